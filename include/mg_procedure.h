@@ -743,6 +743,19 @@ struct mgp_edge_id {
 /// Get the ID of given edge.
 enum mgp_error mgp_edge_get_id(struct mgp_edge *e, struct mgp_edge_id *result);
 
+/// Store the IDs of at most `capacity` edges in `edge_ids`, starting with the
+/// current edge of the iterator, and advance the iterator past them.
+/// The ID of the other vertex of each edge, i.e. the destination of an
+/// outbound edge and the source of an inbound edge, is stored in `other_ids`.
+/// Both arrays must have at least `capacity` elements.
+/// Result is the number of the stored edges, which is 0 if the end of the
+/// iteration has been reached.
+/// The previous mgp_edge obtained through mgp_edges_iterator_get will be
+/// invalidated, and you must not use its value.
+/// Return MGP_ERROR_UNABLE_TO_ALLOCATE if unable to allocate a mgp_edge.
+enum mgp_error mgp_edges_iterator_next_batch(struct mgp_edges_iterator *it, struct mgp_edge_id *edge_ids,
+                                             struct mgp_vertex_id *other_ids, size_t capacity, size_t *result);
+
 /// Result is non-zero if the edge can be modified.
 /// The mutability of the edge is the same as the graph which it is part of. If an edge is immutable, properties cannot
 /// be set or removed and all of the returned vertices will be immutable also.
@@ -1171,6 +1184,146 @@ enum mgp_error mgp_duration_sub(struct mgp_duration *first, struct mgp_duration
 /// Result is NULL if the end of the iteration has been reached.
 /// Return MGP_ERROR_UNABLE_TO_ALLOCATE if unable to allocate a mgp_vertex.
 enum mgp_error mgp_vertices_iterator_next(struct mgp_vertices_iterator *it, struct mgp_vertex **result);
+
+/// Store the IDs of at most `capacity` vertices in `ids`, starting with the
+/// current vertex of the iterator, and advance the iterator past them.
+/// Result is the number of the stored IDs, which is 0 if the end of the
+/// iteration has been reached.
+/// The iterator keeps the vertices of the batch until the next call, so
+/// their properties can be fetched with mgp_vertices_iterator_batch_property.
+/// The previous mgp_vertex obtained through mgp_vertices_iterator_get will be
+/// invalidated, and you must not use its value.
+/// Return MGP_ERROR_UNABLE_TO_ALLOCATE if unable to allocate a mgp_vertex.
+enum mgp_error mgp_vertices_iterator_next_batch(struct mgp_vertices_iterator *it, struct mgp_vertex_id *ids,
+                                                size_t capacity, size_t *result);
+
+/// Values of a single property for a batch of vertices.
+/// The arrays are provided by the caller and must have at least as many
+/// elements as there are vertices in the batch.
+struct mgp_property_column {
+  /// Type of each of the values, MGP_VALUE_TYPE_NULL if the vertex doesn't
+  /// have the property. Values of other types than the ones below are only
+  /// reported here and can be fetched with mgp_vertex_get_property.
+  enum mgp_value_type *types;
+  /// Values of type MGP_VALUE_TYPE_BOOL, as 0 or 1, and MGP_VALUE_TYPE_INT.
+  /// Can be NULL if these values aren't needed.
+  int64_t *ints;
+  /// Values of type MGP_VALUE_TYPE_DOUBLE.
+  /// Can be NULL if these values aren't needed.
+  double *doubles;
+};
+
+/// Fill `column` with the values of the named property of the vertices from
+/// the last mgp_vertices_iterator_next_batch call, in the order of their IDs.
+/// Return MGP_ERROR_DELETED_OBJECT if one of the vertices has been deleted.
+enum mgp_error mgp_vertices_iterator_batch_property(struct mgp_vertices_iterator *it, const char *property_name,
+                                                    struct mgp_property_column *column);
+///@}
+
+/// @name Graph Projection
+///
+/// A graph projection is a read-only snapshot of the graph adjacency in the
+/// compressed sparse row (CSR) format. The projected vertices get dense
+/// ordinals from 0 to the vertex count, and the edges of each vertex are stored
+/// next to each other in flat arrays. Algorithms which traverse the whole graph
+/// many times can work with the raw arrays, without going through the vertex
+/// and edge objects of the API for each step. The projection is built in
+/// parallel, and it doesn't reflect the changes made to the graph after it was
+/// built.
+///@{
+
+/// Read-only CSR snapshot of the graph adjacency.
+struct mgp_graph_projection;
+
+/// Describes which parts of the graph are projected.
+struct mgp_graph_projection_config {
+  /// Only the vertices with this label are projected. If NULL, all of the vertices are projected.
+  const char *vertex_label;
+  /// Only the edges of this type are projected. If NULL, edges of all types are projected.
+  const char *edge_type;
+  /// Name of the numeric edge property which is projected as the edge weight.
+  /// If NULL, the weights aren't projected.
+  const char *weight_property;
+  /// Weight of the edges which don't have the weight property.
+  double default_weight;
+  /// Non-zero if the inbound edges are projected in addition to the outbound ones.
+  int include_in_edges;
+};
+
+/// Project the graph according to `config`.
+/// Only the edges between the projected vertices are projected.
+/// Resulting mgp_graph_projection needs to be deallocated with mgp_graph_projection_destroy.
+/// Return MGP_ERROR_UNABLE_TO_ALLOCATE if unable to allocate the mgp_graph_projection.
+/// Return MGP_ERROR_VALUE_CONVERSION if the weight property of a projected edge isn't a number.
+enum mgp_error mgp_graph_project(struct mgp_graph *graph, struct mgp_graph_projection_config *config,
+                                 struct mgp_memory *memory, struct mgp_graph_projection **result);
+
+/// Free the memory used by a mgp_graph_projection.
+void mgp_graph_projection_destroy(struct mgp_graph_projection *projection);
+
+/// Get the number of the projected vertices.
+/// Current implementation always returns without errors.
+enum mgp_error mgp_graph_projection_vertex_count(struct mgp_graph_projection *projection, size_t *result);
+
+/// Get the number of the projected edges.
+/// Current implementation always returns without errors.
+enum mgp_error mgp_graph_projection_edge_count(struct mgp_graph_projection *projection, size_t *result);
+
+/// Get the array of the projected vertex IDs, indexed by the vertex ordinal.
+/// The array is sorted, so the ordinals follow the order of the vertex IDs.
+/// The array is valid as long as the projection is.
+/// Current implementation always returns without errors.
+enum mgp_error mgp_graph_projection_vertex_ids(struct mgp_graph_projection *projection, const int64_t **result);
+
+/// Get the ordinal of the vertex with the given ID.
+/// Return MGP_ERROR_OUT_OF_RANGE if the vertex isn't projected.
+enum mgp_error mgp_graph_projection_vertex_ordinal(struct mgp_graph_projection *projection, struct mgp_vertex_id id,
+                                                   uint64_t *result);
+
+/// Get the offsets of the outbound edges, which has vertex count + 1 elements.
+/// The outbound edges of the vertex with ordinal `i` are stored at the
+/// indices from `result[i]` up to, but not including, `result[i + 1]` of the
+/// target and weight arrays.
+/// The array is valid as long as the projection is.
+/// Current implementation always returns without errors.
+enum mgp_error mgp_graph_projection_out_offsets(struct mgp_graph_projection *projection, const uint64_t **result);
+
+/// Get the ordinals of the destination vertices of the outbound edges, which
+/// has edge count elements.
+/// The array is valid as long as the projection is.
+/// Current implementation always returns without errors.
+enum mgp_error mgp_graph_projection_out_targets(struct mgp_graph_projection *projection, const uint64_t **result);
+
+/// Get the weights of the outbound edges, which has edge count elements.
+/// Result is NULL if the weights weren't projected.
+/// The array is valid as long as the projection is.
+/// Current implementation always returns without errors.
+enum mgp_error mgp_graph_projection_out_weights(struct mgp_graph_projection *projection, const double **result);
+
+/// Get the offsets of the inbound edges, the same as mgp_graph_projection_out_offsets.
+/// Result is NULL if the inbound edges weren't projected.
+/// Current implementation always returns without errors.
+enum mgp_error mgp_graph_projection_in_offsets(struct mgp_graph_projection *projection, const uint64_t **result);
+
+/// Get the ordinals of the source vertices of the inbound edges.
+/// Result is NULL if the inbound edges weren't projected.
+/// Current implementation always returns without errors.
+enum mgp_error mgp_graph_projection_in_sources(struct mgp_graph_projection *projection, const uint64_t **result);
+
+/// Get the weights of the inbound edges.
+/// Result is NULL if either the inbound edges or the weights weren't projected.
+/// Current implementation always returns without errors.
+enum mgp_error mgp_graph_projection_in_weights(struct mgp_graph_projection *projection, const double **result);
+
+/// Read a numeric property of the projected vertices into the `result` array,
+/// which has to have room for vertex count elements. The value of the vertex
+/// with ordinal `i` is stored at `result[i]`, and the vertices which don't
+/// have the property get `default_value`.
+/// The projection has to be built from the same `graph`.
+/// Return MGP_ERROR_VALUE_CONVERSION if the property of a projected vertex isn't a number.
+/// Return MGP_ERROR_DELETED_OBJECT if a projected vertex has been deleted.
+enum mgp_error mgp_graph_projection_vertex_property(struct mgp_graph *graph, struct mgp_graph_projection *projection,
+                                                    const char *property_name, double default_value, double *result);
 ///@}
 
 /// @name Type System
@@ -1321,6 +1474,57 @@ enum mgp_error mgp_module_add_read_procedure(struct mgp_module *module, const ch
 enum mgp_error mgp_module_add_write_procedure(struct mgp_module *module, const char *name, mgp_proc_cb cb,
                                               struct mgp_proc **result);
 
+/// Entry-point for a query module read procedure which produces its results
+/// in batches, invoked through openCypher.
+///
+/// The callback is invoked repeatedly for a single call of the procedure, with
+/// the same arguments, graph and `state`. Each invocation should add at most
+/// `row_budget` records to the result, continuing where the previous one
+/// stopped. The procedure is done after an invocation which adds no records
+/// or sets an error message. The records are passed on through the query
+/// before the next invocation, so the results don't have to be held in memory
+/// all at once.
+///
+/// The passed in mgp_memory is valid only for the duration of a single
+/// invocation. The state which is kept between the invocations has to be
+/// allocated with the mgp_memory passed to mgp_proc_batch_init. The memory
+/// limit of the procedure applies to the memory of the invocation together
+/// with the memory of the state.
+typedef void (*mgp_proc_batch_cb)(struct mgp_list *args, struct mgp_graph *graph, struct mgp_result *result,
+                                  struct mgp_memory *memory, size_t row_budget, void *state);
+
+/// Prepares a call of a batched procedure, before the first mgp_proc_batch_cb.
+///
+/// The `*state` is passed to each mgp_proc_batch_cb and to the
+/// mgp_proc_batch_cleanup of the call, and it is NULL if not set. The passed
+/// in mgp_memory lives until the call is done, and the memory limit of the
+/// procedure applies to all of the memory allocated with it during the call.
+/// Records added to `result` are ignored, but setting an error message makes
+/// the procedure fail.
+typedef void (*mgp_proc_batch_init)(struct mgp_list *args, struct mgp_graph *graph, struct mgp_result *result,
+                                    struct mgp_memory *memory, void **state);
+
+/// Frees the `state` of a batched procedure call, using the same mgp_memory
+/// which was passed to mgp_proc_batch_init.
+///
+/// The cleanup is invoked once the procedure is done, and also when the query
+/// doesn't pull all of the results. It isn't invoked if the module of the
+/// procedure is reloaded during the call, in which case the call fails.
+typedef void (*mgp_proc_batch_cleanup)(void *state, struct mgp_memory *memory);
+
+/// Register a read-only procedure which produces its results in batches.
+///
+/// The `name` must be a valid identifier, following the same rules as the
+/// procedure `name` in mgp_module_add_read_procedure. The `init` and the
+/// `cleanup` may be NULL.
+///
+/// Return MGP_ERROR_UNABLE_TO_ALLOCATE if unable to allocate memory for mgp_proc.
+/// Return MGP_ERROR_INVALID_ARGUMENT if `name` is not a valid procedure name.
+/// RETURN MGP_ERROR_LOGIC_ERROR if a procedure with the same name was already registered.
+enum mgp_error mgp_module_add_batch_read_procedure(struct mgp_module *module, const char *name,
+                                                   mgp_proc_batch_cb cb, mgp_proc_batch_init init,
+                                                   mgp_proc_batch_cleanup cleanup, struct mgp_proc **result);
+
 /// Add a required argument to a procedure.
 ///
 /// The order of adding arguments will correspond to the order the procedure
@@ -1403,6 +1607,36 @@ enum mgp_error mgp_proc_add_deprecated_result(struct mgp_proc *proc, const char
 /// checking and aborting on its own.
 int mgp_must_abort(struct mgp_graph *graph);
 
+/// Get the number of the threads which can execute the tasks of
+/// mgp_graph_parallel_for at the same time, including the calling thread.
+/// Current implementation always returns without errors.
+enum mgp_error mgp_graph_worker_count(struct mgp_graph *graph, size_t *result);
+
+/// Task executed by mgp_graph_parallel_for.
+///
+/// `task` is the index of the task, from 0 up to, but not including, the task
+/// count. `memory` belongs to the thread executing the task, and it must be
+/// used instead of the procedure's mgp_memory for all of the allocations done
+/// by the task. `data` is passed through from mgp_graph_parallel_for.
+typedef void (*mgp_task_cb)(size_t task, struct mgp_graph *graph, struct mgp_memory *memory, void *data);
+
+/// Execute `task_count` tasks on the worker threads of Memgraph and wait for
+/// all of them to finish.
+///
+/// The calling thread executes the tasks as well, so the tasks are finished
+/// even if all of the workers are busy. The tasks can read the graph at the
+/// same time, e.g. each of them iterating over a part of the vertices, and
+/// they should store their results in `data`. Each thread gets its own
+/// mgp_memory, which is derived from `memory` and counts towards its limit.
+/// Everything allocated from the memory of a thread is released when this
+/// function returns, so the objects created by the tasks must not outlive it.
+/// If the query is aborted, the tasks which haven't started yet aren't
+/// executed, which can be checked with mgp_must_abort.
+/// Return MGP_ERROR_LOGIC_ERROR if `graph` is mutable, since only read
+/// procedures can access the graph from multiple threads.
+enum mgp_error mgp_graph_parallel_for(struct mgp_graph *graph, size_t task_count, mgp_task_cb task, void *data,
+                                      struct mgp_memory *memory);
+
 /// @}
 
 /// @name Stream Source message API
@@ -1502,6 +1736,87 @@ typedef void (*mgp_trans_cb)(struct mgp_messages *, struct mgp_graph *, struct m
 enum mgp_error mgp_module_add_transformation(struct mgp_module *module, const char *name, mgp_trans_cb cb);
 /// @}
 
+/// @name Change Hooks
+/// API for keeping the state of a module, e.g. the result of an algorithm, up
+/// to date with the committed changes of the graph, so the procedures of the
+/// module can read it instead of computing it on each call.
+///@{
+
+/// Changes of the graph committed by a single transaction.
+struct mgp_changes;
+
+/// Edge which was created or deleted, together with its endpoints.
+struct mgp_edge_change {
+  struct mgp_edge_id id;
+  struct mgp_vertex_id from;
+  struct mgp_vertex_id to;
+};
+
+/// Get the IDs of the vertices created by the transaction.
+/// The array is valid only during the mgp_change_cb invocation.
+/// Current implementation always returns without errors.
+enum mgp_error mgp_changes_created_vertices(struct mgp_changes *changes, const struct mgp_vertex_id **ids,
+                                            size_t *count);
+
+/// Get the IDs of the vertices deleted by the transaction.
+/// The array is valid only during the mgp_change_cb invocation.
+/// Current implementation always returns without errors.
+enum mgp_error mgp_changes_deleted_vertices(struct mgp_changes *changes, const struct mgp_vertex_id **ids,
+                                            size_t *count);
+
+/// Get the edges created by the transaction.
+/// The array is valid only during the mgp_change_cb invocation.
+/// Current implementation always returns without errors.
+enum mgp_error mgp_changes_created_edges(struct mgp_changes *changes, const struct mgp_edge_change **edges,
+                                         size_t *count);
+
+/// Get the edges deleted by the transaction.
+/// The array is valid only during the mgp_change_cb invocation.
+/// Current implementation always returns without errors.
+enum mgp_error mgp_changes_deleted_edges(struct mgp_changes *changes, const struct mgp_edge_change **edges,
+                                         size_t *count);
+
+/// Request the mgp_rebuild_cb of the hook, for changes which can't be applied
+/// to the state incrementally. The state is rebuilt after the mgp_change_cb
+/// returns, from a graph which includes the changes.
+/// Current implementation always returns without errors.
+enum mgp_error mgp_changes_request_rebuild(struct mgp_changes *changes);
+
+/// Builds the state of a change hook from the whole graph.
+///
+/// It's invoked before the first changes are passed to the hook and whenever
+/// the hook requests it. The graph is read-only, and it includes exactly the
+/// changes committed before the ones which are passed to the next mgp_change_cb
+/// invocation. The passed in mgp_memory is valid only during the invocation.
+typedef void (*mgp_rebuild_cb)(struct mgp_graph *graph, struct mgp_memory *memory);
+
+/// Applies the changes of a transaction to the state of a change hook.
+///
+/// It's invoked after the transaction is committed, on a single thread shared
+/// by all of the hooks, once for each transaction which changed the graph and
+/// in the order in which they were committed. The procedures can read the
+/// state while the changes are applied, so it needs its own synchronization,
+/// and the procedures can see it slightly behind the graph. The passed in
+/// mgp_memory is valid only during the invocation.
+///
+/// Only the creation and the deletion of the vertices and the edges are passed
+/// on. Changes of the labels and the properties aren't.
+typedef void (*mgp_change_cb)(struct mgp_changes *changes, struct mgp_memory *memory);
+
+/// Register a change hook with a module.
+///
+/// The `name` must be a valid identifier, following the same rules as the
+/// procedure `name` in mgp_module_add_read_procedure. The state of the hook
+/// lives in the module, and it's built for the first time soon after the
+/// module is loaded, with `rebuild`.
+///
+/// Return MGP_ERROR_UNABLE_TO_ALLOCATE if unable to allocate memory for the hook.
+/// Return MGP_ERROR_INVALID_ARGUMENT if `name` is not a valid hook name or if a callback is NULL.
+/// RETURN MGP_ERROR_LOGIC_ERROR if a hook with the same name was already registered.
+enum mgp_error mgp_module_add_change_hook(struct mgp_module *module, const char *name, mgp_rebuild_cb rebuild,
+                                          mgp_change_cb on_change);
+/// @}
+
 #ifdef __cplusplus
 }  // extern "C"
 #endif
@@ -789,6 +789,122 @@ class Vertices:
         return self._len
 
 
+class GraphProjection:
+    """
+    Read-only snapshot of the graph adjacency in the compressed sparse row
+    format, created with `Graph.project`.
+
+    The vertices are identified by their ordinals, which are the indices into
+    `vertex_ids`. The arrays are exported as read-only `memoryview` objects
+    without copying, so they can be wrapped with `numpy.asarray` instead of
+    converting the vertices and edges one by one. The arrays don't reference
+    the graph, so they stay valid after the procedure is done. While the
+    procedure runs, the projection and the property columns count towards the
+    memory usage of the query.
+    """
+    __slots__ = ('_projection',)
+
+    def __init__(self, projection):
+        if not isinstance(projection, _mgp.GraphProjection):
+            raise TypeError("Expected '_mgp.GraphProjection', got '{}'"
+                            .format(type(projection)))
+        self._projection = projection
+
+    def __deepcopy__(self, memo):
+        # The projection is read-only, so it is shared instead of copied.
+        return GraphProjection(self._projection)
+
+    @property
+    def vertex_count(self) -> int:
+        """Number of the projected vertices."""
+        return self._projection.vertex_count()
+
+    @property
+    def edge_count(self) -> int:
+        """Number of the projected edges."""
+        return self._projection.edge_count()
+
+    @property
+    def vertex_ids(self) -> memoryview:
+        """
+        IDs of the projected vertices, indexed by the vertex ordinal. The IDs
+        are sorted.
+        """
+        return self._projection.vertex_ids()
+
+    @property
+    def out_offsets(self) -> memoryview:
+        """
+        Offsets of the outbound edges, which has `vertex_count + 1` elements.
+        The outbound edges of the vertex with ordinal `i` are stored at the
+        indices from `out_offsets[i]` up to, but not including,
+        `out_offsets[i + 1]` of `out_targets` and `out_weights`.
+        """
+        return self._projection.out_offsets()
+
+    @property
+    def out_targets(self) -> memoryview:
+        """Ordinals of the destination vertices of the outbound edges."""
+        return self._projection.out_targets()
+
+    @property
+    def out_weights(self) -> typing.Optional[memoryview]:
+        """
+        Weights of the outbound edges, or None if the weights weren't
+        projected.
+        """
+        return self._projection.out_weights()
+
+    @property
+    def in_offsets(self) -> typing.Optional[memoryview]:
+        """
+        Offsets of the inbound edges, the same as `out_offsets`, or None if
+        the inbound edges weren't projected.
+        """
+        return self._projection.in_offsets()
+
+    @property
+    def in_sources(self) -> typing.Optional[memoryview]:
+        """
+        Ordinals of the source vertices of the inbound edges, or None if the
+        inbound edges weren't projected.
+        """
+        return self._projection.in_sources()
+
+    @property
+    def in_weights(self) -> typing.Optional[memoryview]:
+        """
+        Weights of the inbound edges, or None if either the inbound edges or
+        the weights weren't projected.
+        """
+        return self._projection.in_weights()
+
+    def vertex_ordinal(self, vertex_id: VertexId) -> int:
+        """
+        Return the ordinal of the vertex with the given ID.
+
+        Raise OutOfRangeError if the vertex isn't projected.
+        """
+        return self._projection.vertex_ordinal(vertex_id)
+
+    def vertex_property(self, name: str,
+                        default: float = float('nan')) -> memoryview:
+        """
+        Return the values of a numeric property of the projected vertices,
+        indexed by the vertex ordinal. The vertices which don't have the
+        property get the `default` value.
+
+        Raise InvalidContextError if the procedure which created the
+        projection is done.
+        Raise ValueConversionError if the property of a projected vertex
+        isn't a number.
+        Raise DeletedObjectError if a projected vertex has been deleted.
+        """
+        if not self._projection.is_valid():
+            raise InvalidContextError()
+        return self._projection.vertex_property(name, default)
+
+
 class Graph:
     """State of the graph database in current ProcCtx."""
     __slots__ = ('_graph',)
@@ -840,6 +956,30 @@ class Graph:
             raise InvalidContextError()
         return Vertices(self._graph)
 
+    def project(self, vertex_label: typing.Optional[str] = None,
+                edge_type: typing.Optional[str] = None,
+                weight_property: typing.Optional[str] = None,
+                default_weight: float = 1.0,
+                include_in_edges: bool = False) -> GraphProjection:
+        """
+        Project the graph into contiguous arrays, which can be used by the
+        analytics without converting the vertices and edges one by one.
+
+        Only the vertices with `vertex_label` and the edges of `edge_type`
+        between them are projected, or all of them if the label or the type
+        is None. The numeric `weight_property` of the edges is projected as
+        their weight, and the edges which don't have it get `default_weight`.
+
+        Raise InvalidContextError if context is invalid.
+        Raise ValueConversionError if the weight property of a projected edge
+        isn't a number.
+        """
+        if not self.is_valid():
+            raise InvalidContextError()
+        return GraphProjection(self._graph.project(
+            vertex_label, edge_type, weight_property, default_weight,
+            include_in_edges))
+
     def is_mutable(self) -> bool:
         """
         Return True if `self` represents a mutable graph, thus it can be
@@ -195,6 +195,225 @@ int add_write_procedure(struct mgp_module *module, struct mgp_memory *memory) {
   return 0;
 }
 
+#define BATCH_SIZE 1024
+
+// This example procedure returns 2 fields: `sum` and `edge_count`.
+//   * `sum` is the sum of the given numeric property of all vertices.
+//   * `edge_count` is the number of the outbound edges of all vertices.
+// The vertices with their properties and the edges are fetched in batches,
+// which makes fewer calls into Memgraph than fetching them one by one and
+// doesn't allocate a mgp_value for each of the properties.
+//
+// The procedure can be invoked in openCypher using the following call:
+//   CALL example.batch_procedure("property name") YIELD sum, edge_count;
+static void batch_procedure(struct mgp_list *args, struct mgp_graph *graph, struct mgp_result *result,
+                            struct mgp_memory *memory) {
+  struct mgp_value *arg = NULL;
+  if (mgp_list_at(args, 0, &arg) != MGP_ERROR_NO_ERROR) {
+    goto error_something_went_wrong;
+  }
+  const char *property_name = NULL;
+  if (mgp_value_get_string(arg, &property_name) != MGP_ERROR_NO_ERROR) {
+    goto error_something_went_wrong;
+  }
+
+  struct mgp_vertex_id ids[BATCH_SIZE];
+  enum mgp_value_type types[BATCH_SIZE];
+  int64_t ints[BATCH_SIZE];
+  double doubles[BATCH_SIZE];
+  struct mgp_property_column column = {.types = types, .ints = ints, .doubles = doubles};
+  double sum = 0;
+  struct mgp_vertices_iterator *vertices = NULL;
+  if (mgp_graph_iter_vertices(graph, memory, &vertices) != MGP_ERROR_NO_ERROR) {
+    goto error_something_went_wrong;
+  }
+  size_t vertex_batch_size = 0;
+  do {
+    if (mgp_vertices_iterator_next_batch(vertices, ids, BATCH_SIZE, &vertex_batch_size) != MGP_ERROR_NO_ERROR) {
+      goto error_destroy_vertices;
+    }
+    if (mgp_vertices_iterator_batch_property(vertices, property_name, &column) != MGP_ERROR_NO_ERROR) {
+      goto error_destroy_vertices;
+    }
+    for (size_t i = 0; i < vertex_batch_size; ++i) {
+      if (types[i] == MGP_VALUE_TYPE_INT) {
+        sum += (double)ints[i];
+      } else if (types[i] == MGP_VALUE_TYPE_DOUBLE) {
+        sum += doubles[i];
+      }
+    }
+  } while (vertex_batch_size > 0);
+  mgp_vertices_iterator_destroy(vertices);
+
+  // The edges are fetched in batches for each of the vertices.
+  struct mgp_edge_id edge_ids[BATCH_SIZE];
+  struct mgp_vertex_id other_ids[BATCH_SIZE];
+  int64_t edge_count = 0;
+  if (mgp_graph_iter_vertices(graph, memory, &vertices) != MGP_ERROR_NO_ERROR) {
+    goto error_something_went_wrong;
+  }
+  struct mgp_vertex *vertex = NULL;
+  if (mgp_vertices_iterator_get(vertices, &vertex) != MGP_ERROR_NO_ERROR) {
+    goto error_destroy_vertices;
+  }
+  while (vertex) {
+    struct mgp_edges_iterator *edges = NULL;
+    if (mgp_vertex_iter_out_edges(vertex, memory, &edges) != MGP_ERROR_NO_ERROR) {
+      goto error_destroy_vertices;
+    }
+    size_t edge_batch_size = 0;
+    do {
+      if (mgp_edges_iterator_next_batch(edges, edge_ids, other_ids, BATCH_SIZE, &edge_batch_size) !=
+          MGP_ERROR_NO_ERROR) {
+        mgp_edges_iterator_destroy(edges);
+        goto error_destroy_vertices;
+      }
+      edge_count += (int64_t)edge_batch_size;
+    } while (edge_batch_size > 0);
+    mgp_edges_iterator_destroy(edges);
+    if (mgp_vertices_iterator_next(vertices, &vertex) != MGP_ERROR_NO_ERROR) {
+      goto error_destroy_vertices;
+    }
+  }
+  mgp_vertices_iterator_destroy(vertices);
+
+  struct mgp_result_record *record = NULL;
+  if (mgp_result_new_record(result, &record) != MGP_ERROR_NO_ERROR) {
+    goto error_something_went_wrong;
+  }
+  struct mgp_value *sum_value = NULL;
+  if (mgp_value_make_double(sum, memory, &sum_value) != MGP_ERROR_NO_ERROR) {
+    goto error_something_went_wrong;
+  }
+  enum mgp_error insert_result = mgp_result_record_insert(record, "sum", sum_value);
+  mgp_value_destroy(sum_value);
+  if (insert_result != MGP_ERROR_NO_ERROR) {
+    goto error_something_went_wrong;
+  }
+  struct mgp_value *edge_count_value = NULL;
+  if (mgp_value_make_int(edge_count, memory, &edge_count_value) != MGP_ERROR_NO_ERROR) {
+    goto error_something_went_wrong;
+  }
+  insert_result = mgp_result_record_insert(record, "edge_count", edge_count_value);
+  mgp_value_destroy(edge_count_value);
+  if (insert_result != MGP_ERROR_NO_ERROR) {
+    goto error_something_went_wrong;
+  }
+  return;
+
+error_destroy_vertices:
+  mgp_vertices_iterator_destroy(vertices);
+error_something_went_wrong:
+  // Best effort. If it fails, there is nothing we can do.
+  mgp_result_set_error_msg(result, "Something went wrong!");
+}
+
+int add_batch_procedure(struct mgp_module *module) {
+  struct mgp_proc *proc = NULL;
+  if (mgp_module_add_read_procedure(module, "batch_procedure", batch_procedure, &proc) != MGP_ERROR_NO_ERROR) {
+    return 1;
+  }
+  struct mgp_type *string_type = NULL;
+  if (mgp_type_string(&string_type) != MGP_ERROR_NO_ERROR) {
+    return 1;
+  }
+  if (mgp_proc_add_arg(proc, "property_name", string_type) != MGP_ERROR_NO_ERROR) {
+    return 1;
+  }
+  struct mgp_type *float_type = NULL;
+  if (mgp_type_float(&float_type) != MGP_ERROR_NO_ERROR) {
+    return 1;
+  }
+  if (mgp_proc_add_result(proc, "sum", float_type) != MGP_ERROR_NO_ERROR) {
+    return 1;
+  }
+  struct mgp_type *int_type = NULL;
+  if (mgp_type_int(&int_type) != MGP_ERROR_NO_ERROR) {
+    return 1;
+  }
+  if (mgp_proc_add_result(proc, "edge_count", int_type) != MGP_ERROR_NO_ERROR) {
+    return 1;
+  }
+  return 0;
+}
+
+// State of a call of the stream_procedure, kept between its batches.
+struct stream_state {
+  int64_t next;
+  int64_t count;
+};
+
+static void stream_init(struct mgp_list *args, struct mgp_graph *graph, struct mgp_result *result,
+                        struct mgp_memory *memory, void **state) {
+  struct mgp_value *arg = NULL;
+  int64_t count = 0;
+  if (mgp_list_at(args, 0, &arg) != MGP_ERROR_NO_ERROR || mgp_value_get_int(arg, &count) != MGP_ERROR_NO_ERROR) {
+    mgp_result_set_error_msg(result, "Something went wrong!");
+    return;
+  }
+  struct stream_state *stream = NULL;
+  if (mgp_alloc(memory, sizeof(struct stream_state), (void **)&stream) != MGP_ERROR_NO_ERROR) {
+    mgp_result_set_error_msg(result, "Not enough memory!");
+    return;
+  }
+  stream->next = 0;
+  stream->count = count;
+  *state = stream;
+}
+
+// This example procedure returns the field `number` for each of the numbers
+// from 0 up to, but not including, the given count. The records are yielded
+// in batches of at most `row_budget`, so the query doesn't keep all of them in
+// memory, and stops calling the procedure once it has enough of them.
+//
+// The procedure can be invoked in openCypher using the following call:
+//   CALL example.stream_procedure(1000000) YIELD number RETURN number LIMIT 10;
+static void stream_procedure(struct mgp_list *args, struct mgp_graph *graph, struct mgp_result *result,
+                             struct mgp_memory *memory, size_t row_budget, void *state) {
+  struct stream_state *stream = state;
+  for (size_t i = 0; i < row_budget && stream->next < stream->count; ++i, ++stream->next) {
+    struct mgp_result_record *record = NULL;
+    if (mgp_result_new_record(result, &record) != MGP_ERROR_NO_ERROR) {
+      goto error_something_went_wrong;
+    }
+    struct mgp_value *number = NULL;
+    if (mgp_value_make_int(stream->next, memory, &number) != MGP_ERROR_NO_ERROR) {
+      goto error_something_went_wrong;
+    }
+    enum mgp_error insert_result = mgp_result_record_insert(record, "number", number);
+    mgp_value_destroy(number);
+    if (insert_result != MGP_ERROR_NO_ERROR) {
+      goto error_something_went_wrong;
+    }
+  }
+  return;
+
+error_something_went_wrong:
+  // Best effort. If it fails, there is nothing we can do.
+  mgp_result_set_error_msg(result, "Something went wrong!");
+}
+
+static void stream_cleanup(void *state, struct mgp_memory *memory) { mgp_free(memory, state); }
+
+int add_stream_procedure(struct mgp_module *module) {
+  struct mgp_proc *proc = NULL;
+  if (mgp_module_add_batch_read_procedure(module, "stream_procedure", stream_procedure, stream_init, stream_cleanup,
+                                          &proc) != MGP_ERROR_NO_ERROR) {
+    return 1;
+  }
+  struct mgp_type *int_type = NULL;
+  if (mgp_type_int(&int_type) != MGP_ERROR_NO_ERROR) {
+    return 1;
+  }
+  if (mgp_proc_add_arg(proc, "count", int_type) != MGP_ERROR_NO_ERROR) {
+    return 1;
+  }
+  if (mgp_proc_add_result(proc, "number", int_type) != MGP_ERROR_NO_ERROR) {
+    return 1;
+  }
+  return 0;
+}
+
 // Each module needs to define mgp_init_module function.
 // Here you can register multiple procedures your module supports.
 int mgp_init_module(struct mgp_module *module, struct mgp_memory *memory) {
@@ -204,6 +423,12 @@ int mgp_init_module(struct mgp_module *module, struct mgp_memory *memory) {
   if (add_write_procedure(module, memory) != 0) {
     return -1;
   }
+  if (add_batch_procedure(module) != 0) {
+    return -1;
+  }
+  if (add_stream_procedure(module) != 0) {
+    return -1;
+  }
   return 0;
 }
 
@@ -0,0 +1,569 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "algorithms.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <unordered_set>
+#include <utility>
+
+namespace graph_algorithms {
+
+namespace {
+
+// Calls `func(range, begin, end)` for each of the vertex ranges in `bounds`,
+// with a task for each range.
+template <class TFunc>
+void ForEachRange(const std::vector<uint64_t> &bounds, const ParallelFor &parallel_for, const TFunc &func) {
+  parallel_for(bounds.size() - 1, [&](size_t range) { func(range, bounds[range], bounds[range + 1]); });
+}
+
+double EdgeWeight(const double *weights, uint64_t edge) { return weights ? weights[edge] : 1.0; }
+
+// Returns the root of the `vertex` in the union-find forest, halving the path
+// on the way. The roots are always the smallest vertex of their tree.
+uint64_t FindRoot(std::vector<uint64_t> &parents, uint64_t vertex) {
+  while (true) {
+    auto parent = std::atomic_ref<uint64_t>(parents[vertex]).load(std::memory_order_relaxed);
+    if (parent == vertex) return vertex;
+    const auto grandparent = std::atomic_ref<uint64_t>(parents[parent]).load(std::memory_order_relaxed);
+    if (parent != grandparent) {
+      // Another thread may have changed the parent in the meantime, in which
+      // case the path isn't halved, but the result is the same.
+      std::atomic_ref<uint64_t>(parents[vertex]).compare_exchange_weak(parent, grandparent, std::memory_order_relaxed);
+    }
+    vertex = grandparent;
+  }
+}
+
+void Unite(std::vector<uint64_t> &parents, uint64_t first, uint64_t second) {
+  while (true) {
+    first = FindRoot(parents, first);
+    second = FindRoot(parents, second);
+    if (first == second) return;
+    // The larger root is hooked under the smaller one, so the parents only
+    // decrease and the concurrent hooks can't make a cycle.
+    if (first < second) std::swap(first, second);
+    auto expected = first;
+    if (std::atomic_ref<uint64_t>(parents[first])
+            .compare_exchange_strong(expected, second, std::memory_order_relaxed)) {
+      return;
+    }
+  }
+}
+
+}  // namespace
+
+void SequentialFor(size_t task_count, const std::function<void(size_t task)> &task) {
+  for (size_t i = 0; i < task_count; ++i) task(i);
+}
+
+std::vector<uint64_t> PartitionVertices(const uint64_t *offsets, size_t vertex_count, size_t parts) {
+  // The cost of the vertices before `v` is `v + offsets[v]`, which grows with
+  // `v`, so the boundaries are found with a binary search.
+  const uint64_t total = vertex_count + (vertex_count == 0 ? 0 : offsets[vertex_count]);
+  parts = std::max<size_t>(parts, 1);
+  std::vector<uint64_t> bounds{0};
+  for (size_t i = 1; i < parts; ++i) {
+    const uint64_t target = total / parts * i + total % parts * i / parts;
+    uint64_t low = bounds.back();
+    uint64_t high = vertex_count;
+    while (low < high) {
+      const auto middle = low + (high - low) / 2;
+      if (middle + offsets[middle] < target) {
+        low = middle + 1;
+      } else {
+        high = middle;
+      }
+    }
+    if (low > bounds.back() && low < vertex_count) bounds.push_back(low);
+  }
+  if (vertex_count > 0) bounds.push_back(vertex_count);
+  return bounds;
+}
+
+UndirectedGraph MakeUndirected(const CsrGraph &graph, const ParallelFor &parallel_for, size_t tasks) {
+  const auto vertex_count = graph.vertex_count;
+  const auto bounds = PartitionVertices(graph.out_offsets, vertex_count, tasks);
+  UndirectedGraph result;
+  result.offsets.assign(vertex_count + 1, 0);
+  // Each task merges the edges of its vertices into a buffer of its own, which
+  // are concatenated once the degrees are known.
+  std::vector<std::vector<uint64_t>> buffers(bounds.size() - 1);
+  ForEachRange(bounds, parallel_for, [&](size_t range, uint64_t begin, uint64_t end) {
+    auto &neighbours = buffers[range];
+    for (auto vertex = begin; vertex < end; ++vertex) {
+      const auto first = neighbours.size();
+      neighbours.insert(neighbours.end(), graph.out_targets + graph.out_offsets[vertex],
+                        graph.out_targets + graph.out_offsets[vertex + 1]);
+      neighbours.insert(neighbours.end(), graph.in_sources + graph.in_offsets[vertex],
+                        graph.in_sources + graph.in_offsets[vertex + 1]);
+      std::sort(neighbours.begin() + first, neighbours.end());
+      neighbours.erase(std::unique(neighbours.begin() + first, neighbours.end()), neighbours.end());
+      neighbours.erase(std::remove(neighbours.begin() + first, neighbours.end(), vertex), neighbours.end());
+      result.offsets[vertex + 1] = neighbours.size() - first;
+    }
+  });
+  std::partial_sum(result.offsets.begin(), result.offsets.end(), result.offsets.begin());
+  result.neighbours.resize(result.offsets.back());
+  ForEachRange(bounds, parallel_for, [&](size_t range, uint64_t begin, uint64_t) {
+    std::copy(buffers[range].begin(), buffers[range].end(), result.neighbours.begin() + result.offsets[begin]);
+    buffers[range] = {};
+  });
+  return result;
+}
+
+std::vector<double> PageRank(const CsrGraph &graph, const PageRankConfig &config, const ParallelFor &parallel_for,
+                             size_t tasks) {
+  const auto vertex_count = graph.vertex_count;
+  if (vertex_count == 0) return {};
+  const auto bounds = PartitionVertices(graph.in_offsets, vertex_count, tasks);
+  const auto ranges = bounds.size() - 1;
+  const auto damping = config.damping_factor;
+  std::vector<double> ranks(vertex_count, 1.0 / static_cast<double>(vertex_count));
+  std::vector<double> next_ranks(vertex_count);
+  // The rank each vertex passes to each of its outbound edges.
+  std::vector<double> contributions(vertex_count);
+  std::vector<double> dangling(ranges);
+  std::vector<double> changes(ranges);
+  for (size_t iteration = 0; iteration < config.max_iterations; ++iteration) {
+    ForEachRange(bounds, parallel_for, [&](size_t range, uint64_t begin, uint64_t end) {
+      double dangling_rank = 0;
+      for (auto vertex = begin; vertex < end; ++vertex) {
+        const auto degree = graph.OutDegree(vertex);
+        if (degree == 0) {
+          dangling_rank += ranks[vertex];
+          contributions[vertex] = 0;
+        } else {
+          contributions[vertex] = ranks[vertex] / static_cast<double>(degree);
+        }
+      }
+      dangling[range] = dangling_rank;
+    });
+    const auto dangling_rank = std::accumulate(dangling.begin(), dangling.end(), 0.0);
+    const auto base_rank = ((1 - damping) + damping * dangling_rank) / static_cast<double>(vertex_count);
+    ForEachRange(bounds, parallel_for, [&](size_t range, uint64_t begin, uint64_t end) {
+      double change = 0;
+      for (auto vertex = begin; vertex < end; ++vertex) {
+        double sum = 0;
+        for (auto edge = graph.in_offsets[vertex]; edge < graph.in_offsets[vertex + 1]; ++edge) {
+          sum += contributions[graph.in_sources[edge]];
+        }
+        next_ranks[vertex] = base_rank + damping * sum;
+        change += std::abs(next_ranks[vertex] - ranks[vertex]);
+      }
+      changes[range] = change;
+    });
+    ranks.swap(next_ranks);
+    if (std::accumulate(changes.begin(), changes.end(), 0.0) < config.tolerance) break;
+  }
+  return ranks;
+}
+
+std::vector<uint64_t> WeaklyConnectedComponents(const CsrGraph &graph, const ParallelFor &parallel_for,
+                                                size_t tasks) {
+  const auto vertex_count = graph.vertex_count;
+  std::vector<uint64_t> parents(vertex_count);
+  std::iota(parents.begin(), parents.end(), 0);
+  const auto bounds = PartitionVertices(graph.out_offsets, vertex_count, tasks);
+  ForEachRange(bounds, parallel_for, [&](size_t, uint64_t begin, uint64_t end) {
+    for (auto vertex = begin; vertex < end; ++vertex) {
+      for (auto edge = graph.out_offsets[vertex]; edge < graph.out_offsets[vertex + 1]; ++edge) {
+        Unite(parents, vertex, graph.out_targets[edge]);
+      }
+    }
+  });
+  ForEachRange(bounds, parallel_for, [&](size_t, uint64_t begin, uint64_t end) {
+    for (auto vertex = begin; vertex < end; ++vertex) {
+      std::atomic_ref<uint64_t>(parents[vertex]).store(FindRoot(parents, vertex), std::memory_order_relaxed);
+    }
+  });
+  return parents;
+}
+
+void IncrementalComponents::Assign(const CsrGraph &graph, const int64_t *vertex_ids, const uint64_t *components) {
+  component_of_.clear();
+  components_.clear();
+  neighbours_.clear();
+  component_of_.reserve(graph.vertex_count);
+  for (uint64_t vertex = 0; vertex < graph.vertex_count; ++vertex) {
+    const auto id = vertex_ids[vertex];
+    const auto key = components[vertex];
+    components_[key].insert(id);
+    component_of_[id] = key;
+    next_key_ = std::max(next_key_, key + 1);
+    for (auto edge = graph.out_offsets[vertex]; edge < graph.out_offsets[vertex + 1]; ++edge) {
+      const auto neighbour = vertex_ids[graph.out_targets[edge]];
+      if (neighbour == id) continue;
+      ++neighbours_[id][neighbour];
+      ++neighbours_[neighbour][id];
+    }
+  }
+}
+
+void IncrementalComponents::AddVertex(int64_t vertex) {
+  if (!component_of_.try_emplace(vertex, next_key_).second) return;
+  components_.emplace(next_key_, std::set<int64_t>{vertex});
+  ++next_key_;
+}
+
+void IncrementalComponents::AddEdge(int64_t from, int64_t to) {
+  AddVertex(from);
+  AddVertex(to);
+  if (from == to) return;
+  ++neighbours_[from][to];
+  ++neighbours_[to][from];
+  auto larger_key = component_of_[from];
+  auto smaller_key = component_of_[to];
+  if (larger_key == smaller_key) return;
+  auto *larger = &components_[larger_key];
+  auto *smaller = &components_[smaller_key];
+  if (larger->size() < smaller->size()) {
+    std::swap(larger_key, smaller_key);
+    std::swap(larger, smaller);
+  }
+  for (const auto vertex : *smaller) component_of_[vertex] = larger_key;
+  larger->insert(smaller->begin(), smaller->end());
+  components_.erase(smaller_key);
+}
+
+void IncrementalComponents::RemoveEdge(int64_t from, int64_t to) {
+  if (from == to) return;
+  const auto remove_one = [&](int64_t vertex, int64_t neighbour) {
+    auto vertex_it = neighbours_.find(vertex);
+    if (vertex_it == neighbours_.end()) return false;
+    auto neighbour_it = vertex_it->second.find(neighbour);
+    if (neighbour_it == vertex_it->second.end()) return false;
+    if (--neighbour_it->second == 0) vertex_it->second.erase(neighbour_it);
+    if (vertex_it->second.empty()) neighbours_.erase(vertex_it);
+    return true;
+  };
+  if (!remove_one(from, to)) return;
+  remove_one(to, from);
+  const auto from_it = neighbours_.find(from);
+  if (from_it != neighbours_.end() && from_it->second.contains(to)) return;
+  SplitIfDisconnected(from, to);
+}
+
+void IncrementalComponents::RemoveVertex(int64_t vertex) {
+  auto found = component_of_.find(vertex);
+  if (found == component_of_.end()) return;
+  if (auto vertex_it = neighbours_.find(vertex); vertex_it != neighbours_.end()) {
+    std::vector<std::pair<int64_t, uint64_t>> edges(vertex_it->second.begin(), vertex_it->second.end());
+    for (const auto &[neighbour, count] : edges) {
+      for (uint64_t i = 0; i < count; ++i) RemoveEdge(vertex, neighbour);
+    }
+    found = component_of_.find(vertex);
+  }
+  // The vertex is alone in its component now.
+  components_.erase(found->second);
+  component_of_.erase(found);
+}
+
+void IncrementalComponents::SplitIfDisconnected(int64_t a, int64_t b) {
+  std::unordered_set<int64_t> seen[2]{{a}, {b}};
+  std::deque<int64_t> queues[2]{{a}, {b}};
+  while (true) {
+    for (int side = 0; side < 2; ++side) {
+      auto &queue = queues[side];
+      if (queue.empty()) {
+        // All of the vertices connected to this side are found, and none of
+        // them is connected to the other side.
+        const auto old_key = component_of_[side == 0 ? a : b];
+        auto &old_component = components_[old_key];
+        std::set<int64_t> split(seen[side].begin(), seen[side].end());
+        for (const auto vertex : split) {
+          old_component.erase(vertex);
+          component_of_[vertex] = next_key_;
+        }
+        components_.emplace(next_key_, std::move(split));
+        ++next_key_;
+        return;
+      }
+      const auto vertex = queue.front();
+      queue.pop_front();
+      const auto vertex_it = neighbours_.find(vertex);
+      if (vertex_it == neighbours_.end()) continue;
+      for (const auto &[neighbour, count] : vertex_it->second) {
+        if (seen[1 - side].contains(neighbour)) return;
+        if (seen[side].insert(neighbour).second) queue.push_back(neighbour);
+      }
+    }
+  }
+}
+
+std::optional<int64_t> IncrementalComponents::ComponentOf(int64_t vertex) const {
+  const auto found = component_of_.find(vertex);
+  if (found == component_of_.end()) return std::nullopt;
+  return *components_.at(found->second).begin();
+}
+
+std::vector<uint64_t> StronglyConnectedComponents(const CsrGraph &graph) {
+  constexpr auto kUnvisited = std::numeric_limits<uint64_t>::max();
+  const auto vertex_count = graph.vertex_count;
+  std::vector<uint64_t> indices(vertex_count, kUnvisited);
+  std::vector<uint64_t> low_links(vertex_count);
+  std::vector<uint64_t> components(vertex_count, kUnvisited);
+  std::vector<uint64_t> stack;
+  // The vertices which are being visited, with the next of their edges.
+  std::vector<std::pair<uint64_t, uint64_t>> visiting;
+  uint64_t next_index = 0;
+  uint64_t next_component = 0;
+  const auto visit = [&](uint64_t vertex) {
+    indices[vertex] = low_links[vertex] = next_index++;
+    stack.push_back(vertex);
+    visiting.emplace_back(vertex, graph.out_offsets[vertex]);
+  };
+  for (uint64_t root = 0; root < vertex_count; ++root) {
+    if (indices[root] != kUnvisited) continue;
+    visit(root);
+    while (!visiting.empty()) {
+      const auto vertex = visiting.back().first;
+      auto &edge = visiting.back().second;
+      if (edge < graph.out_offsets[vertex + 1]) {
+        const auto target = graph.out_targets[edge++];
+        if (indices[target] == kUnvisited) {
+          visit(target);
+        } else if (components[target] == kUnvisited) {
+          // The target is still on the stack.
+          low_links[vertex] = std::min(low_links[vertex], indices[target]);
+        }
+        continue;
+      }
+      if (low_links[vertex] == indices[vertex]) {
+        uint64_t member = kUnvisited;
+        do {
+          member = stack.back();
+          stack.pop_back();
+          components[member] = next_component;
+        } while (member != vertex);
+        ++next_component;
+      }
+      visiting.pop_back();
+      if (!visiting.empty()) {
+        const auto parent = visiting.back().first;
+        low_links[parent] = std::min(low_links[parent], low_links[vertex]);
+      }
+    }
+  }
+  return components;
+}
+
+std::vector<uint64_t> LabelPropagation(const CsrGraph &graph, const LabelPropagationConfig &config,
+                                       const ParallelFor &parallel_for, size_t tasks) {
+  const auto vertex_count = graph.vertex_count;
+  std::vector<uint64_t> labels(vertex_count);
+  std::iota(labels.begin(), labels.end(), 0);
+  std::vector<uint64_t> next_labels(labels);
+  const auto bounds = PartitionVertices(graph.out_offsets, vertex_count, tasks);
+  std::vector<uint8_t> changed(bounds.size() - 1);
+  for (size_t iteration = 0; iteration < config.max_iterations; ++iteration) {
+    ForEachRange(bounds, parallel_for, [&](size_t range, uint64_t begin, uint64_t end) {
+      std::vector<std::pair<uint64_t, double>> votes;
+      bool range_changed = false;
+      for (auto vertex = begin; vertex < end; ++vertex) {
+        votes.clear();
+        auto lightest = std::numeric_limits<double>::infinity();
+        const auto add_votes = [&](const uint64_t *offsets, const uint64_t *neighbours, const double *weights) {
+          for (auto edge = offsets[vertex]; edge < offsets[vertex + 1]; ++edge) {
+            if (neighbours[edge] == vertex) continue;
+            const auto weight = EdgeWeight(weights, edge);
+            votes.emplace_back(labels[neighbours[edge]], weight);
+            lightest = std::min(lightest, weight);
+          }
+        };
+        add_votes(graph.out_offsets, graph.out_targets, graph.out_weights);
+        add_votes(graph.in_offsets, graph.in_sources, graph.in_weights);
+        if (votes.empty()) {
+          next_labels[vertex] = labels[vertex];
+          continue;
+        }
+        votes.emplace_back(labels[vertex], lightest);
+        std::sort(votes.begin(), votes.end());
+        auto best_label = labels[vertex];
+        double best_weight = -1;
+        for (size_t i = 0; i < votes.size();) {
+          const auto label = votes[i].first;
+          double weight = 0;
+          for (; i < votes.size() && votes[i].first == label; ++i) weight += votes[i].second;
+          // The labels are sorted, so a tie keeps the smaller one.
+          if (weight > best_weight) {
+            best_label = label;
+            best_weight = weight;
+          }
+        }
+        next_labels[vertex] = best_label;
+        range_changed |= best_label != labels[vertex];
+      }
+      changed[range] = range_changed;
+    });
+    labels.swap(next_labels);
+    if (std::none_of(changed.begin(), changed.end(), [](auto range_changed) { return range_changed; })) break;
+  }
+  return labels;
+}
+
+std::vector<double> BetweennessCentrality(const CsrGraph &graph, const BetweennessConfig &config,
+                                          const ParallelFor &parallel_for, size_t tasks) {
+  const auto vertex_count = graph.vertex_count;
+  if (vertex_count == 0) return {};
+  std::vector<uint64_t> sources(vertex_count);
+  std::iota(sources.begin(), sources.end(), 0);
+  if (config.samples > 0 && config.samples < vertex_count) {
+    std::mt19937_64 generator(config.seed);
+    for (size_t i = 0; i < config.samples; ++i) {
+      std::uniform_int_distribution<size_t> distribution(i, vertex_count - 1);
+      std::swap(sources[i], sources[distribution(generator)]);
+    }
+    sources.resize(config.samples);
+  }
+
+  UndirectedGraph undirected;
+  const uint64_t *offsets = graph.out_offsets;
+  const uint64_t *neighbours = graph.out_targets;
+  if (!config.directed) {
+    undirected = MakeUndirected(graph, parallel_for, tasks);
+    offsets = undirected.offsets.data();
+    neighbours = undirected.neighbours.data();
+  }
+
+  // Each task accumulates the centrality of its sources separately.
+  tasks = std::clamp<size_t>(tasks, 1, sources.size());
+  std::vector<std::vector<double>> centralities(tasks);
+  parallel_for(tasks, [&](size_t task) {
+    auto &centrality = centralities[task];
+    centrality.assign(vertex_count, 0);
+    std::vector<int64_t> distances(vertex_count, -1);
+    std::vector<double> path_counts(vertex_count, 0);
+    std::vector<double> dependencies(vertex_count, 0);
+    // The visited vertices in the order of their distance, which is also the
+    // queue of the breadth-first search.
+    std::vector<uint64_t> order;
+    for (auto i = task; i < sources.size(); i += tasks) {
+      const auto source = sources[i];
+      order.clear();
+      order.push_back(source);
+      distances[source] = 0;
+      path_counts[source] = 1;
+      for (size_t next = 0; next < order.size(); ++next) {
+        const auto vertex = order[next];
+        for (auto edge = offsets[vertex]; edge < offsets[vertex + 1]; ++edge) {
+          const auto target = neighbours[edge];
+          if (distances[target] < 0) {
+            distances[target] = distances[vertex] + 1;
+            order.push_back(target);
+          }
+          if (distances[target] == distances[vertex] + 1) path_counts[target] += path_counts[vertex];
+        }
+      }
+      // The dependencies are accumulated from the successors on the shortest
+      // paths, so the predecessors don't have to be stored.
+      for (auto it = order.rbegin(); it != order.rend(); ++it) {
+        const auto vertex = *it;
+        double dependency = 0;
+        for (auto edge = offsets[vertex]; edge < offsets[vertex + 1]; ++edge) {
+          const auto target = neighbours[edge];
+          if (distances[target] == distances[vertex] + 1) {
+            dependency += path_counts[vertex] / path_counts[target] * (1 + dependencies[target]);
+          }
+        }
+        dependencies[vertex] = dependency;
+        if (vertex != source) centrality[vertex] += dependency;
+      }
+      for (const auto vertex : order) {
+        distances[vertex] = -1;
+        path_counts[vertex] = 0;
+        dependencies[vertex] = 0;
+      }
+    }
+  });
+
+  auto result = std::move(centralities[0]);
+  const auto bounds = PartitionVertices(offsets, vertex_count, tasks);
+  // Each path of an undirected graph is found from both of its ends.
+  const auto scale = static_cast<double>(vertex_count) / static_cast<double>(sources.size()) /
+                     (config.directed ? 1.0 : 2.0);
+  ForEachRange(bounds, parallel_for, [&](size_t, uint64_t begin, uint64_t end) {
+    for (auto vertex = begin; vertex < end; ++vertex) {
+      for (size_t task = 1; task < centralities.size(); ++task) result[vertex] += centralities[task][vertex];
+      result[vertex] *= scale;
+    }
+  });
+  return result;
+}
+
+std::vector<uint64_t> TriangleCount(const CsrGraph &graph, const ParallelFor &parallel_for, size_t tasks) {
+  const auto vertex_count = graph.vertex_count;
+  const auto undirected = MakeUndirected(graph, parallel_for, tasks);
+  const auto &offsets = undirected.offsets;
+  const auto degree = [&](uint64_t vertex) { return offsets[vertex + 1] - offsets[vertex]; };
+  const auto is_before = [&](uint64_t first, uint64_t second) {
+    return std::make_pair(degree(first), first) < std::make_pair(degree(second), second);
+  };
+
+  // Keep only the edges towards the vertices which are later in the order,
+  // which keeps the lists of the high degree vertices short.
+  auto bounds = PartitionVertices(offsets.data(), vertex_count, tasks);
+  std::vector<uint64_t> forward_offsets(vertex_count + 1, 0);
+  ForEachRange(bounds, parallel_for, [&](size_t, uint64_t begin, uint64_t end) {
+    for (auto vertex = begin; vertex < end; ++vertex) {
+      const auto *neighbours = undirected.neighbours.data();
+      forward_offsets[vertex + 1] = std::count_if(neighbours + offsets[vertex], neighbours + offsets[vertex + 1],
+                                                  [&](uint64_t neighbour) { return is_before(vertex, neighbour); });
+    }
+  });
+  std::partial_sum(forward_offsets.begin(), forward_offsets.end(), forward_offsets.begin());
+  std::vector<uint64_t> forward(forward_offsets.back());
+  ForEachRange(bounds, parallel_for, [&](size_t, uint64_t begin, uint64_t end) {
+    for (auto vertex = begin; vertex < end; ++vertex) {
+      const auto *neighbours = undirected.neighbours.data();
+      std::copy_if(neighbours + offsets[vertex], neighbours + offsets[vertex + 1],
+                   forward.begin() + forward_offsets[vertex],
+                   [&](uint64_t neighbour) { return is_before(vertex, neighbour); });
+    }
+  });
+
+  std::vector<uint64_t> triangles(vertex_count, 0);
+  bounds = PartitionVertices(forward_offsets.data(), vertex_count, tasks);
+  ForEachRange(bounds, parallel_for, [&](size_t, uint64_t begin, uint64_t end) {
+    for (auto vertex = begin; vertex < end; ++vertex) {
+      const auto *first_begin = forward.data() + forward_offsets[vertex];
+      const auto *first_end = forward.data() + forward_offsets[vertex + 1];
+      for (const auto *neighbour = first_begin; neighbour != first_end; ++neighbour) {
+        const auto *second = forward.data() + forward_offsets[*neighbour];
+        const auto *second_end = forward.data() + forward_offsets[*neighbour + 1];
+        // Both of the lists are sorted by the ordinal.
+        for (const auto *first = first_begin; first != first_end && second != second_end;) {
+          if (*first < *second) {
+            ++first;
+          } else if (*second < *first) {
+            ++second;
+          } else {
+            for (const auto member : {vertex, *neighbour, *first}) {
+              std::atomic_ref<uint64_t>(triangles[member]).fetch_add(1, std::memory_order_relaxed);
+            }
+            ++first;
+            ++second;
+          }
+        }
+      }
+    }
+  });
+  return triangles;
+}
+
+}  // namespace graph_algorithms
@@ -0,0 +1,195 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+/// Graph algorithms of the graph_algorithms query module. They work on the
+/// raw arrays of a graph in the compressed sparse row (CSR) format, so they
+/// don't depend on the query module API and can be tested and benchmarked on
+/// their own.
+namespace graph_algorithms {
+
+/// Read-only view of a graph in the CSR format, with the same layout as
+/// mgp_graph_projection. The vertices are identified by their ordinals, from 0
+/// up to, but not including, the vertex count.
+struct CsrGraph {
+  size_t vertex_count{0};
+  /// The outbound edges of the vertex `v` are stored at the indices from
+  /// `out_offsets[v]` up to, but not including, `out_offsets[v + 1]`.
+  const uint64_t *out_offsets{nullptr};
+  const uint64_t *out_targets{nullptr};
+  /// NULL if the edges are unweighted, in which case each weight is 1.
+  const double *out_weights{nullptr};
+  /// NULL if the inbound edges aren't available.
+  const uint64_t *in_offsets{nullptr};
+  const uint64_t *in_sources{nullptr};
+  const double *in_weights{nullptr};
+
+  size_t EdgeCount() const { return vertex_count == 0 ? 0 : out_offsets[vertex_count]; }
+  uint64_t OutDegree(uint64_t vertex) const { return out_offsets[vertex + 1] - out_offsets[vertex]; }
+};
+
+/// Executes the tasks from 0 up to, but not including, `task_count`, possibly
+/// in parallel, and returns once all of them are done. The tasks don't throw.
+using ParallelFor = std::function<void(size_t task_count, const std::function<void(size_t task)> &task)>;
+
+/// Executes the tasks one by one on the calling thread.
+void SequentialFor(size_t task_count, const std::function<void(size_t task)> &task);
+
+/// Splits the vertices into at most `parts` consecutive ranges, so that each
+/// of the ranges has about the same number of vertices and edges, given the
+/// CSR `offsets` of the edges. Returns the boundaries of the ranges, where the
+/// range `i` goes from `result[i]` up to, but not including, `result[i + 1]`.
+/// Splitting by the edges keeps the high degree vertices of the power-law
+/// graphs from ending up in a single task.
+std::vector<uint64_t> PartitionVertices(const uint64_t *offsets, size_t vertex_count, size_t parts);
+
+/// Undirected simple graph in the CSR format. The neighbours of each vertex
+/// are sorted and unique, and there are no self loops.
+struct UndirectedGraph {
+  std::vector<uint64_t> offsets;
+  std::vector<uint64_t> neighbours;
+};
+
+/// Merges the outbound and the inbound edges of `graph`, which has to have
+/// the inbound edges, into an undirected simple graph.
+UndirectedGraph MakeUndirected(const CsrGraph &graph, const ParallelFor &parallel_for, size_t tasks);
+
+struct PageRankConfig {
+  double damping_factor{0.85};
+  size_t max_iterations{100};
+  /// The iterations stop once the sum of the absolute rank changes is less.
+  double tolerance{1e-5};
+};
+
+/// Computes the PageRank of each vertex. The ranks sum up to 1, and the rank
+/// of the vertices without outbound edges is spread to all of the vertices.
+/// The ranks are pulled over the inbound edges, which `graph` has to have, so
+/// each vertex is written by a single task.
+std::vector<double> PageRank(const CsrGraph &graph, const PageRankConfig &config, const ParallelFor &parallel_for,
+                             size_t tasks);
+
+/// Computes the weakly connected components. Each vertex gets the smallest
+/// ordinal in its component. The edges are merged with a concurrent union-find,
+/// so the result doesn't depend on the order of the tasks.
+std::vector<uint64_t> WeaklyConnectedComponents(const CsrGraph &graph, const ParallelFor &parallel_for,
+                                                size_t tasks);
+
+/// Weakly connected components of a changing graph, whose vertices are
+/// identified by their IDs. Each component is labelled with the smallest
+/// vertex ID in it, and the component of each vertex is kept up to date, so
+/// it's read in O(1).
+///
+/// Adding an edge merges the components of its endpoints by moving the
+/// vertices of the smaller one, so each vertex is moved at most O(log n)
+/// times while the graph grows. The edges are stored as the number of the
+/// edges between each pair of the vertices. Removing the last edge between a
+/// pair searches from both of the endpoints at the same time, one vertex at a
+/// time from each side, until the searches meet or one of them runs out of
+/// vertices, in which case its vertices are split off into a new component.
+/// That costs O(size of the smaller part) when the component splits.
+class IncrementalComponents {
+ public:
+  /// Replaces the components with the ones of the `graph`, where the vertex
+  /// with the index `i` has the ID `vertex_ids[i]` and is in the component
+  /// `components[i]`, e.g. the result of the WeaklyConnectedComponents.
+  void Assign(const CsrGraph &graph, const int64_t *vertex_ids, const uint64_t *components);
+
+  /// Adds a vertex without edges, unless it's already added.
+  void AddVertex(int64_t vertex);
+
+  /// Adds an edge, merging the components of the endpoints and adding them if
+  /// necessary.
+  void AddEdge(int64_t from, int64_t to);
+
+  /// Removes an edge, splitting the component if the endpoints aren't
+  /// connected anymore. The edges which aren't added are ignored.
+  void RemoveEdge(int64_t from, int64_t to);
+
+  /// Removes a vertex together with its remaining edges.
+  void RemoveVertex(int64_t vertex);
+
+  /// Returns the label of the component of the vertex, or nullopt if the
+  /// vertex isn't added.
+  std::optional<int64_t> ComponentOf(int64_t vertex) const;
+
+  size_t VertexCount() const { return component_of_.size(); }
+  size_t ComponentCount() const { return components_.size(); }
+
+ private:
+  // Moves the vertices of the component of `a` and `b` which aren't
+  // connected to the other one into a new component.
+  void SplitIfDisconnected(int64_t a, int64_t b);
+
+  // The components are keyed by a number which doesn't change when they are
+  // merged into, unlike the label, which is the first of the vertices.
+  std::unordered_map<int64_t, uint64_t> component_of_;
+  std::unordered_map<uint64_t, std::set<int64_t>> components_;
+  // The number of the edges between the vertex and each of its neighbours,
+  // regardless of the direction. The loops aren't stored.
+  std::unordered_map<int64_t, std::unordered_map<int64_t, uint64_t>> neighbours_;
+  uint64_t next_key_{0};
+};
+
+/// Computes the strongly connected components with the Tarjan's algorithm,
+/// without recursion. The components are numbered from 0 in the reverse
+/// topological order of the condensed graph. It runs on a single thread.
+std::vector<uint64_t> StronglyConnectedComponents(const CsrGraph &graph);
+
+struct LabelPropagationConfig {
+  size_t max_iterations{10};
+};
+
+/// Detects the communities with the label propagation, treating the edges as
+/// undirected. Each vertex starts with its own ordinal as the label and takes
+/// the label with the largest weight among its neighbours, preferring the
+/// smallest one on ties. The labels are updated in rounds, from the labels of
+/// the previous round, so the result doesn't depend on the order of the tasks.
+/// Each vertex also votes for its current label, with the weight of its
+/// lightest edge, so that two neighbours don't keep swapping their labels.
+/// `graph` has to have the inbound edges.
+std::vector<uint64_t> LabelPropagation(const CsrGraph &graph, const LabelPropagationConfig &config,
+                                       const ParallelFor &parallel_for, size_t tasks);
+
+struct BetweennessConfig {
+  /// Number of the sampled source vertices. If 0 or at least the vertex count,
+  /// all of the vertices are used and the result is exact.
+  size_t samples{0};
+  /// If false, the edges are treated as undirected, and `graph` has to have
+  /// the inbound edges.
+  bool directed{true};
+  uint64_t seed{0};
+};
+
+/// Computes the betweenness centrality with the Brandes' algorithm, ignoring
+/// the weights. With the sampling, the centrality is approximated from the
+/// shortest paths starting in the sampled vertices and scaled to the whole
+/// graph. The sources are split between the tasks. For the undirected graphs,
+/// each path is counted once.
+std::vector<double> BetweennessCentrality(const CsrGraph &graph, const BetweennessConfig &config,
+                                          const ParallelFor &parallel_for, size_t tasks);
+
+/// Counts the triangles each vertex is a part of, treating the edges as
+/// undirected and ignoring the duplicate edges and the self loops. The edges
+/// are oriented from the lower to the higher degree vertex, so each triangle
+/// is found once, by intersecting the sorted neighbour lists. `graph` has to
+/// have the inbound edges.
+std::vector<uint64_t> TriangleCount(const CsrGraph &graph, const ParallelFor &parallel_for, size_t tasks);
+
+}  // namespace graph_algorithms
@@ -0,0 +1,330 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+// Native graph algorithms, which run on a CSR projection of the graph and use
+// the worker threads of Memgraph. The results are yielded in batches, with a
+// record for each of the projected vertices, e.g.:
+//   CALL graph_algorithms.pagerank() YIELD node, rank RETURN node, rank ORDER BY rank DESC LIMIT 10;
+//   CALL graph_algorithms.weakly_connected_components() YIELD node, component_id;
+//   CALL graph_algorithms.strongly_connected_components() YIELD node, component_id;
+//   CALL graph_algorithms.label_propagation(10, "weight") YIELD node, community_id;
+//   CALL graph_algorithms.betweenness_centrality(256) YIELD node, betweenness;
+//   CALL graph_algorithms.triangle_count() YIELD node, triangles;
+//
+// The incremental_wcc module, which is built from the same sources, keeps the
+// weakly connected components up to date after each commit. It isn't loaded by
+// default, because it adds work to every write transaction.
+
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "mg_procedure.h"
+
+#include "algorithms.hpp"
+#include "module_utils.hpp"
+
+namespace {
+
+using graph_algorithms::module::Check;
+using graph_algorithms::module::GetArg;
+using graph_algorithms::module::MakeValue;
+using graph_algorithms::module::Projection;
+using graph_algorithms::module::ProjectionConfig;
+using graph_algorithms::module::Type;
+using graph_algorithms::module::WorkerPool;
+using graph_algorithms::module::WrapErrors;
+
+// Results of an algorithm, which are yielded in batches. They are allocated
+// with the memory of the procedure call, so they are released with the call
+// even if the cleanup is skipped.
+struct Results {
+  const char *field;
+  size_t count;
+  size_t next;
+  int64_t *vertex_ids;
+  // One of the values is set, depending on the type of the field.
+  double *doubles;
+  int64_t *ints;
+};
+
+template <class T>
+T *Allocate(mgp_memory *memory, size_t count) {
+  void *data{nullptr};
+  Check(mgp_alloc(memory, std::max<size_t>(count, 1) * sizeof(T), &data), "allocate the results");
+  return static_cast<T *>(data);
+}
+
+void FreeResults(Results *results, mgp_memory *memory) {
+  if (!results) return;
+  for (void *data : {static_cast<void *>(results->vertex_ids), static_cast<void *>(results->doubles),
+                     static_cast<void *>(results->ints)}) {
+    if (data) mgp_free(memory, data);
+  }
+  mgp_free(memory, results);
+}
+
+// Allocates the results for all of the projected vertices, with the values
+// of the type `TValue`, which are filled in by `fill(values)`.
+template <class TValue, class TFill>
+Results *MakeResults(const char *field, mgp_graph_projection *projection, mgp_memory *memory, const TFill &fill) {
+  size_t count{0};
+  Check(mgp_graph_projection_vertex_count(projection, &count), "read the projection");
+  const int64_t *vertex_ids{nullptr};
+  Check(mgp_graph_projection_vertex_ids(projection, &vertex_ids), "read the projection");
+  auto *results = Allocate<Results>(memory, 1);
+  *results = Results{field, count, 0, nullptr, nullptr, nullptr};
+  try {
+    results->vertex_ids = Allocate<int64_t>(memory, count);
+    std::copy(vertex_ids, vertex_ids + count, results->vertex_ids);
+    auto *values = Allocate<TValue>(memory, count);
+    if constexpr (std::is_same_v<TValue, double>) {
+      results->doubles = values;
+    } else {
+      results->ints = values;
+    }
+    fill(values);
+  } catch (...) {
+    FreeResults(results, memory);
+    throw;
+  }
+  return results;
+}
+
+Results *MakeFloatResults(const char *field, mgp_graph_projection *projection, const std::vector<double> &values,
+                          mgp_memory *memory) {
+  return MakeResults<double>(field, projection, memory,
+                             [&](double *result) { std::copy(values.begin(), values.end(), result); });
+}
+
+Results *MakeIntResults(const char *field, mgp_graph_projection *projection, const std::vector<uint64_t> &values,
+                        mgp_memory *memory) {
+  return MakeResults<int64_t>(field, projection, memory, [&](int64_t *result) {
+    std::transform(values.begin(), values.end(), result, [](uint64_t value) { return static_cast<int64_t>(value); });
+  });
+}
+
+// Component and community labels are vertex ordinals, which are reported as
+// the IDs of those vertices.
+Results *MakeVertexLabelResults(const char *field, mgp_graph_projection *projection,
+                                const std::vector<uint64_t> &labels, mgp_memory *memory) {
+  const int64_t *vertex_ids{nullptr};
+  Check(mgp_graph_projection_vertex_ids(projection, &vertex_ids), "read the projection");
+  return MakeResults<int64_t>(field, projection, memory, [&](int64_t *result) {
+    std::transform(labels.begin(), labels.end(), result, [vertex_ids](uint64_t label) { return vertex_ids[label]; });
+  });
+}
+
+int64_t GetInt(mgp_list *args, size_t index) {
+  int64_t result{0};
+  Check(mgp_value_get_int(GetArg(args, index), &result), "read the arguments");
+  return result;
+}
+
+size_t GetCount(mgp_list *args, size_t index, const char *name) {
+  const auto value = GetInt(args, index);
+  if (value < 0) throw std::invalid_argument(std::string("The ") + name + " can't be negative.");
+  return static_cast<size_t>(value);
+}
+
+double GetDouble(mgp_list *args, size_t index) {
+  double result{0};
+  Check(mgp_value_get_double(GetArg(args, index), &result), "read the arguments");
+  return result;
+}
+
+bool GetBool(mgp_list *args, size_t index) {
+  int result{0};
+  Check(mgp_value_get_bool(GetArg(args, index), &result), "read the arguments");
+  return result != 0;
+}
+
+// Returns nullptr if the argument is null.
+const char *GetOptionalString(mgp_list *args, size_t index) {
+  auto *value = GetArg(args, index);
+  int is_null{0};
+  Check(mgp_value_is_null(value, &is_null), "read the arguments");
+  if (is_null) return nullptr;
+  const char *result{nullptr};
+  Check(mgp_value_get_string(value, &result), "read the arguments");
+  return result;
+}
+
+void PageRankInit(mgp_list *args, mgp_graph *graph, mgp_result *result, mgp_memory *memory, void **state) {
+  WrapErrors(result, [&] {
+    graph_algorithms::PageRankConfig config;
+    config.max_iterations = GetCount(args, 0, "max_iterations");
+    config.damping_factor = GetDouble(args, 1);
+    config.tolerance = GetDouble(args, 2);
+    const Projection projection(graph, ProjectionConfig(true), memory);
+    const WorkerPool pool(graph, memory);
+    const auto ranks = graph_algorithms::PageRank(projection.View(), config, pool.ParallelFor(), pool.Tasks());
+    *state = MakeFloatResults("rank", projection.get(), ranks, memory);
+  });
+}
+
+void WeaklyConnectedComponentsInit(mgp_list *, mgp_graph *graph, mgp_result *result, mgp_memory *memory,
+                                   void **state) {
+  WrapErrors(result, [&] {
+    const Projection projection(graph, ProjectionConfig(false), memory);
+    const WorkerPool pool(graph, memory);
+    const auto components =
+        graph_algorithms::WeaklyConnectedComponents(projection.View(), pool.ParallelFor(), pool.Tasks());
+    *state = MakeVertexLabelResults("component_id", projection.get(), components, memory);
+  });
+}
+
+void StronglyConnectedComponentsInit(mgp_list *, mgp_graph *graph, mgp_result *result, mgp_memory *memory,
+                                     void **state) {
+  WrapErrors(result, [&] {
+    const Projection projection(graph, ProjectionConfig(false), memory);
+    const auto components = graph_algorithms::StronglyConnectedComponents(projection.View());
+    *state = MakeIntResults("component_id", projection.get(), components, memory);
+  });
+}
+
+void LabelPropagationInit(mgp_list *args, mgp_graph *graph, mgp_result *result, mgp_memory *memory, void **state) {
+  WrapErrors(result, [&] {
+    graph_algorithms::LabelPropagationConfig config;
+    config.max_iterations = GetCount(args, 0, "max_iterations");
+    const Projection projection(graph, ProjectionConfig(true, GetOptionalString(args, 1)), memory);
+    const WorkerPool pool(graph, memory);
+    const auto labels =
+        graph_algorithms::LabelPropagation(projection.View(), config, pool.ParallelFor(), pool.Tasks());
+    *state = MakeVertexLabelResults("community_id", projection.get(), labels, memory);
+  });
+}
+
+void BetweennessCentralityInit(mgp_list *args, mgp_graph *graph, mgp_result *result, mgp_memory *memory,
+                               void **state) {
+  WrapErrors(result, [&] {
+    graph_algorithms::BetweennessConfig config;
+    config.samples = GetCount(args, 0, "samples");
+    config.directed = GetBool(args, 1);
+    config.seed = static_cast<uint64_t>(GetInt(args, 2));
+    const Projection projection(graph, ProjectionConfig(!config.directed), memory);
+    const WorkerPool pool(graph, memory);
+    const auto centrality =
+        graph_algorithms::BetweennessCentrality(projection.View(), config, pool.ParallelFor(), pool.Tasks());
+    *state = MakeFloatResults("betweenness", projection.get(), centrality, memory);
+  });
+}
+
+void TriangleCountInit(mgp_list *, mgp_graph *graph, mgp_result *result, mgp_memory *memory, void **state) {
+  WrapErrors(result, [&] {
+    const Projection projection(graph, ProjectionConfig(true), memory);
+    const WorkerPool pool(graph, memory);
+    const auto triangles = graph_algorithms::TriangleCount(projection.View(), pool.ParallelFor(), pool.Tasks());
+    *state = MakeIntResults("triangles", projection.get(), triangles, memory);
+  });
+}
+
+void YieldResults(mgp_list *, mgp_graph *graph, mgp_result *result, mgp_memory *memory, size_t row_budget,
+                  void *state) {
+  WrapErrors(result, [&] {
+    auto *results = static_cast<Results *>(state);
+    for (size_t rows = 0; rows < row_budget && results->next < results->count; ++results->next) {
+      const auto i = results->next;
+      mgp_vertex *vertex{nullptr};
+      Check(mgp_graph_get_vertex_by_id(graph, mgp_vertex_id{results->vertex_ids[i]}, memory, &vertex),
+            "get the vertex");
+      if (!vertex) continue;
+      ++rows;
+      mgp_value *node{nullptr};
+      if (const auto error = mgp_value_make_vertex(vertex, &node); error != MGP_ERROR_NO_ERROR) {
+        mgp_vertex_destroy(vertex);
+        Check(error, "yield the results");
+      }
+      const auto node_value = MakeValue(node);
+      mgp_value *value{nullptr};
+      if (results->doubles) {
+        Check(mgp_value_make_double(results->doubles[i], memory, &value), "yield the results");
+      } else {
+        Check(mgp_value_make_int(results->ints[i], memory, &value), "yield the results");
+      }
+      const auto field_value = MakeValue(value);
+      mgp_result_record *record{nullptr};
+      Check(mgp_result_new_record(result, &record), "yield the results");
+      Check(mgp_result_record_insert(record, "node", node_value.get()), "yield the results");
+      Check(mgp_result_record_insert(record, results->field, field_value.get()), "yield the results");
+    }
+  });
+}
+
+void CleanupResults(void *state, mgp_memory *memory) { FreeResults(static_cast<Results *>(state), memory); }
+
+mgp_proc *AddProcedure(mgp_module *module, const char *name, mgp_proc_batch_init init, const char *field,
+                       mgp_type *field_type) {
+  mgp_proc *proc{nullptr};
+  Check(mgp_module_add_batch_read_procedure(module, name, YieldResults, init, CleanupResults, &proc),
+        "add the procedure");
+  Check(mgp_proc_add_result(proc, "node", Type(mgp_type_node)), "add the result");
+  Check(mgp_proc_add_result(proc, field, field_type), "add the result");
+  return proc;
+}
+
+void AddOptArg(mgp_proc *proc, const char *name, mgp_type *type, mgp_error (*make_value)(mgp_memory *, mgp_value **),
+               mgp_memory *memory) {
+  mgp_value *value{nullptr};
+  Check(make_value(memory, &value), "make the default value");
+  const auto default_value = MakeValue(value);
+  Check(mgp_proc_add_opt_arg(proc, name, type, default_value.get()), "add the argument");
+}
+
+template <class TValue>
+void AddOptArg(mgp_proc *proc, const char *name, mgp_type *type,
+               mgp_error (*make_value)(TValue, mgp_memory *, mgp_value **), TValue default_value,
+               mgp_memory *memory) {
+  mgp_value *value{nullptr};
+  Check(make_value(default_value, memory, &value), "make the default value");
+  const auto value_ptr = MakeValue(value);
+  Check(mgp_proc_add_opt_arg(proc, name, type, value_ptr.get()), "add the argument");
+}
+
+}  // namespace
+
+// Each module needs to define mgp_init_module function.
+extern "C" int mgp_init_module(mgp_module *module, mgp_memory *memory) {
+  try {
+    auto *pagerank = AddProcedure(module, "pagerank", PageRankInit, "rank", Type(mgp_type_float));
+    AddOptArg<int64_t>(pagerank, "max_iterations", Type(mgp_type_int), mgp_value_make_int, 100, memory);
+    AddOptArg<double>(pagerank, "damping_factor", Type(mgp_type_float), mgp_value_make_double, 0.85, memory);
+    AddOptArg<double>(pagerank, "stop_epsilon", Type(mgp_type_float), mgp_value_make_double, 1e-5, memory);
+
+    AddProcedure(module, "weakly_connected_components", WeaklyConnectedComponentsInit, "component_id",
+                 Type(mgp_type_int));
+    AddProcedure(module, "strongly_connected_components", StronglyConnectedComponentsInit, "component_id",
+                 Type(mgp_type_int));
+
+    auto *label_propagation =
+        AddProcedure(module, "label_propagation", LabelPropagationInit, "community_id", Type(mgp_type_int));
+    AddOptArg<int64_t>(label_propagation, "max_iterations", Type(mgp_type_int), mgp_value_make_int, 10, memory);
+    mgp_type *nullable_string{nullptr};
+    Check(mgp_type_nullable(Type(mgp_type_string), &nullable_string), "get the type");
+    AddOptArg(label_propagation, "weight_property", nullable_string, mgp_value_make_null, memory);
+
+    auto *betweenness = AddProcedure(module, "betweenness_centrality", BetweennessCentralityInit, "betweenness",
+                                     Type(mgp_type_float));
+    AddOptArg<int64_t>(betweenness, "samples", Type(mgp_type_int), mgp_value_make_int, 0, memory);
+    AddOptArg<int>(betweenness, "directed", Type(mgp_type_bool), mgp_value_make_bool, 1, memory);
+    AddOptArg<int64_t>(betweenness, "seed", Type(mgp_type_int), mgp_value_make_int, 0, memory);
+
+    AddProcedure(module, "triangle_count", TriangleCountInit, "triangles", Type(mgp_type_int));
+  } catch (const std::exception &) {
+    return 1;
+  }
+  return 0;
+}
+
+extern "C" int mgp_shutdown_module() { return 0; }
@@ -0,0 +1,177 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+// Weakly connected components which are kept up to date by a change hook,
+// after each committed transaction, so the component of a vertex is read in
+// constant time, e.g.:
+//   MATCH (n) CALL incremental_wcc.get(n) YIELD component_id RETURN n, component_id;
+//   CALL incremental_wcc.stats() YIELD vertices, components, ready;
+//
+// While the module is loaded, the changes of every write transaction are
+// collected and delivered to the hook, and the adjacency of the whole graph is
+// kept in memory. That's why it isn't installed with the other modules, and it
+// has to be enabled by adding its directory to --query-modules-directory.
+
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+
+#include "mg_procedure.h"
+
+#include "algorithms.hpp"
+#include "module_utils.hpp"
+
+namespace {
+
+using graph_algorithms::module::Check;
+using graph_algorithms::module::GetArg;
+using graph_algorithms::module::MakeValue;
+using graph_algorithms::module::Projection;
+using graph_algorithms::module::ProjectionConfig;
+using graph_algorithms::module::Type;
+using graph_algorithms::module::WorkerPool;
+using graph_algorithms::module::WrapErrors;
+
+// Weakly connected components maintained by the change hook, which runs on a
+// single thread while the procedures read them.
+std::shared_mutex components_lock;
+graph_algorithms::IncrementalComponents maintained_components;
+// False until the components are built, and after they fail to update.
+bool components_ready{false};
+
+void RebuildComponents(mgp_graph *graph, mgp_memory *memory) {
+  try {
+    const Projection projection(graph, ProjectionConfig(false), memory);
+    const WorkerPool pool(graph, memory);
+    const auto view = projection.View();
+    const auto components = graph_algorithms::WeaklyConnectedComponents(view, pool.ParallelFor(), pool.Tasks());
+    const int64_t *vertex_ids{nullptr};
+    Check(mgp_graph_projection_vertex_ids(projection.get(), &vertex_ids), "read the projection");
+    graph_algorithms::IncrementalComponents rebuilt;
+    rebuilt.Assign(view, vertex_ids, components.data());
+    const std::unique_lock guard(components_lock);
+    maintained_components = std::move(rebuilt);
+    components_ready = true;
+  } catch (const std::exception &) {
+    const std::unique_lock guard(components_lock);
+    components_ready = false;
+  }
+}
+
+void UpdateComponents(mgp_changes *changes, mgp_memory *) {
+  const std::unique_lock guard(components_lock);
+  try {
+    if (!components_ready) {
+      Check(mgp_changes_request_rebuild(changes), "request the rebuild");
+      return;
+    }
+    const mgp_vertex_id *vertices{nullptr};
+    size_t vertex_count{0};
+    const mgp_edge_change *edges{nullptr};
+    size_t edge_count{0};
+    Check(mgp_changes_created_vertices(changes, &vertices, &vertex_count), "read the changes");
+    for (size_t i = 0; i < vertex_count; ++i) maintained_components.AddVertex(vertices[i].as_int);
+    Check(mgp_changes_created_edges(changes, &edges, &edge_count), "read the changes");
+    for (size_t i = 0; i < edge_count; ++i) maintained_components.AddEdge(edges[i].from.as_int, edges[i].to.as_int);
+    // The edges are removed before their endpoints, so that a deleted vertex
+    // usually has no edges left.
+    Check(mgp_changes_deleted_edges(changes, &edges, &edge_count), "read the changes");
+    for (size_t i = 0; i < edge_count; ++i) {
+      maintained_components.RemoveEdge(edges[i].from.as_int, edges[i].to.as_int);
+    }
+    Check(mgp_changes_deleted_vertices(changes, &vertices, &vertex_count), "read the changes");
+    for (size_t i = 0; i < vertex_count; ++i) maintained_components.RemoveVertex(vertices[i].as_int);
+  } catch (const std::exception &) {
+    // The state is only partially updated.
+    components_ready = false;
+    static_cast<void>(mgp_changes_request_rebuild(changes));
+  }
+}
+
+void Get(mgp_list *args, mgp_graph *, mgp_result *result, mgp_memory *memory) {
+  WrapErrors(result, [&] {
+    mgp_vertex *vertex{nullptr};
+    Check(mgp_value_get_vertex(GetArg(args, 0), &vertex), "read the arguments");
+    mgp_vertex_id id{};
+    Check(mgp_vertex_get_id(vertex, &id), "read the arguments");
+    std::optional<int64_t> component;
+    {
+      const std::shared_lock guard(components_lock);
+      if (components_ready) component = maintained_components.ComponentOf(id.as_int);
+    }
+    mgp_value *value{nullptr};
+    if (component) {
+      Check(mgp_value_make_int(*component, memory, &value), "yield the results");
+    } else {
+      Check(mgp_value_make_null(memory, &value), "yield the results");
+    }
+    const auto component_value = MakeValue(value);
+    mgp_result_record *record{nullptr};
+    Check(mgp_result_new_record(result, &record), "yield the results");
+    Check(mgp_result_record_insert(record, "component_id", component_value.get()), "yield the results");
+  });
+}
+
+void Stats(mgp_list *, mgp_graph *, mgp_result *result, mgp_memory *memory) {
+  WrapErrors(result, [&] {
+    size_t vertices{0};
+    size_t components{0};
+    bool ready{false};
+    {
+      const std::shared_lock guard(components_lock);
+      vertices = maintained_components.VertexCount();
+      components = maintained_components.ComponentCount();
+      ready = components_ready;
+    }
+    mgp_result_record *record{nullptr};
+    Check(mgp_result_new_record(result, &record), "yield the results");
+    const auto insert = [&](const char *field, mgp_value *value) {
+      const auto value_ptr = MakeValue(value);
+      Check(mgp_result_record_insert(record, field, value_ptr.get()), "yield the results");
+    };
+    mgp_value *value{nullptr};
+    Check(mgp_value_make_int(static_cast<int64_t>(vertices), memory, &value), "yield the results");
+    insert("vertices", value);
+    Check(mgp_value_make_int(static_cast<int64_t>(components), memory, &value), "yield the results");
+    insert("components", value);
+    Check(mgp_value_make_bool(ready ? 1 : 0, memory, &value), "yield the results");
+    insert("ready", value);
+  });
+}
+
+}  // namespace
+
+// Each module needs to define mgp_init_module function.
+extern "C" int mgp_init_module(mgp_module *module, mgp_memory * /*memory*/) {
+  try {
+    Check(mgp_module_add_change_hook(module, "components", RebuildComponents, UpdateComponents),
+          "add the change hook");
+    mgp_proc *get{nullptr};
+    Check(mgp_module_add_read_procedure(module, "get", Get, &get),
+          "add the procedure");
+    Check(mgp_proc_add_arg(get, "node", Type(mgp_type_node)), "add the argument");
+    mgp_type *nullable_int{nullptr};
+    Check(mgp_type_nullable(Type(mgp_type_int), &nullable_int), "get the type");
+    Check(mgp_proc_add_result(get, "component_id", nullable_int), "add the result");
+    mgp_proc *stats{nullptr};
+    Check(mgp_module_add_read_procedure(module, "stats", Stats, &stats),
+          "add the procedure");
+    Check(mgp_proc_add_result(stats, "vertices", Type(mgp_type_int)), "add the result");
+    Check(mgp_proc_add_result(stats, "components", Type(mgp_type_int)), "add the result");
+    Check(mgp_proc_add_result(stats, "ready", Type(mgp_type_bool)), "add the result");
+  } catch (const std::exception &) {
+    return 1;
+  }
+  return 0;
+}
+
+extern "C" int mgp_shutdown_module() { return 0; }
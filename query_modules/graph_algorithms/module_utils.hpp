@@ -0,0 +1,135 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+#include "mg_procedure.h"
+
+#include "algorithms.hpp"
+
+/// Helpers of the query modules which are built from the graph algorithms,
+/// which wrap the C API of the query modules.
+namespace graph_algorithms::module {
+
+// Number of the tasks for each of the workers, so the workers which finish
+// early can take over some of the work of the others.
+inline constexpr size_t kTasksPerWorker = 4;
+
+inline void Check(mgp_error error, const char *what) {
+  if (error == MGP_ERROR_UNABLE_TO_ALLOCATE) throw std::bad_alloc();
+  if (error != MGP_ERROR_NO_ERROR) throw std::runtime_error(std::string("Unable to ") + what + ".");
+}
+
+using ValuePtr = std::unique_ptr<mgp_value, decltype(&mgp_value_destroy)>;
+
+inline ValuePtr MakeValue(mgp_value *value) { return ValuePtr(value, &mgp_value_destroy); }
+
+// Owns a mgp_graph_projection.
+class Projection final {
+ public:
+  Projection(mgp_graph *graph, mgp_graph_projection_config config, mgp_memory *memory) {
+    Check(mgp_graph_project(graph, &config, memory, &projection_), "project the graph");
+  }
+
+  Projection(const Projection &) = delete;
+  Projection &operator=(const Projection &) = delete;
+  Projection(Projection &&) = delete;
+  Projection &operator=(Projection &&) = delete;
+
+  ~Projection() { mgp_graph_projection_destroy(projection_); }
+
+  mgp_graph_projection *get() const { return projection_; }
+
+  graph_algorithms::CsrGraph View() const {
+    graph_algorithms::CsrGraph view;
+    Check(mgp_graph_projection_vertex_count(projection_, &view.vertex_count), "read the projection");
+    Check(mgp_graph_projection_out_offsets(projection_, &view.out_offsets), "read the projection");
+    Check(mgp_graph_projection_out_targets(projection_, &view.out_targets), "read the projection");
+    Check(mgp_graph_projection_out_weights(projection_, &view.out_weights), "read the projection");
+    Check(mgp_graph_projection_in_offsets(projection_, &view.in_offsets), "read the projection");
+    Check(mgp_graph_projection_in_sources(projection_, &view.in_sources), "read the projection");
+    Check(mgp_graph_projection_in_weights(projection_, &view.in_weights), "read the projection");
+    return view;
+  }
+
+ private:
+  mgp_graph_projection *projection_{nullptr};
+};
+
+// Executes the tasks on the workers of Memgraph.
+class WorkerPool final {
+ public:
+  WorkerPool(mgp_graph *graph, mgp_memory *memory) : graph_(graph), memory_(memory) {
+    size_t workers = 1;
+    Check(mgp_graph_worker_count(graph, &workers), "get the worker count");
+    tasks_ = workers * kTasksPerWorker;
+  }
+
+  size_t Tasks() const { return tasks_; }
+
+  graph_algorithms::ParallelFor ParallelFor() const {
+    return [graph = graph_, memory = memory_](size_t task_count, const std::function<void(size_t)> &task) {
+      const auto run_task = [](size_t task_index, mgp_graph *, mgp_memory *, void *data) {
+        (*static_cast<const std::function<void(size_t)> *>(data))(task_index);
+      };
+      Check(mgp_graph_parallel_for(graph, task_count, run_task, const_cast<std::function<void(size_t)> *>(&task),
+                                   memory),
+            "run the tasks");
+      // The tasks which haven't started before the query was aborted were
+      // skipped, so the results aren't complete.
+      if (mgp_must_abort(graph)) throw std::runtime_error("The query was aborted.");
+    };
+  }
+
+ private:
+  mgp_graph *graph_;
+  mgp_memory *memory_;
+  size_t tasks_{1};
+};
+
+template <class TFunc>
+void WrapErrors(mgp_result *result, const TFunc &func) {
+  try {
+    func();
+  } catch (const std::exception &e) {
+    // Best effort. If it fails, there is nothing we can do.
+    static_cast<void>(mgp_result_set_error_msg(result, e.what()));
+  }
+}
+
+inline mgp_value *GetArg(mgp_list *args, size_t index) {
+  mgp_value *value{nullptr};
+  Check(mgp_list_at(args, index, &value), "read the arguments");
+  return value;
+}
+
+inline mgp_type *Type(mgp_error (*get_type)(mgp_type **)) {
+  mgp_type *type{nullptr};
+  Check(get_type(&type), "get the type");
+  return type;
+}
+
+inline mgp_graph_projection_config ProjectionConfig(bool include_in_edges, const char *weight_property = nullptr) {
+  return mgp_graph_projection_config{.vertex_label = nullptr,
+                                     .edge_type = nullptr,
+                                     .weight_property = weight_property,
+                                     .default_weight = 1.0,
+                                     .include_in_edges = include_in_edges ? 1 : 0};
+}
+
+}  // namespace graph_algorithms::module
@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <string_view>
 #include <type_traits>
 
 #include "communication/bolt/v1/codes.hpp"
@@ -97,9 +98,9 @@ class BaseEncoder {
     }
   }
 
-  void WriteString(const std::string &value) {
+  void WriteString(std::string_view value) {
     WriteTypeSize(value.size(), MarkerString);
-    WriteRAW(value.c_str(), value.size());
+    WriteRAW(value.data(), value.size());
   }
 
   void WriteList(const std::vector<Value> &value) {
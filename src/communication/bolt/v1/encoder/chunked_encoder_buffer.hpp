@@ -11,9 +11,12 @@
 
 #pragma once
 
+#include <sys/uio.h>
+
 #include <algorithm>
 #include <cstring>
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include "communication/bolt/v1/constants.hpp"
@@ -40,14 +43,29 @@ namespace communication::bolt {
  * can control when the message is over and the whole message isn't
  * unnecessarily buffered in memory.
  *
- * The current implementation stores only a single chunk into memory and sends
- * it immediately to the output stream when new data arrives.
+ * The chunks are built in an internal buffer, each with its header in front
+ * of its data. While the user announces that more data follows, the finished
+ * chunks are kept in the buffer, and are sent to the output stream with a
+ * single write once the buffer holds `kMaxBufferedSize` bytes or the user
+ * flushes without more data following.
+ *
+ * If the output stream supports vectored writes (a `WriteVectored` method
+ * which is enabled by `CanWriteVectored`), the large pieces of data written
+ * with `WriteReferenced` aren't copied into the buffer. The buffer only
+ * references them, and the chunk headers and data are sent together with a
+ * single vectored write.
  *
  * @tparam TOutputStream the output stream that should be used
  */
 template <class TOutputStream>
 class ChunkedEncoderBuffer {
  public:
+  /** Number of copied bytes after which the finished chunks are sent out. */
+  static constexpr size_t kMaxBufferedSize = 2 * kChunkWholeSize;
+
+  /** Pieces of data smaller than this are copied even when referencing. */
+  static constexpr size_t kMinReferencedSize = 4096;
+
   ChunkedEncoderBuffer(TOutputStream &output_stream) : output_stream_(output_stream) {}
 
   /**
@@ -57,29 +75,17 @@ class ChunkedEncoderBuffer {
    * @param values data array of bytes
    * @param n is the number of bytes
    */
-  void Write(const uint8_t *values, size_t n) {
-    size_t written = 0;
-
-    while (n > 0) {
-      // Define the number of bytes which will be copied into the chunk because
-      // the internal storage is a fixed length array.
-      size_t size = n < kChunkMaxDataSize - have_ ? n : kChunkMaxDataSize - have_;
-
-      // Copy `size` values to the chunk array.
-      std::memcpy(chunk_.data() + kChunkHeaderSize + have_, values + written, size);
-
-      // Update positions. The position pointer and incoming size have to be
-      // updated because all incoming values have to be processed.
-      written += size;
-      have_ += size;
-      n -= size;
+  void Write(const uint8_t *values, size_t n) { Append(values, n, false); }
 
-      // If the chunk is full, send it to the output stream and clear the
-      // internal storage to make space for other incoming values that are left
-      // in the values array.
-      if (have_ == kChunkMaxDataSize) Flush(true);
-    }
-  }
+  /**
+   * Writes n values into the buffer like `Write`, but the large pieces of the
+   * values are referenced instead of copied when the output stream supports
+   * it. The values have to stay valid until the next `Flush` or `Clear`.
+   *
+   * @param values data array of bytes
+   * @param n is the number of bytes
+   */
+  void WriteReferenced(const uint8_t *values, size_t n) { Append(values, n, CanWriteVectored()); }
 
   /**
    * Wrap the data from the chunk array (append the size header) and send
@@ -87,24 +93,62 @@ class ChunkedEncoderBuffer {
    *
    * @param have_more this parameter is passed to the underlying output stream
    *                  `Write` method to indicate wether we have more data
-   *                  waiting to be sent (in order to optimize network packets)
+   *                  waiting to be sent (in order to optimize network packets).
+   *                  The data is kept in the buffer while there is more
+   *                  data coming and the buffer isn't full.
    */
   bool Flush(bool have_more = false) {
-    // Write the size of the chunk.
-    chunk_[0] = have_ >> 8;
-    chunk_[1] = have_ & 0xFF;
-
-    // Write the data to the stream.
-    auto ret = output_stream_.Write(chunk_.data(), kChunkHeaderSize + have_, have_more);
+    rollback_point_ = std::nullopt;
+    FinishChunk();
+    // The referenced data is valid only until this call returns.
+    if (have_more && !has_references_ && data_.size() < kMaxBufferedSize) return true;
+    return WriteBuffered(have_more);
+  }
 
-    // Cleanup.
-    Clear();
+  /**
+   * Marks the current position of the buffer, so that the data written after
+   * it can be discarded with `Rollback`. Until the next `Flush`, `Clear` or
+   * `Rollback` none of the data is sent to the output stream, no matter how
+   * large the buffer grows.
+   */
+  void MarkRollbackPoint() {
+    rollback_point_ = RollbackPoint{segments_.size(),
+                                    segments_.empty() ? 0 : segments_.back().size,
+                                    data_.size(),
+                                    have_,
+                                    chunk_header_,
+                                    chunk_open_,
+                                    finished_segments_,
+                                    finished_data_};
+  }
 
-    return ret;
+  /** Discards the data written after the last `MarkRollbackPoint`. */
+  void Rollback() {
+    if (!rollback_point_) return;
+    const auto &point = *rollback_point_;
+    segments_.resize(point.segments);
+    if (!segments_.empty()) segments_.back().size = point.last_segment_size;
+    data_.resize(point.data);
+    have_ = point.have;
+    chunk_header_ = point.chunk_header;
+    chunk_open_ = point.chunk_open;
+    finished_segments_ = point.finished_segments;
+    finished_data_ = point.finished_data;
+    // The header of the chunk which was open at the mark may have been
+    // written since, but it is rewritten when the chunk is finished again.
+    has_references_ = std::any_of(segments_.begin(), segments_.end(), [](const auto &s) { return s.external; });
+    rollback_point_ = std::nullopt;
   }
 
-  /** Clears the internal buffers. */
-  void Clear() { have_ = 0; }
+  /** Clears the data which isn't flushed yet. */
+  void Clear() {
+    rollback_point_ = std::nullopt;
+    segments_.resize(finished_segments_);
+    data_.resize(finished_data_);
+    have_ = 0;
+    chunk_open_ = false;
+    has_references_ = std::any_of(segments_.begin(), segments_.end(), [](const auto &s) { return s.external; });
+  }
 
   /**
    * Returns a boolean indicating whether there is data in the buffer.
@@ -114,13 +158,148 @@ class ChunkedEncoderBuffer {
   bool HasData() { return have_ > 0; }
 
  private:
+  // A piece of the data which is sent. It is either a part of `data_` or
+  // the data referenced by the user.
+  struct Segment {
+    const uint8_t *external;
+    size_t offset;
+    size_t size;
+  };
+
+  bool CanWriteVectored() const {
+    if constexpr (requires(TOutputStream & stream, const iovec *iov) { stream.WriteVectored(iov, 0, false); }) {
+      return output_stream_.CanWriteVectored();
+    } else {
+      return false;
+    }
+  }
+
+  // The state of the buffer at the rollback point.
+  struct RollbackPoint {
+    size_t segments;
+    size_t last_segment_size;
+    size_t data;
+    size_t have;
+    size_t chunk_header;
+    bool chunk_open;
+    size_t finished_segments;
+    size_t finished_data;
+  };
+
+  void Append(const uint8_t *values, size_t n, bool reference) {
+    while (n > 0) {
+      // Define the number of bytes which will be put into the chunk because
+      // a chunk can hold at most `kChunkMaxDataSize` bytes.
+      size_t size = std::min(n, kChunkMaxDataSize - have_);
+
+      if (!chunk_open_) OpenChunk();
+      if (reference && size >= kMinReferencedSize) {
+        segments_.push_back({values, 0, size});
+        has_references_ = true;
+      } else {
+        AppendData(values, size);
+      }
+
+      // Update positions. The position pointer and incoming size have to be
+      // updated because all incoming values have to be processed.
+      values += size;
+      have_ += size;
+      n -= size;
+
+      // If the chunk is full, finish it and start a new one for the other
+      // incoming values that are left in the values array. The referenced
+      // values are valid until the user flushes, so only the copied data can
+      // fill up the buffer here.
+      if (have_ == kChunkMaxDataSize) {
+        FinishChunk();
+        if (data_.size() >= kMaxBufferedSize && !rollback_point_) WriteBuffered(true);
+      }
+    }
+  }
+
+  void AppendData(const uint8_t *values, size_t size) {
+    // The data is appended to the last segment if it's also a part of `data_`.
+    if (segments_.empty() || segments_.back().external) {
+      segments_.push_back({nullptr, data_.size(), 0});
+    }
+    data_.insert(data_.end(), values, values + size);
+    segments_.back().size += size;
+  }
+
+  // Reserves the space for the header of the next chunk.
+  void OpenChunk() {
+    chunk_header_ = data_.size();
+    const uint8_t header[kChunkHeaderSize] = {0, 0};
+    AppendData(header, kChunkHeaderSize);
+    chunk_open_ = true;
+  }
+
+  // Writes the size of the current chunk into its header. A chunk is always
+  // finished, even if it's empty, because the empty chunk marks the end of
+  // the message.
+  void FinishChunk() {
+    if (!chunk_open_) OpenChunk();
+    data_[chunk_header_] = have_ >> 8;
+    data_[chunk_header_ + 1] = have_ & 0xFF;
+    have_ = 0;
+    chunk_open_ = false;
+    finished_segments_ = segments_.size();
+    finished_data_ = data_.size();
+  }
+
+  // Sends all of the finished chunks to the output stream.
+  bool WriteBuffered(bool have_more) {
+    bool ret = true;
+    if (!data_.empty()) {
+      if (has_references_) {
+        iovecs_.clear();
+        for (const auto &segment : segments_) {
+          const auto *base = segment.external ? segment.external : data_.data() + segment.offset;
+          iovecs_.push_back({const_cast<uint8_t *>(base), segment.size});
+        }
+        if constexpr (requires(TOutputStream & stream, const iovec *iov) { stream.WriteVectored(iov, 0, false); }) {
+          ret = output_stream_.WriteVectored(iovecs_.data(), iovecs_.size(), have_more);
+        }
+      } else {
+        // Without the references all of the data is already in one piece.
+        ret = output_stream_.Write(data_.data(), data_.size(), have_more);
+      }
+    }
+
+    // Cleanup.
+    segments_.clear();
+    data_.clear();
+    has_references_ = false;
+    finished_segments_ = 0;
+    finished_data_ = 0;
+
+    return ret;
+  }
+
   // The output stream used.
   TOutputStream &output_stream_;
 
-  // Buffer for a single chunk.
-  std::array<uint8_t, kChunkWholeSize> chunk_;
+  // The chunk headers and the copied data of all buffered chunks.
+  std::vector<uint8_t> data_;
+  std::vector<Segment> segments_;
+  // Reused for the vectored writes.
+  std::vector<iovec> iovecs_;
+
+  // Position of the header of the current chunk in `data_`.
+  size_t chunk_header_{0};
+  bool chunk_open_{false};
 
-  // Amount of data in chunk array.
+  // Amount of data in the current chunk.
   size_t have_{0};
+
+  // Whether any of the buffered data is referenced.
+  bool has_references_{false};
+
+  // The sizes of the buffers at the end of the last finished chunk, which
+  // are restored by `Clear`.
+  size_t finished_segments_{0};
+  size_t finished_data_{0};
+
+  std::optional<RollbackPoint> rollback_point_;
 };
 }  // namespace communication::bolt
@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include <concepts>
+
 #include "communication/bolt/v1/codes.hpp"
 #include "communication/bolt/v1/encoder/base_encoder.hpp"
 
@@ -58,6 +60,33 @@ class Encoder : private BaseEncoder<Buffer> {
     return buffer_.Flush(true);
   }
 
+  /**
+   * Sends a Record message whose list of fields is encoded by `write_fields`,
+   * which is called with the buffer to write the encoded list into.
+   *
+   * If `write_fields` throws, the part of the message which was already
+   * written is discarded and the exception is rethrown, so nothing of the
+   * message is sent.
+   *
+   * @param write_fields callable which writes the Bolt encoded list of the
+   *                     fields into the buffer it's given
+   */
+  template <class TWriteFields>
+  requires std::invocable<TWriteFields, Buffer &>
+  bool MessageRecord(TWriteFields &&write_fields) {
+    buffer_.MarkRollbackPoint();
+    try {
+      WriteRAW(utils::UnderlyingCast(Marker::TinyStruct1));
+      WriteRAW(utils::UnderlyingCast(Signature::Record));
+      write_fields(buffer_);
+    } catch (...) {
+      buffer_.Rollback();
+      throw;
+    }
+    if (!buffer_.Flush(true)) return false;
+    return buffer_.Flush(true);
+  }
+
   /**
    * Sends a Success message.
    *
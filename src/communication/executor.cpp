@@ -0,0 +1,146 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "communication/executor.hpp"
+
+#include <exception>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "utils/logging.hpp"
+#include "utils/thread.hpp"
+
+namespace communication {
+
+Executor::Executor(ExecutorConfig config, std::string name)
+    : config_(config),
+      name_(std::move(name)),
+      limits_{config.interactive_workers, config.analytical_workers},
+      running_tasks_(config.interactive_workers + config.analytical_workers) {
+  MG_ASSERT(config.interactive_workers > 0 && config.analytical_workers > 0,
+            "The executor needs at least one worker for each execution class!");
+}
+
+Executor::~Executor() {
+  MG_ASSERT(workers_.empty(), "You should call Shutdown on communication::Executor!");
+}
+
+void Executor::Start() {
+  {
+    std::lock_guard guard(mutex_);
+    MG_ASSERT(!alive_, "The executor is already started!");
+    alive_ = true;
+  }
+  for (size_t i = 0; i < running_tasks_.size(); ++i) {
+    workers_.emplace_back([this, i] {
+      utils::ThreadSetName(fmt::format("{} exec {}", name_, i + 1));
+      WorkerLoop(i);
+    });
+  }
+}
+
+void Executor::Submit(ExecutionClass execution_class, Task task) {
+  {
+    std::lock_guard guard(mutex_);
+    if (!alive_) return;
+    queues_[Index(execution_class)].push_back(std::move(task));
+  }
+  cv_.notify_one();
+}
+
+void Executor::Shutdown() {
+  {
+    std::lock_guard guard(mutex_);
+    alive_ = false;
+    for (auto &queue : queues_) queue.clear();
+  }
+  cv_.notify_all();
+  for (auto &worker : workers_) {
+    if (worker.joinable()) worker.join();
+  }
+  workers_.clear();
+}
+
+size_t Executor::RunningTasks(ExecutionClass execution_class) const {
+  std::lock_guard guard(mutex_);
+  return running_[Index(execution_class)];
+}
+
+std::optional<std::chrono::steady_clock::duration> Executor::DemoteLongTasks() {
+  const auto now = std::chrono::steady_clock::now();
+  std::optional<std::chrono::steady_clock::duration> until_next;
+  for (auto &task : running_tasks_) {
+    if (!task || task->execution_class != ExecutionClass::INTERACTIVE) continue;
+    const auto elapsed = now - task->start;
+    if (elapsed < config_.analytical_threshold) {
+      const auto remaining = config_.analytical_threshold - elapsed;
+      if (!until_next || remaining < *until_next) until_next = remaining;
+      continue;
+    }
+    if (running_[Index(ExecutionClass::ANALYTICAL)] >= limits_[Index(ExecutionClass::ANALYTICAL)]) continue;
+    task->execution_class = ExecutionClass::ANALYTICAL;
+    --running_[Index(ExecutionClass::INTERACTIVE)];
+    ++running_[Index(ExecutionClass::ANALYTICAL)];
+  }
+  return until_next;
+}
+
+std::optional<ExecutionClass> Executor::NextExecutionClass() const {
+  for (const auto execution_class : {ExecutionClass::INTERACTIVE, ExecutionClass::ANALYTICAL}) {
+    const auto index = Index(execution_class);
+    if (!queues_[index].empty() && running_[index] < limits_[index]) return execution_class;
+  }
+  return std::nullopt;
+}
+
+void Executor::WorkerLoop(const size_t worker_id) {
+  std::unique_lock lock(mutex_);
+  while (alive_) {
+    auto execution_class = NextExecutionClass();
+    if (!execution_class) {
+      // The waiting interactive tasks can start as soon as one of the running
+      // ones is demoted, so the workers wake up when that can happen. The
+      // demotions which wait for room in the analytical class are retried when
+      // an analytical task finishes and notifies the workers.
+      const auto until_next_demotion = DemoteLongTasks();
+      if (NextExecutionClass()) continue;
+      if (!queues_[Index(ExecutionClass::INTERACTIVE)].empty() && until_next_demotion) {
+        cv_.wait_for(lock, *until_next_demotion);
+      } else {
+        cv_.wait(lock);
+      }
+      continue;
+    }
+
+    auto &queue = queues_[Index(*execution_class)];
+    auto task = std::move(queue.front());
+    queue.pop_front();
+    ++running_[Index(*execution_class)];
+    auto &running_task = running_tasks_[worker_id];
+    running_task.emplace(RunningTask{*execution_class, std::chrono::steady_clock::now()});
+
+    lock.unlock();
+    try {
+      task();
+    } catch (const std::exception &e) {
+      spdlog::error("Exception was thrown while executing a {} task: {}", name_, e.what());
+    }
+    lock.lock();
+
+    // The task may have been demoted while it was running.
+    --running_[Index(running_task->execution_class)];
+    running_task.reset();
+    cv_.notify_all();
+  }
+}
+
+}  // namespace communication
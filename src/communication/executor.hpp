@@ -0,0 +1,132 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace communication {
+
+/**
+ * Classes of the work executed by the `Executor`. Each class has its own
+ * concurrency limit, so that the long running work can't take all of the
+ * workers away from the short one.
+ */
+enum class ExecutionClass : uint8_t {
+  // Short requests, e.g. point lookups, which should be served with low
+  // latency.
+  INTERACTIVE,
+  // Long running requests, e.g. analytical queries.
+  ANALYTICAL,
+};
+
+struct ExecutorConfig {
+  // Maximum number of interactive tasks running at the same time.
+  size_t interactive_workers{1};
+  // Maximum number of analytical tasks running at the same time.
+  size_t analytical_workers{1};
+  // Interactive tasks which run longer than this are counted as analytical
+  // from then on, so they stop taking up the interactive workers.
+  std::chrono::milliseconds analytical_threshold{1000};
+};
+
+/**
+ * This class executes tasks on a pool of worker threads, separately from the
+ * threads which handle the network I/O. There are as many workers as the
+ * concurrency limits of all classes allow in total. When both classes have
+ * tasks waiting, the interactive ones are started first.
+ *
+ * The class of a task is known only roughly when it's submitted, so a running
+ * interactive task is moved to the analytical class once it runs longer than
+ * the threshold, as long as the analytical class has room for it. That frees
+ * its interactive slot for the next waiting task.
+ */
+class Executor final {
+ public:
+  using Task = std::function<void()>;
+
+  Executor(ExecutorConfig config, std::string name);
+
+  ~Executor();
+
+  Executor(const Executor &) = delete;
+  Executor(Executor &&) = delete;
+  Executor &operator=(const Executor &) = delete;
+  Executor &operator=(Executor &&) = delete;
+
+  /**
+   * This function starts the worker threads.
+   */
+  void Start();
+
+  /**
+   * This function queues the task for execution in the given class. Tasks
+   * submitted after the shutdown are dropped.
+   */
+  void Submit(ExecutionClass execution_class, Task task);
+
+  /**
+   * This function drops all of the waiting tasks and blocks the calling thread
+   * until the running ones are finished.
+   */
+  void Shutdown();
+
+  /**
+   * Returns the number of tasks of the given class which are currently
+   * running.
+   */
+  size_t RunningTasks(ExecutionClass execution_class) const;
+
+  const ExecutorConfig &config() const { return config_; }
+
+ private:
+  // The task which is currently executed by a worker.
+  struct RunningTask {
+    ExecutionClass execution_class;
+    std::chrono::steady_clock::time_point start;
+  };
+
+  void WorkerLoop(size_t worker_id);
+
+  // Moves the interactive tasks which are running longer than the threshold
+  // to the analytical class. Returns the time until the next running
+  // interactive task reaches the threshold.
+  std::optional<std::chrono::steady_clock::duration> DemoteLongTasks();
+
+  std::optional<ExecutionClass> NextExecutionClass() const;
+
+  static size_t Index(ExecutionClass execution_class) { return static_cast<size_t>(execution_class); }
+
+  const ExecutorConfig config_;
+  const std::string name_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable cv_;
+  std::array<std::deque<Task>, 2> queues_;
+  std::array<size_t, 2> running_{0, 0};
+  std::array<size_t, 2> limits_;
+  std::vector<std::optional<RunningTask>> running_tasks_;
+  bool alive_{false};
+
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace communication
@@ -14,14 +14,19 @@
 #include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <thread>
+#include <variant>
 
 #include <gflags/gflags.h>
 
+#include "communication/executor.hpp"
 #include "communication/session.hpp"
 #include "io/network/epoll.hpp"
+#include "io/network/io_uring.hpp"
 #include "io/network/socket.hpp"
 #include "utils/logging.hpp"
 #include "utils/signals.hpp"
@@ -30,6 +35,16 @@
 
 namespace communication {
 
+/**
+ * The mechanism which the `Listener` uses to wait for the events on the
+ * sessions' sockets.
+ */
+enum class IoBackend : uint8_t {
+  EPOLL,
+  // Polls the sockets through io_uring, see `io::network::IoUring`.
+  IO_URING,
+};
+
 /**
  * This class listens to events on an epoll object and processes them.
  * When a new connection is added a `TSession` object is created to handle the
@@ -38,6 +53,17 @@ namespace communication {
  * closed. Also, this class has a background thread that periodically, every
  * second, checks all sessions for expiration and shuts them down if they have
  * expired.
+ *
+ * When the listener is given an `ExecutorConfig`, its workers only read the
+ * data from the sockets, and the sessions are executed by an `Executor`. That
+ * way a long running execution doesn't take a worker away from the other
+ * sessions' network I/O, and the executor can limit how many long executions
+ * run at the same time.
+ *
+ * The sockets are polled either with epoll or with io_uring, depending on the
+ * given `IoBackend`. The io_uring backend submits the (re)arming of the polls
+ * in batches and takes the ready events without system calls, which saves a
+ * system call per request under a high number of connections.
  */
 template <class TSession, class TSessionData>
 class Listener final {
@@ -52,13 +78,23 @@ class Listener final {
 
  public:
   Listener(TSessionData *data, ServerContext *context, int inactivity_timeout_sec, const std::string &service_name,
-           size_t workers_count)
+           size_t workers_count, std::optional<ExecutorConfig> executor_config = std::nullopt,
+           IoBackend io_backend = IoBackend::EPOLL)
       : data_(data),
         alive_(false),
         context_(context),
         inactivity_timeout_sec_(inactivity_timeout_sec),
         service_name_(service_name),
-        workers_count_(workers_count) {}
+        workers_count_(workers_count) {
+    if (executor_config) executor_.emplace(*executor_config, service_name);
+    if (io_backend == IoBackend::IO_URING) {
+      if (io::network::IoUring::IsSupported()) {
+        poller_.emplace<io::network::IoUring>();
+      } else {
+        spdlog::warn("The kernel doesn't support io_uring, {} will use epoll instead.", service_name_);
+      }
+    }
+  }
 
   ~Listener() {
     bool worker_alive = false;
@@ -96,7 +132,8 @@ class Listener final {
     // concurrently and that is why we use `EPOLLONESHOT`, for a detailed
     // description what are the problems and why this is correct see:
     // https://idea.popcount.org/2017-02-20-epoll-is-fundamentally-broken-12/
-    epoll_.Add(fd, EPOLLIN | EPOLLET | EPOLLRDHUP | EPOLLONESHOT, sessions_.back().get());
+    auto *session = sessions_.back().get();
+    std::visit([&](auto &poller) { poller.Add(fd, EPOLLIN | EPOLLET | EPOLLRDHUP | EPOLLONESHOT, session); }, poller_);
   }
 
   /**
@@ -107,6 +144,12 @@ class Listener final {
     alive_.store(true);
 
     spdlog::info("Starting {} {} workers", workers_count_, service_name_);
+    if (executor_) {
+      const auto &config = executor_->config();
+      spdlog::info("Starting {} {} executors for interactive and {} for analytical sessions", service_name_,
+                   config.interactive_workers, config.analytical_workers);
+      executor_->Start();
+    }
 
     std::string service_name(service_name_);
     for (size_t i = 0; i < workers_count_; ++i) {
@@ -156,6 +199,9 @@ class Listener final {
     for (auto &worker_thread : worker_threads_) {
       if (worker_thread.joinable()) worker_thread.join();
     }
+    // The executions which haven't started yet are dropped, same as the events
+    // which the workers haven't taken.
+    if (executor_) executor_->Shutdown();
     // Here we free all active connections to close them and notify the other
     // end that we won't process them because we stopped all worker threads.
     std::lock_guard<utils::SpinLock> guard(lock_);
@@ -176,7 +222,7 @@ class Listener final {
     // Waits for an events and returns a maximum of max_events (1)
     // and stores them in the events array. It waits for wait_timeout
     // milliseconds. If wait_timeout is achieved, returns 0.
-    int n = epoll_.Wait(events, kMaxEvents, 200);
+    int n = std::visit([&](auto &poller) { return poller.Wait(events, kMaxEvents, 200); }, poller_);
     if (n <= 0) return;
 
     // Process the event.
@@ -194,9 +240,13 @@ class Listener final {
     // and calling a function on that session after that would cause a
     // segfault.
     if (event.events & EPOLLIN) {
-      // Read and process all incoming data.
-      while (ExecuteSession(session))
-        ;
+      if (executor_) {
+        ReadAndSubmitSession(session);
+      } else {
+        // Read and process all incoming data.
+        while (ExecuteSession(session))
+          ;
+      }
     } else if (event.events & EPOLLRDHUP) {
       // The client closed the connection.
       spdlog::info("{} client {} closed the connection.", service_name_, session.socket().endpoint());
@@ -214,17 +264,57 @@ class Listener final {
   }
 
   bool ExecuteSession(SessionHandler &session) {
+    bool done = false;
+    if (!HandleSessionErrors(session, [&] { done = session.Execute(); })) return false;
+    if (done) {
+      // Session execution done, rearm epoll to send events for this
+      // socket.
+      RearmSession(session);
+      return false;
+    }
+    return true;
+  }
+
+  // Reads the next piece of the data on the worker and hands its execution
+  // over to the executor. The epoll is rearmed only after the execution, so the
+  // session isn't read from and executed at the same time.
+  void ReadAndSubmitSession(SessionHandler &session) {
+    bool has_data = false;
+    if (!HandleSessionErrors(session, [&] { has_data = session.Read(); })) return;
+    if (!has_data) {
+      RearmSession(session);
+      return;
+    }
+    executor_->Submit(session.execution_class(), [this, &session] {
+      const auto start = std::chrono::steady_clock::now();
+      if (!HandleSessionErrors(session, [&] { session.ExecuteInput(); })) return;
+      const auto elapsed = std::chrono::steady_clock::now() - start;
+      session.set_execution_class(elapsed > executor_->config().analytical_threshold ? ExecutionClass::ANALYTICAL
+                                                                                     : ExecutionClass::INTERACTIVE);
+      // If more data arrived in the meantime, rearming the epoll generates a
+      // new event for it.
+      RearmSession(session);
+    });
+  }
+
+  void RearmSession(SessionHandler &session) {
+    std::visit(
+        [&](auto &poller) {
+          poller.Modify(session.socket().fd(), EPOLLIN | EPOLLET | EPOLLRDHUP | EPOLLONESHOT, &session);
+        },
+        poller_);
+  }
+
+  // Calls the function and closes the session if it throws. Returns `false` if
+  // the session was closed.
+  template <class TFunc>
+  bool HandleSessionErrors(SessionHandler &session, const TFunc &func) {
     try {
-      if (session.Execute()) {
-        // Session execution done, rearm epoll to send events for this
-        // socket.
-        epoll_.Modify(session.socket().fd(), EPOLLIN | EPOLLET | EPOLLRDHUP | EPOLLONESHOT, &session);
-        return false;
-      }
+      func();
+      return true;
     } catch (const SessionClosedException &e) {
       spdlog::info("{} client {} closed the connection.", service_name_, session.socket().endpoint());
       CloseSession(session);
-      return false;
     } catch (const std::exception &e) {
       // Catch all exceptions.
       spdlog::error(
@@ -233,9 +323,8 @@ class Listener final {
           service_name_, session.socket().endpoint());
       spdlog::debug("Exception message: {}", e.what());
       CloseSession(session);
-      return false;
     }
-    return true;
+    return false;
   }
 
   void CloseSession(SessionHandler &session) {
@@ -243,7 +332,7 @@ class Listener final {
     // a detailed description why this is necessary before destroying (closing)
     // the socket, see:
     // https://idea.popcount.org/2017-03-20-epoll-is-fundamentally-broken-22/
-    epoll_.Delete(session.socket().fd());
+    std::visit([&](auto &poller) { poller.Delete(session.socket().fd()); }, poller_);
 
     std::lock_guard<utils::SpinLock> guard(lock_);
     auto it = std::find_if(sessions_.begin(), sessions_.end(), [&](const auto &l) { return l.get() == &session; });
@@ -257,7 +346,7 @@ class Listener final {
     sessions_.pop_back();
   }
 
-  io::network::Epoll epoll_;
+  std::variant<io::network::Epoll, io::network::IoUring> poller_;
 
   TSessionData *data_;
 
@@ -272,5 +361,7 @@ class Listener final {
   const int inactivity_timeout_sec_;
   const std::string service_name_;
   const size_t workers_count_;
+
+  std::optional<Executor> executor_;
 };
 }  // namespace communication
@@ -34,8 +34,11 @@ namespace communication {
  *
  * Listens for incoming connections on the server port and assigns them to the
  * connection listener. The listener processes the events with a thread pool
- * that has `num_workers` threads. It is started automatically on constructor,
- * and stopped at destructor.
+ * that has `num_workers` threads. If the `executor_config` is given, those
+ * threads only read the data and the sessions are executed by a separate
+ * `Executor`. The `io_backend` selects how the listener polls the
+ * connections. It is started automatically on constructor, and stopped at
+ * destructor.
  *
  * Current Server achitecture:
  * incoming connection -> server -> listener -> session
@@ -60,10 +63,12 @@ class Server final {
    */
   Server(const io::network::Endpoint &endpoint, TSessionData *session_data, ServerContext *context,
          int inactivity_timeout_sec, const std::string &service_name,
-         size_t workers_count = std::thread::hardware_concurrency())
+         size_t workers_count = std::thread::hardware_concurrency(),
+         std::optional<ExecutorConfig> executor_config = std::nullopt, IoBackend io_backend = IoBackend::EPOLL)
       : alive_(false),
         endpoint_(endpoint),
-        listener_(session_data, context, inactivity_timeout_sec, service_name, workers_count),
+        listener_(session_data, context, inactivity_timeout_sec, service_name, workers_count, executor_config,
+                  io_backend),
         service_name_(service_name) {}
 
   ~Server() {
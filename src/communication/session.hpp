@@ -14,10 +14,13 @@
 #include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <thread>
 
+#include <sys/uio.h>
+
 #include <openssl/bio.h>
 #include <openssl/err.h>
 #include <openssl/ssl.h>
@@ -25,6 +28,7 @@
 #include "communication/buffer.hpp"
 #include "communication/context.hpp"
 #include "communication/exceptions.hpp"
+#include "communication/executor.hpp"
 #include "communication/helpers.hpp"
 #include "io/network/socket.hpp"
 #include "io/network/stream_buffer.hpp"
@@ -47,7 +51,11 @@ using InputStream = Buffer::ReadEnd;
  */
 class OutputStream final {
  public:
-  OutputStream(std::function<bool(const uint8_t *, size_t, bool)> write_function) : write_function_(write_function) {}
+  using WriteFunction = std::function<bool(const uint8_t *, size_t, bool)>;
+  using WriteVectoredFunction = std::function<bool(const iovec *, size_t, bool)>;
+
+  OutputStream(WriteFunction write_function, WriteVectoredFunction write_vectored_function = nullptr)
+      : write_function_(std::move(write_function)), write_vectored_function_(std::move(write_vectored_function)) {}
 
   OutputStream(const OutputStream &) = delete;
   OutputStream(OutputStream &&) = delete;
@@ -60,8 +68,19 @@ class OutputStream final {
     return Write(reinterpret_cast<const uint8_t *>(str.data()), str.size(), have_more);
   }
 
+  /**
+   * Returns true if the data of multiple buffers can be written with a single
+   * `WriteVectored` call, without copying it together first.
+   */
+  bool CanWriteVectored() const { return static_cast<bool>(write_vectored_function_); }
+
+  bool WriteVectored(const iovec *iov, size_t iovcnt, bool have_more = false) {
+    return write_vectored_function_(iov, iovcnt, have_more);
+  }
+
  private:
-  std::function<bool(const uint8_t *, size_t, bool)> write_function_;
+  WriteFunction write_function_;
+  WriteVectoredFunction write_vectored_function_;
 };
 
 /**
@@ -74,7 +93,14 @@ class Session final {
  public:
   Session(io::network::Socket &&socket, TSessionData *data, ServerContext *context, int inactivity_timeout_sec)
       : socket_(std::move(socket)),
-        output_stream_([this](const uint8_t *data, size_t len, bool have_more) { return Write(data, len, have_more); }),
+        output_stream_([this](const uint8_t *data, size_t len, bool have_more) { return Write(data, len, have_more); },
+                       // OpenSSL encrypts the data of each write separately, so the
+                       // vectored writes are used only for the plain sockets.
+                       context->use_ssl() ? nullptr
+                                          : OutputStream::WriteVectoredFunction(
+                                                [this](const iovec *iov, size_t iovcnt, bool have_more) {
+                                                  return socket_.Write(iov, iovcnt, have_more);
+                                                })),
         session_(data, socket_.endpoint(), input_buffer_.read_end(), &output_stream_),
         inactivity_timeout_sec_(inactivity_timeout_sec) {
     // Set socket options.
@@ -148,6 +174,91 @@ class Session final {
     RefreshLastEventTime(true);
     utils::OnScopeExit on_exit([this] { RefreshLastEventTime(false); });
 
+    switch (ReadChunk()) {
+      case ReadResult::WOULD_BLOCK:
+        return true;
+      case ReadResult::RETRY:
+        return false;
+      case ReadResult::DATA:
+        break;
+    }
+
+    // Execute the session.
+    session_.Execute();
+
+    return false;
+  }
+
+  /**
+   * This function is used instead of `Execute` when the data is read and
+   * executed on different threads. It reads the next piece of data waiting on
+   * the socket into the input buffer. It returns `true` if data was read, in
+   * which case `ExecuteInput` must be called next. It returns `false` when
+   * there is no more data to be read.
+   */
+  bool Read() {
+    // The session stays active until the data is executed.
+    RefreshLastEventTime(true);
+    while (true) {
+      switch (ReadChunk()) {
+        case ReadResult::WOULD_BLOCK:
+          RefreshLastEventTime(false);
+          return false;
+        case ReadResult::RETRY:
+          continue;
+        case ReadResult::DATA:
+          return true;
+      }
+    }
+  }
+
+  /**
+   * This function calls the `Execute` method from the supplied `TSession` on
+   * the data previously read with `Read`.
+   */
+  void ExecuteInput() {
+    utils::OnScopeExit on_exit([this] { RefreshLastEventTime(false); });
+    session_.Execute();
+  }
+
+  /**
+   * Returns true if session has timed out. Session times out if there was no
+   * activity in inactivity_timeout_sec seconds. This function must be thread
+   * safe because this function and `RefreshLastEventTime` are called from
+   * different threads in the network stack.
+   */
+  bool TimedOut() {
+    std::unique_lock<utils::SpinLock> guard(lock_);
+    if (execution_active_) return false;
+    return last_event_time_ + std::chrono::seconds(inactivity_timeout_sec_) < std::chrono::steady_clock::now();
+  }
+
+  /**
+   * Returns a reference to the internal socket.
+   */
+  io::network::Socket &socket() { return socket_; }
+
+  /**
+   * The class in which the session is executed when its execution is separate
+   * from the network I/O. The session is analytical if its last execution ran
+   * longer than the threshold of the executor.
+   */
+  ExecutionClass execution_class() const { return execution_class_.load(std::memory_order_acquire); }
+  void set_execution_class(ExecutionClass execution_class) {
+    execution_class_.store(execution_class, std::memory_order_release);
+  }
+
+ private:
+  enum class ReadResult : uint8_t {
+    // New data was read into the input buffer.
+    DATA,
+    // There is no data waiting on the socket.
+    WOULD_BLOCK,
+    // Nothing was read, but the read should be attempted again.
+    RETRY,
+  };
+
+  ReadResult ReadChunk() {
     // Allocate the buffer to fill the data.
     auto buf = input_buffer_.write_end()->Allocate();
 
@@ -164,17 +275,15 @@ class Session final {
       if (len < 0) {
         auto err = SSL_get_error(ssl_, len);
         if (err == SSL_ERROR_WANT_READ) {
-          // OpenSSL want's to read more data from the socket. We return `true`
-          // to stop execution of the session to wait for more data to be
-          // received.
-          return true;
+          // OpenSSL want's to read more data from the socket. We stop the
+          // execution of the session to wait for more data to be received.
+          return ReadResult::WOULD_BLOCK;
         } else if (err == SSL_ERROR_WANT_WRITE) {
           // The OpenSSL library wants to perfrom some kind of handshake so we
           // wait for the socket to become ready for a write and call the read
-          // again. We return `false` so that the listener calls this function
           // again.
           socket_.WaitForReadyWrite();
-          return false;
+          return ReadResult::RETRY;
         } else if (err == SSL_ERROR_SYSCALL) {
           // OpenSSL returns this error when you open a connection to the server
           // but you don't send any data. We do this often when we check whether
@@ -200,7 +309,6 @@ class Session final {
       } else if (len == 0) {
         // The client closed the connection.
         throw SessionClosedException("Session was closed by the client.");
-        return false;
       } else {
         // Notify the input buffer that it has new data.
         input_buffer_.write_end()->Written(len);
@@ -214,10 +322,9 @@ class Session final {
       // Check for read errors.
       if (len == -1) {
         // This means read would block or read was interrupted by signal, we
-        // return `true` to indicate that all data is processad and to stop
-        // reading of data.
+        // indicate that all data is processad and to stop reading of data.
         if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
-          return true;
+          return ReadResult::WOULD_BLOCK;
         }
         // Some other error occurred, throw an exception to start session
         // cleanup.
@@ -230,31 +337,9 @@ class Session final {
         input_buffer_.write_end()->Written(len);
       }
     }
-
-    // Execute the session.
-    session_.Execute();
-
-    return false;
-  }
-
-  /**
-   * Returns true if session has timed out. Session times out if there was no
-   * activity in inactivity_timeout_sec seconds. This function must be thread
-   * safe because this function and `RefreshLastEventTime` are called from
-   * different threads in the network stack.
-   */
-  bool TimedOut() {
-    std::unique_lock<utils::SpinLock> guard(lock_);
-    if (execution_active_) return false;
-    return last_event_time_ + std::chrono::seconds(inactivity_timeout_sec_) < std::chrono::steady_clock::now();
+    return ReadResult::DATA;
   }
 
-  /**
-   * Returns a reference to the internal socket.
-   */
-  io::network::Socket &socket() { return socket_; }
-
- private:
   void RefreshLastEventTime(bool active) {
     std::unique_lock<utils::SpinLock> guard(lock_);
     execution_active_ = active;
@@ -323,6 +408,9 @@ class Session final {
   utils::SpinLock lock_;
   const int inactivity_timeout_sec_;
 
+  // Set by the executor and read by the network worker.
+  std::atomic<ExecutionClass> execution_class_{ExecutionClass::INTERACTIVE};
+
   // SSL objects.
   SSL *ssl_{nullptr};
   BIO *bio_{nullptr};
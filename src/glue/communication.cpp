@@ -11,6 +11,7 @@
 
 #include "glue/communication.hpp"
 
+#include <algorithm>
 #include <map>
 #include <string>
 #include <vector>
@@ -183,6 +184,201 @@ storage::Result<communication::bolt::Path> ToBoltPath(const query::Path &path, c
   return communication::bolt::Path(vertices, edges);
 }
 
+storage::Result<void> TypedValueBoltEncoder::WriteList(const std::vector<query::TypedValue> &values) {
+  encoder_.WriteTypeSize(values.size(), communication::bolt::MarkerList);
+  for (const auto &value : values) {
+    if (auto maybe_error = WriteValue(value); maybe_error.HasError()) return maybe_error;
+  }
+  return {};
+}
+
+storage::Result<void> TypedValueBoltEncoder::WriteValue(const query::TypedValue &value) {
+  switch (value.type()) {
+    case query::TypedValue::Type::Null:
+      encoder_.WriteNull();
+      return {};
+    case query::TypedValue::Type::Bool:
+      encoder_.WriteBool(value.ValueBool());
+      return {};
+    case query::TypedValue::Type::Int:
+      encoder_.WriteInt(value.ValueInt());
+      return {};
+    case query::TypedValue::Type::Double:
+      encoder_.WriteDouble(value.ValueDouble());
+      return {};
+    case query::TypedValue::Type::String: {
+      // The values outlive the encoding of the record, so their strings can
+      // be sent without copying them into the buffer.
+      const auto &string = value.ValueString();
+      encoder_.WriteTypeSize(string.size(), communication::bolt::MarkerString);
+      output_.WriteReferenced(reinterpret_cast<const uint8_t *>(string.data()), string.size());
+      return {};
+    }
+    case query::TypedValue::Type::List: {
+      const auto &list = value.ValueList();
+      encoder_.WriteTypeSize(list.size(), communication::bolt::MarkerList);
+      for (const auto &v : list) {
+        if (auto maybe_error = WriteValue(v); maybe_error.HasError()) return maybe_error;
+      }
+      return {};
+    }
+    case query::TypedValue::Type::Map: {
+      const auto &map = value.ValueMap();
+      encoder_.WriteTypeSize(map.size(), communication::bolt::MarkerMap);
+      for (const auto &kv : map) {
+        encoder_.WriteString(kv.first);
+        if (auto maybe_error = WriteValue(kv.second); maybe_error.HasError()) return maybe_error;
+      }
+      return {};
+    }
+    case query::TypedValue::Type::Vertex:
+      return WriteVertex(value.ValueVertex().impl_);
+    case query::TypedValue::Type::Edge:
+      return WriteEdge(value.ValueEdge().impl_, false);
+    case query::TypedValue::Type::Path:
+      return WritePath(value.ValuePath());
+    case query::TypedValue::Type::Date:
+      encoder_.WriteDate(value.ValueDate());
+      return {};
+    case query::TypedValue::Type::LocalTime:
+      encoder_.WriteLocalTime(value.ValueLocalTime());
+      return {};
+    case query::TypedValue::Type::LocalDateTime:
+      encoder_.WriteLocalDateTime(value.ValueLocalDateTime());
+      return {};
+    case query::TypedValue::Type::Duration:
+      encoder_.WriteDuration(value.ValueDuration());
+      return {};
+  }
+}
+
+storage::Result<void> TypedValueBoltEncoder::WriteVertex(const storage::VertexAccessor &vertex) {
+  auto maybe_labels = vertex.Labels(view_);
+  if (maybe_labels.HasError()) return maybe_labels.GetError();
+
+  encoder_.WriteRAW(utils::UnderlyingCast(communication::bolt::Marker::TinyStruct) + 3);
+  encoder_.WriteRAW(utils::UnderlyingCast(communication::bolt::Signature::Node));
+  encoder_.WriteInt(vertex.Gid().AsInt());
+  encoder_.WriteTypeSize(maybe_labels->size(), communication::bolt::MarkerList);
+  for (const auto &label : *maybe_labels) encoder_.WriteString(db_->LabelToName(label));
+  return WriteProperties(vertex);
+}
+
+storage::Result<void> TypedValueBoltEncoder::WriteEdge(const storage::EdgeAccessor &edge, bool unbound) {
+  encoder_.WriteRAW(utils::UnderlyingCast(communication::bolt::Marker::TinyStruct) + (unbound ? 3 : 5));
+  encoder_.WriteRAW(utils::UnderlyingCast(unbound ? communication::bolt::Signature::UnboundRelationship
+                                                  : communication::bolt::Signature::Relationship));
+  encoder_.WriteInt(edge.Gid().AsInt());
+  if (!unbound) {
+    encoder_.WriteInt(edge.FromVertex().Gid().AsInt());
+    encoder_.WriteInt(edge.ToVertex().Gid().AsInt());
+  }
+  encoder_.WriteString(db_->EdgeTypeToName(edge.EdgeType()));
+  return WriteProperties(edge);
+}
+
+storage::Result<void> TypedValueBoltEncoder::WritePath(const query::Path &path) {
+  // Same as communication::bolt::Path, the path is written as its unique
+  // vertices and edges, and the indices which map the path positions to them.
+  const auto &path_vertices = path.vertices();
+  const auto &path_edges = path.edges();
+  std::vector<const storage::VertexAccessor *> vertices;
+  std::vector<const storage::EdgeAccessor *> edges;
+  std::vector<int64_t> indices;
+  vertices.reserve(path_vertices.size());
+  edges.reserve(path_edges.size());
+  indices.reserve(2 * path_edges.size());
+  auto add_element = [&indices](auto &collection, const auto *element, int64_t multiplier, int64_t offset) {
+    auto found = std::find_if(collection.begin(), collection.end(),
+                              [&](const auto *e) { return e->Gid() == element->Gid(); });
+    indices.push_back(multiplier * (std::distance(collection.begin(), found) + offset));
+    if (found == collection.end()) collection.push_back(element);
+  };
+  vertices.push_back(&path_vertices.front().impl_);
+  for (size_t i = 0; i < path_edges.size(); ++i) {
+    const auto &edge = path_edges[i].impl_;
+    const auto &vertex = path_vertices[i + 1].impl_;
+    add_element(edges, &edge, edge.ToVertex().Gid() == vertex.Gid() ? 1 : -1, 1);
+    add_element(vertices, &vertex, 1, 0);
+  }
+
+  encoder_.WriteRAW(utils::UnderlyingCast(communication::bolt::Marker::TinyStruct) + 3);
+  encoder_.WriteRAW(utils::UnderlyingCast(communication::bolt::Signature::Path));
+  encoder_.WriteTypeSize(vertices.size(), communication::bolt::MarkerList);
+  for (const auto *vertex : vertices) {
+    if (auto maybe_error = WriteVertex(*vertex); maybe_error.HasError()) return maybe_error;
+  }
+  encoder_.WriteTypeSize(edges.size(), communication::bolt::MarkerList);
+  for (const auto *edge : edges) {
+    if (auto maybe_error = WriteEdge(*edge, true); maybe_error.HasError()) return maybe_error;
+  }
+  encoder_.WriteTypeSize(indices.size(), communication::bolt::MarkerList);
+  for (auto index : indices) encoder_.WriteInt(index);
+  return {};
+}
+
+template <class TAccessor>
+storage::Result<void> TypedValueBoltEncoder::WriteProperties(const TAccessor &accessor) {
+  return accessor.ForEachProperty(
+      view_, [this](size_t count) { encoder_.WriteTypeSize(count, communication::bolt::MarkerMap); },
+      [this](storage::PropertyId property, const storage::PropertyValue &value) {
+        encoder_.WriteString(db_->PropertyToName(property));
+        WritePropertyValue(value);
+      });
+}
+
+void TypedValueBoltEncoder::WritePropertyValue(const storage::PropertyValue &value) {
+  switch (value.type()) {
+    case storage::PropertyValue::Type::Null:
+      encoder_.WriteNull();
+      return;
+    case storage::PropertyValue::Type::Bool:
+      encoder_.WriteBool(value.ValueBool());
+      return;
+    case storage::PropertyValue::Type::Int:
+      encoder_.WriteInt(value.ValueInt());
+      return;
+    case storage::PropertyValue::Type::Double:
+      encoder_.WriteDouble(value.ValueDouble());
+      return;
+    case storage::PropertyValue::Type::String:
+      encoder_.WriteString(value.ValueString());
+      return;
+    case storage::PropertyValue::Type::List: {
+      const auto &list = value.ValueList();
+      encoder_.WriteTypeSize(list.size(), communication::bolt::MarkerList);
+      for (const auto &v : list) WritePropertyValue(v);
+      return;
+    }
+    case storage::PropertyValue::Type::Map: {
+      const auto &map = value.ValueMap();
+      encoder_.WriteTypeSize(map.size(), communication::bolt::MarkerMap);
+      for (const auto &kv : map) {
+        encoder_.WriteString(kv.first);
+        WritePropertyValue(kv.second);
+      }
+      return;
+    }
+    case storage::PropertyValue::Type::TemporalData: {
+      const auto &temporal_data = value.ValueTemporalData();
+      switch (temporal_data.type) {
+        case storage::TemporalType::Date:
+          encoder_.WriteDate(utils::Date(temporal_data.microseconds));
+          return;
+        case storage::TemporalType::LocalTime:
+          encoder_.WriteLocalTime(utils::LocalTime(temporal_data.microseconds));
+          return;
+        case storage::TemporalType::LocalDateTime:
+          encoder_.WriteLocalDateTime(utils::LocalDateTime(temporal_data.microseconds));
+          return;
+        case storage::TemporalType::Duration:
+          encoder_.WriteDuration(utils::Duration(temporal_data.microseconds));
+          return;
+      }
+    }
+  }
+}
+
 storage::PropertyValue ToPropertyValue(const Value &value) {
   switch (value.type()) {
     case Value::Type::Null:
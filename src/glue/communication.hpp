@@ -12,8 +12,14 @@
 /// @file Conversion functions between Value and other memgraph types.
 #pragma once
 
+#include <cstdint>
+#include <map>
+#include <vector>
+
+#include "communication/bolt/v1/encoder/base_encoder.hpp"
 #include "communication/bolt/v1/value.hpp"
 #include "query/typed_value.hpp"
+#include "storage/v2/id_types.hpp"
 #include "storage/v2/property_value.hpp"
 #include "storage/v2/result.hpp"
 #include "storage/v2/view.hpp"
@@ -59,6 +65,82 @@ storage::Result<communication::bolt::Path> ToBoltPath(const query::Path &path, c
 storage::Result<communication::bolt::Value> ToBoltValue(const query::TypedValue &value, const storage::Storage &db,
                                                         storage::View view);
 
+/// Encodes query::TypedValue straight into Bolt, without building the
+/// intermediate communication::bolt::Value. Vertex and edge properties are
+/// encoded while they are read from their property store, unless there are
+/// changes of the object which aren't garbage collected yet, in which case
+/// they are collected first, see storage::VertexAccessor::ForEachProperty.
+///
+/// The values are written straight into the given buffer, e.g. the chunk
+/// buffer of the Bolt session.
+class TypedValueBoltEncoder final {
+ public:
+  /// @param storage::Storage for getting label, edge type and property names.
+  /// @param storage::View for deciding which vertex and edge attributes are
+  ///        visible.
+  TypedValueBoltEncoder(const storage::Storage *db, storage::View view) : db_(db), view_(view), encoder_(output_) {}
+
+  TypedValueBoltEncoder(const TypedValueBoltEncoder &) = delete;
+  TypedValueBoltEncoder &operator=(const TypedValueBoltEncoder &) = delete;
+  TypedValueBoltEncoder(TypedValueBoltEncoder &&) = delete;
+  TypedValueBoltEncoder &operator=(TypedValueBoltEncoder &&) = delete;
+  ~TypedValueBoltEncoder() = default;
+
+  /// Encodes the values as a Bolt list into `buffer`, which has to have a
+  /// `Write(const uint8_t *, size_t)` method. When an error is returned, the
+  /// written data is incomplete and the caller has to discard it.
+  ///
+  /// If the buffer also has a `WriteReferenced` method, the strings of the
+  /// values are passed to it, so that the large ones aren't copied. The values
+  /// then have to stay valid until the buffer is flushed. The strings of the
+  /// properties are always copied, as they are decoded into temporaries.
+  ///
+  /// The properties are written while the object they belong to is locked,
+  /// so writing to the buffer mustn't block, e.g. on sending the data.
+  ///
+  /// @throw std::bad_alloc
+  template <class TBuffer>
+  storage::Result<void> EncodeList(const std::vector<query::TypedValue> &values, TBuffer *buffer) {
+    output_.context = buffer;
+    output_.write = [](void *context, const uint8_t *data, uint64_t size) {
+      static_cast<TBuffer *>(context)->Write(data, size);
+    };
+    output_.write_referenced = [](void *context, const uint8_t *data, uint64_t size) {
+      if constexpr (requires(TBuffer & b) { b.WriteReferenced(data, size); }) {
+        static_cast<TBuffer *>(context)->WriteReferenced(data, size);
+      } else {
+        static_cast<TBuffer *>(context)->Write(data, size);
+      }
+    };
+    return WriteList(values);
+  }
+
+ private:
+  // Forwards the writes to the buffer given to `EncodeList`.
+  struct Output {
+    void Write(const uint8_t *data, uint64_t size) { write(context, data, size); }
+    void WriteReferenced(const uint8_t *data, uint64_t size) { write_referenced(context, data, size); }
+
+    void *context{nullptr};
+    void (*write)(void *, const uint8_t *, uint64_t){nullptr};
+    void (*write_referenced)(void *, const uint8_t *, uint64_t){nullptr};
+  };
+
+  storage::Result<void> WriteList(const std::vector<query::TypedValue> &values);
+  storage::Result<void> WriteValue(const query::TypedValue &value);
+  storage::Result<void> WriteVertex(const storage::VertexAccessor &vertex);
+  storage::Result<void> WriteEdge(const storage::EdgeAccessor &edge, bool unbound);
+  storage::Result<void> WritePath(const query::Path &path);
+  template <class TAccessor>
+  storage::Result<void> WriteProperties(const TAccessor &accessor);
+  void WritePropertyValue(const storage::PropertyValue &value);
+
+  const storage::Storage *db_;
+  storage::View view_;
+  Output output_;
+  communication::bolt::BaseEncoder<Output> encoder_;
+};
+
 query::TypedValue ToTypedValue(const communication::bolt::Value &value);
 
 communication::bolt::Value ToBoltValue(const storage::PropertyValue &value);
@@ -14,6 +14,7 @@
 #include <algorithm>
 #include <chrono>
 #include <iterator>
+#include <map>
 #include <memory>
 #include <unordered_set>
 
@@ -74,6 +75,28 @@ utils::BasicResult<std::string, std::vector<Message>> GetBatch(RdKafka::KafkaCon
 
   return std::move(batch);
 }
+
+// Commits the offsets after the messages of the batch which are from the given topic partitions.
+RdKafka::ErrorCode CommitPartitions(RdKafka::KafkaConsumer &consumer, const std::vector<Message> &batch,
+                                    const std::vector<std::pair<std::string, int32_t>> &topic_partitions) {
+  std::map<std::pair<std::string, int32_t>, int64_t> next_offsets;
+  for (const auto &topic_partition : topic_partitions) next_offsets.emplace(topic_partition, -1);
+  for (const auto &message : batch) {
+    if (auto it = next_offsets.find({std::string{message.TopicName()}, message.Partition()});
+        it != next_offsets.end()) {
+      it->second = std::max(it->second, message.Offset() + 1);
+    }
+  }
+
+  std::vector<RdKafka::TopicPartition *> partitions;
+  utils::OnScopeExit clear_partitions([&]() { RdKafka::TopicPartition::destroy(partitions); });
+  for (const auto &[topic_partition, offset] : next_offsets) {
+    if (offset < 0) continue;
+    partitions.push_back(RdKafka::TopicPartition::create(topic_partition.first, topic_partition.second, offset));
+  }
+  if (partitions.empty()) return RdKafka::ERR_NO_ERROR;
+  return consumer.commitSync(partitions);
+}
 }  // namespace
 
 Message::Message(std::unique_ptr<RdKafka::Message> &&message) : message_{std::move(message)} {
@@ -108,6 +131,11 @@ int64_t Message::Offset() const {
   return c_message->offset;
 }
 
+int32_t Message::Partition() const {
+  const auto *c_message = message_->c_ptr();
+  return c_message->partition;
+}
+
 Consumer::Consumer(ConsumerInfo info, ConsumerFunction consumer_function)
     : info_{std::move(info)}, consumer_function_(std::move(consumer_function)), cb_(info_.consumer_name) {
   MG_ASSERT(consumer_function_, "Empty consumer function for Kafka consumer");
@@ -386,6 +414,13 @@ void Consumer::StartConsuming() {
           spdlog::warn("Committing offset of consumer {} failed: {}", info_.consumer_name, RdKafka::err2str(err));
           break;
         }
+      } catch (const PartiallyProcessedBatchException &e) {
+        spdlog::warn("Error happened in consumer {} while processing a batch: {}!", info_.consumer_name, e.what());
+        if (const auto err = CommitPartitions(*consumer_, batch, e.ProcessedPartitions());
+            err != RdKafka::ERR_NO_ERROR) {
+          spdlog::warn("Committing offset of consumer {} failed: {}", info_.consumer_name, RdKafka::err2str(err));
+        }
+        break;
       } catch (const std::exception &e) {
         spdlog::warn("Error happened in consumer {} while processing a batch: {}!", info_.consumer_name, e.what());
         break;
@@ -11,7 +11,11 @@
 
 #pragma once
 
+#include <cstdint>
+#include <string>
 #include <string_view>
+#include <utility>
+#include <vector>
 
 #include "utils/exceptions.hpp"
 
@@ -59,6 +63,21 @@ class ConsumerStartFailedException : public KafkaStreamException {
       : KafkaStreamException("Starting Kafka consumer {} failed: {}", consumer_name, error) {}
 };
 
+/// Thrown by the consumer function when the messages of only some of the topic partitions of a batch were processed.
+/// The offsets of those partitions are committed, so only the messages of the other partitions are consumed again.
+class PartiallyProcessedBatchException : public KafkaStreamException {
+ public:
+  PartiallyProcessedBatchException(const std::string_view error,
+                                   std::vector<std::pair<std::string, int32_t>> processed_partitions)
+      : KafkaStreamException("Only a part of the batch was processed: {}", error),
+        processed_partitions_{std::move(processed_partitions)} {}
+
+  const std::vector<std::pair<std::string, int32_t>> &ProcessedPartitions() const { return processed_partitions_; }
+
+ private:
+  std::vector<std::pair<std::string, int32_t>> processed_partitions_;
+};
+
 class TopicNotFoundException : public KafkaStreamException {
  public:
   TopicNotFoundException(const std::string_view consumer_name, const std::string_view topic_name)
@@ -0,0 +1,269 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "io/network/io_uring.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <thread>
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+
+#include "utils/logging.hpp"
+
+namespace io::network {
+
+namespace {
+
+// The number of the requests which can be queued before they have to be
+// submitted. The completion ring is twice as large and the kernel keeps the
+// completions which don't fit in it, so this doesn't limit the number of the
+// armed polls.
+constexpr unsigned kRingEntries = 1024;
+
+constexpr uint32_t kRequiredFeatures = IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP | IORING_FEAT_EXT_ARG;
+
+int Setup(unsigned entries, io_uring_params *params) {
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+unsigned LoadAcquire(unsigned *value) { return std::atomic_ref<unsigned>(*value).load(std::memory_order_acquire); }
+
+void StoreRelease(unsigned *value, unsigned new_value) {
+  std::atomic_ref<unsigned>(*value).store(new_value, std::memory_order_release);
+}
+
+template <class T>
+T *Offset(void *base, uint32_t offset) {
+  return reinterpret_cast<T *>(static_cast<char *>(base) + offset);
+}
+
+}  // namespace
+
+bool IoUring::IsSupported() {
+  io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  const int fd = Setup(1, &params);
+  if (fd == -1) return false;
+  close(fd);
+  return (params.features & kRequiredFeatures) == kRequiredFeatures;
+}
+
+IoUring::IoUring() {
+  io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  ring_fd_ = Setup(kRingEntries, &params);
+  // Same as with epoll, failing to create the ring is either a logical error
+  // in our code or an irrecoverable error.
+  MG_ASSERT(ring_fd_ != -1, "Error on io_uring setup: ({}) {}", errno, strerror(errno));
+  MG_ASSERT((params.features & kRequiredFeatures) == kRequiredFeatures, "The kernel doesn't support io_uring!");
+
+  rings_size_ = std::max(params.sq_off.array + params.sq_entries * sizeof(unsigned),
+                         params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+  rings_ = mmap(nullptr, rings_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING);
+  MG_ASSERT(rings_ != MAP_FAILED, "Error on io_uring rings mmap: ({}) {}", errno, strerror(errno));
+  sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+  auto *sqes = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES);
+  MG_ASSERT(sqes != MAP_FAILED, "Error on io_uring entries mmap: ({}) {}", errno, strerror(errno));
+  sqes_ = static_cast<io_uring_sqe *>(sqes);
+
+  sq_head_ = Offset<unsigned>(rings_, params.sq_off.head);
+  sq_tail_ = Offset<unsigned>(rings_, params.sq_off.tail);
+  sq_mask_ = *Offset<unsigned>(rings_, params.sq_off.ring_mask);
+  sq_entries_ = *Offset<unsigned>(rings_, params.sq_off.ring_entries);
+  sq_array_ = Offset<unsigned>(rings_, params.sq_off.array);
+  cq_head_ = Offset<unsigned>(rings_, params.cq_off.head);
+  cq_tail_ = Offset<unsigned>(rings_, params.cq_off.tail);
+  cq_mask_ = *Offset<unsigned>(rings_, params.cq_off.ring_mask);
+  cqes_ = Offset<io_uring_cqe>(rings_, params.cq_off.cqes);
+
+  // The entries are always submitted in order, so each slot of the array
+  // points to the entry with the same index.
+  for (unsigned i = 0; i < sq_entries_; ++i) sq_array_[i] = i;
+  sq_local_tail_ = *sq_tail_;
+}
+
+IoUring::~IoUring() {
+  munmap(sqes_, sqes_size_);
+  munmap(rings_, rings_size_);
+  close(ring_fd_);
+}
+
+void IoUring::Add(int fd, uint32_t events, void *ptr, bool /*modify*/) {
+  // The user data of 0 marks the completions which are not returned as events.
+  MG_ASSERT(ptr, "The io_uring poll needs an event handler!");
+  std::unique_lock guard(mutex_);
+  auto *sqe = NextSqe(guard);
+  sqe->opcode = IORING_OP_POLL_ADD;
+  sqe->fd = fd;
+  sqe->poll32_events = events;
+  sqe->user_data = reinterpret_cast<uint64_t>(ptr);
+  polls_[fd] = sqe->user_data;
+  // The request is submitted with the rest of the batch by the next thread
+  // which would wait. Only the first request of a batch which is queued while
+  // a thread is blocked in the kernel needs someone to submit it, because that
+  // thread won't see it before its timeout. An idle waiter is woken up for
+  // that, so the requests queued until it runs are submitted together, and if
+  // there is none, the request is submitted right away.
+  if (to_submit_++ > 0 || !in_kernel_) return;
+  if (idle_waiters_ > 0) {
+    cv_.notify_one();
+    return;
+  }
+  Submit(guard);
+}
+
+void IoUring::Delete(int fd) {
+  std::unique_lock guard(mutex_);
+  auto it = polls_.find(fd);
+  if (it == polls_.end()) return;
+  // The poll is usually already completed, in which case the removal fails
+  // with ENOENT and its completion is ignored.
+  auto *sqe = NextSqe(guard);
+  sqe->opcode = IORING_OP_POLL_REMOVE;
+  sqe->fd = -1;
+  sqe->addr = it->second;
+  sqe->user_data = 0;
+  polls_.erase(it);
+  ++to_submit_;
+  // The caller closes the file descriptor and destroys the event handler
+  // after this, so the removal can't wait for the next batch.
+  Submit(guard);
+}
+
+int IoUring::Wait(Event *events, int max_events, int timeout) {
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+  std::unique_lock guard(mutex_);
+  while (true) {
+    const int reaped = Reap(events, max_events);
+    if (reaped > 0) {
+      // Another thread takes the rest of the completions without waiting for
+      // the thread in the kernel.
+      if (*cq_head_ != LoadAcquire(cq_tail_)) cv_.notify_one();
+      return reaped;
+    }
+    if (!in_kernel_) break;
+    // The thread in the kernel doesn't see the requests which were queued
+    // after it blocked, so they are submitted before waiting for it.
+    if (to_submit_ > 0 && Submit(guard)) continue;
+    ++idle_waiters_;
+    bool timed_out = false;
+    if (timeout < 0) {
+      cv_.wait(guard);
+    } else {
+      timed_out = cv_.wait_until(guard, deadline) == std::cv_status::timeout;
+    }
+    --idle_waiters_;
+    if (timed_out) return Reap(events, max_events);
+  }
+
+  // This thread submits the queued requests and waits for the completions in
+  // the same system call, without holding the mutex.
+  in_kernel_ = true;
+  StoreRelease(sq_tail_, sq_local_tail_);
+  const auto to_submit = std::exchange(to_submit_, 0);
+  guard.unlock();
+
+  const auto remaining = std::max(deadline - std::chrono::steady_clock::now(), std::chrono::nanoseconds::zero());
+  const auto remaining_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(remaining).count();
+  __kernel_timespec ts{.tv_sec = remaining_ns / 1000000000LL, .tv_nsec = remaining_ns % 1000000000LL};
+  io_uring_getevents_arg arg;
+  memset(&arg, 0, sizeof(arg));
+  arg.sigmask_sz = _NSIG / 8;
+  if (timeout >= 0) arg.ts = reinterpret_cast<uint64_t>(&ts);
+  const int submitted = Enter(to_submit, 1, IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+
+  guard.lock();
+  in_kernel_ = false;
+  Requeue(to_submit, submitted);
+  const int reaped = Reap(events, max_events);
+  // One of the idle waiters either takes the rest of the completions or
+  // blocks in the kernel instead of this thread.
+  cv_.notify_one();
+  return reaped;
+}
+
+io_uring_sqe *IoUring::NextSqe(std::unique_lock<std::mutex> &guard) {
+  while (sq_local_tail_ - LoadAcquire(sq_head_) == sq_entries_) {
+    // When none of the entries are queued, the whole ring is being submitted
+    // by another thread, which frees it soon.
+    if (to_submit_ > 0 && Submit(guard)) continue;
+    guard.unlock();
+    std::this_thread::yield();
+    guard.lock();
+  }
+  auto *sqe = &sqes_[sq_local_tail_ & sq_mask_];
+  memset(sqe, 0, sizeof(*sqe));
+  ++sq_local_tail_;
+  return sqe;
+}
+
+bool IoUring::Submit(std::unique_lock<std::mutex> &guard) {
+  StoreRelease(sq_tail_, sq_local_tail_);
+  const auto to_submit = std::exchange(to_submit_, 0);
+  if (to_submit == 0) return false;
+  guard.unlock();
+  const int submitted = Enter(to_submit, 0, 0, nullptr, 0);
+  guard.lock();
+  Requeue(to_submit, submitted);
+  return submitted > 0;
+}
+
+void IoUring::Requeue(unsigned to_submit, int submitted) {
+  // The entries are submitted in order by whichever thread enters the kernel
+  // next, so only their number matters.
+  to_submit_ += to_submit - std::clamp(submitted, 0, static_cast<int>(to_submit));
+}
+
+int IoUring::Enter(unsigned to_submit, unsigned min_complete, unsigned flags, void *arg, size_t arg_size) {
+  while (true) {
+    const auto ret = syscall(__NR_io_uring_enter, ring_fd_, to_submit, min_complete, flags, arg, arg_size);
+    if (ret >= 0) return static_cast<int>(ret);
+    if (errno == EINTR) {
+      // The wait was interrupted by a signal handler, which is treated as a
+      // timeout. An interrupted submission is retried.
+      if (!(flags & IORING_ENTER_GETEVENTS)) continue;
+      return -1;
+    }
+    // The timeout expired, or the completions which didn't fit in the
+    // completion ring have to be reaped before submitting more requests. In
+    // both cases the queued requests are submitted later.
+    MG_ASSERT(errno == ETIME || errno == EBUSY || errno == EAGAIN, "Error on io_uring enter: ({}) {}", errno,
+              strerror(errno));
+    return -1;
+  }
+}
+
+int IoUring::Reap(Event *events, int max_events) {
+  unsigned head = *cq_head_;
+  const unsigned tail = LoadAcquire(cq_tail_);
+  int count = 0;
+  while (head != tail && count < max_events) {
+    const auto &cqe = cqes_[head & cq_mask_];
+    ++head;
+    if (cqe.user_data == 0 || cqe.res == -ECANCELED) continue;
+    auto &event = events[count++];
+    event.data.u64 = cqe.user_data;
+    // The result of a poll is the mask of the ready events, the errors are
+    // reported the same way epoll reports them.
+    event.events = cqe.res < 0 ? EPOLLERR : static_cast<uint32_t>(cqe.res);
+  }
+  StoreRelease(cq_head_, head);
+  return count;
+}
+
+}  // namespace io::network
@@ -0,0 +1,159 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <linux/io_uring.h>
+#include <sys/epoll.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+namespace io::network {
+
+/**
+ * Wrapper class for io_uring with the same interface as `Epoll`.
+ * Instead of registering the file descriptors with epoll, every `Add` and
+ * `Modify` queues a oneshot poll request in the submission ring. The requests
+ * are submitted in batches, together with waiting for the completions, by the
+ * thread which is about to block in the kernel, so arming a file descriptor
+ * doesn't cost a system call of its own. see: man 7 io_uring
+ *
+ * At most one thread at a time is blocked in the kernel. The other threads
+ * which call `Wait` take the completions which are already in the completion
+ * ring without a system call, and otherwise wait until the thread in the
+ * kernel wakes up. If that thread is blocked while requests are queued, the
+ * next thread which would wait submits them, so they aren't delayed until its
+ * timeout.
+ *
+ * Because the polls are oneshot, this matches the usage of `Epoll` with
+ * `EPOLLONESHOT`, where the file descriptor has to be rearmed with `Modify`
+ * after each event.
+ */
+class IoUring final {
+ public:
+  using Event = struct epoll_event;
+
+  IoUring();
+  ~IoUring();
+
+  IoUring(const IoUring &) = delete;
+  IoUring(IoUring &&) = delete;
+  IoUring &operator=(const IoUring &) = delete;
+  IoUring &operator=(IoUring &&) = delete;
+
+  /**
+   * Returns true if the kernel supports all of the io_uring features this
+   * class uses.
+   */
+  static bool IsSupported();
+
+  /**
+   * This function queues a poll of the file descriptor for the given events.
+   * The poll is oneshot, regardless of `EPOLLONESHOT`.
+   *
+   * @param fd file descriptor to poll
+   * @param events epoll events mask
+   * @param ptr pointer to the associated event handler
+   * @param modify unused, kept for compatibility with `Epoll`
+   */
+  void Add(int fd, uint32_t events, void *ptr, bool modify = false);
+
+  /**
+   * This function rearms the poll of the file descriptor.
+   *
+   * @param fd file descriptor to poll
+   * @param events epoll events mask
+   * @param ptr pointer to the associated event handler
+   */
+  void Modify(int fd, uint32_t events, void *ptr) { Add(fd, events, ptr, true); }
+
+  /**
+   * This function cancels the poll of the file descriptor, if there is one.
+   *
+   * @param fd file descriptor to delete
+   */
+  void Delete(int fd);
+
+  /**
+   * This function takes the available events or submits the queued requests
+   * and waits for the events. It can be called from multiple threads, but
+   * only one of them blocks in the kernel at a time.
+   *
+   * @return number of events stored in `events`, 0 on timeout
+   */
+  int Wait(Event *events, int max_events, int timeout);
+
+ private:
+  // Returns the next free submission queue entry, submitting the queued ones
+  // if the ring is full. The `mutex_` has to be locked.
+  io_uring_sqe *NextSqe(std::unique_lock<std::mutex> &guard);
+
+  // Submits the queued entries without waiting for the completions and
+  // returns false if none of them were submitted. The `mutex_` has to be
+  // locked and it is unlocked during the system call.
+  bool Submit(std::unique_lock<std::mutex> &guard);
+
+  // Marks the queued entries which weren't submitted as queued again. The
+  // `mutex_` has to be locked.
+  void Requeue(unsigned to_submit, int submitted);
+
+  // Returns the number of the submitted entries, or -1 if the submission or
+  // the wait ended early.
+  int Enter(unsigned to_submit, unsigned min_complete, unsigned flags, void *arg, size_t arg_size);
+
+  // Takes at most `max_events` completions from the completion ring. The
+  // `mutex_` has to be locked.
+  int Reap(Event *events, int max_events);
+
+  int ring_fd_{-1};
+
+  void *rings_{nullptr};
+  size_t rings_size_{0};
+  io_uring_sqe *sqes_{nullptr};
+  size_t sqes_size_{0};
+
+  // Submission ring.
+  unsigned *sq_head_;
+  unsigned *sq_tail_;
+  unsigned sq_mask_;
+  unsigned sq_entries_;
+  unsigned *sq_array_;
+
+  // Completion ring.
+  unsigned *cq_head_;
+  unsigned *cq_tail_;
+  unsigned cq_mask_;
+  io_uring_cqe *cqes_;
+
+  // Protects the state below and the ring heads and tails which aren't
+  // updated by the kernel. It is never held while waiting in the kernel.
+  std::mutex mutex_;
+  // Notified when the thread blocked in the kernel wakes up, when the
+  // completions are left in the ring, and when requests are queued while a
+  // thread is blocked in the kernel.
+  std::condition_variable cv_;
+  // The tail of the submission ring which isn't visible to the kernel yet.
+  unsigned sq_local_tail_{0};
+  // Number of the entries which are queued, but not submitted.
+  unsigned to_submit_{0};
+  // Whether a thread is blocked in the kernel waiting for the completions.
+  bool in_kernel_{false};
+  // Number of the threads which wait on `cv_` for the thread in the kernel.
+  int idle_waiters_{0};
+  // The user data of the poll which is armed for each file descriptor.
+  std::unordered_map<int, uint64_t> polls_;
+};
+
+}  // namespace io::network
@@ -11,10 +11,13 @@
 
 #include "io/network/socket.hpp"
 
+#include <algorithm>
+#include <climits>
 #include <cstdio>
 #include <cstring>
 #include <iostream>
 #include <stdexcept>
+#include <vector>
 
 #include <arpa/inet.h>
 #include <fcntl.h>
@@ -233,6 +236,44 @@ bool Socket::Write(const std::string &s, bool have_more) const {
   return Write(reinterpret_cast<const uint8_t *>(s.data()), s.size(), have_more);
 }
 
+bool Socket::Write(const iovec *iov, size_t iovcnt, bool have_more) const {
+  // The buffers which are left are copied, so that the first one can be
+  // advanced past the data that was already written.
+  std::vector<iovec> remaining(iov, iov + iovcnt);
+  auto *current = remaining.data();
+  auto *end = remaining.data() + remaining.size();
+  int flags = MSG_NOSIGNAL | (have_more ? MSG_MORE : 0);
+  while (true) {
+    while (current != end && current->iov_len == 0) ++current;
+    if (current == end) return true;
+
+    msghdr message{};
+    message.msg_iov = current;
+    message.msg_iovlen = std::min<size_t>(end - current, IOV_MAX);
+    auto written = sendmsg(socket_, &message, flags);
+    if (written == -1) {
+      if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+        // Terminal error, return failure.
+        return false;
+      }
+      // Non-fatal error, retry after the socket is ready.
+      if (!WaitForReadyWrite()) return false;
+    } else if (written == 0) {
+      // The client closed the connection.
+      return false;
+    } else {
+      auto left = static_cast<size_t>(written);
+      while (left >= current->iov_len) {
+        left -= current->iov_len;
+        ++current;
+        if (current == end) return true;
+      }
+      current->iov_base = static_cast<uint8_t *>(current->iov_base) + left;
+      current->iov_len -= left;
+    }
+  }
+}
+
 ssize_t Socket::Read(void *buffer, size_t len, bool nonblock) const {
   return recv(socket_, buffer, len, nonblock ? MSG_DONTWAIT : 0);
 }
@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include <sys/uio.h>
+
 #include <functional>
 #include <iostream>
 #include <optional>
@@ -151,6 +153,21 @@ class Socket {
   bool Write(const uint8_t *data, size_t len, bool have_more = false) const;
   bool Write(const std::string &s, bool have_more = false) const;
 
+  /**
+   * Write the data of multiple buffers to the socket with as few system calls
+   * as possible. This function guarantees that all data will be written.
+   *
+   * @param iov array of the buffers that should be written
+   * @param iovcnt number of the buffers
+   * @param have_more set to true if you plan to send more data to allow the
+   * kernel to buffer the data instead of immediately sending it out
+   *
+   * @return write success status:
+   *             true if write succeeded
+   *             false if write failed
+   */
+  bool Write(const iovec *iov, size_t iovcnt, bool have_more = false) const;
+
   /**
    * Read data from the socket.
    * This function is a direct wrapper for the read function.
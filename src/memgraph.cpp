@@ -140,9 +140,20 @@ DEFINE_VALIDATED_int32(monitoring_port, 7444,
                        "Port on which the websocket server for Memgraph monitoring should listen.",
                        FLAG_IN_RANGE(0, std::numeric_limits<uint16_t>::max()));
 DEFINE_VALIDATED_int32(bolt_num_workers, std::max(std::thread::hardware_concurrency(), 1U),
-                       "Number of workers used by the Bolt server. By default, this will be the "
+                       "Number of workers executing the interactive Bolt sessions. By default, this will be the "
                        "number of processing units available on the machine.",
                        FLAG_IN_RANGE(1, INT32_MAX));
+DEFINE_VALIDATED_int32(bolt_num_analytical_workers, std::max(std::thread::hardware_concurrency() / 2, 1U),
+                       "Number of workers executing the analytical Bolt sessions, i.e. the ones whose execution runs "
+                       "longer than --bolt-analytical-threshold-ms. They don't take the workers of the interactive "
+                       "sessions.",
+                       FLAG_IN_RANGE(1, INT32_MAX));
+DEFINE_VALIDATED_int32(bolt_analytical_threshold_ms, 1000,
+                       "Time in milliseconds after which an executing Bolt session is considered analytical.",
+                       FLAG_IN_RANGE(1, INT32_MAX));
+DEFINE_VALIDATED_int32(bolt_num_io_workers, std::max(std::thread::hardware_concurrency() / 4, 1U),
+                       "Number of workers reading the requests from the Bolt connections.",
+                       FLAG_IN_RANGE(1, INT32_MAX));
 DEFINE_VALIDATED_int32(bolt_session_inactivity_timeout, 1800,
                        "Time in seconds after which inactive Bolt sessions will be "
                        "closed.",
@@ -229,6 +240,50 @@ DEFINE_double(query_execution_timeout_sec, 600,
               "Maximum allowed query execution time. Queries exceeding this "
               "limit will be aborted. Value of 0 means no limit.");
 
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(query_spill_threshold_mib, 0,
+              "Memory in MiB which ORDER BY, aggregations and DISTINCT may use for their state before spilling it to "
+              "temporary files in the data directory. Queries with a QUERY MEMORY LIMIT spill at that limit. Value of "
+              "0 disables spilling for the other queries.");
+
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(query_stripped_cache_max_memory_mib, 16,
+              "Memory in MiB used by the cached stripped query strings, so that repeated queries aren't tokenized "
+              "again. The least recently used queries are evicted from the cache when it's full.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(query_ast_cache_max_memory_mib, 64,
+              "Memory in MiB used by the cached parsed queries. The least recently used queries are evicted from the "
+              "cache when it's full.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(query_plan_cache_max_memory_mib, 256,
+              "Memory in MiB used by the cached query plans. The least recently used plans are evicted from the cache "
+              "when it's full.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_double(query_plan_replan_factor, 10.0,
+              "Cached query plans are planned again when the number of vertices a scan produces differs from the "
+              "planner's estimate by more than this factor. Value of 0 disables the re-planning.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(query_read_ahead_rows, 0,
+              "Maximum number of result rows of a read-only query produced ahead while the previous rows are being "
+              "sent to the client. Value of 0 disables the read-ahead.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(query_read_ahead_threads, std::max(std::thread::hardware_concurrency(), 1U),
+              "Number of threads producing the result rows of read-only queries ahead.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(query_procedure_threads, std::max(std::thread::hardware_concurrency(), 1U),
+              "Number of threads executing the tasks which read procedures split their work into, in addition to the "
+              "thread calling the procedure.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(query_after_commit_trigger_batch_size, 1,
+              "Maximum number of consecutive transactions whose AFTER COMMIT triggers are executed together, once "
+              "for all of their changes, when the triggers fall behind the commits. The changes aren't merged across "
+              "the transactions, so e.g. a property set in several of them is reported once for each. Value of 1 "
+              "disables it.");
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_uint64(query_after_commit_trigger_threads, 1,
+              "Number of threads executing the AFTER COMMIT triggers. With more than one thread, the triggers of the "
+              "same transactions are executed in parallel.");
+
 // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
 DEFINE_uint64(
     memory_limit, 0,
@@ -269,6 +324,43 @@ DEFINE_VALIDATED_string(isolation_level, "SNAPSHOT_ISOLATION", isolation_level_h
 });
 
 namespace {
+constexpr std::array bolt_io_backend_mappings{std::pair{"epoll"sv, communication::IoBackend::EPOLL},
+                                              std::pair{"io_uring"sv, communication::IoBackend::IO_URING}};
+
+const std::string bolt_io_backend_help_string = fmt::format(
+    "Mechanism which the Bolt server uses to wait for the data on the connections. If the kernel doesn't support "
+    "io_uring, epoll is used instead. Allowed values: {}",
+    GetAllowedEnumValuesString(bolt_io_backend_mappings));
+}  // namespace
+
+// NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+DEFINE_VALIDATED_string(bolt_io_backend, "epoll", bolt_io_backend_help_string.c_str(), {
+  if (const auto result = IsValidEnumValueString(value, bolt_io_backend_mappings); result.HasError()) {
+    const auto error = result.GetError();
+    switch (error) {
+      case ValidationError::EmptyValue: {
+        std::cout << "Bolt I/O backend cannot be empty." << std::endl;
+        break;
+      }
+      case ValidationError::InvalidValue: {
+        std::cout << "Invalid value for Bolt I/O backend. Allowed values: "
+                  << GetAllowedEnumValuesString(bolt_io_backend_mappings) << std::endl;
+        break;
+      }
+    }
+    return false;
+  }
+
+  return true;
+});
+
+namespace {
+communication::IoBackend ParseBoltIoBackend() {
+  const auto io_backend = StringToEnum<communication::IoBackend>(FLAGS_bolt_io_backend, bolt_io_backend_mappings);
+  MG_ASSERT(io_backend, "Invalid Bolt I/O backend");
+  return *io_backend;
+}
+
 storage::IsolationLevel ParseIsolationLevel() {
   const auto isolation_level = StringToEnum<storage::IsolationLevel>(FLAGS_isolation_level, isolation_level_mappings);
   MG_ASSERT(isolation_level, "Invalid isolation level");
@@ -921,19 +1013,20 @@ class BoltSession final : public communication::bolt::Session<communication::Inp
     }
   }
 
-  /// Wrapper around TEncoder which converts TypedValue to Value
+  /// Wrapper around TEncoder which encodes TypedValue directly into Bolt
   /// before forwarding the calls to original TEncoder.
   class TypedValueResultStream {
    public:
-    TypedValueResultStream(TEncoder *encoder, const storage::Storage *db) : encoder_(encoder), db_(db) {}
+    TypedValueResultStream(TEncoder *encoder, const storage::Storage *db)
+        : encoder_(encoder), value_encoder_(db, storage::View::NEW) {}
 
     void Result(const std::vector<query::TypedValue> &values) {
-      std::vector<communication::bolt::Value> decoded_values;
-      decoded_values.reserve(values.size());
-      for (const auto &v : values) {
-        auto maybe_value = glue::ToBoltValue(v, *db_, storage::View::NEW);
-        if (maybe_value.HasError()) {
-          switch (maybe_value.GetError()) {
+      // The values are encoded straight into the chunk buffer, and the
+      // partially written record is discarded when the encoding fails.
+      encoder_->MessageRecord([&](auto &buffer) {
+        auto maybe_encoded = value_encoder_.EncodeList(values, &buffer);
+        if (maybe_encoded.HasError()) {
+          switch (maybe_encoded.GetError()) {
             case storage::Error::DELETED_OBJECT:
               throw communication::bolt::ClientError("Returning a deleted object as a result.");
             case storage::Error::NONEXISTENT_OBJECT:
@@ -944,18 +1037,15 @@ class BoltSession final : public communication::bolt::Session<communication::Inp
               throw communication::bolt::ClientError("Unexpected storage error when streaming results.");
           }
         }
-        decoded_values.emplace_back(std::move(*maybe_value));
-      }
-      encoder_->MessageRecord(decoded_values);
+      });
     }
 
    private:
     TEncoder *encoder_;
-    // NOTE: Needed only for ToBoltValue conversions
-    const storage::Storage *db_;
+    glue::TypedValueBoltEncoder value_encoder_;
   };
 
-  // NOTE: Needed only for ToBoltValue conversions
+  // NOTE: Needed only for encoding the values into Bolt
   const storage::Storage *db_;
   query::Interpreter interpreter_;
   utils::Synchronized<auth::Auth, utils::WritePrioritizedRWLock> *auth_;
@@ -1153,7 +1243,17 @@ int main(int argc, char **argv) {
 
   query::InterpreterContext interpreter_context{
       &db,
-      {.query = {.allow_load_csv = FLAGS_allow_load_csv},
+      {.query = {.allow_load_csv = FLAGS_allow_load_csv,
+                 .spill_threshold_bytes = FLAGS_query_spill_threshold_mib * 1024 * 1024,
+                 .stripped_query_cache_max_memory_bytes = FLAGS_query_stripped_cache_max_memory_mib * 1024 * 1024,
+                 .ast_cache_max_memory_bytes = FLAGS_query_ast_cache_max_memory_mib * 1024 * 1024,
+                 .plan_cache_max_memory_bytes = FLAGS_query_plan_cache_max_memory_mib * 1024 * 1024,
+                 .replan_cardinality_factor = FLAGS_query_plan_replan_factor,
+                 .read_ahead_rows = FLAGS_query_read_ahead_rows,
+                 .read_ahead_threads = FLAGS_query_read_ahead_threads,
+                 .procedure_threads = FLAGS_query_procedure_threads,
+                 .after_commit_trigger_batch_size = FLAGS_query_after_commit_trigger_batch_size,
+                 .after_commit_trigger_threads = FLAGS_query_after_commit_trigger_threads},
        .execution_timeout_sec = FLAGS_query_execution_timeout_sec,
        .default_kafka_bootstrap_servers = FLAGS_kafka_bootstrap_servers,
        .default_pulsar_service_url = FLAGS_pulsar_service_url,
@@ -1180,8 +1280,7 @@ int main(int argc, char **argv) {
     auto storage_accessor = interpreter_context.db->Access();
     auto dba = query::DbAccessor{&storage_accessor};
     interpreter_context.trigger_store.RestoreTriggers(&interpreter_context.ast_cache, &dba,
-                                                      &interpreter_context.antlr_lock, interpreter_context.config.query,
-                                                      interpreter_context.auth_checker);
+                                                      interpreter_context.config.query, interpreter_context.auth_checker);
   }
 
   // As the Stream transformations are using modules, they have to be restored after the query modules are loaded.
@@ -1198,7 +1297,12 @@ int main(int argc, char **argv) {
   }
 
   ServerT server({FLAGS_bolt_address, static_cast<uint16_t>(FLAGS_bolt_port)}, &session_data, &context,
-                 FLAGS_bolt_session_inactivity_timeout, service_name, FLAGS_bolt_num_workers);
+                 FLAGS_bolt_session_inactivity_timeout, service_name, FLAGS_bolt_num_io_workers,
+                 communication::ExecutorConfig{
+                     .interactive_workers = static_cast<size_t>(FLAGS_bolt_num_workers),
+                     .analytical_workers = static_cast<size_t>(FLAGS_bolt_num_analytical_workers),
+                     .analytical_threshold = std::chrono::milliseconds(FLAGS_bolt_analytical_threshold_ms)},
+                 ParseBoltIoBackend());
 
   // Setup telemetry
   std::optional<telemetry::Telemetry> telemetry;
@@ -48,6 +48,23 @@ class EnsureGIL final {
   EnsureGIL &operator=(EnsureGIL &&) = delete;
 };
 
+/// Release the GIL held by the current thread, so that other threads can
+/// execute Python code in the meantime. The GIL is reacquired on destruction.
+///
+/// You must *not* use Python C API, nor touch any Python objects while the GIL
+/// is released.
+class ReleaseGIL final {
+  PyThreadState *thread_state_;
+
+ public:
+  ReleaseGIL() noexcept : thread_state_(PyEval_SaveThread()) {}
+  ~ReleaseGIL() noexcept { PyEval_RestoreThread(thread_state_); }
+  ReleaseGIL(const ReleaseGIL &) = delete;
+  ReleaseGIL(ReleaseGIL &&) = delete;
+  ReleaseGIL &operator=(const ReleaseGIL &) = delete;
+  ReleaseGIL &operator=(ReleaseGIL &&) = delete;
+};
+
 /// Owns a `PyObject *` and supports a more C++ idiomatic API to objects.
 class [[nodiscard]] Object final {
   PyObject *ptr_{nullptr};
@@ -10,13 +10,46 @@
 // licenses/APL.txt.
 
 #pragma once
+#include <algorithm>
 #include <chrono>
+#include <cstdint>
 #include <string>
+#include <thread>
 
 namespace query {
 struct InterpreterConfig {
   struct Query {
     bool allow_load_csv{true};
+    // Number of bytes OrderBy, Aggregate and Distinct may use for their state
+    // before spilling it to disk. Value of 0 disables spilling, unless the
+    // query has a memory limit.
+    uint64_t spill_threshold_bytes{0};
+    // Maximum (estimated) memory in bytes used by the cached stripped queries,
+    // ASTs and plans. The least recently used ones are evicted when the cache
+    // is full.
+    uint64_t stripped_query_cache_max_memory_bytes{16 * 1024 * 1024};
+    uint64_t ast_cache_max_memory_bytes{64 * 1024 * 1024};
+    uint64_t plan_cache_max_memory_bytes{256 * 1024 * 1024};
+    // A cached plan is planned again when a scan produces more or fewer
+    // vertices than estimated by this factor. Value of 0 disables it.
+    double replan_cardinality_factor{10.0};
+    // Maximum number of rows of a read-only query produced ahead of streaming
+    // them, on a pool of `read_ahead_threads` threads. Value of 0, the
+    // default, disables it.
+    uint64_t read_ahead_rows{0};
+    uint64_t read_ahead_threads{std::max(std::thread::hardware_concurrency(), 1U)};
+    // Number of threads executing the tasks which the read procedures split
+    // their work into. The thread calling the procedure executes them too.
+    uint64_t procedure_threads{std::max(std::thread::hardware_concurrency(), 1U)};
+    // Maximum number of the consecutive transactions whose after commit
+    // triggers are executed together, once for all of their changes, when the
+    // triggers fall behind the commits. The changes of the transactions are
+    // appended, not merged, see TriggerContext::Append. Value of 1, the
+    // default, disables it.
+    uint64_t after_commit_trigger_batch_size{1};
+    // Number of threads executing the after commit triggers. The triggers of
+    // the same transactions are executed in parallel if there's more than one.
+    uint64_t after_commit_trigger_threads{1};
   } query;
 
   // The default execution timeout is 10 minutes.
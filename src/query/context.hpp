@@ -11,15 +11,20 @@
 
 #pragma once
 
+#include <filesystem>
+#include <optional>
 #include <type_traits>
 
 #include "query/common.hpp"
 #include "query/frontend/semantic/symbol_table.hpp"
 #include "query/metadata.hpp"
 #include "query/parameters.hpp"
+#include "query/plan/cardinality_feedback.hpp"
 #include "query/plan/profile.hpp"
 #include "query/trigger.hpp"
 #include "utils/async_timer.hpp"
+#include "utils/memory.hpp"
+#include "utils/thread_pool.hpp"
 
 namespace query {
 
@@ -60,6 +65,16 @@ inline std::vector<storage::LabelId> NamesToLabels(const std::vector<std::string
   return labels;
 }
 
+/// Settings for the operators which keep their state in temporary files when
+/// it doesn't fit in memory.
+struct SpillConfig {
+  /// Directory for the temporary files.
+  std::filesystem::path directory;
+  /// Number of bytes of state an operator may keep in memory before spilling
+  /// it to disk. Spilling is disabled if not set.
+  std::optional<size_t> threshold;
+};
+
 struct ExecutionContext {
   DbAccessor *db_accessor{nullptr};
   SymbolTable symbol_table;
@@ -72,6 +87,17 @@ struct ExecutionContext {
   ExecutionStats execution_stats;
   TriggerContextCollector *trigger_context_collector{nullptr};
   utils::AsyncTimer timer;
+  SpillConfig spill;
+  // Counts all of the memory used by the query, including the memory of each
+  // Pull. The memory which the operators allocate for their own state should
+  // also be counted by it. Not set if the memory isn't tracked.
+  utils::TrackingMemoryResource *memory_tracker{nullptr};
+  // Collects the number of vertices produced by the scans, to be compared
+  // with the estimates of the cached plan. Not set if they aren't collected.
+  plan::CardinalityFeedback *cardinality_feedback{nullptr};
+  // Executes the tasks of the read procedures in parallel. If not set, the
+  // tasks are executed by the thread calling the procedure.
+  utils::ThreadPool *procedure_pool{nullptr};
 };
 
 static_assert(std::is_move_assignable_v<ExecutionContext>, "ExecutionContext must be move assignable!");
@@ -11,29 +11,42 @@
 
 #include "query/cypher_query_interpreter.hpp"
 
+#include "utils/event_counter.hpp"
+
 // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
 DEFINE_HIDDEN_bool(query_cost_planner, true, "Use the cost-estimating query planner.");
 // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
-DEFINE_VALIDATED_int32(query_plan_cache_ttl, 60, "Time to live for cached query plans, in seconds.",
+DEFINE_VALIDATED_int32(query_plan_cache_ttl, 0,
+                       "Time to live for cached query plans, in seconds. The cached plans are invalidated when "
+                       "indices, constraints or graph statistics change, so the value of 0 disables the expiration.",
                        FLAG_IN_RANGE(0, std::numeric_limits<int32_t>::max()));
 
+namespace EventCounter {
+extern const Event QueryCacheHit;
+extern const Event QueryCacheMiss;
+extern const Event PlanCacheHit;
+extern const Event PlanCacheMiss;
+}  // namespace EventCounter
+
 namespace query {
-CachedPlan::CachedPlan(std::unique_ptr<LogicalPlan> plan) : plan_(std::move(plan)) {}
+CachedPlan::CachedPlan(std::unique_ptr<LogicalPlan> plan, std::vector<plan::ScanEstimate> scan_estimates)
+    : plan_(std::move(plan)), scan_estimates_(std::move(scan_estimates)) {}
 
 ParsedQuery ParseQuery(const std::string &query_string, const std::map<std::string, storage::PropertyValue> &params,
-                       utils::SkipList<QueryCacheEntry> *cache, utils::SpinLock *antlr_lock,
-                       const InterpreterConfig::Query &query_config) {
+                       QueryCache *cache, const InterpreterConfig::Query &query_config,
+                       frontend::StrippedQueryCache *stripped_query_cache) {
   // Strip the query for caching purposes. The process of stripping a query
   // "normalizes" it by replacing any literals with new parameters. This
   // results in just the *structure* of the query being taken into account for
-  // caching.
-  frontend::StrippedQuery stripped_query{query_string};
+  // caching. Repeated queries are stripped only once when the stripped queries
+  // are cached.
+  auto stripped_query = frontend::StripQuery(query_string, stripped_query_cache);
 
   // Copy over the parameters that were introduced during stripping.
-  Parameters parameters{stripped_query.literals()};
+  Parameters parameters{stripped_query->literals()};
 
   // Check that all user-specified parameters are provided.
-  for (const auto &param_pair : stripped_query.parameters()) {
+  for (const auto &param_pair : stripped_query->parameters()) {
     auto it = params.find(param_pair.second);
 
     if (it == params.end()) {
@@ -44,9 +57,8 @@ ParsedQuery ParseQuery(const std::string &query_string, const std::map<std::stri
   }
 
   // Cache the query's AST if it isn't already.
-  auto hash = stripped_query.hash();
-  auto accessor = cache->access();
-  auto it = accessor.find(hash);
+  auto hash = stripped_query->hash();
+  auto cached_query = cache->Find(hash);
   std::unique_ptr<frontend::opencypher::Parser> parser;
 
   // Return a copy of both the AST storage and the query.
@@ -62,21 +74,18 @@ ParsedQuery ParseQuery(const std::string &query_string, const std::map<std::stri
     result.required_privileges = cached_query.required_privileges;
   };
 
-  if (it == accessor.end()) {
-    {
-      std::unique_lock<utils::SpinLock> guard(*antlr_lock);
-
-      try {
-        parser = std::make_unique<frontend::opencypher::Parser>(stripped_query.query());
-      } catch (const SyntaxException &e) {
-        // There is a syntax exception in the stripped query. Re-run the parser
-        // on the original query to get an appropriate error messsage.
-        parser = std::make_unique<frontend::opencypher::Parser>(query_string);
-
-        // If an exception was not thrown here, the stripper messed something
-        // up.
-        LOG_FATAL("The stripped query can't be parsed, but the original can.");
-      }
+  if (!cached_query) {
+    EventCounter::IncrementCounter(EventCounter::QueryCacheMiss);
+    try {
+      parser = std::make_unique<frontend::opencypher::Parser>(stripped_query->query());
+    } catch (const SyntaxException &e) {
+      // There is a syntax exception in the stripped query. Re-run the parser
+      // on the original query to get an appropriate error messsage.
+      parser = std::make_unique<frontend::opencypher::Parser>(query_string);
+
+      // If an exception was not thrown here, the stripper messed something
+      // up.
+      LOG_FATAL("The stripped query can't be parsed, but the original can.");
     }
 
     // Convert the ANTLR4 parse tree into an AST.
@@ -91,10 +100,12 @@ ParsedQuery ParseQuery(const std::string &query_string, const std::map<std::stri
     }
 
     if (visitor.GetQueryInfo().is_cacheable) {
-      CachedQuery cached_query{std::move(ast_storage), visitor.query(), query::GetRequiredPrivileges(visitor.query())};
-      it = accessor.insert({hash, std::move(cached_query)}).first;
+      const auto memory_usage = ast_storage.GetMemoryUsage() + sizeof(CachedQuery);
+      auto query_to_cache = std::make_shared<const CachedQuery>(
+          CachedQuery{std::move(ast_storage), visitor.query(), query::GetRequiredPrivileges(visitor.query())});
+      cached_query = cache->Insert(hash, std::move(query_to_cache), memory_usage);
 
-      get_information_from_cache(it->second);
+      get_information_from_cache(*cached_query);
     } else {
       result.ast_storage.properties_ = ast_storage.properties_;
       result.ast_storage.labels_ = ast_storage.labels_;
@@ -106,7 +117,8 @@ ParsedQuery ParseQuery(const std::string &query_string, const std::map<std::stri
       is_cacheable = false;
     }
   } else {
-    get_information_from_cache(it->second);
+    EventCounter::IncrementCounter(EventCounter::QueryCacheHit);
+    get_information_from_cache(*cached_query);
   }
 
   return ParsedQuery{query_string,
@@ -124,34 +136,37 @@ std::unique_ptr<LogicalPlan> MakeLogicalPlan(AstStorage ast_storage, CypherQuery
                                              const std::vector<Identifier *> &predefined_identifiers) {
   auto vertex_counts = plan::MakeVertexCountCache(db_accessor);
   auto symbol_table = MakeSymbolTable(query, predefined_identifiers);
-  auto planning_context = plan::MakePlanningContext(&ast_storage, &symbol_table, query, &vertex_counts);
+  auto planning_context = plan::MakePlanningContext(&ast_storage, &symbol_table, query, &vertex_counts, &parameters);
   auto [root, cost] = plan::MakeLogicalPlan(&planning_context, parameters, FLAGS_query_cost_planner);
   return std::make_unique<SingleNodeLogicalPlan>(std::move(root), cost, std::move(ast_storage),
                                                  std::move(symbol_table));
 }
 
 std::shared_ptr<CachedPlan> CypherQueryToPlan(uint64_t hash, AstStorage ast_storage, CypherQuery *query,
-                                              const Parameters &parameters, utils::SkipList<PlanCacheEntry> *plan_cache,
+                                              const Parameters &parameters, PlanCache *plan_cache,
                                               DbAccessor *db_accessor,
                                               const std::vector<Identifier *> &predefined_identifiers) {
-  std::optional<utils::SkipList<PlanCacheEntry>::Accessor> plan_cache_access;
   if (plan_cache) {
-    plan_cache_access.emplace(plan_cache->access());
-    auto it = plan_cache_access->find(hash);
-    if (it != plan_cache_access->end()) {
-      if (it->second->IsExpired()) {
-        plan_cache_access->remove(hash);
-      } else {
-        return it->second;
+    if (auto plan = plan_cache->Find(hash)) {
+      if (!plan->IsExpired()) {
+        EventCounter::IncrementCounter(EventCounter::PlanCacheHit);
+        return plan;
       }
+      plan_cache->Erase(hash);
     }
+    EventCounter::IncrementCounter(EventCounter::PlanCacheMiss);
   }
 
-  auto plan = std::make_shared<CachedPlan>(
-      MakeLogicalPlan(std::move(ast_storage), query, parameters, db_accessor, predefined_identifiers));
-  if (plan_cache_access) {
-    plan_cache_access->insert({hash, plan});
+  auto logical_plan = MakeLogicalPlan(std::move(ast_storage), query, parameters, db_accessor, predefined_identifiers);
+  if (plan_cache) {
+    // The estimates are compared with the observed cardinalities during
+    // execution, to find out when the cached plan no longer fits the graph.
+    auto vertex_counts = plan::MakeVertexCountCache(db_accessor);
+    auto scan_estimates = plan::EstimateScanCardinalities(&vertex_counts, parameters, logical_plan->GetRoot());
+    auto plan = std::make_shared<CachedPlan>(std::move(logical_plan), std::move(scan_estimates));
+    const auto memory_usage = plan->memory_usage() + sizeof(CachedPlan);
+    return plan_cache->Insert(hash, std::move(plan), memory_usage);
   }
-  return plan;
+  return std::make_shared<CachedPlan>(std::move(logical_plan));
 }
 }  // namespace query
@@ -11,13 +11,17 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "query/config.hpp"
 #include "query/frontend/ast/cypher_main_visitor.hpp"
 #include "query/frontend/opencypher/parser.hpp"
 #include "query/frontend/semantic/required_privileges.hpp"
 #include "query/frontend/semantic/symbol_generator.hpp"
 #include "query/frontend/stripped.hpp"
+#include "query/plan/cardinality_feedback.hpp"
 #include "query/plan/planner.hpp"
+#include "utils/cache.hpp"
 #include "utils/flag_validation.hpp"
 #include "utils/timer.hpp"
 
@@ -45,25 +49,41 @@ class LogicalPlan {
   virtual double GetCost() const = 0;
   virtual const SymbolTable &GetSymbolTable() const = 0;
   virtual const AstStorage &GetAstStorage() const = 0;
+
+  /// Estimate of the memory used by the plan in bytes.
+  virtual uint64_t GetMemoryUsage() const = 0;
 };
 
 class CachedPlan {
  public:
-  explicit CachedPlan(std::unique_ptr<LogicalPlan> plan);
+  explicit CachedPlan(std::unique_ptr<LogicalPlan> plan, std::vector<plan::ScanEstimate> scan_estimates = {});
 
   const auto &plan() const { return plan_->GetRoot(); }
   double cost() const { return plan_->GetCost(); }
   const auto &symbol_table() const { return plan_->GetSymbolTable(); }
   const auto &ast_storage() const { return plan_->GetAstStorage(); }
+  uint64_t memory_usage() const {
+    return plan_->GetMemoryUsage() + scan_estimates_.size() * sizeof(plan::ScanEstimate);
+  }
+  /// Cardinalities of the scans estimated when the plan was made. Empty if
+  /// the plan isn't cached.
+  const auto &scan_estimates() const { return scan_estimates_; }
 
   bool IsExpired() const {
+    if (is_stale_.load(std::memory_order_acquire)) return true;
     // NOLINTNEXTLINE (modernize-use-nullptr)
-    return cache_timer_.Elapsed() > std::chrono::seconds(FLAGS_query_plan_cache_ttl);
+    return FLAGS_query_plan_cache_ttl > 0 && cache_timer_.Elapsed() > std::chrono::seconds(FLAGS_query_plan_cache_ttl);
   };
 
+  /// Expires the plan, so that the query is planned again the next time it's
+  /// run. The executions which already use the plan aren't affected.
+  void MarkStale() { is_stale_.store(true, std::memory_order_release); }
+
  private:
   std::unique_ptr<LogicalPlan> plan_;
+  std::vector<plan::ScanEstimate> scan_estimates_;
   utils::Timer cache_timer_;
+  std::atomic<bool> is_stale_{false};
 };
 
 struct CachedQuery {
@@ -72,29 +92,11 @@ struct CachedQuery {
   std::vector<AuthQuery::Privilege> required_privileges;
 };
 
-struct QueryCacheEntry {
-  bool operator==(const QueryCacheEntry &other) const { return first == other.first; }
-  bool operator<(const QueryCacheEntry &other) const { return first < other.first; }
-  bool operator==(const uint64_t &other) const { return first == other; }
-  bool operator<(const uint64_t &other) const { return first < other; }
-
-  uint64_t first;
-  // TODO: Maybe store the query string here and use it as a key with the hash
-  // so that we eliminate the risk of hash collisions.
-  CachedQuery second;
-};
-
-struct PlanCacheEntry {
-  bool operator==(const PlanCacheEntry &other) const { return first == other.first; }
-  bool operator<(const PlanCacheEntry &other) const { return first < other.first; }
-  bool operator==(const uint64_t &other) const { return first == other; }
-  bool operator<(const uint64_t &other) const { return first < other; }
-
-  uint64_t first;
-  // TODO: Maybe store the query string here and use it as a key with the hash
-  // so that we eliminate the risk of hash collisions.
-  std::shared_ptr<CachedPlan> second;
-};
+// The caches are keyed by the hash of the stripped query.
+// TODO: Maybe store the query string in the cached objects and compare it with
+// the hash so that we eliminate the risk of hash collisions.
+using QueryCache = utils::MemoryBoundedLruCache<uint64_t, const CachedQuery>;
+using PlanCache = utils::MemoryBoundedLruCache<uint64_t, CachedPlan>;
 
 /**
  * A container for data related to the parsing of a query.
@@ -103,7 +105,7 @@ struct ParsedQuery {
   std::string query_string;
   std::map<std::string, storage::PropertyValue> user_parameters;
   Parameters parameters;
-  frontend::StrippedQuery stripped_query;
+  std::shared_ptr<const frontend::StrippedQuery> stripped_query;
   AstStorage ast_storage;
   Query *query;
   std::vector<AuthQuery::Privilege> required_privileges;
@@ -111,8 +113,8 @@ struct ParsedQuery {
 };
 
 ParsedQuery ParseQuery(const std::string &query_string, const std::map<std::string, storage::PropertyValue> &params,
-                       utils::SkipList<QueryCacheEntry> *cache, utils::SpinLock *antlr_lock,
-                       const InterpreterConfig::Query &query_config);
+                       QueryCache *cache, const InterpreterConfig::Query &query_config,
+                       frontend::StrippedQueryCache *stripped_query_cache = nullptr);
 
 class SingleNodeLogicalPlan final : public LogicalPlan {
  public:
@@ -124,6 +126,11 @@ class SingleNodeLogicalPlan final : public LogicalPlan {
   double GetCost() const override { return cost_; }
   const SymbolTable &GetSymbolTable() const override { return symbol_table_; }
   const AstStorage &GetAstStorage() const override { return storage_; }
+  // The operators and their symbols are small compared to the expressions in
+  // the AST storage, so only the latter are taken into account.
+  uint64_t GetMemoryUsage() const override {
+    return sizeof(*this) + storage_.GetMemoryUsage() + symbol_table_.max_position() * sizeof(Symbol);
+  }
 
  private:
   std::unique_ptr<plan::LogicalOperator> root_;
@@ -145,7 +152,7 @@ std::unique_ptr<LogicalPlan> MakeLogicalPlan(AstStorage ast_storage, CypherQuery
  * because a predefined identifier can be used only in one scope.
  */
 std::shared_ptr<CachedPlan> CypherQueryToPlan(uint64_t hash, AstStorage ast_storage, CypherQuery *query,
-                                              const Parameters &parameters, utils::SkipList<PlanCacheEntry> *plan_cache,
+                                              const Parameters &parameters, PlanCache *plan_cache,
                                               DbAccessor *db_accessor,
                                               const std::vector<Identifier *> &predefined_identifiers = {});
 
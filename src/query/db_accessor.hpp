@@ -356,6 +356,10 @@ class DbAccessor final {
   storage::IndicesInfo ListAllIndices() const { return accessor_->ListAllIndices(); }
 
   storage::ConstraintsInfo ListAllConstraints() const { return accessor_->ListAllConstraints(); }
+
+  std::shared_ptr<const storage::GraphStatistics> GetGraphStatistics() const {
+    return accessor_->GetGraphStatistics();
+  }
 };
 
 }  // namespace query
@@ -93,6 +93,7 @@ class CreateSnapshotQuery;
 class StreamQuery;
 class SettingQuery;
 class VersionQuery;
+class AnalyzeGraphQuery;
 
 using TreeCompositeVisitor = ::utils::CompositeVisitor<
     SingleQuery, CypherUnion, NamedExpression, OrOperator, XorOperator, AndOperator, NotOperator, AdditionOperator,
@@ -127,6 +128,6 @@ template <class TResult>
 class QueryVisitor : public ::utils::Visitor<TResult, CypherQuery, ExplainQuery, ProfileQuery, IndexQuery, AuthQuery,
                                              InfoQuery, ConstraintQuery, DumpQuery, ReplicationQuery, LockPathQuery,
                                              FreeMemoryQuery, TriggerQuery, IsolationLevelQuery, CreateSnapshotQuery,
-                                             StreamQuery, SettingQuery, VersionQuery> {};
+                                             StreamQuery, SettingQuery, VersionQuery, AnalyzeGraphQuery> {};
 
 }  // namespace query
@@ -554,7 +554,7 @@ std::string_view ToString(const CommonStreamConfigKey key) {
     __VA_ARGS__                                                      \
   };
 
-GENERATE_STREAM_CONFIG_KEY_ENUM(Kafka, TOPICS, CONSUMER_GROUP, BOOTSTRAP_SERVERS, CONFIGS, CREDENTIALS);
+GENERATE_STREAM_CONFIG_KEY_ENUM(Kafka, TOPICS, CONSUMER_GROUP, BOOTSTRAP_SERVERS, CONFIGS, CREDENTIALS, PARALLELISM);
 
 std::string_view ToString(const KafkaConfigKey key) {
   switch (key) {
@@ -568,6 +568,8 @@ std::string_view ToString(const KafkaConfigKey key) {
       return "CONFIGS";
     case KafkaConfigKey::CREDENTIALS:
       return "CREDENTIALS";
+    case KafkaConfigKey::PARALLELISM:
+      return "PARALLELISM";
   }
 }
 
@@ -610,6 +612,7 @@ antlrcpp::Any CypherMainVisitor::visitKafkaCreateStream(MemgraphCypher::KafkaCre
                                                                    stream_query->configs_);
   MapConfig<false, std::unordered_map<Expression *, Expression *>>(memory_, KafkaConfigKey::CREDENTIALS,
                                                                    stream_query->credentials_);
+  MapConfig<false, Expression *>(memory_, KafkaConfigKey::PARALLELISM, stream_query->parallelism_);
 
   MapCommonStreamConfigs(memory_, *stream_query);
 
@@ -672,6 +675,16 @@ antlrcpp::Any CypherMainVisitor::visitKafkaCreateStreamConfig(MemgraphCypher::Ka
     return {};
   }
 
+  if (ctx->PARALLELISM()) {
+    ThrowIfExists(memory_, KafkaConfigKey::PARALLELISM);
+    if (!ctx->parallelism->numberLiteral() || !ctx->parallelism->numberLiteral()->integerLiteral()) {
+      throw SemanticException("Parallelism must be an integer literal!");
+    }
+    constexpr auto parallelism_key = static_cast<uint8_t>(KafkaConfigKey::PARALLELISM);
+    memory_[parallelism_key] = ctx->parallelism->accept(this).as<Expression *>();
+    return {};
+  }
+
   MG_ASSERT(ctx->BOOTSTRAP_SERVERS());
   ThrowIfExists(memory_, KafkaConfigKey::BOOTSTRAP_SERVERS);
   if (!ctx->bootstrapServers->StringLiteral()) {
@@ -876,6 +889,12 @@ antlrcpp::Any CypherMainVisitor::visitVersionQuery(MemgraphCypher::VersionQueryC
   return version_query;
 }
 
+antlrcpp::Any CypherMainVisitor::visitAnalyzeGraphQuery(MemgraphCypher::AnalyzeGraphQueryContext * /*ctx*/) {
+  auto *analyze_graph_query = storage_->Create<AnalyzeGraphQuery>();
+  query_ = analyze_graph_query;
+  return analyze_graph_query;
+}
+
 antlrcpp::Any CypherMainVisitor::visitCypherUnion(MemgraphCypher::CypherUnionContext *ctx) {
   bool distinct = !ctx->ALL();
   auto *cypher_union = storage_->Create<CypherUnion>(distinct);
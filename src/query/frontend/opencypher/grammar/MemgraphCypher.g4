@@ -22,6 +22,7 @@ import Cypher ;
 memgraphCypherKeyword : cypherKeyword
                       | AFTER
                       | ALTER
+                      | ANALYZE
                       | ASYNC
                       | AUTH
                       | BAD
@@ -51,6 +52,7 @@ memgraphCypherKeyword : cypherKeyword
                       | FROM
                       | GLOBAL
                       | GRANT
+                      | GRAPH
                       | HEADER
                       | IDENTIFIED
                       | ISOLATION
@@ -62,6 +64,7 @@ memgraphCypherKeyword : cypherKeyword
                       | MODE
                       | NEXT
                       | NO
+                      | PARALLELISM
                       | PASSWORD
                       | PULSAR
                       | PORT
@@ -121,6 +124,7 @@ query : cypherQuery
       | streamQuery
       | settingQuery
       | versionQuery
+      | analyzeGraphQuery
       ;
 
 authQuery : createRole
@@ -324,6 +328,7 @@ kafkaCreateStreamConfig : TOPICS topicNames
                         | BOOTSTRAP_SERVERS bootstrapServers=literal
                         | CONFIGS configsMap=configMap
                         | CREDENTIALS credentialsMap=configMap
+                        | PARALLELISM parallelism=literal
                         | commonCreateStreamConfig
                         ;
 
@@ -362,3 +367,5 @@ showSetting : SHOW DATABASE SETTING settingName ;
 showSettings : SHOW DATABASE SETTINGS ;
 
 versionQuery : SHOW VERSION ;
+
+analyzeGraphQuery : ANALYZE GRAPH ;
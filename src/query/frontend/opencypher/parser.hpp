@@ -12,6 +12,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "antlr4-runtime.h"
 #include "query/exceptions.hpp"
@@ -34,6 +35,7 @@ class Parser {
    *        the first step is to generate AST
    */
   Parser(const std::string query) : query_(std::move(query)) {
+    UseThreadLocalPredictionCaches();
     parser_.removeErrorListeners();
     parser_.addErrorListener(&error_listener_);
     tree_ = parser_.cypher();
@@ -45,6 +47,39 @@ class Parser {
   auto tree() { return tree_; }
 
  private:
+  /// DFA states and prediction contexts which ANTLR caches while it predicts
+  /// the alternatives of the grammar.
+  struct PredictionCache {
+    explicit PredictionCache(const antlr4::atn::ATN &atn) {
+      decision_to_dfa.reserve(atn.getNumberOfDecisions());
+      for (size_t i = 0; i < atn.getNumberOfDecisions(); ++i) {
+        decision_to_dfa.emplace_back(atn.getDecisionState(i), i);
+      }
+    }
+
+    std::vector<antlr4::dfa::DFA> decision_to_dfa;
+    antlr4::atn::PredictionContextCache shared_context_cache;
+  };
+
+  // The generated lexer and parser share a single static prediction cache
+  // between all of their instances, which isn't safe to update from multiple
+  // threads at once. Each thread gets its own caches instead, so the queries
+  // can be parsed concurrently without a global lock. The caches are filled
+  // by the first few parses on each thread and then stay warm for the lifetime
+  // of the (worker) thread.
+  void UseThreadLocalPredictionCaches() {
+    thread_local PredictionCache lexer_cache{lexer_.getATN()};
+    thread_local PredictionCache parser_cache{parser_.getATN()};
+    // The generated recognizers own their interpreters and delete them on
+    // destruction.
+    delete lexer_.getInterpreter<antlr4::atn::LexerATNSimulator>();
+    lexer_.setInterpreter(new antlr4::atn::LexerATNSimulator(&lexer_, lexer_.getATN(), lexer_cache.decision_to_dfa,
+                                                             lexer_cache.shared_context_cache));
+    delete parser_.getInterpreter<antlr4::atn::ParserATNSimulator>();
+    parser_.setInterpreter(new antlr4::atn::ParserATNSimulator(&parser_, parser_.getATN(), parser_cache.decision_to_dfa,
+                                                               parser_cache.shared_context_cache));
+  }
+
   class FirstMessageErrorListener : public antlr4::BaseErrorListener {
     void syntaxError(antlr4::Recognizer *, antlr4::Token *, size_t line, size_t position, const std::string &message,
                      std::exception_ptr) override {
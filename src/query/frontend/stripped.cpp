@@ -57,17 +57,34 @@ StrippedQuery::StrippedQuery(const std::string &query) : original_(query) {
         token = new_token;
       }
     };
-    update(MatchKeyword(i), Token::KEYWORD);
-    update(MatchSpecial(i), Token::SPECIAL);
-    update(MatchString(i), Token::STRING);
-    update(MatchDecimalInt(i), Token::INT);
-    update(MatchOctalInt(i), Token::INT);
-    update(MatchHexadecimalInt(i), Token::INT);
-    update(MatchReal(i), Token::REAL);
-    update(MatchParameter(i), Token::PARAMETER);
-    update(MatchEscapedName(i), Token::ESCAPED_NAME);
-    update(MatchUnescapedName(i), Token::UNESCAPED_NAME);
-    update(MatchWhitespaceAndComments(i), Token::SPACE);
+    // Most of the tokens start with an ASCII letter, digit or whitespace, which
+    // only some of the matchers accept, so the rest of them aren't tried. The
+    // order of the matchers stays the same, because the first one of the
+    // longest matches wins.
+    const auto first = static_cast<unsigned char>(original_[i]);
+    if (('a' <= first && first <= 'z') || ('A' <= first && first <= 'Z') || first == '_') {
+      update(MatchKeyword(i), Token::KEYWORD);
+      update(MatchUnescapedName(i), Token::UNESCAPED_NAME);
+    } else if ('0' <= first && first <= '9') {
+      update(MatchDecimalInt(i), Token::INT);
+      update(MatchOctalInt(i), Token::INT);
+      update(MatchHexadecimalInt(i), Token::INT);
+      update(MatchReal(i), Token::REAL);
+    } else if (first < 0x80 && kSpaceParts[first]) {
+      update(MatchWhitespaceAndComments(i), Token::SPACE);
+    } else {
+      update(MatchKeyword(i), Token::KEYWORD);
+      update(MatchSpecial(i), Token::SPECIAL);
+      update(MatchString(i), Token::STRING);
+      update(MatchDecimalInt(i), Token::INT);
+      update(MatchOctalInt(i), Token::INT);
+      update(MatchHexadecimalInt(i), Token::INT);
+      update(MatchReal(i), Token::REAL);
+      update(MatchParameter(i), Token::PARAMETER);
+      update(MatchEscapedName(i), Token::ESCAPED_NAME);
+      update(MatchUnescapedName(i), Token::UNESCAPED_NAME);
+      update(MatchWhitespaceAndComments(i), Token::SPACE);
+    }
     if (token == Token::UNMATCHED) throw LexingException("Invalid query.");
     tokens.emplace_back(token, original_.substr(i, len));
     i += len;
@@ -251,6 +268,29 @@ StrippedQuery::StrippedQuery(const std::string &query) : original_(query) {
   }
 }
 
+uint64_t StrippedQuery::GetMemoryUsage() const {
+  uint64_t memory_usage = sizeof(*this) + original_.capacity() + query_.capacity() +
+                          literals_.size() * sizeof(std::pair<int, storage::PropertyValue>);
+  for (const auto &[position, name] : parameters_) {
+    memory_usage += sizeof(std::pair<const int, std::string>) + name.capacity();
+  }
+  for (const auto &[position, named_expression] : named_exprs_) {
+    memory_usage += sizeof(std::pair<const int, std::string>) + named_expression.capacity();
+  }
+  return memory_usage;
+}
+
+std::shared_ptr<const StrippedQuery> StripQuery(const std::string &query, StrippedQueryCache *cache) {
+  if (!cache) return std::make_shared<const StrippedQuery>(query);
+  const auto hash = utils::Fnv(query);
+  // The text is compared because different queries may have the same hash.
+  if (auto cached = cache->Find(hash); cached && cached->original_query() == query) return cached;
+  auto stripped_query = std::make_shared<const StrippedQuery>(query);
+  // A different query with the same hash stays in the cache if it's there.
+  cache->Insert(hash, stripped_query, stripped_query->GetMemoryUsage());
+  return stripped_query;
+}
+
 std::string GetFirstUtf8Symbol(const char *_s) {
   // According to
   // https://stackoverflow.com/questions/16260033/reinterpret-cast-between-char-and-stduint8-t-safe
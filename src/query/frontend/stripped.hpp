@@ -11,10 +11,12 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 
 #include "query/parameters.hpp"
+#include "utils/cache.hpp"
 #include "utils/fnv.hpp"
 
 namespace query::frontend {
@@ -63,6 +65,9 @@ class StrippedQuery {
   const auto &parameters() const { return parameters_; }
   uint64_t hash() const { return hash_; }
 
+  /// Estimate of the memory used by the stripped query in bytes.
+  uint64_t GetMemoryUsage() const;
+
  private:
   // Return len of matched keyword if something is matched, otherwise 0.
   int MatchKeyword(int start) const;
@@ -100,4 +105,18 @@ class StrippedQuery {
   uint64_t hash_;
 };
 
+/// Stripped queries keyed by the hash of the original query text, so that
+/// repeated queries are only stripped once.
+using StrippedQueryCache = utils::MemoryBoundedLruCache<uint64_t, const StrippedQuery>;
+
+/**
+ * Returns the stripped query from the cache, or strips the query and caches
+ * it if the same query text wasn't stripped recently.
+ *
+ * @param query Input query.
+ * @param cache Cache of the stripped queries, the query is stripped without
+ * caching if it's nullptr.
+ */
+std::shared_ptr<const StrippedQuery> StripQuery(const std::string &query, StrippedQueryCache *cache);
+
 }  // namespace query::frontend
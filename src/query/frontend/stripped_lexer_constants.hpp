@@ -191,6 +191,7 @@ const trie::Trie kKeywords = {"union",
                               "batch_interval",
                               "batch_size",
                               "consumer_group",
+                              "parallelism",
                               "start",
                               "stream",
                               "streams",
@@ -204,7 +205,9 @@ const trie::Trie kKeywords = {"union",
                               "pulsar",
                               "service_url",
                               "version",
-                              "websocket"};
+                              "websocket",
+                              "analyze",
+                              "graph"};
 
 // Unicode codepoints that are allowed at the start of the unescaped name.
 const std::bitset<kBitsetSize> kUnescapedNameAllowedStarts(
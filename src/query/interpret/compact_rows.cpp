@@ -0,0 +1,195 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "query/interpret/compact_rows.hpp"
+
+#include <cstring>
+
+#include "utils/logging.hpp"
+#include "utils/temporal.hpp"
+
+namespace query {
+
+template <class T>
+T CompactValue::Payload() const {
+  static_assert(sizeof(T) <= sizeof(data_));
+  T value;
+  std::memcpy(&value, data_, sizeof(T));
+  return value;
+}
+
+template <class T>
+void CompactValue::SetPayload(const Kind kind, const T value) {
+  static_assert(sizeof(T) <= sizeof(data_));
+  kind_ = kind;
+  std::memcpy(data_, &value, sizeof(T));
+}
+
+std::optional<CompactValue> CompactValue::Inline(const TypedValue &value) {
+  CompactValue compact;
+  switch (value.type()) {
+    case TypedValue::Type::Null:
+      return compact;
+    case TypedValue::Type::Bool:
+      compact.SetPayload(Kind::Bool, value.ValueBool());
+      return compact;
+    case TypedValue::Type::Int:
+      compact.SetPayload(Kind::Int, value.ValueInt());
+      return compact;
+    case TypedValue::Type::Double:
+      compact.SetPayload(Kind::Double, value.ValueDouble());
+      return compact;
+    case TypedValue::Type::Date:
+      compact.SetPayload(Kind::Date, value.ValueDate().MicrosecondsSinceEpoch());
+      return compact;
+    case TypedValue::Type::LocalTime:
+      compact.SetPayload(Kind::LocalTime, value.ValueLocalTime().MicrosecondsSinceEpoch());
+      return compact;
+    case TypedValue::Type::LocalDateTime:
+      compact.SetPayload(Kind::LocalDateTime, value.ValueLocalDateTime().MicrosecondsSinceEpoch());
+      return compact;
+    case TypedValue::Type::Duration:
+      compact.SetPayload(Kind::Duration, value.ValueDuration().microseconds);
+      return compact;
+    case TypedValue::Type::String: {
+      const auto &string = value.ValueString();
+      if (string.size() > kMaxInlineStringSize) return std::nullopt;
+      compact.kind_ = Kind::InlineString;
+      compact.size_ = static_cast<uint8_t>(string.size());
+      std::memcpy(compact.data_, string.data(), string.size());
+      return compact;
+    }
+    case TypedValue::Type::List:
+    case TypedValue::Type::Map:
+    case TypedValue::Type::Vertex:
+    case TypedValue::Type::Edge:
+    case TypedValue::Type::Path:
+      return std::nullopt;
+  }
+}
+
+CompactValue CompactValue::Handle(const Kind kind, const uint64_t handle) {
+  MG_ASSERT(kind >= Kind::String, "Inline values don't have handles");
+  CompactValue compact;
+  compact.SetPayload(kind, handle);
+  return compact;
+}
+
+TypedValue CompactValue::ToTypedValue(utils::MemoryResource *memory) const {
+  switch (kind_) {
+    case Kind::Null:
+      return TypedValue(memory);
+    case Kind::Bool:
+      return TypedValue(Payload<bool>(), memory);
+    case Kind::Int:
+      return TypedValue(Payload<int64_t>(), memory);
+    case Kind::Double:
+      return TypedValue(Payload<double>(), memory);
+    case Kind::Date:
+      return TypedValue(utils::Date(Payload<int64_t>()), memory);
+    case Kind::LocalTime:
+      return TypedValue(utils::LocalTime(Payload<int64_t>()), memory);
+    case Kind::LocalDateTime:
+      return TypedValue(utils::LocalDateTime(Payload<int64_t>()), memory);
+    case Kind::Duration:
+      return TypedValue(utils::Duration(Payload<int64_t>()), memory);
+    case Kind::InlineString:
+      return TypedValue(std::string_view(data_, size_), memory);
+    case Kind::String:
+    case Kind::Vertex:
+    case Kind::Edge:
+    case Kind::Boxed:
+      LOG_FATAL("The value isn't stored inline");
+  }
+}
+
+CompactRows::CompactRows(utils::MemoryResource *memory)
+    : values_(memory),
+      string_handles_(memory),
+      strings_(memory),
+      vertex_handles_(memory),
+      vertices_(memory),
+      edge_handles_(memory),
+      edges_(memory),
+      boxed_(memory) {}
+
+void CompactRows::Append(const Frame &frame, const std::vector<Symbol> &symbols) {
+  if (row_count_ == 0) width_ = symbols.size();
+  MG_ASSERT(symbols.size() == width_, "All of the rows have to have the same number of slots");
+  values_.reserve(values_.size() + width_);
+  for (const auto &symbol : symbols) values_.push_back(Compact(frame[symbol]));
+  ++row_count_;
+}
+
+void CompactRows::Load(const size_t row, const std::vector<Symbol> &symbols, Frame *frame) const {
+  MG_ASSERT(row < row_count_ && symbols.size() == width_, "The row doesn't exist or has different slots");
+  const auto *value = values_.data() + row * width_;
+  for (const auto &symbol : symbols) {
+    auto &slot = (*frame)[symbol];
+    // The values are allocated with the memory of the slot, so the
+    // assignment doesn't have to copy them again.
+    slot = Expand(*value++, slot.GetMemoryResource());
+  }
+}
+
+void CompactRows::clear() {
+  width_ = 0;
+  row_count_ = 0;
+  values_.clear();
+  string_handles_.clear();
+  strings_.clear();
+  vertex_handles_.clear();
+  vertices_.clear();
+  edge_handles_.clear();
+  edges_.clear();
+  boxed_.clear();
+}
+
+CompactValue CompactRows::Compact(const TypedValue &value) {
+  if (auto compact = CompactValue::Inline(value)) return *compact;
+  switch (value.type()) {
+    case TypedValue::Type::String: {
+      const auto [it, inserted] = string_handles_.try_emplace(value.ValueString(), strings_.size());
+      if (inserted) strings_.push_back(&it->first);
+      return CompactValue::Handle(CompactValue::Kind::String, it->second);
+    }
+    case TypedValue::Type::Vertex: {
+      const auto [it, inserted] = vertex_handles_.try_emplace(value.ValueVertex(), vertices_.size());
+      if (inserted) vertices_.push_back(value.ValueVertex());
+      return CompactValue::Handle(CompactValue::Kind::Vertex, it->second);
+    }
+    case TypedValue::Type::Edge: {
+      const auto [it, inserted] = edge_handles_.try_emplace(value.ValueEdge(), edges_.size());
+      if (inserted) edges_.push_back(value.ValueEdge());
+      return CompactValue::Handle(CompactValue::Kind::Edge, it->second);
+    }
+    default:
+      boxed_.emplace_back(value);
+      return CompactValue::Handle(CompactValue::Kind::Boxed, boxed_.size() - 1);
+  }
+}
+
+TypedValue CompactRows::Expand(const CompactValue &value, utils::MemoryResource *memory) const {
+  switch (value.kind()) {
+    case CompactValue::Kind::String:
+      return TypedValue(*strings_[value.handle()], memory);
+    case CompactValue::Kind::Vertex:
+      return TypedValue(vertices_[value.handle()], memory);
+    case CompactValue::Kind::Edge:
+      return TypedValue(edges_[value.handle()], memory);
+    case CompactValue::Kind::Boxed:
+      return TypedValue(boxed_[value.handle()], memory);
+    default:
+      return value.ToTypedValue(memory);
+  }
+}
+
+}  // namespace query
@@ -0,0 +1,145 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+/// @file
+/// Compact representation of the frame slots which the operators keep for
+/// many rows, e.g. Accumulate and Cartesian.
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "query/db_accessor.hpp"
+#include "query/frontend/semantic/symbol_table.hpp"
+#include "query/interpret/frame.hpp"
+#include "query/typed_value.hpp"
+#include "utils/memory.hpp"
+#include "utils/pmr/unordered_map.hpp"
+#include "utils/pmr/vector.hpp"
+
+namespace query {
+
+/// Tagged 16 byte value of a frame slot. Scalars, temporal types and strings
+/// of up to kMaxInlineStringSize bytes are stored inline and don't need a
+/// memory resource. Longer strings, vertices and edges are handles into the
+/// tables of the CompactRows which holds the value, and the rest of the values
+/// are stored there as TypedValues.
+class CompactValue final {
+ public:
+  static constexpr size_t kMaxInlineStringSize = 14;
+
+  enum class Kind : uint8_t {
+    Null,
+    Bool,
+    Int,
+    Double,
+    Date,
+    LocalTime,
+    LocalDateTime,
+    Duration,
+    InlineString,
+    String,
+    Vertex,
+    Edge,
+    Boxed
+  };
+
+  CompactValue() = default;
+
+  /// Return the value if it can be stored inline, nullopt otherwise.
+  static std::optional<CompactValue> Inline(const TypedValue &value);
+
+  /// Return the value of the given kind which refers to the entry `handle` of
+  /// the table of its kind.
+  static CompactValue Handle(Kind kind, uint64_t handle);
+
+  Kind kind() const { return kind_; }
+
+  bool IsInline() const { return kind_ < Kind::String; }
+
+  /// Return the handle of the value which isn't stored inline.
+  uint64_t handle() const { return Payload<uint64_t>(); }
+
+  /// Return the inline value as a TypedValue allocated with `memory`.
+  TypedValue ToTypedValue(utils::MemoryResource *memory) const;
+
+ private:
+  template <class T>
+  T Payload() const;
+
+  template <class T>
+  void SetPayload(Kind kind, T value);
+
+  // The scalars and the handles are stored in the first 8 bytes and the
+  // inline strings in the first `size_` bytes.
+  alignas(uint64_t) char data_[kMaxInlineStringSize]{};
+  uint8_t size_{0};
+  Kind kind_{Kind::Null};
+};
+
+static_assert(sizeof(CompactValue) == 16, "CompactValue has to fit in 16 bytes");
+
+/// Rows of frame slots in the compact representation.
+///
+/// Each row takes 16 bytes per slot. The strings longer than
+/// CompactValue::kMaxInlineStringSize, e.g. the label and property names
+/// returned by `labels` and `keys`, the vertices and the edges are interned,
+/// so each of them is stored once no matter how many rows it appears in. The
+/// rest of the values are stored as they are. All of the memory is allocated
+/// with the memory resource of the rows.
+class CompactRows final {
+ public:
+  explicit CompactRows(utils::MemoryResource *memory);
+
+  /// Append the values of the frame slots of `symbols` as a new row. Each row
+  /// has to be appended with the same number of symbols.
+  /// @throw std::bad_alloc
+  void Append(const Frame &frame, const std::vector<Symbol> &symbols);
+
+  /// Write the values of the row to the frame slots of `symbols`, which have
+  /// to be the ones the row was appended with.
+  /// @throw std::bad_alloc
+  void Load(size_t row, const std::vector<Symbol> &symbols, Frame *frame) const;
+
+  size_t size() const { return row_count_; }
+  bool empty() const { return size() == 0; }
+
+  /// Remove all of the rows and the interned values.
+  void clear();
+
+  utils::MemoryResource *GetMemoryResource() const { return values_.get_allocator().GetMemoryResource(); }
+
+ private:
+  struct StringHash {
+    size_t operator()(const TypedValue::TString &value) const { return std::hash<std::string_view>{}(value); }
+  };
+
+  CompactValue Compact(const TypedValue &value);
+  TypedValue Expand(const CompactValue &value, utils::MemoryResource *memory) const;
+
+  size_t width_{0};
+  size_t row_count_{0};
+  utils::pmr::vector<CompactValue> values_;
+  // The strings are the keys of the map, whose nodes don't move, and the
+  // handle of a string is its index in `strings_`.
+  utils::pmr::unordered_map<TypedValue::TString, uint64_t, StringHash> string_handles_;
+  utils::pmr::vector<const TypedValue::TString *> strings_;
+  utils::pmr::unordered_map<VertexAccessor, uint64_t> vertex_handles_;
+  utils::pmr::vector<VertexAccessor> vertices_;
+  utils::pmr::unordered_map<EdgeAccessor, uint64_t> edge_handles_;
+  utils::pmr::vector<EdgeAccessor> edges_;
+  utils::pmr::vector<TypedValue> boxed_;
+};
+
+}  // namespace query
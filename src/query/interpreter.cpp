@@ -15,10 +15,14 @@
 #include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <mutex>
 #include <optional>
 
 #include "glue/communication.hpp"
@@ -41,6 +45,7 @@
 #include "query/plan/profile.hpp"
 #include "query/plan/vertex_count_cache.hpp"
 #include "query/stream/common.hpp"
+#include "query/stream/sources.hpp"
 #include "query/trigger.hpp"
 #include "query/typed_value.hpp"
 #include "storage/v2/property_value.hpp"
@@ -48,12 +53,14 @@
 #include "utils/csv_parsing.hpp"
 #include "utils/event_counter.hpp"
 #include "utils/exceptions.hpp"
+#include "utils/file.hpp"
 #include "utils/flag_validation.hpp"
 #include "utils/license.hpp"
 #include "utils/likely.hpp"
 #include "utils/logging.hpp"
 #include "utils/memory.hpp"
 #include "utils/memory_tracker.hpp"
+#include "utils/read_ahead.hpp"
 #include "utils/readable_size.hpp"
 #include "utils/settings.hpp"
 #include "utils/string.hpp"
@@ -70,6 +77,8 @@ extern const Event LabelPropertyIndexCreated;
 
 extern const Event StreamsCreated;
 extern const Event TriggersCreated;
+
+extern const Event PlanCardinalityDrift;
 }  // namespace EventCounter
 
 namespace query {
@@ -563,6 +572,12 @@ Callback::CallbackFunction GetKafkaCreateCallback(StreamQuery *stream_query, Exp
     throw SemanticException("Bootstrap servers must not be an empty string!");
   }
   auto common_stream_info = GetCommonStreamInfo(stream_query, evaluator);
+  const auto parallelism =
+      GetOptionalValue<int64_t>(stream_query->parallelism_, evaluator).value_or(stream::kDefaultParallelism);
+  if (const auto max_parallelism = stream::KafkaStream::MaxParallelism();
+      parallelism < 1 || parallelism > max_parallelism) {
+    throw SemanticException("Parallelism must be between 1 and {}, the number of hardware threads!", max_parallelism);
+  }
 
   const auto get_config_map = [&evaluator](std::unordered_map<Expression *, Expression *> map,
                                            std::string_view map_name) -> std::unordered_map<std::string, std::string> {
@@ -583,7 +598,7 @@ Callback::CallbackFunction GetKafkaCreateCallback(StreamQuery *stream_query, Exp
           consumer_group = std::move(consumer_group), common_stream_info = std::move(common_stream_info),
           bootstrap_servers = std::move(bootstrap), owner = StringPointerToOptional(username),
           configs = get_config_map(stream_query->configs_, "Configs"),
-          credentials = get_config_map(stream_query->credentials_, "Credentials")]() mutable {
+          credentials = get_config_map(stream_query->credentials_, "Credentials"), parallelism]() mutable {
     std::string bootstrap = bootstrap_servers
                                 ? std::move(*bootstrap_servers)
                                 : std::string{interpreter_context->config.default_kafka_bootstrap_servers};
@@ -593,7 +608,8 @@ Callback::CallbackFunction GetKafkaCreateCallback(StreamQuery *stream_query, Exp
                                                                      .consumer_group = std::move(consumer_group),
                                                                      .bootstrap_servers = std::move(bootstrap),
                                                                      .configs = std::move(configs),
-                                                                     .credentials = std::move(credentials)},
+                                                                     .credentials = std::move(credentials),
+                                                                     .parallelism = parallelism},
                                                                     std::move(owner));
 
     return std::vector<std::vector<TypedValue>>{};
@@ -842,6 +858,49 @@ struct PullPlanVector {
   std::vector<std::vector<TypedValue>> values_;
 };
 
+// Temporary memory for a single Pull. Initial memory comes from the stack. 256
+// KiB should fit on the stack and should be more than enough for a single
+// `Pull`.
+class PullMemory final {
+ public:
+  PullMemory(std::optional<size_t> memory_limit, utils::TrackingMemoryResource *memory_tracker)
+      : monotonic_memory_(&stack_data_[0], kStackSize, &resource_with_exception_),
+        // TODO (mferencevic): Tune the parameters accordingly.
+        pool_memory_(128, 1024, &monotonic_memory_),
+        limited_memory_(MakeLimited(memory_limit, &pool_memory_)),
+        tracking_memory_(
+            limited_memory_ ? static_cast<utils::MemoryResource *>(&*limited_memory_) : &pool_memory_,
+            memory_tracker) {}
+
+  PullMemory(const PullMemory &) = delete;
+  PullMemory &operator=(const PullMemory &) = delete;
+  PullMemory(PullMemory &&) = delete;
+  PullMemory &operator=(PullMemory &&) = delete;
+  ~PullMemory() = default;
+
+  utils::MemoryResource *get() { return &tracking_memory_; }
+
+ private:
+  static constexpr size_t kStackSize = 256 * 1024;
+
+  static std::optional<utils::LimitedMemoryResource> MakeLimited(std::optional<size_t> memory_limit,
+                                                                 utils::MemoryResource *memory) {
+    if (!memory_limit) return std::nullopt;
+    return std::optional<utils::LimitedMemoryResource>(std::in_place, memory, *memory_limit);
+  }
+
+  char stack_data_[kStackSize];
+  // We can throw on every query because a simple queries for deleting will use
+  // only the stack allocated buffer. Also, we want to throw only when the query
+  // engine requests more memory and not the storage so we add the exception to
+  // the allocator.
+  utils::ResourceWithOutOfMemoryException resource_with_exception_;
+  utils::MonotonicBufferResource monotonic_memory_;
+  utils::PoolResource pool_memory_;
+  std::optional<utils::LimitedMemoryResource> limited_memory_;
+  utils::TrackingMemoryResource tracking_memory_;
+};
+
 struct PullPlan {
   explicit PullPlan(std::shared_ptr<CachedPlan> plan, const Parameters &parameters, bool is_profile_query,
                     DbAccessor *dba, InterpreterContext *interpreter_context, utils::MemoryResource *execution_memory,
@@ -851,12 +910,36 @@ struct PullPlan {
                                                         const std::vector<Symbol> &output_symbols,
                                                         std::map<std::string, TypedValue> *summary);
 
+  /// Makes the following pulls produce the rows on the given thread pool,
+  /// ahead of their streaming. At most `max_rows` rows are buffered. The
+  /// cursor is pulled while the rows are being streamed, which is only safe for
+  /// queries that don't modify the graph.
+  void EnableReadAhead(const std::vector<Symbol> &output_symbols, uint64_t max_rows, utils::ThreadPool *pool);
+
+  /// Compares the cardinalities of the scans observed so far with the ones
+  /// estimated for the cached plan. If they are too far off, the plan is
+  /// expired and a notification about it is returned.
+  std::optional<Notification> CheckCardinalities();
+
  private:
+  // Pulls a single row from the cursor with the memory of the read-ahead, and
+  // returns the values of the output symbols.
+  std::optional<std::vector<TypedValue>> PullRow(const std::vector<Symbol> &output_symbols);
+  std::optional<plan::ProfilingStatsWithTotalTime> PullReadAhead(AnyStream *stream, std::optional<int> n,
+                                                                 std::map<std::string, TypedValue> *summary);
+  // Fills in the summary after all of the rows were pulled.
+  std::optional<plan::ProfilingStatsWithTotalTime> Finish(std::map<std::string, TypedValue> *summary);
+
   std::shared_ptr<CachedPlan> plan_ = nullptr;
+  // Tracks the memory of the cursors and the frame, and through the per Pull
+  // trackers also the memory of each Pull.
+  utils::TrackingMemoryResource memory_tracker_;
   plan::UniqueCursorPtr cursor_ = nullptr;
   Frame frame_;
   ExecutionContext ctx_;
   std::optional<size_t> memory_limit_;
+  std::optional<plan::CardinalityFeedback> cardinality_feedback_;
+  double replan_cardinality_factor_;
 
   // As it's possible to query execution using multiple pulls
   // we need the keep track of the total execution time across
@@ -870,15 +953,28 @@ struct PullPlan {
   // we have to keep track of any unsent results from previous `PullPlan::Pull`
   // manually by using this flag.
   bool has_unsent_results_ = false;
+
+  // Temporary memory of the rows produced ahead. It's replaced after every
+  // `read_ahead_batch_rows_` rows, so the memory limit applies to each batch
+  // like to a single `Pull` of that many rows.
+  std::unique_ptr<PullMemory> read_ahead_memory_;
+  uint64_t read_ahead_batch_rows_{0};
+  // Number of the rows pulled with the current `read_ahead_memory_`.
+  uint64_t read_ahead_memory_rows_{0};
+  // Declared last, so the rows stop being produced before the rest of the
+  // members are destroyed.
+  std::optional<utils::ReadAhead<std::vector<TypedValue>>> read_ahead_;
 };
 
 PullPlan::PullPlan(const std::shared_ptr<CachedPlan> plan, const Parameters &parameters, const bool is_profile_query,
                    DbAccessor *dba, InterpreterContext *interpreter_context, utils::MemoryResource *execution_memory,
                    TriggerContextCollector *trigger_context_collector, const std::optional<size_t> memory_limit)
     : plan_(plan),
-      cursor_(plan->plan().MakeCursor(execution_memory)),
-      frame_(plan->symbol_table().max_position(), execution_memory),
-      memory_limit_(memory_limit) {
+      memory_tracker_(execution_memory),
+      cursor_(plan->plan().MakeCursor(&memory_tracker_)),
+      frame_(plan->symbol_table().max_position(), &memory_tracker_),
+      memory_limit_(memory_limit),
+      replan_cardinality_factor_(interpreter_context->config.query.replan_cardinality_factor) {
   ctx_.db_accessor = dba;
   ctx_.symbol_table = plan->symbol_table();
   ctx_.evaluation_context.timestamp = QueryTimestamp();
@@ -891,33 +987,100 @@ PullPlan::PullPlan(const std::shared_ptr<CachedPlan> plan, const Parameters &par
   ctx_.is_shutting_down = &interpreter_context->is_shutting_down;
   ctx_.is_profile_query = is_profile_query;
   ctx_.trigger_context_collector = trigger_context_collector;
+  ctx_.memory_tracker = &memory_tracker_;
+  ctx_.procedure_pool = &interpreter_context->procedure_pool;
+  ctx_.spill.directory = interpreter_context->spill_directory;
+  // The state of the operators doesn't count towards the memory limit, which
+  // only bounds the memory of a single Pull, so the limit is used as the
+  // threshold for spilling instead.
+  if (const auto config_threshold = interpreter_context->config.query.spill_threshold_bytes; config_threshold > 0) {
+    ctx_.spill.threshold = memory_limit ? std::min<size_t>(*memory_limit, config_threshold) : config_threshold;
+  } else {
+    ctx_.spill.threshold = memory_limit;
+  }
+  // Only the cached plans have the estimates.
+  if (replan_cardinality_factor_ > 0 && !plan->scan_estimates().empty()) {
+    cardinality_feedback_.emplace(plan->scan_estimates());
+    ctx_.cardinality_feedback = &*cardinality_feedback_;
+  }
+}
+
+std::optional<Notification> PullPlan::CheckCardinalities() {
+  if (!cardinality_feedback_) return std::nullopt;
+  const auto drift = cardinality_feedback_->FindDrift(replan_cardinality_factor_);
+  if (!drift) return std::nullopt;
+  plan_->MarkStale();
+  EventCounter::IncrementCounter(EventCounter::PlanCardinalityDrift);
+  auto description = fmt::format(
+      "{} was estimated to produce {:.1f} vertices per input row, but it produced {:.1f}. The query will be planned "
+      "again the next time it's run.",
+      drift->op->GetTypeInfo().name, drift->estimated, drift->observed);
+  spdlog::info("The cached plan doesn't fit the data anymore. {}", description);
+  return Notification(SeverityLevel::INFO, NotificationCode::PLAN_INVALIDATED,
+                      "The cached plan doesn't fit the data anymore.", std::move(description));
+}
+
+void PullPlan::EnableReadAhead(const std::vector<Symbol> &output_symbols, const uint64_t max_rows,
+                               utils::ThreadPool *pool) {
+  read_ahead_memory_ = std::make_unique<PullMemory>(memory_limit_, &memory_tracker_);
+  read_ahead_batch_rows_ = max_rows;
+  read_ahead_memory_rows_ = 0;
+  read_ahead_.emplace([this, output_symbols] { return PullRow(output_symbols); }, max_rows, pool);
+}
+
+std::optional<std::vector<TypedValue>> PullPlan::PullRow(const std::vector<Symbol> &output_symbols) {
+  // The rows aren't produced concurrently, so they can share the memory. The
+  // returned values are copied out of it, so the memory can be freed once the
+  // batch is pulled, like at the end of a `Pull`.
+  if (read_ahead_memory_rows_ == read_ahead_batch_rows_) {
+    read_ahead_memory_.reset();
+    read_ahead_memory_ = std::make_unique<PullMemory>(memory_limit_, &memory_tracker_);
+    read_ahead_memory_rows_ = 0;
+  }
+  ++read_ahead_memory_rows_;
+  ctx_.evaluation_context.memory = read_ahead_memory_->get();
+  utils::Timer timer;
+  const bool pulled = cursor_->Pull(frame_, ctx_);
+  execution_time_ += timer.Elapsed();
+  if (!pulled) return std::nullopt;
+  std::vector<TypedValue> values;
+  values.reserve(output_symbols.size());
+  for (const auto &symbol : output_symbols) {
+    values.emplace_back(frame_[symbol]);
+  }
+  return values;
+}
+
+std::optional<plan::ProfilingStatsWithTotalTime> PullPlan::PullReadAhead(AnyStream *stream, std::optional<int> n,
+                                                                         std::map<std::string, TypedValue> *summary) {
+  // The rows are pulled from the cursor in the background while they are
+  // streamed, so the execution time is measured by `PullRow`.
+  int i = 0;
+  for (; !n || i < n; ++i) {
+    auto values = read_ahead_->Pop();
+    if (!values) break;
+    stream->Result(*values);
+  }
+  if (i == n && read_ahead_->HasMore()) {
+    return std::nullopt;
+  }
+  // Nothing is pulled in the background anymore, so the execution context can
+  // be used again.
+  read_ahead_.reset();
+  read_ahead_memory_.reset();
+  return Finish(summary);
 }
 
 std::optional<plan::ProfilingStatsWithTotalTime> PullPlan::Pull(AnyStream *stream, std::optional<int> n,
                                                                 const std::vector<Symbol> &output_symbols,
                                                                 std::map<std::string, TypedValue> *summary) {
-  // Set up temporary memory for a single Pull. Initial memory comes from the
-  // stack. 256 KiB should fit on the stack and should be more than enough for a
-  // single `Pull`.
-  constexpr size_t stack_size = 256 * 1024;
-  char stack_data[stack_size];
-  utils::ResourceWithOutOfMemoryException resource_with_exception;
-  utils::MonotonicBufferResource monotonic_memory(&stack_data[0], stack_size, &resource_with_exception);
-  // We can throw on every query because a simple queries for deleting will use only
-  // the stack allocated buffer.
-  // Also, we want to throw only when the query engine requests more memory and not the storage
-  // so we add the exception to the allocator.
-  // TODO (mferencevic): Tune the parameters accordingly.
-  utils::PoolResource pool_memory(128, 1024, &monotonic_memory);
-  std::optional<utils::LimitedMemoryResource> maybe_limited_resource;
-
-  if (memory_limit_) {
-    maybe_limited_resource.emplace(&pool_memory, *memory_limit_);
-    ctx_.evaluation_context.memory = &*maybe_limited_resource;
-  } else {
-    ctx_.evaluation_context.memory = &pool_memory;
+  if (read_ahead_) {
+    return PullReadAhead(stream, n, summary);
   }
 
+  PullMemory pull_memory(memory_limit_, &memory_tracker_);
+  ctx_.evaluation_context.memory = pull_memory.get();
+
   // Returns true if a result was pulled.
   const auto pull_result = [&]() -> bool { return cursor_->Pull(frame_, ctx_); };
 
@@ -964,7 +1127,12 @@ std::optional<plan::ProfilingStatsWithTotalTime> PullPlan::Pull(AnyStream *strea
   if (has_unsent_results_) {
     return std::nullopt;
   }
+  return Finish(summary);
+}
+
+std::optional<plan::ProfilingStatsWithTotalTime> PullPlan::Finish(std::map<std::string, TypedValue> *summary) {
   summary->insert_or_assign("plan_execution_time", execution_time_.count());
+  summary->insert_or_assign("peak_memory_usage", static_cast<int64_t>(memory_tracker_.GetPeakAllocatedBytes()));
   // We are finished with pulling all the data, therefore we can send any
   // metadata about the results i.e. notifications and statistics
   const bool is_any_counter_set =
@@ -987,12 +1155,42 @@ using RWType = plan::ReadWriteTypeChecker::RWType;
 
 InterpreterContext::InterpreterContext(storage::Storage *db, const InterpreterConfig config,
                                        const std::filesystem::path &data_directory)
-    : db(db), trigger_store(data_directory / "triggers"), config(config), streams{this, data_directory / "streams"} {}
+    : db(db),
+      stripped_query_cache(config.query.stripped_query_cache_max_memory_bytes),
+      ast_cache(config.query.ast_cache_max_memory_bytes),
+      plan_cache(config.query.plan_cache_max_memory_bytes),
+      trigger_store(data_directory / "triggers"),
+      after_commit_trigger_workers(std::max<uint64_t>(config.query.after_commit_trigger_threads, 1) - 1),
+      read_ahead_pool(config.query.read_ahead_rows > 0 ? config.query.read_ahead_threads : 0),
+      procedure_pool(config.query.procedure_threads),
+      change_feed(db, &procedure::gModuleRegistry, &is_shutting_down, &procedure_pool),
+      spill_directory(data_directory / "spill"),
+      config(config),
+      streams{this, data_directory / "streams"} {
+  // Temporary files are left behind only if the previous run crashed.
+  utils::DeleteDir(spill_directory);
+}
 
 Interpreter::Interpreter(InterpreterContext *interpreter_context) : interpreter_context_(interpreter_context) {
   MG_ASSERT(interpreter_context_, "Interpreter context must not be NULL");
 }
 
+namespace {
+// Return the events which the transactions have to collect for the triggers
+// and the change hooks, or nullopt if nothing has to be collected.
+std::optional<std::unordered_set<TriggerEventType>> CollectedEventTypes(const InterpreterContext &interpreter_context) {
+  std::optional<std::unordered_set<TriggerEventType>> event_types;
+  if (interpreter_context.trigger_store.HasTriggers()) {
+    event_types.emplace(interpreter_context.trigger_store.GetEventTypes());
+  }
+  if (interpreter_context.change_feed.HasHooks()) {
+    if (!event_types) event_types.emplace();
+    event_types->merge(procedure::ChangeHookEventTypes());
+  }
+  return event_types;
+}
+}  // namespace
+
 PreparedQuery Interpreter::PrepareTransactionQuery(std::string_view query_upper) {
   std::function<void()> handler;
 
@@ -1008,8 +1206,9 @@ PreparedQuery Interpreter::PrepareTransactionQuery(std::string_view query_upper)
           std::make_unique<storage::Storage::Accessor>(interpreter_context_->db->Access(GetIsolationLevelOverride()));
       execution_db_accessor_.emplace(db_accessor_.get());
 
-      if (interpreter_context_->trigger_store.HasTriggers()) {
-        trigger_context_collector_.emplace(interpreter_context_->trigger_store.GetEventTypes());
+      collects_graph_changes_ = interpreter_context_->change_feed.HasHooks();
+      if (auto event_types = CollectedEventTypes(*interpreter_context_)) {
+        trigger_context_collector_.emplace(*event_types);
       }
     };
   } else if (query_upper == "COMMIT") {
@@ -1058,6 +1257,7 @@ PreparedQuery Interpreter::PrepareTransactionQuery(std::string_view query_upper)
 PreparedQuery PrepareCypherQuery(ParsedQuery parsed_query, std::map<std::string, TypedValue> *summary,
                                  InterpreterContext *interpreter_context, DbAccessor *dba,
                                  utils::MemoryResource *execution_memory, std::vector<Notification> *notifications,
+                                 bool in_explicit_transaction,
                                  TriggerContextCollector *trigger_context_collector = nullptr) {
   auto *cypher_query = utils::Downcast<CypherQuery>(parsed_query.query);
 
@@ -1081,7 +1281,7 @@ PreparedQuery PrepareCypherQuery(ParsedQuery parsed_query, std::map<std::string,
         "conversion functions such as ToInteger, ToFloat, ToBoolean etc.");
   }
 
-  auto plan = CypherQueryToPlan(parsed_query.stripped_query.hash(), std::move(parsed_query.ast_storage), cypher_query,
+  auto plan = CypherQueryToPlan(parsed_query.stripped_query->hash(), std::move(parsed_query.ast_storage), cypher_query,
                                 parsed_query.parameters,
                                 parsed_query.is_cacheable ? &interpreter_context->plan_cache : nullptr, dba);
 
@@ -1099,14 +1299,24 @@ PreparedQuery PrepareCypherQuery(ParsedQuery parsed_query, std::map<std::string,
     // WITH), then there is no token position, so use symbol name.
     // Otherwise, find the name from stripped query.
     header.push_back(
-        utils::FindOr(parsed_query.stripped_query.named_expressions(), symbol.token_position(), symbol.name()).first);
+        utils::FindOr(parsed_query.stripped_query->named_expressions(), symbol.token_position(), symbol.name()).first);
   }
   auto pull_plan = std::make_shared<PullPlan>(plan, parsed_query.parameters, false, dba, interpreter_context,
                                               execution_memory, trigger_context_collector, memory_limit);
+  // The rows can be produced ahead only when nothing else runs in the
+  // transaction while they are streamed, and nothing modifies the graph.
+  if (const auto read_ahead_rows = interpreter_context->config.query.read_ahead_rows;
+      read_ahead_rows > 0 && !in_explicit_transaction && rw_type_checker.type == RWType::R &&
+      !output_symbols.empty()) {
+    pull_plan->EnableReadAhead(output_symbols, read_ahead_rows, &interpreter_context->read_ahead_pool);
+  }
   return PreparedQuery{std::move(header), std::move(parsed_query.required_privileges),
-                       [pull_plan = std::move(pull_plan), output_symbols = std::move(output_symbols), summary](
-                           AnyStream *stream, std::optional<int> n) -> std::optional<QueryHandlerResult> {
+                       [pull_plan = std::move(pull_plan), output_symbols = std::move(output_symbols), summary,
+                        notifications](AnyStream *stream, std::optional<int> n) -> std::optional<QueryHandlerResult> {
                          if (pull_plan->Pull(stream, n, output_symbols, summary)) {
+                           if (auto notification = pull_plan->CheckCardinalities()) {
+                             notifications->push_back(std::move(*notification));
+                           }
                            return QueryHandlerResult::COMMIT;
                          }
                          return std::nullopt;
@@ -1118,7 +1328,7 @@ PreparedQuery PrepareExplainQuery(ParsedQuery parsed_query, std::map<std::string
                                   InterpreterContext *interpreter_context, DbAccessor *dba,
                                   utils::MemoryResource *execution_memory) {
   const std::string kExplainQueryStart = "explain ";
-  MG_ASSERT(utils::StartsWith(utils::ToLowerCase(parsed_query.stripped_query.query()), kExplainQueryStart),
+  MG_ASSERT(utils::StartsWith(utils::ToLowerCase(parsed_query.stripped_query->query()), kExplainQueryStart),
             "Expected stripped query to start with '{}'", kExplainQueryStart);
 
   // Parse and cache the inner query separately (as if it was a standalone
@@ -1129,13 +1339,14 @@ PreparedQuery PrepareExplainQuery(ParsedQuery parsed_query, std::map<std::string
   // full query string) when given just the inner query to execute.
   ParsedQuery parsed_inner_query =
       ParseQuery(parsed_query.query_string.substr(kExplainQueryStart.size()), parsed_query.user_parameters,
-                 &interpreter_context->ast_cache, &interpreter_context->antlr_lock, interpreter_context->config.query);
+                 &interpreter_context->ast_cache, interpreter_context->config.query,
+                 &interpreter_context->stripped_query_cache);
 
   auto *cypher_query = utils::Downcast<CypherQuery>(parsed_inner_query.query);
   MG_ASSERT(cypher_query, "Cypher grammar should not allow other queries in EXPLAIN");
 
   auto cypher_query_plan = CypherQueryToPlan(
-      parsed_inner_query.stripped_query.hash(), std::move(parsed_inner_query.ast_storage), cypher_query,
+      parsed_inner_query.stripped_query->hash(), std::move(parsed_inner_query.ast_storage), cypher_query,
       parsed_inner_query.parameters, parsed_inner_query.is_cacheable ? &interpreter_context->plan_cache : nullptr, dba);
 
   std::stringstream printed_plan;
@@ -1165,7 +1376,7 @@ PreparedQuery PrepareProfileQuery(ParsedQuery parsed_query, bool in_explicit_tra
                                   DbAccessor *dba, utils::MemoryResource *execution_memory) {
   const std::string kProfileQueryStart = "profile ";
 
-  MG_ASSERT(utils::StartsWith(utils::ToLowerCase(parsed_query.stripped_query.query()), kProfileQueryStart),
+  MG_ASSERT(utils::StartsWith(utils::ToLowerCase(parsed_query.stripped_query->query()), kProfileQueryStart),
             "Expected stripped query to start with '{}'", kProfileQueryStart);
 
   // PROFILE isn't allowed inside multi-command (explicit) transactions. This is
@@ -1196,7 +1407,8 @@ PreparedQuery PrepareProfileQuery(ParsedQuery parsed_query, bool in_explicit_tra
   // full query string) when given just the inner query to execute.
   ParsedQuery parsed_inner_query =
       ParseQuery(parsed_query.query_string.substr(kProfileQueryStart.size()), parsed_query.user_parameters,
-                 &interpreter_context->ast_cache, &interpreter_context->antlr_lock, interpreter_context->config.query);
+                 &interpreter_context->ast_cache, interpreter_context->config.query,
+                 &interpreter_context->stripped_query_cache);
 
   auto *cypher_query = utils::Downcast<CypherQuery>(parsed_inner_query.query);
   MG_ASSERT(cypher_query, "Cypher grammar should not allow other queries in PROFILE");
@@ -1209,12 +1421,12 @@ PreparedQuery PrepareProfileQuery(ParsedQuery parsed_query, bool in_explicit_tra
   const auto memory_limit = EvaluateMemoryLimit(&evaluator, cypher_query->memory_limit_, cypher_query->memory_scale_);
 
   auto cypher_query_plan = CypherQueryToPlan(
-      parsed_inner_query.stripped_query.hash(), std::move(parsed_inner_query.ast_storage), cypher_query,
+      parsed_inner_query.stripped_query->hash(), std::move(parsed_inner_query.ast_storage), cypher_query,
       parsed_inner_query.parameters, parsed_inner_query.is_cacheable ? &interpreter_context->plan_cache : nullptr, dba);
   auto rw_type_checker = plan::ReadWriteTypeChecker();
   rw_type_checker.InferRWType(const_cast<plan::LogicalOperator &>(cypher_query_plan->plan()));
 
-  return PreparedQuery{{"OPERATOR", "ACTUAL HITS", "RELATIVE TIME", "ABSOLUTE TIME"},
+  return PreparedQuery{{"OPERATOR", "ACTUAL HITS", "RELATIVE TIME", "ABSOLUTE TIME", "ALLOCATED MEMORY"},
                        std::move(parsed_query.required_privileges),
                        [plan = std::move(cypher_query_plan), parameters = std::move(parsed_inner_query.parameters),
                         summary, dba, interpreter_context, execution_memory, memory_limit,
@@ -1257,6 +1469,13 @@ PreparedQuery PrepareDumpQuery(ParsedQuery parsed_query, std::map<std::string, T
                        RWType::R};
 }
 
+// Indices, constraints and graph statistics influence the chosen plans, so the
+// plans made before they changed are dropped.
+void InvalidatePlans(InterpreterContext *interpreter_context) {
+  interpreter_context->plan_cache.Clear();
+  interpreter_context->trigger_store.InvalidatePlans();
+}
+
 PreparedQuery PrepareIndexQuery(ParsedQuery parsed_query, bool in_explicit_transaction,
                                 std::vector<Notification> *notifications, InterpreterContext *interpreter_context) {
   if (in_explicit_transaction) {
@@ -1266,14 +1485,6 @@ PreparedQuery PrepareIndexQuery(ParsedQuery parsed_query, bool in_explicit_trans
   auto *index_query = utils::Downcast<IndexQuery>(parsed_query.query);
   std::function<void(Notification &)> handler;
 
-  // Creating an index influences computed plan costs.
-  auto invalidate_plan_cache = [plan_cache = &interpreter_context->plan_cache] {
-    auto access = plan_cache->access();
-    for (auto &kv : access) {
-      access.remove(kv.first);
-    }
-  };
-
   auto label = interpreter_context->db->NameToLabel(index_query->label_.name);
 
   std::vector<storage::PropertyId> properties;
@@ -1298,8 +1509,8 @@ PreparedQuery PrepareIndexQuery(ParsedQuery parsed_query, bool in_explicit_trans
           fmt::format("Created index on label {} on properties {}.", index_query->label_.name, properties_stringified);
 
       handler = [interpreter_context, label, properties_stringified = std::move(properties_stringified),
-                 label_name = index_query->label_.name, properties = std::move(properties),
-                 invalidate_plan_cache = std::move(invalidate_plan_cache)](Notification &index_notification) {
+                 label_name = index_query->label_.name,
+                 properties = std::move(properties)](Notification &index_notification) {
         if (properties.empty()) {
           if (!interpreter_context->db->CreateIndex(label)) {
             index_notification.code = NotificationCode::EXISTANT_INDEX;
@@ -1316,7 +1527,7 @@ PreparedQuery PrepareIndexQuery(ParsedQuery parsed_query, bool in_explicit_trans
           }
           EventCounter::IncrementCounter(EventCounter::LabelPropertyIndexCreated);
         }
-        invalidate_plan_cache();
+        InvalidatePlans(interpreter_context);
       };
       break;
     }
@@ -1325,8 +1536,8 @@ PreparedQuery PrepareIndexQuery(ParsedQuery parsed_query, bool in_explicit_trans
       index_notification.title = fmt::format("Dropped index on label {} on properties {}.", index_query->label_.name,
                                              utils::Join(properties_string, ", "));
       handler = [interpreter_context, label, properties_stringified = std::move(properties_stringified),
-                 label_name = index_query->label_.name, properties = std::move(properties),
-                 invalidate_plan_cache = std::move(invalidate_plan_cache)](Notification &index_notification) {
+                 label_name = index_query->label_.name,
+                 properties = std::move(properties)](Notification &index_notification) {
         if (properties.empty()) {
           if (!interpreter_context->db->DropIndex(label)) {
             index_notification.code = NotificationCode::NONEXISTANT_INDEX;
@@ -1341,7 +1552,7 @@ PreparedQuery PrepareIndexQuery(ParsedQuery parsed_query, bool in_explicit_trans
                 fmt::format("Index on label {} on properties {} doesn't exist.", label_name, properties_stringified);
           }
         }
-        invalidate_plan_cache();
+        InvalidatePlans(interpreter_context);
       };
       break;
     }
@@ -1514,8 +1725,7 @@ Callback CreateTrigger(TriggerQuery *trigger_query,
         interpreter_context->trigger_store.AddTrigger(
             std::move(trigger_name), trigger_statement, user_parameters, ToTriggerEventType(event_type),
             before_commit ? TriggerPhase::BEFORE_COMMIT : TriggerPhase::AFTER_COMMIT, &interpreter_context->ast_cache,
-            dba, &interpreter_context->antlr_lock, interpreter_context->config.query, std::move(owner),
-            interpreter_context->auth_checker);
+            dba, interpreter_context->config.query, std::move(owner), interpreter_context->auth_checker);
         return {};
       }};
 }
@@ -1743,6 +1953,60 @@ PreparedQuery PrepareVersionQuery(ParsedQuery parsed_query, const bool in_explic
                        RWType::NONE};
 }
 
+PreparedQuery PrepareAnalyzeGraphQuery(ParsedQuery parsed_query, const bool in_explicit_transaction,
+                                       InterpreterContext *interpreter_context) {
+  if (in_explicit_transaction) {
+    throw AnalyzeGraphInMulticommandTxException();
+  }
+
+  auto handler = [interpreter_context] {
+    auto *db = interpreter_context->db;
+    auto statistics = db->AnalyzeGraph();
+    // Cached plans were chosen without the new statistics.
+    InvalidatePlans(interpreter_context);
+
+    std::vector<std::vector<TypedValue>> results;
+    results.push_back({TypedValue("graph"), TypedValue(), TypedValue(static_cast<int64_t>(statistics->vertex_count)),
+                       TypedValue(),
+                       TypedValue(statistics->vertex_count ? static_cast<double>(statistics->edge_count) /
+                                                                 static_cast<double>(statistics->vertex_count)
+                                                           : 0.0)});
+    for (const auto &[label, count] : statistics->label_count) {
+      results.push_back({TypedValue("label"), TypedValue(":" + db->LabelToName(label)),
+                         TypedValue(static_cast<int64_t>(count)), TypedValue(), TypedValue()});
+    }
+    for (const auto &[label_property, property_statistics] : statistics->label_property) {
+      results.push_back(
+          {TypedValue("label+property"),
+           TypedValue(fmt::format(":{}({})", db->LabelToName(label_property.first),
+                                  db->PropertyToName(label_property.second))),
+           TypedValue(static_cast<int64_t>(property_statistics.count)),
+           TypedValue(static_cast<int64_t>(property_statistics.distinct_values_count)), TypedValue()});
+    }
+    for (const auto &[edge_type, edge_type_statistics] : statistics->edge_type) {
+      results.push_back({TypedValue("edge type"), TypedValue(":" + db->EdgeTypeToName(edge_type)),
+                         TypedValue(static_cast<int64_t>(edge_type_statistics.count)), TypedValue(),
+                         TypedValue(edge_type_statistics.AverageOutDegree())});
+    }
+    return results;
+  };
+
+  return PreparedQuery{{"type", "name", "count", "distinct values", "average degree"},
+                       std::move(parsed_query.required_privileges),
+                       [handler = std::move(handler), pull_plan = std::shared_ptr<PullPlanVector>(nullptr)](
+                           AnyStream *stream, std::optional<int> n) mutable -> std::optional<QueryHandlerResult> {
+                         if (!pull_plan) {
+                           pull_plan = std::make_shared<PullPlanVector>(handler());
+                         }
+
+                         if (pull_plan->Pull(stream, n)) {
+                           return QueryHandlerResult::NOTHING;
+                         }
+                         return std::nullopt;
+                       },
+                       RWType::NONE};
+}
+
 PreparedQuery PrepareInfoQuery(ParsedQuery parsed_query, bool in_explicit_transaction,
                                std::map<std::string, TypedValue> *summary, InterpreterContext *interpreter_context,
                                storage::Storage *db, utils::MemoryResource *execution_memory) {
@@ -2007,8 +2271,9 @@ PreparedQuery PrepareConstraintQuery(ParsedQuery parsed_query, bool in_explicit_
   return PreparedQuery{{},
                        std::move(parsed_query.required_privileges),
                        [handler = std::move(handler), constraint_notification = std::move(constraint_notification),
-                        notifications](AnyStream * /*stream*/, std::optional<int> /*n*/) mutable {
+                        notifications, interpreter_context](AnyStream * /*stream*/, std::optional<int> /*n*/) mutable {
                          handler(constraint_notification);
+                         InvalidatePlans(interpreter_context);
                          notifications->push_back(constraint_notification);
                          return QueryHandlerResult::COMMIT;
                        },
@@ -2071,8 +2336,9 @@ Interpreter::PrepareResult Interpreter::Prepare(const std::string &query_string,
     query_execution->summary["cost_estimate"] = 0.0;
 
     utils::Timer parsing_timer;
-    ParsedQuery parsed_query = ParseQuery(query_string, params, &interpreter_context_->ast_cache,
-                                          &interpreter_context_->antlr_lock, interpreter_context_->config.query);
+    ParsedQuery parsed_query =
+        ParseQuery(query_string, params, &interpreter_context_->ast_cache, interpreter_context_->config.query,
+                   &interpreter_context_->stripped_query_cache);
     query_execution->summary["parsing_time"] = parsing_timer.Elapsed().count();
 
     // Some queries require an active transaction in order to be prepared.
@@ -2084,8 +2350,12 @@ Interpreter::PrepareResult Interpreter::Prepare(const std::string &query_string,
           std::make_unique<storage::Storage::Accessor>(interpreter_context_->db->Access(GetIsolationLevelOverride()));
       execution_db_accessor_.emplace(db_accessor_.get());
 
-      if (utils::Downcast<CypherQuery>(parsed_query.query) && interpreter_context_->trigger_store.HasTriggers()) {
-        trigger_context_collector_.emplace(interpreter_context_->trigger_store.GetEventTypes());
+      collects_graph_changes_ = false;
+      if (utils::Downcast<CypherQuery>(parsed_query.query)) {
+        collects_graph_changes_ = interpreter_context_->change_feed.HasHooks();
+        if (auto event_types = CollectedEventTypes(*interpreter_context_)) {
+          trigger_context_collector_.emplace(*event_types);
+        }
       }
     }
 
@@ -2095,7 +2365,7 @@ Interpreter::PrepareResult Interpreter::Prepare(const std::string &query_string,
     if (utils::Downcast<CypherQuery>(parsed_query.query)) {
       prepared_query = PrepareCypherQuery(std::move(parsed_query), &query_execution->summary, interpreter_context_,
                                           &*execution_db_accessor_, &query_execution->execution_memory,
-                                          &query_execution->notifications,
+                                          &query_execution->notifications, in_explicit_transaction_,
                                           trigger_context_collector_ ? &*trigger_context_collector_ : nullptr);
     } else if (utils::Downcast<ExplainQuery>(parsed_query.query)) {
       prepared_query = PrepareExplainQuery(std::move(parsed_query), &query_execution->summary, interpreter_context_,
@@ -2148,6 +2418,8 @@ Interpreter::PrepareResult Interpreter::Prepare(const std::string &query_string,
       prepared_query = PrepareSettingQuery(std::move(parsed_query), in_explicit_transaction_, &*execution_db_accessor_);
     } else if (utils::Downcast<VersionQuery>(parsed_query.query)) {
       prepared_query = PrepareVersionQuery(std::move(parsed_query), in_explicit_transaction_);
+    } else if (utils::Downcast<AnalyzeGraphQuery>(parsed_query.query)) {
+      prepared_query = PrepareAnalyzeGraphQuery(std::move(parsed_query), in_explicit_transaction_, interpreter_context_);
     } else {
       LOG_FATAL("Should not get here -- unknown query type!");
     }
@@ -2176,9 +2448,18 @@ Interpreter::PrepareResult Interpreter::Prepare(const std::string &query_string,
 }
 
 void Interpreter::Abort() {
+  const bool was_in_explicit_transaction = in_explicit_transaction_;
   expect_rollback_ = false;
   in_explicit_transaction_ = false;
   if (!db_accessor_) return;
+  if (!was_in_explicit_transaction) {
+    // The queries outside of explicit transactions may still be producing
+    // their rows in the background, so they have to stop before the
+    // transaction is aborted.
+    for (auto &query_execution : query_executions_) {
+      if (query_execution) query_execution->prepared_query.reset();
+    }
+  }
   db_accessor_->Abort();
   execution_db_accessor_.reset();
   db_accessor_.reset();
@@ -2186,50 +2467,153 @@ void Interpreter::Abort() {
 }
 
 namespace {
+// Executes the trigger in a transaction of its own.
+void RunTrigger(const Trigger &trigger, InterpreterContext *interpreter_context,
+                const TriggerContext &trigger_context) {
+  utils::MonotonicBufferResource execution_memory{kExecutionMemoryBlockSize};
+
+  auto storage_acc = interpreter_context->db->Access();
+  DbAccessor db_accessor{&storage_acc};
+
+  // The changes made by the trigger are passed to the change hooks like the
+  // changes of any other transaction.
+  auto &change_feed = interpreter_context->change_feed;
+  std::optional<TriggerContextCollector> trigger_changes_collector;
+  if (change_feed.HasHooks()) trigger_changes_collector.emplace(procedure::ChangeHookEventTypes());
+
+  try {
+    trigger.ExecuteAfterCommit(&db_accessor, &execution_memory, interpreter_context->config.execution_timeout_sec,
+                               &interpreter_context->is_shutting_down, trigger_context,
+                               interpreter_context->auth_checker,
+                               trigger_changes_collector ? &*trigger_changes_collector : nullptr);
+  } catch (const utils::BasicException &exception) {
+    spdlog::warn("Trigger '{}' failed with exception:\n{}", trigger.Name(), exception.what());
+    db_accessor.Abort();
+    return;
+  }
+
+  std::optional<procedure::GraphChanges> graph_changes;
+  if (trigger_changes_collector) {
+    procedure::CollectGraphChanges(std::move(*trigger_changes_collector).TransformToTriggerContext(),
+                                   &graph_changes.emplace());
+  }
+  auto maybe_constraint_violation = change_feed.CommitAndPublish(&storage_acc, std::move(graph_changes));
+  if (maybe_constraint_violation.HasError()) {
+    const auto &constraint_violation = maybe_constraint_violation.GetError();
+    switch (constraint_violation.type) {
+      case storage::ConstraintViolation::Type::EXISTENCE: {
+        const auto &label_name = db_accessor.LabelToName(constraint_violation.label);
+        MG_ASSERT(constraint_violation.properties.size() == 1U);
+        const auto &property_name = db_accessor.PropertyToName(*constraint_violation.properties.begin());
+        spdlog::warn("Trigger '{}' failed to commit due to existence constraint violation on :{}({})", trigger.Name(),
+                     label_name, property_name);
+        break;
+      }
+      case storage::ConstraintViolation::Type::UNIQUE: {
+        const auto &label_name = db_accessor.LabelToName(constraint_violation.label);
+        std::stringstream property_names_stream;
+        utils::PrintIterable(property_names_stream, constraint_violation.properties, ", ",
+                             [&](auto &stream, const auto &prop) { stream << db_accessor.PropertyToName(prop); });
+        spdlog::warn("Trigger '{}' failed to commit due to unique constraint violation on :{}({})", trigger.Name(),
+                     label_name, property_names_stream.str());
+        break;
+      }
+    }
+  }
+}
+
+// State of the triggers which are executed in parallel. It's shared with the
+// tasks of the workers, which may only start after all of the triggers are
+// done.
+struct ParallelTriggersState {
+  ParallelTriggersState(std::vector<const Trigger *> triggers, InterpreterContext *interpreter_context,
+                        const TriggerContext *trigger_context)
+      : triggers(std::move(triggers)), interpreter_context(interpreter_context), trigger_context(trigger_context) {}
+
+  std::vector<const Trigger *> triggers;
+  InterpreterContext *interpreter_context;
+  const TriggerContext *trigger_context;
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  size_t next_trigger{0};
+  size_t active_workers{0};
+};
+
+// Takes the triggers of `state` until there are none left.
+void RunParallelTriggers(ParallelTriggersState *state) {
+  {
+    std::lock_guard guard(state->mutex);
+    if (state->next_trigger == state->triggers.size()) return;
+    ++state->active_workers;
+  }
+  while (true) {
+    const Trigger *trigger = nullptr;
+    {
+      std::lock_guard guard(state->mutex);
+      if (state->next_trigger == state->triggers.size()) break;
+      trigger = state->triggers[state->next_trigger++];
+    }
+    RunTrigger(*trigger, state->interpreter_context, *state->trigger_context);
+  }
+  std::lock_guard guard(state->mutex);
+  if (--state->active_workers == 0) state->cv.notify_all();
+}
+
 void RunTriggersIndividually(const utils::SkipList<Trigger> &triggers, InterpreterContext *interpreter_context,
-                             TriggerContext trigger_context) {
-  // Run the triggers
-  for (const auto &trigger : triggers.access()) {
-    utils::MonotonicBufferResource execution_memory{kExecutionMemoryBlockSize};
-
-    // create a new transaction for each trigger
-    auto storage_acc = interpreter_context->db->Access();
-    DbAccessor db_accessor{&storage_acc};
-
-    trigger_context.AdaptForAccessor(&db_accessor);
-    try {
-      trigger.Execute(&db_accessor, &execution_memory, interpreter_context->config.execution_timeout_sec,
-                      &interpreter_context->is_shutting_down, trigger_context, interpreter_context->auth_checker);
-    } catch (const utils::BasicException &exception) {
-      spdlog::warn("Trigger '{}' failed with exception:\n{}", trigger.Name(), exception.what());
-      db_accessor.Abort();
-      continue;
+                             const TriggerContext &trigger_context) {
+  auto triggers_acc = triggers.access();
+  auto &workers = interpreter_context->after_commit_trigger_workers;
+  if (workers.Size() == 0 || triggers_acc.size() < 2) {
+    for (const auto &trigger : triggers_acc) {
+      RunTrigger(trigger, interpreter_context, trigger_context);
     }
+    return;
+  }
 
-    auto maybe_constraint_violation = db_accessor.Commit();
-    if (maybe_constraint_violation.HasError()) {
-      const auto &constraint_violation = maybe_constraint_violation.GetError();
-      switch (constraint_violation.type) {
-        case storage::ConstraintViolation::Type::EXISTENCE: {
-          const auto &label_name = db_accessor.LabelToName(constraint_violation.label);
-          MG_ASSERT(constraint_violation.properties.size() == 1U);
-          const auto &property_name = db_accessor.PropertyToName(*constraint_violation.properties.begin());
-          spdlog::warn("Trigger '{}' failed to commit due to existence constraint violation on :{}({})", trigger.Name(),
-                       label_name, property_name);
-          break;
-        }
-        case storage::ConstraintViolation::Type::UNIQUE: {
-          const auto &label_name = db_accessor.LabelToName(constraint_violation.label);
-          std::stringstream property_names_stream;
-          utils::PrintIterable(property_names_stream, constraint_violation.properties, ", ",
-                               [&](auto &stream, const auto &prop) { stream << db_accessor.PropertyToName(prop); });
-          spdlog::warn("Trigger '{}' failed to commit due to unique constraint violation on :{}({})", trigger.Name(),
-                       label_name, property_names_stream.str());
-          break;
-        }
-      }
+  // The triggers are executed in transactions of their own, which only read
+  // the shared trigger context, so they can run in parallel. The accessor
+  // keeps them alive until all of them are done.
+  std::vector<const Trigger *> trigger_ptrs;
+  trigger_ptrs.reserve(triggers_acc.size());
+  for (const auto &trigger : triggers_acc) {
+    trigger_ptrs.push_back(&trigger);
+  }
+  const auto pool_workers = std::min(workers.Size(), trigger_ptrs.size() - 1);
+  auto state = std::make_shared<ParallelTriggersState>(std::move(trigger_ptrs), interpreter_context, &trigger_context);
+  for (size_t i = 0; i < pool_workers; ++i) {
+    workers.AddTask([state] { RunParallelTriggers(state.get()); });
+  }
+  RunParallelTriggers(state.get());
+  std::unique_lock lock(state->mutex);
+  state->cv.wait(lock, [&] { return state->active_workers == 0; });
+}
+
+// Executes the after commit triggers once for a batch of the pending
+// transactions, with the changes of all of them, so the triggers don't fall
+// further behind the commits.
+void RunPendingAfterCommitTriggers(InterpreterContext *interpreter_context) {
+  const auto batch_size = std::max<uint64_t>(interpreter_context->config.query.after_commit_trigger_batch_size, 1);
+  std::vector<PendingAfterCommitTriggers> batch;
+  interpreter_context->pending_after_commit_triggers.WithLock([&](auto &pending) {
+    while (!pending.empty() && batch.size() < batch_size) {
+      batch.push_back(std::move(pending.front()));
+      pending.pop_front();
     }
+  });
+  // The transactions were already taken by one of the previous batches.
+  if (batch.empty()) return;
+
+  auto trigger_context = std::move(batch.front().trigger_context);
+  for (auto it = std::next(batch.begin()); it != batch.end(); ++it) {
+    trigger_context.Append(std::move(it->trigger_context));
   }
+  RunTriggersIndividually(interpreter_context->trigger_store.AfterCommitTriggers(), interpreter_context,
+                          trigger_context);
+  for (auto &pending : batch) {
+    pending.user_transaction->FinalizeTransaction();
+  }
+  SPDLOG_DEBUG("Finished executing after commit triggers of {} transactions", batch.size());
 }
 }  // namespace
 
@@ -2242,24 +2626,40 @@ void Interpreter::Commit() {
   if (!db_accessor_) return;
 
   std::optional<TriggerContext> trigger_context = std::nullopt;
+  // Without the changes, e.g. when the transaction began before a hook was
+  // loaded, the states of the hooks are rebuilt.
+  std::optional<procedure::GraphChanges> graph_changes;
+  const bool has_change_hooks = interpreter_context_->change_feed.HasHooks();
   if (trigger_context_collector_) {
     trigger_context.emplace(std::move(*trigger_context_collector_).TransformToTriggerContext());
     trigger_context_collector_.reset();
+    if (has_change_hooks && collects_graph_changes_) {
+      procedure::CollectGraphChanges(*trigger_context, &graph_changes.emplace());
+    }
   }
 
   if (trigger_context) {
+    // The changes made by the triggers are collected only for the change
+    // hooks, they don't fire the triggers again.
+    std::optional<TriggerContextCollector> trigger_changes_collector;
+    if (graph_changes) trigger_changes_collector.emplace(procedure::ChangeHookEventTypes());
     // Run the triggers
     for (const auto &trigger : interpreter_context_->trigger_store.BeforeCommitTriggers().access()) {
       utils::MonotonicBufferResource execution_memory{kExecutionMemoryBlockSize};
       AdvanceCommand();
       try {
         trigger.Execute(&*execution_db_accessor_, &execution_memory, interpreter_context_->config.execution_timeout_sec,
-                        &interpreter_context_->is_shutting_down, *trigger_context, interpreter_context_->auth_checker);
+                        &interpreter_context_->is_shutting_down, *trigger_context, interpreter_context_->auth_checker,
+                        trigger_changes_collector ? &*trigger_changes_collector : nullptr);
       } catch (const utils::BasicException &e) {
         throw utils::BasicException(
             fmt::format("Trigger '{}' caused the transaction to fail.\nException: {}", trigger.Name(), e.what()));
       }
     }
+    if (trigger_changes_collector && graph_changes) {
+      procedure::CollectGraphChanges(std::move(*trigger_changes_collector).TransformToTriggerContext(),
+                                     &*graph_changes);
+    }
     SPDLOG_DEBUG("Finished executing before commit triggers");
   }
 
@@ -2269,7 +2669,8 @@ void Interpreter::Commit() {
     trigger_context_collector_.reset();
   };
 
-  auto maybe_constraint_violation = db_accessor_->Commit();
+  auto maybe_constraint_violation =
+      interpreter_context_->change_feed.CommitAndPublish(db_accessor_.get(), std::move(graph_changes));
   if (maybe_constraint_violation.HasError()) {
     const auto &constraint_violation = maybe_constraint_violation.GetError();
     switch (constraint_violation.type) {
@@ -2301,15 +2702,13 @@ void Interpreter::Commit() {
   // probably will schedule its after commit triggers, because the other transactions that want to commit are still
   // waiting for commiting or one of them just started commiting its changes.
   // This means the ordered execution of after commit triggers are not guaranteed.
+  // The pending transactions are taken in the order in which they were added, so the batches keep the order, and each
+  // task takes a batch, unless the previous ones already took all of the transactions.
   if (trigger_context && interpreter_context_->trigger_store.AfterCommitTriggers().size() > 0) {
+    interpreter_context_->pending_after_commit_triggers->push_back(
+        {std::move(*trigger_context), std::shared_ptr(std::move(db_accessor_))});
     interpreter_context_->after_commit_trigger_pool.AddTask(
-        [trigger_context = std::move(*trigger_context), interpreter_context = this->interpreter_context_,
-         user_transaction = std::shared_ptr(std::move(db_accessor_))]() mutable {
-          RunTriggersIndividually(interpreter_context->trigger_store.AfterCommitTriggers(), interpreter_context,
-                                  std::move(trigger_context));
-          user_transaction->FinalizeTransaction();
-          SPDLOG_DEBUG("Finished executing after commit triggers");  // NOLINT(bugprone-lambda-function-name)
-        });
+        [interpreter_context = this->interpreter_context_] { RunPendingAfterCommitTriggers(interpreter_context); });
   }
 
   reset_necessary_members();
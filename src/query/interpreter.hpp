@@ -11,6 +11,9 @@
 
 #pragma once
 
+#include <deque>
+#include <memory>
+
 #include <gflags/gflags.h>
 
 #include "query/auth_checker.hpp"
@@ -26,6 +29,7 @@
 #include "query/metadata.hpp"
 #include "query/plan/operator.hpp"
 #include "query/plan/read_write_type_checker.hpp"
+#include "query/procedure/change_feed.hpp"
 #include "query/stream.hpp"
 #include "query/stream/streams.hpp"
 #include "query/trigger.hpp"
@@ -37,6 +41,7 @@
 #include "utils/settings.hpp"
 #include "utils/skip_list.hpp"
 #include "utils/spin_lock.hpp"
+#include "utils/synchronized.hpp"
 #include "utils/thread_pool.hpp"
 #include "utils/timer.hpp"
 #include "utils/tsc.hpp"
@@ -156,6 +161,15 @@ struct PreparedQuery {
   plan::ReadWriteTypeChecker::RWType rw_type;
 };
 
+/// Changes of a committed transaction which weren't passed to the after commit
+/// triggers yet.
+struct PendingAfterCommitTriggers {
+  TriggerContext trigger_context;
+  // Keeps the objects of the transaction accessible until the triggers are
+  // executed.
+  std::shared_ptr<storage::Storage::Accessor> user_transaction;
+};
+
 /**
  * Holds data shared between multiple `Interpreter` instances (which might be
  * running concurrently).
@@ -169,24 +183,36 @@ struct InterpreterContext {
 
   storage::Storage *db;
 
-  // ANTLR has singleton instance that is shared between threads. It is
-  // protected by locks inside of ANTLR. Unfortunately, they are not protected
-  // in a very good way. Once we have ANTLR version without race conditions we
-  // can remove this lock. This will probably never happen since ANTLR
-  // developers introduce more bugs in each version. Fortunately, we have
-  // cache so this lock probably won't impact performance much...
-  utils::SpinLock antlr_lock;
   std::optional<double> tsc_frequency{utils::GetTSCFrequency()};
   std::atomic<bool> is_shutting_down{false};
 
   AuthQueryHandler *auth{nullptr};
   query::AuthChecker *auth_checker{nullptr};
 
-  utils::SkipList<QueryCacheEntry> ast_cache;
-  utils::SkipList<PlanCacheEntry> plan_cache;
+  frontend::StrippedQueryCache stripped_query_cache;
+  QueryCache ast_cache;
+  PlanCache plan_cache;
 
   TriggerStore trigger_store;
+  // Transactions whose after commit triggers have to be executed, in the
+  // commit order.
+  utils::Synchronized<std::deque<PendingAfterCommitTriggers>, utils::SpinLock> pending_after_commit_triggers;
+  // Execute the after commit triggers in parallel with
+  // after_commit_trigger_pool.
+  utils::ThreadPool after_commit_trigger_workers;
+  // Takes the pending transactions in batches, and executes the triggers of
+  // one batch at a time.
   utils::ThreadPool after_commit_trigger_pool{1};
+  // Produces the rows of the read-only queries while they are being streamed.
+  utils::ThreadPool read_ahead_pool;
+  // Executes the tasks of the read procedures in parallel.
+  utils::ThreadPool procedure_pool;
+  // Passes the committed changes to the change hooks of the query modules.
+  procedure::ChangeFeed change_feed;
+
+  // Directory for the temporary files of the queries which spill their state
+  // to disk.
+  std::filesystem::path spill_directory;
 
   const InterpreterConfig config;
 
@@ -324,6 +350,9 @@ class Interpreter final {
   std::unique_ptr<storage::Storage::Accessor> db_accessor_;
   std::optional<DbAccessor> execution_db_accessor_;
   std::optional<TriggerContextCollector> trigger_context_collector_;
+  // True if trigger_context_collector_ collects the changes for the change
+  // hooks.
+  bool collects_graph_changes_{false};
   bool in_explicit_transaction_{false};
   bool expect_rollback_{false};
 
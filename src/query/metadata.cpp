@@ -62,6 +62,8 @@ constexpr std::string_view GetCodeString(const NotificationCode code) {
       return "IndexDoesNotExist"sv;
     case NotificationCode::NONEXISTANT_CONSTRAINT:
       return "ConstraintDoesNotExist"sv;
+    case NotificationCode::PLAN_INVALIDATED:
+      return "PlanInvalidated"sv;
     case NotificationCode::REGISTER_REPLICA:
       return "RegisterReplica"sv;
     case NotificationCode::REPLICA_PORT_WARNING:
@@ -39,6 +39,7 @@ enum class NotificationCode : uint8_t {
   LOAD_CSV_TIP,
   NONEXISTANT_INDEX,
   NONEXISTANT_CONSTRAINT,
+  PLAN_INVALIDATED,
   REPLICA_PORT_WARNING,
   REGISTER_REPLICA,
   SET_REPLICA,
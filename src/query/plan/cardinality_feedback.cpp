@@ -0,0 +1,51 @@
+// Copyright 2021 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "query/plan/cardinality_feedback.hpp"
+
+#include <algorithm>
+
+namespace query::plan {
+
+CardinalityFeedback::CardinalityFeedback(const std::vector<ScanEstimate> &estimates) {
+  scans_.reserve(estimates.size());
+  for (const auto &estimate : estimates) {
+    scans_.push_back(Scan{estimate, ScanObservation{}});
+  }
+}
+
+ScanObservation *CardinalityFeedback::Find(const LogicalOperator *op) {
+  auto it = std::find_if(scans_.begin(), scans_.end(), [op](const auto &scan) { return scan.estimate.op == op; });
+  if (it == scans_.end()) return nullptr;
+  return &it->observation;
+}
+
+std::optional<CardinalityDrift> CardinalityFeedback::FindDrift(const double factor) const {
+  std::optional<CardinalityDrift> drift;
+  double max_ratio = factor;
+  for (const auto &[estimate, observation] : scans_) {
+    if (observation.input_rows == 0) continue;
+    const auto input_rows = static_cast<double>(observation.input_rows);
+    const auto estimated_vertices = estimate.vertices * input_rows;
+    const auto observed_vertices = static_cast<double>(observation.scanned_vertices);
+    if (std::max(estimated_vertices, observed_vertices) < kCardinalityDriftMinVertices) continue;
+    // Empty scans are treated as if they produced a single vertex, so that
+    // the ratio is defined.
+    const auto ratio = std::max(estimated_vertices, observed_vertices) /
+                       std::max(std::min(estimated_vertices, observed_vertices), input_rows);
+    if (ratio <= max_ratio) continue;
+    max_ratio = ratio;
+    drift.emplace(CardinalityDrift{estimate.op, estimate.vertices, observed_vertices / input_rows});
+  }
+  return drift;
+}
+
+}  // namespace query::plan
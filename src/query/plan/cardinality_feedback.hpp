@@ -0,0 +1,83 @@
+// Copyright 2021 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+/// @file
+/// Comparison of the cardinalities which the planner estimated for the scans
+/// of a cached plan with the number of vertices the scans actually produce.
+/// A cached plan whose estimates are far off was made for a different graph,
+/// so it should be planned again.
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace query::plan {
+
+class LogicalOperator;
+
+/// Scans which produce fewer vertices than this, both by the estimate and by
+/// the observation, are never considered off. Plans of small scans can't be
+/// much worse than the best plan.
+constexpr uint64_t kCardinalityDriftMinVertices = 1000;
+
+/// Number of vertices a scan operator is estimated to produce for a single
+/// input row.
+struct ScanEstimate {
+  const LogicalOperator *op;
+  double vertices;
+};
+
+/// Number of vertices a scan operator produced. Only the input rows for which
+/// the scan was exhausted are counted, because scans cut short (e.g. by LIMIT)
+/// don't tell anything about the estimate.
+struct ScanObservation {
+  void Record(uint64_t vertices) {
+    ++input_rows;
+    scanned_vertices += vertices;
+  }
+
+  uint64_t input_rows{0};
+  uint64_t scanned_vertices{0};
+};
+
+/// Scan whose observed cardinality differs from the estimated one. Both
+/// cardinalities are per input row.
+struct CardinalityDrift {
+  const LogicalOperator *op;
+  double estimated;
+  double observed;
+};
+
+/// Observations of the scans of a single execution of a plan.
+class CardinalityFeedback final {
+ public:
+  explicit CardinalityFeedback(const std::vector<ScanEstimate> &estimates);
+
+  /// Returns the observation of the given scan operator or nullptr if its
+  /// cardinality wasn't estimated.
+  ScanObservation *Find(const LogicalOperator *op);
+
+  /// Returns the scan whose observed cardinality differs the most from the
+  /// estimated one, if it differs by more than `factor` times.
+  std::optional<CardinalityDrift> FindDrift(double factor) const;
+
+ private:
+  struct Scan {
+    ScanEstimate estimate;
+    ScanObservation observation;
+  };
+
+  std::vector<Scan> scans_;
+};
+
+}  // namespace query::plan
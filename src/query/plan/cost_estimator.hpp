@@ -11,13 +11,49 @@
 
 #pragma once
 
+#include <memory>
+#include <optional>
+#include <vector>
+
 #include "query/frontend/ast/ast.hpp"
 #include "query/parameters.hpp"
+#include "query/plan/cardinality_feedback.hpp"
 #include "query/plan/operator.hpp"
 #include "query/typed_value.hpp"
+#include "storage/v2/statistics.hpp"
 
 namespace query::plan {
 
+/// If the expression is a constant property value, it is returned. Otherwise,
+/// return nullopt.
+inline std::optional<storage::PropertyValue> ConstPropertyValue(const Expression *expression,
+                                                                const Parameters &parameters) {
+  if (auto *literal = utils::Downcast<const PrimitiveLiteral>(expression)) {
+    return literal->value_;
+  } else if (auto *param_lookup = utils::Downcast<const ParameterLookup>(expression)) {
+    return parameters.AtTokenPosition(param_lookup->token_position_);
+  }
+  return std::nullopt;
+}
+
+/// Estimates the number of edges produced by expanding a single vertex over
+/// the given edge types and direction. Returns nullopt if the graph was never
+/// analyzed.
+inline std::optional<double> EstimateExpandFanOut(const storage::GraphStatistics *statistics,
+                                                  const std::vector<storage::EdgeTypeId> &edge_types,
+                                                  EdgeAtom::Direction direction) {
+  if (!statistics) return std::nullopt;
+  switch (direction) {
+    case EdgeAtom::Direction::OUT:
+      return statistics->AverageOutDegree(edge_types);
+    case EdgeAtom::Direction::IN:
+      return statistics->AverageInDegree(edge_types);
+    case EdgeAtom::Direction::BOTH:
+      return statistics->AverageOutDegree(edge_types) + statistics->AverageInDegree(edge_types);
+  }
+  return std::nullopt;
+}
+
 /**
  * Query plan execution time cost estimator, for comparing and choosing optimal
  * execution plans.
@@ -42,6 +78,10 @@ namespace query::plan {
  * for all plans for a single query part, and query part reordering is not
  * allowed.
  *
+ * Expansion cardinality is estimated from the average edge-type degrees when
+ * the graph statistics were collected with `ANALYZE GRAPH`, otherwise the
+ * constant fan-out parameters are used.
+ *
  * This kind of cost estimation can only be used for comparing logical plans.
  * It's aim is to estimate cost(A) to be less then cost(B) in every case where
  * actual query execution for plan A is less then that of plan B. It can NOT be
@@ -78,17 +118,21 @@ class CostEstimator : public HierarchicalLogicalOperatorVisitor {
   using HierarchicalLogicalOperatorVisitor::PreVisit;
 
   CostEstimator(TDbAccessor *db_accessor, const Parameters &parameters)
-      : db_accessor_(db_accessor), parameters(parameters) {}
+      : db_accessor_(db_accessor), parameters(parameters), statistics_(db_accessor->GetGraphStatistics()) {}
 
-  bool PostVisit(ScanAll &) override {
-    cardinality_ *= db_accessor_->VerticesCount();
+  bool PostVisit(ScanAll &scan_all) override {
+    const auto factor = db_accessor_->VerticesCount();
+    RecordScan(scan_all, factor);
+    cardinality_ *= factor;
     // ScanAll performs some work for every element that is produced
     IncrementCost(CostParam::kScanAll);
     return true;
   }
 
   bool PostVisit(ScanAllByLabel &scan_all_by_label) override {
-    cardinality_ *= db_accessor_->VerticesCount(scan_all_by_label.label_);
+    const auto factor = db_accessor_->VerticesCount(scan_all_by_label.label_);
+    RecordScan(scan_all_by_label, factor);
+    cardinality_ *= factor;
     // ScanAll performs some work for every element that is produced
     IncrementCost(CostParam::kScanAllByLabel);
     return true;
@@ -107,6 +151,10 @@ class CostEstimator : public HierarchicalLogicalOperatorVisitor {
       // estimate the influence as ScanAll(label, property) * filtering
       factor = db_accessor_->VerticesCount(logical_op.label_, logical_op.property_) * CardParam::kFilter;
 
+    // The cached plans are shared by the queries which differ only in the
+    // literals, so the estimate made from the values of the first query
+    // can't be checked against the values of the next ones.
+    if (!property_value) RecordScan(logical_op, factor);
     cardinality_ *= factor;
 
     // ScanAll performs some work for every element that is produced
@@ -132,6 +180,9 @@ class CostEstimator : public HierarchicalLogicalOperatorVisitor {
     // the filtering constant to the factor
     if ((logical_op.upper_bound_ && !upper) || (logical_op.lower_bound_ && !lower)) factor *= CardParam::kFilter;
 
+    // Like for the value lookup, only the estimates which don't depend on the
+    // bound values are checked.
+    if (!upper && !lower) RecordScan(logical_op, factor);
     cardinality_ *= factor;
 
     // ScanAll performs some work for every element that is produced
@@ -141,6 +192,7 @@ class CostEstimator : public HierarchicalLogicalOperatorVisitor {
 
   bool PostVisit(ScanAllByLabelProperty &logical_op) override {
     const auto factor = db_accessor_->VerticesCount(logical_op.label_, logical_op.property_);
+    RecordScan(logical_op, factor);
     cardinality_ *= factor;
     IncrementCost(CostParam::MakeScanAllByLabelProperty);
     return true;
@@ -148,18 +200,26 @@ class CostEstimator : public HierarchicalLogicalOperatorVisitor {
 
   // TODO: Cost estimate ScanAllById?
 
-// For the given op first increments the cardinality and then cost.
-#define POST_VISIT_CARD_FIRST(NAME)     \
-  bool PostVisit(NAME &) override {     \
-    cardinality_ *= CardParam::k##NAME; \
-    IncrementCost(CostParam::k##NAME);  \
-    return true;                        \
+  bool PostVisit(Expand &expand) override {
+    auto fan_out = EstimateExpandFanOut(statistics_.get(), expand.common_.edge_types, expand.common_.direction);
+    cardinality_ *= fan_out.value_or(CardParam::kExpand);
+    IncrementCost(CostParam::kExpand);
+    return true;
   }
 
-  POST_VISIT_CARD_FIRST(Expand);
-  POST_VISIT_CARD_FIRST(ExpandVariable);
-
-#undef POST_VISIT_CARD_FIRST
+  bool PostVisit(ExpandVariable &expand_variable) override {
+    // Variable expansion produces paths of multiple hops, so scale the single
+    // hop fan-out the same way the constant parameters are scaled.
+    auto fan_out = EstimateExpandFanOut(statistics_.get(), expand_variable.common_.edge_types,
+                                        expand_variable.common_.direction);
+    if (fan_out) {
+      cardinality_ *= *fan_out * CardParam::kExpandVariable / CardParam::kExpand;
+    } else {
+      cardinality_ *= CardParam::kExpandVariable;
+    }
+    IncrementCost(CostParam::kExpandVariable);
+    return true;
+  }
 
 // For the given op first increments the cost and then cardinality.
 #define POST_VISIT_COST_FIRST(LOGICAL_OP, PARAM_NAME) \
@@ -197,6 +257,7 @@ class CostEstimator : public HierarchicalLogicalOperatorVisitor {
 
   auto cost() const { return cost_; }
   auto cardinality() const { return cardinality_; }
+  const auto &scan_estimates() const { return scan_estimates_; }
 
  private:
   // cost estimation that gets accumulated as the visitor
@@ -210,9 +271,19 @@ class CostEstimator : public HierarchicalLogicalOperatorVisitor {
   // accessor used for cardinality estimates in ScanAll and ScanAllByLabel
   TDbAccessor *db_accessor_;
   const Parameters &parameters;
+  // statistics used for cardinality estimates in Expand, nullptr if the graph
+  // was never analyzed
+  std::shared_ptr<const storage::GraphStatistics> statistics_;
+
+  // number of vertices each scan produces for a single input row
+  std::vector<ScanEstimate> scan_estimates_;
 
   void IncrementCost(double param) { cost_ += param * cardinality_; }
 
+  void RecordScan(const LogicalOperator &scan, double factor) {
+    scan_estimates_.push_back(ScanEstimate{&scan, factor});
+  }
+
   // converts an optional ScanAll range bound into a property value
   // if the bound is present and is a constant expression convertible to
   // a property value. otherwise returns nullopt
@@ -225,15 +296,8 @@ class CostEstimator : public HierarchicalLogicalOperatorVisitor {
     return std::nullopt;
   }
 
-  // If the expression is a constant property value, it is returned. Otherwise,
-  // return nullopt.
   std::optional<storage::PropertyValue> ConstPropertyValue(const Expression *expression) {
-    if (auto *literal = utils::Downcast<const PrimitiveLiteral>(expression)) {
-      return literal->value_;
-    } else if (auto *param_lookup = utils::Downcast<const ParameterLookup>(expression)) {
-      return parameters.AtTokenPosition(param_lookup->token_position_);
-    }
-    return std::nullopt;
+    return ::query::plan::ConstPropertyValue(expression, parameters);
   }
 };
 
@@ -245,4 +309,15 @@ double EstimatePlanCost(TDbAccessor *db, const Parameters &parameters, LogicalOp
   return estimator.cost();
 }
 
+/** Returns the estimated number of vertices which each of the scans of the
+ * given plan produces for a single input row. */
+template <class TDbAccessor>
+std::vector<ScanEstimate> EstimateScanCardinalities(TDbAccessor *db, const Parameters &parameters,
+                                                    const LogicalOperator &plan) {
+  CostEstimator<TDbAccessor> estimator(db, parameters);
+  // The visitor doesn't modify the plan.
+  const_cast<LogicalOperator &>(plan).Accept(estimator);
+  return estimator.scan_estimates();
+}
+
 }  // namespace query::plan
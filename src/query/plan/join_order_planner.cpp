@@ -0,0 +1,86 @@
+// Copyright 2021 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "query/plan/join_order_planner.hpp"
+
+#include "utils/flag_validation.hpp"
+
+// The exhaustive search keeps a state for every subset of expansions, so the
+// limit must stay small.
+DEFINE_VALIDATED_HIDDEN_uint64(query_plan_dp_max_expansions, 12U,
+                               "Maximum number of expansions in a single MATCH for which the traversal order is found "
+                               "exhaustively. Larger patterns are ordered greedily.",
+                               FLAG_IN_RANGE(0, 20));
+
+namespace query::plan::impl {
+
+namespace {
+
+void CollectPatternSymbols(const Pattern &pattern, const SymbolTable &symbol_table,
+                           std::unordered_set<Symbol> *bound_symbols) {
+  for (const auto *atom : pattern.atoms_) {
+    bound_symbols->insert(symbol_table.at(*atom->identifier_));
+  }
+  if (pattern.identifier_->user_declared_) {
+    bound_symbols->insert(symbol_table.at(*pattern.identifier_));
+  }
+}
+
+}  // namespace
+
+Expansion FlipExpansion(Expansion expansion) {
+  if (!expansion.edge || expansion.edge->type_ == EdgeAtom::Type::BREADTH_FIRST) {
+    return expansion;
+  }
+  std::swap(expansion.node1, expansion.node2);
+  expansion.is_flipped = !expansion.is_flipped;
+  if (expansion.direction != EdgeAtom::Direction::BOTH) {
+    expansion.direction =
+        expansion.direction == EdgeAtom::Direction::IN ? EdgeAtom::Direction::OUT : EdgeAtom::Direction::IN;
+  }
+  return expansion;
+}
+
+void CollectBoundSymbols(const SingleQueryPart &query_part, const SymbolTable &symbol_table,
+                         std::unordered_set<Symbol> *bound_symbols) {
+  bound_symbols->insert(query_part.matching.expansion_symbols.begin(), query_part.matching.expansion_symbols.end());
+  for (const auto &matching : query_part.optional_matching) {
+    bound_symbols->insert(matching.expansion_symbols.begin(), matching.expansion_symbols.end());
+  }
+  for (const auto &matching : query_part.merge_matching) {
+    bound_symbols->insert(matching.expansion_symbols.begin(), matching.expansion_symbols.end());
+  }
+  for (auto *clause : query_part.remaining_clauses) {
+    if (auto *with = utils::Downcast<With>(clause)) {
+      // Only the symbols produced by WITH are visible after it.
+      if (!with->body_.all_identifiers) bound_symbols->clear();
+      for (const auto *named_expression : with->body_.named_expressions) {
+        bound_symbols->insert(symbol_table.at(*named_expression));
+      }
+    } else if (auto *unwind = utils::Downcast<Unwind>(clause)) {
+      bound_symbols->insert(symbol_table.at(*unwind->named_expression_));
+    } else if (auto *call_procedure = utils::Downcast<CallProcedure>(clause)) {
+      for (const auto *identifier : call_procedure->result_identifiers_) {
+        bound_symbols->insert(symbol_table.at(*identifier));
+      }
+    } else if (auto *load_csv = utils::Downcast<LoadCsv>(clause)) {
+      bound_symbols->insert(symbol_table.at(*load_csv->row_var_));
+    } else if (auto *create = utils::Downcast<Create>(clause)) {
+      for (const auto *pattern : create->patterns_) {
+        CollectPatternSymbols(*pattern, symbol_table, bound_symbols);
+      }
+    } else if (auto *merge = utils::Downcast<Merge>(clause)) {
+      CollectPatternSymbols(*merge->pattern_, symbol_table, bound_symbols);
+    }
+  }
+}
+
+}  // namespace query::plan::impl
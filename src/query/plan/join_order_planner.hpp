@@ -0,0 +1,451 @@
+// Copyright 2021 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+/// @file
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "gflags/gflags.h"
+
+#include "query/plan/cost_estimator.hpp"
+#include "query/plan/rule_based_planner.hpp"
+#include "storage/v2/statistics.hpp"
+
+DECLARE_uint64(query_plan_dp_max_expansions);
+
+namespace query::plan {
+
+namespace impl {
+
+// Returns the expansion oriented so that it starts from `node2`. Breadth first
+// expansions must not be flipped, so they are returned unchanged.
+Expansion FlipExpansion(Expansion expansion);
+
+// Adds the symbols which are bound after the given query part is planned.
+// These are used as the initially bound symbols of the next query part.
+void CollectBoundSymbols(const SingleQueryPart &query_part, const SymbolTable &symbol_table,
+                         std::unordered_set<Symbol> *bound_symbols);
+
+// Orders the expansions of a single `Matching` by estimating the cost of each
+// order from the database counts and the graph statistics collected by
+// `ANALYZE GRAPH`. The order is found exhaustively with dynamic programming
+// over subsets of expansions, and greedily for matchings with more than
+// `FLAGS_query_plan_dp_max_expansions` expansions.
+template <class TDbAccessor>
+class JoinOrderOptimizer final {
+  using CostParam = typename CostEstimator<TDbAccessor>::CostParam;
+  using CardParam = typename CostEstimator<TDbAccessor>::CardParam;
+
+ public:
+  JoinOrderOptimizer(TDbAccessor *db, const SymbolTable &symbol_table, const Parameters *parameters)
+      : db_(db),
+        symbol_table_(symbol_table),
+        parameters_(parameters),
+        statistics_(db->GetGraphStatistics()),
+        total_vertices_(std::max<double>(1.0, db->VerticesCount())) {}
+
+  std::vector<Expansion> Optimize(const Matching &matching, const std::unordered_set<Symbol> &bound_symbols) {
+    if (matching.expansions.empty()) return matching.expansions;
+    Prepare(matching, bound_symbols);
+    std::vector<Step> steps;
+    if (matching.expansions.size() <= FLAGS_query_plan_dp_max_expansions && matching.expansions.size() < 64U) {
+      steps = OptimizeExhaustively();
+    } else {
+      steps = OptimizeGreedily();
+    }
+    std::vector<Expansion> expansions;
+    expansions.reserve(steps.size());
+    for (const auto &step : steps) {
+      const auto &expansion = matching.expansions[step.expansion_id];
+      expansions.emplace_back(step.flip ? FlipExpansion(expansion) : expansion);
+    }
+    return expansions;
+  }
+
+ private:
+  // A single expansion in the chosen order.
+  struct Step {
+    size_t expansion_id;
+    bool flip;
+  };
+
+  // Estimated cost and cardinality after performing a set of expansions.
+  struct State {
+    double cost{std::numeric_limits<double>::infinity()};
+    double cardinality{1.0};
+    uint64_t previous{0};
+    Step step{0, false};
+  };
+
+  // Everything needed for estimating a single orientation of an expansion.
+  struct Orientation {
+    size_t from;
+    std::optional<size_t> to;
+    double fan_out;
+    bool is_variable;
+  };
+
+  struct Candidate {
+    std::vector<Orientation> orientations;
+    // Symbols from this matching used in the range of a variable expansion.
+    std::vector<size_t> range_symbols;
+  };
+
+  void Prepare(const Matching &matching, const std::unordered_set<Symbol> &bound_symbols) {
+    symbols_.clear();
+    binding_masks_.clear();
+    initially_bound_.clear();
+    node_cardinalities_.clear();
+    candidates_.clear();
+    auto symbol_index = [&](const Symbol &symbol) {
+      auto [it, inserted] = symbols_.emplace(symbol, binding_masks_.size());
+      if (inserted) {
+        binding_masks_.push_back(0);
+        initially_bound_.push_back(utils::Contains(bound_symbols, symbol));
+        node_cardinalities_.push_back(std::nullopt);
+      }
+      return it->second;
+    };
+    auto node_index = [&](const NodeAtom *node) {
+      const auto &symbol = symbol_table_.at(*node->identifier_);
+      auto index = symbol_index(symbol);
+      if (!node_cardinalities_[index]) node_cardinalities_[index] = EstimateNode(symbol, matching);
+      return index;
+    };
+    for (size_t id = 0; id < matching.expansions.size(); ++id) {
+      const auto &expansion = matching.expansions[id];
+      const uint64_t expansion_mask = 1ULL << std::min<size_t>(id, 63U);
+      Candidate candidate;
+      auto node1 = node_index(expansion.node1);
+      binding_masks_[node1] |= expansion_mask;
+      if (!expansion.edge) {
+        candidate.orientations.push_back(Orientation{node1, std::nullopt, 1.0, false});
+        candidates_.push_back(std::move(candidate));
+        continue;
+      }
+      auto node2 = node_index(expansion.node2);
+      binding_masks_[node2] |= expansion_mask;
+      binding_masks_[symbol_index(symbol_table_.at(*expansion.edge->identifier_))] |= expansion_mask;
+      std::vector<storage::EdgeTypeId> edge_types;
+      edge_types.reserve(expansion.edge->edge_types_.size());
+      for (const auto &type : expansion.edge->edge_types_) {
+        edge_types.push_back(db_->NameToEdgeType(type.name));
+      }
+      const bool is_variable = expansion.edge->IsVariable();
+      candidate.orientations.push_back(
+          Orientation{node1, node2, FanOut(edge_types, expansion.direction, is_variable), is_variable});
+      if (expansion.edge->type_ != EdgeAtom::Type::BREADTH_FIRST) {
+        const auto flipped = FlipExpansion(expansion);
+        candidate.orientations.push_back(
+            Orientation{node2, node1, FanOut(edge_types, flipped.direction, is_variable), is_variable});
+      }
+      for (const auto &range_symbol : expansion.symbols_in_range) {
+        if (utils::Contains(matching.expansion_symbols, range_symbol)) {
+          candidate.range_symbols.push_back(symbol_index(range_symbol));
+        }
+      }
+      candidates_.push_back(std::move(candidate));
+    }
+  }
+
+  bool IsBound(size_t symbol, uint64_t performed) const {
+    return initially_bound_[symbol] || (binding_masks_[symbol] & performed) != 0;
+  }
+
+  bool CanPerform(const Candidate &candidate, uint64_t performed) const {
+    return std::all_of(candidate.range_symbols.begin(), candidate.range_symbols.end(),
+                       [&](auto symbol) { return IsBound(symbol, performed); });
+  }
+
+  // Estimates the state after performing the expansion in the given
+  // orientation, starting from the `previous` state.
+  State Perform(const State &previous, uint64_t performed, const Orientation &orientation) const {
+    State next = previous;
+    auto &cost = next.cost;
+    auto &cardinality = next.cardinality;
+    if (!IsBound(orientation.from, performed)) {
+      const auto &node = *node_cardinalities_[orientation.from];
+      cost += cardinality * node.scanned * node.scan_cost;
+      cardinality *= node.scanned;
+      if (node.filtered < node.scanned) {
+        cost += cardinality * CostParam::kFilter;
+        cardinality *= node.filtered / node.scanned;
+      }
+    }
+    if (!orientation.to) return next;
+    cost += cardinality * (orientation.is_variable ? CostParam::kExpandVariable : CostParam::kExpand);
+    cardinality *= orientation.fan_out;
+    const auto &target = *node_cardinalities_[*orientation.to];
+    if (IsBound(*orientation.to, performed)) {
+      // Expanding to an existing node keeps only the edges which end in it.
+      cardinality /= std::max(1.0, target.filtered);
+    } else if (target.filtered < total_vertices_) {
+      cost += cardinality * CostParam::kFilter;
+      cardinality *= target.filtered / total_vertices_;
+    }
+    return next;
+  }
+
+  std::vector<Step> OptimizeExhaustively() const {
+    const auto expansions_count = candidates_.size();
+    const uint64_t all_performed = (1ULL << expansions_count) - 1;
+    std::vector<State> states(all_performed + 1);
+    states[0].cost = 0.0;
+    // Every transition adds an expansion, so the states are visited in the
+    // order of increasing subsets.
+    for (uint64_t performed = 0; performed < all_performed; ++performed) {
+      const auto &state = states[performed];
+      if (state.cost == std::numeric_limits<double>::infinity()) continue;
+      for (size_t id = 0; id < expansions_count; ++id) {
+        const uint64_t expansion_mask = 1ULL << id;
+        if ((performed & expansion_mask) || !CanPerform(candidates_[id], performed)) continue;
+        const auto &orientations = candidates_[id].orientations;
+        for (size_t orientation = 0; orientation < orientations.size(); ++orientation) {
+          auto next = Perform(state, performed, orientations[orientation]);
+          auto &best = states[performed | expansion_mask];
+          if (next.cost < best.cost) {
+            next.previous = performed;
+            next.step = Step{id, orientation != 0};
+            best = next;
+          }
+        }
+      }
+    }
+    std::vector<Step> steps;
+    steps.reserve(expansions_count);
+    for (uint64_t performed = all_performed; performed != 0; performed = states[performed].previous) {
+      DMG_ASSERT(states[performed].cost != std::numeric_limits<double>::infinity(), "Expected a reachable state");
+      steps.push_back(states[performed].step);
+    }
+    std::reverse(steps.begin(), steps.end());
+    return steps;
+  }
+
+  // Picks the cheapest next expansion until all of them are performed. Only
+  // the first 64 expansions are tracked in the bit set, so the ones after
+  // them keep their original order.
+  std::vector<Step> OptimizeGreedily() const {
+    const auto tracked_count = std::min<size_t>(candidates_.size(), 63U);
+    std::vector<Step> steps;
+    steps.reserve(candidates_.size());
+    std::vector<bool> is_performed(tracked_count, false);
+    uint64_t performed = 0;
+    State state;
+    state.cost = 0.0;
+    for (size_t step = 0; step < tracked_count; ++step) {
+      std::optional<State> best;
+      for (size_t id = 0; id < tracked_count; ++id) {
+        if (is_performed[id] || !CanPerform(candidates_[id], performed)) continue;
+        const auto &orientations = candidates_[id].orientations;
+        for (size_t orientation = 0; orientation < orientations.size(); ++orientation) {
+          auto next = Perform(state, performed, orientations[orientation]);
+          if (!best || next.cost < best->cost) {
+            next.step = Step{id, orientation != 0};
+            best = next;
+          }
+        }
+      }
+      if (!best) break;
+      is_performed[best->step.expansion_id] = true;
+      performed |= 1ULL << best->step.expansion_id;
+      steps.push_back(best->step);
+      state = *best;
+    }
+    for (size_t id = 0; id < candidates_.size(); ++id) {
+      if (id < tracked_count && is_performed[id]) continue;
+      steps.push_back(Step{id, false});
+    }
+    return steps;
+  }
+
+  // Estimated number of vertices produced by scanning a node and the number
+  // left after applying the label and property filters of the node.
+  struct NodeEstimate {
+    double scanned;
+    double filtered;
+    double scan_cost;
+  };
+
+  NodeEstimate EstimateNode(const Symbol &symbol, const Matching &matching) {
+    double scanned = total_vertices_;
+    double scan_cost = CostParam::kScanAll;
+    double filtered = total_vertices_;
+    std::vector<storage::LabelId> labels;
+    for (const auto &label : matching.filters.FilteredLabels(symbol)) {
+      auto label_id = db_->NameToLabel(label.name);
+      labels.push_back(label_id);
+      double label_count = 0.0;
+      if (db_->LabelIndexExists(label_id)) {
+        label_count = db_->VerticesCount(label_id);
+        if (label_count < scanned) {
+          scanned = label_count;
+          scan_cost = CostParam::kScanAllByLabel;
+        }
+      } else if (statistics_) {
+        label_count = statistics_->LabelCount(label_id);
+      } else {
+        label_count = filtered * CardParam::kFilter;
+      }
+      filtered = std::min(filtered, label_count);
+    }
+    for (const auto &filter : matching.filters.PropertyFilters(symbol)) {
+      const auto &property_filter = *filter.property_filter;
+      auto property = db_->NameToProperty(property_filter.property_.name);
+      std::optional<double> property_count;
+      for (const auto label : labels) {
+        auto count = PropertyFilterCount(label, property, property_filter);
+        if (!count) continue;
+        if (db_->LabelPropertyIndexExists(label, property) && *count < scanned) {
+          scanned = *count;
+          scan_cost = CostParam::MakeScanAllByLabelPropertyValue;
+        }
+        property_count = std::min(property_count.value_or(*count), *count);
+      }
+      filtered = std::min(filtered, property_count.value_or(filtered * CardParam::kFilter));
+    }
+    filtered = std::min(filtered, scanned);
+    return {scanned, filtered, scan_cost};
+  }
+
+  // Estimates the number of vertices with the label that pass the property
+  // filter. The index is preferred over the statistics because it's always up
+  // to date.
+  std::optional<double> PropertyFilterCount(storage::LabelId label, storage::PropertyId property,
+                                            const PropertyFilter &filter) {
+    if (filter.is_symbol_in_value_) return std::nullopt;
+    const bool has_index = db_->LabelPropertyIndexExists(label, property);
+    const auto *property_statistics = statistics_ ? statistics_->GetLabelPropertyStatistics(label, property) : nullptr;
+    if (!has_index && !property_statistics) return std::nullopt;
+    auto property_count = [&]() -> double {
+      if (has_index) return db_->VerticesCount(label, property);
+      return property_statistics->count;
+    };
+    switch (filter.type_) {
+      case PropertyFilter::Type::EQUAL: {
+        auto value = ConstValue(filter.value_);
+        if (value && has_index) return db_->VerticesCount(label, property, *value);
+        if (value) return property_statistics->EstimateEqualCount(*value);
+        if (property_statistics) return property_statistics->AverageGroupSize();
+        return property_count() * CardParam::kFilter;
+      }
+      case PropertyFilter::Type::RANGE: {
+        auto lower = ConstBound(filter.lower_bound_);
+        auto upper = ConstBound(filter.upper_bound_);
+        if ((filter.lower_bound_ && !lower) || (filter.upper_bound_ && !upper)) {
+          return property_count() * CardParam::kFilter;
+        }
+        if (has_index) return db_->VerticesCount(label, property, lower, upper);
+        return property_statistics->EstimateRangeCount(lower, upper);
+      }
+      case PropertyFilter::Type::IS_NOT_NULL:
+        return property_count();
+      case PropertyFilter::Type::REGEX_MATCH:
+      case PropertyFilter::Type::IN:
+        return property_count() * CardParam::kFilter;
+    }
+    return std::nullopt;
+  }
+
+  double FanOut(const std::vector<storage::EdgeTypeId> &edge_types, EdgeAtom::Direction direction,
+                bool is_variable) const {
+    auto fan_out = EstimateExpandFanOut(statistics_.get(), edge_types, direction);
+    if (!is_variable) return fan_out.value_or(CardParam::kExpand);
+    if (fan_out) return *fan_out * CardParam::kExpandVariable / CardParam::kExpand;
+    return CardParam::kExpandVariable;
+  }
+
+  std::optional<storage::PropertyValue> ConstValue(const Expression *expression) const {
+    if (!parameters_) {
+      if (auto *literal = utils::Downcast<const PrimitiveLiteral>(expression)) return literal->value_;
+      return std::nullopt;
+    }
+    return ConstPropertyValue(expression, *parameters_);
+  }
+
+  std::optional<utils::Bound<storage::PropertyValue>> ConstBound(const std::optional<PropertyFilter::Bound> &bound) {
+    if (!bound) return std::nullopt;
+    auto value = ConstValue(bound->value());
+    if (!value) return std::nullopt;
+    return utils::Bound<storage::PropertyValue>(*value, bound->type());
+  }
+
+  TDbAccessor *db_;
+  const SymbolTable &symbol_table_;
+  const Parameters *parameters_;
+  std::shared_ptr<const storage::GraphStatistics> statistics_;
+  double total_vertices_;
+
+  // Per matching data, indexed by the symbol position in `symbols_`.
+  std::unordered_map<Symbol, size_t> symbols_;
+  // Set of expansions which bind each symbol.
+  std::vector<uint64_t> binding_masks_;
+  std::vector<bool> initially_bound_;
+  // Set only for node symbols.
+  std::vector<std::optional<NodeEstimate>> node_cardinalities_;
+  std::vector<Candidate> candidates_;
+};
+
+}  // namespace impl
+
+/// @brief Planner which orders graph traversal by estimated cost.
+///
+/// The expansions of each matching are reordered using cardinality estimates
+/// from the database and the statistics collected by `ANALYZE GRAPH`, after
+/// which a single plan is generated by @c RuleBasedPlanner.
+///
+/// @sa MakeLogicalPlan
+template <class TPlanningContext>
+class JoinOrderPlanner {
+ public:
+  explicit JoinOrderPlanner(TPlanningContext *context) : context_(context) {}
+
+  /// @brief The result of plan generation is the root of the generated operator
+  /// tree.
+  using PlanResult = std::unique_ptr<LogicalOperator>;
+
+  PlanResult Plan(const std::vector<SingleQueryPart> &query_parts) {
+    const auto &symbol_table = *context_->symbol_table;
+    impl::JoinOrderOptimizer optimizer(context_->db, symbol_table, context_->parameters);
+    auto ordered_query_parts = query_parts;
+    std::unordered_set<Symbol> bound_symbols(context_->bound_symbols);
+    for (auto &query_part : ordered_query_parts) {
+      query_part.matching.expansions = optimizer.Optimize(query_part.matching, bound_symbols);
+      // Optional and merge matchings are planned after the regular matching,
+      // and each optional matching binds its symbols for the next ones.
+      auto matching_bound_symbols = bound_symbols;
+      matching_bound_symbols.insert(query_part.matching.expansion_symbols.begin(),
+                                    query_part.matching.expansion_symbols.end());
+      for (auto &optional_matching : query_part.optional_matching) {
+        optional_matching.expansions = optimizer.Optimize(optional_matching, matching_bound_symbols);
+        matching_bound_symbols.insert(optional_matching.expansion_symbols.begin(),
+                                      optional_matching.expansion_symbols.end());
+      }
+      for (auto &merge_matching : query_part.merge_matching) {
+        merge_matching.expansions = optimizer.Optimize(merge_matching, matching_bound_symbols);
+      }
+      impl::CollectBoundSymbols(query_part, symbol_table, &bound_symbols);
+    }
+    return RuleBasedPlanner<TPlanningContext>(context_).Plan(ordered_query_parts);
+  }
+
+ private:
+  TPlanningContext *context_;
+};
+
+}  // namespace query::plan
@@ -12,6 +12,7 @@
 #include "query/plan/operator.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cstdint>
 #include <limits>
 #include <queue>
@@ -31,9 +32,11 @@
 #include "query/exceptions.hpp"
 #include "query/frontend/ast/ast.hpp"
 #include "query/frontend/semantic/symbol_table.hpp"
+#include "query/interpret/compact_rows.hpp"
 #include "query/interpret/eval.hpp"
 #include "query/path.hpp"
 #include "query/plan/scoped_profile.hpp"
+#include "query/plan/spill.hpp"
 #include "query/procedure/cypher_types.hpp"
 #include "query/procedure/mg_procedure_impl.hpp"
 #include "query/procedure/module.hpp"
@@ -378,9 +381,10 @@ VertexAccessor &CreateExpand::CreateExpandCursor::OtherVertex(Frame &frame, Exec
 template <class TVerticesFun>
 class ScanAllCursor : public Cursor {
  public:
-  explicit ScanAllCursor(Symbol output_symbol, UniqueCursorPtr input_cursor, TVerticesFun get_vertices,
-                         const char *op_name)
-      : output_symbol_(output_symbol),
+  explicit ScanAllCursor(const ScanAll &self, Symbol output_symbol, UniqueCursorPtr input_cursor,
+                         TVerticesFun get_vertices, const char *op_name)
+      : self_(self),
+        output_symbol_(output_symbol),
         input_cursor_(std::move(input_cursor)),
         get_vertices_(std::move(get_vertices)),
         op_name_(op_name) {}
@@ -391,11 +395,19 @@ class ScanAllCursor : public Cursor {
     if (MustAbort(context)) throw HintedAbortError();
 
     while (!vertices_ || vertices_it_.value() == vertices_.value().end()) {
+      if (vertices_) {
+        RecordScannedVertices(context);
+        vertices_it_ = std::nullopt;
+        vertices_ = std::nullopt;
+      }
       if (!input_cursor_->Pull(frame, context)) return false;
       // We need a getter function, because in case of exhausting a lazy
       // iterable, we cannot simply reset it by calling begin().
       auto next_vertices = get_vertices_(frame, context);
-      if (!next_vertices) continue;
+      if (!next_vertices) {
+        RecordScannedVertices(context);
+        continue;
+      }
       // Since vertices iterator isn't nothrow_move_assignable, we have to use
       // the roundabout assignment + emplace, instead of simple:
       // vertices _ = get_vertices_(frame, context);
@@ -405,6 +417,7 @@ class ScanAllCursor : public Cursor {
 
     frame[output_symbol_] = *vertices_it_.value();
     ++vertices_it_.value();
+    ++scanned_vertices_;
     return true;
   }
 
@@ -414,15 +427,33 @@ class ScanAllCursor : public Cursor {
     input_cursor_->Reset();
     vertices_ = std::nullopt;
     vertices_it_ = std::nullopt;
+    scanned_vertices_ = 0;
   }
 
  private:
+  // Reports the number of vertices scanned for the last input row, once all
+  // of them were scanned.
+  void RecordScannedVertices(ExecutionContext &context) {
+    if (context.cardinality_feedback) {
+      if (!observation_looked_up_) {
+        observation_ = context.cardinality_feedback->Find(&self_);
+        observation_looked_up_ = true;
+      }
+      if (observation_) observation_->Record(scanned_vertices_);
+    }
+    scanned_vertices_ = 0;
+  }
+
+  const ScanAll &self_;
   const Symbol output_symbol_;
   const UniqueCursorPtr input_cursor_;
   TVerticesFun get_vertices_;
   std::optional<typename std::result_of<TVerticesFun(Frame &, ExecutionContext &)>::type::value_type> vertices_;
   std::optional<decltype(vertices_.value().begin())> vertices_it_;
   const char *op_name_;
+  uint64_t scanned_vertices_{0};
+  plan::ScanObservation *observation_{nullptr};
+  bool observation_looked_up_{false};
 };
 
 ScanAll::ScanAll(const std::shared_ptr<LogicalOperator> &input, Symbol output_symbol, storage::View view)
@@ -437,7 +468,7 @@ UniqueCursorPtr ScanAll::MakeCursor(utils::MemoryResource *mem) const {
     auto *db = context.db_accessor;
     return std::make_optional(db->Vertices(view_));
   };
-  return MakeUniqueCursorPtr<ScanAllCursor<decltype(vertices)>>(mem, output_symbol_, input_->MakeCursor(mem),
+  return MakeUniqueCursorPtr<ScanAllCursor<decltype(vertices)>>(mem, *this, output_symbol_, input_->MakeCursor(mem),
                                                                 std::move(vertices), "ScanAll");
 }
 
@@ -460,7 +491,7 @@ UniqueCursorPtr ScanAllByLabel::MakeCursor(utils::MemoryResource *mem) const {
     auto *db = context.db_accessor;
     return std::make_optional(db->Vertices(view_, label_));
   };
-  return MakeUniqueCursorPtr<ScanAllCursor<decltype(vertices)>>(mem, output_symbol_, input_->MakeCursor(mem),
+  return MakeUniqueCursorPtr<ScanAllCursor<decltype(vertices)>>(mem, *this, output_symbol_, input_->MakeCursor(mem),
                                                                 std::move(vertices), "ScanAllByLabel");
 }
 
@@ -525,7 +556,7 @@ UniqueCursorPtr ScanAllByLabelPropertyRange::MakeCursor(utils::MemoryResource *m
     if (maybe_upper && maybe_upper->value().IsNull()) return std::nullopt;
     return std::make_optional(db->Vertices(view_, label_, property_, maybe_lower, maybe_upper));
   };
-  return MakeUniqueCursorPtr<ScanAllCursor<decltype(vertices)>>(mem, output_symbol_, input_->MakeCursor(mem),
+  return MakeUniqueCursorPtr<ScanAllCursor<decltype(vertices)>>(mem, *this, output_symbol_, input_->MakeCursor(mem),
                                                                 std::move(vertices), "ScanAllByLabelPropertyRange");
 }
 
@@ -557,7 +588,7 @@ UniqueCursorPtr ScanAllByLabelPropertyValue::MakeCursor(utils::MemoryResource *m
     }
     return std::make_optional(db->Vertices(view_, label_, property_, storage::PropertyValue(value)));
   };
-  return MakeUniqueCursorPtr<ScanAllCursor<decltype(vertices)>>(mem, output_symbol_, input_->MakeCursor(mem),
+  return MakeUniqueCursorPtr<ScanAllCursor<decltype(vertices)>>(mem, *this, output_symbol_, input_->MakeCursor(mem),
                                                                 std::move(vertices), "ScanAllByLabelPropertyValue");
 }
 
@@ -575,7 +606,7 @@ UniqueCursorPtr ScanAllByLabelProperty::MakeCursor(utils::MemoryResource *mem) c
     auto *db = context.db_accessor;
     return std::make_optional(db->Vertices(view_, label_, property_));
   };
-  return MakeUniqueCursorPtr<ScanAllCursor<decltype(vertices)>>(mem, output_symbol_, input_->MakeCursor(mem),
+  return MakeUniqueCursorPtr<ScanAllCursor<decltype(vertices)>>(mem, *this, output_symbol_, input_->MakeCursor(mem),
                                                                 std::move(vertices), "ScanAllByLabelProperty");
 }
 
@@ -601,7 +632,7 @@ UniqueCursorPtr ScanAllById::MakeCursor(utils::MemoryResource *mem) const {
     if (!maybe_vertex) return std::nullopt;
     return std::vector<VertexAccessor>{*maybe_vertex};
   };
-  return MakeUniqueCursorPtr<ScanAllCursor<decltype(vertices)>>(mem, output_symbol_, input_->MakeCursor(mem),
+  return MakeUniqueCursorPtr<ScanAllCursor<decltype(vertices)>>(mem, *this, output_symbol_, input_->MakeCursor(mem),
                                                                 std::move(vertices), "ScanAllById");
 }
 
@@ -2535,21 +2566,17 @@ class AccumulateCursor : public Cursor {
     // cache all the input
     if (!pulled_all_input_) {
       while (input_cursor_->Pull(frame, context)) {
-        utils::pmr::vector<TypedValue> row(cache_.get_allocator().GetMemoryResource());
-        row.reserve(self_.symbols_.size());
-        for (const Symbol &symbol : self_.symbols_) row.emplace_back(frame[symbol]);
-        cache_.emplace_back(std::move(row));
+        cache_.Append(frame, self_.symbols_);
       }
       pulled_all_input_ = true;
-      cache_it_ = cache_.begin();
+      cache_row_ = 0;
 
       if (self_.advance_command_) dba.AdvanceCommand();
     }
 
     if (MustAbort(context)) throw HintedAbortError();
-    if (cache_it_ == cache_.end()) return false;
-    auto row_it = (cache_it_++)->begin();
-    for (const Symbol &symbol : self_.symbols_) frame[symbol] = *row_it++;
+    if (cache_row_ == cache_.size()) return false;
+    cache_.Load(cache_row_++, self_.symbols_, &frame);
     return true;
   }
 
@@ -2558,15 +2585,15 @@ class AccumulateCursor : public Cursor {
   void Reset() override {
     input_cursor_->Reset();
     cache_.clear();
-    cache_it_ = cache_.begin();
+    cache_row_ = 0;
     pulled_all_input_ = false;
   }
 
  private:
   const Accumulate &self_;
   const UniqueCursorPtr input_cursor_;
-  utils::pmr::vector<utils::pmr::vector<TypedValue>> cache_;
-  decltype(cache_.begin()) cache_it_ = cache_.begin();
+  CompactRows cache_;
+  size_t cache_row_{0};
   bool pulled_all_input_{false};
 };
 
@@ -2611,16 +2638,29 @@ TypedValue DefaultAggregationOpValue(const Aggregate::Element &element, utils::M
       return TypedValue(TypedValue::TMap(memory));
   }
 }
+// Returns true if an operator keeping its state in `memory` should move some
+// of it to disk.
+bool ShouldSpill(const utils::TrackingMemoryResource &memory, const ExecutionContext &context) {
+  return context.spill.threshold && memory.GetAllocatedBytes() > *context.spill.threshold;
+}
 }  // namespace
 
 class AggregateCursor : public Cursor {
  public:
   AggregateCursor(const Aggregate &self, utils::MemoryResource *mem)
-      : self_(self), input_cursor_(self_.input_->MakeCursor(mem)), aggregation_(mem) {}
+      : self_(self),
+        input_cursor_(self_.input_->MakeCursor(mem)),
+        aggregation_(&memory_),
+        row_(&memory_),
+        inputs_(&memory_) {}
 
   bool Pull(Frame &frame, ExecutionContext &context) override {
     SCOPED_PROFILE_OP("Aggregate");
 
+    memory_.SetParent(context.memory_tracker);
+
+    if (self_.grouped_input_) return PullGrouped(frame, context);
+
     if (!pulled_all_input_) {
       ProcessAll(&frame, &context);
       pulled_all_input_ = true;
@@ -2639,17 +2679,13 @@ class AggregateCursor : public Cursor {
       }
     }
 
-    if (aggregation_it_ == aggregation_.end()) return false;
-
-    // place aggregation values on the frame
-    auto aggregation_values_it = aggregation_it_->second.values_.begin();
-    for (const auto &aggregation_elem : self_.aggregations_)
-      frame[aggregation_elem.output_sym] = *aggregation_values_it++;
-
-    // place remember values on the frame
-    auto remember_values_it = aggregation_it_->second.remember_.begin();
-    for (const Symbol &remember_sym : self_.remember_) frame[remember_sym] = *remember_values_it++;
+    // the groups which didn't fit in memory are aggregated once the groups in
+    // memory are exhausted
+    while (aggregation_it_ == aggregation_.end()) {
+      if (!ProcessNextPartition(&context)) return false;
+    }
 
+    PlaceOnFrame(aggregation_it_->second, &frame);
     aggregation_it_++;
     return true;
   }
@@ -2661,6 +2697,10 @@ class AggregateCursor : public Cursor {
     aggregation_.clear();
     aggregation_it_ = aggregation_.begin();
     pulled_all_input_ = false;
+    overflow_.reset();
+    pending_partitions_.clear();
+    level_ = 0;
+    group_.reset();
   }
 
  private:
@@ -2686,6 +2726,10 @@ class AggregateCursor : public Cursor {
 
   const Aggregate &self_;
   const UniqueCursorPtr input_cursor_;
+  // The aggregated data is kept in its own memory, so that the memory can be
+  // measured and reused between the passes over the spilled partitions.
+  utils::PoolResource pool_memory_{128, 1024};
+  utils::TrackingMemoryResource memory_{&pool_memory_};
   // storage for aggregated data
   // map key is the vector of group-by values
   // map value is an AggregationValue struct
@@ -2701,6 +2745,19 @@ class AggregateCursor : public Cursor {
   // this LogicalOp pulls all from the input on it's first pull
   // this switch tracks if this has been performed
   bool pulled_all_input_{false};
+  // partitioning level of the rows being aggregated
+  uint64_t level_{0};
+  // Rows of the groups which didn't fit in memory in the current pass. Each
+  // row holds the group-by values, the aggregation inputs and the remember
+  // values.
+  std::optional<SpillPartitions> overflow_;
+  // partitions waiting for their pass, with their partitioning level
+  std::vector<std::pair<std::unique_ptr<SpillFile>, uint64_t>> pending_partitions_;
+  // buffers for the rows read from the partitions
+  utils::pmr::vector<TypedValue> row_;
+  utils::pmr::vector<TypedValue> inputs_;
+  // the group being aggregated when the input is grouped
+  std::optional<std::pair<utils::pmr::vector<TypedValue>, AggregationValue>> group_;
 
   /**
    * Pulls from the input operator until exhausted and aggregates the
@@ -2715,69 +2772,232 @@ class AggregateCursor : public Cursor {
     ExpressionEvaluator evaluator(frame, context->symbol_table, context->evaluation_context, context->db_accessor,
                                   storage::View::NEW);
     while (input_cursor_->Pull(*frame, *context)) {
-      ProcessOne(*frame, &evaluator);
-    }
-
-    // calculate AVG aggregations (so far they have only been summed)
-    for (size_t pos = 0; pos < self_.aggregations_.size(); ++pos) {
-      if (self_.aggregations_[pos].op != Aggregation::Op::AVG) continue;
-      for (auto &kv : aggregation_) {
-        AggregationValue &agg_value = kv.second;
-        auto count = agg_value.counts_[pos];
-        auto *pull_memory = context->evaluation_context.memory;
-        if (count > 0) {
-          agg_value.values_[pos] = agg_value.values_[pos] / TypedValue(static_cast<double>(count), pull_memory);
-        }
-      }
+      ProcessOne(*frame, &evaluator, context);
     }
+    FinishAggregation(context->evaluation_context.memory);
   }
 
   /**
    * Performs a single accumulation.
    */
-  void ProcessOne(const Frame &frame, ExpressionEvaluator *evaluator) {
-    auto *mem = aggregation_.get_allocator().GetMemoryResource();
-    utils::pmr::vector<TypedValue> group_by(mem);
+  void ProcessOne(const Frame &frame, ExpressionEvaluator *evaluator, ExecutionContext *context) {
+    auto group_by = EvaluateGroupBy(evaluator);
+    // The inputs are evaluated up front, so that they can be written to disk
+    // when the group doesn't fit in memory.
+    auto inputs = EvaluateInputs(evaluator, context->evaluation_context.memory);
+    utils::pmr::vector<TypedValue> remember(&memory_);
+    AggregateRow(std::move(group_by), inputs,
+                 [&]() -> const utils::pmr::vector<TypedValue> & {
+                   remember.reserve(self_.remember_.size());
+                   for (const Symbol &remember_sym : self_.remember_) remember.push_back(frame[remember_sym]);
+                   return remember;
+                 },
+                 *context);
+  }
+
+  /**
+   * Evaluates the group-by expressions for the current row.
+   */
+  utils::pmr::vector<TypedValue> EvaluateGroupBy(ExpressionEvaluator *evaluator) {
+    utils::pmr::vector<TypedValue> group_by(&memory_);
     group_by.reserve(self_.group_by_.size());
     for (Expression *expression : self_.group_by_) {
       group_by.emplace_back(expression->Accept(*evaluator));
     }
-    auto &agg_value = aggregation_.try_emplace(std::move(group_by), mem).first->second;
-    EnsureInitialized(frame, &agg_value);
-    Update(evaluator, &agg_value);
+    return group_by;
+  }
+
+  /**
+   * Evaluates the value and the key of each aggregation for the current row.
+   */
+  utils::pmr::vector<TypedValue> EvaluateInputs(ExpressionEvaluator *evaluator, utils::MemoryResource *memory) const {
+    utils::pmr::vector<TypedValue> inputs(memory);
+    inputs.reserve(2 * self_.aggregations_.size());
+    for (const auto &agg_elem : self_.aggregations_) {
+      // COUNT(*) is the only case where input expression is optional
+      if (!agg_elem.value) {
+        inputs.emplace_back();
+        inputs.emplace_back();
+        continue;
+      }
+      auto input_value = agg_elem.value->Accept(*evaluator);
+      // The key of COLLECT_MAP is only evaluated for non-Null values.
+      const bool has_key = agg_elem.key && !input_value.IsNull();
+      inputs.emplace_back(std::move(input_value));
+      inputs.emplace_back(has_key ? agg_elem.key->Accept(*evaluator) : TypedValue());
+    }
+    return inputs;
+  }
+
+  /**
+   * Aggregates the input which produces the rows of each group consecutively.
+   * A group is finished and emitted once the first row of the next group is
+   * pulled, so only a single group is kept in memory.
+   */
+  bool PullGrouped(Frame &frame, ExecutionContext &context) {
+    DMG_ASSERT(!self_.group_by_.empty(), "Grouped input requires group-by expressions");
+    ExpressionEvaluator evaluator(&frame, context.symbol_table, context.evaluation_context, context.db_accessor,
+                                  storage::View::NEW);
+    auto *pull_memory = context.evaluation_context.memory;
+    while (!pulled_all_input_) {
+      if (!input_cursor_->Pull(frame, context)) {
+        pulled_all_input_ = true;
+        break;
+      }
+      auto group_by = EvaluateGroupBy(&evaluator);
+      auto inputs = EvaluateInputs(&evaluator, pull_memory);
+      if (group_ && TypedValueVectorEqual{}(group_->first, group_by)) {
+        Update(inputs, &group_->second);
+        continue;
+      }
+
+      auto finished_group = std::move(group_);
+      group_.emplace(std::move(group_by), AggregationValue(&memory_));
+      utils::pmr::vector<TypedValue> remember(&memory_);
+      remember.reserve(self_.remember_.size());
+      for (const Symbol &remember_sym : self_.remember_) remember.push_back(frame[remember_sym]);
+      Initialize(remember, &group_->second);
+      Update(inputs, &group_->second);
+      // The new group is started from the values on the frame, so the
+      // finished group is placed on the frame only afterwards.
+      if (finished_group) {
+        FinishAggregation(&finished_group->second, pull_memory);
+        PlaceOnFrame(finished_group->second, &frame);
+        return true;
+      }
+    }
+
+    if (!group_) return false;
+    FinishAggregation(&group_->second, pull_memory);
+    PlaceOnFrame(group_->second, &frame);
+    group_.reset();
+    return true;
+  }
+
+  void PlaceOnFrame(const AggregationValue &agg_value, Frame *frame) const {
+    // place aggregation values on the frame
+    auto aggregation_values_it = agg_value.values_.begin();
+    for (const auto &aggregation_elem : self_.aggregations_)
+      (*frame)[aggregation_elem.output_sym] = *aggregation_values_it++;
+
+    // place remember values on the frame
+    auto remember_values_it = agg_value.remember_.begin();
+    for (const Symbol &remember_sym : self_.remember_) (*frame)[remember_sym] = *remember_values_it++;
+  }
+
+  /**
+   * Aggregates the row into its group, or writes the row to disk if the group
+   * isn't in memory and there is no more memory for it. Once a row is written
+   * to disk, the rest of the new groups in the pass are written to disk too,
+   * so that each group is aggregated in a single pass. The remember values
+   * are only needed for new groups, so they are obtained with
+   * `get_remember`.
+   */
+  template <class TGetRemember>
+  void AggregateRow(utils::pmr::vector<TypedValue> group_by, const utils::pmr::vector<TypedValue> &inputs,
+                    const TGetRemember &get_remember, const ExecutionContext &context) {
+    auto agg_it = aggregation_.find(group_by);
+    if (agg_it == aggregation_.end()) {
+      if (overflow_ || (ShouldSpill(memory_, context) && !aggregation_.empty())) {
+        if (!overflow_) overflow_.emplace(context.spill.directory, level_);
+        overflow_->WriteRow(aggregation_.hash_function()(group_by), group_by, inputs, get_remember());
+        return;
+      }
+      agg_it = aggregation_.emplace(std::move(group_by), AggregationValue(&memory_)).first;
+      Initialize(get_remember(), &agg_it->second);
+    }
+    Update(inputs, &agg_it->second);
   }
 
-  /** Ensures the new AggregationValue has been initialized. This means
-   * that the value vectors are filled with an appropriate number of Nulls,
-   * counts are set to 0 and remember values are remembered.
+  /**
+   * Aggregates the rows of the next partition written to disk, replacing the
+   * groups in memory. Returns false if there are no more partitions.
    */
-  void EnsureInitialized(const Frame &frame, AggregateCursor::AggregationValue *agg_value) const {
-    if (!agg_value->values_.empty()) return;
+  bool ProcessNextPartition(ExecutionContext *context) {
+    if (overflow_) {
+      const auto next_level = overflow_->level() + 1;
+      for (auto &partition : std::move(*overflow_).Release()) {
+        pending_partitions_.emplace_back(std::move(partition), next_level);
+      }
+      overflow_.reset();
+    }
+    if (pending_partitions_.empty()) return false;
+
+    auto [partition, level] = std::move(pending_partitions_.back());
+    pending_partitions_.pop_back();
+    level_ = level;
+    // The map is replaced instead of cleared, so that its buckets are freed.
+    decltype(aggregation_)(aggregation_.get_allocator()).swap(aggregation_);
+
+    const auto group_by_size = self_.group_by_.size();
+    const auto inputs_size = 2 * self_.aggregations_.size();
+    while (partition->ReadRow(&row_)) {
+      if (MustAbort(*context)) throw HintedAbortError();
+      const auto inputs_begin = row_.begin() + group_by_size;
+      const auto inputs_end = inputs_begin + inputs_size;
+      utils::pmr::vector<TypedValue> group_by(std::make_move_iterator(row_.begin()),
+                                              std::make_move_iterator(inputs_begin), &memory_);
+      inputs_.assign(std::make_move_iterator(inputs_begin), std::make_move_iterator(inputs_end));
+      // The remember values are left at the end of the row.
+      row_.erase(row_.begin(), inputs_end);
+      AggregateRow(std::move(group_by), inputs_, [this]() -> const utils::pmr::vector<TypedValue> & { return row_; },
+                   *context);
+    }
+    FinishAggregation(context->evaluation_context.memory);
+    aggregation_it_ = aggregation_.begin();
+    return true;
+  }
 
+  /** Calculates the AVG aggregations of the groups in memory, so far they
+   * have only been summed. */
+  void FinishAggregation(utils::MemoryResource *pull_memory) {
+    for (auto &kv : aggregation_) FinishAggregation(&kv.second, pull_memory);
+  }
+
+  void FinishAggregation(AggregationValue *agg_value, utils::MemoryResource *pull_memory) const {
+    for (size_t pos = 0; pos < self_.aggregations_.size(); ++pos) {
+      if (self_.aggregations_[pos].op != Aggregation::Op::AVG) continue;
+      auto count = agg_value->counts_[pos];
+      if (count > 0) {
+        agg_value->values_[pos] = agg_value->values_[pos] / TypedValue(static_cast<double>(count), pull_memory);
+      }
+    }
+  }
+
+  /** Initializes the new AggregationValue. This means that the value vectors
+   * are filled with an appropriate number of Nulls, counts are set to 0 and
+   * remember values are remembered.
+   */
+  void Initialize(const utils::pmr::vector<TypedValue> &remember, AggregateCursor::AggregationValue *agg_value) const {
     for (const auto &agg_elem : self_.aggregations_) {
       auto *mem = agg_value->values_.get_allocator().GetMemoryResource();
       agg_value->values_.emplace_back(DefaultAggregationOpValue(agg_elem, mem));
     }
     agg_value->counts_.resize(self_.aggregations_.size(), 0);
 
-    for (const Symbol &remember_sym : self_.remember_) agg_value->remember_.push_back(frame[remember_sym]);
+    agg_value->remember_.assign(remember.begin(), remember.end());
   }
 
-  /** Updates the given AggregationValue with new data. Assumes that
-   * the AggregationValue has been initialized */
-  void Update(ExpressionEvaluator *evaluator, AggregateCursor::AggregationValue *agg_value) {
+  /** Updates the given AggregationValue with the evaluated inputs of a row,
+   * which are the value and the key of each aggregation. Assumes that the
+   * AggregationValue has been initialized */
+  void Update(const utils::pmr::vector<TypedValue> &inputs, AggregateCursor::AggregationValue *agg_value) {
     DMG_ASSERT(self_.aggregations_.size() == agg_value->values_.size(),
                "Expected as much AggregationValue.values_ as there are "
                "aggregations.");
     DMG_ASSERT(self_.aggregations_.size() == agg_value->counts_.size(),
                "Expected as much AggregationValue.counts_ as there are "
                "aggregations.");
+    DMG_ASSERT(2 * self_.aggregations_.size() == inputs.size(),
+               "Expected a value and a key input for each aggregation.");
 
-    // we iterate over counts, values and aggregation info at the same time
+    // we iterate over counts, values, inputs and aggregation info at the same
+    // time
     auto count_it = agg_value->counts_.begin();
     auto value_it = agg_value->values_.begin();
+    auto input_it = inputs.begin();
     auto agg_elem_it = self_.aggregations_.begin();
-    for (; count_it < agg_value->counts_.end(); count_it++, value_it++, agg_elem_it++) {
+    for (; count_it < agg_value->counts_.end(); count_it++, value_it++, input_it += 2, agg_elem_it++) {
       // COUNT(*) is the only case where input expression is optional
       // handle it here
       auto input_expr_ptr = agg_elem_it->value;
@@ -2787,7 +3007,8 @@ class AggregateCursor : public Cursor {
         continue;
       }
 
-      TypedValue input_value = input_expr_ptr->Accept(*evaluator);
+      const TypedValue &input_value = *input_it;
+      const TypedValue &key = *(input_it + 1);
 
       // Aggregations skip Null input values.
       if (input_value.IsNull()) continue;
@@ -2813,7 +3034,6 @@ class AggregateCursor : public Cursor {
             value_it->ValueList().push_back(input_value);
             break;
           case Aggregation::Op::COLLECT_MAP:
-            auto key = agg_elem_it->key->Accept(*evaluator);
             if (key.type() != TypedValue::Type::String) throw QueryRuntimeException("Map key must be a string.");
             value_it->ValueMap().emplace(key.ValueString(), input_value);
             break;
@@ -2861,7 +3081,6 @@ class AggregateCursor : public Cursor {
           value_it->ValueList().push_back(input_value);
           break;
         case Aggregation::Op::COLLECT_MAP:
-          auto key = agg_elem_it->key->Accept(*evaluator);
           if (key.type() != TypedValue::Type::String) throw QueryRuntimeException("Map key must be a string.");
           value_it->ValueMap().emplace(key.ValueString(), input_value);
           break;
@@ -3013,8 +3232,8 @@ void Limit::LimitCursor::Reset() {
 }
 
 OrderBy::OrderBy(const std::shared_ptr<LogicalOperator> &input, const std::vector<SortItem> &order_by,
-                 const std::vector<Symbol> &output_symbols)
-    : input_(input), output_symbols_(output_symbols) {
+                 const std::vector<Symbol> &output_symbols, Expression *skip, Expression *limit)
+    : input_(input), output_symbols_(output_symbols), skip_(skip), limit_(limit) {
   // split the order_by vector into two vectors of orderings and expressions
   std::vector<Ordering> ordering;
   ordering.reserve(order_by.size());
@@ -3038,49 +3257,79 @@ std::vector<Symbol> OrderBy::ModifiedSymbols(const SymbolTable &table) const { r
 class OrderByCursor : public Cursor {
  public:
   OrderByCursor(const OrderBy &self, utils::MemoryResource *mem)
-      : self_(self), input_cursor_(self_.input_->MakeCursor(mem)), cache_(mem) {}
+      : self_(self), input_cursor_(self_.input_->MakeCursor(mem)), cache_(&memory_), row_(&memory_) {}
 
   bool Pull(Frame &frame, ExecutionContext &context) override {
     SCOPED_PROFILE_OP("OrderBy");
 
+    memory_.SetParent(context.memory_tracker);
+
     if (!did_pull_all_) {
       ExpressionEvaluator evaluator(&frame, context.symbol_table, context.evaluation_context, context.db_accessor,
                                     storage::View::OLD);
       auto *mem = cache_.get_allocator().GetMemoryResource();
-      while (input_cursor_->Pull(frame, context)) {
-        // collect the order_by elements
-        utils::pmr::vector<TypedValue> order_by(mem);
-        order_by.reserve(self_.order_by_.size());
-        for (auto expression_ptr : self_.order_by_) {
-          order_by.emplace_back(expression_ptr->Accept(evaluator));
-        }
+      auto compare = [this](const auto &pair1, const auto &pair2) {
+        return self_.compare_(pair1.order_by, pair2.order_by);
+      };
+      const auto top_k = EvaluateTopK(evaluator);
+      // With a bound on the number of needed rows the cache is kept as a max
+      // heap, so the worst of the kept rows is always at the front.
+      if (!top_k || *top_k > 0) {
+        while (input_cursor_->Pull(frame, context)) {
+          // collect the order_by elements
+          utils::pmr::vector<TypedValue> order_by(mem);
+          order_by.reserve(self_.order_by_.size());
+          for (auto expression_ptr : self_.order_by_) {
+            order_by.emplace_back(expression_ptr->Accept(evaluator));
+          }
 
-        // collect the output elements
-        utils::pmr::vector<TypedValue> output(mem);
-        output.reserve(self_.output_symbols_.size());
-        for (const Symbol &output_sym : self_.output_symbols_) output.emplace_back(frame[output_sym]);
+          const bool heap_full = top_k && cache_.size() >= *top_k;
+          // Rows which wouldn't make it into the top k are dropped before
+          // copying their output elements.
+          if (heap_full && !self_.compare_(order_by, cache_.front().order_by)) continue;
 
-        cache_.push_back(Element{std::move(order_by), std::move(output)});
+          // collect the output elements
+          utils::pmr::vector<TypedValue> output(mem);
+          output.reserve(self_.output_symbols_.size());
+          for (const Symbol &output_sym : self_.output_symbols_) output.emplace_back(frame[output_sym]);
+
+          if (!top_k) {
+            cache_.push_back(Element{std::move(order_by), std::move(output)});
+            if (ShouldSpill(memory_, context)) SpillCache(context);
+            continue;
+          }
+          if (heap_full) {
+            // Evict the worst row right away, so that its values are freed.
+            std::pop_heap(cache_.begin(), cache_.end(), compare);
+            cache_.pop_back();
+          }
+          cache_.push_back(Element{std::move(order_by), std::move(output)});
+          std::push_heap(cache_.begin(), cache_.end(), compare);
+        }
       }
 
-      std::sort(cache_.begin(), cache_.end(), [this](const auto &pair1, const auto &pair2) {
-        return self_.compare_(pair1.order_by, pair2.order_by);
-      });
+      if (top_k) {
+        std::sort_heap(cache_.begin(), cache_.end(), compare);
+      } else if (runs_.empty()) {
+        std::sort(cache_.begin(), cache_.end(), compare);
+      } else {
+        // Some of the rows are on disk, so all of them are merged from the
+        // sorted runs.
+        if (!cache_.empty()) SpillCache(context);
+        MergeRuns(context);
+      }
 
       did_pull_all_ = true;
       cache_it_ = cache_.begin();
     }
 
+    if (merging_) return PullMerged(frame, context);
+
     if (cache_it_ == cache_.end()) return false;
 
     if (MustAbort(context)) throw HintedAbortError();
 
-    // place the output values on the frame
-    DMG_ASSERT(self_.output_symbols_.size() == cache_it_->remember.size(),
-               "Number of values does not match the number of output symbols "
-               "in OrderBy");
-    auto output_sym_it = self_.output_symbols_.begin();
-    for (const TypedValue &output : cache_it_->remember) frame[*output_sym_it++] = output;
+    PlaceOnFrame(cache_it_->remember, &frame);
 
     cache_it_++;
     return true;
@@ -3092,6 +3341,9 @@ class OrderByCursor : public Cursor {
     did_pull_all_ = false;
     cache_.clear();
     cache_it_ = cache_.begin();
+    runs_.clear();
+    merge_heap_.clear();
+    merging_ = false;
   }
 
  private:
@@ -3100,14 +3352,151 @@ class OrderByCursor : public Cursor {
     utils::pmr::vector<TypedValue> remember;
   };
 
+  // A sorted run which is being merged, together with its smallest row which
+  // hasn't been merged yet.
+  struct MergeSource {
+    std::unique_ptr<SpillFile> run;
+    Element element;
+  };
+
+  // Returns the number of rows needed by the following Skip and Limit, or
+  // std::nullopt if all of the rows need to be sorted. Invalid skip and limit
+  // values don't bound the sort, they are reported by the Skip and Limit
+  // operators themselves.
+  std::optional<uint64_t> EvaluateTopK(ExpressionEvaluator &evaluator) const {
+    if (!self_.limit_) return std::nullopt;
+    auto evaluate_count = [&evaluator](Expression *expression) -> std::optional<uint64_t> {
+      if (!expression) return 0;
+      auto value = expression->Accept(evaluator);
+      if (value.type() != TypedValue::Type::Int || value.ValueInt() < 0) return std::nullopt;
+      return value.ValueInt();
+    };
+    auto skip = evaluate_count(self_.skip_);
+    auto limit = evaluate_count(self_.limit_);
+    if (!skip || !limit) return std::nullopt;
+    if (*skip > std::numeric_limits<uint64_t>::max() - *limit) return std::nullopt;
+    return *skip + *limit;
+  }
+
+  void PlaceOnFrame(const utils::pmr::vector<TypedValue> &remember, Frame *frame) const {
+    DMG_ASSERT(self_.output_symbols_.size() == remember.size(),
+               "Number of values does not match the number of output symbols "
+               "in OrderBy");
+    auto output_sym_it = self_.output_symbols_.begin();
+    for (const TypedValue &output : remember) (*frame)[*output_sym_it++] = output;
+  }
+
+  // Sorts the cached rows and writes them to disk as a new sorted run.
+  void SpillCache(const ExecutionContext &context) {
+    std::sort(cache_.begin(), cache_.end(),
+              [this](const auto &pair1, const auto &pair2) { return self_.compare_(pair1.order_by, pair2.order_by); });
+    auto run = std::make_unique<SpillFile>(context.spill.directory);
+    for (const auto &element : cache_) run->WriteRow(element.order_by, element.remember);
+    runs_.push_back(std::move(run));
+    cache_.clear();
+    cache_.shrink_to_fit();
+  }
+
+  // Reads the next row of the run into `element`. Returns false at the end of
+  // the run.
+  bool ReadElement(SpillFile *run, Element *element) {
+    if (!run->ReadRow(&row_)) return false;
+    const auto order_by_end = row_.begin() + self_.order_by_.size();
+    element->order_by.assign(std::make_move_iterator(row_.begin()), std::make_move_iterator(order_by_end));
+    element->remember.assign(std::make_move_iterator(order_by_end), std::make_move_iterator(row_.end()));
+    return true;
+  }
+
+  // std heap functions keep the largest element at the front, so the
+  // comparison is reversed to get the smallest row.
+  auto MergeCompare() const {
+    return [this](const MergeSource &a, const MergeSource &b) {
+      return self_.compare_(b.element.order_by, a.element.order_by);
+    };
+  }
+
+  // Starts merging the given runs, the smallest row is then at the front of
+  // `merge_heap_`.
+  template <class TIterator>
+  void StartMerge(TIterator begin, TIterator end) {
+    merge_heap_.clear();
+    for (auto it = begin; it != end; ++it) {
+      MergeSource source{std::move(*it), Element{utils::pmr::vector<TypedValue>(&memory_),
+                                                 utils::pmr::vector<TypedValue>(&memory_)}};
+      if (ReadElement(source.run.get(), &source.element)) merge_heap_.push_back(std::move(source));
+    }
+    std::make_heap(merge_heap_.begin(), merge_heap_.end(), MergeCompare());
+  }
+
+  // Moves the smallest row to the back of `merge_heap_`. The row needs to be
+  // consumed before calling `AdvanceMerge`.
+  void PopMerged() { std::pop_heap(merge_heap_.begin(), merge_heap_.end(), MergeCompare()); }
+
+  void AdvanceMerge() {
+    auto &source = merge_heap_.back();
+    if (ReadElement(source.run.get(), &source.element)) {
+      std::push_heap(merge_heap_.begin(), merge_heap_.end(), MergeCompare());
+    } else {
+      merge_heap_.pop_back();
+    }
+  }
+
+  // Merges the sorted runs in multiple passes, until there are few enough of
+  // them to be merged at once while streaming the rows out.
+  void MergeRuns(ExecutionContext &context) {
+    while (runs_.size() > kSpillMergeFanIn) {
+      std::vector<std::unique_ptr<SpillFile>> merged_runs;
+      for (size_t begin = 0; begin < runs_.size(); begin += kSpillMergeFanIn) {
+        const auto end = std::min<size_t>(begin + kSpillMergeFanIn, runs_.size());
+        StartMerge(runs_.begin() + begin, runs_.begin() + end);
+        auto merged_run = std::make_unique<SpillFile>(context.spill.directory);
+        while (!merge_heap_.empty()) {
+          if (MustAbort(context)) throw HintedAbortError();
+          PopMerged();
+          const auto &element = merge_heap_.back().element;
+          merged_run->WriteRow(element.order_by, element.remember);
+          AdvanceMerge();
+        }
+        merged_runs.push_back(std::move(merged_run));
+      }
+      runs_ = std::move(merged_runs);
+    }
+    StartMerge(runs_.begin(), runs_.end());
+    runs_.clear();
+    merging_ = true;
+  }
+
+  bool PullMerged(Frame &frame, ExecutionContext &context) {
+    if (merge_heap_.empty()) return false;
+
+    if (MustAbort(context)) throw HintedAbortError();
+
+    PopMerged();
+    PlaceOnFrame(merge_heap_.back().element.remember, &frame);
+    AdvanceMerge();
+    return true;
+  }
+
   const OrderBy &self_;
   const UniqueCursorPtr input_cursor_;
   bool did_pull_all_{false};
+  // The cached rows are kept in their own memory, so that the memory can be
+  // measured and reused once the rows are spilled to disk.
+  utils::PoolResource pool_memory_{128, 1024};
+  utils::TrackingMemoryResource memory_{&pool_memory_};
   // a cache of elements pulled from the input
   // the cache is filled and sorted (only on first elem) on first Pull
   utils::pmr::vector<Element> cache_;
   // iterator over the cache_, maintains state between Pulls
   decltype(cache_.begin()) cache_it_ = cache_.begin();
+  // sorted runs of rows which didn't fit in memory
+  std::vector<std::unique_ptr<SpillFile>> runs_;
+  // the runs which are being merged, ordered as a heap by `MergeCompare`
+  std::vector<MergeSource> merge_heap_;
+  // true when the output rows come from `merge_heap_` instead of `cache_`
+  bool merging_{false};
+  // buffer for the rows read from the runs
+  utils::pmr::vector<TypedValue> row_;
 };
 
 UniqueCursorPtr OrderBy::MakeCursor(utils::MemoryResource *mem) const {
@@ -3346,19 +3735,25 @@ UniqueCursorPtr Unwind::MakeCursor(utils::MemoryResource *mem) const {
 class DistinctCursor : public Cursor {
  public:
   DistinctCursor(const Distinct &self, utils::MemoryResource *mem)
-      : self_(self), input_cursor_(self.input_->MakeCursor(mem)), seen_rows_(mem) {}
+      : self_(self), input_cursor_(self.input_->MakeCursor(mem)), seen_rows_(&memory_) {}
 
   bool Pull(Frame &frame, ExecutionContext &context) override {
     SCOPED_PROFILE_OP("Distinct");
 
-    while (true) {
-      if (!input_cursor_->Pull(frame, context)) return false;
+    memory_.SetParent(context.memory_tracker);
 
-      utils::pmr::vector<TypedValue> row(seen_rows_.get_allocator().GetMemoryResource());
+    if (merging_) return PullMerged(frame, context);
+
+    while (input_cursor_->Pull(frame, context)) {
+      utils::pmr::vector<TypedValue> row(&memory_);
       row.reserve(self_.value_symbols_.size());
       for (const auto &symbol : self_.value_symbols_) row.emplace_back(frame[symbol]);
-      if (seen_rows_.insert(std::move(row)).second) return true;
+      // The values of the row are already on the frame.
+      if (Insert(std::move(row), input_row_count_++, context)) return true;
     }
+    if (!overflow_) return false;
+    ProcessPartitions(context);
+    return PullMerged(frame, context);
   }
 
   void Shutdown() override { input_cursor_->Shutdown(); }
@@ -3366,11 +3761,158 @@ class DistinctCursor : public Cursor {
   void Reset() override {
     input_cursor_->Reset();
     seen_rows_.clear();
+    input_row_count_ = 0;
+    overflow_.reset();
+    pending_partitions_.clear();
+    partition_.reset();
+    level_ = 0;
+    runs_.clear();
+    merge_heap_.clear();
+    merging_ = false;
   }
 
  private:
+  // A run of the first occurrences of the deferred rows which is being merged,
+  // together with its next row. The last value of the rows in the runs and in
+  // the partitions is the position of the row in the input.
+  struct MergeSource {
+    std::unique_ptr<SpillFile> run;
+    utils::pmr::vector<TypedValue> row;
+  };
+
+  // Remembers the row if it wasn't seen yet and returns the remembered row.
+  // Once there is no more memory for new rows, all of the rows which aren't
+  // seen yet are deferred to a later pass, together with their `position`.
+  // So each row is either remembered in this pass or written to disk, never
+  // both.
+  const utils::pmr::vector<TypedValue> *Insert(utils::pmr::vector<TypedValue> &&row, uint64_t position,
+                                               const ExecutionContext &context) {
+    if (seen_rows_.contains(row)) return nullptr;
+    if (overflow_ || (ShouldSpill(memory_, context) && !seen_rows_.empty())) {
+      if (!overflow_) overflow_.emplace(context.spill.directory, level_);
+      overflow_->WriteRow(seen_rows_.hash_function()(row), row,
+                          std::array{TypedValue(static_cast<int64_t>(position))});
+      return nullptr;
+    }
+    return &*seen_rows_.insert(std::move(row)).first;
+  }
+
+  // Starts reading the next partition written to disk. Rows of different
+  // partitions are different, so the seen rows are forgotten. Returns false
+  // if there are no more partitions.
+  bool StartNextPartition() {
+    if (overflow_) {
+      const auto next_level = overflow_->level() + 1;
+      for (auto &partition : std::move(*overflow_).Release()) {
+        pending_partitions_.emplace_back(std::move(partition), next_level);
+      }
+      overflow_.reset();
+    }
+    // The set is replaced instead of cleared, so that its buckets are freed.
+    decltype(seen_rows_)(seen_rows_.get_allocator()).swap(seen_rows_);
+    if (pending_partitions_.empty()) {
+      partition_.reset();
+      return false;
+    }
+    std::tie(partition_, level_) = std::move(pending_partitions_.back());
+    pending_partitions_.pop_back();
+    return true;
+  }
+
+  // Finds the first occurrences of the deferred rows with a pass over each of
+  // the partitions, and starts merging them by their position in the input,
+  // so that the rows are yielded in the input order. All of the deferred rows
+  // come after the rows which were already yielded.
+  void ProcessPartitions(ExecutionContext &context) {
+    utils::pmr::vector<TypedValue> row(&memory_);
+    while (StartNextPartition()) {
+      // The partition is written in the input order, so the rows of the run
+      // are sorted by their position.
+      auto run = std::make_unique<SpillFile>(context.spill.directory);
+      while (partition_->ReadRow(&row)) {
+        if (MustAbort(context)) throw HintedAbortError();
+        const auto position = row.back().ValueInt();
+        row.pop_back();
+        if (const auto *inserted = Insert(std::move(row), position, context)) {
+          run->WriteRow(*inserted, std::array{TypedValue(position)});
+        }
+      }
+      if (run->row_count() > 0) runs_.push_back(std::move(run));
+    }
+    MergeRuns(context);
+  }
+
+  // std heap functions keep the largest element at the front, so the
+  // comparison is reversed to get the row with the smallest position.
+  static bool MergeCompare(const MergeSource &a, const MergeSource &b) {
+    return a.row.back().ValueInt() > b.row.back().ValueInt();
+  }
+
+  template <class TIterator>
+  void StartMerge(TIterator begin, TIterator end) {
+    merge_heap_.clear();
+    for (auto it = begin; it != end; ++it) {
+      MergeSource source{std::move(*it), utils::pmr::vector<TypedValue>(&memory_)};
+      if (source.run->ReadRow(&source.row)) merge_heap_.push_back(std::move(source));
+    }
+    std::make_heap(merge_heap_.begin(), merge_heap_.end(), MergeCompare);
+  }
+
+  // Moves the row with the smallest position to the back of `merge_heap_`. The
+  // row needs to be consumed before calling `AdvanceMerge`.
+  void PopMerged() { std::pop_heap(merge_heap_.begin(), merge_heap_.end(), MergeCompare); }
+
+  void AdvanceMerge() {
+    auto &source = merge_heap_.back();
+    if (source.run->ReadRow(&source.row)) {
+      std::push_heap(merge_heap_.begin(), merge_heap_.end(), MergeCompare);
+    } else {
+      merge_heap_.pop_back();
+    }
+  }
+
+  // Merges the runs in multiple passes, until there are few enough of them to
+  // be merged at once while streaming the rows out.
+  void MergeRuns(ExecutionContext &context) {
+    while (runs_.size() > kSpillMergeFanIn) {
+      std::vector<std::unique_ptr<SpillFile>> merged_runs;
+      for (size_t begin = 0; begin < runs_.size(); begin += kSpillMergeFanIn) {
+        const auto end = std::min<size_t>(begin + kSpillMergeFanIn, runs_.size());
+        StartMerge(runs_.begin() + begin, runs_.begin() + end);
+        auto merged_run = std::make_unique<SpillFile>(context.spill.directory);
+        while (!merge_heap_.empty()) {
+          if (MustAbort(context)) throw HintedAbortError();
+          PopMerged();
+          merged_run->WriteRow(merge_heap_.back().row);
+          AdvanceMerge();
+        }
+        merged_runs.push_back(std::move(merged_run));
+      }
+      runs_ = std::move(merged_runs);
+    }
+    StartMerge(runs_.begin(), runs_.end());
+    runs_.clear();
+    merging_ = true;
+  }
+
+  bool PullMerged(Frame &frame, ExecutionContext &context) {
+    if (merge_heap_.empty()) return false;
+
+    if (MustAbort(context)) throw HintedAbortError();
+
+    PopMerged();
+    const auto &row = merge_heap_.back().row;
+    for (size_t i = 0; i < self_.value_symbols_.size(); ++i) frame[self_.value_symbols_[i]] = row[i];
+    AdvanceMerge();
+    return true;
+  }
+
   const Distinct &self_;
   const UniqueCursorPtr input_cursor_;
+  // The seen rows are kept in their own memory, so that the memory can be
+  // measured and reused between the passes over the spilled partitions.
+  utils::PoolResource pool_memory_{128, 1024};
+  utils::TrackingMemoryResource memory_{&pool_memory_};
   // a set of already seen rows
   utils::pmr::unordered_set<utils::pmr::vector<TypedValue>,
                             // use FNV collection hashing specialized for a
@@ -3378,6 +3920,22 @@ class DistinctCursor : public Cursor {
                             utils::FnvCollection<utils::pmr::vector<TypedValue>, TypedValue, TypedValue::Hash>,
                             TypedValueVectorEqual>
       seen_rows_;
+  // number of the rows pulled from the input
+  uint64_t input_row_count_{0};
+  // partitioning level of the rows being read
+  uint64_t level_{0};
+  // rows deferred in the current pass
+  std::optional<SpillPartitions> overflow_;
+  // partitions waiting for their pass, with their partitioning level
+  std::vector<std::pair<std::unique_ptr<SpillFile>, uint64_t>> pending_partitions_;
+  // the partition being read
+  std::unique_ptr<SpillFile> partition_;
+  // first occurrences of the deferred rows, one run per pass over a partition
+  std::vector<std::unique_ptr<SpillFile>> runs_;
+  // the runs which are being merged, ordered as a heap by `MergeCompare`
+  std::vector<MergeSource> merge_heap_;
+  // true when the output rows come from `merge_heap_`
+  bool merging_{false};
 };
 
 Distinct::Distinct(const std::shared_ptr<LogicalOperator> &input, const std::vector<Symbol> &value_symbols)
@@ -3502,12 +4060,11 @@ class CartesianCursor : public Cursor {
     if (!cartesian_pull_initialized_) {
       // Pull all left_op frames.
       while (left_op_cursor_->Pull(frame, context)) {
-        left_op_frames_.emplace_back(frame.elems().begin(), frame.elems().end());
+        left_op_frames_.Append(frame, self_.left_symbols_);
       }
 
-      // We're setting the iterator to 'end' here so it pulls the right
-      // cursor.
-      left_op_frames_it_ = left_op_frames_.end();
+      // We're setting the row to 'end' here so it pulls the right cursor.
+      left_op_frames_row_ = left_op_frames_.size();
       cartesian_pull_initialized_ = true;
     }
 
@@ -3522,12 +4079,12 @@ class CartesianCursor : public Cursor {
       }
     };
 
-    if (left_op_frames_it_ == left_op_frames_.end()) {
+    if (left_op_frames_row_ == left_op_frames_.size()) {
       // Advance right_op_cursor_.
       if (!right_op_cursor_->Pull(frame, context)) return false;
 
       right_op_frame_.assign(frame.elems().begin(), frame.elems().end());
-      left_op_frames_it_ = left_op_frames_.begin();
+      left_op_frames_row_ = 0;
     } else {
       // Make sure right_op_cursor last pulled results are on frame.
       restore_frame(self_.right_symbols_, right_op_frame_);
@@ -3535,8 +4092,7 @@ class CartesianCursor : public Cursor {
 
     if (MustAbort(context)) throw HintedAbortError();
 
-    restore_frame(self_.left_symbols_, *left_op_frames_it_);
-    left_op_frames_it_++;
+    left_op_frames_.Load(left_op_frames_row_++, self_.left_symbols_, &frame);
     return true;
   }
 
@@ -3550,17 +4106,17 @@ class CartesianCursor : public Cursor {
     right_op_cursor_->Reset();
     right_op_frame_.clear();
     left_op_frames_.clear();
-    left_op_frames_it_ = left_op_frames_.end();
+    left_op_frames_row_ = 0;
     cartesian_pull_initialized_ = false;
   }
 
  private:
   const Cartesian &self_;
-  utils::pmr::vector<utils::pmr::vector<TypedValue>> left_op_frames_;
+  CompactRows left_op_frames_;
   utils::pmr::vector<TypedValue> right_op_frame_;
   const UniqueCursorPtr left_op_cursor_;
   const UniqueCursorPtr right_op_cursor_;
-  utils::pmr::vector<utils::pmr::vector<TypedValue>>::iterator left_op_frames_it_;
+  size_t left_op_frames_row_{0};
   bool cartesian_pull_initialized_{false};
 };
 
@@ -3695,15 +4251,14 @@ std::unordered_map<std::string, int64_t> CallProcedure::GetAndResetCounters() {
 
 namespace {
 
-void CallCustomProcedure(const std::string_view &fully_qualified_procedure_name, const mgp_proc &proc,
-                         const std::vector<Expression *> &args, mgp_graph &graph, ExpressionEvaluator *evaluator,
-                         utils::MemoryResource *memory, std::optional<size_t> memory_limit, mgp_result *result) {
+// Build and type check procedure arguments.
+void BuildProcedureArguments(const std::string_view &fully_qualified_procedure_name, const mgp_proc &proc,
+                             const std::vector<Expression *> &args, mgp_graph &graph, ExpressionEvaluator *evaluator,
+                             mgp_list *proc_args) {
   static_assert(std::uses_allocator_v<mgp_value, utils::Allocator<mgp_value>>,
                 "Expected mgp_value to use custom allocator and makes STL "
                 "containers aware of that");
-  // Build and type check procedure arguments.
-  mgp_list proc_args(memory);
-  proc_args.elems.reserve(args.size());
+  proc_args->elems.reserve(args.size());
   if (args.size() < proc.args.size() ||
       // Rely on `||` short circuit so we can avoid potential overflow of
       // proc.args.size() + proc.opt_args.size() by subtracting.
@@ -3734,21 +4289,28 @@ void CallCustomProcedure(const std::string_view &fully_qualified_procedure_name,
       throw QueryRuntimeException("'{}' argument named '{}' at position {} must be of type {}.",
                                   fully_qualified_procedure_name, name, i, type->GetPresentableName());
     }
-    proc_args.elems.emplace_back(std::move(arg), &graph);
+    proc_args->elems.emplace_back(std::move(arg), &graph);
   }
   // Fill missing optional arguments with their default values.
   MG_ASSERT(args.size() >= proc.args.size());
   size_t passed_in_opt_args = args.size() - proc.args.size();
   MG_ASSERT(passed_in_opt_args <= proc.opt_args.size());
   for (size_t i = passed_in_opt_args; i < proc.opt_args.size(); ++i) {
-    proc_args.elems.emplace_back(std::get<2>(proc.opt_args[i]), &graph);
+    proc_args->elems.emplace_back(std::get<2>(proc.opt_args[i]), &graph);
   }
+}
+
+void CallCustomProcedure(const std::string_view &fully_qualified_procedure_name, const mgp_proc &proc,
+                         const std::vector<Expression *> &args, mgp_graph &graph, ExpressionEvaluator *evaluator,
+                         utils::MemoryResource *memory, std::optional<size_t> memory_limit, mgp_result *result) {
+  mgp_list proc_args(memory);
+  BuildProcedureArguments(fully_qualified_procedure_name, proc, args, graph, evaluator, &proc_args);
+  MG_ASSERT(result->signature == &proc.results);
   if (memory_limit) {
     SPDLOG_INFO("Running '{}' with memory limit of {}", fully_qualified_procedure_name,
                 utils::GetReadableSize(*memory_limit));
     utils::LimitedMemoryResource limited_mem(memory, *memory_limit);
     mgp_memory proc_memory{&limited_mem};
-    MG_ASSERT(result->signature == &proc.results);
     // TODO: What about cross library boundary exceptions? OMG C++?!
     proc.cb(&proc_args, &graph, result, &proc_memory);
     size_t leaked_bytes = limited_mem.GetAllocatedBytes();
@@ -3759,20 +4321,55 @@ void CallCustomProcedure(const std::string_view &fully_qualified_procedure_name,
     // TODO: Add a tracking MemoryResource without limits, so that we report
     // memory leaks in procedure.
     mgp_memory proc_memory{memory};
-    MG_ASSERT(result->signature == &proc.results);
     // TODO: What about cross library boundary exceptions? OMG C++?!
     proc.cb(&proc_args, &graph, result, &proc_memory);
   }
 }
 
+// The maximum number of records a batched procedure yields in one invocation.
+constexpr size_t kProcedureBatchRows = 1024;
+
 }  // namespace
 
 class CallProcedureCursor : public Cursor {
+  // A call of a procedure which yields its results in batches. The call spans
+  // multiple `Pull` evaluations, so it keeps the arguments and the state of
+  // the procedure in memory of its own, which is tracked with the memory of
+  // the query and released when the call is done. The memory limit applies to
+  // the whole call: to the state, which is allocated by `init` and freed by
+  // `cleanup`, together with the memory of the batch which is running.
+  struct BatchCall {
+    BatchCall(utils::TrackingMemoryResource *memory_tracker, mgp_graph graph, std::optional<size_t> memory_limit,
+              uint64_t module_load_id)
+        : tracking_memory(utils::NewDeleteResource(), memory_tracker),
+          memory(128, 1024, &tracking_memory),
+          limited_memory(memory_limit
+                             ? std::optional<utils::LimitedMemoryResource>(std::in_place, &memory, *memory_limit)
+                             : std::nullopt),
+          call_memory{limited_memory ? static_cast<utils::MemoryResource *>(&*limited_memory) : &memory},
+          graph(graph),
+          args(&memory),
+          module_load_id(module_load_id) {}
+
+    utils::TrackingMemoryResource tracking_memory;
+    utils::PoolResource memory;
+    std::optional<utils::LimitedMemoryResource> limited_memory;
+    mgp_memory call_memory;
+    mgp_graph graph;
+    mgp_list args;
+    uint64_t module_load_id;
+    void *state{nullptr};
+  };
+
   const CallProcedure *self_;
   UniqueCursorPtr input_cursor_;
+  // Rows of the results are cleared after they are pulled, so the memory is
+  // pooled and reused for the next results instead of growing with each call.
+  utils::PoolResource rows_memory_;
   mgp_result result_;
   decltype(result_.rows.end()) result_row_it_{result_.rows.end()};
   size_t result_signature_size_{0};
+  std::optional<BatchCall> batch_call_;
 
  public:
   CallProcedureCursor(const CallProcedure *self, utils::MemoryResource *mem)
@@ -3781,10 +4378,19 @@ class CallProcedureCursor : public Cursor {
         // result_ needs to live throughout multiple Pull evaluations, until all
         // rows are produced. Therefore, we use the memory dedicated for the
         // whole execution.
-        result_(nullptr, mem) {
+        rows_memory_(128, 1024, mem),
+        result_(nullptr, &rows_memory_) {
     MG_ASSERT(self_->result_fields_.size() == self_->result_symbols_.size(), "Incorrectly constructed CallProcedure");
   }
 
+  ~CallProcedureCursor() override {
+    try {
+      AbortBatchCall();
+    } catch (const std::exception &e) {
+      spdlog::error("Failed to clean up the call of procedure '{}': {}", self_->procedure_name_, e.what());
+    }
+  }
+
   bool Pull(Frame &frame, ExecutionContext &context) override {
     SCOPED_PROFILE_OP("CallProcedure");
 
@@ -3796,10 +4402,14 @@ class CallProcedureCursor : public Cursor {
     // have procedures registering what they return.
     // This `while` loop will skip over empty results.
     while (result_row_it_ == result_.rows.end()) {
-      if (!input_cursor_->Pull(frame, context)) return false;
       result_.signature = nullptr;
       result_.rows.clear();
       result_.error_msg.reset();
+      if (batch_call_) {
+        PullBatch(context);
+        continue;
+      }
+      if (!input_cursor_->Pull(frame, context)) return false;
       // It might be a good idea to resolve the procedure name once, at the
       // start. Unfortunately, this could deadlock if we tried to invoke a
       // procedure from a module (read lock) and reload a module (write lock)
@@ -3824,13 +4434,17 @@ class CallProcedureCursor : public Cursor {
                                     graph_view);
 
       result_.signature = &proc->results;
+      auto memory_limit = EvaluateMemoryLimit(&evaluator, self_->memory_limit_, self_->memory_scale_);
+      mgp_graph graph{context.db_accessor, graph_view, &context};
+      if (proc->batch) {
+        // The results are pulled in batches, starting with the next iteration.
+        StartBatchCall(*module, *proc, graph, &evaluator, memory_limit, context);
+        result_.signature = nullptr;
+        continue;
+      }
       // Use evaluation memory, as invoking a procedure is akin to a simple
       // evaluation of an expression.
-      // TODO: This will probably need to be changed when we add support for
-      // generator like procedures which yield a new result on each invocation.
       auto *memory = context.evaluation_context.memory;
-      auto memory_limit = EvaluateMemoryLimit(&evaluator, self_->memory_limit_, self_->memory_scale_);
-      mgp_graph graph{context.db_accessor, graph_view, &context};
       CallCustomProcedure(self_->procedure_name_, *proc, self_->arguments_, graph, &evaluator, memory, memory_limit,
                           &result_);
 
@@ -3871,14 +4485,114 @@ class CallProcedureCursor : public Cursor {
   }
 
   void Reset() override {
+    AbortBatchCall();
     result_.rows.clear();
+    result_row_it_ = result_.rows.end();
     result_.error_msg.reset();
     input_cursor_->Reset();
   }
 
-  void Shutdown() override {}
+  void Shutdown() override { AbortBatchCall(); }
+
+ private:
+  void StartBatchCall(const procedure::Module &module, const mgp_proc &proc, mgp_graph graph,
+                      ExpressionEvaluator *evaluator, std::optional<size_t> memory_limit,
+                      const ExecutionContext &context) {
+    batch_call_.emplace(context.memory_tracker, graph, memory_limit, module.LoadId());
+    // The arguments are kept for all the batches, so they are evaluated into
+    // the memory of the call. The procedure isn't cleaned up if they fail,
+    // since it wasn't initialized.
+    try {
+      BuildProcedureArguments(self_->procedure_name_, proc, self_->arguments_, batch_call_->graph, evaluator,
+                              &batch_call_->args);
+    } catch (...) {
+      batch_call_.reset();
+      throw;
+    }
+    result_signature_size_ = proc.results.size();
+    if (memory_limit) {
+      SPDLOG_TRACE("Running '{}' with memory limit of {}", self_->procedure_name_,
+                   utils::GetReadableSize(*memory_limit));
+    }
+    if (!proc.batch->init) return;
+    proc.batch->init(&batch_call_->args, &batch_call_->graph, &result_, &batch_call_->call_memory,
+                     &batch_call_->state);
+    result_.rows.clear();
+    if (result_.error_msg) {
+      FinishBatchCall(proc);
+      throw QueryRuntimeException("{}: {}", self_->procedure_name_, *result_.error_msg);
+    }
+  }
+
+  void PullBatch(ExecutionContext &context) {
+    // The procedure is looked up again for each batch, so that the module
+    // isn't locked while the results are pulled by the rest of the query.
+    const auto maybe_found = FindBatchProcedure(context.evaluation_context.memory);
+    if (!maybe_found) {
+      batch_call_.reset();
+      throw QueryRuntimeException("The module of procedure '{}' was reloaded while the procedure was running.",
+                                  self_->procedure_name_);
+    }
+    const auto &proc = *maybe_found->second;
+    result_.signature = &proc.results;
+    {
+      // The memory of the batch comes from the memory of the call, so the
+      // same limit applies to both of them.
+      utils::MonotonicBufferResource batch_memory(1024, batch_call_->call_memory.impl);
+      utils::TrackingMemoryResource tracked_memory(&batch_memory);
+      mgp_memory proc_memory{&tracked_memory};
+      proc.batch->cb(&batch_call_->args, &batch_call_->graph, &result_, &proc_memory, kProcedureBatchRows,
+                     batch_call_->state);
+      if (const auto leaked_bytes = tracked_memory.GetAllocatedBytes(); leaked_bytes > 0U) {
+        spdlog::warn("Query procedure '{}' leaked {} *tracked* bytes", self_->procedure_name_, leaked_bytes);
+      }
+    }
+    result_.signature = nullptr;
+    if (result_.error_msg || result_.rows.empty()) FinishBatchCall(proc);
+    if (result_.error_msg) {
+      throw QueryRuntimeException("{}: {}", self_->procedure_name_, *result_.error_msg);
+    }
+    result_row_it_ = result_.rows.begin();
+  }
+
+  // Return the procedure of the running batch call, or std::nullopt if its
+  // module was reloaded since the call started.
+  std::optional<std::pair<procedure::ModulePtr, const mgp_proc *>> FindBatchProcedure(
+      utils::MemoryResource *memory) const {
+    auto maybe_found = procedure::FindProcedure(procedure::gModuleRegistry, self_->procedure_name_, memory);
+    if (!maybe_found || !maybe_found->second->batch || maybe_found->first->LoadId() != batch_call_->module_load_id) {
+      return std::nullopt;
+    }
+    return maybe_found;
+  }
+
+  void FinishBatchCall(const mgp_proc &proc) {
+    if (proc.batch->cleanup) {
+      proc.batch->cleanup(batch_call_->state, &batch_call_->call_memory);
+    }
+    if (batch_call_->limited_memory) {
+      if (const auto leaked_bytes = batch_call_->limited_memory->GetAllocatedBytes(); leaked_bytes > 0U) {
+        spdlog::warn("Query procedure '{}' leaked {} *tracked* bytes", self_->procedure_name_, leaked_bytes);
+      }
+    }
+    batch_call_.reset();
+  }
+
+  // Clean up the batch call whose results weren't all pulled.
+  void AbortBatchCall() {
+    if (!batch_call_) return;
+    const auto maybe_found = FindBatchProcedure(utils::NewDeleteResource());
+    if (!maybe_found) {
+      spdlog::warn("The cleanup of procedure '{}' is skipped, because its module was reloaded.",
+                   self_->procedure_name_);
+      batch_call_.reset();
+      return;
+    }
+    FinishBatchCall(*maybe_found->second);
+  }
 };
 
+
 UniqueCursorPtr CallProcedure::MakeCursor(utils::MemoryResource *mem) const {
   EventCounter::IncrementCounter(EventCounter::CallProcedureOperator);
   CallProcedure::IncrementCounter(procedure_name_);
@@ -18,10 +18,12 @@
 #pragma once
 
 #include "query/plan/cost_estimator.hpp"
+#include "query/plan/join_order_planner.hpp"
 #include "query/plan/operator.hpp"
 #include "query/plan/preprocess.hpp"
 #include "query/plan/pretty_print.hpp"
 #include "query/plan/rewrite/index_lookup.hpp"
+#include "query/plan/rewrite/index_order.hpp"
 #include "query/plan/rule_based_planner.hpp"
 #include "query/plan/variable_start_planner.hpp"
 #include "query/plan/vertex_count_cache.hpp"
@@ -43,7 +45,11 @@ class PostProcessor final {
 
   template <class TPlanningContext>
   std::unique_ptr<LogicalOperator> Rewrite(std::unique_ptr<LogicalOperator> plan, TPlanningContext *context) {
-    return RewriteWithIndexLookup(std::move(plan), context->symbol_table, context->ast_storage, context->db);
+    auto rewritten_plan =
+        RewriteWithIndexLookup(std::move(plan), context->symbol_table, context->ast_storage, context->db);
+    rewritten_plan = RewriteWithIndexOrder(std::move(rewritten_plan), *context->symbol_table, context->ast_storage);
+    MarkGroupedAggregations(rewritten_plan.get(), *context->symbol_table);
+    return rewritten_plan;
   }
 
   template <class TVertexCounts>
@@ -97,6 +103,11 @@ auto MakeLogicalPlanForSingleQuery(std::vector<SingleQueryPart> single_query_par
 /// @param post_process performs plan rewrites and cost estimation.
 /// @param use_variable_planner boolean flag to choose which planner to use.
 ///
+/// When @p use_variable_planner is set, the plan ordered by @c JoinOrderPlanner
+/// is used if the graph was analyzed, because its estimates are more precise
+/// than the ones used for comparing the plan costs. Otherwise, it competes
+/// with the plans generated by @c VariableStartPlanner.
+///
 /// @return pair consisting of the final `TPlanPostProcess::ProcessedPlan` and
 /// the estimated cost of that plan as a `double`.
 template <class TPlanningContext, class TPlanPostProcess>
@@ -113,6 +124,12 @@ auto MakeLogicalPlan(TPlanningContext *context, TPlanPostProcess *post_process,
     double min_cost = std::numeric_limits<double>::max();
 
     if (use_variable_planner) {
+      auto plan = MakeLogicalPlanForSingleQuery<JoinOrderPlanner>(query_part.single_query_parts, context);
+      auto rewritten_plan = post_process->Rewrite(std::move(plan), context);
+      min_cost = post_process->EstimatePlanCost(rewritten_plan, &vertex_counts);
+      curr_plan.emplace(std::move(rewritten_plan));
+    }
+    if (use_variable_planner && !vertex_counts.GetGraphStatistics()) {
       auto plans = MakeLogicalPlanForSingleQuery<VariableStartPlanner>(query_part.single_query_parts, context);
       for (auto plan : plans) {
         // Plans are generated lazily and the current plan will disappear, so
@@ -124,7 +141,7 @@ auto MakeLogicalPlan(TPlanningContext *context, TPlanPostProcess *post_process,
           min_cost = cost;
         }
       }
-    } else {
+    } else if (!use_variable_planner) {
       auto plan = MakeLogicalPlanForSingleQuery<RuleBasedPlanner>(query_part.single_query_parts, context);
       auto rewritten_plan = post_process->Rewrite(std::move(plan), context);
       min_cost = post_process->EstimatePlanCost(rewritten_plan, &vertex_counts);
@@ -156,7 +156,7 @@ PRE_VISIT(Accumulate);
 
 bool PlanPrinter::PreVisit(query::plan::Aggregate &op) {
   WithPrintLn([&](auto &out) {
-    out << "* Aggregate {";
+    out << (op.grouped_input_ ? "* Aggregate (Streaming) {" : "* Aggregate {");
     utils::PrintIterable(out, op.aggregations_, ", ",
                          [](auto &out, const auto &aggr) { out << aggr.output_sym.name(); });
     out << "} {";
@@ -171,7 +171,7 @@ PRE_VISIT(Limit);
 
 bool PlanPrinter::PreVisit(query::plan::OrderBy &op) {
   WithPrintLn([&op](auto &out) {
-    out << "* OrderBy {";
+    out << (op.limit_ ? "* OrderBy (TopK) {" : "* OrderBy {");
     utils::PrintIterable(out, op.output_symbols_, ", ", [](auto &out, const auto &sym) { out << sym.name(); });
     out << "}";
   });
@@ -711,6 +711,7 @@ bool PlanToJsonVisitor::PreVisit(Aggregate &op) {
   self["aggregations"] = ToJson(op.aggregations_);
   self["group_by"] = ToJson(op.group_by_);
   self["remember"] = ToJson(op.remember_);
+  if (op.grouped_input_) self["grouped_input"] = true;
 
   op.input_->Accept(*this);
   self["input"] = PopOutput();
@@ -754,6 +755,8 @@ bool PlanToJsonVisitor::PreVisit(OrderBy &op) {
     self["order_by"].push_back(json);
   }
   self["output_symbols"] = ToJson(op.output_symbols_);
+  if (op.skip_) self["skip"] = ToJson(op.skip_);
+  if (op.limit_) self["limit"] = ToJson(op.limit_);
 
   op.input_->Accept(*this);
   self["input"] = PopOutput();
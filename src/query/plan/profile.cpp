@@ -19,6 +19,7 @@
 
 #include "query/context.hpp"
 #include "utils/likely.hpp"
+#include "utils/readable_size.hpp"
 
 namespace query::plan {
 
@@ -30,6 +31,12 @@ unsigned long long IndividualCycles(const ProfilingStats &cumulative_stats) {
                                                        [](auto acc, auto &stats) { return acc + stats.num_cycles; });
 }
 
+uint64_t IndividualAllocatedBytes(const ProfilingStats &cumulative_stats) {
+  return cumulative_stats.allocated_bytes -
+         std::accumulate(cumulative_stats.children.begin(), cumulative_stats.children.end(), uint64_t{0},
+                         [](auto acc, auto &stats) { return acc + stats.allocated_bytes; });
+}
+
 double RelativeTime(unsigned long long num_cycles, unsigned long long total_cycles) {
   return static_cast<double>(num_cycles) / total_cycles;
 }
@@ -58,7 +65,8 @@ class ProfilingStatsToTableHelper {
 
     rows_.emplace_back(std::vector<TypedValue>{
         TypedValue(FormatOperator(cumulative_stats.name)), TypedValue(cumulative_stats.actual_hits),
-        TypedValue(FormatRelativeTime(cycles)), TypedValue(FormatAbsoluteTime(cycles))});
+        TypedValue(FormatRelativeTime(cycles)), TypedValue(FormatAbsoluteTime(cycles)),
+        TypedValue(utils::GetReadableSize(static_cast<double>(IndividualAllocatedBytes(cumulative_stats))))});
 
     for (size_t i = 1; i < cumulative_stats.children.size(); ++i) {
       Branch(cumulative_stats.children[i]);
@@ -73,7 +81,8 @@ class ProfilingStatsToTableHelper {
 
  private:
   void Branch(const ProfilingStats &cumulative_stats) {
-    rows_.emplace_back(std::vector<TypedValue>{TypedValue("|\\"), TypedValue(""), TypedValue(""), TypedValue("")});
+    rows_.emplace_back(
+        std::vector<TypedValue>{TypedValue("|\\"), TypedValue(""), TypedValue(""), TypedValue(""), TypedValue("")});
 
     ++depth_;
     Output(cumulative_stats);
@@ -141,6 +150,7 @@ class ProfilingStatsToJsonHelper {
     obj->emplace("actual_hits", cumulative_stats.actual_hits);
     obj->emplace("relative_time", RelativeTime(cycles, total_cycles_));
     obj->emplace("absolute_time", AbsoluteTime(cycles, total_cycles_, total_time_));
+    obj->emplace("allocated_bytes", IndividualAllocatedBytes(cumulative_stats));
     obj->emplace("children", json::array());
 
     for (size_t i = 0; i < cumulative_stats.children.size(); ++i) {
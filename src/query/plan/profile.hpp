@@ -32,6 +32,9 @@ struct ProfilingStats {
   const char *name{nullptr};
   // TODO: This should use the allocator for query execution
   std::vector<ProfilingStats> children;
+  // Number of bytes of query memory allocated while the operator was running,
+  // including its children.
+  uint64_t allocated_bytes{0};
 };
 
 struct ProfilingStatsWithTotalTime {
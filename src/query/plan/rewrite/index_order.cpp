@@ -0,0 +1,192 @@
+// Copyright 2021 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "query/plan/rewrite/index_order.hpp"
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "utils/typeinfo.hpp"
+
+namespace query::plan {
+
+namespace impl {
+
+namespace {
+
+// The sort key as it is tracked down the plan. It is either the value of the
+// symbol, or the value of the symbol's property.
+struct SortKey {
+  Symbol symbol;
+  std::optional<std::string> property;
+};
+
+std::optional<SortKey> ToSortKey(Expression *expression, const SymbolTable &symbol_table) {
+  if (auto *identifier = utils::Downcast<Identifier>(expression)) {
+    return SortKey{symbol_table.at(*identifier), std::nullopt};
+  }
+  if (auto *property_lookup = utils::Downcast<PropertyLookup>(expression)) {
+    if (auto *identifier = utils::Downcast<Identifier>(property_lookup->expression_)) {
+      return SortKey{symbol_table.at(*identifier), property_lookup->property_.name};
+    }
+  }
+  return std::nullopt;
+}
+
+// Follows the sort key through the named expressions of Produce, e.g.
+// `WITH n AS m` or `RETURN n.prop AS value`.
+std::optional<SortKey> ThroughProduce(const Produce &produce, const SortKey &key, const SymbolTable &symbol_table) {
+  for (auto *named_expression : produce.named_expressions_) {
+    if (symbol_table.at(*named_expression) != key.symbol) continue;
+    auto produced_key = ToSortKey(named_expression->expression_, symbol_table);
+    if (!produced_key) return std::nullopt;
+    if (key.property) {
+      // Nested property lookups aren't supported by the index.
+      if (produced_key->property) return std::nullopt;
+      produced_key->property = key.property;
+    }
+    return produced_key;
+  }
+  return key;
+}
+
+// Operators which produce the rows for each input row consecutively and don't
+// change the values of existing symbols, so the input order is kept. Distinct
+// isn't one of them, because it reorders the rows when it spills to disk.
+bool PreservesOrder(const LogicalOperator &op) {
+  return utils::IsSubtype(op, Filter::kType) || utils::IsSubtype(op, Expand::kType) ||
+         utils::IsSubtype(op, ExpandVariable::kType) || utils::IsSubtype(op, EdgeUniquenessFilter::kType) ||
+         utils::IsSubtype(op, ConstructNamedPath::kType) || utils::IsSubtype(op, Skip::kType) ||
+         utils::IsSubtype(op, Limit::kType) || utils::IsSubtype(op, Unwind::kType);
+}
+
+template <class TScan>
+bool IsScanOfKey(const TScan &scan, const SortKey &key) {
+  // The scan must be the first operator, otherwise the index is scanned for
+  // each input row and the order restarts.
+  return key.property && scan.output_symbol_ == key.symbol && scan.property_name_ == *key.property &&
+         utils::IsSubtype(*scan.input(), Once::kType);
+}
+
+// Returns true if the scan produces the rows with equal keys consecutively. The
+// keys all refer to the scanned symbol.
+bool IsScanGroupedBy(const ScanAll &scan, const std::vector<SortKey> &keys) {
+  // Each vertex is scanned once and its properties depend only on the vertex.
+  if (std::any_of(keys.begin(), keys.end(), [](const auto &key) { return !key.property; })) return true;
+  std::optional<std::string> property_name;
+  if (const auto *range_scan = utils::Downcast<const ScanAllByLabelPropertyRange>(&scan)) {
+    property_name = range_scan->property_name_;
+  } else if (const auto *value_scan = utils::Downcast<const ScanAllByLabelPropertyValue>(&scan)) {
+    property_name = value_scan->property_name_;
+  } else if (const auto *property_scan = utils::Downcast<const ScanAllByLabelProperty>(&scan)) {
+    property_name = property_scan->property_name_;
+  }
+  // Equal property values are next to each other in the index.
+  return property_name &&
+         std::all_of(keys.begin(), keys.end(), [&](const auto &key) { return *key.property == *property_name; });
+}
+
+}  // namespace
+
+bool IsSortedByIndex(const OrderBy &order_by, const SymbolTable &symbol_table) {
+  if (order_by.order_by_.size() != 1) return false;
+  auto key = ToSortKey(order_by.order_by_.front(), symbol_table);
+  if (!key) return false;
+  const auto ordering = order_by.compare_.ordering_.front();
+
+  for (const auto *op = order_by.input().get();; op = op->input().get()) {
+    if (const auto *produce = utils::Downcast<const Produce>(op)) {
+      key = ThroughProduce(*produce, *key, symbol_table);
+      if (!key) return false;
+      continue;
+    }
+    // The index is iterated in ascending order and vertices with a Null
+    // property aren't in it, which is where ascending ORDER BY puts them.
+    if (const auto *scan = utils::Downcast<const ScanAllByLabelPropertyRange>(op)) {
+      return ordering == Ordering::ASC && IsScanOfKey(*scan, *key);
+    }
+    // All of the scanned vertices have the same value, so any ordering holds.
+    if (const auto *scan = utils::Downcast<const ScanAllByLabelPropertyValue>(op)) {
+      return IsScanOfKey(*scan, *key);
+    }
+    if (!PreservesOrder(*op)) return false;
+  }
+}
+
+bool IsInputGrouped(const Aggregate &aggregate, const SymbolTable &symbol_table) {
+  if (aggregate.group_by_.empty()) return false;
+  std::vector<SortKey> keys;
+  keys.reserve(aggregate.group_by_.size());
+  for (auto *group_by : aggregate.group_by_) {
+    auto key = ToSortKey(group_by, symbol_table);
+    if (!key) return false;
+    keys.push_back(std::move(*key));
+  }
+
+  for (const auto *op = aggregate.input().get();; op = op->input().get()) {
+    if (const auto *produce = utils::Downcast<const Produce>(op)) {
+      for (auto &key : keys) {
+        auto produced_key = ThroughProduce(*produce, key, symbol_table);
+        if (!produced_key) return false;
+        key = std::move(*produced_key);
+      }
+      continue;
+    }
+    if (const auto *scan = utils::Downcast<const ScanAll>(op)) {
+      auto is_scanned = [&](const auto &key) { return key.symbol == scan->output_symbol_; };
+      // Scans of other symbols produce their rows for each input row
+      // consecutively, so the groups stay together.
+      if (std::none_of(keys.begin(), keys.end(), is_scanned)) continue;
+      // The scan must be the first operator, otherwise it is repeated for each
+      // input row.
+      return std::all_of(keys.begin(), keys.end(), is_scanned) && utils::IsSubtype(*scan->input(), Once::kType) &&
+             IsScanGroupedBy(*scan, keys);
+    }
+    if (!PreservesOrder(*op)) return false;
+  }
+}
+
+}  // namespace impl
+
+std::unique_ptr<LogicalOperator> RewriteWithIndexOrder(std::unique_ptr<LogicalOperator> root_op,
+                                                       const SymbolTable &symbol_table, AstStorage *ast_storage) {
+  LogicalOperator *parent = nullptr;
+  LogicalOperator *op = root_op.get();
+  while (op->HasSingleInput()) {
+    const auto *order_by = utils::Downcast<const OrderBy>(op);
+    if (!order_by || !impl::IsSortedByIndex(*order_by, symbol_table)) {
+      parent = op;
+      op = op->input().get();
+      continue;
+    }
+    if (!parent) {
+      // The root is owned uniquely, so the rest of the plan needs to be copied.
+      root_op = order_by->input()->Clone(ast_storage);
+      op = root_op.get();
+    } else {
+      parent->set_input(order_by->input());
+      op = parent->input().get();
+    }
+  }
+  return root_op;
+}
+
+void MarkGroupedAggregations(LogicalOperator *root_op, const SymbolTable &symbol_table) {
+  for (auto *op = root_op; op->HasSingleInput(); op = op->input().get()) {
+    if (auto *aggregate = utils::Downcast<Aggregate>(op)) {
+      aggregate->grouped_input_ = impl::IsInputGrouped(*aggregate, symbol_table);
+    }
+  }
+}
+
+}  // namespace query::plan
@@ -0,0 +1,55 @@
+// Copyright 2021 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+/// @file
+/// This file provides plan rewriters which take advantage of the order in
+/// which the scans produce rows. `RewriteWithIndexOrder` removes `OrderBy`
+/// operations when the rows already come in the required order from a
+/// label-property index scan. `MarkGroupedAggregations` makes `Aggregate`
+/// operations stream their groups when the rows of each group come
+/// consecutively.
+
+#pragma once
+
+#include <memory>
+
+#include "query/plan/operator.hpp"
+
+namespace query::plan {
+
+namespace impl {
+
+/// Returns true if the input of the given `OrderBy` produces the rows sorted
+/// by its (single) sort key, because they are streamed from a
+/// `ScanAllByLabelPropertyRange` or `ScanAllByLabelPropertyValue` in index
+/// order.
+bool IsSortedByIndex(const OrderBy &order_by, const SymbolTable &symbol_table);
+
+/// Returns true if the input of the given `Aggregate` produces the rows of
+/// each group consecutively. That holds when it groups by a scanned vertex
+/// (and possibly its properties), or by the property of a label-property index
+/// scan.
+bool IsInputGrouped(const Aggregate &aggregate, const SymbolTable &symbol_table);
+
+}  // namespace impl
+
+/// Removes `OrderBy` operators along the main input chain of the plan which
+/// sort rows already sorted by a label-property index scan. The preceding
+/// `IndexLookupRewriter` must have already introduced the index scans.
+std::unique_ptr<LogicalOperator> RewriteWithIndexOrder(std::unique_ptr<LogicalOperator> root_op,
+                                                       const SymbolTable &symbol_table, AstStorage *ast_storage);
+
+/// Sets `Aggregate::grouped_input_` of the `Aggregate` operators along the
+/// main input chain of the plan, so that they stream the groups when their
+/// input is already grouped.
+void MarkGroupedAggregations(LogicalOperator *root_op, const SymbolTable &symbol_table);
+
+}  // namespace query::plan
@@ -479,9 +479,11 @@ std::unique_ptr<LogicalOperator> GenReturnBody(std::unique_ptr<LogicalOperator>
     last_op = std::make_unique<Distinct>(std::move(last_op), body.output_symbols());
   }
   // Like Where, OrderBy can read from symbols established by named expressions
-  // in Produce, so it must come after it.
+  // in Produce, so it must come after it. When followed by Limit, OrderBy only
+  // needs to keep the first skip + limit rows.
   if (!body.order_by().empty()) {
-    last_op = std::make_unique<OrderBy>(std::move(last_op), body.order_by(), body.output_symbols());
+    last_op = std::make_unique<OrderBy>(std::move(last_op), body.order_by(), body.output_symbols(), body.skip(),
+                                        body.limit());
   }
   // Finally, Skip and Limit must come after OrderBy.
   if (body.skip()) {
@@ -19,6 +19,7 @@
 
 #include "query/frontend/ast/ast.hpp"
 #include "query/frontend/ast/ast_visitor.hpp"
+#include "query/parameters.hpp"
 #include "query/plan/operator.hpp"
 #include "query/plan/preprocess.hpp"
 #include "utils/logging.hpp"
@@ -41,6 +42,12 @@ struct PlanningContext {
   /// database to generate better plans. The accessor is required only to live
   /// long enough for the plan generation to finish.
   TDbAccessor *db{nullptr};
+  /// @brief Query parameters, which are used for estimating the selectivity
+  /// of filters on property values, and through it the order of the joins.
+  /// The plan may therefore depend on the parameter values it was made with.
+  /// If they are left unset, only the literals are used and the filters on
+  /// parameters get the default selectivity.
+  const Parameters *parameters{nullptr};
   /// @brief Symbol set is used to differentiate cycles in pattern matching.
   /// During planning, symbols will be added as each operator produces values
   /// for them. This way, the operator can be correctly initialized whether to
@@ -51,8 +58,9 @@ struct PlanningContext {
 };
 
 template <class TDbAccessor>
-auto MakePlanningContext(AstStorage *ast_storage, SymbolTable *symbol_table, CypherQuery *query, TDbAccessor *db) {
-  return PlanningContext<TDbAccessor>{symbol_table, ast_storage, query, db};
+auto MakePlanningContext(AstStorage *ast_storage, SymbolTable *symbol_table, CypherQuery *query, TDbAccessor *db,
+                         const Parameters *parameters = nullptr) {
+  return PlanningContext<TDbAccessor>{symbol_table, ast_storage, query, db, parameters};
 }
 
 // Contextual information used for generating match operators.
@@ -58,6 +58,7 @@ class ScopedProfile {
 
       context_->stats_root = stats_;
       stats_->actual_hits++;
+      start_allocated_bytes_ = AllocatedBytes();
       start_time_ = utils::ReadTSC();
     }
   }
@@ -65,6 +66,7 @@ class ScopedProfile {
   ~ScopedProfile() noexcept {
     if (UNLIKELY(context_->is_profile_query)) {
       stats_->num_cycles += utils::ReadTSC() - start_time_;
+      stats_->allocated_bytes += AllocatedBytes() - start_allocated_bytes_;
 
       // Restore the old root ("pop")
       context_->stats_root = root_;
@@ -72,10 +74,15 @@ class ScopedProfile {
   }
 
  private:
+  uint64_t AllocatedBytes() const noexcept {
+    return context_->memory_tracker ? context_->memory_tracker->GetTotalAllocatedBytes() : 0;
+  }
+
   query::ExecutionContext *context_;
   ProfilingStats *root_;
   ProfilingStats *stats_;
   unsigned long long start_time_;
+  uint64_t start_allocated_bytes_;
 };
 
 }  // namespace plan
@@ -0,0 +1,288 @@
+// Copyright 2021 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "query/plan/spill.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include "query/exceptions.hpp"
+#include "utils/uuid.hpp"
+
+namespace query::plan {
+
+namespace {
+
+// Accessors are written as raw bytes, which is only valid while the
+// transaction that created them is alive.
+static_assert(std::is_trivially_copyable_v<VertexAccessor>, "VertexAccessor can't be spilled as raw bytes");
+static_assert(std::is_trivially_copyable_v<EdgeAccessor>, "EdgeAccessor can't be spilled as raw bytes");
+
+constexpr uint64_t kSpillPartitionBits = std::countr_zero(kSpillPartitionCount);
+static_assert(std::has_single_bit(kSpillPartitionCount), "Number of spill partitions must be a power of 2");
+
+}  // namespace
+
+SpillFile::SpillFile(const std::filesystem::path &directory)
+    : path_(directory / (utils::GenerateUUID() + ".spill")),
+      buffer_(std::make_unique<uint8_t[]>(utils::kFileBufferSize)) {
+  if (!utils::EnsureDir(directory)) {
+    throw QueryRuntimeException("Couldn't create the directory '{}' for spilled query data.", directory.string());
+  }
+  fd_ = open(path_.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0640);
+  if (fd_ == -1) {
+    throw QueryRuntimeException("Couldn't create the file '{}' for spilled query data: {}", path_.string(),
+                                std::strerror(errno));
+  }
+}
+
+SpillFile::~SpillFile() {
+  if (fd_ != -1) close(fd_);
+  utils::DeleteFile(path_);
+}
+
+bool SpillFile::ReadRow(utils::pmr::vector<TypedValue> *row) {
+  if (writing_) {
+    Flush();
+    if (lseek(fd_, 0, SEEK_SET) == -1) {
+      throw QueryRuntimeException("Couldn't read the spilled query data from '{}': {}", path_.string(),
+                                  std::strerror(errno));
+    }
+    writing_ = false;
+  }
+  if (read_row_count_ == row_count_) return false;
+  ++read_row_count_;
+  const auto size = ReadSize();
+  row->clear();
+  row->reserve(size);
+  auto *memory = row->get_allocator().GetMemoryResource();
+  for (uint64_t i = 0; i < size; ++i) row->emplace_back(ReadValue(memory));
+  return true;
+}
+
+template <class T>
+void SpillFile::WriteRaw(const T &value) {
+  static_assert(std::is_trivially_copyable_v<T>);
+  WriteBytes(reinterpret_cast<const uint8_t *>(&value), sizeof(value));
+}
+
+template <class T>
+T SpillFile::ReadRaw() {
+  static_assert(std::is_trivially_copyable_v<T>);
+  std::array<uint8_t, sizeof(T)> data;
+  ReadBytes(data.data(), data.size());
+  return std::bit_cast<T>(data);
+}
+
+void SpillFile::WriteSize(uint64_t size) { WriteRaw(size); }
+
+uint64_t SpillFile::ReadSize() { return ReadRaw<uint64_t>(); }
+
+void SpillFile::WriteBytes(const uint8_t *data, size_t size) {
+  while (size > 0) {
+    if (buffer_position_ == utils::kFileBufferSize) Flush();
+    const auto count = std::min(size, utils::kFileBufferSize - buffer_position_);
+    std::memcpy(buffer_.get() + buffer_position_, data, count);
+    buffer_position_ += count;
+    data += count;
+    size -= count;
+  }
+}
+
+void SpillFile::ReadBytes(uint8_t *data, size_t size) {
+  while (size > 0) {
+    if (buffer_position_ == buffer_end_) Fill();
+    const auto count = std::min(size, buffer_end_ - buffer_position_);
+    std::memcpy(data, buffer_.get() + buffer_position_, count);
+    buffer_position_ += count;
+    data += count;
+    size -= count;
+  }
+}
+
+void SpillFile::Flush() {
+  size_t written = 0;
+  while (written < buffer_position_) {
+    const auto result = write(fd_, buffer_.get() + written, buffer_position_ - written);
+    if (result == -1) {
+      if (errno == EINTR) continue;
+      throw QueryRuntimeException("Couldn't write the spilled query data to '{}': {}", path_.string(),
+                                  std::strerror(errno));
+    }
+    written += result;
+  }
+  buffer_position_ = 0;
+}
+
+void SpillFile::Fill() {
+  ssize_t result = -1;
+  do {
+    result = read(fd_, buffer_.get(), utils::kFileBufferSize);
+  } while (result == -1 && errno == EINTR);
+  if (result == -1) {
+    throw QueryRuntimeException("Couldn't read the spilled query data from '{}': {}", path_.string(),
+                                std::strerror(errno));
+  }
+  if (result == 0) {
+    throw QueryRuntimeException("Couldn't read the spilled query data from '{}'.", path_.string());
+  }
+  buffer_position_ = 0;
+  buffer_end_ = result;
+}
+
+void SpillFile::WriteValue(const TypedValue &value) {
+  WriteRaw(static_cast<uint8_t>(value.type()));
+  switch (value.type()) {
+    case TypedValue::Type::Null:
+      return;
+    case TypedValue::Type::Bool:
+      WriteRaw(value.ValueBool());
+      return;
+    case TypedValue::Type::Int:
+      WriteRaw(value.ValueInt());
+      return;
+    case TypedValue::Type::Double:
+      WriteRaw(value.ValueDouble());
+      return;
+    case TypedValue::Type::String: {
+      const auto &string = value.ValueString();
+      WriteSize(string.size());
+      WriteBytes(reinterpret_cast<const uint8_t *>(string.data()), string.size());
+      return;
+    }
+    case TypedValue::Type::List:
+      WriteSize(value.ValueList().size());
+      for (const auto &element : value.ValueList()) WriteValue(element);
+      return;
+    case TypedValue::Type::Map:
+      WriteSize(value.ValueMap().size());
+      for (const auto &[key, element] : value.ValueMap()) {
+        WriteSize(key.size());
+        WriteBytes(reinterpret_cast<const uint8_t *>(key.data()), key.size());
+        WriteValue(element);
+      }
+      return;
+    case TypedValue::Type::Vertex:
+      WriteRaw(value.ValueVertex());
+      return;
+    case TypedValue::Type::Edge:
+      WriteRaw(value.ValueEdge());
+      return;
+    case TypedValue::Type::Path: {
+      const auto &path = value.ValuePath();
+      WriteSize(path.vertices().size());
+      WriteRaw(path.vertices().front());
+      for (size_t i = 0; i < path.edges().size(); ++i) {
+        WriteRaw(path.edges()[i]);
+        WriteRaw(path.vertices()[i + 1]);
+      }
+      return;
+    }
+    case TypedValue::Type::Date:
+      WriteRaw(value.ValueDate().MicrosecondsSinceEpoch());
+      return;
+    case TypedValue::Type::LocalTime:
+      WriteRaw(value.ValueLocalTime().MicrosecondsSinceEpoch());
+      return;
+    case TypedValue::Type::LocalDateTime:
+      WriteRaw(value.ValueLocalDateTime().MicrosecondsSinceEpoch());
+      return;
+    case TypedValue::Type::Duration:
+      WriteRaw(value.ValueDuration().microseconds);
+      return;
+  }
+}
+
+TypedValue SpillFile::ReadValue(utils::MemoryResource *memory) {
+  auto read_string = [&] {
+    TypedValue::TString string(ReadSize(), '\0', memory);
+    ReadBytes(reinterpret_cast<uint8_t *>(string.data()), string.size());
+    return string;
+  };
+  const auto type = static_cast<TypedValue::Type>(ReadRaw<uint8_t>());
+  switch (type) {
+    case TypedValue::Type::Null:
+      return TypedValue(memory);
+    case TypedValue::Type::Bool:
+      return TypedValue(ReadRaw<bool>(), memory);
+    case TypedValue::Type::Int:
+      return TypedValue(ReadRaw<int64_t>(), memory);
+    case TypedValue::Type::Double:
+      return TypedValue(ReadRaw<double>(), memory);
+    case TypedValue::Type::String:
+      return TypedValue(read_string(), memory);
+    case TypedValue::Type::List: {
+      TypedValue::TVector list(memory);
+      const auto size = ReadSize();
+      list.reserve(size);
+      for (uint64_t i = 0; i < size; ++i) list.emplace_back(ReadValue(memory));
+      return TypedValue(std::move(list), memory);
+    }
+    case TypedValue::Type::Map: {
+      TypedValue::TMap map(memory);
+      const auto size = ReadSize();
+      for (uint64_t i = 0; i < size; ++i) {
+        auto key = read_string();
+        map.emplace(std::move(key), ReadValue(memory));
+      }
+      return TypedValue(std::move(map), memory);
+    }
+    case TypedValue::Type::Vertex:
+      return TypedValue(ReadRaw<VertexAccessor>(), memory);
+    case TypedValue::Type::Edge:
+      return TypedValue(ReadRaw<EdgeAccessor>(), memory);
+    case TypedValue::Type::Path: {
+      const auto vertex_count = ReadSize();
+      Path path(ReadRaw<VertexAccessor>(), memory);
+      for (uint64_t i = 1; i < vertex_count; ++i) {
+        path.Expand(ReadRaw<EdgeAccessor>());
+        path.Expand(ReadRaw<VertexAccessor>());
+      }
+      return TypedValue(path, memory);
+    }
+    case TypedValue::Type::Date:
+      return TypedValue(utils::Date(ReadRaw<int64_t>()), memory);
+    case TypedValue::Type::LocalTime:
+      return TypedValue(utils::LocalTime(ReadRaw<int64_t>()), memory);
+    case TypedValue::Type::LocalDateTime:
+      return TypedValue(utils::LocalDateTime(ReadRaw<int64_t>()), memory);
+    case TypedValue::Type::Duration:
+      return TypedValue(utils::Duration(ReadRaw<int64_t>()), memory);
+  }
+  throw QueryRuntimeException("Invalid spilled query data in '{}'.", path_.string());
+}
+
+std::vector<std::unique_ptr<SpillFile>> SpillPartitions::Release() && {
+  std::vector<std::unique_ptr<SpillFile>> partitions;
+  for (auto &partition : partitions_) {
+    if (partition) partitions.push_back(std::move(partition));
+  }
+  return partitions;
+}
+
+size_t SpillPartitions::PartitionIndex(size_t hash) const {
+  // Once all of the hash bits are used up, the rows can't be split any more.
+  // Every pass still finishes at least a single group, so the processing
+  // terminates.
+  const auto shift = kSpillPartitionBits * level_;
+  if (shift >= std::numeric_limits<size_t>::digits) return 0;
+  return (hash >> shift) & (kSpillPartitionCount - 1);
+}
+
+}  // namespace query::plan
@@ -0,0 +1,145 @@
+// Copyright 2021 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+/// @file
+/// Temporary files used by the operators which keep their state on disk when
+/// it doesn't fit in memory (OrderBy, Aggregate and Distinct).
+///
+/// Rows are written in a process-local format. Vertices and edges are stored
+/// as raw accessors, so the files may only be read by the same transaction
+/// which wrote them.
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+#include "query/typed_value.hpp"
+#include "utils/file.hpp"
+#include "utils/memory.hpp"
+#include "utils/pmr/vector.hpp"
+
+namespace query::plan {
+
+/// Number of partitions the rows are split into when a hashed operator
+/// (Aggregate or Distinct) spills its input.
+constexpr uint64_t kSpillPartitionCount = 16;
+
+/// Maximum number of sorted runs which are merged at once, which bounds the
+/// number of simultaneously open files (each with its own buffer).
+constexpr uint64_t kSpillMergeFanIn = 64;
+
+/// Temporary file holding rows of TypedValues. All of the rows are first
+/// written and then read back in the same order. The file is deleted when the
+/// object is destroyed.
+class SpillFile final {
+ public:
+  /// Creates a new file in the given directory, creating the directory if
+  /// needed.
+  ///
+  /// @throw QueryRuntimeException if the directory or the file can't be
+  /// created.
+  explicit SpillFile(const std::filesystem::path &directory);
+
+  SpillFile(const SpillFile &) = delete;
+  SpillFile &operator=(const SpillFile &) = delete;
+  SpillFile(SpillFile &&) = delete;
+  SpillFile &operator=(SpillFile &&) = delete;
+  ~SpillFile();
+
+  /// Writes a single row made of the values of all the given ranges.
+  ///
+  /// @throw QueryRuntimeException if the data can't be written.
+  template <class... TRanges>
+  void WriteRow(const TRanges &...ranges) {
+    MG_ASSERT(writing_, "Rows can't be written to a spill file after reading from it");
+    WriteSize((std::size(ranges) + ...));
+    (WriteValues(ranges), ...);
+    ++row_count_;
+  }
+
+  /// Reads the next row into `row`, replacing its contents. Returns false when
+  /// there are no more rows. The first call finishes writing of the file.
+  ///
+  /// @throw QueryRuntimeException if the data can't be read.
+  bool ReadRow(utils::pmr::vector<TypedValue> *row);
+
+  uint64_t row_count() const { return row_count_; }
+
+ private:
+  template <class TRange>
+  void WriteValues(const TRange &values) {
+    for (const auto &value : values) WriteValue(value);
+  }
+
+  template <class T>
+  void WriteRaw(const T &value);
+  template <class T>
+  T ReadRaw();
+
+  void WriteSize(uint64_t size);
+  void WriteValue(const TypedValue &value);
+  uint64_t ReadSize();
+  TypedValue ReadValue(utils::MemoryResource *memory);
+
+  void WriteBytes(const uint8_t *data, size_t size);
+  void ReadBytes(uint8_t *data, size_t size);
+  // Writes out the buffered data.
+  void Flush();
+  // Reads the next part of the file into the buffer.
+  void Fill();
+
+  std::filesystem::path path_;
+  // The file is accessed directly, instead of through utils::OutputFile and
+  // utils::InputFile, so that the I/O errors fail the query instead of the
+  // whole process.
+  int fd_{-1};
+  bool writing_{true};
+  // The buffer is large, so it's kept on the heap.
+  std::unique_ptr<uint8_t[]> buffer_;
+  // Position of the next byte in the buffer, and the end of the data read
+  // into it.
+  size_t buffer_position_{0};
+  size_t buffer_end_{0};
+  uint64_t row_count_{0};
+  uint64_t read_row_count_{0};
+};
+
+/// Set of `kSpillPartitionCount` spill files where each row is written to the
+/// file selected by its hash. Each level of partitioning uses different bits of
+/// the hash, so rows of a partition which is partitioned again get split up.
+class SpillPartitions final {
+ public:
+  SpillPartitions(const std::filesystem::path &directory, uint64_t level) : directory_(directory), level_(level) {}
+
+  template <class... TRanges>
+  void WriteRow(size_t hash, const TRanges &...ranges) {
+    auto &partition = partitions_[PartitionIndex(hash)];
+    if (!partition) partition = std::make_unique<SpillFile>(directory_);
+    partition->WriteRow(ranges...);
+  }
+
+  /// Moves out the non-empty partitions.
+  std::vector<std::unique_ptr<SpillFile>> Release() &&;
+
+  uint64_t level() const { return level_; }
+
+ private:
+  size_t PartitionIndex(size_t hash) const;
+
+  std::filesystem::path directory_;
+  uint64_t level_;
+  std::unique_ptr<SpillFile> partitions_[kSpillPartitionCount];
+};
+
+}  // namespace query::plan
@@ -12,11 +12,13 @@
 /// @file
 #pragma once
 
+#include <memory>
 #include <optional>
 
 #include "query/typed_value.hpp"
 #include "storage/v2/id_types.hpp"
 #include "storage/v2/property_value.hpp"
+#include "storage/v2/statistics.hpp"
 #include "utils/bound.hpp"
 #include "utils/fnv.hpp"
 
@@ -72,6 +74,14 @@ class VertexCountCache {
     return bounds_vertex_count.at(bounds);
   }
 
+  /// Statistics collected by `ANALYZE GRAPH`, or nullptr if the graph was
+  /// never analyzed. The same snapshot is returned for the whole lifetime of
+  /// the cache, so all estimates for a single query are consistent.
+  std::shared_ptr<const storage::GraphStatistics> GetGraphStatistics() {
+    if (!graph_statistics_) graph_statistics_ = db_->GetGraphStatistics();
+    return *graph_statistics_;
+  }
+
   bool LabelIndexExists(storage::LabelId label) { return db_->LabelIndexExists(label); }
 
   bool LabelPropertyIndexExists(storage::LabelId label, storage::PropertyId property) {
@@ -119,6 +129,7 @@ class VertexCountCache {
   };
 
   TDbAccessor *db_;
+  std::optional<std::shared_ptr<const storage::GraphStatistics>> graph_statistics_;
   std::optional<int64_t> vertices_count_;
   std::unordered_map<storage::LabelId, int64_t> label_vertex_count_;
   std::unordered_map<LabelPropertyKey, int64_t, LabelPropertyHash> label_property_vertex_count_;
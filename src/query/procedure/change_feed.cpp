@@ -0,0 +1,215 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "query/procedure/change_feed.hpp"
+
+#include <exception>
+#include <optional>
+#include <utility>
+
+#include "query/context.hpp"
+#include "query/db_accessor.hpp"
+#include "utils/logging.hpp"
+#include "utils/memory.hpp"
+
+namespace query::procedure {
+
+namespace {
+
+// Initial size of the memory of a single hook invocation.
+constexpr size_t kHookMemoryBlockSize = 64 * 1024;
+
+mgp_edge_change MakeEdgeChange(const EdgeAccessor &edge) {
+  return mgp_edge_change{.id = mgp_edge_id{edge.Gid().AsInt()},
+                         .from = mgp_vertex_id{edge.From().Gid().AsInt()},
+                         .to = mgp_vertex_id{edge.To().Gid().AsInt()}};
+}
+
+}  // namespace
+
+std::unordered_set<TriggerEventType> ChangeHookEventTypes() {
+  return {TriggerEventType::CREATE, TriggerEventType::DELETE};
+}
+
+void CollectGraphChanges(const TriggerContext &context, GraphChanges *changes) {
+  for (const auto &created : context.CreatedVertices()) {
+    changes->created_vertices.push_back(mgp_vertex_id{created.object.Gid().AsInt()});
+  }
+  for (const auto &deleted : context.DeletedVertices()) {
+    changes->deleted_vertices.push_back(mgp_vertex_id{deleted.object.Gid().AsInt()});
+  }
+  for (const auto &created : context.CreatedEdges()) changes->created_edges.push_back(MakeEdgeChange(created.object));
+  for (const auto &deleted : context.DeletedEdges()) changes->deleted_edges.push_back(MakeEdgeChange(deleted.object));
+}
+
+ChangeFeed::ChangeFeed(storage::Storage *db, ModuleRegistry *module_registry, std::atomic<bool> *is_shutting_down,
+                       utils::ThreadPool *procedure_pool, const size_t max_queued_objects)
+    : db_(db),
+      module_registry_(module_registry),
+      is_shutting_down_(is_shutting_down),
+      procedure_pool_(procedure_pool),
+      max_queued_objects_(max_queued_objects),
+      last_commit_timestamp_(db->LastCommitTimestamp()),
+      delivery_thread_([this] { DeliveryLoop(); }) {
+  // The hooks of the newly loaded modules are rebuilt right away, instead of
+  // waiting for the next changes. The commits made while no hooks were loaded
+  // didn't go through the feed, so the hooks which missed them are rebuilt
+  // too.
+  module_registry_->SetChangeHookListener([this] {
+    std::lock_guard guard(publish_lock_);
+    if (db_->LastCommitTimestamp() == last_commit_timestamp_) {
+      Enqueue({0, std::nullopt});
+      return;
+    }
+    last_commit_timestamp_ = db_->LastCommitTimestamp();
+    Enqueue({++published_, std::nullopt});
+  });
+  if (HasHooks()) Enqueue({0, std::nullopt});
+}
+
+ChangeFeed::~ChangeFeed() {
+  module_registry_->SetChangeHookListener({});
+  {
+    std::lock_guard guard(queue_lock_);
+    stop_ = true;
+  }
+  queue_cv_.notify_all();
+  delivery_thread_.join();
+}
+
+utils::BasicResult<storage::ConstraintViolation, void> ChangeFeed::CommitAndPublish(
+    storage::Storage::Accessor *accessor, std::optional<GraphChanges> changes) {
+  if (!HasHooks()) return accessor->Commit();
+  const auto size = changes ? changes->Size() : 0;
+  const auto release = [&] {
+    {
+      std::lock_guard guard(queue_lock_);
+      queued_objects_ -= size;
+    }
+    queue_cv_.notify_all();
+  };
+  if (size > 0) {
+    // The space is taken before the commit, so that the delivery thread can
+    // take the snapshots while this waits. Changes larger than the limit are
+    // let through when nothing else is queued.
+    std::unique_lock guard(queue_lock_);
+    queue_cv_.wait(guard, [&] {
+      return stop_ || queued_objects_ == 0 || queued_objects_ + size <= max_queued_objects_;
+    });
+    queued_objects_ += size;
+  }
+
+  std::lock_guard guard(publish_lock_);
+  if (db_->LastCommitTimestamp() != last_commit_timestamp_) {
+    // Some transaction was committed without going through the feed, so the
+    // hooks can't get its changes.
+    Enqueue({++published_, std::nullopt});
+  }
+  auto result = accessor->Commit();
+  const bool committed_deltas = db_->LastCommitTimestamp() != last_commit_timestamp_;
+  last_commit_timestamp_ = db_->LastCommitTimestamp();
+  if (!changes) {
+    // The changes weren't collected, so the hooks are rebuilt if the
+    // transaction changed anything.
+    if (committed_deltas) Enqueue({++published_, std::nullopt});
+    return result;
+  }
+  if (result.HasError() || size == 0) {
+    if (size > 0) release();
+    return result;
+  }
+  Enqueue({++published_, std::move(changes)});
+  return result;
+}
+
+void ChangeFeed::AwaitDelivery() {
+  std::unique_lock guard(queue_lock_);
+  queue_cv_.wait(guard, [&] { return stop_ || (queue_.empty() && !delivering_); });
+}
+
+void ChangeFeed::Enqueue(Delivery delivery) {
+  {
+    std::lock_guard guard(queue_lock_);
+    queue_.push_back(std::move(delivery));
+  }
+  queue_cv_.notify_all();
+}
+
+void ChangeFeed::DeliveryLoop() {
+  while (true) {
+    std::optional<Delivery> delivery;
+    {
+      std::unique_lock guard(queue_lock_);
+      queue_cv_.wait(guard, [&] { return stop_ || !queue_.empty(); });
+      if (stop_) return;
+      delivery.emplace(std::move(queue_.front()));
+      queue_.pop_front();
+      delivering_ = true;
+    }
+    Deliver(*delivery);
+    {
+      std::lock_guard guard(queue_lock_);
+      delivering_ = false;
+      if (delivery->changes) queued_objects_ -= delivery->changes->Size();
+    }
+    queue_cv_.notify_all();
+  }
+}
+
+void ChangeFeed::Deliver(const Delivery &delivery) {
+  const auto sequence = delivery.sequence;
+  const auto &changes = delivery.changes;
+  module_registry_->ForEachChangeHook(
+      [&](std::string_view module_name, std::string_view hook_name, const mgp_change_hook &hook) {
+        try {
+          if (!hook.rebuilt_at || (!changes && *hook.rebuilt_at < sequence)) Rebuild(hook);
+          // The rebuilt state may already include the changes.
+          if (!changes || !hook.rebuilt_at || sequence <= *hook.rebuilt_at) return;
+          utils::MonotonicBufferResource memory_resource(kHookMemoryBlockSize);
+          mgp_memory memory{&memory_resource};
+          mgp_changes hook_changes{&*changes};
+          hook.on_change(&hook_changes, &memory);
+          hook.rebuilt_at = sequence;
+          if (hook_changes.rebuild_requested) Rebuild(hook);
+        } catch (const std::exception &e) {
+          // The state is rebuilt again before the next changes.
+          hook.rebuilt_at.reset();
+          spdlog::warn("Change hook {}.{} failed: {}", module_name, hook_name, e.what());
+        }
+      });
+}
+
+void ChangeFeed::Rebuild(const mgp_change_hook &hook) {
+  hook.rebuilt_at.reset();
+  std::optional<storage::Storage::Accessor> accessor;
+  uint64_t snapshot{0};
+  {
+    // The commits hold the lock, so the snapshot includes exactly the
+    // published changes.
+    std::lock_guard guard(publish_lock_);
+    accessor.emplace(db_->Access(storage::IsolationLevel::SNAPSHOT_ISOLATION));
+    snapshot = published_;
+  }
+  DbAccessor db_accessor(&*accessor);
+  ExecutionContext ctx;
+  ctx.db_accessor = &db_accessor;
+  ctx.is_shutting_down = is_shutting_down_;
+  ctx.procedure_pool = procedure_pool_;
+  mgp_graph graph{&db_accessor, storage::View::OLD, &ctx};
+  utils::MonotonicBufferResource memory_resource(kHookMemoryBlockSize);
+  mgp_memory memory{&memory_resource};
+  hook.rebuild(&graph, &memory);
+  accessor->Abort();
+  if (MustAbort(ctx)) return;
+  hook.rebuilt_at = snapshot;
+}
+
+}  // namespace query::procedure
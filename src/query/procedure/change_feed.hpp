@@ -0,0 +1,137 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+/// @file
+/// Delivery of the committed changes of the graph to the change hooks of the
+/// query modules.
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_set>
+
+#include "query/procedure/mg_procedure_impl.hpp"
+#include "query/procedure/module.hpp"
+#include "query/trigger_context.hpp"
+#include "storage/v2/storage.hpp"
+#include "utils/result.hpp"
+#include "utils/thread_pool.hpp"
+
+namespace query::procedure {
+
+/// Events which have to be collected from the transactions for the change
+/// hooks.
+std::unordered_set<TriggerEventType> ChangeHookEventTypes();
+
+/// Append the vertices and the edges created and deleted in `context` to
+/// `changes`. The context has to be collected with ChangeHookEventTypes, and
+/// the objects have to be readable, i.e. the transaction can't be finalized.
+void CollectGraphChanges(const TriggerContext &context, GraphChanges *changes);
+
+/// Delivers the changes committed by the transactions to the change hooks of
+/// the loaded modules, on a thread of its own.
+///
+/// The changes are delivered in the order in which the transactions were
+/// committed, and each of them gets a sequence number. The state of a hook is
+/// rebuilt from a snapshot of the graph which is taken while no changes can be
+/// published, so it includes exactly the changes up to the last published
+/// sequence number, and the ones after it are passed to the hook.
+///
+/// All of the commits of the transactions which can change the graph have to
+/// go through CommitAndPublish while any hook is loaded. A commit which
+/// doesn't, e.g. a transaction received from the main instance or an index
+/// creation, is noticed by the next CommitAndPublish from the last commit
+/// timestamp of the storage, and the states of the hooks are rebuilt.
+///
+/// The number of the changed objects which wait for the delivery is limited.
+/// When the hooks fall behind that much, CommitAndPublish waits before
+/// committing until the delivery catches up.
+///
+/// The changes of the transactions which started before a module was loaded
+/// weren't collected, so their commits rebuild the states of the hooks.
+class ChangeFeed final {
+ public:
+  /// Default limit of the number of the created and deleted vertices and edges
+  /// which wait for the delivery.
+  static constexpr size_t kDefaultMaxQueuedObjects = 1U << 20U;
+
+  ChangeFeed(storage::Storage *db, ModuleRegistry *module_registry, std::atomic<bool> *is_shutting_down,
+             utils::ThreadPool *procedure_pool, size_t max_queued_objects = kDefaultMaxQueuedObjects);
+  ~ChangeFeed();
+
+  ChangeFeed(const ChangeFeed &) = delete;
+  ChangeFeed(ChangeFeed &&) = delete;
+  ChangeFeed &operator=(const ChangeFeed &) = delete;
+  ChangeFeed &operator=(ChangeFeed &&) = delete;
+
+  /// Return true if the changes of the transactions have to be collected.
+  bool HasHooks() const noexcept { return module_registry_->HasChangeHooks(); }
+
+  /// Commit the transaction and, if it succeeds, publish its `changes`. The
+  /// commits are serialized while any hook is loaded, so the changes are
+  /// published in the commit order. Without the `changes`, i.e. when they
+  /// weren't collected, the hooks are rebuilt if the commit changed the graph.
+  /// @throw std::bad_alloc
+  utils::BasicResult<storage::ConstraintViolation, void> CommitAndPublish(storage::Storage::Accessor *accessor,
+                                                                          std::optional<GraphChanges> changes);
+
+  /// Wait until all of the changes published so far are delivered.
+  void AwaitDelivery();
+
+ private:
+  struct Delivery {
+    uint64_t sequence;
+    // Without the changes, the hooks whose state doesn't include the commits
+    // up to `sequence` are rebuilt.
+    std::optional<GraphChanges> changes;
+  };
+
+  void Enqueue(Delivery delivery);
+
+  void DeliveryLoop();
+
+  void Deliver(const Delivery &delivery);
+
+  void Rebuild(const mgp_change_hook &hook);
+
+  storage::Storage *db_;
+  ModuleRegistry *module_registry_;
+  std::atomic<bool> *is_shutting_down_;
+  utils::ThreadPool *procedure_pool_;
+  const size_t max_queued_objects_;
+
+  std::mutex publish_lock_;
+  // Sequence number of the last published changes, guarded by publish_lock_.
+  uint64_t published_{0};
+  // Last commit timestamp of the storage after the last commit which went
+  // through the feed, guarded by publish_lock_.
+  uint64_t last_commit_timestamp_;
+
+  std::mutex queue_lock_;
+  // Notified when a delivery is queued, and when the delivery thread is done
+  // with one.
+  std::condition_variable queue_cv_;
+  std::deque<Delivery> queue_;
+  // Number of the objects in the queued changes and in the changes of the
+  // commits which are waiting to be queued.
+  size_t queued_objects_{0};
+  bool delivering_{false};
+  bool stop_{false};
+  // Delivers the changes and rebuilds the hooks in the order of the queue.
+  std::thread delivery_thread_;
+};
+
+}  // namespace query::procedure
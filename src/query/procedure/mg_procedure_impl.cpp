@@ -12,15 +12,19 @@
 #include "query/procedure/mg_procedure_impl.hpp"
 
 #include <algorithm>
+#include <condition_variable>
 #include <cstddef>
 #include <cstring>
 #include <exception>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <regex>
 #include <stdexcept>
+#include <thread>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "mg_procedure.h"
 #include "module.hpp"
@@ -1922,6 +1926,32 @@ mgp_error mgp_edge_get_id(mgp_edge *e, mgp_edge_id *result) {
   return WrapExceptions([e] { return mgp_edge_id{.as_int = e->impl.Gid().AsInt()}; }, result);
 }
 
+mgp_error mgp_edges_iterator_next_batch(mgp_edges_iterator *it, mgp_edge_id *edge_ids, mgp_vertex_id *other_ids,
+                                        size_t capacity, size_t *result) {
+  return WrapExceptions(
+      [=] {
+        MG_ASSERT(it->in || it->out);
+        auto next_batch = [&](auto *impl_it, const auto &end, const auto &get_other) -> size_t {
+          size_t count = 0;
+          for (; count < capacity && *impl_it != end; ++(*impl_it), ++count) {
+            const auto &edge = **impl_it;
+            edge_ids[count] = mgp_edge_id{.as_int = edge.Gid().AsInt()};
+            other_ids[count] = mgp_vertex_id{.as_int = get_other(edge).Gid().AsInt()};
+          }
+          it->current_e = std::nullopt;
+          if (*impl_it != end) {
+            it->current_e.emplace(**impl_it, it->source_vertex.graph, it->GetMemoryResource());
+          }
+          return count;
+        };
+        if (it->in_it) {
+          return next_batch(&*it->in_it, it->in->end(), [](const auto &edge) { return edge.From(); });
+        }
+        return next_batch(&*it->out_it, it->out->end(), [](const auto &edge) { return edge.To(); });
+      },
+      result);
+}
+
 mgp_error mgp_edge_underlying_graph_is_mutable(mgp_edge *e, int *result) {
   return mgp_vertex_underlying_graph_is_mutable(&e->from, result);
 }
@@ -2276,6 +2306,385 @@ mgp_error mgp_vertices_iterator_next(mgp_vertices_iterator *it, mgp_vertex **res
       result);
 }
 
+mgp_error mgp_vertices_iterator_next_batch(mgp_vertices_iterator *it, mgp_vertex_id *ids, size_t capacity,
+                                           size_t *result) {
+  return WrapExceptions(
+      [=] {
+        it->batch.clear();
+        it->batch.reserve(capacity);
+        it->current_v = std::nullopt;
+        size_t count = 0;
+        for (; count < capacity && it->current_it != it->vertices.end(); ++it->current_it, ++count) {
+          it->batch.push_back(*it->current_it);
+          ids[count] = mgp_vertex_id{.as_int = it->batch.back().Gid().AsInt()};
+        }
+        if (it->current_it != it->vertices.end()) {
+          it->current_v.emplace(*it->current_it, it->graph, it->GetMemoryResource());
+        }
+        return count;
+      },
+      result);
+}
+
+mgp_error mgp_vertices_iterator_batch_property(mgp_vertices_iterator *it, const char *property_name,
+                                               mgp_property_column *column) {
+  return WrapExceptions([=] {
+    // The property is looked up once for the whole batch and the values are
+    // stored without allocating a mgp_value for each of them.
+    const auto key = it->graph->impl->NameToProperty(property_name);
+    for (size_t i = 0; i < it->batch.size(); ++i) {
+      auto maybe_prop = it->batch[i].GetProperty(it->graph->view, key);
+      if (maybe_prop.HasError()) {
+        switch (maybe_prop.GetError()) {
+          case storage::Error::DELETED_OBJECT:
+            throw DeletedObjectException{"Cannot get a property of a deleted vertex!"};
+          case storage::Error::NONEXISTENT_OBJECT:
+            LOG_FATAL(
+                "Query modules shouldn't have access to nonexistent objects when getting a property of a vertex.");
+          case storage::Error::PROPERTIES_DISABLED:
+          case storage::Error::VERTEX_HAS_EDGES:
+          case storage::Error::SERIALIZATION_ERROR:
+            LOG_FATAL("Unexpected error when getting a property of a vertex.");
+        }
+      }
+      const auto &value = *maybe_prop;
+      switch (value.type()) {
+        case storage::PropertyValue::Type::Null:
+          column->types[i] = MGP_VALUE_TYPE_NULL;
+          break;
+        case storage::PropertyValue::Type::Bool:
+          column->types[i] = MGP_VALUE_TYPE_BOOL;
+          if (column->ints) column->ints[i] = value.ValueBool() ? 1 : 0;
+          break;
+        case storage::PropertyValue::Type::Int:
+          column->types[i] = MGP_VALUE_TYPE_INT;
+          if (column->ints) column->ints[i] = value.ValueInt();
+          break;
+        case storage::PropertyValue::Type::Double:
+          column->types[i] = MGP_VALUE_TYPE_DOUBLE;
+          if (column->doubles) column->doubles[i] = value.ValueDouble();
+          break;
+        case storage::PropertyValue::Type::String:
+          column->types[i] = MGP_VALUE_TYPE_STRING;
+          break;
+        case storage::PropertyValue::Type::List:
+          column->types[i] = MGP_VALUE_TYPE_LIST;
+          break;
+        case storage::PropertyValue::Type::Map:
+          column->types[i] = MGP_VALUE_TYPE_MAP;
+          break;
+        case storage::PropertyValue::Type::TemporalData:
+          switch (value.ValueTemporalData().type) {
+            case storage::TemporalType::Date:
+              column->types[i] = MGP_VALUE_TYPE_DATE;
+              break;
+            case storage::TemporalType::LocalTime:
+              column->types[i] = MGP_VALUE_TYPE_LOCAL_TIME;
+              break;
+            case storage::TemporalType::LocalDateTime:
+              column->types[i] = MGP_VALUE_TYPE_LOCAL_DATE_TIME;
+              break;
+            case storage::TemporalType::Duration:
+              column->types[i] = MGP_VALUE_TYPE_DURATION;
+              break;
+          }
+          break;
+      }
+    }
+  });
+}
+
+namespace {
+
+// The vertices are split between the threads building the projection, but a
+// thread isn't started for less than this many vertices.
+constexpr size_t kProjectionMinVerticesPerThread = 4096;
+
+// Splits the vertices into contiguous parts, one for each thread. The part
+// `i` consists of the vertices from `result[i]` up to `result[i + 1]`.
+std::vector<size_t> SplitProjection(const size_t vertex_count) {
+  const size_t max_threads = std::max(1U, std::thread::hardware_concurrency());
+  const size_t parts = std::clamp<size_t>(vertex_count / kProjectionMinVerticesPerThread, 1, max_threads);
+  std::vector<size_t> bounds(parts + 1);
+  for (size_t i = 0; i <= parts; ++i) {
+    bounds[i] = vertex_count * i / parts;
+  }
+  return bounds;
+}
+
+// Calls `func(part)` for each of the parts in a thread of its own and rethrows
+// the exception of the first part which failed.
+template <class TFunc>
+void ForEachProjectionPart(const size_t parts, const TFunc &func) {
+  std::vector<std::exception_ptr> exceptions(parts);
+  auto run = [&](const size_t part) {
+    try {
+      func(part);
+    } catch (...) {
+      exceptions[part] = std::current_exception();
+    }
+  };
+  std::vector<std::thread> threads;
+  threads.reserve(parts - 1);
+  for (size_t part = 1; part < parts; ++part) {
+    threads.emplace_back(run, part);
+  }
+  run(0);
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (const auto &exception : exceptions) {
+    if (exception) std::rethrow_exception(exception);
+  }
+}
+
+template <class TResult>
+void CheckProjectionResult(const TResult &result) {
+  if (!result.HasError()) return;
+  switch (result.GetError()) {
+    case storage::Error::DELETED_OBJECT:
+      throw DeletedObjectException{"Cannot project a deleted object!"};
+    case storage::Error::NONEXISTENT_OBJECT:
+      LOG_FATAL("Query modules shouldn't have access to nonexistent objects when projecting the graph.");
+    case storage::Error::PROPERTIES_DISABLED:
+    case storage::Error::VERTEX_HAS_EDGES:
+    case storage::Error::SERIALIZATION_ERROR:
+      LOG_FATAL("Unexpected error when projecting the graph.");
+  }
+}
+
+struct ProjectionEdges {
+  std::vector<uint64_t> ends;
+  std::vector<double> weights;
+};
+
+// Projects the edges of one direction. `get_edges` returns the edges of a
+// vertex in that direction and `get_other_end` returns the other vertex of an
+// edge. The edges are collected by the threads first, since the number of the
+// edges isn't known, and only then copied into the arrays which are allocated
+// with the memory of the projection, because that memory isn't thread safe.
+template <class TGetEdges, class TGetOtherEnd>
+void ProjectEdges(const std::vector<query::VertexAccessor> &vertices, const std::vector<size_t> &bounds,
+                  const utils::pmr::vector<int64_t> &vertex_ids,
+                  const std::optional<storage::PropertyId> weight_property, const double default_weight,
+                  const TGetEdges &get_edges, const TGetOtherEnd &get_other_end, const storage::View view,
+                  utils::pmr::vector<uint64_t> *offsets, utils::pmr::vector<uint64_t> *ends,
+                  utils::pmr::vector<double> *weights) {
+  const auto parts = bounds.size() - 1;
+  offsets->resize(vertices.size() + 1, 0);
+  std::vector<ProjectionEdges> part_edges(parts);
+  ForEachProjectionPart(parts, [&](const size_t part) {
+    auto &edges = part_edges[part];
+    for (auto i = bounds[part]; i < bounds[part + 1]; ++i) {
+      const auto maybe_edges = get_edges(vertices[i]);
+      CheckProjectionResult(maybe_edges);
+      uint64_t degree = 0;
+      for (const auto &edge : *maybe_edges) {
+        const auto other_id = get_other_end(edge).Gid().AsInt();
+        const auto it = std::lower_bound(vertex_ids.begin(), vertex_ids.end(), other_id);
+        // The other end isn't projected, so neither is the edge.
+        if (it == vertex_ids.end() || *it != other_id) continue;
+        edges.ends.push_back(it - vertex_ids.begin());
+        if (weight_property) {
+          const auto maybe_weight = edge.GetProperty(view, *weight_property);
+          CheckProjectionResult(maybe_weight);
+          const auto &weight = *maybe_weight;
+          if (weight.IsNull()) {
+            edges.weights.push_back(default_weight);
+          } else if (weight.IsInt()) {
+            edges.weights.push_back(static_cast<double>(weight.ValueInt()));
+          } else if (weight.IsDouble()) {
+            edges.weights.push_back(weight.ValueDouble());
+          } else {
+            throw ValueConversionException{"The weight property of a projected edge has to be a number!"};
+          }
+        }
+        ++degree;
+      }
+      (*offsets)[i + 1] = degree;
+    }
+  });
+
+  for (size_t i = 0; i < vertices.size(); ++i) {
+    (*offsets)[i + 1] += (*offsets)[i];
+  }
+  ends->resize(offsets->back());
+  if (weight_property) weights->resize(offsets->back());
+  ForEachProjectionPart(parts, [&](const size_t part) {
+    const auto &edges = part_edges[part];
+    const auto begin = (*offsets)[bounds[part]];
+    std::copy(edges.ends.begin(), edges.ends.end(), ends->begin() + begin);
+    if (weight_property) std::copy(edges.weights.begin(), edges.weights.end(), weights->begin() + begin);
+  });
+}
+
+}  // namespace
+
+void mgp_graph_projection_destroy(mgp_graph_projection *projection) { DeleteRawMgpObject(projection); }
+
+mgp_error mgp_graph_project(mgp_graph *graph, mgp_graph_projection_config *config, mgp_memory *memory,
+                            mgp_graph_projection **result) {
+  return WrapExceptions(
+      [graph, config, memory] {
+        auto projection = NewMgpObject<mgp_graph_projection>(memory);
+        const auto view = graph->view;
+        std::optional<storage::LabelId> label;
+        if (config->vertex_label) label = graph->impl->NameToLabel(config->vertex_label);
+        std::vector<storage::EdgeTypeId> edge_types;
+        if (config->edge_type) edge_types.push_back(graph->impl->NameToEdgeType(config->edge_type));
+        std::optional<storage::PropertyId> weight_property;
+        if (config->weight_property) weight_property = graph->impl->NameToProperty(config->weight_property);
+
+        // The vertices are collected in a single thread, because the storage
+        // iterators can't be split. Only the label index has to be sorted,
+        // the vertices of the whole graph are already ordered by their IDs.
+        std::vector<query::VertexAccessor> vertices;
+        const bool use_label_index = label && graph->impl->LabelIndexExists(*label);
+        for (auto vertex : use_label_index ? graph->impl->Vertices(view, *label) : graph->impl->Vertices(view)) {
+          vertices.push_back(vertex);
+        }
+        const auto by_id = [](const auto &lhs, const auto &rhs) { return lhs.Gid() < rhs.Gid(); };
+        if (!std::is_sorted(vertices.begin(), vertices.end(), by_id)) {
+          std::sort(vertices.begin(), vertices.end(), by_id);
+        }
+
+        if (label && !use_label_index) {
+          std::vector<uint8_t> has_label(vertices.size());
+          const auto bounds = SplitProjection(vertices.size());
+          ForEachProjectionPart(bounds.size() - 1, [&](const size_t part) {
+            for (auto i = bounds[part]; i < bounds[part + 1]; ++i) {
+              const auto maybe_has_label = vertices[i].HasLabel(view, *label);
+              CheckProjectionResult(maybe_has_label);
+              has_label[i] = *maybe_has_label;
+            }
+          });
+          size_t kept = 0;
+          for (size_t i = 0; i < vertices.size(); ++i) {
+            if (has_label[i]) vertices[kept++] = vertices[i];
+          }
+          vertices.erase(vertices.begin() + kept, vertices.end());
+        }
+
+        projection->vertex_ids.reserve(vertices.size());
+        for (const auto &vertex : vertices) {
+          projection->vertex_ids.push_back(vertex.Gid().AsInt());
+        }
+        projection->has_weights = weight_property.has_value();
+        projection->has_in_edges = config->include_in_edges != 0;
+
+        // Reading the graph from multiple threads is safe, because all of them
+        // only read the objects which are visible to the same transaction.
+        const auto bounds = SplitProjection(vertices.size());
+        ProjectEdges(
+            vertices, bounds, projection->vertex_ids, weight_property, config->default_weight,
+            [&](const auto &vertex) { return vertex.OutEdges(view, edge_types); },
+            [](const auto &edge) { return edge.To(); }, view, &projection->out_offsets, &projection->out_targets,
+            &projection->out_weights);
+        if (projection->has_in_edges) {
+          ProjectEdges(
+              vertices, bounds, projection->vertex_ids, weight_property, config->default_weight,
+              [&](const auto &vertex) { return vertex.InEdges(view, edge_types); },
+              [](const auto &edge) { return edge.From(); }, view, &projection->in_offsets, &projection->in_sources,
+              &projection->in_weights);
+        }
+        return projection.release();
+      },
+      result);
+}
+
+mgp_error mgp_graph_projection_vertex_count(mgp_graph_projection *projection, size_t *result) {
+  return WrapExceptions([projection] { return projection->vertex_ids.size(); }, result);
+}
+
+mgp_error mgp_graph_projection_edge_count(mgp_graph_projection *projection, size_t *result) {
+  return WrapExceptions([projection] { return projection->out_targets.size(); }, result);
+}
+
+mgp_error mgp_graph_projection_vertex_ids(mgp_graph_projection *projection, const int64_t **result) {
+  return WrapExceptions([projection] { return projection->vertex_ids.data(); }, result);
+}
+
+mgp_error mgp_graph_projection_vertex_ordinal(mgp_graph_projection *projection, mgp_vertex_id id, uint64_t *result) {
+  return WrapExceptions(
+      [projection, id]() -> uint64_t {
+        const auto &ids = projection->vertex_ids;
+        const auto it = std::lower_bound(ids.begin(), ids.end(), id.as_int);
+        if (it == ids.end() || *it != id.as_int) {
+          throw std::out_of_range("The vertex isn't projected.");
+        }
+        return it - ids.begin();
+      },
+      result);
+}
+
+mgp_error mgp_graph_projection_out_offsets(mgp_graph_projection *projection, const uint64_t **result) {
+  return WrapExceptions([projection] { return projection->out_offsets.data(); }, result);
+}
+
+mgp_error mgp_graph_projection_out_targets(mgp_graph_projection *projection, const uint64_t **result) {
+  return WrapExceptions([projection] { return projection->out_targets.data(); }, result);
+}
+
+mgp_error mgp_graph_projection_out_weights(mgp_graph_projection *projection, const double **result) {
+  return WrapExceptions(
+      [projection]() -> const double * { return projection->has_weights ? projection->out_weights.data() : nullptr; },
+      result);
+}
+
+mgp_error mgp_graph_projection_in_offsets(mgp_graph_projection *projection, const uint64_t **result) {
+  return WrapExceptions(
+      [projection]() -> const uint64_t * {
+        return projection->has_in_edges ? projection->in_offsets.data() : nullptr;
+      },
+      result);
+}
+
+mgp_error mgp_graph_projection_in_sources(mgp_graph_projection *projection, const uint64_t **result) {
+  return WrapExceptions(
+      [projection]() -> const uint64_t * {
+        return projection->has_in_edges ? projection->in_sources.data() : nullptr;
+      },
+      result);
+}
+
+mgp_error mgp_graph_projection_in_weights(mgp_graph_projection *projection, const double **result) {
+  return WrapExceptions(
+      [projection]() -> const double * {
+        return projection->has_in_edges && projection->has_weights ? projection->in_weights.data() : nullptr;
+      },
+      result);
+}
+
+mgp_error mgp_graph_projection_vertex_property(mgp_graph *graph, mgp_graph_projection *projection,
+                                               const char *property_name, double default_value, double *result) {
+  return WrapExceptions([=] {
+    const auto view = graph->view;
+    const auto property = graph->impl->NameToProperty(property_name);
+    const auto &vertex_ids = projection->vertex_ids;
+    const auto bounds = SplitProjection(vertex_ids.size());
+    ForEachProjectionPart(bounds.size() - 1, [&](const size_t part) {
+      for (auto i = bounds[part]; i < bounds[part + 1]; ++i) {
+        const auto vertex = graph->impl->FindVertex(storage::Gid::FromInt(vertex_ids[i]), view);
+        if (!vertex) {
+          throw DeletedObjectException{"Cannot read the property of a deleted vertex!"};
+        }
+        const auto maybe_value = vertex->GetProperty(view, property);
+        CheckProjectionResult(maybe_value);
+        const auto &value = *maybe_value;
+        if (value.IsNull()) {
+          result[i] = default_value;
+        } else if (value.IsInt()) {
+          result[i] = static_cast<double>(value.ValueInt());
+        } else if (value.IsDouble()) {
+          result[i] = value.ValueDouble();
+        } else {
+          throw ValueConversionException{"The projected property of a vertex has to be a number!"};
+        }
+      }
+    });
+  });
+}
+
 /// Type System
 ///
 /// All types are allocated globally, so that we simplify the API and minimize
@@ -2376,6 +2785,18 @@ mgp_error mgp_module_add_write_procedure(mgp_module *module, const char *name, m
   return WrapExceptions([=] { return mgp_module_add_procedure(module, name, cb, {.is_write = true}); }, result);
 }
 
+mgp_error mgp_module_add_batch_read_procedure(mgp_module *module, const char *name, mgp_proc_batch_cb cb,
+                                              mgp_proc_batch_init init, mgp_proc_batch_cleanup cleanup,
+                                              mgp_proc **result) {
+  return WrapExceptions(
+      [=] {
+        auto *proc = mgp_module_add_procedure(module, name, nullptr, {.is_write = false});
+        proc->batch.emplace(BatchProcedure{cb, init, cleanup});
+        return proc;
+      },
+      result);
+}
+
 mgp_error mgp_proc_add_arg(mgp_proc *proc, const char *name, mgp_type *type) {
   return WrapExceptions([=] {
     if (!IsValidIdentifierName(name)) {
@@ -2470,6 +2891,101 @@ int mgp_must_abort(mgp_graph *graph) {
   return query::MustAbort(*graph->ctx) ? 1 : 0;
 }
 
+namespace {
+
+constexpr size_t kWorkerInitialMemory = 8 * 1024;
+
+// State of a mgp_graph_parallel_for call, shared with the workers. The workers
+// which start after all of the tasks were taken only look at the counters, so
+// they don't touch the rest of the state which belongs to the call.
+struct ParallelForState {
+  ParallelForState(mgp_graph *graph, size_t task_count, mgp_task_cb task, void *data, mgp_memory *memory)
+      : graph(graph), task_count(task_count), task(task), data(data), memory(memory->impl) {}
+
+  mgp_graph *graph;
+  size_t task_count;
+  mgp_task_cb task;
+  void *data;
+  // The threads allocate their memory from the procedure's memory one at a
+  // time, so the procedure's memory limit applies to all of them.
+  utils::SynchronizedMemoryResource memory;
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  size_t next_task{0};
+  size_t active_workers{0};
+  std::exception_ptr exception;
+};
+
+// Takes the tasks of `state` until there are none left.
+void ExecuteParallelForTasks(ParallelForState *state) {
+  {
+    std::lock_guard guard(state->mutex);
+    if (state->next_task == state->task_count) return;
+    ++state->active_workers;
+  }
+  {
+    // Like the procedure's memory, the memory of a worker is only released at
+    // the end, which keeps the allocations of the tasks cheap.
+    utils::MonotonicBufferResource worker_memory(kWorkerInitialMemory, &state->memory);
+    mgp_memory memory{&worker_memory};
+    while (true) {
+      size_t task = 0;
+      {
+        std::lock_guard guard(state->mutex);
+        if (state->next_task == state->task_count) break;
+        if (state->graph->ctx && query::MustAbort(*state->graph->ctx)) {
+          state->next_task = state->task_count;
+          break;
+        }
+        task = state->next_task++;
+      }
+      try {
+        state->task(task, state->graph, &memory, state->data);
+      } catch (...) {
+        std::lock_guard guard(state->mutex);
+        if (!state->exception) state->exception = std::current_exception();
+        state->next_task = state->task_count;
+      }
+    }
+  }
+  std::lock_guard guard(state->mutex);
+  if (--state->active_workers == 0) state->cv.notify_all();
+}
+
+size_t ProcedureWorkerCount(const mgp_graph &graph) {
+  if (!graph.ctx || !graph.ctx->procedure_pool) return 1;
+  return graph.ctx->procedure_pool->Size() + 1;
+}
+
+}  // namespace
+
+mgp_error mgp_graph_worker_count(mgp_graph *graph, size_t *result) {
+  return WrapExceptions([graph] { return ProcedureWorkerCount(*graph); }, result);
+}
+
+mgp_error mgp_graph_parallel_for(mgp_graph *graph, size_t task_count, mgp_task_cb task, void *data,
+                                 mgp_memory *memory) {
+  return WrapExceptions([=] {
+    // The accessors only support concurrent reads, and the changes are also
+    // collected for the triggers and the query statistics, which isn't thread
+    // safe.
+    if (MgpGraphIsMutable(*graph)) {
+      throw std::logic_error{"Only read procedures can execute tasks in parallel!"};
+    }
+    auto state = std::make_shared<ParallelForState>(graph, task_count, task, data, memory);
+    // The calling thread takes one of the tasks as well.
+    const auto pool_workers = std::min(ProcedureWorkerCount(*graph) - 1, task_count > 0 ? task_count - 1 : 0);
+    for (size_t i = 0; i < pool_workers; ++i) {
+      graph->ctx->procedure_pool->AddTask([state] { ExecuteParallelForTasks(state.get()); });
+    }
+    ExecuteParallelForTasks(state.get());
+    std::unique_lock lock(state->mutex);
+    state->cv.wait(lock, [&] { return state->active_workers == 0; });
+    if (state->exception) std::rethrow_exception(state->exception);
+  });
+}
+
 namespace query::procedure {
 
 namespace {
@@ -2705,3 +3221,48 @@ mgp_error mgp_module_add_transformation(mgp_module *module, const char *name, mg
     module->transformations.emplace(name, mgp_trans(name, cb, memory));
   });
 }
+
+mgp_error mgp_changes_created_vertices(mgp_changes *changes, const mgp_vertex_id **ids, size_t *count) {
+  *ids = changes->changes->created_vertices.data();
+  *count = changes->changes->created_vertices.size();
+  return MGP_ERROR_NO_ERROR;
+}
+
+mgp_error mgp_changes_deleted_vertices(mgp_changes *changes, const mgp_vertex_id **ids, size_t *count) {
+  *ids = changes->changes->deleted_vertices.data();
+  *count = changes->changes->deleted_vertices.size();
+  return MGP_ERROR_NO_ERROR;
+}
+
+mgp_error mgp_changes_created_edges(mgp_changes *changes, const mgp_edge_change **edges, size_t *count) {
+  *edges = changes->changes->created_edges.data();
+  *count = changes->changes->created_edges.size();
+  return MGP_ERROR_NO_ERROR;
+}
+
+mgp_error mgp_changes_deleted_edges(mgp_changes *changes, const mgp_edge_change **edges, size_t *count) {
+  *edges = changes->changes->deleted_edges.data();
+  *count = changes->changes->deleted_edges.size();
+  return MGP_ERROR_NO_ERROR;
+}
+
+mgp_error mgp_changes_request_rebuild(mgp_changes *changes) {
+  changes->rebuild_requested = true;
+  return MGP_ERROR_NO_ERROR;
+}
+
+mgp_error mgp_module_add_change_hook(mgp_module *module, const char *name, mgp_rebuild_cb rebuild,
+                                     mgp_change_cb on_change) {
+  return WrapExceptions([=] {
+    if (!IsValidIdentifierName(name)) {
+      throw std::invalid_argument{fmt::format("Invalid change hook name: {}", name)};
+    }
+    if (!rebuild || !on_change) {
+      throw std::invalid_argument{fmt::format("Change hook '{}' needs both of the callbacks", name)};
+    }
+    if (module->change_hooks.find(name) != module->change_hooks.end()) {
+      throw std::logic_error{fmt::format("Change hook already exists with name '{}'", name)};
+    };
+    module->change_hooks.emplace(name, mgp_change_hook{rebuild, on_change, std::nullopt});
+  });
+}
@@ -18,6 +18,7 @@
 
 #include <optional>
 #include <ostream>
+#include <vector>
 
 #include "integrations/kafka/consumer.hpp"
 #include "integrations/pulsar/consumer.hpp"
@@ -635,7 +636,11 @@ struct mgp_vertices_iterator {
 
   /// @throw anything VerticesIterable may throw
   mgp_vertices_iterator(mgp_graph *graph, utils::MemoryResource *memory)
-      : memory(memory), graph(graph), vertices(graph->impl->Vertices(graph->view)), current_it(vertices.begin()) {
+      : memory(memory),
+        graph(graph),
+        vertices(graph->impl->Vertices(graph->view)),
+        current_it(vertices.begin()),
+        batch(memory) {
     if (current_it != vertices.end()) {
       current_v.emplace(*current_it, graph, memory);
     }
@@ -648,6 +653,40 @@ struct mgp_vertices_iterator {
   decltype(graph->impl->Vertices(graph->view)) vertices;
   decltype(vertices.begin()) current_it;
   std::optional<mgp_vertex> current_v;
+  // Vertices returned by the last mgp_vertices_iterator_next_batch.
+  utils::pmr::vector<query::VertexAccessor> batch;
+};
+
+struct mgp_graph_projection {
+  using allocator_type = utils::Allocator<mgp_graph_projection>;
+
+  explicit mgp_graph_projection(utils::MemoryResource *memory)
+      : vertex_ids(memory),
+        out_offsets(memory),
+        out_targets(memory),
+        out_weights(memory),
+        in_offsets(memory),
+        in_sources(memory),
+        in_weights(memory) {}
+
+  mgp_graph_projection(const mgp_graph_projection &) = delete;
+  mgp_graph_projection(mgp_graph_projection &&) = delete;
+  mgp_graph_projection &operator=(const mgp_graph_projection &) = delete;
+  mgp_graph_projection &operator=(mgp_graph_projection &&) = delete;
+  ~mgp_graph_projection() = default;
+
+  utils::MemoryResource *GetMemoryResource() const noexcept { return vertex_ids.get_allocator().GetMemoryResource(); }
+
+  // Sorted, so the ordinal of a vertex is found with a binary search.
+  utils::pmr::vector<int64_t> vertex_ids;
+  utils::pmr::vector<uint64_t> out_offsets;
+  utils::pmr::vector<uint64_t> out_targets;
+  utils::pmr::vector<double> out_weights;
+  utils::pmr::vector<uint64_t> in_offsets;
+  utils::pmr::vector<uint64_t> in_sources;
+  utils::pmr::vector<double> in_weights;
+  bool has_weights{false};
+  bool has_in_edges{false};
 };
 
 struct mgp_type {
@@ -658,6 +697,14 @@ struct ProcedureInfo {
   bool is_write = false;
   std::optional<query::AuthQuery::Privilege> required_privilege = std::nullopt;
 };
+
+/// Entry-points of a procedure which produces its results in batches.
+struct BatchProcedure {
+  mgp_proc_batch_cb cb;
+  mgp_proc_batch_init init;
+  mgp_proc_batch_cleanup cleanup;
+};
+
 struct mgp_proc {
   using allocator_type = utils::Allocator<mgp_proc>;
 
@@ -686,7 +733,8 @@ struct mgp_proc {
         args(other.args, memory),
         opt_args(other.opt_args, memory),
         results(other.results, memory),
-        info(other.info) {}
+        info(other.info),
+        batch(other.batch) {}
 
   mgp_proc(mgp_proc &&other, utils::MemoryResource *memory)
       : name(std::move(other.name), memory),
@@ -694,7 +742,8 @@ struct mgp_proc {
         args(std::move(other.args), memory),
         opt_args(std::move(other.opt_args), memory),
         results(std::move(other.results), memory),
-        info(other.info) {}
+        info(other.info),
+        batch(other.batch) {}
 
   mgp_proc(const mgp_proc &other) = default;
   mgp_proc(mgp_proc &&other) = default;
@@ -715,6 +764,9 @@ struct mgp_proc {
   /// Fields this procedure returns, as a (name -> (type, is_deprecated)) map.
   utils::pmr::map<utils::pmr::string, std::pair<const query::procedure::CypherType *, bool>> results;
   ProcedureInfo info;
+  /// Set if the procedure produces its results in batches, in which case `cb`
+  /// isn't used.
+  std::optional<BatchProcedure> batch;
 };
 
 struct mgp_trans {
@@ -757,16 +809,56 @@ struct mgp_trans {
 
 mgp_error MgpTransAddFixedResult(mgp_trans *trans) noexcept;
 
+/// Entry-points of a change hook.
+struct mgp_change_hook {
+  mgp_rebuild_cb rebuild;
+  mgp_change_cb on_change;
+  /// Sequence number of the last changes which are included in the state of
+  /// the hook, or nullopt if the state has to be rebuilt. Only used by the
+  /// thread which delivers the changes.
+  mutable std::optional<uint64_t> rebuilt_at;
+};
+
+namespace query::procedure {
+
+/// Vertices and edges created and deleted by a committed transaction.
+struct GraphChanges {
+  std::vector<mgp_vertex_id> created_vertices;
+  std::vector<mgp_vertex_id> deleted_vertices;
+  std::vector<mgp_edge_change> created_edges;
+  std::vector<mgp_edge_change> deleted_edges;
+
+  bool Empty() const {
+    return created_vertices.empty() && deleted_vertices.empty() && created_edges.empty() && deleted_edges.empty();
+  }
+
+  size_t Size() const {
+    return created_vertices.size() + deleted_vertices.size() + created_edges.size() + deleted_edges.size();
+  }
+};
+
+}  // namespace query::procedure
+
+struct mgp_changes {
+  const query::procedure::GraphChanges *changes;
+  bool rebuild_requested{false};
+};
+
 struct mgp_module {
   using allocator_type = utils::Allocator<mgp_module>;
 
-  explicit mgp_module(utils::MemoryResource *memory) : procedures(memory), transformations(memory) {}
+  explicit mgp_module(utils::MemoryResource *memory)
+      : procedures(memory), transformations(memory), change_hooks(memory) {}
 
   mgp_module(const mgp_module &other, utils::MemoryResource *memory)
-      : procedures(other.procedures, memory), transformations(other.transformations, memory) {}
+      : procedures(other.procedures, memory),
+        transformations(other.transformations, memory),
+        change_hooks(other.change_hooks, memory) {}
 
   mgp_module(mgp_module &&other, utils::MemoryResource *memory)
-      : procedures(std::move(other.procedures), memory), transformations(std::move(other.transformations), memory) {}
+      : procedures(std::move(other.procedures), memory),
+        transformations(std::move(other.transformations), memory),
+        change_hooks(std::move(other.change_hooks), memory) {}
 
   mgp_module(const mgp_module &) = default;
   mgp_module(mgp_module &&) = default;
@@ -778,6 +870,7 @@ struct mgp_module {
 
   utils::pmr::map<utils::pmr::string, mgp_proc> procedures;
   utils::pmr::map<utils::pmr::string, mgp_trans> transformations;
+  utils::pmr::map<utils::pmr::string, mgp_change_hook> change_hooks;
 };
 
 namespace query::procedure {
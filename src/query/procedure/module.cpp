@@ -13,6 +13,8 @@
 
 #include <filesystem>
 #include <optional>
+#include <tuple>
+#include <vector>
 
 extern "C" {
 #include <dlfcn.h>
@@ -52,6 +54,8 @@ class BuiltinModule final : public Module {
 
   const std::map<std::string, mgp_trans, std::less<>> *Transformations() const override;
 
+  const std::map<std::string, mgp_change_hook, std::less<>> *ChangeHooks() const override;
+
   void AddProcedure(std::string_view name, mgp_proc proc);
 
   void AddTransformation(std::string_view name, mgp_trans trans);
@@ -62,6 +66,7 @@ class BuiltinModule final : public Module {
   /// Registered procedures
   std::map<std::string, mgp_proc, std::less<>> procedures_;
   std::map<std::string, mgp_trans, std::less<>> transformations_;
+  std::map<std::string, mgp_change_hook, std::less<>> change_hooks_;
 };
 
 BuiltinModule::BuiltinModule() {}
@@ -76,6 +81,10 @@ const std::map<std::string, mgp_trans, std::less<>> *BuiltinModule::Transformati
   return &transformations_;
 }
 
+const std::map<std::string, mgp_change_hook, std::less<>> *BuiltinModule::ChangeHooks() const {
+  return &change_hooks_;
+}
+
 void BuiltinModule::AddProcedure(std::string_view name, mgp_proc proc) { procedures_.emplace(name, std::move(proc)); }
 
 void BuiltinModule::AddTransformation(std::string_view name, mgp_trans trans) {
@@ -646,12 +655,12 @@ void RegisterMgDeleteModuleFile(ModuleRegistry *module_registry, utils::RWLock *
 }
 
 // Run `fun` with `mgp_module *` and `mgp_memory *` arguments. If `fun` returned
-// a `true` value, store the `mgp_module::procedures` and
-// `mgp_module::transformations into `proc_map`. The return value of WithModuleRegistration
-// is the same as that of `fun`. Note, the return value need only be convertible to `bool`,
-// it does not have to be `bool` itself.
-template <class TProcMap, class TTransMap, class TFun>
-auto WithModuleRegistration(TProcMap *proc_map, TTransMap *trans_map, const TFun &fun) {
+// a `true` value, store the `mgp_module::procedures`, `mgp_module::transformations`
+// and `mgp_module::change_hooks` into `proc_map`, `trans_map` and `hook_map`. The return
+// value of WithModuleRegistration is the same as that of `fun`. Note, the return value need
+// only be convertible to `bool`, it does not have to be `bool` itself.
+template <class TProcMap, class TTransMap, class THookMap, class TFun>
+auto WithModuleRegistration(TProcMap *proc_map, TTransMap *trans_map, THookMap *hook_map, const TFun &fun) {
   // We probably don't need more than 256KB for module initialization.
   constexpr size_t stack_bytes = 256 * 1024;
   unsigned char stack_memory[stack_bytes];
@@ -664,6 +673,8 @@ auto WithModuleRegistration(TProcMap *proc_map, TTransMap *trans_map, const TFun
     for (const auto &proc : module_def.procedures) proc_map->emplace(proc);
     // Copy transformations into resulting trans_map.
     for (const auto &trans : module_def.transformations) trans_map->emplace(trans);
+    // Copy change hooks into resulting hook_map.
+    for (const auto &hook : module_def.change_hooks) hook_map->emplace(hook);
   }
   return res;
 }
@@ -687,6 +698,8 @@ class SharedLibraryModule final : public Module {
 
   const std::map<std::string, mgp_trans, std::less<>> *Transformations() const override;
 
+  const std::map<std::string, mgp_change_hook, std::less<>> *ChangeHooks() const override;
+
   std::optional<std::filesystem::path> Path() const override { return file_path_; }
 
  private:
@@ -702,6 +715,8 @@ class SharedLibraryModule final : public Module {
   std::map<std::string, mgp_proc, std::less<>> procedures_;
   /// Registered transformations
   std::map<std::string, mgp_trans, std::less<>> transformations_;
+  /// Registered change hooks
+  std::map<std::string, mgp_change_hook, std::less<>> change_hooks_;
 };
 
 SharedLibraryModule::SharedLibraryModule() : handle_(nullptr) {}
@@ -755,7 +770,7 @@ bool SharedLibraryModule::Load(const std::filesystem::path &file_path) {
     }
     return true;
   };
-  if (!WithModuleRegistration(&procedures_, &transformations_, module_cb)) {
+  if (!WithModuleRegistration(&procedures_, &transformations_, &change_hooks_, module_cb)) {
     return false;
   }
   // Get optional mgp_shutdown_module
@@ -784,6 +799,7 @@ bool SharedLibraryModule::Close() {
   spdlog::info("Closed module {}", file_path_);
   handle_ = nullptr;
   procedures_.clear();
+  change_hooks_.clear();
   return true;
 }
 
@@ -801,6 +817,13 @@ const std::map<std::string, mgp_trans, std::less<>> *SharedLibraryModule::Transf
   return &transformations_;
 }
 
+const std::map<std::string, mgp_change_hook, std::less<>> *SharedLibraryModule::ChangeHooks() const {
+  MG_ASSERT(handle_,
+            "Attempting to access change hooks of a module that has not "
+            "been loaded...");
+  return &change_hooks_;
+}
+
 class PythonModule final : public Module {
  public:
   PythonModule();
@@ -816,6 +839,7 @@ class PythonModule final : public Module {
 
   const std::map<std::string, mgp_proc, std::less<>> *Procedures() const override;
   const std::map<std::string, mgp_trans, std::less<>> *Transformations() const override;
+  const std::map<std::string, mgp_change_hook, std::less<>> *ChangeHooks() const override;
   std::optional<std::filesystem::path> Path() const override { return file_path_; }
 
  private:
@@ -823,6 +847,7 @@ class PythonModule final : public Module {
   py::Object py_module_;
   std::map<std::string, mgp_proc, std::less<>> procedures_;
   std::map<std::string, mgp_trans, std::less<>> transformations_;
+  std::map<std::string, mgp_change_hook, std::less<>> change_hooks_;
 };
 
 PythonModule::PythonModule() {}
@@ -853,7 +878,7 @@ bool PythonModule::Load(const std::filesystem::path &file_path) {
     };
     return result;
   };
-  py_module_ = WithModuleRegistration(&procedures_, &transformations_, module_cb);
+  py_module_ = WithModuleRegistration(&procedures_, &transformations_, &change_hooks_, module_cb);
   if (py_module_) {
     spdlog::info("Loaded module {}", file_path);
 
@@ -906,6 +931,13 @@ const std::map<std::string, mgp_trans, std::less<>> *PythonModule::Transformatio
             "not been loaded...");
   return &transformations_;
 }
+
+const std::map<std::string, mgp_change_hook, std::less<>> *PythonModule::ChangeHooks() const {
+  MG_ASSERT(py_module_,
+            "Attempting to access change hooks of a module that has "
+            "not been loaded...");
+  return &change_hooks_;
+}
 namespace {
 
 std::unique_ptr<Module> LoadModuleFromFile(const std::filesystem::path &path) {
@@ -937,7 +969,13 @@ bool ModuleRegistry::RegisterModule(const std::string_view &name, std::unique_pt
         utils::MessageWithLink("Unable to overwrite an already loaded module {}.", name, "https://memgr.ph/modules"));
     return false;
   }
+  const auto change_hooks = module->ChangeHooks()->size();
+  module->load_id_ = ++last_load_id_;
   modules_.emplace(name, std::move(module));
+  if (change_hooks > 0) {
+    change_hook_count_.fetch_add(change_hooks, std::memory_order_acq_rel);
+    if (change_hook_listener_) change_hook_listener_();
+  }
   return true;
 }
 
@@ -948,6 +986,7 @@ void ModuleRegistry::DoUnloadAllModules() {
   auto module = std::move(modules_["mg"]);
   modules_.clear();
   modules_.emplace("mg", std::move(module));
+  change_hook_count_.store(0, std::memory_order_release);
 }
 
 ModuleRegistry::ModuleRegistry() {
@@ -973,6 +1012,31 @@ void ModuleRegistry::SetModulesDirectory(std::vector<std::filesystem::path> modu
 
 const std::vector<std::filesystem::path> &ModuleRegistry::GetModulesDirectory() const { return modules_dirs_; }
 
+bool ModuleRegistry::HasChangeHooks() const noexcept {
+  return change_hook_count_.load(std::memory_order_acquire) > 0;
+}
+
+void ModuleRegistry::ForEachChangeHook(
+    const std::function<void(std::string_view module_name, std::string_view hook_name, const mgp_change_hook &hook)>
+        &function) const {
+  std::lock_guard hooks_guard(change_hooks_lock_);
+  std::vector<std::tuple<std::string_view, std::string_view, const mgp_change_hook *>> hooks;
+  {
+    std::shared_lock<utils::RWLock> guard(lock_);
+    for (const auto &[module_name, module] : modules_) {
+      for (const auto &[hook_name, hook] : *module->ChangeHooks()) hooks.emplace_back(module_name, hook_name, &hook);
+    }
+  }
+  // The modules which are loaded meanwhile don't invalidate the hooks, and
+  // the ones which are unloaded first wait for the `change_hooks_lock_`.
+  for (const auto &[module_name, hook_name, hook] : hooks) function(module_name, hook_name, *hook);
+}
+
+void ModuleRegistry::SetChangeHookListener(std::function<void()> listener) {
+  std::unique_lock<utils::RWLock> guard(lock_);
+  change_hook_listener_ = std::move(listener);
+}
+
 bool ModuleRegistry::LoadModuleIfFound(const std::filesystem::path &modules_dir, const std::string_view name) {
   if (!utils::DirExists(modules_dir)) {
     spdlog::error(
@@ -993,13 +1057,16 @@ bool ModuleRegistry::LoadModuleIfFound(const std::filesystem::path &modules_dir,
 bool ModuleRegistry::LoadOrReloadModuleFromName(const std::string_view name) {
   if (modules_dirs_.empty()) return false;
   if (name.empty()) return false;
+  std::lock_guard hooks_guard(change_hooks_lock_);
   std::unique_lock<utils::RWLock> guard(lock_);
   auto found_it = modules_.find(name);
   if (found_it != modules_.end()) {
+    const auto change_hooks = found_it->second->ChangeHooks()->size();
     if (!found_it->second->Close()) {
       spdlog::warn("Failed to close module {}", found_it->first);
     }
     modules_.erase(found_it);
+    change_hook_count_.fetch_sub(change_hooks, std::memory_order_acq_rel);
   }
 
   for (const auto &module_dir : modules_dirs_) {
@@ -1030,6 +1097,7 @@ void ModuleRegistry::LoadModulesFromDirectory(const std::filesystem::path &modul
 }
 
 void ModuleRegistry::UnloadAndLoadModulesFromDirectories() {
+  std::lock_guard hooks_guard(change_hooks_lock_);
   std::unique_lock<utils::RWLock> guard(lock_);
   DoUnloadAllModules();
   for (const auto &module_dir : modules_dirs_) {
@@ -1045,6 +1113,7 @@ ModulePtr ModuleRegistry::GetModuleNamed(const std::string_view &name) const {
 }
 
 void ModuleRegistry::UnloadAllModules() {
+  std::lock_guard hooks_guard(change_hooks_lock_);
   std::unique_lock<utils::RWLock> guard(lock_);
   DoUnloadAllModules();
 }
@@ -13,8 +13,11 @@
 /// API for loading and registering modules providing custom oC procedures
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <filesystem>
 #include <functional>
+#include <mutex>
 #include <optional>
 #include <shared_mutex>
 #include <string>
@@ -26,6 +29,8 @@
 #include "utils/rw_lock.hpp"
 
 class CypherMainVisitorTest;
+class CallProcedureBatchTest;
+class ChangeFeedTest;
 
 namespace query::procedure {
 
@@ -45,8 +50,20 @@ class Module {
   virtual const std::map<std::string, mgp_proc, std::less<>> *Procedures() const = 0;
   /// Returns registered transformations of this module
   virtual const std::map<std::string, mgp_trans, std::less<>> *Transformations() const = 0;
+  /// Returns registered change hooks of this module
+  virtual const std::map<std::string, mgp_change_hook, std::less<>> *ChangeHooks() const = 0;
 
   virtual std::optional<std::filesystem::path> Path() const = 0;
+
+  /// Returns the number of this load of the module, which is different for
+  /// each module registered in the ModuleRegistry, also when a module with
+  /// the same name is loaded again.
+  uint64_t LoadId() const { return load_id_; }
+
+ private:
+  friend class ModuleRegistry;
+
+  uint64_t load_id_{0};
 };
 
 /// Proxy for a registered Module, acquires a read lock from ModuleRegistry.
@@ -68,9 +85,20 @@ class ModulePtr final {
 /// Thread-safe registration of modules from libraries, uses utils::RWLock.
 class ModuleRegistry final {
   friend CypherMainVisitorTest;
+  friend CallProcedureBatchTest;
+  friend ChangeFeedTest;
 
   std::map<std::string, std::unique_ptr<Module>, std::less<>> modules_;
   mutable utils::RWLock lock_{utils::RWLock::Priority::WRITE};
+  // The load ID of the last registered module.
+  uint64_t last_load_id_{0};
+  // Number of the change hooks of the loaded modules.
+  std::atomic<size_t> change_hook_count_{0};
+  std::function<void()> change_hook_listener_;
+  // Taken before the write lock by everything which unloads the modules, and
+  // by ForEachChangeHook instead of the read lock, so that a long call of a
+  // change hook doesn't keep the write lock waiting.
+  mutable std::mutex change_hooks_lock_;
   std::unique_ptr<utils::MemoryResource> shared_{std::make_unique<utils::ResourceWithOutOfMemoryException>()};
 
   bool RegisterModule(const std::string_view &name, std::unique_ptr<Module> module);
@@ -109,6 +137,27 @@ class ModuleRegistry final {
   /// Takes a write lock.
   void UnloadAndLoadModulesFromDirectories();
 
+  /// Return true if any of the loaded modules has a change hook.
+  ///
+  /// Doesn't take a lock.
+  bool HasChangeHooks() const noexcept;
+
+  /// Call `function` with each change hook of the loaded modules.
+  ///
+  /// Takes a read lock only while the hooks are listed. The modules can't be
+  /// unloaded until the call returns, but the lookups of the procedures
+  /// aren't blocked by an unload which waits for it.
+  void ForEachChangeHook(
+      const std::function<void(std::string_view module_name, std::string_view hook_name, const mgp_change_hook &hook)>
+          &function) const;
+
+  /// Set the function which is called each time a module with change hooks is
+  /// loaded. It's called while the write lock is held, so it must not use the
+  /// registry.
+  ///
+  /// Takes a write lock.
+  void SetChangeHookListener(std::function<void()> listener);
+
   /// Find a module with given name or return nullptr.
   /// Takes a read lock.
   ModulePtr GetModuleNamed(const std::string_view &name) const;
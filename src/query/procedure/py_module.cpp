@@ -13,11 +13,14 @@
 
 #include <datetime.h>
 #include <pyerrors.h>
+#include <algorithm>
 #include <array>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include "mg_procedure.h"
 #include "query/procedure/mg_procedure_helpers.hpp"
@@ -131,6 +134,43 @@ mgp_value *PyObjectToMgpValueWithPythonExceptions(PyObject *py_value, mgp_memory
 // These should all be in the private `_mgp` Python module, which will be used
 // by the `mgp` to implement the user friendly Python API.
 
+// The memory of the graph projections. It isn't a part of the procedure
+// memory, which is released once the procedure is done, so the arrays exported
+// from the projections stay valid as long as Python references them. While the
+// procedure runs, the memory counts towards the memory tracker of the query. The
+// procedure memory updates the same tracker from the threads started by the
+// procedure, so both are used under the lock of the procedure memory.
+class ProjectionMemoryResource final : public utils::MemoryResource {
+ public:
+  ProjectionMemoryResource(utils::TrackingMemoryResource *memory_tracker, utils::SpinLock *lock)
+      : memory_(utils::NewDeleteResource(), memory_tracker), lock_(lock ? lock : &own_lock_) {}
+
+  // Called once the procedure is done, as the memory tracker and the lock
+  // don't outlive the call.
+  void Detach() {
+    std::lock_guard<utils::SpinLock> guard(*lock_);
+    memory_.SetParent(nullptr);
+    lock_ = &own_lock_;
+  }
+
+ private:
+  utils::TrackingMemoryResource memory_;
+  utils::SpinLock own_lock_;
+  utils::SpinLock *lock_;
+
+  void *DoAllocate(size_t bytes, size_t alignment) override {
+    std::lock_guard<utils::SpinLock> guard(*lock_);
+    return memory_.Allocate(bytes, alignment);
+  }
+
+  void DoDeallocate(void *p, size_t bytes, size_t alignment) override {
+    std::lock_guard<utils::SpinLock> guard(*lock_);
+    memory_.Deallocate(p, bytes, alignment);
+  }
+
+  bool DoIsEqual(const MemoryResource &other) const noexcept override { return this == &other; }
+};
+
 // Wraps mgp_graph in a PyObject.
 //
 // Executing a `CALL python_module.procedure(...)` in openCypher should
@@ -148,9 +188,28 @@ struct PyGraph {
   PyObject_HEAD
   mgp_graph *graph;
   mgp_memory *memory;
+  // The lock of the procedure memory, if it is used from multiple threads.
+  utils::SpinLock *memory_lock;
+  // Created with the first projection and destroyed with the graph, because the
+  // projections reference the graph.
+  ProjectionMemoryResource *projection_memory;
 };
 // clang-format on
 
+// Calls a function of the C API without holding the GIL, so that the other
+// threads can execute Python code in the meantime. This is only worth it for
+// the calls whose cost grows with the size of the data they read, because
+// reacquiring the GIL while another thread executes Python code can take as
+// long as the switch interval. The GIL is kept when the graph is mutable, as
+// the modifications made by the other Python threads of the same procedure
+// mustn't run concurrently with the call.
+template <typename TFunc, typename... TArgs>
+mgp_error CallWithoutGIL(const PyGraph &py_graph, TFunc func, TArgs... args) {
+  if (CallBool(mgp_graph_is_mutable, py_graph.graph)) return func(args...);
+  py::ReleaseGIL gil;
+  return func(args...);
+}
+
 // clang-format off
 struct PyVerticesIterator {
   PyObject_HEAD
@@ -295,12 +354,288 @@ static PyTypeObject PyEdgesIteratorType = {
 };
 // clang-format on
 
+bool PyGraphIsValidImpl(PyGraph &self);
+
+// Exports a contiguous array through the buffer protocol, so the array can be
+// wrapped by `memoryview` or NumPy without copying it.
+//
+// clang-format off
+struct PyProjectionArray {
+  PyObject_HEAD
+  // The object which owns the data, or keeps `memory` alive if the array owns
+  // the data.
+  PyObject *owner;
+  // The memory the data is allocated from, or nullptr if `owner` owns the data.
+  utils::MemoryResource *memory;
+  void *data;
+  Py_ssize_t size;
+  Py_ssize_t item_size;
+  const char *format;
+};
+// clang-format on
+
+// An owned array allocates at least one element, so its data is never nullptr.
+size_t ProjectionArrayBytes(const size_t size, const size_t item_size) {
+  return std::max<size_t>(size, 1) * item_size;
+}
+
+void PyProjectionArrayDealloc(PyProjectionArray *self) {
+  if (self->memory) {
+    self->memory->Deallocate(self->data, ProjectionArrayBytes(self->size, self->item_size), self->item_size);
+  }
+  Py_DECREF(self->owner);
+  Py_TYPE(self)->tp_free(self);
+}
+
+int PyProjectionArrayGetBuffer(PyProjectionArray *self, Py_buffer *view, int flags) {
+  // An empty vector may not have any data, but the buffer needs a valid pointer.
+  static char empty{0};
+  auto *data = self->data ? self->data : &empty;
+  if (PyBuffer_FillInfo(view, reinterpret_cast<PyObject *>(self), data, self->size * self->item_size,
+                        /* readonly = */ 1, flags) < 0) {
+    return -1;
+  }
+  // Without the format, the consumer expects an array of bytes, which is what
+  // `PyBuffer_FillInfo` describes.
+  if (flags & PyBUF_FORMAT) {
+    view->format = const_cast<char *>(self->format);
+    view->itemsize = self->item_size;
+    if ((flags & PyBUF_ND) == PyBUF_ND) view->shape = &self->size;
+  }
+  return 0;
+}
+
+static PyBufferProcs PyProjectionArrayBufferProcs = {
+    .bf_getbuffer = reinterpret_cast<getbufferproc>(PyProjectionArrayGetBuffer),
+    .bf_releasebuffer = nullptr,
+};
+
+// clang-format off
+static PyTypeObject PyProjectionArrayType = {
+    PyVarObject_HEAD_INIT(nullptr, 0)
+    .tp_name = "_mgp.ProjectionArray",
+    .tp_basicsize = sizeof(PyProjectionArray),
+    .tp_dealloc = reinterpret_cast<destructor>(PyProjectionArrayDealloc),
+    .tp_as_buffer = &PyProjectionArrayBufferProcs,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = "Exports an array of a graph projection.",
+};
+// clang-format on
+
+// Returns the format of the array elements, as in the `struct` module.
+template <typename T>
+constexpr const char *ProjectionArrayFormat() {
+  if constexpr (std::is_same_v<T, int64_t>) {
+    return "q";
+  } else if constexpr (std::is_same_v<T, uint64_t>) {
+    return "Q";
+  } else {
+    static_assert(std::is_same_v<T, double>, "Unsupported projection array type");
+    return "d";
+  }
+}
+
+// Returns a `memoryview` of the array. If `memory` isn't nullptr, the array
+// takes the ownership of the data, which has to be allocated from `memory` with
+// `ProjectionArrayBytes`, and `owner` has to keep `memory` alive.
+template <typename T>
+PyObject *MakePyProjectionArray(PyObject *owner, const T *data, size_t size, utils::MemoryResource *memory = nullptr) {
+  auto *py_array = PyObject_New(PyProjectionArray, &PyProjectionArrayType);
+  if (!py_array) {
+    if (memory) memory->Deallocate(const_cast<T *>(data), ProjectionArrayBytes(size, sizeof(T)), sizeof(T));
+    return nullptr;
+  }
+  Py_INCREF(owner);
+  py_array->owner = owner;
+  py_array->memory = memory;
+  py_array->data = const_cast<T *>(data);
+  py_array->size = static_cast<Py_ssize_t>(size);
+  py_array->item_size = sizeof(T);
+  py_array->format = ProjectionArrayFormat<T>();
+  py::Object array(reinterpret_cast<PyObject *>(py_array));
+  return PyMemoryView_FromObject(array.Ptr());
+}
+
+// clang-format off
+struct PyGraphProjection {
+  PyObject_HEAD
+  mgp_graph_projection *projection;
+  PyGraph *py_graph;
+};
+// clang-format on
+
+void PyGraphProjectionDealloc(PyGraphProjection *self) {
+  MG_ASSERT(self->projection);
+  MG_ASSERT(self->py_graph);
+  // The projection doesn't use the procedure memory, so it is destroyed even
+  // if the graph isn't valid anymore. The graph is released afterwards, as it
+  // owns the projection memory.
+  mgp_graph_projection_destroy(self->projection);
+  Py_DECREF(self->py_graph);
+  Py_TYPE(self)->tp_free(self);
+}
+
+size_t ProjectionVertexCount(PyGraphProjection *self) {
+  MG_ASSERT(self->projection);
+  return Call<size_t>(mgp_graph_projection_vertex_count, self->projection);
+}
+
+size_t ProjectionEdgeCount(PyGraphProjection *self) {
+  MG_ASSERT(self->projection);
+  return Call<size_t>(mgp_graph_projection_edge_count, self->projection);
+}
+
+PyObject *PyGraphProjectionVertexCount(PyGraphProjection *self, PyObject *Py_UNUSED(ignored)) {
+  return PyLong_FromSize_t(ProjectionVertexCount(self));
+}
+
+PyObject *PyGraphProjectionEdgeCount(PyGraphProjection *self, PyObject *Py_UNUSED(ignored)) {
+  return PyLong_FromSize_t(ProjectionEdgeCount(self));
+}
+
+PyObject *PyGraphProjectionIsValid(PyGraphProjection *self, PyObject *Py_UNUSED(ignored)) {
+  MG_ASSERT(self->py_graph);
+  return PyBool_FromLong(PyGraphIsValidImpl(*self->py_graph));
+}
+
+PyObject *PyGraphProjectionVertexOrdinal(PyGraphProjection *self, PyObject *args) {
+  MG_ASSERT(self->projection);
+  static_assert(std::is_same_v<int64_t, long>);
+  int64_t id = 0;
+  if (!PyArg_ParseTuple(args, "l", &id)) return nullptr;
+  uint64_t ordinal{0};
+  if (RaiseExceptionFromErrorCode(mgp_graph_projection_vertex_ordinal(self->projection, mgp_vertex_id{id}, &ordinal))) {
+    return nullptr;
+  }
+  return PyLong_FromUnsignedLongLong(ordinal);
+}
+
+// Returns a `memoryview` of the projection array returned by `get_array`, or
+// None if the array wasn't projected.
+template <typename T>
+PyObject *GetPyProjectionArray(PyGraphProjection *self, mgp_error (*get_array)(mgp_graph_projection *, const T **),
+                               const size_t size) {
+  MG_ASSERT(self->projection);
+  const T *data{nullptr};
+  if (RaiseExceptionFromErrorCode(get_array(self->projection, &data))) {
+    return nullptr;
+  }
+  if (!data) {
+    Py_RETURN_NONE;
+  }
+  return MakePyProjectionArray(reinterpret_cast<PyObject *>(self), data, size);
+}
+
+PyObject *PyGraphProjectionVertexIds(PyGraphProjection *self, PyObject *Py_UNUSED(ignored)) {
+  return GetPyProjectionArray(self, mgp_graph_projection_vertex_ids, ProjectionVertexCount(self));
+}
+
+PyObject *PyGraphProjectionOutOffsets(PyGraphProjection *self, PyObject *Py_UNUSED(ignored)) {
+  return GetPyProjectionArray(self, mgp_graph_projection_out_offsets, ProjectionVertexCount(self) + 1);
+}
+
+PyObject *PyGraphProjectionOutTargets(PyGraphProjection *self, PyObject *Py_UNUSED(ignored)) {
+  return GetPyProjectionArray(self, mgp_graph_projection_out_targets, ProjectionEdgeCount(self));
+}
+
+PyObject *PyGraphProjectionOutWeights(PyGraphProjection *self, PyObject *Py_UNUSED(ignored)) {
+  return GetPyProjectionArray(self, mgp_graph_projection_out_weights, ProjectionEdgeCount(self));
+}
+
+PyObject *PyGraphProjectionInOffsets(PyGraphProjection *self, PyObject *Py_UNUSED(ignored)) {
+  return GetPyProjectionArray(self, mgp_graph_projection_in_offsets, ProjectionVertexCount(self) + 1);
+}
+
+PyObject *PyGraphProjectionInSources(PyGraphProjection *self, PyObject *Py_UNUSED(ignored)) {
+  return GetPyProjectionArray(self, mgp_graph_projection_in_sources, ProjectionEdgeCount(self));
+}
+
+PyObject *PyGraphProjectionInWeights(PyGraphProjection *self, PyObject *Py_UNUSED(ignored)) {
+  return GetPyProjectionArray(self, mgp_graph_projection_in_weights, ProjectionEdgeCount(self));
+}
+
+PyObject *PyGraphProjectionVertexProperty(PyGraphProjection *self, PyObject *args) {
+  MG_ASSERT(self->projection);
+  MG_ASSERT(self->py_graph);
+  MG_ASSERT(PyGraphIsValidImpl(*self->py_graph));
+  const char *property_name{nullptr};
+  double default_value{0.0};
+  if (!PyArg_ParseTuple(args, "sd", &property_name, &default_value)) return nullptr;
+  const auto vertex_count = ProjectionVertexCount(self);
+  // The column is owned by the exported array and allocated from the same
+  // memory as the projection, so it counts towards the memory of the query
+  // just like the rest of the projection.
+  auto *memory = self->projection->GetMemoryResource();
+  const auto bytes = ProjectionArrayBytes(vertex_count, sizeof(double));
+  double *column{nullptr};
+  try {
+    column = static_cast<double *>(memory->Allocate(bytes, alignof(double)));
+  } catch (const std::bad_alloc &) {
+    return PyErr_NoMemory();
+  }
+  if (RaiseExceptionFromErrorCode(CallWithoutGIL(*self->py_graph, mgp_graph_projection_vertex_property,
+                                                 self->py_graph->graph, self->projection, property_name,
+                                                 default_value, column))) {
+    memory->Deallocate(column, bytes, alignof(double));
+    return nullptr;
+  }
+  return MakePyProjectionArray<double>(reinterpret_cast<PyObject *>(self), column, vertex_count, memory);
+}
+
+static PyMethodDef PyGraphProjectionMethods[] = {
+    {"__reduce__", reinterpret_cast<PyCFunction>(DisallowPickleAndCopy), METH_NOARGS, "__reduce__ is not supported"},
+    {"is_valid", reinterpret_cast<PyCFunction>(PyGraphProjectionIsValid), METH_NOARGS,
+     "Return True if the graph the projection was created from may still be used."},
+    {"vertex_count", reinterpret_cast<PyCFunction>(PyGraphProjectionVertexCount), METH_NOARGS,
+     "Return the number of the projected vertices."},
+    {"edge_count", reinterpret_cast<PyCFunction>(PyGraphProjectionEdgeCount), METH_NOARGS,
+     "Return the number of the projected edges."},
+    {"vertex_ordinal", reinterpret_cast<PyCFunction>(PyGraphProjectionVertexOrdinal), METH_VARARGS,
+     "Return the ordinal of the vertex with the given ID."},
+    {"vertex_ids", reinterpret_cast<PyCFunction>(PyGraphProjectionVertexIds), METH_NOARGS,
+     "Return a memoryview of the projected vertex IDs."},
+    {"out_offsets", reinterpret_cast<PyCFunction>(PyGraphProjectionOutOffsets), METH_NOARGS,
+     "Return a memoryview of the offsets of the outbound edges."},
+    {"out_targets", reinterpret_cast<PyCFunction>(PyGraphProjectionOutTargets), METH_NOARGS,
+     "Return a memoryview of the destination ordinals of the outbound edges."},
+    {"out_weights", reinterpret_cast<PyCFunction>(PyGraphProjectionOutWeights), METH_NOARGS,
+     "Return a memoryview of the weights of the outbound edges or None."},
+    {"in_offsets", reinterpret_cast<PyCFunction>(PyGraphProjectionInOffsets), METH_NOARGS,
+     "Return a memoryview of the offsets of the inbound edges or None."},
+    {"in_sources", reinterpret_cast<PyCFunction>(PyGraphProjectionInSources), METH_NOARGS,
+     "Return a memoryview of the source ordinals of the inbound edges or None."},
+    {"in_weights", reinterpret_cast<PyCFunction>(PyGraphProjectionInWeights), METH_NOARGS,
+     "Return a memoryview of the weights of the inbound edges or None."},
+    {"vertex_property", reinterpret_cast<PyCFunction>(PyGraphProjectionVertexProperty), METH_VARARGS,
+     "Return a memoryview of a numeric property of the projected vertices."},
+    {nullptr},
+};
+
+// clang-format off
+static PyTypeObject PyGraphProjectionType = {
+    PyVarObject_HEAD_INIT(nullptr, 0)
+    .tp_name = "_mgp.GraphProjection",
+    .tp_basicsize = sizeof(PyGraphProjection),
+    .tp_dealloc = reinterpret_cast<destructor>(PyGraphProjectionDealloc),
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_doc = "Wraps struct mgp_graph_projection.",
+    .tp_methods = PyGraphProjectionMethods,
+};
+// clang-format on
+
 PyObject *PyGraphInvalidate(PyGraph *self, PyObject *Py_UNUSED(ignored)) {
+  if (self->projection_memory) self->projection_memory->Detach();
   self->graph = nullptr;
   self->memory = nullptr;
+  self->memory_lock = nullptr;
   Py_RETURN_NONE;
 }
 
+void PyGraphDealloc(PyGraph *self) {
+  delete self->projection_memory;
+  Py_TYPE(self)->tp_free(self);
+}
+
 bool PyGraphIsValidImpl(PyGraph &self) { return self.graph != nullptr; }
 
 PyObject *PyGraphIsValid(PyGraph *self, PyObject *Py_UNUSED(ignored)) {
@@ -372,6 +707,36 @@ PyObject *PyGraphIterVertices(PyGraph *self, PyObject *Py_UNUSED(ignored)) {
   return reinterpret_cast<PyObject *>(py_vertices_it);
 }
 
+PyObject *PyGraphProject(PyGraph *self, PyObject *args) {
+  MG_ASSERT(PyGraphIsValidImpl(*self));
+  mgp_graph_projection_config config{};
+  int include_in_edges{0};
+  if (!PyArg_ParseTuple(args, "zzzdp", &config.vertex_label, &config.edge_type, &config.weight_property,
+                        &config.default_weight, &include_in_edges)) {
+    return nullptr;
+  }
+  config.include_in_edges = include_in_edges;
+  if (!self->projection_memory) {
+    auto *memory_tracker = self->graph->ctx ? self->graph->ctx->memory_tracker : nullptr;
+    self->projection_memory = new ProjectionMemoryResource(memory_tracker, self->memory_lock);
+  }
+  mgp_memory projection_memory{self->projection_memory};
+  mgp_graph_projection *projection{nullptr};
+  if (RaiseExceptionFromErrorCode(
+          CallWithoutGIL(*self, mgp_graph_project, self->graph, &config, &projection_memory, &projection))) {
+    return nullptr;
+  }
+  auto *py_projection = PyObject_New(PyGraphProjection, &PyGraphProjectionType);
+  if (!py_projection) {
+    mgp_graph_projection_destroy(projection);
+    return nullptr;
+  }
+  py_projection->projection = projection;
+  Py_INCREF(self);
+  py_projection->py_graph = self;
+  return reinterpret_cast<PyObject *>(py_projection);
+}
+
 PyObject *PyGraphMustAbort(PyGraph *self, PyObject *Py_UNUSED(ignored)) {
   MG_ASSERT(PyGraphIsValidImpl(*self));
   return PyBool_FromLong(mgp_must_abort(self->graph));
@@ -394,6 +759,7 @@ static PyMethodDef PyGraphMethods[] = {
      "Delete a vertex and all of its edges."},
     {"delete_edge", reinterpret_cast<PyCFunction>(PyGraphDeleteEdge), METH_VARARGS, "Delete an edge."},
     {"iter_vertices", reinterpret_cast<PyCFunction>(PyGraphIterVertices), METH_NOARGS, "Return _mgp.VerticesIterator."},
+    {"project", reinterpret_cast<PyCFunction>(PyGraphProject), METH_VARARGS, "Return _mgp.GraphProjection."},
     {"must_abort", reinterpret_cast<PyCFunction>(PyGraphMustAbort), METH_NOARGS,
      "Check whether the running procedure should abort"},
     {nullptr},
@@ -404,18 +770,21 @@ static PyTypeObject PyGraphType = {
     PyVarObject_HEAD_INIT(nullptr, 0)
     .tp_name = "_mgp.Graph",
     .tp_basicsize = sizeof(PyGraph),
+    .tp_dealloc = reinterpret_cast<destructor>(PyGraphDealloc),
     .tp_flags = Py_TPFLAGS_DEFAULT,
     .tp_doc = "Wraps struct mgp_graph.",
     .tp_methods = PyGraphMethods,
 };
 // clang-format on
 
-PyObject *MakePyGraph(mgp_graph *graph, mgp_memory *memory) {
+PyObject *MakePyGraph(mgp_graph *graph, mgp_memory *memory, utils::SpinLock *memory_lock) {
   MG_ASSERT(!graph || (graph && memory));
   auto *py_graph = PyObject_New(PyGraph, &PyGraphType);
   if (!py_graph) return nullptr;
   py_graph->graph = graph;
   py_graph->memory = memory;
+  py_graph->memory_lock = memory_lock;
+  py_graph->projection_memory = nullptr;
   return reinterpret_cast<PyObject *>(py_graph);
 }
 
@@ -797,7 +1166,26 @@ py::Object MgpListToPyTuple(mgp_list *list, PyObject *py_graph) {
 
 namespace {
 
-std::optional<py::ExceptionInfo> AddRecordFromPython(mgp_result *result, py::Object py_record) {
+// The number of records which are converted from Python before they are
+// inserted into the result without holding the GIL.
+constexpr Py_ssize_t kRecordBatchSize = 1024;
+
+// Field of a record which is converted from Python, but isn't inserted into the
+// result yet. The key and the value are borrowed from the items of the record.
+struct PendingField {
+  const char *name;
+  MgpUniquePtr<mgp_value> value;
+  PyObject *py_key;
+  PyObject *py_value;
+};
+
+struct PendingRecord {
+  py::Object items;
+  std::vector<PendingField> fields;
+};
+
+std::optional<py::ExceptionInfo> ConvertRecordFromPython(mgp_result *result, py::Object py_record,
+                                                         std::vector<PendingRecord> *records) {
   py::Object py_mgp(PyImport_ImportModule("mgp"));
   if (!py_mgp) return py::FetchError();
   auto record_cls = py_mgp.GetAttr("Record");
@@ -817,11 +1205,9 @@ std::optional<py::ExceptionInfo> AddRecordFromPython(mgp_result *result, py::Obj
   }
   py::Object items(PyDict_Items(fields.Ptr()));
   if (!items) return py::FetchError();
-  mgp_result_record *record{nullptr};
-  if (RaiseExceptionFromErrorCode(mgp_result_new_record(result, &record))) {
-    return py::FetchError();
-  }
   Py_ssize_t len = PyList_GET_SIZE(items.Ptr());
+  std::vector<PendingField> record_fields;
+  record_fields.reserve(len);
   for (Py_ssize_t i = 0; i < len; ++i) {
     auto *item = PyList_GET_ITEM(items.Ptr(), i);
     if (!item) return py::FetchError();
@@ -840,32 +1226,75 @@ std::optional<py::ExceptionInfo> AddRecordFromPython(mgp_result *result, py::Obj
     auto *val = PyTuple_GetItem(item, 1);
     if (!val) return py::FetchError();
     mgp_memory memory{result->rows.get_allocator().GetMemoryResource()};
-    mgp_value *field_val = PyObjectToMgpValueWithPythonExceptions(val, &memory);
+    MgpUniquePtr<mgp_value> field_val{PyObjectToMgpValueWithPythonExceptions(val, &memory), mgp_value_destroy};
     if (field_val == nullptr) {
       return py::FetchError();
     }
-    if (mgp_result_record_insert(record, field_name, field_val) != MGP_ERROR_NO_ERROR) {
-      std::stringstream ss;
-      ss << "Unable to insert field '" << py::Object::FromBorrow(key) << "' with value: '"
-         << py::Object::FromBorrow(val) << "'; did you set the correct field type?";
-      const auto &msg = ss.str();
-      PyErr_SetString(PyExc_ValueError, msg.c_str());
-      mgp_value_destroy(field_val);
-      return py::FetchError();
+    record_fields.push_back(PendingField{field_name, std::move(field_val), key, val});
+  }
+  records->push_back(PendingRecord{std::move(items), std::move(record_fields)});
+  return std::nullopt;
+}
+
+// Inserts the converted records into the result. Converting the values into
+// the result doesn't need Python, so it is done without holding the GIL. The
+// Python threads started by the procedure can't use its memory anymore at this
+// point, as the graph is about to be invalidated.
+std::optional<py::ExceptionInfo> InsertRecords(mgp_result *result, std::vector<PendingRecord> *records) {
+  auto error = MGP_ERROR_NO_ERROR;
+  const PendingField *failed_field{nullptr};
+  {
+    py::ReleaseGIL gil;
+    for (auto &record : *records) {
+      mgp_result_record *result_record{nullptr};
+      error = mgp_result_new_record(result, &result_record);
+      if (error != MGP_ERROR_NO_ERROR) break;
+      for (auto &field : record.fields) {
+        if (mgp_result_record_insert(result_record, field.name, field.value.get()) != MGP_ERROR_NO_ERROR) {
+          failed_field = &field;
+          break;
+        }
+        field.value.reset();
+      }
+      if (failed_field) break;
     }
-    mgp_value_destroy(field_val);
+  }
+  if (RaiseExceptionFromErrorCode(error)) {
+    return py::FetchError();
+  }
+  if (failed_field) {
+    std::stringstream ss;
+    ss << "Unable to insert field '" << py::Object::FromBorrow(failed_field->py_key) << "' with value: '"
+       << py::Object::FromBorrow(failed_field->py_value) << "'; did you set the correct field type?";
+    const auto &msg = ss.str();
+    PyErr_SetString(PyExc_ValueError, msg.c_str());
+    return py::FetchError();
   }
   return std::nullopt;
 }
 
+std::optional<py::ExceptionInfo> AddRecordFromPython(mgp_result *result, py::Object py_record) {
+  std::vector<PendingRecord> records;
+  auto maybe_exc = ConvertRecordFromPython(result, py_record, &records);
+  if (maybe_exc) return maybe_exc;
+  return InsertRecords(result, &records);
+}
+
 std::optional<py::ExceptionInfo> AddMultipleRecordsFromPython(mgp_result *result, py::Object py_seq) {
   Py_ssize_t len = PySequence_Size(py_seq.Ptr());
   if (len == -1) return py::FetchError();
+  std::vector<PendingRecord> records;
+  records.reserve(std::min(len, kRecordBatchSize));
   for (Py_ssize_t i = 0; i < len; ++i) {
     py::Object py_record(PySequence_GetItem(py_seq.Ptr(), i));
     if (!py_record) return py::FetchError();
-    auto maybe_exc = AddRecordFromPython(result, py_record);
+    auto maybe_exc = ConvertRecordFromPython(result, py_record, &records);
     if (maybe_exc) return maybe_exc;
+    if (static_cast<Py_ssize_t>(records.size()) == kRecordBatchSize || i + 1 == len) {
+      maybe_exc = InsertRecords(result, &records);
+      if (maybe_exc) return maybe_exc;
+      records.clear();
+    }
   }
   return std::nullopt;
 }
@@ -931,7 +1360,11 @@ void CallPythonProcedure(const py::Object &py_cb, mgp_list *args, mgp_graph *gra
   // object.
   std::optional<std::string> maybe_msg;
   {
-    py::Object py_graph(MakePyGraph(graph, memory));
+    // The GIL is released while reading the graph, so the Python threads
+    // started by the procedure can use the memory concurrently.
+    utils::SynchronizedMemoryResource synchronized_memory_resource(memory->impl);
+    mgp_memory synchronized_memory{&synchronized_memory_resource};
+    py::Object py_graph(MakePyGraph(graph, &synchronized_memory, &synchronized_memory_resource.GetLock()));
     if (py_graph) {
       try {
         maybe_msg = error_to_msg(call(py_graph));
@@ -1011,7 +1444,11 @@ void CallPythonTransformation(const py::Object &py_cb, mgp_messages *msgs, mgp_g
   // object.
   std::optional<std::string> maybe_msg;
   {
-    py::Object py_graph(MakePyGraph(graph, memory));
+    // The GIL is released while reading the graph, so the Python threads
+    // started by the procedure can use the memory concurrently.
+    utils::SynchronizedMemoryResource synchronized_memory_resource(memory->impl);
+    mgp_memory synchronized_memory{&synchronized_memory_resource};
+    py::Object py_graph(MakePyGraph(graph, &synchronized_memory, &synchronized_memory_resource.GetLock()));
     py::Object py_messages(MakePyMessages(msgs, memory));
     if (py_graph && py_messages) {
       try {
@@ -1369,7 +1806,8 @@ PyObject *PyEdgeIterProperties(PyEdge *self, PyObject *Py_UNUSED(ignored)) {
   MG_ASSERT(self->py_graph);
   MG_ASSERT(self->py_graph->graph);
   mgp_properties_iterator *properties_it{nullptr};
-  if (RaiseExceptionFromErrorCode(mgp_edge_iter_properties(self->edge, self->py_graph->memory, &properties_it))) {
+  if (RaiseExceptionFromErrorCode(CallWithoutGIL(*self->py_graph, mgp_edge_iter_properties, self->edge,
+                                                 self->py_graph->memory, &properties_it))) {
     return nullptr;
   }
   auto *py_properties_it = PyObject_New(PyPropertiesIterator, &PyPropertiesIteratorType);
@@ -1391,7 +1829,8 @@ PyObject *PyEdgeGetProperty(PyEdge *self, PyObject *args) {
   const char *prop_name = nullptr;
   if (!PyArg_ParseTuple(args, "s", &prop_name)) return nullptr;
   mgp_value *prop_value{nullptr};
-  if (RaiseExceptionFromErrorCode(mgp_edge_get_property(self->edge, prop_name, self->py_graph->memory, &prop_value))) {
+  if (RaiseExceptionFromErrorCode(CallWithoutGIL(*self->py_graph, mgp_edge_get_property, self->edge, prop_name,
+                                                 self->py_graph->memory, &prop_value))) {
     return nullptr;
   }
   auto py_prop_value = MgpValueToPyObject(*prop_value, self->py_graph);
@@ -1576,7 +2015,8 @@ PyObject *PyVertexIterInEdges(PyVertex *self, PyObject *Py_UNUSED(ignored)) {
   MG_ASSERT(self->py_graph);
   MG_ASSERT(self->py_graph->graph);
   mgp_edges_iterator *edges_it{nullptr};
-  if (RaiseExceptionFromErrorCode(mgp_vertex_iter_in_edges(self->vertex, self->py_graph->memory, &edges_it))) {
+  if (RaiseExceptionFromErrorCode(CallWithoutGIL(*self->py_graph, mgp_vertex_iter_in_edges, self->vertex,
+                                                 self->py_graph->memory, &edges_it))) {
     return nullptr;
   }
   auto *py_edges_it = PyObject_New(PyEdgesIterator, &PyEdgesIteratorType);
@@ -1596,7 +2036,8 @@ PyObject *PyVertexIterOutEdges(PyVertex *self, PyObject *Py_UNUSED(ignored)) {
   MG_ASSERT(self->py_graph);
   MG_ASSERT(self->py_graph->graph);
   mgp_edges_iterator *edges_it{nullptr};
-  if (RaiseExceptionFromErrorCode(mgp_vertex_iter_out_edges(self->vertex, self->py_graph->memory, &edges_it))) {
+  if (RaiseExceptionFromErrorCode(CallWithoutGIL(*self->py_graph, mgp_vertex_iter_out_edges, self->vertex,
+                                                 self->py_graph->memory, &edges_it))) {
     return nullptr;
   }
   auto *py_edges_it = PyObject_New(PyEdgesIterator, &PyEdgesIteratorType);
@@ -1616,7 +2057,8 @@ PyObject *PyVertexIterProperties(PyVertex *self, PyObject *Py_UNUSED(ignored)) {
   MG_ASSERT(self->py_graph);
   MG_ASSERT(self->py_graph->graph);
   mgp_properties_iterator *properties_it{nullptr};
-  if (RaiseExceptionFromErrorCode(mgp_vertex_iter_properties(self->vertex, self->py_graph->memory, &properties_it))) {
+  if (RaiseExceptionFromErrorCode(CallWithoutGIL(*self->py_graph, mgp_vertex_iter_properties, self->vertex,
+                                                 self->py_graph->memory, &properties_it))) {
     return nullptr;
   }
   auto *py_properties_it = PyObject_New(PyPropertiesIterator, &PyPropertiesIteratorType);
@@ -1640,8 +2082,8 @@ PyObject *PyVertexGetProperty(PyVertex *self, PyObject *args) {
     return nullptr;
   }
   mgp_value *prop_value{nullptr};
-  if (RaiseExceptionFromErrorCode(
-          mgp_vertex_get_property(self->vertex, prop_name, self->py_graph->memory, &prop_value))) {
+  if (RaiseExceptionFromErrorCode(CallWithoutGIL(*self->py_graph, mgp_vertex_get_property, self->vertex, prop_name,
+                                                 self->py_graph->memory, &prop_value))) {
     return nullptr;
   }
   auto py_prop_value = MgpValueToPyObject(*prop_value, self->py_graph);
@@ -1978,6 +2420,8 @@ PyObject *PyInitMgpModule() {
   if (!register_type(&PyVerticesIteratorType, "VerticesIterator")) return nullptr;
   if (!register_type(&PyEdgesIteratorType, "EdgesIterator")) return nullptr;
   if (!register_type(&PyGraphType, "Graph")) return nullptr;
+  if (!register_type(&PyGraphProjectionType, "GraphProjection")) return nullptr;
+  if (!register_type(&PyProjectionArrayType, "ProjectionArray")) return nullptr;
   if (!register_type(&PyEdgeType, "Edge")) return nullptr;
   if (!register_type(&PyQueryProcType, "Proc")) return nullptr;
   if (!register_type(&PyQueryModuleType, "Module")) return nullptr;
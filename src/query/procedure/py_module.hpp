@@ -20,6 +20,10 @@ struct mgp_memory;
 struct mgp_module;
 struct mgp_value;
 
+namespace utils {
+class SpinLock;
+}  // namespace utils
+
 namespace query::procedure {
 
 struct PyGraph;
@@ -61,7 +65,10 @@ mgp_value *PyObjectToMgpValue(PyObject *, mgp_memory *);
 PyObject *PyInitMgpModule();
 
 /// Create an instance of _mgp.Graph class.
-PyObject *MakePyGraph(mgp_graph *, mgp_memory *);
+///
+/// `memory_lock` is held while using `memory`, if it is used from multiple
+/// threads.
+PyObject *MakePyGraph(mgp_graph *, mgp_memory *, utils::SpinLock *memory_lock = nullptr);
 
 /// Import a module with given name in the context of mgp_module.
 ///
@@ -25,6 +25,7 @@ namespace query::stream {
 
 constexpr std::chrono::milliseconds kDefaultBatchInterval{100};
 constexpr int64_t kDefaultBatchSize{1000};
+constexpr int64_t kDefaultParallelism{1};
 
 template <typename TMessage>
 using ConsumerFunction = std::function<void(const std::vector<TMessage> &)>;
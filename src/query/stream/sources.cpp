@@ -11,13 +11,26 @@
 
 #include "query/stream/sources.hpp"
 
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string_view>
+#include <thread>
+#include <utility>
+
 #include <json/json.hpp>
 
 #include "integrations/constants.hpp"
+#include "integrations/kafka/exceptions.hpp"
 
 namespace query::stream {
 KafkaStream::KafkaStream(std::string stream_name, StreamInfo stream_info,
-                         ConsumerFunction<integrations::kafka::Message> consumer_function) {
+                         ConsumerFunction<integrations::kafka::Message> consumer_function)
+    : parallelism_{stream_info.parallelism} {
   integrations::kafka::ConsumerInfo consumer_info{
       .consumer_name = std::move(stream_name),
       .topics = std::move(stream_info.topics),
@@ -40,7 +53,8 @@ KafkaStream::StreamInfo KafkaStream::Info(std::string transformation_name) const
           .consumer_group = info.consumer_group,
           .bootstrap_servers = info.bootstrap_servers,
           .configs = info.public_configs,
-          .credentials = info.private_configs};
+          .credentials = info.private_configs,
+          .parallelism = parallelism_};
 }
 
 void KafkaStream::Start() { consumer_->Start(); }
@@ -56,12 +70,15 @@ utils::BasicResult<std::string> KafkaStream::SetStreamOffset(const int64_t offse
   return consumer_->SetConsumerOffsets(offset);
 }
 
+int64_t KafkaStream::MaxParallelism() { return std::max<int64_t>(1, std::thread::hardware_concurrency()); }
+
 namespace {
 const std::string kTopicsKey{"topics"};
 const std::string kConsumerGroupKey{"consumer_group"};
 const std::string kBoostrapServers{"bootstrap_servers"};
 const std::string kConfigs{"configs"};
 const std::string kCredentials{"credentials"};
+const std::string kParallelism{"parallelism"};
 
 const std::unordered_map<std::string, std::string> kDefaultConfigsMap;
 }  // namespace
@@ -73,6 +90,7 @@ void to_json(nlohmann::json &data, KafkaStream::StreamInfo &&info) {
   data[kBoostrapServers] = std::move(info.bootstrap_servers);
   data[kConfigs] = std::move(info.configs);
   data[kCredentials] = std::move(info.credentials);
+  data[kParallelism] = info.parallelism;
 }
 
 void from_json(const nlohmann::json &data, KafkaStream::StreamInfo &info) {
@@ -83,6 +101,78 @@ void from_json(const nlohmann::json &data, KafkaStream::StreamInfo &info) {
   // These values might not be present in the persisted JSON object
   info.configs = data.value(kConfigs, kDefaultConfigsMap);
   info.credentials = data.value(kCredentials, kDefaultConfigsMap);
+  info.parallelism = data.value(kParallelism, kDefaultParallelism);
+}
+
+std::vector<KafkaMessageGroup> SplitByPartition(const std::vector<KafkaStream::Message> &messages,
+                                                const size_t group_count) {
+  std::map<std::pair<std::string_view, int32_t>, size_t> group_of_partition;
+  std::vector<KafkaMessageGroup> groups;
+  for (const auto &message : messages) {
+    auto [it, inserted] = group_of_partition.try_emplace({message.TopicName(), message.Partition()}, 0);
+    if (inserted) {
+      it->second = (group_of_partition.size() - 1) % group_count;
+      if (it->second == groups.size()) groups.emplace_back();
+    }
+    groups[it->second].emplace_back(message);
+  }
+  return groups;
+}
+
+void ProcessPartitionGroups(const std::vector<KafkaMessageGroup> &groups, utils::ThreadPool *pool,
+                            const std::function<void(size_t)> &process_group) {
+  if (groups.empty()) return;
+  std::mutex mutex;
+  std::condition_variable cv;
+  size_t remaining_groups = groups.size() - 1;
+  std::vector<bool> processed(groups.size(), false);
+  std::exception_ptr error;
+  const auto process = [&](const size_t index) {
+    std::exception_ptr group_error;
+    try {
+      process_group(index);
+    } catch (...) {
+      group_error = std::current_exception();
+    }
+    std::lock_guard guard(mutex);
+    if (!group_error) {
+      processed[index] = true;
+    } else if (!error) {
+      error = std::move(group_error);
+    }
+  };
+  for (size_t i = 1; i < groups.size(); ++i) {
+    pool->AddTask([&, i] {
+      process(i);
+      std::lock_guard guard(mutex);
+      if (--remaining_groups == 0) cv.notify_all();
+    });
+  }
+  process(0);
+  std::unique_lock lock(mutex);
+  cv.wait(lock, [&] { return remaining_groups == 0; });
+  if (!error) return;
+
+  // The transactions of the other groups are already committed, so their partitions mustn't be consumed again.
+  std::set<std::pair<std::string, int32_t>> processed_partitions;
+  for (size_t i = 0; i < groups.size(); ++i) {
+    if (!processed[i]) continue;
+    for (const auto &message : groups[i]) {
+      processed_partitions.emplace(message.get().TopicName(), message.get().Partition());
+    }
+  }
+  // Nothing was committed, so the whole batch is consumed again as after any other error.
+  if (processed_partitions.empty()) std::rethrow_exception(error);
+
+  std::string message = "unknown error";
+  try {
+    std::rethrow_exception(error);
+  } catch (const std::exception &e) {
+    message = e.what();
+  } catch (...) {
+  }
+  throw integrations::kafka::PartiallyProcessedBatchException(
+      message, {processed_partitions.begin(), processed_partitions.end()});
 }
 
 PulsarStream::PulsarStream(std::string stream_name, StreamInfo stream_info,
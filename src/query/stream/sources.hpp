@@ -11,10 +11,15 @@
 
 #pragma once
 
+#include <cstddef>
+#include <functional>
+#include <vector>
+
 #include "query/stream/common.hpp"
 
 #include "integrations/kafka/consumer.hpp"
 #include "integrations/pulsar/consumer.hpp"
+#include "utils/thread_pool.hpp"
 
 namespace query::stream {
 
@@ -26,6 +31,9 @@ struct KafkaStream {
     std::string bootstrap_servers;
     std::unordered_map<std::string, std::string> configs;
     std::unordered_map<std::string, std::string> credentials;
+    // Number of the partition groups of a batch which are transformed and
+    // executed in parallel, each in a transaction of its own.
+    int64_t parallelism{kDefaultParallelism};
   };
 
   using Message = integrations::kafka::Message;
@@ -44,14 +52,34 @@ struct KafkaStream {
 
   utils::BasicResult<std::string> SetStreamOffset(int64_t offset);
 
+  /// Returns the largest parallelism of a stream, which is the number of the hardware threads.
+  static int64_t MaxParallelism();
+
  private:
   using Consumer = integrations::kafka::Consumer;
   std::optional<Consumer> consumer_;
+  int64_t parallelism_;
 };
 
 void to_json(nlohmann::json &data, KafkaStream::StreamInfo &&info);
 void from_json(const nlohmann::json &data, KafkaStream::StreamInfo &info);
 
+using KafkaMessageGroup = std::vector<std::reference_wrapper<const KafkaStream::Message>>;
+
+/// Splits the messages into at most `group_count` groups. The messages of a topic partition are put into the same
+/// group, in the order in which they were consumed, so their queries are executed in the same order as without the
+/// split.
+std::vector<KafkaMessageGroup> SplitByPartition(const std::vector<KafkaStream::Message> &messages, size_t group_count);
+
+/// Calls `process_group` with the index of each of the groups and waits for all of the calls to finish. The first
+/// group is processed by the calling thread and the others on the pool.
+///
+/// @throws integrations::kafka::PartiallyProcessedBatchException if any of the calls throws, with the topic
+///         partitions of the groups which were processed
+/// @throws the exception of the first failed call if none of the groups were processed
+void ProcessPartitionGroups(const std::vector<KafkaMessageGroup> &groups, utils::ThreadPool *pool,
+                            const std::function<void(size_t)> &process_group);
+
 template <>
 inline StreamSourceType StreamType(const KafkaStream & /*stream*/) {
   return StreamSourceType::KAFKA;
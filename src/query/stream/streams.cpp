@@ -11,6 +11,9 @@
 
 #include "query/stream/streams.hpp"
 
+#include <algorithm>
+#include <map>
+#include <memory>
 #include <shared_mutex>
 #include <string_view>
 #include <utility>
@@ -34,6 +37,7 @@
 #include "utils/memory.hpp"
 #include "utils/on_scope_exit.hpp"
 #include "utils/pmr/string.hpp"
+#include "utils/thread_pool.hpp"
 #include "utils/variant_helpers.hpp"
 
 namespace EventCounter {
@@ -114,6 +118,13 @@ void CallCustomTransformation(const std::string &transformation_name, const std:
   }
 }
 
+// The interpreter and the transformation result of a partition group, which is processed in parallel with the other
+// groups of the same batch.
+struct PartitionGroupProcessor {
+  std::shared_ptr<Interpreter> interpreter;
+  mgp_result result;
+};
+
 template <Stream TStream>
 StreamStatus<TStream> CreateStatus(std::string stream_name, std::string transformation_name,
                                    std::optional<std::string> owner, const TStream &stream) {
@@ -482,15 +493,12 @@ Streams::StreamsMap::iterator Streams::CreateConsumer(StreamsMap &map, const std
 
   auto *memory_resource = utils::NewDeleteResource();
 
-  auto consumer_function = [interpreter_context = interpreter_context_, memory_resource, stream_name,
-                            transformation_name = stream_info.common_info.transformation_name, owner = owner,
-                            interpreter = std::make_shared<Interpreter>(interpreter_context_),
-                            result = mgp_result{nullptr, memory_resource},
-                            total_retries = interpreter_context_->config.stream_transaction_conflict_retries,
-                            retry_interval = interpreter_context_->config.stream_transaction_retry_interval](
-                               const std::vector<typename TStream::Message> &messages) mutable {
+  auto process_messages = [interpreter_context = interpreter_context_, memory_resource, stream_name,
+                           transformation_name = stream_info.common_info.transformation_name, owner = owner,
+                           total_retries = interpreter_context_->config.stream_transaction_conflict_retries,
+                           retry_interval = interpreter_context_->config.stream_transaction_retry_interval](
+                              Interpreter &interpreter, mgp_result &result, const auto &messages) {
     auto accessor = interpreter_context->db->Access();
-    EventCounter::IncrementCounter(EventCounter::MessagesConsumed, messages.size());
     CallCustomTransformation(transformation_name, messages, result, accessor, *memory_resource, stream_name);
 
     DiscardValueResultStream stream;
@@ -498,14 +506,14 @@ Streams::StreamsMap::iterator Streams::CreateConsumer(StreamsMap &map, const std
     spdlog::trace("Start transaction in stream '{}'", stream_name);
     utils::OnScopeExit cleanup{[&interpreter, &result]() {
       result.rows.clear();
-      interpreter->Abort();
+      interpreter.Abort();
     }};
 
     const static std::map<std::string, storage::PropertyValue> empty_parameters{};
     uint32_t i = 0;
     while (true) {
       try {
-        interpreter->BeginTransaction();
+        interpreter.BeginTransaction();
         for (auto &row : result.rows) {
           spdlog::trace("Processing row in stream '{}'", stream_name);
           auto [query_value, params_value] = ExtractTransformationResult(row.values, transformation_name, stream_name);
@@ -514,22 +522,22 @@ Streams::StreamsMap::iterator Streams::CreateConsumer(StreamsMap &map, const std
           std::string query{query_value.ValueString()};
           spdlog::trace("Executing query '{}' in stream '{}'", query, stream_name);
           auto prepare_result =
-              interpreter->Prepare(query, params_prop.IsNull() ? empty_parameters : params_prop.ValueMap(), nullptr);
+              interpreter.Prepare(query, params_prop.IsNull() ? empty_parameters : params_prop.ValueMap(), nullptr);
           if (!interpreter_context->auth_checker->IsUserAuthorized(owner, prepare_result.privileges)) {
             throw StreamsException{
                 "Couldn't execute query '{}' for stream '{}' because the owner is not authorized to execute the "
                 "query!",
                 query, stream_name};
           }
-          interpreter->PullAll(&stream);
+          interpreter.PullAll(&stream);
         }
 
         spdlog::trace("Commit transaction in stream '{}'", stream_name);
-        interpreter->CommitTransaction();
+        interpreter.CommitTransaction();
         result.rows.clear();
         break;
       } catch (const query::TransactionSerializationException &e) {
-        interpreter->Abort();
+        interpreter.Abort();
         if (i == total_retries) {
           throw;
         }
@@ -539,6 +547,46 @@ Streams::StreamsMap::iterator Streams::CreateConsumer(StreamsMap &map, const std
     }
   };
 
+  int64_t parallelism{kDefaultParallelism};
+  if constexpr (std::same_as<TStream, KafkaStream>) {
+    // The streams restored on a machine with fewer hardware threads don't get more of them.
+    parallelism = std::min(stream_info.parallelism, KafkaStream::MaxParallelism());
+  }
+
+  auto consumer_function = [interpreter_context = interpreter_context_, memory_resource,
+                            process_messages = std::move(process_messages),
+                            interpreter = std::make_shared<Interpreter>(interpreter_context_),
+                            result = mgp_result{nullptr, memory_resource},
+                            group_processors = std::vector<PartitionGroupProcessor>{},
+                            pool = parallelism > 1 ? std::make_shared<utils::ThreadPool>(parallelism - 1) : nullptr](
+                               const std::vector<typename TStream::Message> &messages) mutable {
+    EventCounter::IncrementCounter(EventCounter::MessagesConsumed, messages.size());
+    if constexpr (std::same_as<TStream, KafkaStream>) {
+      if (pool) {
+        auto groups = SplitByPartition(messages, pool->Size() + 1);
+        if (groups.size() > 1) {
+          while (group_processors.size() < groups.size() - 1) {
+            group_processors.push_back({std::make_shared<Interpreter>(interpreter_context),
+                                        mgp_result{nullptr, memory_resource}});
+          }
+          // Each group is committed in its own transaction. If any of them fails, only the offsets of the partitions
+          // of the committed groups are committed, so the messages of the failed groups are consumed again, but the
+          // messages of the committed ones aren't.
+          ProcessPartitionGroups(groups, pool.get(), [&](const size_t index) {
+            if (index == 0) {
+              process_messages(*interpreter, result, groups[0]);
+            } else {
+              auto &processor = group_processors[index - 1];
+              process_messages(*processor.interpreter, processor.result, groups[index]);
+            }
+          });
+          return;
+        }
+      }
+    }
+    process_messages(*interpreter, result, messages);
+  };
+
   auto insert_result = map.try_emplace(
       stream_name, StreamData<TStream>{std::move(stream_info.common_info.transformation_name), std::move(owner),
                                        std::make_unique<SynchronizedStreamSource<TStream>>(
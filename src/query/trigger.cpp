@@ -152,11 +152,11 @@ std::vector<std::pair<Identifier, TriggerIdentifierTag>> GetPredefinedIdentifier
 
 Trigger::Trigger(std::string name, const std::string &query,
                  const std::map<std::string, storage::PropertyValue> &user_parameters,
-                 const TriggerEventType event_type, utils::SkipList<QueryCacheEntry> *query_cache,
-                 DbAccessor *db_accessor, utils::SpinLock *antlr_lock, const InterpreterConfig::Query &query_config,
-                 std::optional<std::string> owner, const query::AuthChecker *auth_checker)
+                 const TriggerEventType event_type, QueryCache *query_cache, DbAccessor *db_accessor,
+                 const InterpreterConfig::Query &query_config, std::optional<std::string> owner,
+                 const query::AuthChecker *auth_checker)
     : name_{std::move(name)},
-      parsed_statements_{ParseQuery(query, user_parameters, query_cache, antlr_lock, query_config)},
+      parsed_statements_{ParseQuery(query, user_parameters, query_cache, query_config)},
       event_type_{event_type},
       owner_{std::move(owner)} {
   // We check immediately if the query is valid by trying to create a plan.
@@ -193,17 +193,57 @@ std::shared_ptr<Trigger::TriggerPlan> Trigger::GetPlan(DbAccessor *db_accessor,
   return trigger_plan_;
 }
 
+void Trigger::InvalidatePlan() const {
+  std::lock_guard plan_guard{plan_lock_};
+  trigger_plan_.reset();
+}
+
 void Trigger::Execute(DbAccessor *dba, utils::MonotonicBufferResource *execution_memory,
                       const double max_execution_time_sec, std::atomic<bool> *is_shutting_down,
-                      const TriggerContext &context, const AuthChecker *auth_checker) const {
+                      const TriggerContext &context, const AuthChecker *auth_checker,
+                      TriggerContextCollector *trigger_context_collector) const {
+  if (!context.ShouldEventTrigger(event_type_)) {
+    return;
+  }
+
+  auto trigger_plan = GetPlan(dba, auth_checker);
+  MG_ASSERT(trigger_plan, "Invalid trigger plan received");
+  ExecutePlan(*trigger_plan, dba, execution_memory, max_execution_time_sec, is_shutting_down, context,
+              trigger_context_collector);
+}
+
+void Trigger::ExecuteAfterCommit(DbAccessor *dba, utils::MonotonicBufferResource *execution_memory,
+                                 const double max_execution_time_sec, std::atomic<bool> *is_shutting_down,
+                                 const TriggerContext &context, const AuthChecker *auth_checker,
+                                 TriggerContextCollector *trigger_context_collector) const {
   if (!context.ShouldEventTrigger(event_type_)) {
     return;
   }
 
-  spdlog::debug("Executing trigger '{}'", name_);
   auto trigger_plan = GetPlan(dba, auth_checker);
   MG_ASSERT(trigger_plan, "Invalid trigger plan received");
-  auto &[plan, identifiers] = *trigger_plan;
+  std::vector<TriggerIdentifierTag> referenced_tags;
+  for (const auto &[identifier, tag] : trigger_plan->identifiers) {
+    if (identifier.symbol_pos_ != -1) {
+      referenced_tags.push_back(tag);
+    }
+  }
+
+  const auto adapted_context = context.AdaptedForAccessor(dba, event_type_, referenced_tags);
+  // The objects may have been deleted in the meantime
+  if (!adapted_context.ShouldEventTrigger(event_type_)) {
+    return;
+  }
+  ExecutePlan(*trigger_plan, dba, execution_memory, max_execution_time_sec, is_shutting_down, adapted_context,
+              trigger_context_collector);
+}
+
+void Trigger::ExecutePlan(const TriggerPlan &trigger_plan, DbAccessor *dba,
+                          utils::MonotonicBufferResource *execution_memory, const double max_execution_time_sec,
+                          std::atomic<bool> *is_shutting_down, const TriggerContext &context,
+                          TriggerContextCollector *trigger_context_collector) const {
+  spdlog::debug("Executing trigger '{}'", name_);
+  const auto &[plan, identifiers] = trigger_plan;
 
   ExecutionContext ctx;
   ctx.db_accessor = dba;
@@ -215,6 +255,7 @@ void Trigger::Execute(DbAccessor *dba, utils::MonotonicBufferResource *execution
   ctx.timer = utils::AsyncTimer(max_execution_time_sec);
   ctx.is_shutting_down = is_shutting_down;
   ctx.is_profile_query = false;
+  ctx.trigger_context_collector = trigger_context_collector;
 
   // Set up temporary memory for a single Pull. Initial memory comes from the
   // stack. 256 KiB should fit on the stack and should be more than enough for a
@@ -256,8 +297,8 @@ constexpr uint64_t kVersion{2};
 
 TriggerStore::TriggerStore(std::filesystem::path directory) : storage_{std::move(directory)} {}
 
-void TriggerStore::RestoreTriggers(utils::SkipList<QueryCacheEntry> *query_cache, DbAccessor *db_accessor,
-                                   utils::SpinLock *antlr_lock, const InterpreterConfig::Query &query_config,
+void TriggerStore::RestoreTriggers(QueryCache *query_cache, DbAccessor *db_accessor,
+                                   const InterpreterConfig::Query &query_config,
                                    const query::AuthChecker *auth_checker) {
   MG_ASSERT(before_commit_triggers_.size() == 0 && after_commit_triggers_.size() == 0,
             "Cannot restore trigger when some triggers already exist!");
@@ -317,8 +358,8 @@ void TriggerStore::RestoreTriggers(utils::SkipList<QueryCacheEntry> *query_cache
 
     std::optional<Trigger> trigger;
     try {
-      trigger.emplace(trigger_name, statement, user_parameters, event_type, query_cache, db_accessor, antlr_lock,
-                      query_config, std::move(owner), auth_checker);
+      trigger.emplace(trigger_name, statement, user_parameters, event_type, query_cache, db_accessor, query_config,
+                      std::move(owner), auth_checker);
     } catch (const utils::BasicException &e) {
       spdlog::warn("Failed to create trigger '{}' because: {}", trigger_name, e.what());
       continue;
@@ -334,9 +375,8 @@ void TriggerStore::RestoreTriggers(utils::SkipList<QueryCacheEntry> *query_cache
 
 void TriggerStore::AddTrigger(std::string name, const std::string &query,
                               const std::map<std::string, storage::PropertyValue> &user_parameters,
-                              TriggerEventType event_type, TriggerPhase phase,
-                              utils::SkipList<QueryCacheEntry> *query_cache, DbAccessor *db_accessor,
-                              utils::SpinLock *antlr_lock, const InterpreterConfig::Query &query_config,
+                              TriggerEventType event_type, TriggerPhase phase, QueryCache *query_cache,
+                              DbAccessor *db_accessor, const InterpreterConfig::Query &query_config,
                               std::optional<std::string> owner, const query::AuthChecker *auth_checker) {
   std::unique_lock store_guard{store_lock_};
   if (storage_.Get(name)) {
@@ -345,8 +385,8 @@ void TriggerStore::AddTrigger(std::string name, const std::string &query,
 
   std::optional<Trigger> trigger;
   try {
-    trigger.emplace(std::move(name), query, user_parameters, event_type, query_cache, db_accessor, antlr_lock,
-                    query_config, std::move(owner), auth_checker);
+    trigger.emplace(std::move(name), query, user_parameters, event_type, query_cache, db_accessor, query_config,
+                    std::move(owner), auth_checker);
   } catch (const utils::BasicException &e) {
     const auto identifiers = GetPredefinedIdentifiers(event_type);
     std::stringstream identifier_names_stream;
@@ -381,6 +421,14 @@ void TriggerStore::AddTrigger(std::string name, const std::string &query,
   triggers_acc.insert(std::move(*trigger));
 }
 
+void TriggerStore::InvalidatePlans() {
+  for (auto *triggers : {&before_commit_triggers_, &after_commit_triggers_}) {
+    for (const auto &trigger : triggers->access()) {
+      trigger.InvalidatePlan();
+    }
+  }
+}
+
 void TriggerStore::DropTrigger(const std::string &name) {
   std::unique_lock store_guard{store_lock_};
   const auto maybe_trigger_data = storage_.Get(name);
@@ -34,13 +34,22 @@ namespace query {
 struct Trigger {
   explicit Trigger(std::string name, const std::string &query,
                    const std::map<std::string, storage::PropertyValue> &user_parameters, TriggerEventType event_type,
-                   utils::SkipList<QueryCacheEntry> *query_cache, DbAccessor *db_accessor, utils::SpinLock *antlr_lock,
-                   const InterpreterConfig::Query &query_config, std::optional<std::string> owner,
-                   const query::AuthChecker *auth_checker);
+                   QueryCache *query_cache, DbAccessor *db_accessor, const InterpreterConfig::Query &query_config,
+                   std::optional<std::string> owner, const query::AuthChecker *auth_checker);
 
+  /// The changes made by the trigger are registered with `trigger_context_collector`, if it's set.
   void Execute(DbAccessor *dba, utils::MonotonicBufferResource *execution_memory, double max_execution_time_sec,
-               std::atomic<bool> *is_shutting_down, const TriggerContext &context,
-               const AuthChecker *auth_checker) const;
+               std::atomic<bool> *is_shutting_down, const TriggerContext &context, const AuthChecker *auth_checker,
+               TriggerContextCollector *trigger_context_collector = nullptr) const;
+
+  /// Executes the trigger in a transaction other than the one which collected the `context`. Only the objects which
+  /// the trigger checks or references are adapted for `dba`, on a copy, so the `context` can be shared between the
+  /// triggers which are executed at the same time.
+  /// The changes made by the trigger are registered with `trigger_context_collector`, if it's set.
+  void ExecuteAfterCommit(DbAccessor *dba, utils::MonotonicBufferResource *execution_memory,
+                          double max_execution_time_sec, std::atomic<bool> *is_shutting_down,
+                          const TriggerContext &context, const AuthChecker *auth_checker,
+                          TriggerContextCollector *trigger_context_collector = nullptr) const;
 
   bool operator==(const Trigger &other) const { return name_ == other.name_; }
   // NOLINTNEXTLINE (modernize-use-nullptr)
@@ -54,6 +63,9 @@ struct Trigger {
   const auto &Owner() const noexcept { return owner_; }
   auto EventType() const noexcept { return event_type_; }
 
+  /// Makes the next execution of the trigger plan its statements again.
+  void InvalidatePlan() const;
+
  private:
   struct TriggerPlan {
     using IdentifierInfo = std::pair<Identifier, TriggerIdentifierTag>;
@@ -65,6 +77,10 @@ struct Trigger {
   };
   std::shared_ptr<TriggerPlan> GetPlan(DbAccessor *db_accessor, const query::AuthChecker *auth_checker) const;
 
+  void ExecutePlan(const TriggerPlan &trigger_plan, DbAccessor *dba, utils::MonotonicBufferResource *execution_memory,
+                   double max_execution_time_sec, std::atomic<bool> *is_shutting_down, const TriggerContext &context,
+                   TriggerContextCollector *trigger_context_collector) const;
+
   std::string name_;
   ParsedQuery parsed_statements_;
 
@@ -80,18 +96,20 @@ enum class TriggerPhase : uint8_t { BEFORE_COMMIT, AFTER_COMMIT };
 struct TriggerStore {
   explicit TriggerStore(std::filesystem::path directory);
 
-  void RestoreTriggers(utils::SkipList<QueryCacheEntry> *query_cache, DbAccessor *db_accessor,
-                       utils::SpinLock *antlr_lock, const InterpreterConfig::Query &query_config,
+  void RestoreTriggers(QueryCache *query_cache, DbAccessor *db_accessor, const InterpreterConfig::Query &query_config,
                        const query::AuthChecker *auth_checker);
 
   void AddTrigger(std::string name, const std::string &query,
                   const std::map<std::string, storage::PropertyValue> &user_parameters, TriggerEventType event_type,
-                  TriggerPhase phase, utils::SkipList<QueryCacheEntry> *query_cache, DbAccessor *db_accessor,
-                  utils::SpinLock *antlr_lock, const InterpreterConfig::Query &query_config,
-                  std::optional<std::string> owner, const query::AuthChecker *auth_checker);
+                  TriggerPhase phase, QueryCache *query_cache, DbAccessor *db_accessor,
+                  const InterpreterConfig::Query &query_config, std::optional<std::string> owner,
+                  const query::AuthChecker *auth_checker);
 
   void DropTrigger(const std::string &name);
 
+  /// Invalidates the plans of all triggers, e.g. because an index was created.
+  void InvalidatePlans();
+
   struct TriggerInfo {
     std::string name;
     std::string statement;
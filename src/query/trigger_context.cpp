@@ -12,6 +12,7 @@
 #include "query/trigger.hpp"
 
 #include <concepts>
+#include <iterator>
 
 #include "query/context.hpp"
 #include "query/cypher_query_interpreter.hpp"
@@ -156,6 +157,94 @@ bool AnyContainsValue(const TContainer &...value_containers) {
   return (!value_containers.empty() || ...);
 }
 
+// The lists of objects in the TriggerContext
+enum ContextList : uint16_t {
+  CREATED_VERTICES = 1U << 0U,
+  DELETED_VERTICES = 1U << 1U,
+  SET_VERTEX_PROPERTIES = 1U << 2U,
+  REMOVED_VERTEX_PROPERTIES = 1U << 3U,
+  SET_VERTEX_LABELS = 1U << 4U,
+  REMOVED_VERTEX_LABELS = 1U << 5U,
+  CREATED_EDGES = 1U << 6U,
+  DELETED_EDGES = 1U << 7U,
+  SET_EDGE_PROPERTIES = 1U << 8U,
+  REMOVED_EDGE_PROPERTIES = 1U << 9U,
+
+  UPDATED_VERTICES = SET_VERTEX_PROPERTIES | REMOVED_VERTEX_PROPERTIES | SET_VERTEX_LABELS | REMOVED_VERTEX_LABELS,
+  UPDATED_EDGES = SET_EDGE_PROPERTIES | REMOVED_EDGE_PROPERTIES,
+  ALL_LISTS = (1U << 10U) - 1
+};
+
+uint16_t ContextListsOf(const TriggerIdentifierTag tag) {
+  switch (tag) {
+    case TriggerIdentifierTag::CREATED_VERTICES:
+      return CREATED_VERTICES;
+    case TriggerIdentifierTag::CREATED_EDGES:
+      return CREATED_EDGES;
+    case TriggerIdentifierTag::CREATED_OBJECTS:
+      return CREATED_VERTICES | CREATED_EDGES;
+    case TriggerIdentifierTag::DELETED_VERTICES:
+      return DELETED_VERTICES;
+    case TriggerIdentifierTag::DELETED_EDGES:
+      return DELETED_EDGES;
+    case TriggerIdentifierTag::DELETED_OBJECTS:
+      return DELETED_VERTICES | DELETED_EDGES;
+    case TriggerIdentifierTag::SET_VERTEX_PROPERTIES:
+      return SET_VERTEX_PROPERTIES;
+    case TriggerIdentifierTag::SET_EDGE_PROPERTIES:
+      return SET_EDGE_PROPERTIES;
+    case TriggerIdentifierTag::REMOVED_VERTEX_PROPERTIES:
+      return REMOVED_VERTEX_PROPERTIES;
+    case TriggerIdentifierTag::REMOVED_EDGE_PROPERTIES:
+      return REMOVED_EDGE_PROPERTIES;
+    case TriggerIdentifierTag::SET_VERTEX_LABELS:
+      return SET_VERTEX_LABELS;
+    case TriggerIdentifierTag::REMOVED_VERTEX_LABELS:
+      return REMOVED_VERTEX_LABELS;
+    case TriggerIdentifierTag::UPDATED_VERTICES:
+      return UPDATED_VERTICES;
+    case TriggerIdentifierTag::UPDATED_EDGES:
+      return UPDATED_EDGES;
+    case TriggerIdentifierTag::UPDATED_OBJECTS:
+      return UPDATED_VERTICES | UPDATED_EDGES;
+  }
+}
+
+uint16_t ContextListsOf(const TriggerEventType event_type) {
+  switch (event_type) {
+    case TriggerEventType::ANY:
+      return ALL_LISTS;
+    case TriggerEventType::CREATE:
+      return CREATED_VERTICES | CREATED_EDGES;
+    case TriggerEventType::VERTEX_CREATE:
+      return CREATED_VERTICES;
+    case TriggerEventType::EDGE_CREATE:
+      return CREATED_EDGES;
+    case TriggerEventType::DELETE:
+      return DELETED_VERTICES | DELETED_EDGES;
+    case TriggerEventType::VERTEX_DELETE:
+      return DELETED_VERTICES;
+    case TriggerEventType::EDGE_DELETE:
+      return DELETED_EDGES;
+    case TriggerEventType::UPDATE:
+      return UPDATED_VERTICES | UPDATED_EDGES;
+    case TriggerEventType::VERTEX_UPDATE:
+      return UPDATED_VERTICES;
+    case TriggerEventType::EDGE_UPDATE:
+      return UPDATED_EDGES;
+  }
+}
+
+template <typename T>
+void AppendValues(std::vector<T> *values, std::vector<T> &&other_values) {
+  if (values->empty()) {
+    *values = std::move(other_values);
+    return;
+  }
+  values->insert(values->end(), std::make_move_iterator(other_values.begin()),
+                 std::make_move_iterator(other_values.end()));
+}
+
 template <detail::ObjectAccessor TAccessor>
 using ChangesSummary =
     std::tuple<std::vector<detail::CreatedObject<TAccessor>>, std::vector<detail::DeletedObject<TAccessor>>,
@@ -342,6 +431,47 @@ void TriggerContext::AdaptForAccessor(DbAccessor *accessor) {
   adapt_context_with_edge(&removed_edge_properties_);
 }
 
+TriggerContext TriggerContext::AdaptedForAccessor(DbAccessor *accessor, const TriggerEventType event_type,
+                                                  const std::vector<TriggerIdentifierTag> &tags) const {
+  auto lists = ContextListsOf(event_type);
+  for (const auto tag : tags) {
+    lists |= ContextListsOf(tag);
+  }
+
+  TriggerContext adapted;
+  const auto copy_if_needed = [lists](const ContextList list, const auto &values, auto *adapted_values) {
+    if (lists & list) {
+      *adapted_values = values;
+    }
+  };
+  copy_if_needed(CREATED_VERTICES, created_vertices_, &adapted.created_vertices_);
+  copy_if_needed(DELETED_VERTICES, deleted_vertices_, &adapted.deleted_vertices_);
+  copy_if_needed(SET_VERTEX_PROPERTIES, set_vertex_properties_, &adapted.set_vertex_properties_);
+  copy_if_needed(REMOVED_VERTEX_PROPERTIES, removed_vertex_properties_, &adapted.removed_vertex_properties_);
+  copy_if_needed(SET_VERTEX_LABELS, set_vertex_labels_, &adapted.set_vertex_labels_);
+  copy_if_needed(REMOVED_VERTEX_LABELS, removed_vertex_labels_, &adapted.removed_vertex_labels_);
+  copy_if_needed(CREATED_EDGES, created_edges_, &adapted.created_edges_);
+  copy_if_needed(DELETED_EDGES, deleted_edges_, &adapted.deleted_edges_);
+  copy_if_needed(SET_EDGE_PROPERTIES, set_edge_properties_, &adapted.set_edge_properties_);
+  copy_if_needed(REMOVED_EDGE_PROPERTIES, removed_edge_properties_, &adapted.removed_edge_properties_);
+
+  adapted.AdaptForAccessor(accessor);
+  return adapted;
+}
+
+void TriggerContext::Append(TriggerContext &&other) {
+  AppendValues(&created_vertices_, std::move(other.created_vertices_));
+  AppendValues(&deleted_vertices_, std::move(other.deleted_vertices_));
+  AppendValues(&set_vertex_properties_, std::move(other.set_vertex_properties_));
+  AppendValues(&removed_vertex_properties_, std::move(other.removed_vertex_properties_));
+  AppendValues(&set_vertex_labels_, std::move(other.set_vertex_labels_));
+  AppendValues(&removed_vertex_labels_, std::move(other.removed_vertex_labels_));
+  AppendValues(&created_edges_, std::move(other.created_edges_));
+  AppendValues(&deleted_edges_, std::move(other.deleted_edges_));
+  AppendValues(&set_edge_properties_, std::move(other.set_edge_properties_));
+  AppendValues(&removed_edge_properties_, std::move(other.removed_edge_properties_));
+}
+
 TypedValue TriggerContext::GetTypedValue(const TriggerIdentifierTag tag, DbAccessor *dba) const {
   switch (tag) {
     case TriggerIdentifierTag::CREATED_VERTICES:
@@ -199,10 +199,29 @@ class TriggerContext {
   // to the sent DbAccessor so they can be used safely)
   void AdaptForAccessor(DbAccessor *accessor);
 
+  // Return a copy of the TriggerContext adapted for a different DbAccessor, which only has the
+  // objects needed to check the event_type and to get the identifiers defined with tags
+  TriggerContext AdaptedForAccessor(DbAccessor *accessor, TriggerEventType event_type,
+                                    const std::vector<TriggerIdentifierTag> &tags) const;
+
+  // Append the objects of a TriggerContext collected in a later transaction.
+  // Unlike the changes within a single transaction, the appended changes
+  // aren't merged: a property set in several transactions has an entry for
+  // each of them, and an object created in one transaction and deleted in a
+  // later one is in both the created and the deleted objects, until the
+  // context is adapted and the created object is dropped because it doesn't
+  // exist anymore.
+  void Append(TriggerContext &&other);
+
   // Get TypedValue for the identifier defined with tag
   TypedValue GetTypedValue(TriggerIdentifierTag tag, DbAccessor *dba) const;
   bool ShouldEventTrigger(TriggerEventType) const;
 
+  const std::vector<detail::CreatedObject<VertexAccessor>> &CreatedVertices() const { return created_vertices_; }
+  const std::vector<detail::DeletedObject<VertexAccessor>> &DeletedVertices() const { return deleted_vertices_; }
+  const std::vector<detail::CreatedObject<EdgeAccessor>> &CreatedEdges() const { return created_edges_; }
+  const std::vector<detail::DeletedObject<EdgeAccessor>> &DeletedEdges() const { return deleted_edges_; }
+
  private:
   std::vector<detail::CreatedObject<VertexAccessor>> created_vertices_;
   std::vector<detail::DeletedObject<VertexAccessor>> deleted_vertices_;
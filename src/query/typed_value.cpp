@@ -923,10 +923,12 @@ TypedValue operator+(const TypedValue &a, const TypedValue &b) {
   if (a.IsNull() || b.IsNull()) return TypedValue(a.GetMemoryResource());
 
   if (a.IsList() || b.IsList()) {
+    auto list_size = [](const TypedValue &v) { return v.IsList() ? v.ValueList().size() : 1U; };
     TypedValue::TVector list(a.GetMemoryResource());
+    list.reserve(list_size(a) + list_size(b));
     auto append_list = [&list](const TypedValue &v) {
       if (v.IsList()) {
-        auto list2 = v.ValueList();
+        const auto &list2 = v.ValueList();
         list.insert(list.end(), list2.begin(), list2.end());
       } else {
         list.push_back(v);
@@ -944,7 +946,22 @@ TypedValue operator+(const TypedValue &a, const TypedValue &b) {
   EnsureArithmeticallyOk(a, b, true, "addition");
   // no more Bool nor Null, summing works on anything from here onward
 
-  if (a.IsString() || b.IsString()) return TypedValue(ValueToString(a) + ValueToString(b), a.GetMemoryResource());
+  if (a.IsString() || b.IsString()) {
+    // The result is built directly in the memory of `a`, instead of
+    // concatenating temporary copies of both operands.
+    TypedValue::TString string(a.GetMemoryResource());
+    auto append_string = [&string](const TypedValue &v) {
+      if (v.IsString()) {
+        string.append(v.ValueString());
+      } else {
+        string.append(ValueToString(v));
+      }
+    };
+    if (a.IsString() && b.IsString()) string.reserve(a.ValueString().size() + b.ValueString().size());
+    append_string(a);
+    append_string(b);
+    return TypedValue(std::move(string), a.GetMemoryResource());
+  }
 
   // at this point we only have int and double
   if (a.IsDouble() || b.IsDouble()) {
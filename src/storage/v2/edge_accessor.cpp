@@ -196,4 +196,27 @@ Result<std::map<PropertyId, PropertyValue>> EdgeAccessor::Properties(View view)
   return std::move(properties);
 }
 
+Result<void> EdgeAccessor::ForEachProperty(View view, const std::function<void(size_t)> &visit_count,
+                                           const std::function<void(PropertyId, const PropertyValue &)> &visit) const {
+  if (!config_.properties_on_edges) {
+    visit_count(0);
+    return {};
+  }
+  {
+    std::lock_guard<utils::SpinLock> guard(edge_.ptr->lock);
+    // Without the deltas, all of the transactions see the stored properties.
+    if (!edge_.ptr->delta) {
+      if (!for_deleted_ && edge_.ptr->deleted) return Error::DELETED_OBJECT;
+      visit_count(edge_.ptr->properties.PropertyCount());
+      edge_.ptr->properties.ForEachProperty(visit);
+      return {};
+    }
+  }
+  auto maybe_properties = Properties(view);
+  if (maybe_properties.HasError()) return maybe_properties.GetError();
+  visit_count(maybe_properties->size());
+  for (const auto &[property, value] : *maybe_properties) visit(property, value);
+  return {};
+}
+
 }  // namespace storage
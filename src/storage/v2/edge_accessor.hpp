@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <functional>
 #include <optional>
 
 #include "storage/v2/edge.hpp"
@@ -68,6 +69,15 @@ class EdgeAccessor final {
   /// @throw std::bad_alloc
   Result<std::map<PropertyId, PropertyValue>> Properties(View view) const;
 
+  /// Calls `visit_count` with the number of the properties and then `visit`
+  /// with each of them, in the order of the property IDs. If no transaction
+  /// has changes of the edge which aren't garbage collected yet, the
+  /// properties are read straight from the property store, under the lock of
+  /// the edge, without collecting them into a map like `Properties` does.
+  /// @throw std::bad_alloc
+  Result<void> ForEachProperty(View view, const std::function<void(size_t)> &visit_count,
+                               const std::function<void(PropertyId, const PropertyValue &)> &visit) const;
+
   Gid Gid() const noexcept {
     if (config_.properties_on_edges) {
       return edge_.ptr->gid;
@@ -1021,6 +1021,39 @@ std::map<PropertyId, PropertyValue> PropertyStore::Properties() const {
   return props;
 }
 
+size_t PropertyStore::PropertyCount() const {
+  uint64_t size;
+  const uint8_t *data;
+  std::tie(size, data) = GetSizeData(buffer_);
+  if (size % 8 != 0) {
+    // We are storing the data in the local buffer.
+    size = sizeof(buffer_) - 1;
+    data = &buffer_[1];
+  }
+  Reader reader(data, size);
+  size_t count = 0;
+  while (DecodeAnyProperty(&reader, nullptr)) ++count;
+  return count;
+}
+
+void PropertyStore::ForEachProperty(const std::function<void(PropertyId, const PropertyValue &)> &callback) const {
+  uint64_t size;
+  const uint8_t *data;
+  std::tie(size, data) = GetSizeData(buffer_);
+  if (size % 8 != 0) {
+    // We are storing the data in the local buffer.
+    size = sizeof(buffer_) - 1;
+    data = &buffer_[1];
+  }
+  Reader reader(data, size);
+  PropertyValue value;
+  while (true) {
+    auto prop = DecodeAnyProperty(&reader, &value);
+    if (!prop) break;
+    callback(*prop, value);
+  }
+}
+
 bool PropertyStore::SetProperty(PropertyId property, const PropertyValue &value) {
   uint64_t property_size = 0;
   if (!value.IsNull()) {
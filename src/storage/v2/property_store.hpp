@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include <cstddef>
+#include <functional>
 #include <map>
 
 #include "storage/v2/id_types.hpp"
@@ -51,6 +53,17 @@ class PropertyStore {
   /// @throw std::bad_alloc
   std::map<PropertyId, PropertyValue> Properties() const;
 
+  /// Returns the number of the stored properties. The time complexity of this
+  /// function is O(n).
+  size_t PropertyCount() const;
+
+  /// Calls `callback` for each of the stored properties, in the order of the
+  /// property IDs, without collecting them. The value passed to the callback
+  /// is reused for the next property. The time complexity of this function is
+  /// O(n).
+  /// @throw std::bad_alloc
+  void ForEachProperty(const std::function<void(PropertyId, const PropertyValue &)> &callback) const;
+
   /// Set a property value and return `true` if insertion took place. `false` is
   /// returned if assignment took place. The time complexity of this function is
   /// O(n).
@@ -0,0 +1,240 @@
+// Copyright 2021 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "storage/v2/statistics.hpp"
+
+#include <algorithm>
+
+#include "utils/logging.hpp"
+
+namespace storage {
+
+namespace {
+
+std::optional<double> NumericValue(const PropertyValue &value) {
+  if (value.IsInt()) return static_cast<double>(value.ValueInt());
+  if (value.IsDouble()) return value.ValueDouble();
+  return std::nullopt;
+}
+
+bool SatisfiesLowerBound(const PropertyValue &value, const std::optional<utils::Bound<PropertyValue>> &bound) {
+  if (!bound) return true;
+  if (!PropertyValue::AreComparableTypes(value.type(), bound->value().type())) return false;
+  return bound->IsInclusive() ? !(value < bound->value()) : bound->value() < value;
+}
+
+bool SatisfiesUpperBound(const PropertyValue &value, const std::optional<utils::Bound<PropertyValue>> &bound) {
+  if (!bound) return true;
+  if (!PropertyValue::AreComparableTypes(value.type(), bound->value().type())) return false;
+  return bound->IsInclusive() ? !(bound->value() < value) : value < bound->value();
+}
+
+// Estimates which part of the bucket falls inside the given range. Numeric
+// buckets are assumed to have uniformly distributed values, for all the other
+// types a partially covered bucket is assumed to be covered by half.
+double BucketFraction(const HistogramBucket &bucket, const std::optional<utils::Bound<PropertyValue>> &lower,
+                      const std::optional<utils::Bound<PropertyValue>> &upper) {
+  auto satisfies = [&](const PropertyValue &value) {
+    return SatisfiesLowerBound(value, lower) && SatisfiesUpperBound(value, upper);
+  };
+  const bool lower_inside = satisfies(bucket.lower_bound);
+  const bool upper_inside = satisfies(bucket.upper_bound);
+  if (lower_inside && upper_inside) return 1.0;
+
+  // Check whether the range and the bucket overlap at all.
+  if (lower && !(lower_inside || upper_inside)) {
+    if (!PropertyValue::AreComparableTypes(bucket.upper_bound.type(), lower->value().type()) ||
+        bucket.upper_bound < lower->value()) {
+      return 0.0;
+    }
+  }
+  if (upper && !(lower_inside || upper_inside)) {
+    if (!PropertyValue::AreComparableTypes(bucket.lower_bound.type(), upper->value().type()) ||
+        upper->value() < bucket.lower_bound) {
+      return 0.0;
+    }
+  }
+
+  auto bucket_lower = NumericValue(bucket.lower_bound);
+  auto bucket_upper = NumericValue(bucket.upper_bound);
+  auto range_lower = lower ? NumericValue(lower->value()) : bucket_lower;
+  auto range_upper = upper ? NumericValue(upper->value()) : bucket_upper;
+  if (bucket_lower && bucket_upper && range_lower && range_upper && *bucket_lower < *bucket_upper) {
+    const auto overlap_lower = std::max(*bucket_lower, *range_lower);
+    const auto overlap_upper = std::min(*bucket_upper, *range_upper);
+    if (overlap_upper < overlap_lower) return 0.0;
+    // Keep at least a single group of equal values, because the range
+    // overlaps the bucket.
+    const auto single_group = 1.0 / static_cast<double>(std::max<uint64_t>(bucket.distinct_values_count, 1));
+    return std::max((overlap_upper - overlap_lower) / (*bucket_upper - *bucket_lower), single_group);
+  }
+
+  if (lower_inside || upper_inside) return 0.5;
+  // The range is completely inside the bucket.
+  return 1.0 / static_cast<double>(std::max<uint64_t>(bucket.distinct_values_count, 1));
+}
+
+}  // namespace
+
+double LabelPropertyStatistics::AverageGroupSize() const {
+  if (distinct_values_count == 0) return 0.0;
+  return static_cast<double>(count) / static_cast<double>(distinct_values_count);
+}
+
+double LabelPropertyStatistics::EstimateEqualCount(const PropertyValue &value) const {
+  if (value.IsNull()) return 0.0;
+  // Find the first bucket whose upper bound isn't less than the value.
+  auto it = std::lower_bound(histogram.begin(), histogram.end(), value,
+                             [](const auto &bucket, const auto &value) { return bucket.upper_bound < value; });
+  if (it == histogram.end() || value < it->lower_bound) return 0.0;
+  if (it->distinct_values_count == 0) return 0.0;
+  return static_cast<double>(it->count) / static_cast<double>(it->distinct_values_count);
+}
+
+double LabelPropertyStatistics::EstimateRangeCount(const std::optional<utils::Bound<PropertyValue>> &lower,
+                                                   const std::optional<utils::Bound<PropertyValue>> &upper) const {
+  double estimate = 0.0;
+  for (const auto &bucket : histogram) {
+    estimate += BucketFraction(bucket, lower, upper) * static_cast<double>(bucket.count);
+  }
+  return estimate;
+}
+
+LabelPropertyStatisticsBuilder::LabelPropertyStatisticsBuilder(uint64_t expected_count, uint64_t max_buckets)
+    : bucket_size_(std::max<uint64_t>(1, expected_count / std::max<uint64_t>(1, max_buckets))) {}
+
+void LabelPropertyStatisticsBuilder::Add(const PropertyValue &value) {
+  if (value.IsNull()) return;
+  ++statistics_.count;
+  if (current_bucket_) {
+    DMG_ASSERT(!(value < current_bucket_->upper_bound), "Values for statistics must be added in sorted order");
+    if (current_bucket_->upper_bound == value) {
+      ++current_bucket_->count;
+      return;
+    }
+    // A new distinct value, close the bucket if it's full. Equal values are
+    // never split between buckets so that equality estimation stays simple.
+    if (current_bucket_->count >= bucket_size_) {
+      statistics_.histogram.push_back(std::move(*current_bucket_));
+      current_bucket_.reset();
+    }
+  }
+  ++statistics_.distinct_values_count;
+  if (!current_bucket_) {
+    current_bucket_.emplace(HistogramBucket{value, value, 1, 1});
+    return;
+  }
+  current_bucket_->upper_bound = value;
+  ++current_bucket_->count;
+  ++current_bucket_->distinct_values_count;
+}
+
+LabelPropertyStatistics LabelPropertyStatisticsBuilder::Finish() && {
+  if (current_bucket_) {
+    statistics_.histogram.push_back(std::move(*current_bucket_));
+    current_bucket_.reset();
+  }
+  return std::move(statistics_);
+}
+
+LabelPropertyStatisticsSampler::LabelPropertyStatisticsSampler(uint64_t sample_size, uint64_t seed)
+    : sample_size_(std::max<uint64_t>(1, sample_size)), generator_(seed) {}
+
+void LabelPropertyStatisticsSampler::Add(const PropertyValue &value) {
+  if (value.IsNull()) return;
+  ++seen_;
+  if (sample_.size() < sample_size_) {
+    sample_.push_back(value);
+    return;
+  }
+  std::uniform_int_distribution<uint64_t> distribution(0, seen_ - 1);
+  if (auto position = distribution(generator_); position < sample_size_) {
+    sample_[position] = value;
+  }
+}
+
+LabelPropertyStatistics LabelPropertyStatisticsSampler::Finish() && {
+  std::sort(sample_.begin(), sample_.end());
+  LabelPropertyStatisticsBuilder builder(sample_.size());
+  // Number of values which appear exactly once in the sample.
+  uint64_t singletons = 0;
+  for (size_t i = 0; i < sample_.size(); ++i) {
+    builder.Add(sample_[i]);
+    const bool same_as_previous = i > 0 && sample_[i - 1] == sample_[i];
+    const bool same_as_next = i + 1 < sample_.size() && sample_[i + 1] == sample_[i];
+    if (!same_as_previous && !same_as_next) ++singletons;
+  }
+  auto statistics = std::move(builder).Finish();
+  if (seen_ <= sample_.size()) return statistics;
+
+  // Extrapolate the number of distinct values with the Haas-Stokes estimator
+  // n * d / (n - f1 + f1 * n / N), where n is the sample size, N the number of
+  // values, d the number of distinct values in the sample and f1 the number of
+  // values which appear exactly once in the sample.
+  const auto sample_count = static_cast<double>(sample_.size());
+  const auto total_count = static_cast<double>(seen_);
+  const auto sample_distinct = static_cast<double>(statistics.distinct_values_count);
+  const auto denominator =
+      sample_count - static_cast<double>(singletons) + static_cast<double>(singletons) * sample_count / total_count;
+  auto distinct = denominator > 0 ? sample_count * sample_distinct / denominator : total_count;
+  distinct = std::clamp(distinct, sample_distinct, total_count);
+
+  const auto count_scale = total_count / sample_count;
+  const auto distinct_scale = distinct / sample_distinct;
+  for (auto &bucket : statistics.histogram) {
+    bucket.count = static_cast<uint64_t>(static_cast<double>(bucket.count) * count_scale);
+    bucket.distinct_values_count = std::max<uint64_t>(
+        1, static_cast<uint64_t>(static_cast<double>(bucket.distinct_values_count) * distinct_scale));
+  }
+  statistics.count = seen_;
+  statistics.distinct_values_count = static_cast<uint64_t>(distinct);
+  return statistics;
+}
+
+uint64_t GraphStatistics::LabelCount(LabelId label) const {
+  auto it = label_count.find(label);
+  if (it == label_count.end()) return 0;
+  return it->second;
+}
+
+double GraphStatistics::AverageOutDegree(const std::vector<EdgeTypeId> &edge_types) const {
+  if (edge_types.empty()) {
+    return vertex_count ? static_cast<double>(edge_count) / static_cast<double>(vertex_count) : 0.0;
+  }
+  double degree = 0.0;
+  for (const auto edge_type_id : edge_types) {
+    if (auto it = edge_type.find(edge_type_id); it != edge_type.end()) {
+      degree += it->second.AverageOutDegree();
+    }
+  }
+  return degree;
+}
+
+double GraphStatistics::AverageInDegree(const std::vector<EdgeTypeId> &edge_types) const {
+  if (edge_types.empty()) {
+    return vertex_count ? static_cast<double>(edge_count) / static_cast<double>(vertex_count) : 0.0;
+  }
+  double degree = 0.0;
+  for (const auto edge_type_id : edge_types) {
+    if (auto it = edge_type.find(edge_type_id); it != edge_type.end()) {
+      degree += it->second.AverageInDegree();
+    }
+  }
+  return degree;
+}
+
+const LabelPropertyStatistics *GraphStatistics::GetLabelPropertyStatistics(LabelId label, PropertyId property) const {
+  auto it = label_property.find({label, property});
+  if (it == label_property.end()) return nullptr;
+  return &it->second;
+}
+
+}  // namespace storage
@@ -0,0 +1,140 @@
+// Copyright 2021 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "storage/v2/id_types.hpp"
+#include "storage/v2/property_value.hpp"
+#include "utils/bound.hpp"
+
+namespace storage {
+
+/// Number of buckets in the equi-depth histograms built by `ANALYZE GRAPH`.
+constexpr uint64_t kStatisticsHistogramBuckets = 64;
+
+/// Number of property values sampled for label-property pairs which don't
+/// have an index.
+constexpr uint64_t kStatisticsSampleSize = 4096;
+
+/// A single bucket of an equi-depth histogram. All the values which fall into
+/// the bucket are inside the closed range [lower_bound, upper_bound]. Equal
+/// values are never split between two buckets.
+struct HistogramBucket {
+  PropertyValue lower_bound;
+  PropertyValue upper_bound;
+  uint64_t count{0};
+  uint64_t distinct_values_count{0};
+};
+
+/// Statistics about the values of a single property on vertices with a single
+/// label.
+struct LabelPropertyStatistics {
+  uint64_t count{0};
+  uint64_t distinct_values_count{0};
+  /// Buckets are sorted by their bounds and don't overlap.
+  std::vector<HistogramBucket> histogram;
+
+  /// Average number of vertices that share the same property value.
+  double AverageGroupSize() const;
+
+  /// Estimated number of vertices whose property is equal to `value`.
+  double EstimateEqualCount(const PropertyValue &value) const;
+
+  /// Estimated number of vertices whose property is inside the given range.
+  double EstimateRangeCount(const std::optional<utils::Bound<PropertyValue>> &lower,
+                            const std::optional<utils::Bound<PropertyValue>> &upper) const;
+};
+
+/// Builds `LabelPropertyStatistics` from a stream of property values which
+/// must be passed in sorted order, e.g. as read from a label-property index.
+class LabelPropertyStatisticsBuilder final {
+ public:
+  /// `expected_count` is used to determine the size of histogram buckets. It
+  /// doesn't need to be exact.
+  explicit LabelPropertyStatisticsBuilder(uint64_t expected_count,
+                                          uint64_t max_buckets = kStatisticsHistogramBuckets);
+
+  void Add(const PropertyValue &value);
+
+  LabelPropertyStatistics Finish() &&;
+
+ private:
+  uint64_t bucket_size_;
+  LabelPropertyStatistics statistics_;
+  std::optional<HistogramBucket> current_bucket_;
+};
+
+/// Builds `LabelPropertyStatistics` from a stream of unsorted property values
+/// by keeping a fixed size uniform sample of them (reservoir sampling). The
+/// total count is exact, while the histogram and the number of distinct values
+/// are extrapolated from the sample.
+class LabelPropertyStatisticsSampler final {
+ public:
+  explicit LabelPropertyStatisticsSampler(uint64_t sample_size = kStatisticsSampleSize, uint64_t seed = 0);
+
+  void Add(const PropertyValue &value);
+
+  LabelPropertyStatistics Finish() &&;
+
+ private:
+  uint64_t sample_size_;
+  uint64_t seen_{0};
+  std::vector<PropertyValue> sample_;
+  std::mt19937_64 generator_;
+};
+
+/// Statistics about the edges of a single edge type.
+struct EdgeTypeStatistics {
+  uint64_t count{0};
+  /// Number of distinct vertices with at least one outgoing edge of this type.
+  uint64_t source_count{0};
+  /// Number of distinct vertices with at least one incoming edge of this type.
+  uint64_t destination_count{0};
+
+  double AverageOutDegree() const { return source_count ? static_cast<double>(count) / source_count : 0.0; }
+  double AverageInDegree() const { return destination_count ? static_cast<double>(count) / destination_count : 0.0; }
+};
+
+/// Statistics about the whole graph collected by `Storage::AnalyzeGraph`. The
+/// query planner uses them for cardinality estimation when choosing the order
+/// of graph traversal.
+struct GraphStatistics {
+  uint64_t vertex_count{0};
+  uint64_t edge_count{0};
+  std::map<LabelId, uint64_t> label_count;
+  std::map<EdgeTypeId, EdgeTypeStatistics> edge_type;
+  /// Exact for label-property pairs which have an index, extrapolated from a
+  /// sample of values for all the other pairs.
+  std::map<std::pair<LabelId, PropertyId>, LabelPropertyStatistics> label_property;
+
+  /// Returns the number of vertices with the given label.
+  uint64_t LabelCount(LabelId label) const;
+
+  /// Average number of outgoing edges of the given types for a vertex which
+  /// has such edges. All edge types are considered if `edge_types` is empty.
+  double AverageOutDegree(const std::vector<EdgeTypeId> &edge_types) const;
+
+  /// Average number of incoming edges of the given types for a vertex which
+  /// has such edges. All edge types are considered if `edge_types` is empty.
+  double AverageInDegree(const std::vector<EdgeTypeId> &edge_types) const;
+
+  /// Returns nullptr if there are no statistics for the given pair.
+  const LabelPropertyStatistics *GetLabelPropertyStatistics(LabelId label, PropertyId property) const;
+};
+
+}  // namespace storage
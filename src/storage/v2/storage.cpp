@@ -12,6 +12,7 @@
 #include "storage/v2/storage.hpp"
 #include <algorithm>
 #include <atomic>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <variant>
@@ -1793,6 +1794,87 @@ utils::BasicResult<Storage::CreateSnapshotError> Storage::CreateSnapshot() {
   return {};
 }
 
+std::shared_ptr<const GraphStatistics> Storage::AnalyzeGraph() {
+  auto statistics = std::make_shared<GraphStatistics>();
+  {
+    auto accessor = Access(IsolationLevel::SNAPSHOT_ISOLATION);
+    const auto label_property_indices = accessor.ListAllIndices().label_property;
+    auto is_indexed = [&label_property_indices](LabelId label, PropertyId property) {
+      return std::find(label_property_indices.begin(), label_property_indices.end(), std::make_pair(label, property)) !=
+             label_property_indices.end();
+    };
+    // Label-property pairs without an index are sampled during the vertex
+    // scan, the indexed ones are read from the index afterwards.
+    std::map<std::pair<LabelId, PropertyId>, LabelPropertyStatisticsSampler> samplers;
+    // Edge types seen on the current vertex, used for counting the distinct
+    // sources and destinations of each edge type.
+    std::vector<EdgeTypeId> seen_edge_types;
+    for (auto vertex : accessor.Vertices(View::OLD)) {
+      ++statistics->vertex_count;
+      auto maybe_labels = vertex.Labels(View::OLD);
+      MG_ASSERT(maybe_labels.HasValue(), "Invalid database state!");
+      for (const auto label : *maybe_labels) {
+        ++statistics->label_count[label];
+      }
+      if (!maybe_labels->empty()) {
+        auto maybe_properties = vertex.Properties(View::OLD);
+        MG_ASSERT(maybe_properties.HasValue(), "Invalid database state!");
+        for (const auto label : *maybe_labels) {
+          for (const auto &[property, value] : *maybe_properties) {
+            if (is_indexed(label, property)) continue;
+            samplers[std::make_pair(label, property)].Add(value);
+          }
+        }
+      }
+
+      auto maybe_out_edges = vertex.OutEdges(View::OLD);
+      MG_ASSERT(maybe_out_edges.HasValue(), "Invalid database state!");
+      seen_edge_types.clear();
+      for (const auto &edge : *maybe_out_edges) {
+        auto &edge_type_statistics = statistics->edge_type[edge.EdgeType()];
+        ++edge_type_statistics.count;
+        ++statistics->edge_count;
+        if (std::find(seen_edge_types.begin(), seen_edge_types.end(), edge.EdgeType()) == seen_edge_types.end()) {
+          seen_edge_types.push_back(edge.EdgeType());
+          ++edge_type_statistics.source_count;
+        }
+      }
+
+      auto maybe_in_edges = vertex.InEdges(View::OLD);
+      MG_ASSERT(maybe_in_edges.HasValue(), "Invalid database state!");
+      seen_edge_types.clear();
+      for (const auto &edge : *maybe_in_edges) {
+        if (std::find(seen_edge_types.begin(), seen_edge_types.end(), edge.EdgeType()) == seen_edge_types.end()) {
+          seen_edge_types.push_back(edge.EdgeType());
+          ++statistics->edge_type[edge.EdgeType()].destination_count;
+        }
+      }
+    }
+
+    // The label-property indices are sorted by the property value, so the
+    // histograms can be built in a single pass with bounded memory.
+    for (auto &[label_property, sampler] : samplers) {
+      statistics->label_property.emplace(label_property, std::move(sampler).Finish());
+    }
+    for (const auto &[label, property] : label_property_indices) {
+      LabelPropertyStatisticsBuilder builder(accessor.ApproximateVertexCount(label, property));
+      for (auto vertex : accessor.Vertices(label, property, View::OLD)) {
+        auto maybe_value = vertex.GetProperty(property, View::OLD);
+        MG_ASSERT(maybe_value.HasValue(), "Invalid database state!");
+        builder.Add(*maybe_value);
+      }
+      statistics->label_property.emplace(std::make_pair(label, property), std::move(builder).Finish());
+    }
+  }
+
+  graph_statistics_.WithLock([&statistics](auto &graph_statistics) { graph_statistics = statistics; });
+  return statistics;
+}
+
+std::shared_ptr<const GraphStatistics> Storage::GetGraphStatistics() const {
+  return graph_statistics_.WithLock([](const auto &graph_statistics) { return graph_statistics; });
+}
+
 bool Storage::LockPath() {
   auto locker_accessor = global_locker_.Access();
   return locker_accessor.AddPath(config_.durability.storage_directory);
@@ -1927,6 +2009,8 @@ std::optional<replication::ReplicaState> Storage::GetReplicaState(const std::str
 
 ReplicationRole Storage::GetReplicationRole() const { return replication_role_; }
 
+uint64_t Storage::LastCommitTimestamp() const { return last_commit_timestamp_.load(); }
+
 std::vector<Storage::ReplicaInfo> Storage::ReplicasInfo() {
   return replication_clients_.WithLock([](auto &clients) {
     std::vector<Storage::ReplicaInfo> replica_info;
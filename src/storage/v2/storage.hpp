@@ -13,6 +13,7 @@
 
 #include <atomic>
 #include <filesystem>
+#include <memory>
 #include <optional>
 #include <shared_mutex>
 #include <variant>
@@ -30,6 +31,7 @@
 #include "storage/v2/mvcc.hpp"
 #include "storage/v2/name_id_mapper.hpp"
 #include "storage/v2/result.hpp"
+#include "storage/v2/statistics.hpp"
 #include "storage/v2/transaction.hpp"
 #include "storage/v2/vertex.hpp"
 #include "storage/v2/vertex_accessor.hpp"
@@ -306,6 +308,10 @@ class Storage final {
               storage_->constraints_.unique_constraints.ListConstraints()};
     }
 
+    /// Return the statistics collected by the last `Storage::AnalyzeGraph`
+    /// call, or nullptr if the graph was never analyzed.
+    std::shared_ptr<const GraphStatistics> GetGraphStatistics() const { return storage_->GetGraphStatistics(); }
+
     void AdvanceCommand();
 
     /// Commit returns `ConstraintViolation` if the changes made by this
@@ -425,6 +431,11 @@ class Storage final {
 
   ReplicationRole GetReplicationRole() const;
 
+  /// Return the commit timestamp of the last committed transaction which
+  /// changed the storage, including the index and constraint changes and the
+  /// transactions received from the main instance.
+  uint64_t LastCommitTimestamp() const;
+
   struct ReplicaInfo {
     std::string name;
     replication::ReplicationMode mode;
@@ -443,6 +454,14 @@ class Storage final {
 
   utils::BasicResult<CreateSnapshotError> CreateSnapshot();
 
+  /// Scans the whole graph and the label-property indices to collect the
+  /// statistics used by the query planner. The new statistics replace the
+  /// previously collected ones.
+  /// @throw std::bad_alloc
+  std::shared_ptr<const GraphStatistics> AnalyzeGraph();
+
+  std::shared_ptr<const GraphStatistics> GetGraphStatistics() const;
+
  private:
   Transaction CreateTransaction(IsolationLevel isolation_level);
 
@@ -492,6 +511,9 @@ class Storage final {
   Constraints constraints_;
   Indices indices_;
 
+  // Statistics for the query planner, refreshed only through `AnalyzeGraph`.
+  mutable utils::Synchronized<std::shared_ptr<const GraphStatistics>, utils::SpinLock> graph_statistics_;
+
   // Transaction engine
   utils::SpinLock engine_lock_;
   uint64_t timestamp_{kTimestampInitialId};
@@ -339,6 +339,26 @@ Result<std::map<PropertyId, PropertyValue>> VertexAccessor::Properties(View view
   return std::move(properties);
 }
 
+Result<void> VertexAccessor::ForEachProperty(
+    View view, const std::function<void(size_t)> &visit_count,
+    const std::function<void(PropertyId, const PropertyValue &)> &visit) const {
+  {
+    std::lock_guard<utils::SpinLock> guard(vertex_->lock);
+    // Without the deltas, all of the transactions see the stored properties.
+    if (!vertex_->delta) {
+      if (!for_deleted_ && vertex_->deleted) return Error::DELETED_OBJECT;
+      visit_count(vertex_->properties.PropertyCount());
+      vertex_->properties.ForEachProperty(visit);
+      return {};
+    }
+  }
+  auto maybe_properties = Properties(view);
+  if (maybe_properties.HasError()) return maybe_properties.GetError();
+  visit_count(maybe_properties->size());
+  for (const auto &[property, value] : *maybe_properties) visit(property, value);
+  return {};
+}
+
 Result<std::vector<EdgeAccessor>> VertexAccessor::InEdges(View view, const std::vector<EdgeTypeId> &edge_types,
                                                           const VertexAccessor *destination) const {
   MG_ASSERT(!destination || destination->transaction_ == transaction_, "Invalid accessor!");
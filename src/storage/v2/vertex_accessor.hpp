@@ -11,6 +11,7 @@
 
 #pragma once
 
+#include <functional>
 #include <optional>
 
 #include "storage/v2/vertex.hpp"
@@ -78,6 +79,15 @@ class VertexAccessor final {
   /// @throw std::bad_alloc
   Result<std::map<PropertyId, PropertyValue>> Properties(View view) const;
 
+  /// Calls `visit_count` with the number of the properties and then `visit`
+  /// with each of them, in the order of the property IDs. If no transaction
+  /// has changes of the vertex which aren't garbage collected yet, the
+  /// properties are read straight from the property store, under the lock of
+  /// the vertex, without collecting them into a map like `Properties` does.
+  /// @throw std::bad_alloc
+  Result<void> ForEachProperty(View view, const std::function<void(size_t)> &visit_count,
+                               const std::function<void(PropertyId, const PropertyValue &)> &visit) const;
+
   /// @throw std::bad_alloc
   /// @throw std::length_error if the resulting vector exceeds
   ///        std::vector::max_size().
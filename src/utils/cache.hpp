@@ -13,10 +13,17 @@
 
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <unordered_map>
+#include <vector>
 
 #include "utils/logging.hpp"
+#include "utils/spin_lock.hpp"
 
 namespace utils {
 namespace impl {
@@ -164,6 +171,122 @@ class LruCache {
   std::unordered_map<TKey, impl::Node<TKey, TValue> *> access_map_;
 };
 
+/// Thread safe cache of shared objects which is bounded by the total size of
+/// the objects in bytes. Uses least recently used replacement algorithm for
+/// evicting elements when the maximum size would be exceeded. The evicted
+/// objects are only released by the cache, so they stay alive as long as
+/// someone still holds them.
+///
+/// @tparam TKey - any object that has hash() defined
+/// @tparam TValue - any object
+template <typename TKey, typename TValue>
+class MemoryBoundedLruCache {
+ public:
+  explicit MemoryBoundedLruCache(uint64_t max_memory_usage) : max_memory_usage_(max_memory_usage) {}
+
+  MemoryBoundedLruCache(const MemoryBoundedLruCache &) = delete;
+  MemoryBoundedLruCache(MemoryBoundedLruCache &&) = delete;
+  MemoryBoundedLruCache &operator=(const MemoryBoundedLruCache &) = delete;
+  MemoryBoundedLruCache &operator=(MemoryBoundedLruCache &&) = delete;
+  ~MemoryBoundedLruCache() = default;
+
+  /// Returns the cached object, or nullptr if there is no object cached under
+  /// the given key.
+  std::shared_ptr<TValue> Find(const TKey &key) {
+    std::lock_guard<SpinLock> guard(lock_);
+    auto found = access_map_.find(key);
+    if (found == access_map_.end()) {
+      misses_.fetch_add(1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    lru_order_.splice(lru_order_.begin(), lru_order_, found->second);
+    return found->second->value;
+  }
+
+  /// Inserts the object with the given size in bytes to the cache and returns
+  /// the cached object. If an object is already cached under the key, it is
+  /// kept and returned instead. Objects larger than the maximum size aren't
+  /// cached.
+  std::shared_ptr<TValue> Insert(const TKey &key, std::shared_ptr<TValue> value, uint64_t memory_usage) {
+    // Evicted objects are released after the lock, because destroying them
+    // may take a while.
+    std::vector<std::shared_ptr<TValue>> evicted;
+    std::lock_guard<SpinLock> guard(lock_);
+    if (auto found = access_map_.find(key); found != access_map_.end()) {
+      lru_order_.splice(lru_order_.begin(), lru_order_, found->second);
+      return found->second->value;
+    }
+    if (memory_usage > max_memory_usage_) return value;
+
+    while (memory_usage_ + memory_usage > max_memory_usage_) {
+      auto &rear = lru_order_.back();
+      memory_usage_ -= rear.memory_usage;
+      access_map_.erase(rear.key);
+      evicted.push_back(std::move(rear.value));
+      lru_order_.pop_back();
+      evictions_.fetch_add(1, std::memory_order_relaxed);
+    }
+    lru_order_.push_front(Entry{key, value, memory_usage});
+    access_map_.emplace(key, lru_order_.begin());
+    memory_usage_ += memory_usage;
+    return value;
+  }
+
+  /// Removes the object cached under the given key, if there is one.
+  void Erase(const TKey &key) {
+    std::shared_ptr<TValue> erased;
+    std::lock_guard<SpinLock> guard(lock_);
+    auto found = access_map_.find(key);
+    if (found == access_map_.end()) return;
+    memory_usage_ -= found->second->memory_usage;
+    erased = std::move(found->second->value);
+    lru_order_.erase(found->second);
+    access_map_.erase(found);
+  }
+
+  void Clear() {
+    std::list<Entry> erased;
+    std::lock_guard<SpinLock> guard(lock_);
+    access_map_.clear();
+    erased.swap(lru_order_);
+    memory_usage_ = 0;
+  }
+
+  size_t size() const {
+    std::lock_guard<SpinLock> guard(lock_);
+    return access_map_.size();
+  }
+
+  /// Total size of the cached objects in bytes.
+  uint64_t memory_usage() const {
+    std::lock_guard<SpinLock> guard(lock_);
+    return memory_usage_;
+  }
+
+  uint64_t max_memory_usage() const { return max_memory_usage_; }
+
+  uint64_t hits() const { return hits_.load(std::memory_order_relaxed); }
+  uint64_t misses() const { return misses_.load(std::memory_order_relaxed); }
+  uint64_t evictions() const { return evictions_.load(std::memory_order_relaxed); }
+
+ private:
+  struct Entry {
+    TKey key;
+    std::shared_ptr<TValue> value;
+    uint64_t memory_usage;
+  };
+
+  const uint64_t max_memory_usage_;
+  mutable SpinLock lock_;
+  uint64_t memory_usage_{0};
+  std::list<Entry> lru_order_;
+  std::unordered_map<TKey, typename std::list<Entry>::iterator> access_map_;
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> misses_{0};
+  std::atomic<uint64_t> evictions_{0};
+};
+
 /// Used for caching objects. Uses least recently used page replacement
 /// algorithm for evicting elements when maximum size is reached. This class
 /// is NOT thread safe.
@@ -51,6 +51,11 @@
   M(CallProcedureOperator, "Number of times CallProcedure operator was used.")                             \
                                                                                                            \
   M(FailedQuery, "Number of times executing a query failed.")                                              \
+  M(QueryCacheHit, "Number of times a parsed query was found in the AST cache.")                           \
+  M(QueryCacheMiss, "Number of times a query had to be parsed because it wasn't in the AST cache.")        \
+  M(PlanCacheHit, "Number of times a query plan was found in the plan cache.")                             \
+  M(PlanCacheMiss, "Number of times a query had to be planned because it wasn't in the plan cache.")       \
+  M(PlanCardinalityDrift, "Number of cached plans expired because of wrong cardinality estimates.")        \
   M(LabelIndexCreated, "Number of times a label index was created.")                                       \
   M(LabelPropertyIndexCreated, "Number of times a label property index was created.")                      \
   M(StreamsCreated, "Number of Streams created.")                                                          \
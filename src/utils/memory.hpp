@@ -15,6 +15,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
 #include <memory>
 #include <mutex>
@@ -537,6 +538,35 @@ class SynchronizedPoolResource final : public MemoryResource {
   bool DoIsEqual(const MemoryResource &other) const noexcept override { return this == &other; }
 };
 
+/// MemoryResource which forwards the allocations to the upstream resource
+/// under a SpinLock, so that a resource which isn't thread safe can be shared
+/// between multiple threads.
+class SynchronizedMemoryResource final : public MemoryResource {
+ public:
+  explicit SynchronizedMemoryResource(MemoryResource *memory) : memory_(memory) {}
+
+  /// The lock held while using the upstream resource. Other resources which
+  /// share state with the upstream, e.g. the parent of a
+  /// TrackingMemoryResource, can hold it as well.
+  SpinLock &GetLock() noexcept { return lock_; }
+
+ private:
+  MemoryResource *memory_;
+  SpinLock lock_;
+
+  void *DoAllocate(size_t bytes, size_t alignment) override {
+    std::lock_guard<SpinLock> guard(lock_);
+    return memory_->Allocate(bytes, alignment);
+  }
+
+  void DoDeallocate(void *p, size_t bytes, size_t alignment) override {
+    std::lock_guard<SpinLock> guard(lock_);
+    memory_->Deallocate(p, bytes, alignment);
+  }
+
+  bool DoIsEqual(const MemoryResource &other) const noexcept override { return this == &other; }
+};
+
 class LimitedMemoryResource final : public utils::MemoryResource {
  public:
   explicit LimitedMemoryResource(utils::MemoryResource *memory, size_t max_allocated_bytes)
@@ -564,6 +594,75 @@ class LimitedMemoryResource final : public utils::MemoryResource {
   bool DoIsEqual(const MemoryResource &other) const noexcept override { return this == &other; }
 };
 
+/// MemoryResource which forwards the allocations to the upstream resource and
+/// counts the number of bytes currently allocated through it, as well as the
+/// highest number of bytes allocated at any point.
+///
+/// The allocations are also counted by the parent resource, if there is one,
+/// so that the parent tracks the total of multiple resources.
+class TrackingMemoryResource final : public utils::MemoryResource {
+ public:
+  explicit TrackingMemoryResource(utils::MemoryResource *memory, TrackingMemoryResource *parent = nullptr)
+      : memory_(memory), parent_(parent) {}
+
+  TrackingMemoryResource(const TrackingMemoryResource &) = delete;
+  TrackingMemoryResource &operator=(const TrackingMemoryResource &) = delete;
+  TrackingMemoryResource(TrackingMemoryResource &&) = delete;
+  TrackingMemoryResource &operator=(TrackingMemoryResource &&) = delete;
+
+  /// The bytes which are still allocated stop counting towards the parent,
+  /// because the upstream resource is expected to release them.
+  ~TrackingMemoryResource() override { SetParent(nullptr); }
+
+  /// Changes the parent, moving the currently allocated bytes over to it.
+  void SetParent(TrackingMemoryResource *parent) noexcept {
+    if (parent == parent_) return;
+    if (parent_) parent_->Untrack(allocated_bytes_);
+    parent_ = parent;
+    if (parent_) parent_->Track(allocated_bytes_);
+  }
+
+  size_t GetAllocatedBytes() const noexcept { return allocated_bytes_; }
+
+  size_t GetPeakAllocatedBytes() const noexcept { return peak_allocated_bytes_; }
+
+  /// Number of bytes allocated so far, including the deallocated ones.
+  size_t GetTotalAllocatedBytes() const noexcept { return total_allocated_bytes_; }
+
+ private:
+  utils::MemoryResource *memory_;
+  TrackingMemoryResource *parent_;
+  size_t allocated_bytes_{0};
+  size_t peak_allocated_bytes_{0};
+  size_t total_allocated_bytes_{0};
+
+  void Track(size_t bytes) noexcept {
+    allocated_bytes_ += bytes;
+    total_allocated_bytes_ += bytes;
+    peak_allocated_bytes_ = std::max(peak_allocated_bytes_, allocated_bytes_);
+    if (parent_) parent_->Track(bytes);
+  }
+
+  void Untrack(size_t bytes) noexcept {
+    MG_ASSERT(allocated_bytes_ >= bytes, "Failed deallocation");
+    allocated_bytes_ -= bytes;
+    if (parent_) parent_->Untrack(bytes);
+  }
+
+  void *DoAllocate(size_t bytes, size_t alignment) override {
+    auto *ptr = memory_->Allocate(bytes, alignment);
+    Track(bytes);
+    return ptr;
+  }
+
+  void DoDeallocate(void *p, size_t bytes, size_t alignment) override {
+    Untrack(bytes);
+    return memory_->Deallocate(p, bytes, alignment);
+  }
+
+  bool DoIsEqual(const MemoryResource &other) const noexcept override { return this == &other; }
+};
+
 // Allocate memory with the OutOfMemoryException enabled if the requested size
 // puts total allocated amount over the limit.
 class ResourceWithOutOfMemoryException : public MemoryResource {
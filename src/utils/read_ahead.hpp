@@ -0,0 +1,180 @@
+// Copyright 2021 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+#include "utils/thread_pool.hpp"
+
+namespace utils {
+
+/// Produces the values of a sequence ahead of their consumer. The values are
+/// produced by tasks on the given thread pool into a buffer, which holds at
+/// most `capacity` of them. The production pauses when the buffer is full and
+/// continues as the consumer takes the values out of it.
+///
+/// The producer is never called concurrently. When the consumer needs a value
+/// and nothing is being produced in the background (e.g. all of the threads in
+/// the pool are busy), the consumer calls the producer itself, so it never
+/// waits for a free thread.
+///
+/// The consumer side (`Pop`, `HasMore` and `Stop`) must be used by a single
+/// thread at a time.
+template <class TValue>
+class ReadAhead final {
+ public:
+  /// Returns the next value of the sequence, or std::nullopt at its end.
+  using Producer = std::function<std::optional<TValue>()>;
+
+  ReadAhead(Producer producer, uint64_t capacity, ThreadPool *pool)
+      : state_(std::make_shared<State>(std::move(producer), capacity)), pool_(pool) {}
+
+  ReadAhead(const ReadAhead &) = delete;
+  ReadAhead &operator=(const ReadAhead &) = delete;
+  ReadAhead(ReadAhead &&) = delete;
+  ReadAhead &operator=(ReadAhead &&) = delete;
+
+  ~ReadAhead() { Stop(); }
+
+  /// Returns the next value, or std::nullopt at the end of the sequence. If the
+  /// producer threw an exception, it is rethrown after all of the values
+  /// produced before it were returned.
+  std::optional<TValue> Pop() {
+    std::unique_lock lock(state_->mutex);
+    WaitForValue(&lock);
+    if (state_->buffer.empty()) {
+      RethrowError();
+      return std::nullopt;
+    }
+    auto value = std::move(state_->buffer.front());
+    state_->buffer.pop_front();
+    ScheduleProduction();
+    return value;
+  }
+
+  /// Returns true if the sequence has more values, waiting for the next one to
+  /// be produced if needed.
+  bool HasMore() {
+    std::unique_lock lock(state_->mutex);
+    WaitForValue(&lock);
+    if (state_->buffer.empty()) RethrowError();
+    return !state_->buffer.empty();
+  }
+
+  /// Stops producing the values and waits for the value which is currently
+  /// being produced. The producer isn't called after this returns.
+  void Stop() {
+    std::unique_lock lock(state_->mutex);
+    state_->stopped = true;
+    state_->buffer.clear();
+    state_->cv.wait(lock, [this] { return !state_->running; });
+  }
+
+ private:
+  // The state is shared with the scheduled tasks, which may start after the
+  // ReadAhead is already destroyed.
+  struct State {
+    State(Producer producer, uint64_t capacity) : producer(std::move(producer)), capacity(capacity) {}
+
+    // Produces a single value. The mutex has to be locked and `running` set
+    // by the caller. The mutex is unlocked while the producer is running.
+    void ProduceValue(std::unique_lock<std::mutex> *lock) {
+      lock->unlock();
+      std::optional<TValue> value;
+      std::exception_ptr exception;
+      try {
+        value = producer();
+      } catch (...) {
+        exception = std::current_exception();
+      }
+      lock->lock();
+      if (exception) {
+        error = std::move(exception);
+        finished = true;
+      } else if (!value) {
+        finished = true;
+      } else if (!stopped) {
+        buffer.push_back(std::move(*value));
+      }
+    }
+
+    bool CanProduce() const { return !stopped && !finished && buffer.size() < capacity; }
+
+    Producer producer;
+    uint64_t capacity;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<TValue> buffer;
+    std::exception_ptr error;
+    // Set while the producer is being called, either by a task or by the
+    // consumer.
+    bool running{false};
+    // Set while a task is waiting in the pool.
+    bool scheduled{false};
+    bool finished{false};
+    bool stopped{false};
+  };
+
+  static void RunTask(const std::shared_ptr<State> &state) {
+    std::unique_lock lock(state->mutex);
+    state->scheduled = false;
+    // The consumer may have started producing while the task was waiting, in
+    // which case it schedules another task when it's done.
+    if (state->running) return;
+    state->running = true;
+    while (state->CanProduce()) {
+      state->ProduceValue(&lock);
+      state->cv.notify_all();
+    }
+    state->running = false;
+    state->cv.notify_all();
+  }
+
+  // Waits until there is a value in the buffer or the sequence is finished,
+  // producing the value if nothing is producing it in the background.
+  void WaitForValue(std::unique_lock<std::mutex> *lock) {
+    ScheduleProduction();
+    while (state_->buffer.empty() && !state_->finished && !state_->stopped) {
+      if (state_->running) {
+        state_->cv.wait(*lock);
+        continue;
+      }
+      state_->running = true;
+      state_->ProduceValue(lock);
+      state_->running = false;
+      state_->cv.notify_all();
+    }
+  }
+
+  void ScheduleProduction() {
+    if (state_->running || state_->scheduled || !state_->CanProduce()) return;
+    state_->scheduled = true;
+    pool_->AddTask([state = state_] { RunTask(state); });
+  }
+
+  void RethrowError() {
+    if (state_->error) std::rethrow_exception(std::exchange(state_->error, nullptr));
+  }
+
+  std::shared_ptr<State> state_;
+  ThreadPool *pool_;
+};
+
+}  // namespace utils
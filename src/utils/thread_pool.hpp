@@ -42,6 +42,8 @@ class ThreadPool {
 
   size_t UnfinishedTasksNum() const;
 
+  size_t Size() const { return thread_pool_.size(); }
+
  private:
   std::unique_ptr<TaskSignature> PopTask();
 
@@ -0,0 +1,134 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "query/db_accessor.hpp"
+#include "query/interpret/compact_rows.hpp"
+#include "query/interpret/frame.hpp"
+#include "storage/v2/storage.hpp"
+
+// Caches the rows of a frame with a vertex, an edge, an integer, a short and a
+// long string, like Accumulate and Cartesian do, and restores all of them. The
+// argument is the number of rows, which repeat the same 64 vertices and edges.
+// The counters show the allocations and the bytes allocated per row.
+
+namespace {
+
+constexpr int64_t kDistinctObjects = 64;
+
+class CountingMemoryResource final : public utils::MemoryResource {
+ public:
+  size_t allocations{0};
+  size_t allocated_bytes{0};
+
+ private:
+  void *DoAllocate(size_t bytes, size_t alignment) override {
+    ++allocations;
+    allocated_bytes += bytes;
+    return utils::NewDeleteResource()->Allocate(bytes, alignment);
+  }
+
+  void DoDeallocate(void *p, size_t bytes, size_t alignment) override {
+    utils::NewDeleteResource()->Deallocate(p, bytes, alignment);
+  }
+
+  bool DoIsEqual(const utils::MemoryResource &other) const noexcept override { return this == &other; }
+};
+
+class RowsFixture {
+ public:
+  RowsFixture() {
+    for (int i = 0; i < 5; ++i) symbols_.push_back(symbol_table_.CreateSymbol("s" + std::to_string(i), true));
+    for (int64_t i = 0; i < kDistinctObjects; ++i) {
+      vertices_.push_back(dba_.InsertVertex());
+      edges_.push_back(*dba_.InsertEdge(&vertices_.back(), &vertices_.back(), dba_.NameToEdgeType("Type")));
+    }
+  }
+
+  // Fills the frame with the values of the given row.
+  void SetRow(int64_t row) {
+    frame_[symbols_[0]] = vertices_[row % kDistinctObjects];
+    frame_[symbols_[1]] = edges_[row % kDistinctObjects];
+    frame_[symbols_[2]] = row;
+    frame_[symbols_[3]] = "Person";
+    frame_[symbols_[4]] = "a property name longer than the inline strings";
+  }
+
+  const std::vector<query::Symbol> &symbols() const { return symbols_; }
+  query::Frame &frame() { return frame_; }
+
+ private:
+  storage::Storage db_;
+  storage::Storage::Accessor storage_dba_{db_.Access()};
+  query::DbAccessor dba_{&storage_dba_};
+  query::SymbolTable symbol_table_;
+  std::vector<query::Symbol> symbols_;
+  query::Frame frame_{5};
+  std::vector<query::VertexAccessor> vertices_;
+  std::vector<query::EdgeAccessor> edges_;
+};
+
+void SetCounters(benchmark::State &state, const CountingMemoryResource &memory) {
+  const auto rows = static_cast<double>(state.iterations() * state.range(0));
+  state.counters["allocations_per_row"] = static_cast<double>(memory.allocations) / rows;
+  state.counters["bytes_per_row"] = static_cast<double>(memory.allocated_bytes) / rows;
+  state.SetItemsProcessed(static_cast<int64_t>(rows));
+}
+
+}  // namespace
+
+// The rows as Accumulate and Cartesian kept them before, a vector of
+// TypedValues for each row.
+// NOLINTNEXTLINE(google-runtime-references)
+static void TypedValueRows(benchmark::State &state) {
+  RowsFixture fixture;
+  CountingMemoryResource memory;
+  for (auto _ : state) {
+    utils::pmr::vector<utils::pmr::vector<query::TypedValue>> rows(&memory);
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      fixture.SetRow(i);
+      utils::pmr::vector<query::TypedValue> row(&memory);
+      row.reserve(fixture.symbols().size());
+      for (const auto &symbol : fixture.symbols()) row.emplace_back(fixture.frame()[symbol]);
+      rows.emplace_back(std::move(row));
+    }
+    for (const auto &row : rows) {
+      auto row_it = row.begin();
+      for (const auto &symbol : fixture.symbols()) fixture.frame()[symbol] = *row_it++;
+    }
+  }
+  SetCounters(state, memory);
+}
+
+BENCHMARK(TypedValueRows)->Range(1024, 1U << 16U)->Unit(benchmark::kMicrosecond);
+
+// NOLINTNEXTLINE(google-runtime-references)
+static void CompactValueRows(benchmark::State &state) {
+  RowsFixture fixture;
+  CountingMemoryResource memory;
+  for (auto _ : state) {
+    query::CompactRows rows(&memory);
+    for (int64_t i = 0; i < state.range(0); ++i) {
+      fixture.SetRow(i);
+      rows.Append(fixture.frame(), fixture.symbols());
+    }
+    for (size_t i = 0; i < rows.size(); ++i) rows.Load(i, fixture.symbols(), &fixture.frame());
+  }
+  SetCounters(state, memory);
+}
+
+BENCHMARK(CompactValueRows)->Range(1024, 1U << 16U)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -9,6 +9,9 @@
 // by the Apache License, Version 2.0, included in the file
 // licenses/APL.txt.
 
+#include <string>
+#include <vector>
+
 #include <benchmark/benchmark.h>
 
 #include "query/db_accessor.hpp"
@@ -85,4 +88,52 @@ BENCHMARK_TEMPLATE(AdditionOperator, NewDeleteResource)->Range(1024, 1U << 15U)-
 
 BENCHMARK_TEMPLATE(AdditionOperator, MonotonicBufferResource)->Range(1024, 1U << 15U)->Unit(benchmark::kMicrosecond);
 
+// Evaluates `'...' + 'a' + ...` and `[...] + [0] + ...`. The allocated bytes
+// include the intermediate results, so they show how much each concatenation
+// copies.
+template <class TMemory, bool kList>
+// NOLINTNEXTLINE(google-runtime-references)
+static void ConcatenationOperator(benchmark::State &state) {
+  query::AstStorage ast;
+  query::SymbolTable symbol_table;
+  TMemory memory;
+  utils::TrackingMemoryResource tracking_memory(memory.get());
+  query::Frame frame(symbol_table.max_position(), &tracking_memory);
+  storage::Storage db;
+  auto storage_dba = db.Access();
+  query::DbAccessor dba(&storage_dba);
+  auto create_operand = [&]() -> query::Expression * {
+    if (kList) {
+      return ast.Create<query::ListLiteral>(std::vector<query::Expression *>{ast.Create<query::PrimitiveLiteral>(0)});
+    }
+    return ast.Create<query::PrimitiveLiteral>(std::string("a string long enough to be allocated"));
+  };
+  query::Expression *expr = create_operand();
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    expr = ast.Create<query::AdditionOperator>(expr, create_operand());
+  }
+  query::EvaluationContext evaluation_context{&tracking_memory};
+  query::ExpressionEvaluator evaluator(&frame, symbol_table, evaluation_context, &dba, storage::View::NEW);
+  while (state.KeepRunning()) {
+    benchmark::DoNotOptimize(expr->Accept(evaluator));
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.counters["allocated_bytes"] = benchmark::Counter(static_cast<double>(tracking_memory.GetTotalAllocatedBytes()),
+                                                         benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK_TEMPLATE(ConcatenationOperator, NewDeleteResource, false)->Range(64, 1U << 10U)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(ConcatenationOperator, MonotonicBufferResource, false)
+    ->Range(64, 1U << 10U)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(ConcatenationOperator, NewDeleteResource, true)
+    ->Range(64, 1U << 10U)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_TEMPLATE(ConcatenationOperator, MonotonicBufferResource, true)
+    ->Range(64, 1U << 10U)
+    ->Unit(benchmark::kMicrosecond);
+
 BENCHMARK_MAIN();
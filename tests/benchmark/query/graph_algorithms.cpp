@@ -0,0 +1,191 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "graph_algorithms/algorithms.hpp"
+
+// Runs the algorithms of the graph_algorithms query module on synthetic
+// power-law graphs, which are generated with the R-MAT model. The first
+// argument is the scale, the graph has 2^scale vertices and 16 times as many
+// edges. The second argument is the number of the threads.
+
+namespace {
+
+constexpr size_t kEdgeFactor = 16;
+constexpr size_t kTasksPerThread = 4;
+
+class RmatGraph {
+ public:
+  explicit RmatGraph(int scale) {
+    const size_t vertex_count = size_t{1} << scale;
+    const size_t edge_count = vertex_count * kEdgeFactor;
+    std::mt19937_64 generator(scale);
+    std::uniform_real_distribution<double> distribution(0, 1);
+    std::vector<std::pair<uint64_t, uint64_t>> edges(edge_count);
+    for (auto &[from, to] : edges) {
+      from = 0;
+      to = 0;
+      // Each bit of the endpoints picks one of the quadrants of the adjacency
+      // matrix, with the probabilities 0.57, 0.19, 0.19 and 0.05.
+      for (int bit = 0; bit < scale; ++bit) {
+        const auto quadrant = distribution(generator);
+        from = (from << 1) | (quadrant >= 0.76 ? 1 : 0);
+        to = (to << 1) | ((quadrant >= 0.57 && quadrant < 0.76) || quadrant >= 0.95 ? 1 : 0);
+      }
+    }
+    // The ordinals are shuffled, so the high degree vertices aren't next to
+    // each other.
+    std::vector<uint64_t> permutation(vertex_count);
+    std::iota(permutation.begin(), permutation.end(), 0);
+    std::shuffle(permutation.begin(), permutation.end(), generator);
+
+    out_offsets_.assign(vertex_count + 1, 0);
+    in_offsets_.assign(vertex_count + 1, 0);
+    for (auto &[from, to] : edges) {
+      from = permutation[from];
+      to = permutation[to];
+      ++out_offsets_[from + 1];
+      ++in_offsets_[to + 1];
+    }
+    std::partial_sum(out_offsets_.begin(), out_offsets_.end(), out_offsets_.begin());
+    std::partial_sum(in_offsets_.begin(), in_offsets_.end(), in_offsets_.begin());
+    out_targets_.resize(edge_count);
+    in_sources_.resize(edge_count);
+    auto out_next = out_offsets_;
+    auto in_next = in_offsets_;
+    for (const auto &[from, to] : edges) {
+      out_targets_[out_next[from]++] = to;
+      in_sources_[in_next[to]++] = from;
+    }
+    graph_.vertex_count = vertex_count;
+    graph_.out_offsets = out_offsets_.data();
+    graph_.out_targets = out_targets_.data();
+    graph_.in_offsets = in_offsets_.data();
+    graph_.in_sources = in_sources_.data();
+  }
+
+  const graph_algorithms::CsrGraph &operator*() const { return graph_; }
+
+ private:
+  std::vector<uint64_t> out_offsets_;
+  std::vector<uint64_t> out_targets_;
+  std::vector<uint64_t> in_offsets_;
+  std::vector<uint64_t> in_sources_;
+  graph_algorithms::CsrGraph graph_;
+};
+
+// The graphs are generated once for each scale.
+const graph_algorithms::CsrGraph &Graph(int scale) {
+  static std::map<int, std::unique_ptr<RmatGraph>> graphs;
+  auto &graph = graphs[scale];
+  if (!graph) graph = std::make_unique<RmatGraph>(scale);
+  return **graph;
+}
+
+graph_algorithms::ParallelFor ThreadedFor(size_t threads) {
+  return [threads](size_t task_count, const std::function<void(size_t)> &task) {
+    std::atomic<size_t> next{0};
+    const auto run = [&] {
+      for (auto current = next++; current < task_count; current = next++) task(current);
+    };
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < threads; ++i) workers.emplace_back(run);
+    run();
+    for (auto &worker : workers) worker.join();
+  };
+}
+
+template <class TRun>
+void RunAlgorithm(benchmark::State &state, const TRun &run) {
+  const auto &graph = Graph(static_cast<int>(state.range(0)));
+  const auto threads = static_cast<size_t>(state.range(1));
+  const auto parallel_for = ThreadedFor(threads);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(run(graph, parallel_for, threads * kTasksPerThread));
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * graph.EdgeCount()));
+}
+
+void Arguments(benchmark::internal::Benchmark *benchmark) {
+  const auto max_threads = static_cast<int64_t>(std::max(1U, std::thread::hardware_concurrency()));
+  for (const int64_t scale : {14, 17}) {
+    benchmark->Args({scale, 1});
+    if (max_threads > 1) benchmark->Args({scale, max_threads});
+  }
+  benchmark->Unit(benchmark::kMillisecond)->UseRealTime();
+}
+
+}  // namespace
+
+void BM_PageRank(benchmark::State &state) {
+  graph_algorithms::PageRankConfig config;
+  config.max_iterations = 20;
+  config.tolerance = 0;
+  RunAlgorithm(state, [&](const auto &graph, const auto &parallel_for, size_t tasks) {
+    return graph_algorithms::PageRank(graph, config, parallel_for, tasks);
+  });
+}
+BENCHMARK(BM_PageRank)->Apply(Arguments);
+
+void BM_WeaklyConnectedComponents(benchmark::State &state) {
+  RunAlgorithm(state, [](const auto &graph, const auto &parallel_for, size_t tasks) {
+    return graph_algorithms::WeaklyConnectedComponents(graph, parallel_for, tasks);
+  });
+}
+BENCHMARK(BM_WeaklyConnectedComponents)->Apply(Arguments);
+
+void BM_StronglyConnectedComponents(benchmark::State &state) {
+  RunAlgorithm(state, [](const auto &graph, const auto &, size_t) {
+    return graph_algorithms::StronglyConnectedComponents(graph);
+  });
+}
+BENCHMARK(BM_StronglyConnectedComponents)->Apply(Arguments);
+
+void BM_LabelPropagation(benchmark::State &state) {
+  RunAlgorithm(state, [](const auto &graph, const auto &parallel_for, size_t tasks) {
+    return graph_algorithms::LabelPropagation(graph, {}, parallel_for, tasks);
+  });
+}
+BENCHMARK(BM_LabelPropagation)->Apply(Arguments);
+
+void BM_BetweennessCentrality(benchmark::State &state) {
+  graph_algorithms::BetweennessConfig config;
+  config.samples = 64;
+  RunAlgorithm(state, [&](const auto &graph, const auto &parallel_for, size_t tasks) {
+    return graph_algorithms::BetweennessCentrality(graph, config, parallel_for, tasks);
+  });
+}
+BENCHMARK(BM_BetweennessCentrality)->Apply(Arguments);
+
+void BM_TriangleCount(benchmark::State &state) {
+  RunAlgorithm(state, [](const auto &graph, const auto &parallel_for, size_t tasks) {
+    return graph_algorithms::TriangleCount(graph, parallel_for, tasks);
+  });
+}
+BENCHMARK(BM_TriangleCount)->Apply(Arguments);
+
+int main(int argc, char **argv) {
+  ::benchmark::Initialize(&argc, argv);
+  ::benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
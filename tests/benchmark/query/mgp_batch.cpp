@@ -0,0 +1,195 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <array>
+#include <optional>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "mg_procedure.h"
+#include "query/db_accessor.hpp"
+#include "query/procedure/mg_procedure_impl.hpp"
+#include "storage/v2/storage.hpp"
+#include "utils/logging.hpp"
+#include "utils/memory.hpp"
+
+// Compares reading the vertices, a property and the edges through the query
+// module API one by one with reading them in batches.
+
+constexpr size_t kBatchSize = 1024;
+constexpr size_t kEdgesPerVertex = 16;
+
+class MgpBatchBenchFixture : public benchmark::Fixture {
+ protected:
+  std::optional<storage::Storage> db;
+  std::optional<storage::Storage::Accessor> storage_accessor;
+  std::optional<query::DbAccessor> db_accessor;
+  std::optional<mgp_graph> graph;
+  mgp_memory memory{utils::NewDeleteResource()};
+
+  void SetUp(const benchmark::State &state) override {
+    db.emplace();
+    {
+      auto dba = db->Access();
+      const auto property = dba.NameToProperty("value");
+      const auto edge_type = dba.NameToEdgeType("edge_type");
+      std::vector<storage::VertexAccessor> vertices;
+      for (int64_t i = 0; i < state.range(0); ++i) {
+        vertices.push_back(dba.CreateVertex());
+        MG_ASSERT(vertices.back().SetProperty(property, storage::PropertyValue(i)).HasValue());
+      }
+      for (size_t i = 0; i < vertices.size(); ++i) {
+        for (size_t j = 1; j <= kEdgesPerVertex; ++j) {
+          MG_ASSERT(dba.CreateEdge(&vertices[i], &vertices[(i + j) % vertices.size()], edge_type).HasValue());
+        }
+      }
+      MG_ASSERT(!dba.Commit().HasError());
+    }
+    storage_accessor.emplace(db->Access());
+    db_accessor.emplace(&*storage_accessor);
+    graph.emplace(mgp_graph{&*db_accessor, storage::View::OLD, nullptr});
+  }
+
+  void TearDown(const benchmark::State &) override {
+    graph = std::nullopt;
+    db_accessor = std::nullopt;
+    storage_accessor = std::nullopt;
+    db = std::nullopt;
+  }
+};
+
+BENCHMARK_DEFINE_F(MgpBatchBenchFixture, PropertyPerItem)(benchmark::State &state) {
+  while (state.KeepRunning()) {
+    int64_t sum = 0;
+    mgp_vertices_iterator *vertices{nullptr};
+    MG_ASSERT(mgp_graph_iter_vertices(&*graph, &memory, &vertices) == MGP_ERROR_NO_ERROR);
+    mgp_vertex *vertex{nullptr};
+    MG_ASSERT(mgp_vertices_iterator_get(vertices, &vertex) == MGP_ERROR_NO_ERROR);
+    while (vertex) {
+      mgp_value *value{nullptr};
+      MG_ASSERT(mgp_vertex_get_property(vertex, "value", &memory, &value) == MGP_ERROR_NO_ERROR);
+      int64_t int_value{0};
+      MG_ASSERT(mgp_value_get_int(value, &int_value) == MGP_ERROR_NO_ERROR);
+      sum += int_value;
+      mgp_value_destroy(value);
+      MG_ASSERT(mgp_vertices_iterator_next(vertices, &vertex) == MGP_ERROR_NO_ERROR);
+    }
+    mgp_vertices_iterator_destroy(vertices);
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_REGISTER_F(MgpBatchBenchFixture, PropertyPerItem)
+    ->RangeMultiplier(16)
+    ->Range(1 << 10, 1 << 16)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(MgpBatchBenchFixture, PropertyBatched)(benchmark::State &state) {
+  std::array<mgp_vertex_id, kBatchSize> ids{};
+  std::array<mgp_value_type, kBatchSize> types{};
+  std::array<int64_t, kBatchSize> ints{};
+  mgp_property_column column{.types = types.data(), .ints = ints.data(), .doubles = nullptr};
+  while (state.KeepRunning()) {
+    int64_t sum = 0;
+    mgp_vertices_iterator *vertices{nullptr};
+    MG_ASSERT(mgp_graph_iter_vertices(&*graph, &memory, &vertices) == MGP_ERROR_NO_ERROR);
+    size_t batch_size = 0;
+    do {
+      MG_ASSERT(mgp_vertices_iterator_next_batch(vertices, ids.data(), kBatchSize, &batch_size) ==
+                MGP_ERROR_NO_ERROR);
+      MG_ASSERT(mgp_vertices_iterator_batch_property(vertices, "value", &column) == MGP_ERROR_NO_ERROR);
+      for (size_t i = 0; i < batch_size; ++i) {
+        sum += ints[i];
+      }
+    } while (batch_size > 0);
+    mgp_vertices_iterator_destroy(vertices);
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_REGISTER_F(MgpBatchBenchFixture, PropertyBatched)
+    ->RangeMultiplier(16)
+    ->Range(1 << 10, 1 << 16)
+    ->Unit(benchmark::kMillisecond);
+
+// Calls `read_edges` with the outbound edges of every vertex.
+template <class TReadEdges>
+void ReadEdges(mgp_graph *graph, mgp_memory *memory, const TReadEdges &read_edges) {
+  mgp_vertices_iterator *vertices{nullptr};
+  MG_ASSERT(mgp_graph_iter_vertices(graph, memory, &vertices) == MGP_ERROR_NO_ERROR);
+  mgp_vertex *vertex{nullptr};
+  MG_ASSERT(mgp_vertices_iterator_get(vertices, &vertex) == MGP_ERROR_NO_ERROR);
+  while (vertex) {
+    mgp_edges_iterator *edges{nullptr};
+    MG_ASSERT(mgp_vertex_iter_out_edges(vertex, memory, &edges) == MGP_ERROR_NO_ERROR);
+    read_edges(edges);
+    mgp_edges_iterator_destroy(edges);
+    MG_ASSERT(mgp_vertices_iterator_next(vertices, &vertex) == MGP_ERROR_NO_ERROR);
+  }
+  mgp_vertices_iterator_destroy(vertices);
+}
+
+BENCHMARK_DEFINE_F(MgpBatchBenchFixture, EdgesPerItem)(benchmark::State &state) {
+  while (state.KeepRunning()) {
+    ReadEdges(&*graph, &memory, [](mgp_edges_iterator *edges) {
+      mgp_edge *edge{nullptr};
+      MG_ASSERT(mgp_edges_iterator_get(edges, &edge) == MGP_ERROR_NO_ERROR);
+      while (edge) {
+        mgp_edge_id edge_id{};
+        MG_ASSERT(mgp_edge_get_id(edge, &edge_id) == MGP_ERROR_NO_ERROR);
+        mgp_vertex *to{nullptr};
+        MG_ASSERT(mgp_edge_get_to(edge, &to) == MGP_ERROR_NO_ERROR);
+        mgp_vertex_id to_id{};
+        MG_ASSERT(mgp_vertex_get_id(to, &to_id) == MGP_ERROR_NO_ERROR);
+        benchmark::DoNotOptimize(edge_id);
+        benchmark::DoNotOptimize(to_id);
+        MG_ASSERT(mgp_edges_iterator_next(edges, &edge) == MGP_ERROR_NO_ERROR);
+      }
+    });
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0) * kEdgesPerVertex);
+}
+
+BENCHMARK_REGISTER_F(MgpBatchBenchFixture, EdgesPerItem)
+    ->RangeMultiplier(16)
+    ->Range(1 << 10, 1 << 16)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(MgpBatchBenchFixture, EdgesBatched)(benchmark::State &state) {
+  std::array<mgp_edge_id, kBatchSize> edge_ids{};
+  std::array<mgp_vertex_id, kBatchSize> other_ids{};
+  while (state.KeepRunning()) {
+    ReadEdges(&*graph, &memory, [&](mgp_edges_iterator *edges) {
+      size_t batch_size = 0;
+      do {
+        MG_ASSERT(mgp_edges_iterator_next_batch(edges, edge_ids.data(), other_ids.data(), kBatchSize, &batch_size) ==
+                  MGP_ERROR_NO_ERROR);
+        benchmark::DoNotOptimize(edge_ids);
+        benchmark::DoNotOptimize(other_ids);
+      } while (batch_size > 0);
+    });
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0) * kEdgesPerVertex);
+}
+
+BENCHMARK_REGISTER_F(MgpBatchBenchFixture, EdgesBatched)
+    ->RangeMultiplier(16)
+    ->Range(1 << 10, 1 << 16)
+    ->Unit(benchmark::kMillisecond);
+
+int main(int argc, char **argv) {
+  ::benchmark::Initialize(&argc, argv);
+  ::benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
@@ -0,0 +1,90 @@
+// Copyright 2021 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <cstdint>
+#include <string>
+
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+
+#include "query/cypher_query_interpreter.hpp"
+
+const int kThreadsNum = 16;
+
+// clang-format off
+const char *kQueries[] = {
+"MATCH (a) RETURN size(collect(a)) AS size{0}",
+"MATCH (a:L{0})-[rel]->(b) RETURN a, count(*)",
+"MATCH (n:L{0}) RETURN n.division, count(*) ORDER BY count(*) DESC, n.division ASC",
+"UNWIND ['a', 'b', 'B', null, 'abc', 'abc1'] AS i RETURN max(i) AS max{0}",
+"MATCH (a)-[r]-(b) DELETE r, a, b RETURN count(*) AS c{0}",
+"MATCH (u:User{0}) WITH {{key: u}} AS nodes DELETE nodes.key",
+"MATCH p = ()-[r:T{0}]-() WHERE r.id = 42 DELETE r",
+"UNWIND range(0, 1000) AS i CREATE (:A{0} {{id: i}}) MERGE (:B {{id: i % 10}})",
+"MATCH (n) WHERE NOT(n.name = 'apa' AND false) RETURN n AS n{0}",
+"MATCH (n:A{0}) WHERE n.name = 'Andres' SET n.name = 'Michael' RETURN n",
+"MATCH (n) WITH n LIMIT toInteger(ceil(1.7)) RETURN count(*) AS count{0}",
+"MATCH (a:A{0}), (b:B) MERGE (a)-[r:TYPE]->(b) ON CREATE SET r.name = 'Lola' RETURN count(r)",
+};
+// clang-format on
+
+// The AST cache is shared between the threads, just like it is shared between
+// the Bolt workers.
+class ParseQueryFixture : public benchmark::Fixture {
+ protected:
+  void SetUp(const benchmark::State &state) override {
+    if (state.thread_index() == 0) {
+      cache.Clear();
+    }
+  }
+
+  query::InterpreterConfig::Query config;
+  query::QueryCache cache{config.ast_cache_max_memory_bytes};
+};
+
+// Each query has a label or an alias which is unique to the thread and the
+// iteration, so every query misses the cache and has to be parsed.
+BENCHMARK_DEFINE_F(ParseQueryFixture, Uncached)(benchmark::State &state) {
+  uint64_t counter = 0;
+  for (auto _ : state) {
+    for (const auto *query : kQueries) {
+      auto query_string = fmt::format(fmt::runtime(query), fmt::format("_{}_{}", state.thread_index(), counter++));
+      benchmark::DoNotOptimize(query::ParseQuery(query_string, {}, &cache, config));
+    }
+  }
+  state.SetItemsProcessed(counter);
+}
+
+BENCHMARK_REGISTER_F(ParseQueryFixture, Uncached)
+    ->ThreadRange(1, kThreadsNum)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+// All of the threads run the same queries, so only the first run of each one
+// is parsed and the rest are served from the cache.
+BENCHMARK_DEFINE_F(ParseQueryFixture, Cached)(benchmark::State &state) {
+  uint64_t counter = 0;
+  for (auto _ : state) {
+    for (const auto *query : kQueries) {
+      auto query_string = fmt::format(fmt::runtime(query), "");
+      benchmark::DoNotOptimize(query::ParseQuery(query_string, {}, &cache, config));
+      ++counter;
+    }
+  }
+  state.SetItemsProcessed(counter);
+}
+
+BENCHMARK_REGISTER_F(ParseQueryFixture, Cached)
+    ->ThreadRange(1, kThreadsNum)
+    ->Unit(benchmark::kMicrosecond)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -63,6 +63,16 @@ int main(int argc, char *argv[]) {
     benchmark::RegisterBenchmark(test, BM_Strip, preprocess, test)->Range(1, 1)->Complexity(benchmark::oN);
   }
 
+  // Repeated queries are served from the cache after they are stripped once.
+  query::frontend::StrippedQueryCache cache(16 * 1024 * 1024);
+  auto preprocess_cached = [&cache](const std::string &query) { return query::frontend::StripQuery(query, &cache); };
+
+  for (auto test : kQueries) {
+    benchmark::RegisterBenchmark((std::string("Cached/") + test).c_str(), BM_Strip, preprocess_cached, test)
+        ->Range(1, 1)
+        ->Complexity(benchmark::oN);
+  }
+
   benchmark::Initialize(&argc, argv);
   benchmark::RunSpecifiedBenchmarks();
 
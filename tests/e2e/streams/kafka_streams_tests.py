@@ -451,5 +451,82 @@ def test_info_procedure(kafka_topics, connection):
     common.validate_info(stream_info, expected_stream_info)
 
 
+@pytest.mark.parametrize("transformation", TRANSFORMATIONS_TO_CHECK)
+def test_parallelism(kafka_producer, kafka_topics, connection, transformation):
+    assert len(kafka_topics) > 1
+    cursor = connection.cursor()
+    common.execute_and_fetch_all(
+        cursor,
+        "CREATE KAFKA STREAM test "
+        f"TOPICS {','.join(kafka_topics)} "
+        f"TRANSFORM {transformation} "
+        "PARALLELISM 2",
+    )
+    common.start_stream(cursor, "test")
+    time.sleep(5)
+
+    for topic in kafka_topics:
+        kafka_producer.send(topic, common.SIMPLE_MSG).get(timeout=60)
+
+    for topic in kafka_topics:
+        common.kafka_check_vertex_exists_with_topic_and_payload(
+            cursor, topic, common.SIMPLE_MSG)
+
+
+def test_parallelism_above_hardware_threads(kafka_topics, connection):
+    cursor = connection.cursor()
+    with pytest.raises(mgclient.DatabaseError):
+        common.execute_and_fetch_all(
+            cursor,
+            "CREATE KAFKA STREAM test "
+            f"TOPICS {','.join(kafka_topics)} "
+            "TRANSFORM kafka_transform.simple "
+            "PARALLELISM 1000000",
+        )
+
+
+def test_parallelism_commits_processed_partitions(
+        kafka_producer, kafka_topics, connection):
+    # When one of the partition groups of a batch fails, the offsets of the
+    # partitions of the committed groups are committed, so only the messages
+    # of the failed group are consumed again when the stream is recreated.
+    assert len(kafka_topics) > 1
+    cursor = connection.cursor()
+
+    def create_stream(transformation):
+        common.execute_and_fetch_all(
+            cursor,
+            "CREATE KAFKA STREAM test "
+            f"TOPICS {kafka_topics[0]},{kafka_topics[1]} "
+            f"TRANSFORM {transformation} "
+            "PARALLELISM 2",
+        )
+
+    create_stream("kafka_transform.query")
+    common.start_stream(cursor, "test")
+    time.sleep(5)
+
+    valid_query = b"CREATE (n:VERTEX { id : 42 })"
+    invalid_query = b"this is not a valid query"
+    kafka_producer.send(kafka_topics[0], valid_query).get(timeout=60)
+    kafka_producer.send(kafka_topics[1], invalid_query).get(timeout=60)
+    assert common.timed_wait(
+        lambda: not common.get_is_running(cursor, "test"))
+    assert common.check_one_result_row(
+        cursor, "MATCH (n:VERTEX { id : 42 }) RETURN n")
+
+    common.drop_stream(cursor, "test")
+    create_stream("kafka_transform.simple")
+    common.start_stream(cursor, "test")
+
+    common.kafka_check_vertex_exists_with_topic_and_payload(
+        cursor, kafka_topics[1], invalid_query)
+    vertices_with_valid_query = common.execute_and_fetch_all(
+        cursor,
+        "MATCH (n: MESSAGE {" f"payload: '{valid_query.decode('utf-8')}'" "}) RETURN n",
+    )
+    assert len(vertices_with_valid_query) == 0
+
+
 if __name__ == "__main__":
     sys.exit(pytest.main([__file__, "-rA"]))
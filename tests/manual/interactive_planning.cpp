@@ -199,6 +199,9 @@ class InteractiveDbAccessor {
     return ReadVertexCount("label '" + label + "' and property '" + property + "' in range " + range_string.str());
   }
 
+  // Statistics aren't read interactively, so the constant estimates are used.
+  std::shared_ptr<const storage::GraphStatistics> GetGraphStatistics() { return nullptr; }
+
   bool LabelIndexExists(storage::LabelId label) { return true; }
 
   bool LabelPropertyIndexExists(storage::LabelId label_id, storage::PropertyId property_id) {
@@ -102,6 +102,12 @@ parser.add_argument("--num-workers-for-import", type=int,
 parser.add_argument("--num-workers-for-benchmark", type=int,
                     default=1,
                     help="number of workers used to execute the benchmark")
+parser.add_argument("--queries-per-connection", type=int,
+                    default=0,
+                    help="number of queries each benchmark worker executes "
+                    "before it reconnects, used to benchmark a storm of "
+                    "short-lived connections (0 means a single connection "
+                    "per worker)")
 parser.add_argument("--single-threaded-runtime-sec", type=int,
                     default=10,
                     help="single threaded duration of each test")
@@ -116,6 +122,10 @@ parser.add_argument("--temporary-directory", default="/tmp",
                     "be stored")
 parser.add_argument("--no-properties-on-edges", action="store_true",
                     help="disable properties on edges")
+parser.add_argument("--bolt-io-backend", default="epoll",
+                    choices=["epoll", "io_uring"],
+                    help="mechanism which Memgraph uses to wait for the data "
+                    "on the Bolt connections")
 args = parser.parse_args()
 
 # Detect available datasets.
@@ -172,7 +182,8 @@ for dataset, tests in benchmarks:
 
     # Prepare runners and import the dataset.
     memgraph = runners.Memgraph(args.memgraph_binary, args.temporary_directory,
-                                not args.no_properties_on_edges)
+                                not args.no_properties_on_edges,
+                                args.bolt_io_backend)
     client = runners.Client(args.client_binary, args.temporary_directory)
     memgraph.start_preparation()
     ret = client.execute(file_path=dataset.get_file(),
@@ -254,8 +265,10 @@ for dataset, tests in benchmarks:
             print("Queries are executed using", args.num_workers_for_benchmark,
                   "concurrent clients.")
             memgraph.start_benchmark()
-            ret = client.execute(queries=get_queries(func, count),
-                                 num_workers=args.num_workers_for_benchmark)[0]
+            ret = client.execute(
+                queries=get_queries(func, count),
+                num_workers=args.num_workers_for_benchmark,
+                queries_per_connection=args.queries_per_connection)[0]
             usage = memgraph.stop()
             ret["database"] = usage
 
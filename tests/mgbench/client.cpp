@@ -39,6 +39,10 @@ DEFINE_bool(use_ssl, false, "Set to true to connect with SSL to the server.");
 DEFINE_uint64(num_workers, 1,
               "Number of workers that should be used to concurrently execute "
               "the supplied queries.");
+DEFINE_uint64(queries_per_connection, 0,
+              "Number of queries that each worker executes before it reconnects to "
+              "the server. Use it to benchmark a server under a storm of short-lived "
+              "connections. By default, each worker uses a single connection.");
 DEFINE_uint64(max_retries, 50, "Maximum number of retries for each query.");
 DEFINE_bool(queries_json, false,
             "Set to true to load all queries as as single JSON encoded list. Each item "
@@ -166,6 +170,7 @@ void Execute(const std::vector<std::pair<std::string, std::map<std::string, comm
   std::vector<uint64_t> worker_retries(FLAGS_num_workers, 0);
   std::vector<Metadata> worker_metadata(FLAGS_num_workers, Metadata());
   std::vector<double> worker_duration(FLAGS_num_workers, 0.0);
+  std::vector<uint64_t> worker_connections(FLAGS_num_workers, 1);
 
   // Start workers and execute queries.
   auto size = queries.size();
@@ -186,10 +191,19 @@ void Execute(const std::vector<std::pair<std::string, std::map<std::string, comm
       auto &retries = worker_retries[worker];
       auto &metadata = worker_metadata[worker];
       auto &duration = worker_duration[worker];
+      auto &connections = worker_connections[worker];
+      uint64_t connection_queries = 0;
       utils::Timer timer;
       while (true) {
         auto pos = position.fetch_add(1, std::memory_order_acq_rel);
         if (pos >= size) break;
+        if (FLAGS_queries_per_connection > 0 && connection_queries == FLAGS_queries_per_connection) {
+          client.Close();
+          client.Connect(endpoint, FLAGS_username, FLAGS_password);
+          ++connections;
+          connection_queries = 0;
+        }
+        ++connection_queries;
         const auto &query = queries[pos];
         auto ret = ExecuteNTimesTillSuccess(&client, query.first, query.second, FLAGS_max_retries);
         retries += ret.second;
@@ -211,10 +225,12 @@ void Execute(const std::vector<std::pair<std::string, std::map<std::string, comm
   // Create and output summary.
   Metadata final_metadata;
   uint64_t final_retries = 0;
+  uint64_t final_connections = 0;
   double final_duration = 0.0;
   for (int i = 0; i < FLAGS_num_workers; ++i) {
     final_metadata += worker_metadata[i];
     final_retries += worker_retries[i];
+    final_connections += worker_connections[i];
     final_duration += worker_duration[i];
   }
   final_duration /= FLAGS_num_workers;
@@ -223,6 +239,7 @@ void Execute(const std::vector<std::pair<std::string, std::map<std::string, comm
   summary["duration"] = final_duration;
   summary["throughput"] = static_cast<double>(queries.size()) / final_duration;
   summary["retries"] = final_retries;
+  summary["connections"] = final_connections;
   summary["metadata"] = final_metadata.Export();
   summary["num_workers"] = FLAGS_num_workers;
   (*stream) << summary.dump() << std::endl;
@@ -52,10 +52,12 @@ def _get_usage(pid):
 
 
 class Memgraph:
-    def __init__(self, memgraph_binary, temporary_dir, properties_on_edges):
+    def __init__(self, memgraph_binary, temporary_dir, properties_on_edges,
+                 bolt_io_backend="epoll"):
         self._memgraph_binary = memgraph_binary
         self._directory = tempfile.TemporaryDirectory(dir=temporary_dir)
         self._properties_on_edges = properties_on_edges
+        self._bolt_io_backend = bolt_io_backend
         self._proc_mg = None
         atexit.register(self._cleanup)
 
@@ -81,6 +83,10 @@ class Memgraph:
         else:
             assert self._properties_on_edges, \
                 "Older versions of Memgraph can't disable properties on edges!"
+        # The flag is passed only when needed, so that the older versions of
+        # Memgraph, which don't have it, still work with the default backend.
+        if self._bolt_io_backend != "epoll":
+            kwargs["bolt_io_backend"] = self._bolt_io_backend
         return _convert_args_to_flags(self._memgraph_binary, **kwargs)
 
     def _start(self, **kwargs):
@@ -134,7 +140,8 @@ class Client:
     def _get_args(self, **kwargs):
         return _convert_args_to_flags(self._client_binary, **kwargs)
 
-    def execute(self, queries=None, file_path=None, num_workers=1):
+    def execute(self, queries=None, file_path=None, num_workers=1,
+                queries_per_connection=0):
         if (queries is None and file_path is None) or \
                 (queries is not None and file_path is not None):
             raise ValueError("Either queries or input_path must be specified!")
@@ -152,7 +159,8 @@ class Client:
                     f.write("\n")
 
         args = self._get_args(input=file_path, num_workers=num_workers,
-                              queries_json=queries_json)
+                              queries_json=queries_json,
+                              queries_per_connection=queries_per_connection)
         ret = subprocess.run(args, stdout=subprocess.PIPE, check=True)
         data = ret.stdout.decode("utf-8").strip().split("\n")
         return list(map(json.loads, data))
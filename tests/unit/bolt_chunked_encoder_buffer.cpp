@@ -109,3 +109,161 @@ TEST_F(BoltChunkedEncoderBuffer, OneAndAHalfOfMaxChunk) {
   VerifyChunkOfTestData(output, kChunkMaxDataSize);
   VerifyChunkOfTestData(output + kChunkWholeSize, kTestDataSize - kChunkMaxDataSize, kChunkMaxDataSize);
 }
+
+// Counts the writes and optionally supports the vectored writes.
+class CountingOutputStream : public TestOutputStream {
+ public:
+  bool Write(const uint8_t *data, size_t len, bool have_more = false) {
+    ++writes;
+    return TestOutputStream::Write(data, len, have_more);
+  }
+
+  bool CanWriteVectored() const { return vectored; }
+
+  bool WriteVectored(const iovec *iov, size_t iovcnt, bool have_more = false) {
+    ++writes;
+    for (size_t i = 0; i < iovcnt; ++i) {
+      bases.push_back(iov[i].iov_base);
+      TestOutputStream::Write(static_cast<const uint8_t *>(iov[i].iov_base), iov[i].iov_len, have_more);
+    }
+    return write_success_;
+  }
+
+  bool vectored{false};
+  int writes{0};
+  std::vector<const void *> bases;
+};
+
+using CountingBufferT = communication::bolt::ChunkedEncoderBuffer<CountingOutputStream>;
+
+TEST_F(BoltChunkedEncoderBuffer, BuffersChunksWhileMoreDataFollows) {
+  int size = 100;
+
+  // initialize tested buffer
+  CountingOutputStream output_stream;
+  CountingBufferT buffer(output_stream);
+
+  // write ten chunks, each followed by an end marker, and only send them out
+  // with the last flush
+  for (int i = 0; i < 10; ++i) {
+    buffer.Write(test_data + i * size, size);
+    buffer.Flush(true);
+    if (i < 9) buffer.Flush(true);
+  }
+  ASSERT_EQ(output_stream.writes, 0);
+  buffer.Flush();
+  ASSERT_EQ(output_stream.writes, 1);
+
+  // check the output array
+  auto data = output_stream.output.data();
+  for (int i = 0; i < 10; ++i) {
+    VerifyChunkOfTestData(data, size, i * size);
+    data += kChunkHeaderSize + size;
+    if (i < 9) {
+      VerifyChunkOfTestData(data, 0);
+      data += kChunkHeaderSize;
+    }
+  }
+  VerifyChunkOfTestData(data, 0);
+  ASSERT_EQ(data + kChunkHeaderSize, output_stream.output.data() + output_stream.output.size());
+}
+
+TEST_F(BoltChunkedEncoderBuffer, SendsChunksWhenFull) {
+  // initialize tested buffer
+  CountingOutputStream output_stream;
+  CountingBufferT buffer(output_stream);
+
+  // the buffered chunks are sent out once they take more than the maximum
+  // buffered size
+  auto chunks = CountingBufferT::kMaxBufferedSize / kChunkWholeSize;
+  for (size_t i = 0; i <= chunks; ++i) {
+    buffer.Write(test_data, kChunkMaxDataSize - 1);
+    buffer.Flush(true);
+  }
+  ASSERT_EQ(output_stream.writes, 1);
+  VerifyChunkOfTestData(output_stream.output.data(), kChunkMaxDataSize - 1);
+}
+
+TEST_F(BoltChunkedEncoderBuffer, ClearKeepsFlushedChunks) {
+  int size = 100;
+
+  // initialize tested buffer
+  CountingOutputStream output_stream;
+  CountingBufferT buffer(output_stream);
+
+  // the first chunk is flushed, so only the second one is cleared
+  buffer.Write(test_data, size);
+  buffer.Flush(true);
+  buffer.Write(test_data + size, size);
+  buffer.Clear();
+  ASSERT_FALSE(buffer.HasData());
+  buffer.Flush();
+
+  auto data = output_stream.output.data();
+  VerifyChunkOfTestData(data, size);
+  VerifyChunkOfTestData(data + kChunkHeaderSize + size, 0);
+  ASSERT_EQ(output_stream.output.size(), 2 * kChunkHeaderSize + size);
+}
+
+TEST_F(BoltChunkedEncoderBuffer, RollbackDiscardsDataAfterTheMark) {
+  int size = 100;
+
+  // initialize tested buffer
+  CountingOutputStream output_stream;
+  CountingBufferT buffer(output_stream);
+
+  // nothing is sent after the mark, even when the buffer grows over the
+  // maximum buffered size, and all of it is discarded by the rollback
+  buffer.Write(test_data, size);
+  buffer.Flush(true);
+  buffer.MarkRollbackPoint();
+  buffer.Write(test_data, 10);
+  buffer.Write(test_data, kTestDataSize);
+  buffer.Write(test_data, kTestDataSize);
+  ASSERT_EQ(output_stream.writes, 0);
+  buffer.Rollback();
+  buffer.Write(test_data + size, size);
+  buffer.Flush();
+  ASSERT_EQ(output_stream.writes, 1);
+
+  auto data = output_stream.output.data();
+  VerifyChunkOfTestData(data, size);
+  VerifyChunkOfTestData(data + kChunkHeaderSize + size, size, size);
+  ASSERT_EQ(output_stream.output.size(), 2 * (kChunkHeaderSize + size));
+}
+
+TEST_F(BoltChunkedEncoderBuffer, ReferencesLargeData) {
+  // initialize tested buffer
+  CountingOutputStream output_stream;
+  output_stream.vectored = true;
+  CountingBufferT buffer(output_stream);
+
+  // the referenced data isn't copied, it's sent with the chunk headers in a
+  // single write when the buffer is flushed
+  buffer.Write(test_data, 10);
+  buffer.WriteReferenced(test_data + 10, kTestDataSize - 10);
+  ASSERT_EQ(output_stream.writes, 0);
+  buffer.Flush(true);
+  ASSERT_EQ(output_stream.writes, 1);
+  ASSERT_NE(std::find(output_stream.bases.begin(), output_stream.bases.end(), test_data + 10),
+            output_stream.bases.end());
+
+  auto output = output_stream.output.data();
+  VerifyChunkOfTestData(output, kChunkMaxDataSize);
+  VerifyChunkOfTestData(output + kChunkWholeSize, kTestDataSize - kChunkMaxDataSize, kChunkMaxDataSize);
+}
+
+TEST_F(BoltChunkedEncoderBuffer, CopiesReferencedDataWithoutVectoredWrites) {
+  // initialize tested buffer
+  CountingOutputStream output_stream;
+  CountingBufferT buffer(output_stream);
+
+  buffer.WriteReferenced(test_data, kTestDataSize);
+  buffer.Flush();
+  ASSERT_EQ(output_stream.writes, 1);
+  ASSERT_TRUE(output_stream.bases.empty());
+
+  auto output = output_stream.output.data();
+  VerifyChunkOfTestData(output, kChunkMaxDataSize);
+  VerifyChunkOfTestData(output + kChunkWholeSize, kTestDataSize - kChunkMaxDataSize, kChunkMaxDataSize);
+}
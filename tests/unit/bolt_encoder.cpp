@@ -9,12 +9,15 @@
 // by the Apache License, Version 2.0, included in the file
 // licenses/APL.txt.
 
+#include <algorithm>
 #include <array>
 #include <bit>
+#include <stdexcept>
 
 #include "bolt_common.hpp"
 #include "bolt_testdata.hpp"
 #include "communication/bolt/v1/codes.hpp"
+#include "communication/bolt/v1/encoder/chunked_encoder_buffer.hpp"
 #include "communication/bolt/v1/encoder/encoder.hpp"
 #include "glue/communication.hpp"
 #include "storage/v2/storage.hpp"
@@ -222,6 +225,151 @@ TEST_F(BoltEncoder, VertexAndEdge) {
   CheckOutput(output, vertexedge_encoded + 48, 26);
 }
 
+TEST_F(BoltEncoder, TypedValueEncoder) {
+  storage::Storage db;
+  auto dba = db.Access();
+  auto va1 = dba.CreateVertex();
+  auto va2 = dba.CreateVertex();
+  ASSERT_TRUE(va1.AddLabel(dba.NameToLabel("label1")).HasValue());
+  ASSERT_TRUE(va1.SetProperty(dba.NameToProperty("prop1"), storage::PropertyValue("value")).HasValue());
+  std::vector<storage::PropertyValue> list{
+      storage::PropertyValue(1), storage::PropertyValue(storage::TemporalData(storage::TemporalType::Date, 1))};
+  ASSERT_TRUE(va2.SetProperty(dba.NameToProperty("prop2"), storage::PropertyValue(list)).HasValue());
+  auto ea1 = dba.CreateEdge(&va1, &va2, dba.NameToEdgeType("type1"));
+  auto ea2 = dba.CreateEdge(&va1, &va2, dba.NameToEdgeType("type2"));
+  ASSERT_TRUE(ea1.HasValue() && ea2.HasValue());
+  ASSERT_TRUE(ea1->SetProperty(dba.NameToProperty("prop3"), storage::PropertyValue(4.2)).HasValue());
+  query::VertexAccessor v1(va1);
+  query::VertexAccessor v2(va2);
+  query::EdgeAccessor e1(*ea1);
+  query::EdgeAccessor e2(*ea2);
+
+  std::vector<query::TypedValue> values;
+  values.emplace_back();
+  values.emplace_back(true);
+  values.emplace_back(-42);
+  values.emplace_back(1.5);
+  values.emplace_back("string");
+  values.emplace_back(std::vector<query::TypedValue>{query::TypedValue(1), query::TypedValue("two")});
+  values.emplace_back(
+      std::map<std::string, query::TypedValue>{{"b", query::TypedValue(v1)}, {"a", query::TypedValue()}});
+  values.emplace_back(v1);
+  values.emplace_back(e1);
+  values.emplace_back(query::Path(v1, e1, v2, e2, v1, e1, v2));
+  values.emplace_back(utils::LocalDateTime(123456789));
+  values.emplace_back(utils::Duration(-1));
+
+  // The values are encoded straight into the chunk buffer.
+  using ChunkedBufferT = communication::bolt::ChunkedEncoderBuffer<TestOutputStream>;
+  TestOutputStream chunked_output_stream;
+  ChunkedBufferT chunked_buffer(chunked_output_stream);
+  communication::bolt::Encoder<ChunkedBufferT> chunked_encoder(chunked_buffer);
+  auto &chunked_output = chunked_output_stream.output;
+
+  // The direct encoding has to be the same as the one of the converted values.
+  std::vector<Value> converted_values;
+  for (const auto &value : values) converted_values.push_back(*glue::ToBoltValue(value, db, storage::View::NEW));
+  ASSERT_TRUE(chunked_encoder.MessageRecord(converted_values));
+  chunked_buffer.Flush();
+  auto expected = chunked_output;
+
+  chunked_output.clear();
+  glue::TypedValueBoltEncoder value_encoder(&db, storage::View::NEW);
+  ASSERT_TRUE(chunked_encoder.MessageRecord(
+      [&](auto &buffer) { ASSERT_FALSE(value_encoder.EncodeList(values, &buffer).HasError()); }));
+  chunked_buffer.Flush();
+  EXPECT_EQ(chunked_output, expected);
+
+  // The properties of the committed objects are read from the property store
+  // and the ones of the objects changed by the transaction from the deltas,
+  // and both give the same result.
+  ASSERT_FALSE(dba.Commit().HasError());
+  db.FreeMemory();
+  auto dba2 = db.Access();
+  auto committed_v1 = dba2.FindVertex(va1.Gid(), storage::View::OLD);
+  ASSERT_TRUE(committed_v1);
+  chunked_output.clear();
+  ASSERT_TRUE(chunked_encoder.MessageRecord([&](auto &buffer) {
+    ASSERT_FALSE(value_encoder.EncodeList({query::TypedValue(query::VertexAccessor(*committed_v1))}, &buffer)
+                     .HasError());
+  }));
+  chunked_buffer.Flush();
+  expected = chunked_output;
+  ASSERT_TRUE(committed_v1->SetProperty(dba2.NameToProperty("prop1"), storage::PropertyValue("value")).HasValue());
+  chunked_output.clear();
+  ASSERT_TRUE(chunked_encoder.MessageRecord([&](auto &buffer) {
+    ASSERT_FALSE(value_encoder.EncodeList({query::TypedValue(query::VertexAccessor(*committed_v1))}, &buffer)
+                     .HasError());
+  }));
+  chunked_buffer.Flush();
+  EXPECT_EQ(chunked_output, expected);
+
+  // The part of the record which was written before the encoding failed
+  // isn't sent.
+  ASSERT_TRUE(dba2.DetachDeleteVertex(&*committed_v1).HasValue());
+  chunked_output.clear();
+  EXPECT_THROW(chunked_encoder.MessageRecord([&](auto &buffer) {
+    const std::vector<query::TypedValue> row{query::TypedValue(1),
+                                             query::TypedValue(query::VertexAccessor(*committed_v1))};
+    auto maybe_encoded = value_encoder.EncodeList(row, &buffer);
+    EXPECT_TRUE(maybe_encoded.HasError());
+    EXPECT_EQ(maybe_encoded.GetError(), storage::Error::DELETED_OBJECT);
+    throw std::runtime_error("The encoding failed.");
+  }),
+               std::runtime_error);
+  ASSERT_TRUE(chunked_encoder.MessageRecord(std::vector<Value>{Value(1), Value(2), Value(3)}));
+  chunked_buffer.Flush();
+  CheckOutput(chunked_output, (const uint8_t *)"\x00\x06\xB1\x71\x93\x01\x02\x03\x00\x00\x00\x00", 12);
+}
+
+// Supports the vectored writes, so the chunk buffer references the large
+// strings instead of copying them.
+class VectoredOutputStream : public TestOutputStream {
+ public:
+  bool CanWriteVectored() const { return true; }
+
+  bool WriteVectored(const iovec *iov, size_t iovcnt, bool have_more = false) {
+    for (size_t i = 0; i < iovcnt; ++i) {
+      bases.push_back(iov[i].iov_base);
+      Write(static_cast<const uint8_t *>(iov[i].iov_base), iov[i].iov_len, have_more);
+    }
+    return write_success_;
+  }
+
+  std::vector<const void *> bases;
+};
+
+TEST_F(BoltEncoder, TypedValueEncoderReferencesStrings) {
+  storage::Storage db;
+  std::vector<query::TypedValue> values;
+  values.emplace_back(std::string(SIZE, 'a'));
+  values.emplace_back(
+      std::vector<query::TypedValue>{query::TypedValue("short"), query::TypedValue(std::string(SIZE, 'b'))});
+
+  using ChunkedBufferT = communication::bolt::ChunkedEncoderBuffer<VectoredOutputStream>;
+  VectoredOutputStream chunked_output_stream;
+  ChunkedBufferT chunked_buffer(chunked_output_stream);
+  communication::bolt::Encoder<ChunkedBufferT> chunked_encoder(chunked_buffer);
+
+  std::vector<Value> converted_values;
+  for (const auto &value : values) converted_values.push_back(*glue::ToBoltValue(value, db, storage::View::NEW));
+  ASSERT_TRUE(chunked_encoder.MessageRecord(converted_values));
+  chunked_buffer.Flush();
+  const auto expected = chunked_output_stream.output;
+
+  chunked_output_stream.output.clear();
+  chunked_output_stream.bases.clear();
+  glue::TypedValueBoltEncoder value_encoder(&db, storage::View::NEW);
+  ASSERT_TRUE(chunked_encoder.MessageRecord(
+      [&](auto &buffer) { ASSERT_FALSE(value_encoder.EncodeList(values, &buffer).HasError()); }));
+  chunked_buffer.Flush();
+  EXPECT_EQ(chunked_output_stream.output, expected);
+  // The large strings are sent straight from the values.
+  const auto &bases = chunked_output_stream.bases;
+  EXPECT_NE(std::find(bases.begin(), bases.end(), values[0].ValueString().data()), bases.end());
+  EXPECT_NE(std::find(bases.begin(), bases.end(), values[1].ValueList()[1].ValueString().data()), bases.end());
+}
+
 TEST_F(BoltEncoder, BoltV1ExampleMessages) {
   // this test checks example messages from: http://boltprotocol.org/v1/
 
@@ -0,0 +1,186 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "communication/executor.hpp"
+#include "communication/server.hpp"
+#include "io/network/socket.hpp"
+
+using namespace std::chrono_literals;
+using communication::ExecutionClass;
+
+namespace {
+
+void WaitFor(const std::function<bool()> &condition) {
+  while (!condition()) std::this_thread::sleep_for(1ms);
+}
+
+}  // namespace
+
+TEST(Executor, ExecutesAllTasks) {
+  communication::Executor executor({.interactive_workers = 2, .analytical_workers = 2}, "Test");
+  executor.Start();
+  std::atomic<int> count{0};
+  for (int i = 0; i < 1000; ++i) {
+    executor.Submit(i % 2 ? ExecutionClass::INTERACTIVE : ExecutionClass::ANALYTICAL, [&] { ++count; });
+  }
+  WaitFor([&] { return count == 1000; });
+  executor.Shutdown();
+}
+
+TEST(Executor, LimitsEachClass) {
+  communication::Executor executor({.interactive_workers = 1, .analytical_workers = 1}, "Test");
+  executor.Start();
+  std::atomic<bool> release{false};
+  std::atomic<int> analytical_done{0};
+  for (int i = 0; i < 2; ++i) {
+    executor.Submit(ExecutionClass::ANALYTICAL, [&] {
+      WaitFor([&] { return release.load(); });
+      ++analytical_done;
+    });
+  }
+  WaitFor([&] { return executor.RunningTasks(ExecutionClass::ANALYTICAL) == 1; });
+
+  // The analytical class is full, but the interactive tasks still run.
+  std::atomic<int> interactive_done{0};
+  for (int i = 0; i < 10; ++i) {
+    executor.Submit(ExecutionClass::INTERACTIVE, [&] { ++interactive_done; });
+  }
+  WaitFor([&] { return interactive_done == 10; });
+  EXPECT_EQ(analytical_done, 0);
+  EXPECT_EQ(executor.RunningTasks(ExecutionClass::ANALYTICAL), 1);
+
+  release = true;
+  WaitFor([&] { return analytical_done == 2; });
+  executor.Shutdown();
+}
+
+TEST(Executor, DemotesLongTasks) {
+  communication::Executor executor(
+      {.interactive_workers = 1, .analytical_workers = 1, .analytical_threshold = 50ms}, "Test");
+  executor.Start();
+  std::atomic<bool> release{false};
+  executor.Submit(ExecutionClass::INTERACTIVE, [&] { WaitFor([&] { return release.load(); }); });
+  WaitFor([&] { return executor.RunningTasks(ExecutionClass::INTERACTIVE) == 1; });
+
+  // The long task leaves the interactive class after the threshold, so the
+  // next interactive task can run.
+  std::atomic<bool> done{false};
+  executor.Submit(ExecutionClass::INTERACTIVE, [&] { done = true; });
+  WaitFor([&] { return done.load(); });
+  EXPECT_EQ(executor.RunningTasks(ExecutionClass::ANALYTICAL), 1);
+  EXPECT_EQ(executor.RunningTasks(ExecutionClass::INTERACTIVE), 0);
+
+  release = true;
+  WaitFor([&] { return executor.RunningTasks(ExecutionClass::ANALYTICAL) == 0; });
+  executor.Shutdown();
+}
+
+TEST(Executor, ShutdownDropsWaitingTasks) {
+  communication::Executor executor({.interactive_workers = 1, .analytical_workers = 1}, "Test");
+  executor.Start();
+  std::atomic<bool> release{false};
+  std::atomic<int> done{0};
+  executor.Submit(ExecutionClass::ANALYTICAL, [&] {
+    WaitFor([&] { return release.load(); });
+    ++done;
+  });
+  WaitFor([&] { return executor.RunningTasks(ExecutionClass::ANALYTICAL) == 1; });
+  executor.Submit(ExecutionClass::ANALYTICAL, [&] { ++done; });
+
+  std::thread releaser([&] {
+    std::this_thread::sleep_for(50ms);
+    release = true;
+  });
+  executor.Shutdown();
+  releaser.join();
+  // The running task is finished, the waiting one is dropped.
+  EXPECT_EQ(done, 1);
+  executor.Submit(ExecutionClass::ANALYTICAL, [&] { ++done; });
+  EXPECT_EQ(done, 1);
+}
+
+class TestData {};
+
+// Echoes the received data. Data starting with 'e' takes a while to execute.
+class TestSession {
+ public:
+  TestSession(TestData *, const io::network::Endpoint &, communication::InputStream *input_stream,
+              communication::OutputStream *output_stream)
+      : input_stream_(input_stream), output_stream_(output_stream) {}
+
+  void Execute() {
+    if (input_stream_->data()[0] == 'e') {
+      std::this_thread::sleep_for(2s);
+    }
+    output_stream_->Write(input_stream_->data(), input_stream_->size());
+    input_stream_->Shift(input_stream_->size());
+  }
+
+ private:
+  communication::InputStream *input_stream_;
+  communication::OutputStream *output_stream_;
+};
+
+bool QueryServer(io::network::Socket &socket, const std::string &query) {
+  if (!socket.Write(query)) return false;
+  std::string response(query.size(), 0);
+  size_t len = 0;
+  while (len < query.size()) {
+    const auto got = socket.Read(response.data() + len, query.size() - len);
+    if (got <= 0) return false;
+    len += got;
+  }
+  return response == query;
+}
+
+TEST(Executor, ServerKeepsServingDuringLongExecution) {
+  TestData test_data;
+  communication::ServerContext context;
+  communication::Server<TestSession, TestData> server{
+      {"127.0.0.1", 0},
+      &test_data,
+      &context,
+      -1,
+      "Test",
+      1,
+      communication::ExecutorConfig{.interactive_workers = 1, .analytical_workers = 1, .analytical_threshold = 100ms}};
+  ASSERT_TRUE(server.Start());
+
+  io::network::Socket long_client;
+  ASSERT_TRUE(long_client.Connect(server.endpoint()));
+  std::thread long_query([&] { EXPECT_TRUE(QueryServer(long_client, "eeee")); });
+
+  // The long execution takes neither the only I/O worker nor, after the
+  // threshold, the only interactive worker.
+  std::this_thread::sleep_for(200ms);
+  io::network::Socket client;
+  ASSERT_TRUE(client.Connect(server.endpoint()));
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_TRUE(QueryServer(client, "tttt"));
+  }
+  EXPECT_LT(std::chrono::steady_clock::now() - start, 1s);
+
+  long_query.join();
+  // The session of the long execution still works.
+  ASSERT_TRUE(QueryServer(long_client, "tttt"));
+
+  server.Shutdown();
+  server.AwaitShutdown();
+}
@@ -211,10 +211,12 @@ class MockModule : public procedure::Module {
   const std::map<std::string, mgp_proc, std::less<>> *Procedures() const override { return &procedures; }
 
   const std::map<std::string, mgp_trans, std::less<>> *Transformations() const override { return &transformations; }
+  const std::map<std::string, mgp_change_hook, std::less<>> *ChangeHooks() const override { return &change_hooks; }
   std::optional<std::filesystem::path> Path() const override { return std::nullopt; }
 
   std::map<std::string, mgp_proc, std::less<>> procedures{};
   std::map<std::string, mgp_trans, std::less<>> transformations{};
+  std::map<std::string, mgp_change_hook, std::less<>> change_hooks{};
 };
 
 void DummyProcCallback(mgp_list * /*args*/, mgp_graph * /*graph*/, mgp_result * /*result*/, mgp_memory * /*memory*/){};
@@ -3900,6 +3902,26 @@ TEST_P(CypherMainVisitorTest, CreateKafkaStream) {
   }
 }
 
+TEST_P(CypherMainVisitorTest, CreateKafkaStreamParallelism) {
+  auto &ast_generator = *GetParam();
+  TestInvalidQuery("CREATE KAFKA STREAM stream TOPICS topic1 TRANSFORM transform PARALLELISM", ast_generator);
+  TestInvalidQuery<SemanticException>(
+      "CREATE KAFKA STREAM stream TOPICS topic1 TRANSFORM transform PARALLELISM 'invalid parallelism'",
+      ast_generator);
+  TestInvalidQuery<SemanticException>(
+      "CREATE KAFKA STREAM stream TOPICS topic1 TRANSFORM transform PARALLELISM 2 PARALLELISM 3", ast_generator);
+
+  auto *parsed_query = dynamic_cast<StreamQuery *>(
+      ast_generator.ParseQuery("CREATE KAFKA STREAM stream TOPICS topic1 TRANSFORM transform PARALLELISM 4"));
+  ASSERT_NE(parsed_query, nullptr);
+  EXPECT_NO_FATAL_FAILURE(CheckOptionalExpression(ast_generator, parsed_query->parallelism_, TypedValue{4}));
+
+  parsed_query = dynamic_cast<StreamQuery *>(
+      ast_generator.ParseQuery("CREATE KAFKA STREAM stream TOPICS topic1 TRANSFORM transform"));
+  ASSERT_NE(parsed_query, nullptr);
+  EXPECT_EQ(parsed_query->parallelism_, nullptr);
+}
+
 void ValidateCreatePulsarStreamQuery(Base &ast_generator, const std::string &query_string,
                                      const std::string_view stream_name, const std::vector<std::string> &topic_names,
                                      const std::string_view transform_name,
@@ -4087,3 +4109,13 @@ TEST_P(CypherMainVisitorTest, VersionQuery) {
   TestInvalidQuery("SHOW VERSIONS", ast_generator);
   ASSERT_NO_THROW(ast_generator.ParseQuery("SHOW VERSION"));
 }
+
+TEST_P(CypherMainVisitorTest, AnalyzeGraphQuery) {
+  auto &ast_generator = *GetParam();
+
+  TestInvalidQuery("ANALYZE", ast_generator);
+  TestInvalidQuery("ANALYZE GRAPHS", ast_generator);
+  TestInvalidQuery("ANALYZE GRAPH GRAPH", ast_generator);
+  auto *query = dynamic_cast<AnalyzeGraphQuery *>(ast_generator.ParseQuery("ANALYZE GRAPH"));
+  ASSERT_TRUE(query);
+}
@@ -715,13 +715,14 @@ TEST_F(InterpreterTest, ProfileQuery) {
   EXPECT_EQ(interpreter_context.plan_cache.size(), 0U);
   EXPECT_EQ(interpreter_context.ast_cache.size(), 0U);
   auto stream = Interpret("PROFILE MATCH (n) RETURN *;");
-  std::vector<std::string> expected_header{"OPERATOR", "ACTUAL HITS", "RELATIVE TIME", "ABSOLUTE TIME"};
+  std::vector<std::string> expected_header{"OPERATOR", "ACTUAL HITS", "RELATIVE TIME", "ABSOLUTE TIME",
+                                           "ALLOCATED MEMORY"};
   EXPECT_EQ(stream.GetHeader(), expected_header);
   std::vector<std::string> expected_rows{"* Produce", "* ScanAll", "* Once"};
   ASSERT_EQ(stream.GetResults().size(), expected_rows.size());
   auto expected_it = expected_rows.begin();
   for (const auto &row : stream.GetResults()) {
-    ASSERT_EQ(row.size(), 4U);
+    ASSERT_EQ(row.size(), 5U);
     EXPECT_EQ(row.front().ValueString(), *expected_it);
     ++expected_it;
   }
@@ -740,7 +741,8 @@ TEST_F(InterpreterTest, ProfileQueryMultiplePulls) {
   EXPECT_EQ(interpreter_context.plan_cache.size(), 0U);
   EXPECT_EQ(interpreter_context.ast_cache.size(), 0U);
   auto [stream, qid] = Prepare("PROFILE MATCH (n) RETURN *;");
-  std::vector<std::string> expected_header{"OPERATOR", "ACTUAL HITS", "RELATIVE TIME", "ABSOLUTE TIME"};
+  std::vector<std::string> expected_header{"OPERATOR", "ACTUAL HITS", "RELATIVE TIME", "ABSOLUTE TIME",
+                                           "ALLOCATED MEMORY"};
   EXPECT_EQ(stream.GetHeader(), expected_header);
 
   std::vector<std::string> expected_rows{"* Produce", "* ScanAll", "* Once"};
@@ -748,19 +750,19 @@ TEST_F(InterpreterTest, ProfileQueryMultiplePulls) {
 
   Pull(&stream, 1);
   ASSERT_EQ(stream.GetResults().size(), 1U);
-  ASSERT_EQ(stream.GetResults()[0].size(), 4U);
+  ASSERT_EQ(stream.GetResults()[0].size(), 5U);
   ASSERT_EQ(stream.GetResults()[0][0].ValueString(), *expected_it);
   ++expected_it;
 
   Pull(&stream, 1);
   ASSERT_EQ(stream.GetResults().size(), 2U);
-  ASSERT_EQ(stream.GetResults()[1].size(), 4U);
+  ASSERT_EQ(stream.GetResults()[1].size(), 5U);
   ASSERT_EQ(stream.GetResults()[1][0].ValueString(), *expected_it);
   ++expected_it;
 
   Pull(&stream);
   ASSERT_EQ(stream.GetResults().size(), 3U);
-  ASSERT_EQ(stream.GetResults()[2].size(), 4U);
+  ASSERT_EQ(stream.GetResults()[2].size(), 5U);
   ASSERT_EQ(stream.GetResults()[2][0].ValueString(), *expected_it);
 
   // We should have a plan cache for MATCH ...
@@ -784,13 +786,14 @@ TEST_F(InterpreterTest, ProfileQueryWithParams) {
   EXPECT_EQ(interpreter_context.plan_cache.size(), 0U);
   EXPECT_EQ(interpreter_context.ast_cache.size(), 0U);
   auto stream = Interpret("PROFILE MATCH (n) WHERE n.id = $id RETURN *;", {{"id", storage::PropertyValue(42)}});
-  std::vector<std::string> expected_header{"OPERATOR", "ACTUAL HITS", "RELATIVE TIME", "ABSOLUTE TIME"};
+  std::vector<std::string> expected_header{"OPERATOR", "ACTUAL HITS", "RELATIVE TIME", "ABSOLUTE TIME",
+                                           "ALLOCATED MEMORY"};
   EXPECT_EQ(stream.GetHeader(), expected_header);
   std::vector<std::string> expected_rows{"* Produce", "* Filter", "* ScanAll", "* Once"};
   ASSERT_EQ(stream.GetResults().size(), expected_rows.size());
   auto expected_it = expected_rows.begin();
   for (const auto &row : stream.GetResults()) {
-    ASSERT_EQ(row.size(), 4U);
+    ASSERT_EQ(row.size(), 5U);
     EXPECT_EQ(row.front().ValueString(), *expected_it);
     ++expected_it;
   }
@@ -809,13 +812,14 @@ TEST_F(InterpreterTest, ProfileQueryWithLiterals) {
   EXPECT_EQ(interpreter_context.plan_cache.size(), 0U);
   EXPECT_EQ(interpreter_context.ast_cache.size(), 0U);
   auto stream = Interpret("PROFILE UNWIND range(1, 1000) AS x CREATE (:Node {id: x});", {});
-  std::vector<std::string> expected_header{"OPERATOR", "ACTUAL HITS", "RELATIVE TIME", "ABSOLUTE TIME"};
+  std::vector<std::string> expected_header{"OPERATOR", "ACTUAL HITS", "RELATIVE TIME", "ABSOLUTE TIME",
+                                           "ALLOCATED MEMORY"};
   EXPECT_EQ(stream.GetHeader(), expected_header);
   std::vector<std::string> expected_rows{"* CreateNode", "* Unwind", "* Once"};
   ASSERT_EQ(stream.GetResults().size(), expected_rows.size());
   auto expected_it = expected_rows.begin();
   for (const auto &row : stream.GetResults()) {
-    ASSERT_EQ(row.size(), 4U);
+    ASSERT_EQ(row.size(), 5U);
     EXPECT_EQ(row.front().ValueString(), *expected_it);
     ++expected_it;
   }
@@ -828,6 +832,14 @@ TEST_F(InterpreterTest, ProfileQueryWithLiterals) {
   EXPECT_EQ(interpreter_context.ast_cache.size(), 2U);
 }
 
+TEST_F(InterpreterTest, PeakMemoryUsageSummary) {
+  auto stream = Interpret("UNWIND range(1, 10000) AS x RETURN collect(x) AS xs;");
+  ASSERT_EQ(stream.GetResults().size(), 1U);
+  ASSERT_EQ(stream.GetSummary().count("peak_memory_usage"), 1);
+  // The collected list alone holds 10000 integers.
+  EXPECT_GT(stream.GetSummary().at("peak_memory_usage").ValueInt(), 10000 * static_cast<int64_t>(sizeof(int64_t)));
+}
+
 TEST_F(InterpreterTest, Transactions) {
   auto &interpreter = default_interpreter.interpreter;
   {
@@ -1064,6 +1076,104 @@ TEST_F(InterpreterTest, CacheableQueries) {
   }
 }
 
+TEST_F(InterpreterTest, PlanCacheInvalidation) {
+  const auto &interpreter_context = default_interpreter.interpreter_context;
+  Interpret("MATCH (n) RETURN n");
+  EXPECT_EQ(interpreter_context.plan_cache.size(), 1U);
+  Interpret("CREATE INDEX ON :A(a)");
+  EXPECT_EQ(interpreter_context.plan_cache.size(), 0U);
+  Interpret("MATCH (n) RETURN n");
+  EXPECT_EQ(interpreter_context.plan_cache.size(), 1U);
+  Interpret("CREATE CONSTRAINT ON (n:A) ASSERT EXISTS (n.a)");
+  EXPECT_EQ(interpreter_context.plan_cache.size(), 0U);
+  // The parsed queries don't depend on the schema.
+  EXPECT_EQ(interpreter_context.ast_cache.hits(), 1U);
+}
+
+TEST_F(InterpreterTest, CacheMemoryLimit) {
+  TmpDirManager directory_manager{"cache_memory_limit"};
+  InterpreterFaker interpreter_faker{
+      &db_, {.query = {.ast_cache_max_memory_bytes = 0, .plan_cache_max_memory_bytes = 0}}, directory_manager.Path()};
+  const auto &interpreter_context = interpreter_faker.interpreter_context;
+  interpreter_faker.Interpret("MATCH (n) RETURN n");
+  EXPECT_EQ(interpreter_context.ast_cache.size(), 0U);
+  EXPECT_EQ(interpreter_context.plan_cache.size(), 0U);
+  EXPECT_EQ(interpreter_context.ast_cache.memory_usage(), 0U);
+  EXPECT_EQ(interpreter_context.plan_cache.memory_usage(), 0U);
+}
+
+TEST_F(InterpreterTest, ReplanOnCardinalityDrift) {
+  const std::string query = "MATCH (n:Person) RETURN count(n)";
+  // The plan is made for the empty graph.
+  Interpret(query);
+  Interpret("UNWIND range(1, 2000) AS i CREATE (:Person {id: i})");
+  {
+    auto [stream, qid] = Prepare(query);
+    Pull(&stream);
+    ASSERT_EQ(stream.GetSummary().count("notifications"), 1);
+    auto notification = stream.GetSummary().at("notifications").ValueList()[0].ValueMap();
+    EXPECT_EQ(notification["severity"].ValueString(), "INFO");
+    EXPECT_EQ(notification["code"].ValueString(), "PlanInvalidated");
+    EXPECT_EQ(notification["description"].ValueString(),
+              "ScanAll was estimated to produce 0.0 vertices per input row, but it produced 2000.0. The query will be "
+              "planned again the next time it's run.");
+  }
+  // The new plan is made for the current graph.
+  {
+    auto [stream, qid] = Prepare(query);
+    Pull(&stream);
+    EXPECT_EQ(stream.GetSummary().count("notifications"), 0);
+  }
+}
+
+TEST_F(InterpreterTest, ReadAhead) {
+  TmpDirManager directory_manager{"read_ahead"};
+  InterpreterFaker interpreter_faker{&db_, {.query = {.read_ahead_rows = 3, .read_ahead_threads = 2}},
+                                     directory_manager.Path()};
+  interpreter_faker.Interpret("UNWIND range(1, 10) AS i CREATE (:Node {id: i})");
+  {
+    auto [stream, qid] = interpreter_faker.Prepare("MATCH (n:Node) RETURN n.id AS id ORDER BY id");
+    for (int64_t i = 1; i <= 10; i += 2) {
+      interpreter_faker.Pull(&stream, 2);
+      ASSERT_EQ(stream.GetResults().size(), static_cast<size_t>(i + 1));
+      EXPECT_EQ(stream.GetResults()[i - 1][0].ValueInt(), i);
+      EXPECT_EQ(stream.GetResults()[i][0].ValueInt(), i + 1);
+      EXPECT_EQ(stream.GetSummary().at("has_more").ValueBool(), i + 1 < 10);
+    }
+  }
+  // The rows produced before the error are streamed before it's thrown.
+  {
+    auto [stream, qid] = interpreter_faker.Prepare("UNWIND range(1, 10) AS i RETURN 10 / (5 - i)");
+    interpreter_faker.Pull(&stream, 2);
+    ASSERT_EQ(stream.GetResults().size(), 2U);
+    EXPECT_THROW(interpreter_faker.Pull(&stream), query::QueryRuntimeException);
+    EXPECT_EQ(stream.GetResults().size(), 4U);
+  }
+  // The query can be abandoned while its rows are still being produced.
+  {
+    auto [stream, qid] = interpreter_faker.Prepare("UNWIND range(1, 1000) AS i RETURN i");
+    interpreter_faker.Pull(&stream, 1);
+    ASSERT_EQ(stream.GetResults().size(), 1U);
+    interpreter_faker.interpreter.Abort();
+  }
+  EXPECT_EQ(interpreter_faker.Interpret("MATCH (n:Node) RETURN count(n)").GetResults()[0][0].ValueInt(), 10);
+}
+
+TEST_F(InterpreterTest, NoReplanOnSkewedPropertyValues) {
+  Interpret("CREATE INDEX ON :Person(team)");
+  Interpret("UNWIND range(1, 2000) AS i CREATE (:Person {team: 1})");
+  Interpret("CREATE (:Person {team: 2})");
+  // The plan is cached with the estimate for the value 2, but the value 1 is
+  // looked up by the same plan.
+  for (const auto *query : {"MATCH (n:Person {team: 2}) RETURN count(n)", "MATCH (n:Person {team: 1}) RETURN count(n)",
+                            "MATCH (n:Person) WHERE n.team > 1 RETURN count(n)",
+                            "MATCH (n:Person) WHERE n.team > 0 RETURN count(n)"}) {
+    auto [stream, qid] = Prepare(query);
+    Pull(&stream);
+    EXPECT_EQ(stream.GetSummary().count("notifications"), 0) << query;
+  }
+}
+
 TEST_F(InterpreterTest, AllowLoadCsvConfig) {
   const auto check_load_csv_queries = [&](const bool allow_load_csv) {
     TmpDirManager directory_manager{"allow_load_csv"};
@@ -127,3 +127,5 @@ void KafkaClusterMock::SeedTopic(const std::string &topic_name, std::span<const
     throw std::runtime_error("Failed to delivered a message on " + topic_name + " to seed it");
   }
 }
+
+std::string MockedRdKafkaMessage::mocked_topic_name = "Topic1";
@@ -11,8 +11,10 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <span>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -47,3 +49,85 @@ class KafkaClusterMock {
   RdKafkaUniquePtr rk_{nullptr};
   RdKafkaMockClusterUniquePtr cluster_{nullptr};
 };
+
+/// This class implements the interface of RdKafka::Message such that it can be mocked.
+/// It's important to note that integrations::kafka::Message member functions
+/// use c_ptr() to indirectly access the results inside the rd_kafka_message_s structure
+/// effectively bypassing the mocked values returned by the overrides below. Therefore, to
+/// protect against accidental use of the public members, the functions are marked as
+/// [[noreturn]] and throw an std::logic_error exception.
+class MockedRdKafkaMessage : public RdKafka::Message {
+ public:
+  explicit MockedRdKafkaMessage(std::string key, std::string payload, int64_t offset, int32_t partition = 0)
+      : key_(std::move(key)), payload_(std::move(payload)) {
+    message_.err = rd_kafka_resp_err_t::RD_KAFKA_RESP_ERR__BEGIN;
+    message_.key = static_cast<void *>(key_.data());
+    message_.key_len = key_.size();
+    message_.offset = offset;
+    message_.partition = partition;
+    message_.payload = static_cast<void *>(payload_.data());
+    message_.len = payload_.size();
+    rd_kafka_ = rd_kafka_new(rd_kafka_type_t::RD_KAFKA_CONSUMER, nullptr, nullptr, 0);
+    message_.rkt = rd_kafka_topic_new(rd_kafka_, mocked_topic_name.data(), nullptr);
+  }
+
+  ~MockedRdKafkaMessage() override {
+    rd_kafka_destroy(rd_kafka_);
+    rd_kafka_topic_destroy(message_.rkt);
+  }
+
+  // The two can be accessed safely. Any use of the other public members should
+  // be considered accidental (as per the current semantics of the class
+  // Message) and therefore they are marked as [[noreturn]] and throw
+  rd_kafka_message_s *c_ptr() override { return &message_; }
+
+  // This is used by Message() constructor
+
+  RdKafka::ErrorCode err() const override { return RdKafka::ErrorCode::ERR_NO_ERROR; }
+
+  [[noreturn]] std::string errstr() const override { ThrowIllegalCallError(); }
+
+  [[noreturn]] RdKafka::Topic *topic() const override { ThrowIllegalCallError(); }
+
+  [[noreturn]] std::string topic_name() const override { ThrowIllegalCallError(); }
+
+  [[noreturn]] int32_t partition() const override { ThrowIllegalCallError(); }
+
+  [[noreturn]] void *payload() const override { ThrowIllegalCallError(); }
+
+  [[noreturn]] size_t len() const override { ThrowIllegalCallError(); }
+
+  [[noreturn]] const std::string *key() const override { ThrowIllegalCallError(); }
+
+  [[noreturn]] const void *key_pointer() const override { ThrowIllegalCallError(); }
+
+  [[noreturn]] size_t key_len() const override { ThrowIllegalCallError(); }
+
+  [[noreturn]] int64_t offset() const override { ThrowIllegalCallError(); }
+
+  [[noreturn]] RdKafka::MessageTimestamp timestamp() const override { ThrowIllegalCallError(); }
+
+  [[noreturn]] void *msg_opaque() const override { ThrowIllegalCallError(); }
+
+  [[noreturn]] int64_t latency() const override { ThrowIllegalCallError(); }
+
+  [[noreturn]] Status status() const override { ThrowIllegalCallError(); }
+
+  [[noreturn]] RdKafka::Headers *headers() override { ThrowIllegalCallError(); }
+
+  [[noreturn]] RdKafka::Headers *headers(RdKafka::ErrorCode *err) override { ThrowIllegalCallError(); }
+
+  [[noreturn]] int32_t broker_id() const override { ThrowIllegalCallError(); }
+
+ private:
+  [[noreturn]] void ThrowIllegalCallError() const {
+    throw std::logic_error("This function should not have been called");
+  }
+
+  std::string key_;
+  rd_kafka_t *rd_kafka_;
+  std::string payload_;
+  rd_kafka_message_s message_;
+
+  static std::string mocked_topic_name;
+};
@@ -0,0 +1,190 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "communication/server.hpp"
+#include "io/network/io_uring.hpp"
+#include "io/network/socket.hpp"
+
+class IoUringTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    if (!io::network::IoUring::IsSupported()) GTEST_SKIP() << "The kernel doesn't support io_uring.";
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds_), 0);
+  }
+
+  void TearDown() override {
+    for (const auto fd : fds_) {
+      if (fd != -1) close(fd);
+    }
+  }
+
+  int fds_[2]{-1, -1};
+};
+
+TEST_F(IoUringTest, PollIsOneshot) {
+  io::network::IoUring ring;
+  io::network::IoUring::Event event;
+  int handler = 0;
+  ring.Add(fds_[0], EPOLLIN | EPOLLET | EPOLLRDHUP | EPOLLONESHOT, &handler);
+  ASSERT_EQ(ring.Wait(&event, 1, 10), 0);
+
+  ASSERT_EQ(write(fds_[1], "a", 1), 1);
+  ASSERT_EQ(ring.Wait(&event, 1, 1000), 1);
+  EXPECT_EQ(event.data.ptr, &handler);
+  EXPECT_TRUE(event.events & EPOLLIN);
+
+  // The data wasn't read, but the poll has to be rearmed to report it again.
+  ASSERT_EQ(ring.Wait(&event, 1, 10), 0);
+  ring.Modify(fds_[0], EPOLLIN | EPOLLET | EPOLLRDHUP | EPOLLONESHOT, &handler);
+  ASSERT_EQ(ring.Wait(&event, 1, 1000), 1);
+  EXPECT_EQ(event.data.ptr, &handler);
+}
+
+TEST_F(IoUringTest, ReportsHangup) {
+  io::network::IoUring ring;
+  io::network::IoUring::Event event;
+  int handler = 0;
+  ring.Add(fds_[0], EPOLLIN | EPOLLET | EPOLLRDHUP | EPOLLONESHOT, &handler);
+  close(fds_[1]);
+  fds_[1] = -1;
+  ASSERT_EQ(ring.Wait(&event, 1, 1000), 1);
+  EXPECT_TRUE(event.events & EPOLLRDHUP);
+}
+
+TEST_F(IoUringTest, DeleteCancelsPoll) {
+  io::network::IoUring ring;
+  io::network::IoUring::Event event;
+  int handler = 0;
+  ring.Add(fds_[0], EPOLLIN | EPOLLET | EPOLLRDHUP | EPOLLONESHOT, &handler);
+  ASSERT_EQ(ring.Wait(&event, 1, 10), 0);
+  ring.Delete(fds_[0]);
+  ASSERT_EQ(ring.Wait(&event, 1, 10), 0);
+  ASSERT_EQ(write(fds_[1], "a", 1), 1);
+  ASSERT_EQ(ring.Wait(&event, 1, 10), 0);
+}
+
+TEST_F(IoUringTest, AddWhileWaiting) {
+  io::network::IoUring ring;
+  int handler = 0;
+  ASSERT_EQ(write(fds_[1], "a", 1), 1);
+  std::thread waiter([&] {
+    io::network::IoUring::Event event;
+    // The poll is added while this thread is blocked in the kernel and no
+    // other thread waits, so it has to be submitted right away.
+    EXPECT_EQ(ring.Wait(&event, 1, 5000), 1);
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  const auto start = std::chrono::steady_clock::now();
+  ring.Add(fds_[0], EPOLLIN | EPOLLET | EPOLLRDHUP | EPOLLONESHOT, &handler);
+  waiter.join();
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+}
+
+TEST_F(IoUringTest, AddWhileManyWaiting) {
+  constexpr int kPairs = 4;
+  io::network::IoUring ring;
+  std::vector<int> fds;
+  std::vector<int> handlers(kPairs, 0);
+  for (int i = 0; i < kPairs; ++i) {
+    int pair[2];
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, pair), 0);
+    fds.insert(fds.end(), pair, pair + 2);
+    ASSERT_EQ(write(pair[1], "a", 1), 1);
+  }
+  // One of the threads blocks in the kernel and the others wait for it. The
+  // polls added meanwhile are submitted by one of the waiting threads and the
+  // completions are shared between all of them.
+  std::atomic<int> received{0};
+  std::vector<std::thread> waiters;
+  for (int i = 0; i < kPairs; ++i) {
+    waiters.emplace_back([&] {
+      io::network::IoUring::Event event;
+      if (ring.Wait(&event, 1, 5000) == 1) ++received;
+    });
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kPairs; ++i) {
+    ring.Add(fds[2 * i], EPOLLIN | EPOLLET | EPOLLRDHUP | EPOLLONESHOT, &handlers[i]);
+  }
+  for (auto &waiter : waiters) waiter.join();
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+  EXPECT_EQ(received, kPairs);
+  for (const auto fd : fds) close(fd);
+}
+
+class TestData {};
+
+class TestSession {
+ public:
+  TestSession(TestData *, const io::network::Endpoint &, communication::InputStream *input_stream,
+              communication::OutputStream *output_stream)
+      : input_stream_(input_stream), output_stream_(output_stream) {}
+
+  void Execute() {
+    output_stream_->Write(input_stream_->data(), input_stream_->size());
+    input_stream_->Shift(input_stream_->size());
+  }
+
+ private:
+  communication::InputStream *input_stream_;
+  communication::OutputStream *output_stream_;
+};
+
+bool QueryServer(io::network::Socket &socket, const std::string &query) {
+  if (!socket.Write(query)) return false;
+  std::string response(query.size(), 0);
+  size_t len = 0;
+  while (len < query.size()) {
+    const auto got = socket.Read(response.data() + len, query.size() - len);
+    if (got <= 0) return false;
+    len += got;
+  }
+  return response == query;
+}
+
+TEST_F(IoUringTest, ServerHandlesManyConnections) {
+  TestData test_data;
+  communication::ServerContext context;
+  communication::Server<TestSession, TestData> server{
+      {"127.0.0.1", 0}, &test_data, &context, -1, "Test", 4, std::nullopt, communication::IoBackend::IO_URING};
+  ASSERT_TRUE(server.Start());
+
+  std::vector<std::thread> clients;
+  for (int i = 0; i < 8; ++i) {
+    clients.emplace_back([&, i] {
+      // Each client reconnects a couple of times, so the connections are
+      // opened and closed while the others are served.
+      for (int j = 0; j < 10; ++j) {
+        io::network::Socket client;
+        ASSERT_TRUE(client.Connect(server.endpoint()));
+        for (int k = 0; k < 10; ++k) {
+          ASSERT_TRUE(QueryServer(client, fmt::format("query {} {} {}", i, j, k)));
+        }
+      }
+    });
+  }
+  for (auto &client : clients) client.join();
+
+  server.Shutdown();
+  server.AwaitShutdown();
+}
@@ -0,0 +1,104 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "query/interpret/compact_rows.hpp"
+#include "storage/v2/storage.hpp"
+#include "utils/temporal.hpp"
+
+using query::CompactRows;
+using query::CompactValue;
+using query::TypedValue;
+
+class CompactRowsTest : public ::testing::Test {
+ protected:
+  storage::Storage db;
+  storage::Storage::Accessor storage_dba{db.Access()};
+  query::DbAccessor dba{&storage_dba};
+  query::SymbolTable symbol_table;
+  utils::MonotonicBufferResource memory{1024};
+
+  std::vector<query::Symbol> MakeSymbols(size_t count) {
+    std::vector<query::Symbol> symbols;
+    for (size_t i = 0; i < count; ++i) symbols.push_back(symbol_table.CreateSymbol(std::to_string(i), true));
+    return symbols;
+  }
+};
+
+TEST_F(CompactRowsTest, InlineValues) {
+  EXPECT_EQ(CompactValue::Inline(TypedValue())->kind(), CompactValue::Kind::Null);
+  EXPECT_EQ(CompactValue::Inline(TypedValue(42))->kind(), CompactValue::Kind::Int);
+  EXPECT_EQ(CompactValue::Inline(TypedValue("fourteen bytes"))->kind(), CompactValue::Kind::InlineString);
+  EXPECT_FALSE(CompactValue::Inline(TypedValue("fifteen bytes..")));
+  EXPECT_FALSE(CompactValue::Inline(TypedValue(std::vector<TypedValue>{TypedValue(1)})));
+  EXPECT_FALSE(CompactValue::Inline(TypedValue(dba.InsertVertex())));
+
+  const std::vector<TypedValue> values{TypedValue(),
+                                       TypedValue(true),
+                                       TypedValue(-7),
+                                       TypedValue(0.5),
+                                       TypedValue("short"),
+                                       TypedValue(utils::Date({1994, 12, 7})),
+                                       TypedValue(utils::LocalTime({12, 30, 15, 2, 3})),
+                                       TypedValue(utils::LocalDateTime(utils::DateParameters{2021, 3, 4},
+                                                                       utils::LocalTimeParameters{1, 2, 3})),
+                                       TypedValue(utils::Duration(-12345))};
+  for (const auto &value : values) {
+    const auto compact = CompactValue::Inline(value);
+    ASSERT_TRUE(compact);
+    EXPECT_TRUE(compact->IsInline());
+    const auto restored = compact->ToTypedValue(&memory);
+    EXPECT_EQ(restored.type(), value.type());
+    EXPECT_TRUE(TypedValue::BoolEqual{}(restored, value));
+    EXPECT_EQ(restored.GetMemoryResource(), &memory);
+  }
+}
+
+TEST_F(CompactRowsTest, AppendAndLoad) {
+  const auto symbols = MakeSymbols(4);
+  query::Frame frame(symbol_table.max_position());
+  auto vertex = dba.InsertVertex();
+  auto edge = *dba.InsertEdge(&vertex, &vertex, dba.NameToEdgeType("Type"));
+  const std::string long_string = "a string which doesn't fit inline";
+
+  CompactRows rows(&memory);
+  EXPECT_TRUE(rows.empty());
+  for (int64_t i = 0; i < 3; ++i) {
+    frame[symbols[0]] = vertex;
+    frame[symbols[1]] = edge;
+    frame[symbols[2]] = TypedValue(long_string);
+    frame[symbols[3]] = TypedValue(std::map<std::string, TypedValue>{{"row", TypedValue(i)}});
+    rows.Append(frame, symbols);
+  }
+  ASSERT_EQ(rows.size(), 3U);
+
+  for (size_t i = 0; i < rows.size(); ++i) {
+    for (const auto &symbol : symbols) frame[symbol] = TypedValue();
+    rows.Load(i, symbols, &frame);
+    EXPECT_EQ(frame[symbols[0]].ValueVertex(), vertex);
+    EXPECT_EQ(frame[symbols[1]].ValueEdge(), edge);
+    EXPECT_EQ(std::string_view(frame[symbols[2]].ValueString()), long_string);
+    EXPECT_EQ(frame[symbols[3]].ValueMap().find("row")->second.ValueInt(), i);
+  }
+
+  rows.clear();
+  EXPECT_TRUE(rows.empty());
+  frame[symbols[0]] = TypedValue(1);
+  rows.Append(frame, {symbols[0]});
+  rows.Load(0, {symbols[0]}, &frame);
+  EXPECT_EQ(frame[symbols[0]].ValueInt(), 1);
+}
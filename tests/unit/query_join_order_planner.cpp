@@ -0,0 +1,131 @@
+// Copyright 2021 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include "gtest/gtest.h"
+
+#include "query/frontend/semantic/symbol_generator.hpp"
+#include "query/frontend/semantic/symbol_table.hpp"
+#include "query/plan/planner.hpp"
+
+#include "query_plan_common.hpp"
+
+using namespace query::plan;
+using query::AstStorage;
+using Direction = query::EdgeAtom::Direction;
+
+namespace {
+
+// Graph with 1000 (:Person {age}) vertices and 5 (:City) vertices, where each
+// person has a single outgoing edge (:Person) -[:LIVES_IN]-> (:City).
+class JoinOrderPlannerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    auto storage_dba = db.Access();
+    query::DbAccessor dba(&storage_dba);
+    age = dba.NameToProperty("age");
+    std::vector<query::VertexAccessor> cities;
+    for (int i = 0; i < 5; ++i) {
+      auto city = dba.InsertVertex();
+      ASSERT_TRUE(city.AddLabel(dba.NameToLabel("City")).HasValue());
+      cities.push_back(city);
+    }
+    for (int i = 0; i < 1000; ++i) {
+      auto person = dba.InsertVertex();
+      ASSERT_TRUE(person.AddLabel(dba.NameToLabel("Person")).HasValue());
+      ASSERT_TRUE(person.SetProperty(age, storage::PropertyValue(i)).HasValue());
+      ASSERT_TRUE(dba.InsertEdge(&person, &cities[i % cities.size()], dba.NameToEdgeType("LIVES_IN")).HasValue());
+    }
+    ASSERT_FALSE(dba.Commit().HasError());
+  }
+
+  // Plans the query with `JoinOrderPlanner` and returns the symbol of the
+  // first scanned node.
+  std::string FirstScannedSymbol(query::CypherQuery *query, AstStorage &storage) {
+    auto storage_dba = db.Access();
+    query::DbAccessor dba(&storage_dba);
+    auto symbol_table = query::MakeSymbolTable(query);
+    auto planning_context = MakePlanningContext(&storage, &symbol_table, query, &dba);
+    auto query_parts = CollectQueryParts(symbol_table, storage, query);
+    auto plan = MakeLogicalPlanForSingleQuery<JoinOrderPlanner>(query_parts.query_parts.at(0).single_query_parts,
+                                                                &planning_context);
+    LogicalOperator *op = plan.get();
+    while (op->HasSingleInput()) {
+      if (auto *scan_all = dynamic_cast<ScanAll *>(op); scan_all && !op->input()->HasSingleInput()) {
+        return scan_all->output_symbol_.name();
+      }
+      op = op->input().get();
+    }
+    return "";
+  }
+
+  storage::Storage db;
+  storage::PropertyId age;
+};
+
+TEST_F(JoinOrderPlannerTest, WithoutStatisticsKeepsOrder) {
+  // MATCH (p :Person) -[:LIVES_IN]-> (c :City) RETURN p
+  AstStorage storage;
+  auto *query = QUERY(SINGLE_QUERY(
+      MATCH(PATTERN(NODE("p", "Person"), EDGE("r", Direction::OUT, {"LIVES_IN"}), NODE("c", "City"))), RETURN("p")));
+  // Without indices and statistics both labels are equally selective.
+  EXPECT_EQ(FirstScannedSymbol(query, storage), "p");
+}
+
+TEST_F(JoinOrderPlannerTest, LabelStatistics) {
+  db.AnalyzeGraph();
+  // MATCH (p :Person) -[:LIVES_IN]-> (c :City) RETURN p
+  AstStorage storage;
+  auto *query = QUERY(SINGLE_QUERY(
+      MATCH(PATTERN(NODE("p", "Person"), EDGE("r", Direction::OUT, {"LIVES_IN"}), NODE("c", "City"))), RETURN("p")));
+  EXPECT_EQ(FirstScannedSymbol(query, storage), "c");
+}
+
+TEST_F(JoinOrderPlannerTest, LabelIndex) {
+  ASSERT_TRUE(db.CreateIndex(db.Access().NameToLabel("Person")));
+  ASSERT_TRUE(db.CreateIndex(db.Access().NameToLabel("City")));
+  // MATCH (p :Person) -[:LIVES_IN]-> (c :City) RETURN p
+  AstStorage storage;
+  auto *query = QUERY(SINGLE_QUERY(
+      MATCH(PATTERN(NODE("p", "Person"), EDGE("r", Direction::OUT, {"LIVES_IN"}), NODE("c", "City"))), RETURN("p")));
+  EXPECT_EQ(FirstScannedSymbol(query, storage), "c");
+}
+
+TEST_F(JoinOrderPlannerTest, PropertyStatistics) {
+  db.AnalyzeGraph();
+  // MATCH (p :Person) -[:LIVES_IN]-> (c :City) WHERE p.age = 42 RETURN p
+  AstStorage storage;
+  auto storage_dba = db.Access();
+  query::DbAccessor dba(&storage_dba);
+  auto *query = QUERY(SINGLE_QUERY(
+      MATCH(PATTERN(NODE("p", "Person"), EDGE("r", Direction::OUT, {"LIVES_IN"}), NODE("c", "City"))),
+      WHERE(EQ(PROPERTY_LOOKUP("p", age), LITERAL(42))), RETURN("p")));
+  EXPECT_EQ(FirstScannedSymbol(query, storage), "p");
+}
+
+TEST_F(JoinOrderPlannerTest, ProducesSameResults) {
+  db.AnalyzeGraph();
+  auto storage_dba = db.Access();
+  query::DbAccessor dba(&storage_dba);
+  // MATCH (p :Person) -[:LIVES_IN]-> (c :City) WHERE p.age < 10 RETURN p
+  AstStorage storage;
+  auto *query = QUERY(SINGLE_QUERY(
+      MATCH(PATTERN(NODE("p", "Person"), EDGE("r", Direction::OUT, {"LIVES_IN"}), NODE("c", "City"))),
+      WHERE(LESS(PROPERTY_LOOKUP("p", age), LITERAL(10))), RETURN("p")));
+  auto symbol_table = query::MakeSymbolTable(query);
+  auto planning_context = MakePlanningContext(&storage, &symbol_table, query, &dba);
+  auto [plan, cost] = MakeLogicalPlan(&planning_context, query::Parameters{}, true);
+  auto *produce = dynamic_cast<Produce *>(plan.get());
+  ASSERT_TRUE(produce);
+  auto context = MakeContext(storage, symbol_table, &dba);
+  EXPECT_EQ(CollectProduce(*produce, &context).size(), 10);
+}
+
+}  // namespace
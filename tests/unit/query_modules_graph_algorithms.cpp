@@ -0,0 +1,300 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <atomic>
+#include <numeric>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "graph_algorithms/algorithms.hpp"
+
+namespace {
+
+constexpr size_t kTasks = 8;
+
+// Executes the tasks on a couple of threads, in an unspecified order.
+void ThreadedFor(size_t task_count, const std::function<void(size_t)> &task) {
+  std::atomic<size_t> next{0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&] {
+      for (auto current = next++; current < task_count; current = next++) task(current);
+    });
+  }
+  for (auto &thread : threads) thread.join();
+}
+
+// Owns the arrays of a graph in the CSR format, with the inbound edges.
+class TestGraph {
+ public:
+  TestGraph(size_t vertex_count, const std::vector<std::pair<uint64_t, uint64_t>> &edges,
+            const std::vector<double> &weights = {})
+      : out_offsets_(vertex_count + 1, 0), in_offsets_(vertex_count + 1, 0) {
+    for (const auto &[from, to] : edges) {
+      ++out_offsets_[from + 1];
+      ++in_offsets_[to + 1];
+    }
+    std::partial_sum(out_offsets_.begin(), out_offsets_.end(), out_offsets_.begin());
+    std::partial_sum(in_offsets_.begin(), in_offsets_.end(), in_offsets_.begin());
+    out_targets_.resize(edges.size());
+    in_sources_.resize(edges.size());
+    if (!weights.empty()) {
+      out_weights_.resize(edges.size());
+      in_weights_.resize(edges.size());
+    }
+    auto out_next = out_offsets_;
+    auto in_next = in_offsets_;
+    for (size_t i = 0; i < edges.size(); ++i) {
+      const auto &[from, to] = edges[i];
+      const auto out_edge = out_next[from]++;
+      const auto in_edge = in_next[to]++;
+      out_targets_[out_edge] = to;
+      in_sources_[in_edge] = from;
+      if (!weights.empty()) {
+        out_weights_[out_edge] = weights[i];
+        in_weights_[in_edge] = weights[i];
+      }
+    }
+    graph_.vertex_count = vertex_count;
+    graph_.out_offsets = out_offsets_.data();
+    graph_.out_targets = out_targets_.data();
+    graph_.out_weights = weights.empty() ? nullptr : out_weights_.data();
+    graph_.in_offsets = in_offsets_.data();
+    graph_.in_sources = in_sources_.data();
+    graph_.in_weights = weights.empty() ? nullptr : in_weights_.data();
+  }
+
+  const graph_algorithms::CsrGraph &operator*() const { return graph_; }
+
+ private:
+  std::vector<uint64_t> out_offsets_;
+  std::vector<uint64_t> out_targets_;
+  std::vector<double> out_weights_;
+  std::vector<uint64_t> in_offsets_;
+  std::vector<uint64_t> in_sources_;
+  std::vector<double> in_weights_;
+  graph_algorithms::CsrGraph graph_;
+};
+
+// Two cliques of 4 vertices, connected by the edge 3 -> 4.
+TestGraph TwoCliques() {
+  std::vector<std::pair<uint64_t, uint64_t>> edges;
+  for (uint64_t offset : {0, 4}) {
+    for (uint64_t i = 0; i < 4; ++i) {
+      for (uint64_t j = i + 1; j < 4; ++j) edges.emplace_back(offset + i, offset + j);
+    }
+  }
+  edges.emplace_back(3, 4);
+  return TestGraph(8, edges);
+}
+
+}  // namespace
+
+TEST(GraphAlgorithms, PartitionVertices) {
+  // The vertex 1 has most of the edges, so it gets a range of its own.
+  const TestGraph graph(6, {{0, 1}, {1, 0}, {1, 2}, {1, 3}, {1, 4}, {1, 5}, {1, 1}, {1, 2}, {1, 3}, {5, 0}});
+  const auto bounds = graph_algorithms::PartitionVertices((*graph).out_offsets, 6, 4);
+  ASSERT_GE(bounds.size(), 2);
+  EXPECT_EQ(bounds.front(), 0);
+  EXPECT_EQ(bounds.back(), 6);
+  EXPECT_TRUE(std::is_sorted(bounds.begin(), bounds.end()));
+  EXPECT_EQ(std::adjacent_find(bounds.begin(), bounds.end()), bounds.end());
+  EXPECT_NE(std::find(bounds.begin(), bounds.end(), 2), bounds.end());
+
+  EXPECT_EQ(graph_algorithms::PartitionVertices((*graph).out_offsets, 0, 4), std::vector<uint64_t>{0});
+  EXPECT_EQ(graph_algorithms::PartitionVertices((*graph).out_offsets, 6, 1), (std::vector<uint64_t>{0, 6}));
+}
+
+TEST(GraphAlgorithms, PageRank) {
+  {
+    const TestGraph cycle(3, {{0, 1}, {1, 2}, {2, 0}});
+    const auto ranks = graph_algorithms::PageRank(*cycle, {}, ThreadedFor, kTasks);
+    ASSERT_EQ(ranks.size(), 3);
+    for (const auto rank : ranks) EXPECT_NEAR(rank, 1.0 / 3, 1e-6);
+  }
+  {
+    // The vertex 0 gets the rank of all the others, and its own rank is
+    // spread to all of the vertices, since it has no outbound edges.
+    const TestGraph star(5, {{1, 0}, {2, 0}, {3, 0}, {4, 0}});
+    graph_algorithms::PageRankConfig config;
+    config.tolerance = 1e-9;
+    const auto ranks = graph_algorithms::PageRank(*star, config, ThreadedFor, kTasks);
+    EXPECT_NEAR(std::accumulate(ranks.begin(), ranks.end(), 0.0), 1.0, 1e-6);
+    for (size_t i = 1; i < 5; ++i) {
+      EXPECT_GT(ranks[0], ranks[i]);
+      EXPECT_NEAR(ranks[i], ranks[1], 1e-9);
+    }
+    EXPECT_EQ(ranks, graph_algorithms::PageRank(*star, config, graph_algorithms::SequentialFor, 1));
+  }
+  EXPECT_TRUE(graph_algorithms::PageRank(*TestGraph(0, {}), {}, ThreadedFor, kTasks).empty());
+}
+
+TEST(GraphAlgorithms, WeaklyConnectedComponents) {
+  const TestGraph graph(7, {{1, 0}, {2, 1}, {4, 3}, {5, 4}, {3, 5}, {2, 2}});
+  const auto components = graph_algorithms::WeaklyConnectedComponents(*graph, ThreadedFor, kTasks);
+  EXPECT_EQ(components, (std::vector<uint64_t>{0, 0, 0, 3, 3, 3, 6}));
+}
+
+TEST(GraphAlgorithms, StronglyConnectedComponents) {
+  // The cycle 0 -> 1 -> 2 -> 0 leads to the cycle 3 <-> 4, and 5 leads to 0.
+  const TestGraph graph(6, {{0, 1}, {1, 2}, {2, 0}, {2, 3}, {3, 4}, {4, 3}, {5, 0}});
+  const auto components = graph_algorithms::StronglyConnectedComponents(*graph);
+  ASSERT_EQ(components.size(), 6);
+  EXPECT_EQ(components[0], components[1]);
+  EXPECT_EQ(components[0], components[2]);
+  EXPECT_EQ(components[3], components[4]);
+  EXPECT_NE(components[0], components[3]);
+  EXPECT_NE(components[0], components[5]);
+  // The components are numbered in the reverse topological order.
+  EXPECT_LT(components[3], components[0]);
+  EXPECT_LT(components[0], components[5]);
+}
+
+TEST(GraphAlgorithms, LabelPropagation) {
+  const auto graph = TwoCliques();
+  const auto labels = graph_algorithms::LabelPropagation(*graph, {}, ThreadedFor, kTasks);
+  EXPECT_EQ(labels, (std::vector<uint64_t>{0, 0, 0, 0, 4, 4, 4, 4}));
+
+  // Two vertices don't keep swapping their labels.
+  const TestGraph pair(2, {{0, 1}});
+  EXPECT_EQ(graph_algorithms::LabelPropagation(*pair, {}, ThreadedFor, kTasks), (std::vector<uint64_t>{0, 0}));
+
+  // The heavy edge pulls the vertex 1 to the vertex 2.
+  const TestGraph weighted(3, {{0, 1}, {1, 2}}, {1.0, 5.0});
+  graph_algorithms::LabelPropagationConfig config;
+  config.max_iterations = 1;
+  EXPECT_EQ(graph_algorithms::LabelPropagation(*weighted, config, ThreadedFor, kTasks)[1], 2);
+}
+
+TEST(GraphAlgorithms, BetweennessCentrality) {
+  const TestGraph path(3, {{0, 1}, {1, 2}});
+  EXPECT_EQ(graph_algorithms::BetweennessCentrality(*path, {}, ThreadedFor, kTasks),
+            (std::vector<double>{0, 1, 0}));
+  graph_algorithms::BetweennessConfig undirected;
+  undirected.directed = false;
+  EXPECT_EQ(graph_algorithms::BetweennessCentrality(*path, undirected, ThreadedFor, kTasks),
+            (std::vector<double>{0, 1, 0}));
+
+  // The two shortest paths from 0 to 3 split the centrality.
+  const TestGraph diamond(4, {{0, 1}, {0, 2}, {1, 3}, {2, 3}});
+  EXPECT_EQ(graph_algorithms::BetweennessCentrality(*diamond, {}, ThreadedFor, kTasks),
+            (std::vector<double>{0, 0.5, 0.5, 0}));
+
+  // Sampling all of the vertices is exact, and sampling fewer is scaled.
+  const auto graph = TwoCliques();
+  graph_algorithms::BetweennessConfig config;
+  const auto exact = graph_algorithms::BetweennessCentrality(*graph, config, ThreadedFor, kTasks);
+  config.samples = 8;
+  EXPECT_EQ(graph_algorithms::BetweennessCentrality(*graph, config, ThreadedFor, kTasks), exact);
+  config.samples = 4;
+  const auto sampled = graph_algorithms::BetweennessCentrality(*graph, config, ThreadedFor, kTasks);
+  EXPECT_EQ(sampled, graph_algorithms::BetweennessCentrality(*graph, config, graph_algorithms::SequentialFor, 1));
+  EXPECT_EQ(sampled[0], 0);
+}
+
+TEST(GraphAlgorithms, TriangleCount) {
+  // The duplicate edges, the edges in the other direction and the self loops
+  // don't make more triangles.
+  const TestGraph graph(6, {{0, 1}, {1, 2}, {2, 0}, {0, 2}, {0, 1}, {1, 1}, {2, 3}, {3, 0}, {3, 4}, {4, 5}});
+  EXPECT_EQ(graph_algorithms::TriangleCount(*graph, ThreadedFor, kTasks), (std::vector<uint64_t>{2, 1, 2, 1, 0, 0}));
+
+  const auto cliques = TwoCliques();
+  EXPECT_EQ(graph_algorithms::TriangleCount(*cliques, ThreadedFor, kTasks),
+            (std::vector<uint64_t>{3, 3, 3, 3, 3, 3, 3, 3}));
+}
+
+TEST(GraphAlgorithms, MakeUndirected) {
+  const TestGraph graph(3, {{0, 1}, {1, 0}, {1, 1}, {2, 1}, {0, 1}});
+  const auto undirected = graph_algorithms::MakeUndirected(*graph, ThreadedFor, kTasks);
+  EXPECT_EQ(undirected.offsets, (std::vector<uint64_t>{0, 1, 3, 4}));
+  EXPECT_EQ(undirected.neighbours, (std::vector<uint64_t>{1, 0, 2, 1}));
+}
+
+TEST(GraphAlgorithms, IncrementalComponents) {
+  graph_algorithms::IncrementalComponents components;
+  // The vertices 10, 11 and 12 are connected, and 13 is alone.
+  const std::vector<int64_t> vertex_ids{12, 10, 11, 13};
+  const TestGraph graph(4, {{0, 1}, {2, 1}});
+  const auto wcc = graph_algorithms::WeaklyConnectedComponents(*graph, ThreadedFor, kTasks);
+  components.Assign(*graph, vertex_ids.data(), wcc.data());
+  EXPECT_EQ(components.VertexCount(), 4);
+  EXPECT_EQ(components.ComponentCount(), 2);
+  EXPECT_EQ(components.ComponentOf(12), 10);
+  EXPECT_EQ(components.ComponentOf(13), 13);
+  EXPECT_FALSE(components.ComponentOf(14));
+
+  // The new edges merge the components, and the smallest ID labels them.
+  components.AddVertex(5);
+  components.AddEdge(13, 5);
+  EXPECT_EQ(components.ComponentOf(13), 5);
+  components.AddEdge(11, 5);
+  EXPECT_EQ(components.ComponentCount(), 1);
+  for (const int64_t vertex : {5, 10, 11, 12, 13}) EXPECT_EQ(components.ComponentOf(vertex), 5);
+  components.AddEdge(12, 10);
+  EXPECT_EQ(components.ComponentCount(), 1);
+
+  // The loops don't connect anything.
+  components.AddEdge(20, 20);
+  EXPECT_EQ(components.ComponentOf(20), 20);
+  components.RemoveVertex(20);
+  EXPECT_FALSE(components.ComponentOf(20));
+  components.RemoveVertex(20);
+  EXPECT_EQ(components.VertexCount(), 5);
+}
+
+TEST(GraphAlgorithms, IncrementalComponentsRemoveEdges) {
+  graph_algorithms::IncrementalComponents components;
+  // 1 - 2 - 3 - 4 with two edges between 1 and 2, and 3 - 5.
+  const std::vector<int64_t> vertex_ids{1, 2, 3, 4, 5};
+  const TestGraph graph(5, {{0, 1}, {1, 0}, {1, 2}, {2, 3}, {2, 4}});
+  const auto wcc = graph_algorithms::WeaklyConnectedComponents(*graph, ThreadedFor, kTasks);
+  components.Assign(*graph, vertex_ids.data(), wcc.data());
+  ASSERT_EQ(components.ComponentCount(), 1);
+
+  // One of the parallel edges is left.
+  components.RemoveEdge(2, 1);
+  EXPECT_EQ(components.ComponentCount(), 1);
+  EXPECT_EQ(components.ComponentOf(1), 1);
+
+  // The edge which closes a cycle doesn't split the component.
+  components.AddEdge(4, 5);
+  components.RemoveEdge(3, 4);
+  EXPECT_EQ(components.ComponentCount(), 1);
+  EXPECT_EQ(components.ComponentOf(4), 1);
+
+  // The part without the smallest ID gets a new label.
+  components.RemoveEdge(2, 3);
+  EXPECT_EQ(components.ComponentCount(), 2);
+  EXPECT_EQ(components.ComponentOf(2), 1);
+  for (const int64_t vertex : {3, 4, 5}) EXPECT_EQ(components.ComponentOf(vertex), 3);
+
+  // The part with the smallest ID is split off.
+  components.RemoveEdge(1, 2);
+  EXPECT_EQ(components.ComponentCount(), 3);
+  EXPECT_EQ(components.ComponentOf(1), 1);
+  EXPECT_EQ(components.ComponentOf(2), 2);
+
+  // The edges which aren't added are ignored.
+  components.RemoveEdge(1, 2);
+  components.RemoveEdge(7, 8);
+  EXPECT_EQ(components.ComponentCount(), 3);
+
+  // Removing a vertex removes its edges too.
+  components.RemoveVertex(5);
+  EXPECT_EQ(components.ComponentCount(), 4);
+  EXPECT_EQ(components.ComponentOf(3), 3);
+  EXPECT_EQ(components.ComponentOf(4), 4);
+  EXPECT_FALSE(components.ComponentOf(5));
+  EXPECT_EQ(components.VertexCount(), 4);
+}
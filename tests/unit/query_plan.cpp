@@ -420,6 +420,40 @@ TYPED_TEST(TestPlanner, MatchReturnSum) {
   CheckPlan(planner.plan(), symbol_table, ExpectScanAll(), aggr, ExpectProduce());
 }
 
+TYPED_TEST(TestPlanner, MatchExpandReturnCountGroupedInput) {
+  // Test MATCH (n) -[r]-> (m) RETURN n, COUNT(m) AS c
+  FakeDbAccessor dba;
+  AstStorage storage;
+  auto ident_n = IDENT("n");
+  auto count = COUNT(IDENT("m"));
+  auto *query = QUERY(SINGLE_QUERY(MATCH(PATTERN(NODE("n"), EDGE("r", Direction::OUT), NODE("m"))),
+                                   RETURN(ident_n, AS("n"), count, AS("c"))));
+  auto symbol_table = query::MakeSymbolTable(query);
+  auto planner = MakePlanner<TypeParam>(&dba, storage, symbol_table, query);
+  CheckPlan(planner.plan(), symbol_table, ExpectScanAll(), ExpectExpand(), ExpectAggregate({count}, {ident_n}),
+            ExpectProduce());
+  // The rows of each scanned vertex come consecutively from Expand.
+  auto &aggregate = dynamic_cast<Aggregate &>(*planner.plan().input());
+  EXPECT_TRUE(aggregate.grouped_input_);
+}
+
+TYPED_TEST(TestPlanner, MatchExpandReturnCountNotGroupedInput) {
+  // Test MATCH (n) -[r]-> (m) RETURN m, COUNT(n) AS c
+  FakeDbAccessor dba;
+  AstStorage storage;
+  auto ident_m = IDENT("m");
+  auto count = COUNT(IDENT("n"));
+  auto *query = QUERY(SINGLE_QUERY(MATCH(PATTERN(NODE("n"), EDGE("r", Direction::OUT), NODE("m"))),
+                                   RETURN(ident_m, AS("m"), count, AS("c"))));
+  auto symbol_table = query::MakeSymbolTable(query);
+  auto planner = MakePlanner<TypeParam>(&dba, storage, symbol_table, query);
+  CheckPlan(planner.plan(), symbol_table, ExpectScanAll(), ExpectExpand(), ExpectAggregate({count}, {ident_m}),
+            ExpectProduce());
+  // The expanded vertices may repeat in any order.
+  auto &aggregate = dynamic_cast<Aggregate &>(*planner.plan().input());
+  EXPECT_FALSE(aggregate.grouped_input_);
+}
+
 TYPED_TEST(TestPlanner, CreateWithSum) {
   // Test CREATE (n) WITH SUM(n.prop) AS sum
   FakeDbAccessor dba;
@@ -1320,6 +1354,43 @@ TYPED_TEST(TestPlanner, FilterRegexMatchIndex) {
             ExpectFilter(), ExpectProduce());
 }
 
+TYPED_TEST(TestPlanner, OrderByIndexRange) {
+  // Test MATCH (n :label) WHERE n.prop > 42 RETURN n.prop AS p ORDER BY p LIMIT 10
+  AstStorage storage;
+  FakeDbAccessor dba;
+  auto prop = dba.Property("prop");
+  auto label = dba.Label("label");
+  dba.SetIndexCount(label, prop, 0);
+  auto *query = QUERY(SINGLE_QUERY(
+      MATCH(PATTERN(NODE("n", "label"))), WHERE(GREATER(PROPERTY_LOOKUP("n", prop), LITERAL(42))),
+      RETURN(PROPERTY_LOOKUP("n", prop), AS("p"), ORDER_BY(IDENT("p")), LIMIT(LITERAL(10)))));
+  // The index already produces the vertices sorted by the property, so there
+  // is no need for OrderBy.
+  Bound lower_bound(LITERAL(42), Bound::Type::EXCLUSIVE);
+  auto symbol_table = query::MakeSymbolTable(query);
+  auto planner = MakePlanner<TypeParam>(&dba, storage, symbol_table, query);
+  CheckPlan(planner.plan(), symbol_table, ExpectScanAllByLabelPropertyRange(label, prop, lower_bound, std::nullopt),
+            ExpectProduce(), ExpectLimit());
+}
+
+TYPED_TEST(TestPlanner, OrderByDescendingIndexRange) {
+  // Test MATCH (n :label) WHERE n.prop > 42 RETURN n ORDER BY n.prop DESC LIMIT 10
+  AstStorage storage;
+  FakeDbAccessor dba;
+  auto prop = dba.Property("prop");
+  auto label = dba.Label("label");
+  dba.SetIndexCount(label, prop, 0);
+  auto *query = QUERY(SINGLE_QUERY(
+      MATCH(PATTERN(NODE("n", "label"))), WHERE(GREATER(PROPERTY_LOOKUP("n", prop), LITERAL(42))),
+      RETURN("n", ORDER_BY(PROPERTY_LOOKUP("n", prop), query::Ordering::DESC), LIMIT(LITERAL(10)))));
+  // The index is only iterated in ascending order.
+  Bound lower_bound(LITERAL(42), Bound::Type::EXCLUSIVE);
+  auto symbol_table = query::MakeSymbolTable(query);
+  auto planner = MakePlanner<TypeParam>(&dba, storage, symbol_table, query);
+  CheckPlan(planner.plan(), symbol_table, ExpectScanAllByLabelPropertyRange(label, prop, lower_bound, std::nullopt),
+            ExpectProduce(), ExpectOrderBy(), ExpectLimit());
+}
+
 TYPED_TEST(TestPlanner, FilterRegexMatchPreferEqualityIndex) {
   // Test MATCH (n :label) WHERE n.prop =~ "regex" AND n.prop = 42 RETURN n
   AstStorage storage;
@@ -10,8 +10,10 @@
 // licenses/APL.txt.
 
 #include <algorithm>
+#include <filesystem>
 #include <iterator>
 #include <memory>
+#include <set>
 #include <vector>
 
 #include "gmock/gmock.h"
@@ -368,6 +370,81 @@ TEST(QueryPlan, AggregateMultipleGroupBy) {
   EXPECT_EQ(results.size(), 2 * 3 * 5);
 }
 
+TEST(QueryPlan, AggregateSpill) {
+  storage::Storage db;
+  auto storage_dba = db.Access();
+  query::DbAccessor dba(&storage_dba);
+
+  auto group = dba.NameToProperty("group");
+  auto value = dba.NameToProperty("value");
+  const int kGroups = 50;
+  for (int i = 0; i < 1000; ++i) {
+    auto v = dba.InsertVertex();
+    ASSERT_TRUE(v.SetProperty(group, storage::PropertyValue(i % kGroups)).HasValue());
+    ASSERT_TRUE(v.SetProperty(value, storage::PropertyValue(i)).HasValue());
+  }
+  dba.AdvanceCommand();
+
+  AstStorage storage;
+  SymbolTable symbol_table;
+  auto n = MakeScanAll(storage, symbol_table, "n");
+  auto n_group = PROPERTY_LOOKUP(IDENT("n")->MapTo(n.sym_), group);
+  auto n_value = PROPERTY_LOOKUP(IDENT("n")->MapTo(n.sym_), value);
+  auto produce =
+      MakeAggregationProduce(n.op_, symbol_table, storage, {n_value, n_value, n_value},
+                             {Aggregation::Op::COUNT, Aggregation::Op::SUM, Aggregation::Op::AVG}, {n_group}, {});
+  auto context = MakeContext(storage, symbol_table, &dba);
+  const auto spill_directory = std::filesystem::temp_directory_path() / "MG_tests_unit_query_plan_aggregate_spill";
+  context.spill.directory = spill_directory;
+  // Only a single group fits in memory in each pass.
+  context.spill.threshold = 1;
+  auto results = CollectProduce(*produce, &context);
+  ASSERT_EQ(results.size(), kGroups);
+  std::set<int64_t> result_groups;
+  for (const auto &row : results) {
+    ASSERT_EQ(row.size(), 4);
+    const auto group_value = row[3].ValueInt();
+    result_groups.insert(group_value);
+    EXPECT_EQ(row[0].ValueInt(), 1000 / kGroups);
+    // The values of a group are group_value + k * kGroups, for k < 20.
+    EXPECT_EQ(row[1].ValueInt(), 20 * group_value + kGroups * 190);
+    EXPECT_DOUBLE_EQ(row[2].ValueDouble(), group_value + kGroups * 9.5);
+  }
+  EXPECT_EQ(result_groups.size(), kGroups);
+  EXPECT_TRUE(std::filesystem::is_empty(spill_directory));
+  std::filesystem::remove_all(spill_directory);
+}
+
+TEST(QueryPlan, AggregateGroupedInput) {
+  // UNWIND [1, 1, 2, 3, 3, 3] AS x RETURN x, COUNT(x), AVG(x)
+  storage::Storage db;
+  auto storage_dba = db.Access();
+  query::DbAccessor dba(&storage_dba);
+  AstStorage storage;
+  SymbolTable symbol_table;
+
+  std::vector<TypedValue> input{TypedValue(1), TypedValue(1), TypedValue(2),
+                                TypedValue(3), TypedValue(3), TypedValue(3)};
+  auto x = symbol_table.CreateSymbol("x", true);
+  auto unwind = std::make_shared<plan::Unwind>(nullptr, LITERAL(TypedValue(input)), x);
+  auto x_expr = IDENT("x")->MapTo(x);
+  auto produce = MakeAggregationProduce(unwind, symbol_table, storage, {x_expr, x_expr},
+                                        {Aggregation::Op::COUNT, Aggregation::Op::AVG}, {x_expr}, {});
+  // The input comes sorted, so the groups are emitted as they are completed.
+  auto &aggregate = dynamic_cast<Aggregate &>(*produce->input());
+  aggregate.grouped_input_ = true;
+  auto context = MakeContext(storage, symbol_table, &dba);
+  auto results = CollectProduce(*produce, &context);
+  ASSERT_EQ(results.size(), 3);
+  const std::vector<int64_t> counts{2, 1, 3};
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_EQ(results[i].size(), 3);
+    EXPECT_EQ(results[i][0].ValueInt(), counts[i]);
+    EXPECT_DOUBLE_EQ(results[i][1].ValueDouble(), i + 1);
+    EXPECT_EQ(results[i][2].ValueInt(), i + 1);
+  }
+}
+
 TEST(QueryPlan, AggregateNoInput) {
   storage::Storage db;
   auto storage_dba = db.Access();
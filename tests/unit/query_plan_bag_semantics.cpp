@@ -15,8 +15,10 @@
 //
 
 #include <algorithm>
+#include <filesystem>
 #include <iterator>
 #include <memory>
+#include <numeric>
 #include <vector>
 
 #include "gmock/gmock.h"
@@ -242,6 +244,89 @@ TEST(QueryPlan, OrderByMultiple) {
   }
 }
 
+TEST(QueryPlan, OrderByTopK) {
+  storage::Storage db;
+  auto storage_dba = db.Access();
+  query::DbAccessor dba(&storage_dba);
+  AstStorage storage;
+  SymbolTable symbol_table;
+
+  auto prop = dba.NameToProperty("prop");
+  const int N = 100;
+  std::vector<int> values(N);
+  std::iota(values.begin(), values.end(), 0);
+  std::random_shuffle(values.begin(), values.end());
+  for (const auto value : values) {
+    ASSERT_TRUE(dba.InsertVertex().SetProperty(prop, storage::PropertyValue(value)).HasValue());
+  }
+  // A vertex without the property is ordered last.
+  dba.InsertVertex();
+  dba.AdvanceCommand();
+
+  auto check = [&](Ordering ordering, Expression *skip, Expression *limit, const std::vector<TypedValue> &expected) {
+    auto n = MakeScanAll(storage, symbol_table, "n");
+    auto n_p = PROPERTY_LOOKUP(IDENT("n")->MapTo(n.sym_), prop);
+    auto order_by = std::make_shared<plan::OrderBy>(n.op_, std::vector<SortItem>{{ordering, n_p}},
+                                                    std::vector<Symbol>{n.sym_}, skip, limit);
+    auto n_p_ne = NEXPR("n.p", n_p)->MapTo(symbol_table.CreateSymbol("n.p", true));
+    auto produce = MakeProduce(order_by, n_p_ne);
+    auto context = MakeContext(storage, symbol_table, &dba);
+    auto results = CollectProduce(*produce, &context);
+    ASSERT_EQ(results.size(), expected.size());
+    for (size_t i = 0; i < results.size(); ++i) EXPECT_TRUE(TypedValue::BoolEqual{}(results[i][0], expected[i]));
+  };
+
+  // Only the first skip + limit rows are produced, in order.
+  check(Ordering::ASC, nullptr, LITERAL(3), {TypedValue(0), TypedValue(1), TypedValue(2)});
+  check(Ordering::DESC, nullptr, LITERAL(3), {TypedValue(), TypedValue(99), TypedValue(98)});
+  check(Ordering::ASC, LITERAL(2), LITERAL(2), {TypedValue(0), TypedValue(1), TypedValue(2), TypedValue(3)});
+  check(Ordering::ASC, nullptr, LITERAL(0), {});
+  // A limit larger than the input sorts all of the rows.
+  std::vector<TypedValue> all_values;
+  for (int i = 0; i < N; ++i) all_values.emplace_back(i);
+  all_values.emplace_back();
+  check(Ordering::ASC, nullptr, LITERAL(1000), all_values);
+  // Invalid values are reported by Skip and Limit, so all of the rows are sorted.
+  check(Ordering::ASC, nullptr, LITERAL(-1), all_values);
+}
+
+TEST(QueryPlan, OrderBySpill) {
+  storage::Storage db;
+  auto storage_dba = db.Access();
+  query::DbAccessor dba(&storage_dba);
+  AstStorage storage;
+  SymbolTable symbol_table;
+
+  auto prop = dba.NameToProperty("prop");
+  // Enough rows for the sorted runs to be merged in multiple passes.
+  const int N = 200;
+  std::vector<int> values(N);
+  std::iota(values.begin(), values.end(), 0);
+  std::random_shuffle(values.begin(), values.end());
+  for (const auto value : values) {
+    ASSERT_TRUE(dba.InsertVertex().SetProperty(prop, storage::PropertyValue(value)).HasValue());
+  }
+  dba.AdvanceCommand();
+
+  auto n = MakeScanAll(storage, symbol_table, "n");
+  auto n_p = PROPERTY_LOOKUP(IDENT("n")->MapTo(n.sym_), prop);
+  auto order_by =
+      std::make_shared<plan::OrderBy>(n.op_, std::vector<SortItem>{{Ordering::DESC, n_p}}, std::vector<Symbol>{n.sym_});
+  auto n_p_ne = NEXPR("n.p", n_p)->MapTo(symbol_table.CreateSymbol("n.p", true));
+  auto produce = MakeProduce(order_by, n_p_ne);
+  auto context = MakeContext(storage, symbol_table, &dba);
+  const auto spill_directory = std::filesystem::temp_directory_path() / "MG_tests_unit_query_plan_order_by_spill";
+  context.spill.directory = spill_directory;
+  // Each row is written to disk as soon as it is cached.
+  context.spill.threshold = 1;
+  auto results = CollectProduce(*produce, &context);
+  ASSERT_EQ(results.size(), N);
+  for (int i = 0; i < N; ++i) EXPECT_EQ(results[i][0].ValueInt(), N - 1 - i);
+  // The temporary files are deleted once they are merged.
+  EXPECT_TRUE(std::filesystem::is_empty(spill_directory));
+  std::filesystem::remove_all(spill_directory);
+}
+
 TEST(QueryPlan, OrderByExceptions) {
   storage::Storage db;
   auto storage_dba = db.Access();
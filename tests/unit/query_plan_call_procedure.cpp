@@ -0,0 +1,214 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <algorithm>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "mg_procedure.h"
+#include "query/context.hpp"
+#include "query/exceptions.hpp"
+#include "query/plan/operator.hpp"
+#include "query/procedure/cypher_types.hpp"
+#include "query/procedure/mg_procedure_impl.hpp"
+#include "query/procedure/module.hpp"
+
+#include "query_plan_common.hpp"
+
+namespace {
+
+constexpr int64_t kRows = 2500;
+
+// Counters of the callbacks of the batched procedure.
+int inits{0};
+int batches{0};
+int cleanups{0};
+size_t last_row_budget{0};
+// Number of bytes the procedure allocates for its state.
+size_t state_size{sizeof(int64_t)};
+
+void InitNumbers(mgp_list * /*args*/, mgp_graph * /*graph*/, mgp_result *result, mgp_memory *memory, void **state) {
+  ++inits;
+  void *allocation{nullptr};
+  if (mgp_alloc(memory, std::max(state_size, sizeof(int64_t)), &allocation) != MGP_ERROR_NO_ERROR) {
+    static_cast<void>(mgp_result_set_error_msg(result, "Unable to allocate the state."));
+    return;
+  }
+  *static_cast<int64_t *>(allocation) = 0;
+  *state = allocation;
+}
+
+// Yields the numbers from 0 to kRows - 1, continuing from the state.
+void Numbers(mgp_list * /*args*/, mgp_graph * /*graph*/, mgp_result *result, mgp_memory *memory, size_t row_budget,
+             void *state) {
+  ++batches;
+  last_row_budget = row_budget;
+  auto &next = *static_cast<int64_t *>(state);
+  for (size_t i = 0; i < row_budget && next < kRows; ++i, ++next) {
+    mgp_result_record *record{nullptr};
+    ASSERT_EQ(mgp_result_new_record(result, &record), MGP_ERROR_NO_ERROR);
+    mgp_value *value{nullptr};
+    ASSERT_EQ(mgp_value_make_int(next, memory, &value), MGP_ERROR_NO_ERROR);
+    EXPECT_EQ(mgp_result_record_insert(record, "n", value), MGP_ERROR_NO_ERROR);
+    mgp_value_destroy(value);
+  }
+}
+
+void CleanupNumbers(void *state, mgp_memory *memory) {
+  ++cleanups;
+  if (state) mgp_free(memory, state);
+}
+
+class MockModule : public query::procedure::Module {
+ public:
+  MockModule() = default;
+  ~MockModule() override = default;
+  MockModule(const MockModule &) = delete;
+  MockModule(MockModule &&) = delete;
+  MockModule &operator=(const MockModule &) = delete;
+  MockModule &operator=(MockModule &&) = delete;
+
+  bool Close() override { return true; }
+
+  const std::map<std::string, mgp_proc, std::less<>> *Procedures() const override { return &procedures; }
+  const std::map<std::string, mgp_trans, std::less<>> *Transformations() const override { return &transformations; }
+  const std::map<std::string, mgp_change_hook, std::less<>> *ChangeHooks() const override { return &change_hooks; }
+  std::optional<std::filesystem::path> Path() const override { return std::nullopt; }
+
+  std::map<std::string, mgp_proc, std::less<>> procedures{};
+  std::map<std::string, mgp_trans, std::less<>> transformations{};
+  std::map<std::string, mgp_change_hook, std::less<>> change_hooks{};
+};
+
+}  // namespace
+
+class CallProcedureBatchTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    inits = 0;
+    batches = 0;
+    cleanups = 0;
+    state_size = sizeof(int64_t);
+    RegisterBatchModule();
+  }
+
+  void TearDown() override { query::procedure::gModuleRegistry.UnloadAllModules(); }
+
+  // Registers the module with the batched procedure, which is also how a
+  // reload registers it again.
+  static void RegisterBatchModule() {
+    auto module = std::make_unique<MockModule>();
+    auto *memory = utils::NewDeleteResource();
+    mgp_proc proc("numbers", static_cast<mgp_proc_cb>(nullptr), memory, {.is_write = false});
+    proc.results.emplace(utils::pmr::string("n", memory), std::make_pair(&any_type, false));
+    proc.batch.emplace(BatchProcedure{Numbers, InitNumbers, CleanupNumbers});
+    module->procedures.emplace("numbers", std::move(proc));
+    query::procedure::gModuleRegistry.RegisterModule("batch_module", std::move(module));
+  }
+
+  static void ReloadBatchModule() {
+    query::procedure::gModuleRegistry.UnloadAllModules();
+    RegisterBatchModule();
+  }
+
+  std::shared_ptr<CallProcedure> MakeCall(Expression *memory_limit = nullptr) {
+    return std::make_shared<CallProcedure>(std::make_shared<Once>(), "batch_module.numbers",
+                                           std::vector<Expression *>{}, std::vector<std::string>{"n"},
+                                           std::vector<Symbol>{n_symbol}, memory_limit, 1024U, false);
+  }
+
+  static const query::procedure::AnyType any_type;
+
+  storage::Storage db;
+  storage::Storage::Accessor storage_dba{db.Access()};
+  query::DbAccessor dba{&storage_dba};
+  AstStorage storage;
+  SymbolTable symbol_table;
+  Symbol n_symbol{symbol_table.CreateSymbol("n", true)};
+};
+
+const query::procedure::AnyType CallProcedureBatchTest::any_type{};
+
+TEST_F(CallProcedureBatchTest, PullsAllBatches) {
+  auto call = MakeCall();
+  auto context = MakeContext(storage, symbol_table, &dba);
+  Frame frame(symbol_table.max_position());
+  auto cursor = call->MakeCursor(utils::NewDeleteResource());
+  for (int64_t i = 0; i < kRows; ++i) {
+    ASSERT_TRUE(cursor->Pull(frame, context));
+    ASSERT_EQ(frame[n_symbol].ValueInt(), i);
+    // The next batch is produced only after the previous one was pulled.
+    ASSERT_EQ(batches, i / static_cast<int64_t>(last_row_budget) + 1);
+  }
+  EXPECT_FALSE(cursor->Pull(frame, context));
+  EXPECT_EQ(inits, 1);
+  // The last invocation adds no records, which ends the call.
+  const auto budget = static_cast<int64_t>(last_row_budget);
+  EXPECT_EQ(batches, (kRows + budget - 1) / budget + 1);
+  EXPECT_EQ(cleanups, 1);
+}
+
+TEST_F(CallProcedureBatchTest, LimitCleansUpTheCall) {
+  auto limit = std::make_shared<Limit>(MakeCall(), LITERAL(10));
+  auto context = MakeContext(storage, symbol_table, &dba);
+  EXPECT_EQ(PullAll(*limit, &context), 10);
+  EXPECT_EQ(inits, 1);
+  EXPECT_EQ(batches, 1);
+  EXPECT_EQ(cleanups, 1);
+}
+
+TEST_F(CallProcedureBatchTest, ReloadFailsTheCall) {
+  auto call = MakeCall();
+  auto context = MakeContext(storage, symbol_table, &dba);
+  Frame frame(symbol_table.max_position());
+  auto cursor = call->MakeCursor(utils::NewDeleteResource());
+  ASSERT_TRUE(cursor->Pull(frame, context));
+  ReloadBatchModule();
+  // The rows of the batch pulled before the reload are still returned.
+  EXPECT_THROW(
+      {
+        while (cursor->Pull(frame, context)) {
+        }
+      },
+      QueryRuntimeException);
+  EXPECT_EQ(batches, 1);
+  cursor.reset();
+  // The cleanup of the reloaded module isn't called with the state of the
+  // previous one.
+  EXPECT_EQ(cleanups, 0);
+
+  // A call started after the reload isn't affected by it.
+  auto context_after_reload = MakeContext(storage, symbol_table, &dba);
+  EXPECT_EQ(PullAll(*call, &context_after_reload), kRows);
+  EXPECT_EQ(cleanups, 1);
+}
+
+TEST_F(CallProcedureBatchTest, InitMemoryIsLimited) {
+  state_size = 1024 * 1024;
+  // The limit is 1 KiB.
+  auto call = MakeCall(LITERAL(1));
+  auto context = MakeContext(storage, symbol_table, &dba);
+  EXPECT_THROW(PullAll(*call, &context), QueryRuntimeException);
+  EXPECT_EQ(inits, 1);
+  EXPECT_EQ(batches, 0);
+  EXPECT_EQ(cleanups, 1);
+
+  // Without the limit the state can be allocated.
+  auto unlimited_call = MakeCall();
+  EXPECT_EQ(PullAll(*unlimited_call, &context), kRows);
+  EXPECT_EQ(cleanups, 2);
+}
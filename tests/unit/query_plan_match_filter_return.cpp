@@ -9,6 +9,7 @@
 // by the Apache License, Version 2.0, included in the file
 // licenses/APL.txt.
 
+#include <filesystem>
 #include <iterator>
 #include <memory>
 #include <optional>
@@ -1619,6 +1620,35 @@ TEST(QueryPlan, Distinct) {
       {TypedValue(3), TypedValue("two"), TypedValue(), TypedValue(true), TypedValue(false), TypedValue("TWO")}, false);
 }
 
+TEST(QueryPlan, DistinctSpill) {
+  // UNWIND range(0, 299) AS i WITH i * 37 % 100 AS x RETURN DISTINCT x
+  storage::Storage db;
+  auto storage_dba = db.Access();
+  query::DbAccessor dba(&storage_dba);
+  AstStorage storage;
+  SymbolTable symbol_table;
+
+  std::vector<TypedValue> input;
+  for (int i = 0; i < 300; ++i) input.emplace_back(i * 37 % 100);
+  auto x = symbol_table.CreateSymbol("x", true);
+  auto unwind = std::make_shared<plan::Unwind>(nullptr, LITERAL(TypedValue(input)), x);
+  auto distinct = std::make_shared<plan::Distinct>(unwind, std::vector<Symbol>{x});
+  auto x_ne = NEXPR("x", IDENT("x")->MapTo(x))->MapTo(symbol_table.CreateSymbol("x_ne", true));
+  auto produce = MakeProduce(distinct, x_ne);
+  auto context = MakeContext(storage, symbol_table, &dba);
+  const auto spill_directory = std::filesystem::temp_directory_path() / "MG_tests_unit_query_plan_distinct_spill";
+  context.spill.directory = spill_directory;
+  // Only a single row fits in memory in each pass.
+  context.spill.threshold = 1;
+  auto results = CollectProduce(*produce, &context);
+  // The rows are yielded in the order of their first occurrence, like
+  // without spilling.
+  ASSERT_EQ(results.size(), 100);
+  for (int i = 0; i < 100; ++i) EXPECT_EQ(results[i][0].ValueInt(), input[i].ValueInt());
+  EXPECT_TRUE(std::filesystem::is_empty(spill_directory));
+  std::filesystem::remove_all(spill_directory);
+}
+
 TEST(QueryPlan, ScanAllByLabel) {
   storage::Storage db;
   auto label = db.NameToLabel("label");
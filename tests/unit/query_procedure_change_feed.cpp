@@ -0,0 +1,292 @@
+// Copyright 2022 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "mg_procedure.h"
+#include "query/procedure/change_feed.hpp"
+#include "query/procedure/mg_procedure_impl.hpp"
+#include "query/procedure/module.hpp"
+#include "storage/v2/storage.hpp"
+#include "utils/thread_pool.hpp"
+
+namespace {
+
+// State of the hook, which mirrors the IDs of the vertices of the graph.
+std::mutex hook_lock;
+std::set<int64_t> hook_vertices;
+// The created vertices in the order in which they were delivered.
+std::vector<int64_t> delivered;
+int rebuilds{0};
+// Held by the tests to stop the delivery in the middle of the changes.
+std::mutex delivery_gate;
+
+void RebuildVertices(mgp_graph *graph, mgp_memory *memory) {
+  std::set<int64_t> vertices;
+  mgp_vertices_iterator *it{nullptr};
+  ASSERT_EQ(mgp_graph_iter_vertices(graph, memory, &it), MGP_ERROR_NO_ERROR);
+  mgp_vertex *vertex{nullptr};
+  for (mgp_vertices_iterator_get(it, &vertex); vertex; mgp_vertices_iterator_next(it, &vertex)) {
+    mgp_vertex_id id{};
+    EXPECT_EQ(mgp_vertex_get_id(vertex, &id), MGP_ERROR_NO_ERROR);
+    vertices.insert(id.as_int);
+  }
+  mgp_vertices_iterator_destroy(it);
+  std::lock_guard guard(hook_lock);
+  hook_vertices = std::move(vertices);
+  ++rebuilds;
+}
+
+void ApplyVertices(mgp_changes *changes, mgp_memory * /*memory*/) {
+  std::lock_guard gate(delivery_gate);
+  std::lock_guard guard(hook_lock);
+  const mgp_vertex_id *ids{nullptr};
+  size_t count{0};
+  EXPECT_EQ(mgp_changes_created_vertices(changes, &ids, &count), MGP_ERROR_NO_ERROR);
+  for (size_t i = 0; i < count; ++i) {
+    hook_vertices.insert(ids[i].as_int);
+    delivered.push_back(ids[i].as_int);
+  }
+  EXPECT_EQ(mgp_changes_deleted_vertices(changes, &ids, &count), MGP_ERROR_NO_ERROR);
+  for (size_t i = 0; i < count; ++i) hook_vertices.erase(ids[i].as_int);
+}
+
+class MockModule : public query::procedure::Module {
+ public:
+  MockModule() = default;
+  ~MockModule() override = default;
+  MockModule(const MockModule &) = delete;
+  MockModule(MockModule &&) = delete;
+  MockModule &operator=(const MockModule &) = delete;
+  MockModule &operator=(MockModule &&) = delete;
+
+  bool Close() override { return true; }
+
+  const std::map<std::string, mgp_proc, std::less<>> *Procedures() const override { return &procedures; }
+  const std::map<std::string, mgp_trans, std::less<>> *Transformations() const override { return &transformations; }
+  const std::map<std::string, mgp_change_hook, std::less<>> *ChangeHooks() const override { return &change_hooks; }
+  std::optional<std::filesystem::path> Path() const override { return std::nullopt; }
+
+  std::map<std::string, mgp_proc, std::less<>> procedures{};
+  std::map<std::string, mgp_trans, std::less<>> transformations{};
+  std::map<std::string, mgp_change_hook, std::less<>> change_hooks{};
+};
+
+}  // namespace
+
+class ChangeFeedTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    std::lock_guard guard(hook_lock);
+    hook_vertices.clear();
+    delivered.clear();
+    rebuilds = 0;
+  }
+
+  void RegisterHookModule() {
+    auto module = std::make_unique<MockModule>();
+    module->change_hooks.emplace("vertices", mgp_change_hook{RebuildVertices, ApplyVertices, std::nullopt});
+    registry.RegisterModule("hook_module", std::move(module));
+  }
+
+  std::unique_ptr<query::procedure::ChangeFeed> MakeFeed(
+      size_t max_queued_objects = query::procedure::ChangeFeed::kDefaultMaxQueuedObjects) {
+    return std::make_unique<query::procedure::ChangeFeed>(&db, &registry, &is_shutting_down, &procedure_pool,
+                                                          max_queued_objects);
+  }
+
+  // Creates a vertex in a transaction which is committed through the feed.
+  int64_t CommitVertex(query::procedure::ChangeFeed *feed) {
+    auto accessor = db.Access();
+    const auto id = accessor.CreateVertex().Gid().AsInt();
+    query::procedure::GraphChanges changes;
+    changes.created_vertices.push_back(mgp_vertex_id{id});
+    EXPECT_FALSE(feed->CommitAndPublish(&accessor, std::move(changes)).HasError());
+    return id;
+  }
+
+  std::set<int64_t> GraphVertices() {
+    std::set<int64_t> vertices;
+    auto accessor = db.Access();
+    for (const auto &vertex : accessor.Vertices(storage::View::OLD)) vertices.insert(vertex.Gid().AsInt());
+    return vertices;
+  }
+
+  storage::Storage db;
+  query::procedure::ModuleRegistry registry;
+  std::atomic<bool> is_shutting_down{false};
+  utils::ThreadPool procedure_pool{1};
+};
+
+TEST_F(ChangeFeedTest, DeliversInCommitOrder) {
+  auto feed = MakeFeed();
+  RegisterHookModule();
+  ASSERT_TRUE(feed->HasHooks());
+  feed->AwaitDelivery();
+
+  // The second vertex is created after the first one, but it's committed
+  // first.
+  auto first = db.Access();
+  auto second = db.Access();
+  const auto first_id = first.CreateVertex().Gid().AsInt();
+  const auto second_id = second.CreateVertex().Gid().AsInt();
+  for (auto [accessor, id] : {std::pair{&second, second_id}, std::pair{&first, first_id}}) {
+    query::procedure::GraphChanges changes;
+    changes.created_vertices.push_back(mgp_vertex_id{id});
+    ASSERT_FALSE(feed->CommitAndPublish(accessor, std::move(changes)).HasError());
+  }
+  const auto third_id = CommitVertex(feed.get());
+  feed->AwaitDelivery();
+
+  std::lock_guard guard(hook_lock);
+  EXPECT_EQ(rebuilds, 1);
+  EXPECT_EQ(delivered, (std::vector<int64_t>{second_id, first_id, third_id}));
+  EXPECT_EQ(hook_vertices, GraphVertices());
+}
+
+TEST_F(ChangeFeedTest, RebuildIncludesThePublishedChanges) {
+  auto feed = MakeFeed();
+  // Without the hooks, the changes aren't published.
+  CommitVertex(feed.get());
+  CommitVertex(feed.get());
+  RegisterHookModule();
+  feed->AwaitDelivery();
+  {
+    std::lock_guard guard(hook_lock);
+    EXPECT_EQ(rebuilds, 1);
+    EXPECT_TRUE(delivered.empty());
+    EXPECT_EQ(hook_vertices, GraphVertices());
+  }
+
+  // The changes published while the delivery is stopped are either included
+  // in the snapshot or delivered, but not both.
+  std::vector<int64_t> published;
+  {
+    std::lock_guard gate(delivery_gate);
+    for (int i = 0; i < 5; ++i) published.push_back(CommitVertex(feed.get()));
+  }
+  feed->AwaitDelivery();
+  std::lock_guard guard(hook_lock);
+  EXPECT_EQ(rebuilds, 1);
+  EXPECT_EQ(delivered, published);
+  EXPECT_EQ(hook_vertices, GraphVertices());
+}
+
+TEST_F(ChangeFeedTest, CommitOutsideTheFeedRebuilds) {
+  auto feed = MakeFeed();
+  RegisterHookModule();
+  feed->AwaitDelivery();
+  CommitVertex(feed.get());
+  feed->AwaitDelivery();
+
+  // The vertex committed around the feed is noticed by the next commit which
+  // goes through it.
+  {
+    auto accessor = db.Access();
+    accessor.CreateVertex();
+    ASSERT_FALSE(accessor.Commit().HasError());
+  }
+  CommitVertex(feed.get());
+  feed->AwaitDelivery();
+
+  std::lock_guard guard(hook_lock);
+  EXPECT_EQ(rebuilds, 2);
+  EXPECT_EQ(hook_vertices, GraphVertices());
+}
+
+TEST_F(ChangeFeedTest, UncollectedCommitRebuilds) {
+  auto feed = MakeFeed();
+  RegisterHookModule();
+  feed->AwaitDelivery();
+
+  // A read-only transaction whose changes weren't collected doesn't rebuild
+  // the hooks.
+  {
+    auto accessor = db.Access();
+    ASSERT_FALSE(feed->CommitAndPublish(&accessor, std::nullopt).HasError());
+  }
+  feed->AwaitDelivery();
+  {
+    std::lock_guard guard(hook_lock);
+    EXPECT_EQ(rebuilds, 1);
+  }
+
+  {
+    auto accessor = db.Access();
+    accessor.CreateVertex();
+    ASSERT_FALSE(feed->CommitAndPublish(&accessor, std::nullopt).HasError());
+  }
+  feed->AwaitDelivery();
+  std::lock_guard guard(hook_lock);
+  EXPECT_EQ(rebuilds, 2);
+  EXPECT_TRUE(delivered.empty());
+  EXPECT_EQ(hook_vertices, GraphVertices());
+}
+
+TEST_F(ChangeFeedTest, CommitWaitsForTheDelivery) {
+  auto feed = MakeFeed(2);
+  RegisterHookModule();
+  feed->AwaitDelivery();
+
+  std::atomic<bool> committed{false};
+  std::thread committer;
+  {
+    std::lock_guard gate(delivery_gate);
+    // The first changes are being delivered and the second ones are queued.
+    CommitVertex(feed.get());
+    CommitVertex(feed.get());
+    committer = std::thread([&] {
+      CommitVertex(feed.get());
+      committed = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_FALSE(committed);
+  }
+  committer.join();
+  EXPECT_TRUE(committed);
+  feed->AwaitDelivery();
+
+  std::lock_guard guard(hook_lock);
+  EXPECT_EQ(delivered.size(), 3);
+  EXPECT_EQ(hook_vertices, GraphVertices());
+}
+
+TEST_F(ChangeFeedTest, UnloadDoesNotBlockLookups) {
+  auto feed = MakeFeed();
+  RegisterHookModule();
+  feed->AwaitDelivery();
+
+  std::thread unloader;
+  {
+    std::lock_guard gate(delivery_gate);
+    CommitVertex(feed.get());
+    // The unload waits for the hook, which is stopped, but the modules can
+    // still be looked up meanwhile.
+    unloader = std::thread([&] { registry.UnloadAllModules(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_TRUE(registry.GetModuleNamed("hook_module"));
+  }
+  unloader.join();
+  EXPECT_FALSE(registry.GetModuleNamed("hook_module"));
+  EXPECT_FALSE(feed->HasHooks());
+}
@@ -134,3 +134,72 @@ TEST(Module, ReadWriteProcedures) {
                                    utils::NewDeleteResource()};
   EXPECT_FALSE(read_proc_with_function.info.is_write);
 }
+
+static void DummyBatchCallback(mgp_list *, mgp_graph *, mgp_result *, mgp_memory *, size_t, void *) {}
+
+TEST(Module, BatchReadProcedures) {
+  mgp_module module(utils::NewDeleteResource());
+  auto *proc = EXPECT_MGP_NO_ERROR(mgp_proc *, mgp_module_add_batch_read_procedure, &module, "batch",
+                                   &DummyBatchCallback, nullptr, nullptr);
+  EXPECT_FALSE(proc->info.is_write);
+  ASSERT_TRUE(proc->batch);
+  EXPECT_EQ(proc->batch->cb, &DummyBatchCallback);
+  EXPECT_EQ(proc->batch->init, nullptr);
+  EXPECT_EQ(proc->batch->cleanup, nullptr);
+  EXPECT_FALSE(EXPECT_MGP_NO_ERROR(mgp_proc *, mgp_module_add_read_procedure, &module, "read", &DummyCallback)->batch);
+  mgp_proc *same_name{nullptr};
+  EXPECT_EQ(mgp_module_add_batch_read_procedure(&module, "batch", DummyBatchCallback, nullptr, nullptr, &same_name),
+            MGP_ERROR_LOGIC_ERROR);
+  // The batch entry-points are kept when the procedure is copied, e.g. into a
+  // module's memory.
+  mgp_proc copy(*proc, utils::NewDeleteResource());
+  ASSERT_TRUE(copy.batch);
+  EXPECT_EQ(copy.batch->cb, &DummyBatchCallback);
+}
+
+static void DummyRebuildCallback(mgp_graph *, mgp_memory *) {}
+static void DummyChangeCallback(mgp_changes *changes, mgp_memory *) {
+  size_t count{0};
+  const mgp_edge_change *edges{nullptr};
+  static_cast<void>(mgp_changes_deleted_edges(changes, &edges, &count));
+  if (count > 0) static_cast<void>(mgp_changes_request_rebuild(changes));
+}
+
+TEST(Module, ChangeHooks) {
+  mgp_module module(utils::NewDeleteResource());
+  EXPECT_EQ(mgp_module_add_change_hook(&module, "hook", DummyRebuildCallback, DummyChangeCallback),
+            MGP_ERROR_NO_ERROR);
+  EXPECT_EQ(mgp_module_add_change_hook(&module, "hook", DummyRebuildCallback, DummyChangeCallback),
+            MGP_ERROR_LOGIC_ERROR);
+  EXPECT_EQ(mgp_module_add_change_hook(&module, "dashed-name", DummyRebuildCallback, DummyChangeCallback),
+            MGP_ERROR_INVALID_ARGUMENT);
+  EXPECT_EQ(mgp_module_add_change_hook(&module, "no_rebuild", nullptr, DummyChangeCallback),
+            MGP_ERROR_INVALID_ARGUMENT);
+  ASSERT_EQ(module.change_hooks.size(), 1);
+  const auto &hook = module.change_hooks.begin()->second;
+  EXPECT_EQ(hook.rebuild, &DummyRebuildCallback);
+  // The state of a new hook has to be built first.
+  EXPECT_FALSE(hook.rebuilt_at);
+
+  query::procedure::GraphChanges graph_changes;
+  graph_changes.created_vertices = {mgp_vertex_id{1}, mgp_vertex_id{2}};
+  graph_changes.created_edges = {mgp_edge_change{mgp_edge_id{3}, mgp_vertex_id{1}, mgp_vertex_id{2}}};
+  mgp_changes changes{&graph_changes};
+  const mgp_vertex_id *vertices{nullptr};
+  size_t count{0};
+  EXPECT_EQ(mgp_changes_created_vertices(&changes, &vertices, &count), MGP_ERROR_NO_ERROR);
+  ASSERT_EQ(count, 2);
+  EXPECT_EQ(vertices[1].as_int, 2);
+  const mgp_edge_change *edges{nullptr};
+  EXPECT_EQ(mgp_changes_created_edges(&changes, &edges, &count), MGP_ERROR_NO_ERROR);
+  ASSERT_EQ(count, 1);
+  EXPECT_EQ(edges[0].to.as_int, 2);
+  EXPECT_EQ(mgp_changes_deleted_vertices(&changes, &vertices, &count), MGP_ERROR_NO_ERROR);
+  EXPECT_EQ(count, 0);
+  hook.on_change(&changes, nullptr);
+  EXPECT_FALSE(changes.rebuild_requested);
+
+  graph_changes.deleted_edges = graph_changes.created_edges;
+  hook.on_change(&changes, nullptr);
+  EXPECT_TRUE(changes.rebuild_requested);
+}
@@ -13,6 +13,8 @@
 
 #include <filesystem>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "query/procedure/mg_procedure_impl.hpp"
 #include "query/procedure/py_module.hpp"
@@ -245,6 +247,67 @@ TEST(PyModule, PyPath) {
   ASSERT_FALSE(dba.Commit().HasError());
 }
 
+TEST(PyModule, PyGraphProjection) {
+  storage::Storage db;
+  {
+    auto dba = db.Access();
+    auto v1 = dba.CreateVertex();
+    auto v2 = dba.CreateVertex();
+    auto v3 = dba.CreateVertex();
+    ASSERT_TRUE(v1.SetProperty(dba.NameToProperty("rank"), storage::PropertyValue(1)).HasValue());
+    ASSERT_TRUE(v2.SetProperty(dba.NameToProperty("rank"), storage::PropertyValue(2.5)).HasValue());
+    auto edge = dba.CreateEdge(&v1, &v2, dba.NameToEdgeType("type"));
+    ASSERT_TRUE(edge.HasValue());
+    ASSERT_TRUE(edge->SetProperty(dba.NameToProperty("weight"), storage::PropertyValue(3)).HasValue());
+    ASSERT_TRUE(dba.CreateEdge(&v2, &v3, dba.NameToEdgeType("type")).HasValue());
+    ASSERT_FALSE(dba.Commit().HasError());
+  }
+  auto storage_dba = db.Access();
+  query::DbAccessor dba(&storage_dba);
+  mgp_memory memory{utils::NewDeleteResource()};
+  mgp_graph graph{&dba, storage::View::OLD};
+  auto gil = py::EnsureGIL();
+  py::Object py_graph(query::procedure::MakePyGraph(&graph, &memory));
+  ASSERT_TRUE(py_graph);
+  py::Object py_projection(PyObject_CallMethod(py_graph.Ptr(), "project", "OOsdp", Py_None, Py_None, "weight", 1.0, 1));
+  ASSERT_TRUE(py_projection);
+  AssertPickleAndCopyAreNotSupported(py_projection.Ptr());
+
+  // The arrays are exported through the buffer protocol, so they are checked
+  // the same way a Python module would read them.
+  auto to_list = [&](py::Object array) {
+    EXPECT_TRUE(array);
+    EXPECT_TRUE(PyMemoryView_Check(array.Ptr()));
+    py::Object list(array.CallMethod("tolist"));
+    EXPECT_TRUE(list);
+    std::vector<double> values;
+    for (Py_ssize_t i = 0; i < PyList_Size(list.Ptr()); ++i) {
+      values.push_back(PyFloat_AsDouble(PyList_GetItem(list.Ptr(), i)));
+    }
+    return values;
+  };
+  auto get_array = [&](const char *method) { return py_projection.CallMethod(method); };
+  EXPECT_EQ(to_list(get_array("vertex_ids")), (std::vector<double>{0, 1, 2}));
+  EXPECT_EQ(to_list(get_array("out_offsets")), (std::vector<double>{0, 1, 2, 2}));
+  EXPECT_EQ(to_list(get_array("out_targets")), (std::vector<double>{1, 2}));
+  EXPECT_EQ(to_list(get_array("out_weights")), (std::vector<double>{3, 1}));
+  EXPECT_EQ(to_list(get_array("in_offsets")), (std::vector<double>{0, 0, 1, 2}));
+  EXPECT_EQ(to_list(get_array("in_sources")), (std::vector<double>{0, 1}));
+  EXPECT_EQ(to_list(py::Object(PyObject_CallMethod(py_projection.Ptr(), "vertex_property", "sd", "rank", -1.0))),
+            (std::vector<double>{1, 2.5, -1}));
+
+  // The arrays stay valid after the projection and the graph are gone.
+  auto vertex_ids = get_array("vertex_ids");
+  ASSERT_TRUE(vertex_ids);
+  py_projection = py::Object(nullptr);
+  ASSERT_TRUE(py_graph.CallMethod("invalidate"));
+  py_graph = py::Object(nullptr);
+  py::Object last_id(PySequence_GetItem(vertex_ids.Ptr(), 2));
+  ASSERT_TRUE(last_id);
+  EXPECT_EQ(PyLong_AsLong(last_id.Ptr()), 2);
+  ASSERT_FALSE(dba.Commit().HasError());
+}
+
 TEST(PyModule, PyObjectToMgpValue) {
   mgp_memory memory{utils::NewDeleteResource()};
   auto gil = py::EnsureGIL();
@@ -292,6 +355,23 @@ TEST(PyModule, PyObjectToMgpValue) {
   mgp_value_destroy(value);
 }
 
+TEST(PyModule, ReleaseGIL) {
+  auto gil = py::EnsureGIL();
+  py::Object value(PyLong_FromLong(42));
+  {
+    py::ReleaseGIL released_gil;
+    // Another thread can execute Python code while this one waits for it.
+    std::thread thread([] {
+      auto thread_gil = py::EnsureGIL();
+      py::Object result(PyRun_String("sum(range(100))", Py_eval_input, PyEval_GetBuiltins(), nullptr));
+      ASSERT_TRUE(result);
+      EXPECT_EQ(PyLong_AsLong(result.Ptr()), 4950);
+    });
+    thread.join();
+  }
+  EXPECT_EQ(PyLong_AsLong(value.Ptr()), 42);
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   // Initialize Python
@@ -12,6 +12,9 @@
 #include <algorithm>
 #include <iterator>
 #include <list>
+#include <mutex>
+#include <set>
+#include <thread>
 #include <memory>
 #include <vector>
 
@@ -30,6 +33,7 @@
 #include "storage_test_utils.hpp"
 #include "test_utils.hpp"
 #include "utils/memory.hpp"
+#include "utils/thread_pool.hpp"
 
 #define EXPECT_SUCCESS(...) EXPECT_EQ(__VA_ARGS__, MGP_ERROR_NO_ERROR)
 
@@ -66,6 +70,14 @@ struct MgpVerticesIteratorDeleter {
   }
 };
 
+struct MgpGraphProjectionDeleter {
+  void operator()(mgp_graph_projection *projection) {
+    if (projection != nullptr) {
+      mgp_graph_projection_destroy(projection);
+    }
+  }
+};
+
 struct MgpValueDeleter {
   void operator()(mgp_value *v) {
     if (v != nullptr) {
@@ -79,6 +91,7 @@ using MgpEdgesIteratorPtr = std::unique_ptr<mgp_edges_iterator, MgpEdgesIterator
 using MgpVertexPtr = std::unique_ptr<mgp_vertex, MgpVertexDeleter>;
 using MgpVerticesIteratorPtr = std::unique_ptr<mgp_vertices_iterator, MgpVerticesIteratorDeleter>;
 using MgpValuePtr = std::unique_ptr<mgp_value, MgpValueDeleter>;
+using MgpGraphProjectionPtr = std::unique_ptr<mgp_graph_projection, MgpGraphProjectionDeleter>;
 
 template <typename TMaybeIterable>
 size_t CountMaybeIterables(TMaybeIterable &&maybe_iterable) {
@@ -119,6 +132,35 @@ struct MgpGraphTest : public ::testing::Test {
     return vertex_ids;
   }
 
+  // Creates the vertices 0, 1, 2 and 3, where all except 2 have the label A,
+  // and the edges 0-E->1 (w: 1), 0-E->2 (w: 2), 1-F->3 (w: 3.5) and 3-E->0.
+  std::array<storage::Gid, 4> CreateProjectionGraph() {
+    std::array<storage::Gid, 4> vertex_ids{};
+    auto &accessor = CreateDbAccessor(storage::IsolationLevel::SNAPSHOT_ISOLATION);
+    std::vector<query::VertexAccessor> vertices;
+    for (auto i = 0; i < 4; ++i) {
+      vertices.push_back(accessor.InsertVertex());
+      vertex_ids[i] = vertices.back().Gid();
+      if (i != 2) {
+        EXPECT_TRUE(vertices.back().AddLabel(accessor.NameToLabel("A")).HasValue());
+      }
+    }
+    auto create_edge = [&](const int from, const int to, const std::string_view type,
+                           const storage::PropertyValue &weight) {
+      auto edge = accessor.InsertEdge(&vertices[from], &vertices[to], accessor.NameToEdgeType(type));
+      ASSERT_TRUE(edge.HasValue());
+      if (!weight.IsNull()) {
+        ASSERT_TRUE(edge->SetProperty(accessor.NameToProperty("w"), weight).HasValue());
+      }
+    };
+    create_edge(0, 1, "E", storage::PropertyValue{1});
+    create_edge(0, 2, "E", storage::PropertyValue{2});
+    create_edge(1, 3, "F", storage::PropertyValue{3.5});
+    create_edge(3, 0, "E", storage::PropertyValue{});
+    EXPECT_FALSE(accessor.Commit().HasError());
+    return vertex_ids;
+  }
+
   void GetFirstOutEdge(mgp_graph &graph, storage::Gid vertex_id, MgpEdgePtr &edge) {
     MgpVertexPtr from{EXPECT_MGP_NO_ERROR(mgp_vertex *, mgp_graph_get_vertex_by_id, &graph,
                                           mgp_vertex_id{vertex_id.AsInt()}, &memory)};
@@ -133,6 +175,8 @@ struct MgpGraphTest : public ::testing::Test {
     ASSERT_NE(edge, nullptr);
   }
 
+  void SetProcedurePool(utils::ThreadPool *pool) { ctx_->procedure_pool = pool; }
+
   query::DbAccessor &CreateDbAccessor(const storage::IsolationLevel isolationLevel) {
     accessors_.push_back(storage.Access(isolationLevel));
     db_accessors_.emplace_back(&accessors_.back());
@@ -615,3 +659,296 @@ TEST_F(MgpGraphTest, EdgeSetPropertyWithImmutableGraph) {
   EXPECT_EQ(EXPECT_MGP_NO_ERROR(int, mgp_edge_underlying_graph_is_mutable, edge.get()), 0);
   EXPECT_EQ(mgp_edge_set_property(edge.get(), "property", value.get()), MGP_ERROR_IMMUTABLE_OBJECT);
 }
+
+namespace {
+template <typename T>
+std::vector<T> ToVector(const T *data, const size_t size) {
+  if (data == nullptr) {
+    ADD_FAILURE() << "The projected array is missing";
+    return {};
+  }
+  return {data, data + size};
+}
+}  // namespace
+
+TEST_F(MgpGraphTest, ProjectWholeGraph) {
+  const auto vertex_ids = CreateProjectionGraph();
+  auto graph = CreateGraph(storage::View::OLD);
+  mgp_graph_projection_config config{};
+  MgpGraphProjectionPtr projection{
+      EXPECT_MGP_NO_ERROR(mgp_graph_projection *, mgp_graph_project, &graph, &config, &memory)};
+  ASSERT_NE(projection, nullptr);
+
+  ASSERT_EQ(EXPECT_MGP_NO_ERROR(size_t, mgp_graph_projection_vertex_count, projection.get()), 4);
+  ASSERT_EQ(EXPECT_MGP_NO_ERROR(size_t, mgp_graph_projection_edge_count, projection.get()), 4);
+  const auto *ids = EXPECT_MGP_NO_ERROR(const int64_t *, mgp_graph_projection_vertex_ids, projection.get());
+  for (size_t i = 0; i < vertex_ids.size(); ++i) {
+    EXPECT_EQ(ids[i], vertex_ids[i].AsInt());
+    EXPECT_EQ(EXPECT_MGP_NO_ERROR(uint64_t, mgp_graph_projection_vertex_ordinal, projection.get(),
+                                  mgp_vertex_id{vertex_ids[i].AsInt()}),
+              i);
+  }
+  EXPECT_THAT(ToVector(EXPECT_MGP_NO_ERROR(const uint64_t *, mgp_graph_projection_out_offsets, projection.get()), 5),
+              ::testing::ElementsAre(0, 2, 3, 3, 4));
+  EXPECT_THAT(ToVector(EXPECT_MGP_NO_ERROR(const uint64_t *, mgp_graph_projection_out_targets, projection.get()), 4),
+              ::testing::ElementsAre(1, 2, 3, 0));
+  EXPECT_EQ(EXPECT_MGP_NO_ERROR(const double *, mgp_graph_projection_out_weights, projection.get()), nullptr);
+  EXPECT_EQ(EXPECT_MGP_NO_ERROR(const uint64_t *, mgp_graph_projection_in_offsets, projection.get()), nullptr);
+  EXPECT_EQ(EXPECT_MGP_NO_ERROR(const uint64_t *, mgp_graph_projection_in_sources, projection.get()), nullptr);
+  EXPECT_EQ(EXPECT_MGP_NO_ERROR(const double *, mgp_graph_projection_in_weights, projection.get()), nullptr);
+}
+
+TEST_F(MgpGraphTest, ProjectFilteredGraph) {
+  const auto vertex_ids = CreateProjectionGraph();
+  auto check_projection = [this, &vertex_ids] {
+    auto graph = CreateGraph(storage::View::OLD);
+    mgp_graph_projection_config config{
+        .vertex_label = "A", .edge_type = "E", .weight_property = "w", .default_weight = 10, .include_in_edges = 1};
+    MgpGraphProjectionPtr projection{
+        EXPECT_MGP_NO_ERROR(mgp_graph_projection *, mgp_graph_project, &graph, &config, &memory)};
+    ASSERT_NE(projection, nullptr);
+
+    // The vertex 2 doesn't have the label, so the edge 0->2 isn't projected either.
+    ASSERT_EQ(EXPECT_MGP_NO_ERROR(size_t, mgp_graph_projection_vertex_count, projection.get()), 3);
+    ASSERT_EQ(EXPECT_MGP_NO_ERROR(size_t, mgp_graph_projection_edge_count, projection.get()), 2);
+    EXPECT_THAT(ToVector(EXPECT_MGP_NO_ERROR(const int64_t *, mgp_graph_projection_vertex_ids, projection.get()), 3),
+                ::testing::ElementsAre(vertex_ids[0].AsInt(), vertex_ids[1].AsInt(), vertex_ids[3].AsInt()));
+    uint64_t ordinal{0};
+    EXPECT_EQ(mgp_graph_projection_vertex_ordinal(projection.get(), mgp_vertex_id{vertex_ids[2].AsInt()}, &ordinal),
+              MGP_ERROR_OUT_OF_RANGE);
+
+    EXPECT_THAT(
+        ToVector(EXPECT_MGP_NO_ERROR(const uint64_t *, mgp_graph_projection_out_offsets, projection.get()), 4),
+        ::testing::ElementsAre(0, 1, 1, 2));
+    EXPECT_THAT(
+        ToVector(EXPECT_MGP_NO_ERROR(const uint64_t *, mgp_graph_projection_out_targets, projection.get()), 2),
+        ::testing::ElementsAre(1, 0));
+    EXPECT_THAT(ToVector(EXPECT_MGP_NO_ERROR(const double *, mgp_graph_projection_out_weights, projection.get()), 2),
+                ::testing::ElementsAre(1, 10));
+    EXPECT_THAT(ToVector(EXPECT_MGP_NO_ERROR(const uint64_t *, mgp_graph_projection_in_offsets, projection.get()), 4),
+                ::testing::ElementsAre(0, 1, 2, 2));
+    EXPECT_THAT(ToVector(EXPECT_MGP_NO_ERROR(const uint64_t *, mgp_graph_projection_in_sources, projection.get()), 2),
+                ::testing::ElementsAre(2, 0));
+    EXPECT_THAT(ToVector(EXPECT_MGP_NO_ERROR(const double *, mgp_graph_projection_in_weights, projection.get()), 2),
+                ::testing::ElementsAre(10, 1));
+  };
+  {
+    SCOPED_TRACE("Without label index");
+    check_projection();
+  }
+  ASSERT_TRUE(storage.CreateIndex(storage.NameToLabel("A")));
+  {
+    SCOPED_TRACE("With label index");
+    check_projection();
+  }
+}
+
+TEST_F(MgpGraphTest, ProjectNonNumericWeight) {
+  {
+    auto &accessor = CreateDbAccessor(storage::IsolationLevel::SNAPSHOT_ISOLATION);
+    auto from = accessor.InsertVertex();
+    auto to = accessor.InsertVertex();
+    auto edge = accessor.InsertEdge(&from, &to, accessor.NameToEdgeType("E"));
+    ASSERT_TRUE(edge.HasValue());
+    ASSERT_TRUE(edge->SetProperty(accessor.NameToProperty("w"), storage::PropertyValue{"heavy"}).HasValue());
+    ASSERT_FALSE(accessor.Commit().HasError());
+  }
+  auto graph = CreateGraph(storage::View::OLD);
+  mgp_graph_projection_config config{.weight_property = "w"};
+  mgp_graph_projection *projection{nullptr};
+  EXPECT_EQ(mgp_graph_project(&graph, &config, &memory, &projection), MGP_ERROR_VALUE_CONVERSION);
+}
+
+TEST_F(MgpGraphTest, ProjectLargeGraph) {
+  // Large enough to be projected by multiple threads.
+  constexpr uint64_t kVertexCount = 50000;
+  {
+    auto &accessor = CreateDbAccessor(storage::IsolationLevel::SNAPSHOT_ISOLATION);
+    std::vector<query::VertexAccessor> vertices;
+    for (uint64_t i = 0; i < kVertexCount; ++i) {
+      vertices.push_back(accessor.InsertVertex());
+    }
+    const auto edge_type = accessor.NameToEdgeType("E");
+    for (uint64_t i = 0; i < kVertexCount; ++i) {
+      ASSERT_TRUE(accessor.InsertEdge(&vertices[i], &vertices[(i + 1) % kVertexCount], edge_type).HasValue());
+    }
+    ASSERT_FALSE(accessor.Commit().HasError());
+  }
+  auto graph = CreateGraph(storage::View::OLD);
+  mgp_graph_projection_config config{.include_in_edges = 1};
+  MgpGraphProjectionPtr projection{
+      EXPECT_MGP_NO_ERROR(mgp_graph_projection *, mgp_graph_project, &graph, &config, &memory)};
+  ASSERT_NE(projection, nullptr);
+  ASSERT_EQ(EXPECT_MGP_NO_ERROR(size_t, mgp_graph_projection_edge_count, projection.get()), kVertexCount);
+  const auto *out_offsets = EXPECT_MGP_NO_ERROR(const uint64_t *, mgp_graph_projection_out_offsets, projection.get());
+  const auto *out_targets = EXPECT_MGP_NO_ERROR(const uint64_t *, mgp_graph_projection_out_targets, projection.get());
+  const auto *in_offsets = EXPECT_MGP_NO_ERROR(const uint64_t *, mgp_graph_projection_in_offsets, projection.get());
+  const auto *in_sources = EXPECT_MGP_NO_ERROR(const uint64_t *, mgp_graph_projection_in_sources, projection.get());
+  for (uint64_t i = 0; i < kVertexCount; ++i) {
+    ASSERT_EQ(out_offsets[i], i);
+    ASSERT_EQ(out_targets[i], (i + 1) % kVertexCount);
+    ASSERT_EQ(in_offsets[i], i);
+    ASSERT_EQ(in_sources[i], (i + kVertexCount - 1) % kVertexCount);
+  }
+}
+
+TEST_F(MgpGraphTest, VerticesIteratorBatch) {
+  std::vector<storage::Gid> vertex_ids;
+  {
+    auto &accessor = CreateDbAccessor(storage::IsolationLevel::SNAPSHOT_ISOLATION);
+    const auto property = accessor.NameToProperty("p");
+    for (auto i = 0; i < 5; ++i) {
+      auto vertex = accessor.InsertVertex();
+      vertex_ids.push_back(vertex.Gid());
+      // The vertices have a different type of the property each.
+      const std::array<storage::PropertyValue, 5> values{storage::PropertyValue{}, storage::PropertyValue{true},
+                                                         storage::PropertyValue{42}, storage::PropertyValue{0.5},
+                                                         storage::PropertyValue{"string"}};
+      if (!values[i].IsNull()) {
+        ASSERT_TRUE(vertex.SetProperty(property, values[i]).HasValue());
+      }
+    }
+    ASSERT_FALSE(accessor.Commit().HasError());
+  }
+  auto graph = CreateGraph(storage::View::OLD);
+  MgpVerticesIteratorPtr vertices{
+      EXPECT_MGP_NO_ERROR(mgp_vertices_iterator *, mgp_graph_iter_vertices, &graph, &memory)};
+  ASSERT_NE(vertices, nullptr);
+
+  std::array<mgp_vertex_id, 3> ids{};
+  std::array<mgp_value_type, 3> types{};
+  std::array<int64_t, 3> ints{};
+  std::array<double, 3> doubles{};
+  mgp_property_column column{.types = types.data(), .ints = ints.data(), .doubles = doubles.data()};
+
+  ASSERT_EQ(EXPECT_MGP_NO_ERROR(size_t, mgp_vertices_iterator_next_batch, vertices.get(), ids.data(), 3), 3);
+  for (size_t i = 0; i < 3; ++i) {
+    EXPECT_EQ(ids[i].as_int, vertex_ids[i].AsInt());
+  }
+  ASSERT_EQ(mgp_vertices_iterator_batch_property(vertices.get(), "p", &column), MGP_ERROR_NO_ERROR);
+  EXPECT_EQ(types[0], MGP_VALUE_TYPE_NULL);
+  EXPECT_EQ(types[1], MGP_VALUE_TYPE_BOOL);
+  EXPECT_EQ(ints[1], 1);
+  EXPECT_EQ(types[2], MGP_VALUE_TYPE_INT);
+  EXPECT_EQ(ints[2], 42);
+
+  // The iterator continues with the vertex after the batch.
+  auto *vertex = EXPECT_MGP_NO_ERROR(mgp_vertex *, mgp_vertices_iterator_get, vertices.get());
+  ASSERT_NE(vertex, nullptr);
+  EXPECT_EQ(EXPECT_MGP_NO_ERROR(mgp_vertex_id, mgp_vertex_get_id, vertex).as_int, vertex_ids[3].AsInt());
+
+  ASSERT_EQ(EXPECT_MGP_NO_ERROR(size_t, mgp_vertices_iterator_next_batch, vertices.get(), ids.data(), 3), 2);
+  EXPECT_EQ(ids[0].as_int, vertex_ids[3].AsInt());
+  EXPECT_EQ(ids[1].as_int, vertex_ids[4].AsInt());
+  ASSERT_EQ(mgp_vertices_iterator_batch_property(vertices.get(), "p", &column), MGP_ERROR_NO_ERROR);
+  EXPECT_EQ(types[0], MGP_VALUE_TYPE_DOUBLE);
+  EXPECT_EQ(doubles[0], 0.5);
+  EXPECT_EQ(types[1], MGP_VALUE_TYPE_STRING);
+  EXPECT_EQ(EXPECT_MGP_NO_ERROR(mgp_vertex *, mgp_vertices_iterator_get, vertices.get()), nullptr);
+
+  EXPECT_EQ(EXPECT_MGP_NO_ERROR(size_t, mgp_vertices_iterator_next_batch, vertices.get(), ids.data(), 3), 0);
+  EXPECT_EQ(EXPECT_MGP_NO_ERROR(mgp_vertex *, mgp_vertices_iterator_next, vertices.get()), nullptr);
+}
+
+TEST_F(MgpGraphTest, EdgesIteratorBatch) {
+  const auto vertex_ids = CreateProjectionGraph();
+  auto graph = CreateGraph(storage::View::OLD);
+  MgpVertexPtr vertex{EXPECT_MGP_NO_ERROR(mgp_vertex *, mgp_graph_get_vertex_by_id, &graph,
+                                          mgp_vertex_id{vertex_ids[0].AsInt()}, &memory)};
+  ASSERT_NE(vertex, nullptr);
+  std::array<mgp_edge_id, 1> edge_ids{};
+  std::array<mgp_vertex_id, 1> other_ids{};
+
+  std::vector<int64_t> targets;
+  {
+    MgpEdgesIteratorPtr edges{
+        EXPECT_MGP_NO_ERROR(mgp_edges_iterator *, mgp_vertex_iter_out_edges, vertex.get(), &memory)};
+    size_t batch_size = 0;
+    do {
+      batch_size = EXPECT_MGP_NO_ERROR(size_t, mgp_edges_iterator_next_batch, edges.get(), edge_ids.data(),
+                                       other_ids.data(), edge_ids.size());
+      for (size_t i = 0; i < batch_size; ++i) {
+        targets.push_back(other_ids[i].as_int);
+      }
+    } while (batch_size > 0);
+    EXPECT_EQ(EXPECT_MGP_NO_ERROR(mgp_edge *, mgp_edges_iterator_get, edges.get()), nullptr);
+  }
+  EXPECT_THAT(targets, ::testing::UnorderedElementsAre(vertex_ids[1].AsInt(), vertex_ids[2].AsInt()));
+
+  MgpEdgesIteratorPtr edges{EXPECT_MGP_NO_ERROR(mgp_edges_iterator *, mgp_vertex_iter_in_edges, vertex.get(), &memory)};
+  ASSERT_EQ(EXPECT_MGP_NO_ERROR(size_t, mgp_edges_iterator_next_batch, edges.get(), edge_ids.data(), other_ids.data(),
+                                edge_ids.size()),
+            1);
+  EXPECT_EQ(other_ids[0].as_int, vertex_ids[3].AsInt());
+  EXPECT_EQ(EXPECT_MGP_NO_ERROR(size_t, mgp_edges_iterator_next_batch, edges.get(), edge_ids.data(), other_ids.data(),
+                                edge_ids.size()),
+            0);
+}
+
+namespace {
+struct ParallelCount {
+  std::vector<size_t> vertex_counts;
+  std::mutex mutex;
+  std::set<std::thread::id> threads;
+};
+
+void CountVertices(size_t task, mgp_graph *graph, mgp_memory *memory, void *data) {
+  auto *count = static_cast<ParallelCount *>(data);
+  {
+    std::lock_guard guard(count->mutex);
+    count->threads.insert(std::this_thread::get_id());
+  }
+  mgp_vertices_iterator *it{nullptr};
+  ASSERT_EQ(mgp_graph_iter_vertices(graph, memory, &it), MGP_ERROR_NO_ERROR);
+  MgpVerticesIteratorPtr vertices{it};
+  mgp_vertex *vertex{nullptr};
+  ASSERT_EQ(mgp_vertices_iterator_get(vertices.get(), &vertex), MGP_ERROR_NO_ERROR);
+  while (vertex) {
+    ++count->vertex_counts[task];
+    // Give the other threads a chance to take some of the tasks.
+    std::this_thread::yield();
+    ASSERT_EQ(mgp_vertices_iterator_next(vertices.get(), &vertex), MGP_ERROR_NO_ERROR);
+  }
+}
+}  // namespace
+
+TEST_F(MgpGraphTest, ParallelFor) {
+  constexpr size_t kVertexCount = 1000;
+  constexpr size_t kTaskCount = 16;
+  {
+    auto &accessor = CreateDbAccessor(storage::IsolationLevel::SNAPSHOT_ISOLATION);
+    for (size_t i = 0; i < kVertexCount; ++i) {
+      accessor.InsertVertex();
+    }
+    ASSERT_FALSE(accessor.Commit().HasError());
+  }
+  auto check_parallel_for = [this](const size_t worker_count) {
+    auto graph = CreateGraph(storage::View::OLD);
+    EXPECT_EQ(EXPECT_MGP_NO_ERROR(size_t, mgp_graph_worker_count, &graph), worker_count);
+    ParallelCount count;
+    count.vertex_counts.resize(kTaskCount);
+    ASSERT_EQ(mgp_graph_parallel_for(&graph, kTaskCount, CountVertices, &count, &memory), MGP_ERROR_NO_ERROR);
+    EXPECT_THAT(count.vertex_counts, ::testing::Each(kVertexCount));
+    EXPECT_LE(count.threads.size(), worker_count);
+    EXPECT_TRUE(count.threads.contains(std::this_thread::get_id()));
+  };
+  {
+    SCOPED_TRACE("Without the pool");
+    check_parallel_for(1);
+  }
+  utils::ThreadPool pool{3};
+  SetProcedurePool(&pool);
+  {
+    SCOPED_TRACE("With the pool");
+    check_parallel_for(4);
+  }
+  SetProcedurePool(nullptr);
+}
+
+TEST_F(MgpGraphTest, ParallelForWithMutableGraph) {
+  auto graph = CreateGraph(storage::View::NEW);
+  ParallelCount count;
+  count.vertex_counts.resize(1);
+  EXPECT_EQ(mgp_graph_parallel_for(&graph, 1, CountVertices, &count, &memory), MGP_ERROR_LOGIC_ERROR);
+  EXPECT_EQ(count.vertex_counts[0], 0);
+}
@@ -270,3 +270,19 @@ TEST(QueryProfileTest, ComplicatedQuery) {
   EXPECT_EQ(children5[0]["name"], "Once");
   EXPECT_TRUE(children5[0]["children"].empty());
 }
+
+TEST(QueryProfileTest, AllocatedMemory) {
+  std::chrono::duration<double> total_time{0.001};
+  ProfilingStats once{2, 25, 0, "Once", {}, 1024};
+  // The allocated bytes include the ones of the children.
+  ProfilingStats produce{2, 100, 0, "Produce", {once}, 3072};
+
+  auto table = ProfilingStatsToTable(ProfilingStatsWithTotalTime{produce, total_time});
+  ASSERT_EQ(table.size(), 2U);
+  EXPECT_EQ(table[0][4].ValueString(), "2.00KiB");
+  EXPECT_EQ(table[1][4].ValueString(), "1.00KiB");
+
+  auto json = ProfilingStatsToJson(ProfilingStatsWithTotalTime{produce, total_time});
+  EXPECT_EQ(json["allocated_bytes"], 2048);
+  EXPECT_EQ(json["children"][0]["allocated_bytes"], 1024);
+}
@@ -10,9 +10,16 @@
 // licenses/APL.txt.
 
 #include <algorithm>
+#include <atomic>
 #include <filesystem>
+#include <mutex>
 #include <optional>
+#include <set>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
 #include <utility>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -21,9 +28,11 @@
 #include "kafka_mock.hpp"
 #include "query/config.hpp"
 #include "query/interpreter.hpp"
+#include "query/stream/sources.hpp"
 #include "query/stream/streams.hpp"
 #include "storage/v2/storage.hpp"
 #include "test_utils.hpp"
+#include "utils/thread_pool.hpp"
 
 using Streams = query::stream::Streams;
 using StreamInfo = query::stream::KafkaStream::StreamInfo;
@@ -90,6 +99,7 @@ class StreamsTest : public ::testing::Test {
         stream_data->stream_source->ReadLock()->Info(check_data.info.common_info.transformation_name);
     EXPECT_TRUE(
         std::equal(check_data.info.configs.begin(), check_data.info.configs.end(), stream_info.configs.begin()));
+    EXPECT_EQ(check_data.info.parallelism, stream_info.parallelism);
   }
 
   void StartStream(StreamCheckData &check_data) {
@@ -196,6 +206,7 @@ TEST_F(StreamsTest, RestoreStreams) {
     if (i > 0) {
       stream_info.common_info.batch_interval = std::chrono::milliseconds((i + 1) * 10);
       stream_info.common_info.batch_size = 1000 + i;
+      stream_info.parallelism = i + 1;
       stream_check_data.owner = std::string{"owner"} + iteration_postfix;
 
       // These are just random numbers to make the CONFIGS and CREDENTIALS map vary between consumers:
@@ -309,3 +320,103 @@ TEST_F(StreamsTest, CheckInvalidCredentials) {
   EXPECT_THROW_WITH_MSG(streams_->Create<query::stream::KafkaStream>(stream_name, stream_info, std::nullopt),
                         integrations::kafka::SettingCustomConfigFailed, checker);
 }
+
+namespace {
+// Creates a message for each of the partitions, with the offsets increasing in the order of the partitions.
+std::vector<query::stream::KafkaStream::Message> CreateMessages(const std::vector<int32_t> &partitions) {
+  std::vector<query::stream::KafkaStream::Message> messages;
+  int64_t offset{0};
+  for (const auto partition : partitions) {
+    messages.emplace_back(std::make_unique<MockedRdKafkaMessage>("key", "payload", offset++, partition));
+  }
+  return messages;
+}
+
+std::vector<int64_t> Offsets(const query::stream::KafkaMessageGroup &group) {
+  std::vector<int64_t> offsets;
+  for (const auto &message : group) offsets.push_back(message.get().Offset());
+  return offsets;
+}
+}  // namespace
+
+TEST(KafkaPartitionGroupsTest, SplitByPartition) {
+  const auto messages = CreateMessages({0, 1, 0, 2, 1, 3, 2});
+  {
+    // The partitions are assigned to the groups in the order in which they appear, and the messages of a partition
+    // keep their order.
+    const auto groups = query::stream::SplitByPartition(messages, 2);
+    ASSERT_EQ(groups.size(), 2);
+    EXPECT_EQ(Offsets(groups[0]), (std::vector<int64_t>{0, 2, 3, 6}));
+    EXPECT_EQ(Offsets(groups[1]), (std::vector<int64_t>{1, 4, 5}));
+  }
+  {
+    const auto groups = query::stream::SplitByPartition(messages, 8);
+    ASSERT_EQ(groups.size(), 4);
+    EXPECT_EQ(Offsets(groups[0]), (std::vector<int64_t>{0, 2}));
+    EXPECT_EQ(Offsets(groups[1]), (std::vector<int64_t>{1, 4}));
+    EXPECT_EQ(Offsets(groups[2]), (std::vector<int64_t>{3, 6}));
+    EXPECT_EQ(Offsets(groups[3]), (std::vector<int64_t>{5}));
+  }
+  {
+    const auto groups = query::stream::SplitByPartition(messages, 1);
+    ASSERT_EQ(groups.size(), 1);
+    EXPECT_EQ(groups[0].size(), messages.size());
+  }
+  EXPECT_TRUE(query::stream::SplitByPartition({}, 2).empty());
+}
+
+TEST(KafkaPartitionGroupsTest, ProcessPartitionGroups) {
+  const auto messages = CreateMessages({0, 1, 2, 0, 1, 2});
+  const auto groups = query::stream::SplitByPartition(messages, 3);
+  ASSERT_EQ(groups.size(), 3);
+  utils::ThreadPool pool{2};
+
+  std::mutex mutex;
+  std::vector<size_t> processed;
+  std::set<std::thread::id> threads;
+  query::stream::ProcessPartitionGroups(groups, &pool, [&](const size_t index) {
+    std::lock_guard guard(mutex);
+    processed.push_back(index);
+    threads.insert(std::this_thread::get_id());
+  });
+  std::sort(processed.begin(), processed.end());
+  EXPECT_EQ(processed, (std::vector<size_t>{0, 1, 2}));
+  // The first group is processed by the calling thread and the others on the pool.
+  EXPECT_TRUE(threads.contains(std::this_thread::get_id()));
+  EXPECT_GE(threads.size(), 2);
+}
+
+TEST(KafkaPartitionGroupsTest, FailedGroupsAreNotCommitted) {
+  const auto messages = CreateMessages({0, 1, 2, 0, 1, 2});
+  const auto groups = query::stream::SplitByPartition(messages, 3);
+  ASSERT_EQ(groups.size(), 3);
+  utils::ThreadPool pool{2};
+
+  std::atomic<size_t> processed{0};
+  try {
+    query::stream::ProcessPartitionGroups(groups, &pool, [&](const size_t index) {
+      ++processed;
+      if (index == 1) throw std::runtime_error("The group failed");
+    });
+    ADD_FAILURE() << "The failure of the group wasn't reported";
+  } catch (const integrations::kafka::PartiallyProcessedBatchException &exception) {
+    // The messages of the processed partitions aren't consumed again, only the ones of the failed partition.
+    EXPECT_EQ(exception.ProcessedPartitions(),
+              (std::vector<std::pair<std::string, int32_t>>{{"Topic1", 0}, {"Topic1", 2}}));
+    EXPECT_NE(std::string_view{exception.what()}.find("The group failed"), std::string_view::npos);
+  }
+  // The other groups are processed even though one of them failed.
+  EXPECT_EQ(processed, 3);
+}
+
+TEST(KafkaPartitionGroupsTest, FailedBatchIsNotPartiallyProcessed) {
+  const auto messages = CreateMessages({0, 1, 0, 1});
+  const auto groups = query::stream::SplitByPartition(messages, 2);
+  ASSERT_EQ(groups.size(), 2);
+  utils::ThreadPool pool{1};
+
+  // Without any processed group, the error of the group is thrown as is.
+  EXPECT_THROW(query::stream::ProcessPartitionGroups(
+                   groups, &pool, [](const size_t /*index*/) { throw std::runtime_error("The group failed"); }),
+               std::runtime_error);
+}
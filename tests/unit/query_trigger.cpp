@@ -330,6 +330,91 @@ TEST_F(TriggerContextTest, ReturnCreateOnlyEvent) {
   CheckTypedValueSize(trigger_context, query::TriggerIdentifierTag::UPDATED_OBJECTS, 0, dba);
 }
 
+// The contexts of the consecutive transactions are appended for the after commit triggers, and a trigger only gets
+// the objects it checks or references, adapted for its own transaction.
+TEST_F(TriggerContextTest, AppendAndAdaptNeededObjects) {
+  query::TriggerContext trigger_context;
+  {
+    query::DbAccessor dba{&StartTransaction()};
+    query::TriggerContextCollector trigger_context_collector{kAllEventTypes};
+    for (size_t i = 0; i < 2; ++i) {
+      trigger_context_collector.RegisterCreatedObject(dba.InsertVertex());
+    }
+    dba.AdvanceCommand();
+    ASSERT_FALSE(dba.Commit().HasError());
+    trigger_context = std::move(trigger_context_collector).TransformToTriggerContext();
+  }
+  {
+    query::DbAccessor dba{&StartTransaction()};
+    query::TriggerContextCollector trigger_context_collector{kAllEventTypes};
+    trigger_context_collector.RegisterCreatedObject(dba.InsertVertex());
+    for (auto vertex : dba.Vertices(storage::View::OLD)) {
+      const auto maybe_values = dba.DetachRemoveVertex(&vertex);
+      ASSERT_TRUE(maybe_values.HasValue());
+      ASSERT_TRUE(maybe_values.GetValue());
+      trigger_context_collector.RegisterDeletedObject(std::get<0>(*maybe_values.GetValue()));
+      break;
+    }
+    dba.AdvanceCommand();
+    ASSERT_FALSE(dba.Commit().HasError());
+    trigger_context.Append(std::move(trigger_context_collector).TransformToTriggerContext());
+  }
+
+  query::DbAccessor dba{&StartTransaction()};
+  ASSERT_TRUE(trigger_context.ShouldEventTrigger(query::TriggerEventType::VERTEX_CREATE));
+  ASSERT_TRUE(trigger_context.ShouldEventTrigger(query::TriggerEventType::VERTEX_DELETE));
+
+  {
+    const auto adapted = trigger_context.AdaptedForAccessor(&dba, query::TriggerEventType::VERTEX_CREATE, {});
+    EXPECT_TRUE(adapted.ShouldEventTrigger(query::TriggerEventType::VERTEX_CREATE));
+    EXPECT_FALSE(adapted.ShouldEventTrigger(query::TriggerEventType::VERTEX_DELETE));
+    // The vertex deleted in the second transaction isn't there anymore
+    CheckTypedValueSize(adapted, query::TriggerIdentifierTag::CREATED_VERTICES, 2, dba);
+    CheckTypedValueSize(adapted, query::TriggerIdentifierTag::DELETED_VERTICES, 0, dba);
+  }
+  {
+    const auto adapted = trigger_context.AdaptedForAccessor(&dba, query::TriggerEventType::VERTEX_CREATE,
+                                                            {query::TriggerIdentifierTag::DELETED_OBJECTS});
+    CheckTypedValueSize(adapted, query::TriggerIdentifierTag::CREATED_VERTICES, 2, dba);
+    CheckTypedValueSize(adapted, query::TriggerIdentifierTag::DELETED_VERTICES, 1, dba);
+  }
+  {
+    const auto adapted = trigger_context.AdaptedForAccessor(&dba, query::TriggerEventType::UPDATE, {});
+    EXPECT_FALSE(adapted.ShouldEventTrigger(query::TriggerEventType::ANY));
+  }
+}
+
+// The appended contexts aren't merged like the changes of a single transaction are, so a property set in several
+// transactions is reported once for each of them.
+TEST_F(TriggerContextTest, AppendKeepsChangesOfEachTransaction) {
+  storage::Gid gid;
+  {
+    query::DbAccessor dba{&StartTransaction()};
+    gid = dba.InsertVertex().Gid();
+    ASSERT_FALSE(dba.Commit().HasError());
+  }
+  query::TriggerContext trigger_context;
+  for (int64_t i = 0; i < 2; ++i) {
+    query::DbAccessor dba{&StartTransaction()};
+    query::TriggerContextCollector trigger_context_collector{kAllEventTypes};
+    auto vertex = dba.FindVertex(gid, storage::View::OLD);
+    ASSERT_TRUE(vertex);
+    trigger_context_collector.RegisterSetObjectProperty(*vertex, dba.NameToProperty("PROPERTY"), query::TypedValue(i),
+                                                        query::TypedValue(i + 1));
+    ASSERT_FALSE(dba.Commit().HasError());
+    auto context = std::move(trigger_context_collector).TransformToTriggerContext();
+    if (i == 0) {
+      trigger_context = std::move(context);
+    } else {
+      trigger_context.Append(std::move(context));
+    }
+  }
+
+  query::DbAccessor dba{&StartTransaction()};
+  const auto adapted = trigger_context.AdaptedForAccessor(&dba, query::TriggerEventType::VERTEX_UPDATE, {});
+  CheckTypedValueSize(adapted, query::TriggerIdentifierTag::SET_VERTEX_PROPERTIES, 2, dba);
+}
+
 namespace {
 void EXPECT_PROP_TRUE(const query::TypedValue &a) {
   EXPECT_TRUE(a.type() == query::TypedValue::Type::Bool && a.ValueBool());
@@ -839,8 +924,7 @@ class TriggerStoreTest : public ::testing::Test {
 
   std::optional<query::DbAccessor> dba;
 
-  utils::SkipList<query::QueryCacheEntry> ast_cache;
-  utils::SpinLock antlr_lock;
+  query::QueryCache ast_cache{query::InterpreterConfig::Query{}.ast_cache_max_memory_bytes};
   query::AllowEverythingAuthChecker auth_checker;
 
  private:
@@ -858,7 +942,7 @@ TEST_F(TriggerStoreTest, Restore) {
 
   const auto reset_store = [&] {
     store.emplace(testing_directory);
-    store->RestoreTriggers(&ast_cache, &*dba, &antlr_lock, query::InterpreterConfig::Query{}, &auth_checker);
+    store->RestoreTriggers(&ast_cache, &*dba, query::InterpreterConfig::Query{}, &auth_checker);
   };
 
   reset_store();
@@ -878,12 +962,12 @@ TEST_F(TriggerStoreTest, Restore) {
   const std::string owner{"owner"};
   store->AddTrigger(trigger_name_before, trigger_statement,
                     std::map<std::string, storage::PropertyValue>{{"parameter", storage::PropertyValue{1}}}, event_type,
-                    query::TriggerPhase::BEFORE_COMMIT, &ast_cache, &*dba, &antlr_lock,
-                    query::InterpreterConfig::Query{}, std::nullopt, &auth_checker);
+                    query::TriggerPhase::BEFORE_COMMIT, &ast_cache, &*dba, query::InterpreterConfig::Query{},
+                    std::nullopt, &auth_checker);
   store->AddTrigger(trigger_name_after, trigger_statement,
                     std::map<std::string, storage::PropertyValue>{{"parameter", storage::PropertyValue{"value"}}},
-                    event_type, query::TriggerPhase::AFTER_COMMIT, &ast_cache, &*dba, &antlr_lock,
-                    query::InterpreterConfig::Query{}, {owner}, &auth_checker);
+                    event_type, query::TriggerPhase::AFTER_COMMIT, &ast_cache, &*dba, query::InterpreterConfig::Query{},
+                    {owner}, &auth_checker);
 
   const auto check_triggers = [&] {
     ASSERT_EQ(store->GetTriggerInfo().size(), 2);
@@ -933,16 +1017,16 @@ TEST_F(TriggerStoreTest, AddTrigger) {
 
   // Invalid query in statements
   ASSERT_THROW(store.AddTrigger("trigger", "RETUR 1", {}, query::TriggerEventType::VERTEX_CREATE,
-                                query::TriggerPhase::BEFORE_COMMIT, &ast_cache, &*dba, &antlr_lock,
+                                query::TriggerPhase::BEFORE_COMMIT, &ast_cache, &*dba,
                                 query::InterpreterConfig::Query{}, std::nullopt, &auth_checker),
                utils::BasicException);
   ASSERT_THROW(store.AddTrigger("trigger", "RETURN createdEdges", {}, query::TriggerEventType::VERTEX_CREATE,
-                                query::TriggerPhase::BEFORE_COMMIT, &ast_cache, &*dba, &antlr_lock,
+                                query::TriggerPhase::BEFORE_COMMIT, &ast_cache, &*dba,
                                 query::InterpreterConfig::Query{}, std::nullopt, &auth_checker),
                utils::BasicException);
 
   ASSERT_THROW(store.AddTrigger("trigger", "RETURN $parameter", {}, query::TriggerEventType::VERTEX_CREATE,
-                                query::TriggerPhase::BEFORE_COMMIT, &ast_cache, &*dba, &antlr_lock,
+                                query::TriggerPhase::BEFORE_COMMIT, &ast_cache, &*dba,
                                 query::InterpreterConfig::Query{}, std::nullopt, &auth_checker),
                utils::BasicException);
 
@@ -950,16 +1034,16 @@ TEST_F(TriggerStoreTest, AddTrigger) {
       store.AddTrigger("trigger", "RETURN $parameter",
                        std::map<std::string, storage::PropertyValue>{{"parameter", storage::PropertyValue{1}}},
                        query::TriggerEventType::VERTEX_CREATE, query::TriggerPhase::BEFORE_COMMIT, &ast_cache, &*dba,
-                       &antlr_lock, query::InterpreterConfig::Query{}, std::nullopt, &auth_checker));
+                       query::InterpreterConfig::Query{}, std::nullopt, &auth_checker));
 
   // Inserting with the same name
   ASSERT_THROW(store.AddTrigger("trigger", "RETURN 1", {}, query::TriggerEventType::VERTEX_CREATE,
-                                query::TriggerPhase::BEFORE_COMMIT, &ast_cache, &*dba, &antlr_lock,
+                                query::TriggerPhase::BEFORE_COMMIT, &ast_cache, &*dba,
                                 query::InterpreterConfig::Query{}, std::nullopt, &auth_checker),
                utils::BasicException);
   ASSERT_THROW(store.AddTrigger("trigger", "RETURN 1", {}, query::TriggerEventType::VERTEX_CREATE,
-                                query::TriggerPhase::AFTER_COMMIT, &ast_cache, &*dba, &antlr_lock,
-                                query::InterpreterConfig::Query{}, std::nullopt, &auth_checker),
+                                query::TriggerPhase::AFTER_COMMIT, &ast_cache, &*dba, query::InterpreterConfig::Query{},
+                                std::nullopt, &auth_checker),
                utils::BasicException);
 
   ASSERT_EQ(store.GetTriggerInfo().size(), 1);
@@ -974,8 +1058,8 @@ TEST_F(TriggerStoreTest, DropTrigger) {
 
   const auto *trigger_name = "trigger";
   store.AddTrigger(trigger_name, "RETURN 1", {}, query::TriggerEventType::VERTEX_CREATE,
-                   query::TriggerPhase::BEFORE_COMMIT, &ast_cache, &*dba, &antlr_lock,
-                   query::InterpreterConfig::Query{}, std::nullopt, &auth_checker);
+                   query::TriggerPhase::BEFORE_COMMIT, &ast_cache, &*dba, query::InterpreterConfig::Query{},
+                   std::nullopt, &auth_checker);
 
   ASSERT_THROW(store.DropTrigger("Unknown"), utils::BasicException);
   ASSERT_NO_THROW(store.DropTrigger(trigger_name));
@@ -987,8 +1071,8 @@ TEST_F(TriggerStoreTest, TriggerInfo) {
 
   std::vector<query::TriggerStore::TriggerInfo> expected_info;
   store.AddTrigger("trigger", "RETURN 1", {}, query::TriggerEventType::VERTEX_CREATE,
-                   query::TriggerPhase::BEFORE_COMMIT, &ast_cache, &*dba, &antlr_lock,
-                   query::InterpreterConfig::Query{}, std::nullopt, &auth_checker);
+                   query::TriggerPhase::BEFORE_COMMIT, &ast_cache, &*dba, query::InterpreterConfig::Query{},
+                   std::nullopt, &auth_checker);
   expected_info.push_back(
       {"trigger", "RETURN 1", query::TriggerEventType::VERTEX_CREATE, query::TriggerPhase::BEFORE_COMMIT});
 
@@ -1007,7 +1091,7 @@ TEST_F(TriggerStoreTest, TriggerInfo) {
   check_trigger_info();
 
   store.AddTrigger("edge_update_trigger", "RETURN 1", {}, query::TriggerEventType::EDGE_UPDATE,
-                   query::TriggerPhase::AFTER_COMMIT, &ast_cache, &*dba, &antlr_lock, query::InterpreterConfig::Query{},
+                   query::TriggerPhase::AFTER_COMMIT, &ast_cache, &*dba, query::InterpreterConfig::Query{},
                    std::nullopt, &auth_checker);
   expected_info.push_back(
       {"edge_update_trigger", "RETURN 1", query::TriggerEventType::EDGE_UPDATE, query::TriggerPhase::AFTER_COMMIT});
@@ -1120,7 +1204,7 @@ TEST_F(TriggerStoreTest, AnyTriggerAllKeywords) {
     for (const auto keyword : keywords) {
       SCOPED_TRACE(keyword);
       EXPECT_NO_THROW(store.AddTrigger(trigger_name, fmt::format("RETURN {}", keyword), {}, event_type,
-                                       query::TriggerPhase::BEFORE_COMMIT, &ast_cache, &*dba, &antlr_lock,
+                                       query::TriggerPhase::BEFORE_COMMIT, &ast_cache, &*dba,
                                        query::InterpreterConfig::Query{}, std::nullopt, &auth_checker));
       store.DropTrigger(trigger_name);
     }
@@ -1145,12 +1229,11 @@ TEST_F(TriggerStoreTest, AuthCheckerUsage) {
 
   ASSERT_NO_THROW(store->AddTrigger("successfull_trigger_1", "CREATE (n:VERTEX) RETURN n", {},
                                     query::TriggerEventType::EDGE_UPDATE, query::TriggerPhase::AFTER_COMMIT, &ast_cache,
-                                    &*dba, &antlr_lock, query::InterpreterConfig::Query{}, std::nullopt,
-                                    &mock_checker));
+                                    &*dba, query::InterpreterConfig::Query{}, std::nullopt, &mock_checker));
 
   ASSERT_NO_THROW(store->AddTrigger("successfull_trigger_2", "CREATE (n:VERTEX) RETURN n", {},
                                     query::TriggerEventType::EDGE_UPDATE, query::TriggerPhase::AFTER_COMMIT, &ast_cache,
-                                    &*dba, &antlr_lock, query::InterpreterConfig::Query{}, owner, &mock_checker));
+                                    &*dba, query::InterpreterConfig::Query{}, owner, &mock_checker));
 
   EXPECT_CALL(mock_checker, IsUserAuthorized(std::optional<std::string>{}, ElementsAre(Privilege::MATCH)))
       .Times(1)
@@ -1158,7 +1241,7 @@ TEST_F(TriggerStoreTest, AuthCheckerUsage) {
 
   ASSERT_THROW(store->AddTrigger("unprivileged_trigger", "MATCH (n:VERTEX) RETURN n", {},
                                  query::TriggerEventType::EDGE_UPDATE, query::TriggerPhase::AFTER_COMMIT, &ast_cache,
-                                 &*dba, &antlr_lock, query::InterpreterConfig::Query{}, std::nullopt, &mock_checker);
+                                 &*dba, query::InterpreterConfig::Query{}, std::nullopt, &mock_checker);
                , utils::BasicException);
 
   store.emplace(testing_directory);
@@ -1167,8 +1250,7 @@ TEST_F(TriggerStoreTest, AuthCheckerUsage) {
       .WillOnce(Return(false));
   EXPECT_CALL(mock_checker, IsUserAuthorized(owner, ElementsAre(Privilege::CREATE))).Times(1).WillOnce(Return(true));
 
-  ASSERT_NO_THROW(
-      store->RestoreTriggers(&ast_cache, &*dba, &antlr_lock, query::InterpreterConfig::Query{}, &mock_checker));
+  ASSERT_NO_THROW(store->RestoreTriggers(&ast_cache, &*dba, query::InterpreterConfig::Query{}, &mock_checker));
 
   const auto triggers = store->GetTriggerInfo();
   ASSERT_EQ(triggers.size(), 1);
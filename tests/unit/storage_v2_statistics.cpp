@@ -0,0 +1,191 @@
+// Copyright 2021 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <gtest/gtest.h>
+
+#include "storage/v2/property_value.hpp"
+#include "storage/v2/statistics.hpp"
+#include "storage/v2/storage.hpp"
+
+// NOLINTNEXTLINE(google-build-using-namespace)
+using namespace storage;
+
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define ASSERT_NO_ERROR(result) ASSERT_FALSE((result).HasError())
+
+namespace {
+
+LabelPropertyStatistics BuildStatistics(const std::vector<int64_t> &sorted_values, uint64_t max_buckets) {
+  LabelPropertyStatisticsBuilder builder(sorted_values.size(), max_buckets);
+  for (const auto value : sorted_values) {
+    builder.Add(PropertyValue(value));
+  }
+  return std::move(builder).Finish();
+}
+
+}  // namespace
+
+TEST(StatisticsTest, BuilderCountsValues) {
+  // 0, 1, 1, 2, 2, 2, ... 9 (9 times)
+  std::vector<int64_t> values;
+  for (int64_t i = 0; i < 10; ++i) {
+    for (int64_t j = 0; j < std::max<int64_t>(i, 1); ++j) values.push_back(i);
+  }
+  auto statistics = BuildStatistics(values, 4);
+  EXPECT_EQ(statistics.count, values.size());
+  EXPECT_EQ(statistics.distinct_values_count, 10);
+  ASSERT_FALSE(statistics.histogram.empty());
+  EXPECT_LE(statistics.histogram.size(), 5);
+  uint64_t bucket_total = 0;
+  for (size_t i = 0; i < statistics.histogram.size(); ++i) {
+    const auto &bucket = statistics.histogram[i];
+    bucket_total += bucket.count;
+    EXPECT_FALSE(bucket.upper_bound < bucket.lower_bound);
+    if (i > 0) {
+      // Equal values are never split between buckets.
+      EXPECT_TRUE(statistics.histogram[i - 1].upper_bound < bucket.lower_bound);
+    }
+  }
+  EXPECT_EQ(bucket_total, values.size());
+  EXPECT_DOUBLE_EQ(statistics.AverageGroupSize(), static_cast<double>(values.size()) / 10);
+}
+
+TEST(StatisticsTest, BuilderIgnoresNull) {
+  LabelPropertyStatisticsBuilder builder(2);
+  builder.Add(PropertyValue());
+  builder.Add(PropertyValue(1));
+  auto statistics = std::move(builder).Finish();
+  EXPECT_EQ(statistics.count, 1);
+  EXPECT_EQ(statistics.distinct_values_count, 1);
+}
+
+TEST(StatisticsTest, EstimateEqualCount) {
+  std::vector<int64_t> values;
+  for (int64_t i = 0; i < 100; ++i) {
+    values.push_back(i);
+    values.push_back(i);
+  }
+  auto statistics = BuildStatistics(values, 10);
+  EXPECT_DOUBLE_EQ(statistics.EstimateEqualCount(PropertyValue(42)), 2.0);
+  EXPECT_DOUBLE_EQ(statistics.EstimateEqualCount(PropertyValue(100)), 0.0);
+  EXPECT_DOUBLE_EQ(statistics.EstimateEqualCount(PropertyValue(-1)), 0.0);
+  EXPECT_DOUBLE_EQ(statistics.EstimateEqualCount(PropertyValue()), 0.0);
+}
+
+TEST(StatisticsTest, EstimateRangeCount) {
+  std::vector<int64_t> values;
+  for (int64_t i = 0; i < 1000; ++i) values.push_back(i);
+  auto statistics = BuildStatistics(values, 10);
+  auto inclusive = [](int64_t value) {
+    return std::make_optional(utils::MakeBoundInclusive(PropertyValue(value)));
+  };
+  auto exclusive = [](int64_t value) {
+    return std::make_optional(utils::MakeBoundExclusive(PropertyValue(value)));
+  };
+  EXPECT_DOUBLE_EQ(statistics.EstimateRangeCount(std::nullopt, std::nullopt), 1000.0);
+  EXPECT_NEAR(statistics.EstimateRangeCount(inclusive(0), exclusive(500)), 500.0, 20.0);
+  EXPECT_NEAR(statistics.EstimateRangeCount(inclusive(250), std::nullopt), 750.0, 20.0);
+  EXPECT_NEAR(statistics.EstimateRangeCount(std::nullopt, inclusive(99)), 100.0, 20.0);
+  EXPECT_DOUBLE_EQ(statistics.EstimateRangeCount(inclusive(2000), std::nullopt), 0.0);
+  // Values of incomparable types never satisfy the range.
+  EXPECT_DOUBLE_EQ(
+      statistics.EstimateRangeCount(std::make_optional(utils::MakeBoundInclusive(PropertyValue("a"))), std::nullopt),
+      0.0);
+}
+
+TEST(StatisticsTest, SamplerIsExactForSmallInput) {
+  LabelPropertyStatisticsSampler sampler(100);
+  for (int64_t i = 50; i > 0; --i) {
+    sampler.Add(PropertyValue(i % 10));
+  }
+  auto statistics = std::move(sampler).Finish();
+  EXPECT_EQ(statistics.count, 50);
+  EXPECT_EQ(statistics.distinct_values_count, 10);
+  EXPECT_DOUBLE_EQ(statistics.EstimateEqualCount(PropertyValue(3)), 5.0);
+}
+
+TEST(StatisticsTest, SamplerExtrapolates) {
+  LabelPropertyStatisticsSampler sampler(1000);
+  // 100 distinct values, each appearing 100 times.
+  for (int64_t i = 0; i < 10000; ++i) {
+    sampler.Add(PropertyValue(i % 100));
+  }
+  auto statistics = std::move(sampler).Finish();
+  EXPECT_EQ(statistics.count, 10000);
+  EXPECT_NEAR(statistics.distinct_values_count, 100, 10);
+  EXPECT_NEAR(statistics.EstimateEqualCount(PropertyValue(7)), 100.0, 50.0);
+  EXPECT_NEAR(statistics.EstimateRangeCount(std::make_optional(utils::MakeBoundInclusive(PropertyValue(0))),
+                                            std::make_optional(utils::MakeBoundExclusive(PropertyValue(50)))),
+              5000.0, 1000.0);
+}
+
+TEST(StatisticsTest, AnalyzeGraph) {
+  Storage store;
+  EXPECT_FALSE(store.GetGraphStatistics());
+  LabelId person;
+  LabelId city;
+  PropertyId age;
+  PropertyId name;
+  EdgeTypeId lives_in;
+  {
+    auto acc = store.Access();
+    person = acc.NameToLabel("Person");
+    city = acc.NameToLabel("City");
+    age = acc.NameToProperty("age");
+    name = acc.NameToProperty("name");
+    lives_in = acc.NameToEdgeType("LIVES_IN");
+    std::vector<VertexAccessor> cities;
+    for (int64_t i = 0; i < 2; ++i) {
+      auto vertex = acc.CreateVertex();
+      ASSERT_NO_ERROR(vertex.AddLabel(city));
+      ASSERT_NO_ERROR(vertex.SetProperty(name, PropertyValue(i)));
+      cities.push_back(vertex);
+    }
+    for (int64_t i = 0; i < 10; ++i) {
+      auto vertex = acc.CreateVertex();
+      ASSERT_NO_ERROR(vertex.AddLabel(person));
+      ASSERT_NO_ERROR(vertex.SetProperty(age, PropertyValue(i % 5)));
+      ASSERT_NO_ERROR(acc.CreateEdge(&vertex, &cities[i % 2], lives_in));
+    }
+    ASSERT_NO_ERROR(acc.Commit());
+  }
+  ASSERT_TRUE(store.CreateIndex(person, age));
+
+  auto statistics = store.AnalyzeGraph();
+  ASSERT_TRUE(statistics);
+  EXPECT_EQ(store.GetGraphStatistics(), statistics);
+  EXPECT_EQ(statistics->vertex_count, 12);
+  EXPECT_EQ(statistics->edge_count, 10);
+  EXPECT_EQ(statistics->LabelCount(person), 10);
+  EXPECT_EQ(statistics->LabelCount(city), 2);
+
+  const auto &edge_type_statistics = statistics->edge_type.at(lives_in);
+  EXPECT_EQ(edge_type_statistics.count, 10);
+  EXPECT_EQ(edge_type_statistics.source_count, 10);
+  EXPECT_EQ(edge_type_statistics.destination_count, 2);
+  EXPECT_DOUBLE_EQ(statistics->AverageOutDegree({lives_in}), 1.0);
+  EXPECT_DOUBLE_EQ(statistics->AverageInDegree({lives_in}), 5.0);
+
+  // Read from the index.
+  const auto *age_statistics = statistics->GetLabelPropertyStatistics(person, age);
+  ASSERT_TRUE(age_statistics);
+  EXPECT_EQ(age_statistics->count, 10);
+  EXPECT_EQ(age_statistics->distinct_values_count, 5);
+  EXPECT_DOUBLE_EQ(age_statistics->EstimateEqualCount(PropertyValue(3)), 2.0);
+
+  // Sampled without an index.
+  const auto *name_statistics = statistics->GetLabelPropertyStatistics(city, name);
+  ASSERT_TRUE(name_statistics);
+  EXPECT_EQ(name_statistics->count, 2);
+  EXPECT_EQ(name_statistics->distinct_values_count, 2);
+
+  EXPECT_FALSE(statistics->GetLabelPropertyStatistics(city, age));
+}
@@ -402,4 +402,29 @@ TEST(QueryStripper, CreateTriggerQuery) {
   }
 }
 
+TEST(QueryStripper, Cache) {
+  StrippedQueryCache cache(1024 * 1024);
+  auto stripped = StripQuery("MATCH (n {id: 42}) RETURN n", &cache);
+  EXPECT_EQ(stripped->query(), "MATCH ( n { id : 0 } ) RETURN n");
+  EXPECT_EQ(cache.size(), 1U);
+
+  // The same query text is stripped once.
+  EXPECT_EQ(StripQuery("MATCH (n {id: 42}) RETURN n", &cache), stripped);
+  EXPECT_EQ(cache.hits(), 1U);
+
+  // Queries which differ only in the literals are stripped separately, but
+  // they still have the same hash.
+  auto other = StripQuery("MATCH (n {id: 43}) RETURN n", &cache);
+  EXPECT_NE(other, stripped);
+  EXPECT_EQ(other->hash(), stripped->hash());
+  EXPECT_EQ(other->literals().At(0).second.ValueInt(), 43);
+  EXPECT_EQ(cache.size(), 2U);
+
+  // Invalid queries aren't cached.
+  EXPECT_THROW(StripQuery("RETURN \"unterminated", &cache), LexingException);
+  EXPECT_EQ(cache.size(), 2U);
+
+  EXPECT_NE(StripQuery("RETURN 1", nullptr), nullptr);
+}
+
 }  // namespace
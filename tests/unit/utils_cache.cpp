@@ -0,0 +1,86 @@
+// Copyright 2021 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <memory>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "utils/cache.hpp"
+
+using Cache = utils::MemoryBoundedLruCache<int, std::string>;
+
+TEST(MemoryBoundedLruCache, FindAndInsert) {
+  Cache cache(100);
+  EXPECT_EQ(cache.Find(1), nullptr);
+  auto value = cache.Insert(1, std::make_shared<std::string>("one"), 10);
+  EXPECT_EQ(*value, "one");
+  EXPECT_EQ(cache.Find(1), value);
+  EXPECT_EQ(cache.size(), 1U);
+  EXPECT_EQ(cache.memory_usage(), 10U);
+  EXPECT_EQ(cache.hits(), 1U);
+  EXPECT_EQ(cache.misses(), 1U);
+
+  // The value which is already cached is kept.
+  EXPECT_EQ(cache.Insert(1, std::make_shared<std::string>("uno"), 10), value);
+  EXPECT_EQ(cache.size(), 1U);
+  EXPECT_EQ(cache.memory_usage(), 10U);
+}
+
+TEST(MemoryBoundedLruCache, EvictsLeastRecentlyUsed) {
+  Cache cache(30);
+  cache.Insert(1, std::make_shared<std::string>("one"), 10);
+  cache.Insert(2, std::make_shared<std::string>("two"), 10);
+  cache.Insert(3, std::make_shared<std::string>("three"), 10);
+  ASSERT_NE(cache.Find(1), nullptr);
+
+  cache.Insert(4, std::make_shared<std::string>("four"), 20);
+  EXPECT_EQ(cache.evictions(), 2U);
+  EXPECT_EQ(cache.size(), 2U);
+  EXPECT_EQ(cache.memory_usage(), 30U);
+  EXPECT_NE(cache.Find(1), nullptr);
+  EXPECT_EQ(cache.Find(2), nullptr);
+  EXPECT_EQ(cache.Find(3), nullptr);
+  EXPECT_NE(cache.Find(4), nullptr);
+}
+
+TEST(MemoryBoundedLruCache, EvictedValueStaysAlive) {
+  Cache cache(10);
+  auto value = cache.Insert(1, std::make_shared<std::string>("one"), 10);
+  cache.Insert(2, std::make_shared<std::string>("two"), 10);
+  EXPECT_EQ(cache.Find(1), nullptr);
+  EXPECT_EQ(*value, "one");
+}
+
+TEST(MemoryBoundedLruCache, TooLargeValue) {
+  Cache cache(10);
+  cache.Insert(1, std::make_shared<std::string>("one"), 10);
+  auto value = cache.Insert(2, std::make_shared<std::string>("two"), 11);
+  EXPECT_EQ(*value, "two");
+  EXPECT_EQ(cache.Find(2), nullptr);
+  EXPECT_NE(cache.Find(1), nullptr);
+  EXPECT_EQ(cache.evictions(), 0U);
+}
+
+TEST(MemoryBoundedLruCache, EraseAndClear) {
+  Cache cache(100);
+  cache.Insert(1, std::make_shared<std::string>("one"), 10);
+  cache.Insert(2, std::make_shared<std::string>("two"), 20);
+  cache.Erase(1);
+  cache.Erase(3);
+  EXPECT_EQ(cache.Find(1), nullptr);
+  EXPECT_EQ(cache.size(), 1U);
+  EXPECT_EQ(cache.memory_usage(), 20U);
+  cache.Clear();
+  EXPECT_EQ(cache.Find(2), nullptr);
+  EXPECT_EQ(cache.size(), 0U);
+  EXPECT_EQ(cache.memory_usage(), 0U);
+}
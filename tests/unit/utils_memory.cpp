@@ -321,6 +321,45 @@ TEST(PoolResource, BlockDeallocation) {
   EXPECT_EQ(test_mem.new_count_, 0U);
 }
 
+TEST(TrackingMemoryResource, CountsAllocatedBytes) {
+  TestMemory test_mem;
+  utils::TrackingMemoryResource mem(&test_mem);
+  auto *first = CheckAllocation(&mem, 64U);
+  auto *second = CheckAllocation(&mem, 32U);
+  EXPECT_EQ(test_mem.new_count_, 2U);
+  EXPECT_EQ(mem.GetAllocatedBytes(), 96U);
+  mem.Deallocate(first, 64U);
+  EXPECT_EQ(test_mem.delete_count_, 1U);
+  EXPECT_EQ(mem.GetAllocatedBytes(), 32U);
+  EXPECT_EQ(mem.GetPeakAllocatedBytes(), 96U);
+  mem.Deallocate(second, 32U);
+  EXPECT_EQ(mem.GetAllocatedBytes(), 0U);
+  EXPECT_EQ(mem.GetPeakAllocatedBytes(), 96U);
+}
+
+TEST(TrackingMemoryResource, CountsTowardsParent) {
+  TestMemory test_mem;
+  utils::TrackingMemoryResource parent(&test_mem);
+  auto *first = CheckAllocation(&parent, 16U);
+  void *third = nullptr;
+  {
+    utils::TrackingMemoryResource child(&test_mem, &parent);
+    auto *second = CheckAllocation(&child, 64U);
+    EXPECT_EQ(child.GetAllocatedBytes(), 64U);
+    EXPECT_EQ(parent.GetAllocatedBytes(), 80U);
+    child.Deallocate(second, 64U);
+    EXPECT_EQ(parent.GetAllocatedBytes(), 16U);
+    // Memory which is left allocated in the child is released by its upstream.
+    third = CheckAllocation(&child, 32U);
+    EXPECT_EQ(parent.GetAllocatedBytes(), 48U);
+  }
+  test_mem.Deallocate(third, 32U);
+  EXPECT_EQ(parent.GetAllocatedBytes(), 16U);
+  EXPECT_EQ(parent.GetPeakAllocatedBytes(), 80U);
+  EXPECT_EQ(parent.GetTotalAllocatedBytes(), 112U);
+  parent.Deallocate(first, 16U);
+}
+
 class AllocationTrackingMemory final : public utils::MemoryResource {
  public:
   std::vector<size_t> allocated_sizes_;
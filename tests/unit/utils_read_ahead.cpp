@@ -0,0 +1,120 @@
+// Copyright 2021 Memgraph Ltd.
+//
+// Use of this software is governed by the Business Source License
+// included in the file licenses/BSL.txt; by using this file, you agree to be bound by the terms of the Business Source
+// License, and you may not use this file except in compliance with the Business Source License.
+//
+// As of the Change Date specified in that file, in accordance with
+// the Business Source License, use of this software will be governed
+// by the Apache License, Version 2.0, included in the file
+// licenses/APL.txt.
+
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "utils/read_ahead.hpp"
+
+using namespace std::chrono_literals;
+
+using ReadAhead = utils::ReadAhead<int>;
+
+// Produces the integers [0, end) and counts how many were produced.
+struct Counter {
+  std::optional<int> operator()() {
+    if (*produced == end) return std::nullopt;
+    return (*produced)++;
+  }
+
+  std::atomic<int> *produced;
+  int end;
+};
+
+TEST(ReadAhead, ProducesAllValues) {
+  utils::ThreadPool pool(2);
+  std::atomic<int> produced{0};
+  ReadAhead read_ahead(Counter{&produced, 100}, 10, &pool);
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_TRUE(read_ahead.HasMore());
+    auto value = read_ahead.Pop();
+    ASSERT_TRUE(value);
+    EXPECT_EQ(*value, i);
+  }
+  EXPECT_FALSE(read_ahead.HasMore());
+  EXPECT_FALSE(read_ahead.Pop());
+  EXPECT_FALSE(read_ahead.Pop());
+}
+
+TEST(ReadAhead, StopsWhenBufferIsFull) {
+  utils::ThreadPool pool(1);
+  std::atomic<int> produced{0};
+  ReadAhead read_ahead(Counter{&produced, 100}, 10, &pool);
+  ASSERT_EQ(read_ahead.Pop(), 0);
+  // The background task fills the buffer and stops.
+  while (pool.UnfinishedTasksNum() != 0 || produced < 11) std::this_thread::sleep_for(1ms);
+  std::this_thread::sleep_for(10ms);
+  EXPECT_EQ(produced, 11);
+  // Taking a value out of the buffer continues the production.
+  ASSERT_EQ(read_ahead.Pop(), 1);
+  while (produced < 12) std::this_thread::sleep_for(1ms);
+}
+
+TEST(ReadAhead, ProducesWithoutFreeThreads) {
+  // The pool doesn't have any threads, so the consumer produces the values.
+  utils::ThreadPool pool(0);
+  std::atomic<int> produced{0};
+  ReadAhead read_ahead(Counter{&produced, 3}, 10, &pool);
+  EXPECT_EQ(read_ahead.Pop(), 0);
+  EXPECT_EQ(read_ahead.Pop(), 1);
+  EXPECT_EQ(read_ahead.Pop(), 2);
+  EXPECT_FALSE(read_ahead.Pop());
+  EXPECT_EQ(produced, 3);
+}
+
+TEST(ReadAhead, RethrowsProducerException) {
+  utils::ThreadPool pool(1);
+  int produced = 0;
+  ReadAhead read_ahead(
+      [&]() -> std::optional<int> {
+        if (produced == 2) throw std::runtime_error("error");
+        return produced++;
+      },
+      10, &pool);
+  EXPECT_EQ(read_ahead.Pop(), 0);
+  EXPECT_EQ(read_ahead.Pop(), 1);
+  EXPECT_THROW(read_ahead.Pop(), std::runtime_error);
+  EXPECT_FALSE(read_ahead.Pop());
+}
+
+TEST(ReadAhead, StopWaitsForProducer) {
+  utils::ThreadPool pool(1);
+  std::atomic<bool> running{false};
+  std::atomic<bool> release{false};
+  std::atomic<int> calls{0};
+  std::optional<ReadAhead> read_ahead;
+  read_ahead.emplace(
+      [&]() -> std::optional<int> {
+        auto call = calls++;
+        if (call == 1) {
+          running = true;
+          while (!release) std::this_thread::sleep_for(1ms);
+        }
+        return call;
+      },
+      10, &pool);
+  ASSERT_EQ(read_ahead->Pop(), 0);
+  while (!running) std::this_thread::sleep_for(1ms);
+  std::thread releaser([&] {
+    std::this_thread::sleep_for(20ms);
+    release = true;
+  });
+  read_ahead.reset();
+  EXPECT_TRUE(release);
+  releaser.join();
+  // The producer isn't called after the ReadAhead is destroyed.
+  EXPECT_EQ(calls, 2);
+}